@@ -43,8 +43,10 @@
 
 #pragma once
 
+#include <cstddef>
 #include <memory>
 
+#include <boost/optional.hpp>
 #include <boost/thread/shared_mutex.hpp>
 
 #include <llvm/ADT/DenseMap.h>
@@ -65,13 +67,16 @@ private:
   /// \brief Call statement
   ar::CallBase* _call = nullptr;
 
+  /// \brief Number of call statements in the context
+  std::size_t _depth = 0;
+
 private:
   /// \brief Create an empty call context
   CallContext() = default;
 
   /// \brief Create a call context
   CallContext(CallContext* parent, ar::CallBase* call)
-      : _parent(parent), _call(call) {
+      : _parent(parent), _call(call), _depth(parent->_depth + 1) {
     ikos_assert(this->_parent != nullptr);
     ikos_assert(this->_call != nullptr);
   }
@@ -110,6 +115,9 @@ public:
     return this->_call;
   }
 
+  /// \brief Return the number of call statements in the context
+  std::size_t depth() const { return this->_depth; }
+
   /// \brief Return true if the given function is within the call context
   bool contains(ar::Function* fun) const {
     const CallContext* context = this;
@@ -129,6 +137,11 @@ private:
 }; // end class CallContext
 
 /// \brief Management of calling contexts
+///
+/// The depth of the calling contexts can be bounded by k: a call statement in a
+/// context of depth k leads to the context made of the last k call statements
+/// (k-limited call strings). Such a context is shared by all the call strings
+/// with the same suffix.
 class CallContextFactory {
 private:
   boost::shared_mutex _mutex;
@@ -139,9 +152,16 @@ private:
 
   std::unique_ptr< CallContext > _empty_call_context;
 
+  /// \brief Maximum number of call statements in a context, or boost::none
+  boost::optional< unsigned > _max_depth;
+
 public:
   /// \brief Constructor
-  CallContextFactory();
+  ///
+  /// \param max_depth Maximum number of call statements in a context, or
+  /// boost::none for unbounded call strings
+  explicit CallContextFactory(
+      boost::optional< unsigned > max_depth = boost::none);
 
   /// \brief No copy constructor
   CallContextFactory(const CallContextFactory&) = delete;
@@ -163,10 +183,26 @@ public:
 
   /// \brief Get or Create the call context with the given parameters
   ///
+  /// If the parent context has the maximum depth, this returns the context
+  /// made of its last call statements followed by the given call statement.
+  ///
   /// \param parent Parent call context
   /// \param call Call statement
   CallContext* get_context(CallContext* parent, ar::CallBase* call);
 
+  /// \brief Return true if the contexts of the calls in the given context
+  /// might be shared by several call strings
+  ///
+  /// This is the case if the depth is bounded and the contexts of the calls
+  /// have the maximum depth.
+  bool is_merged(CallContext* parent) const {
+    return this->_max_depth && parent->depth() + 1 >= *this->_max_depth;
+  }
+
+private:
+  /// \brief Get or Create the call context with the given parent context
+  CallContext* get_or_create(CallContext* parent, ar::CallBase* call);
+
 }; // end class CallContextFactory
 
 } // end namespace analyzer
@@ -0,0 +1,160 @@
+/*******************************************************************************
+ *
+ * \file
+ * \brief Call graph and its strongly connected components
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include <llvm/ADT/DenseMap.h>
+
+#include <ikos/ar/semantic/function.hpp>
+
+#include <ikos/analyzer/analysis/context.hpp>
+
+namespace ikos {
+namespace analyzer {
+
+/// \brief Call graph of the function definitions of a bundle
+///
+/// Indirect calls are resolved using the results of the function pointer
+/// analysis, if available. Otherwise, they have no successor.
+///
+/// The call graph is partitioned into strongly connected components, in
+/// bottom-up order: a component always comes after the components it calls.
+class CallGraph {
+private:
+  /// \brief Function definitions, in the order of the bundle
+  std::vector< ar::Function* > _functions;
+
+  /// \brief Map from a function definition to its index in _functions
+  llvm::DenseMap< ar::Function*, std::size_t > _function_index;
+
+  /// \brief Function definitions called by each function definition, sorted
+  std::vector< std::vector< std::size_t > > _successors;
+
+  /// \brief Strongly connected components, in bottom-up order
+  ///
+  /// The functions of a component are in the order of the bundle.
+  std::vector< std::vector< ar::Function* > > _sccs;
+
+  /// \brief Map from a function index to the index of its component
+  std::vector< std::size_t > _scc_index;
+
+  /// \brief Components called by each component, sorted, without itself
+  std::vector< std::vector< std::size_t > > _callees;
+
+  /// \brief Components calling each component, sorted, without itself
+  std::vector< std::vector< std::size_t > > _callers;
+
+public:
+  /// \brief Build the call graph of the bundle
+  explicit CallGraph(Context& ctx);
+
+  /// \brief No copy constructor
+  CallGraph(const CallGraph&) = delete;
+
+  /// \brief No move constructor
+  CallGraph(CallGraph&&) = delete;
+
+  /// \brief No copy assignment operator
+  CallGraph& operator=(const CallGraph&) = delete;
+
+  /// \brief No move assignment operator
+  CallGraph& operator=(CallGraph&&) = delete;
+
+  /// \brief Destructor
+  ~CallGraph();
+
+  /// \brief Return the number of function definitions
+  std::size_t num_functions() const { return this->_functions.size(); }
+
+  /// \brief Return the function definition with the given index
+  ar::Function* function(std::size_t index) const {
+    return this->_functions[index];
+  }
+
+  /// \brief Return the index of the given function definition
+  std::size_t function_index(ar::Function* fun) const;
+
+  /// \brief Return the indexes of the function definitions called by the
+  /// given function
+  const std::vector< std::size_t >& successors(ar::Function* fun) const {
+    return this->_successors[this->function_index(fun)];
+  }
+
+  /// \brief Return the number of strongly connected components
+  std::size_t num_sccs() const { return this->_sccs.size(); }
+
+  /// \brief Return the functions of the given component
+  const std::vector< ar::Function* >& scc(std::size_t index) const {
+    return this->_sccs[index];
+  }
+
+  /// \brief Return the index of the component of the given function
+  std::size_t scc_index(ar::Function* fun) const {
+    return this->_scc_index[this->function_index(fun)];
+  }
+
+  /// \brief Return the components called by the given component
+  const std::vector< std::size_t >& callees(std::size_t index) const {
+    return this->_callees[index];
+  }
+
+  /// \brief Return the components calling the given component
+  const std::vector< std::size_t >& callers(std::size_t index) const {
+    return this->_callers[index];
+  }
+
+  /// \brief Return true if the component `caller` calls the component `callee`
+  bool calls(std::size_t caller, std::size_t callee) const;
+
+private:
+  /// \brief Compute the function definitions called by the given function
+  std::vector< std::size_t > compute_successors(Context& ctx,
+                                                ar::Function* fun) const;
+
+}; // end class CallGraph
+
+} // end namespace analyzer
+} // end namespace ikos
@@ -43,6 +43,8 @@
 
 #pragma once
 
+#include <mutex>
+
 #include <boost/filesystem.hpp>
 
 #include <ikos/ar/semantic/bundle.hpp>
@@ -104,6 +106,11 @@ public:
   /// \brief Pointer analysis, or null
   PointerAnalysis* pointer;
 
+  /// \brief Mutex for the creation of types and constants during the analysis
+  ///
+  /// The ar::Context is not thread safe.
+  std::mutex ar_context_mutex;
+
 public:
   /// \brief Constructor
   Context(ar::Bundle* bundle_,
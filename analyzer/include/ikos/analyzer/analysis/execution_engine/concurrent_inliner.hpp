@@ -61,6 +61,9 @@
 #include <ikos/analyzer/analysis/execution_engine/fixpoint_cache.hpp>
 #include <ikos/analyzer/analysis/execution_engine/numerical.hpp>
 #include <ikos/analyzer/analysis/pointer/value.hpp>
+#include <ikos/analyzer/util/demangle.hpp>
+#include <ikos/analyzer/util/log.hpp>
+#include <ikos/analyzer/util/memory.hpp>
 
 namespace ikos {
 namespace analyzer {
@@ -111,6 +114,17 @@ public:
   /// \brief Mark to check the callees
   void mark_check_callees() { this->_check_callees = true; }
 
+private:
+  /// \brief Return true if the memory usage exceeds the memory budget
+  ///
+  /// Above the budget, the invariants of callee fixpoints are spilled to
+  /// temporary files until the checks, trading time for memory.
+  bool exceeds_memory_budget() const {
+    return _ctx.opts.memory_budget &&
+           sampled_memory_usage() >= *_ctx.opts.memory_budget;
+  }
+
+public:
   /// \brief Exit a function
   ///
   /// This is called whenever we reach the exit node (if there is one).
@@ -262,16 +276,41 @@ private:
 
       analysis.fixpoint = nullptr;
 
+      if (_ctx.call_context_factory->is_merged(
+              this->_caller.call_context())) {
+        // The calling context of the callee is shared by several call strings
+        ar::ReturnValue* return_stmt =
+            this->exec_merged_callee(engine, analysis.callee);
+
+        // Merge exceptions in caught_exceptions, in case it's an invoke
+        engine.inv().merge_propagated_in_caught_exceptions();
+
+        if (!engine.inv().is_normal_flow_bottom()) {
+          engine.match_up(this->_call, return_stmt);
+        }
+        this->post_join(std::move(engine.inv()));
+        return;
+      }
+
       if (_ctx.opts.use_fixpoint_cache && this->_caller.converged()) {
         // Try to fetch the previously computed fix-point
         analysis.fixpoint =
-            this->_callees_cache.try_fetch(this->_call, analysis.callee);
+            this->_callees_cache.try_fetch(this->_caller.call_context(),
+                                           this->_call,
+                                           analysis.callee);
+
+        if (analysis.fixpoint != nullptr) {
+          // Read back the invariants, if they were spilled
+          analysis.fixpoint->restore();
+        }
       }
 
       if (analysis.fixpoint == nullptr) {
         if (_ctx.opts.use_fixpoint_cache) {
           // Erase the previous fix-point on the callee
-          this->_callees_cache.erase(this->_call, analysis.callee);
+          this->_callees_cache.erase(this->_caller.call_context(),
+                                     this->_call,
+                                     analysis.callee);
         }
 
         // Create a fixpoint on the callee
@@ -303,6 +342,51 @@ private:
       this->post_join(std::move(engine.inv()));
     }
 
+    /// \brief Analyze a callee in a merged calling context
+    ///
+    /// The callee is analyzed from the join of the entry invariants of the
+    /// call strings sharing its calling context, unless a previous result
+    /// covers the current entry invariant. The checks on the callee run once
+    /// all the entry points are analyzed.
+    ///
+    /// Set the invariant of the engine to the exit invariant of the callee,
+    /// and return the return statement of the callee, or null.
+    ar::ReturnValue* exec_merged_callee(NumericalExecutionEngineT& engine,
+                                        ar::Function* callee) {
+      CallContext* context =
+          _ctx.call_context_factory->get_context(this->_caller.call_context(),
+                                                 this->_call);
+
+      engine.inv().normalize();
+      AbstractDomain entry = std::move(engine.inv());
+      AbstractDomain exit = entry;
+      ar::ReturnValue* return_stmt = nullptr;
+
+      while (!this->_callees_cache.fetch_merged(context,
+                                                callee,
+                                                _ctx.opts.widening_delay,
+                                                entry,
+                                                exit,
+                                                return_stmt)) {
+        // Run analysis on callee, from the joined entry invariant
+        FunctionFixpoint fixpoint(_ctx, this->_caller, this->_call, callee);
+        fixpoint.run(entry);
+        exit = fixpoint.exit_invariant();
+        return_stmt = fixpoint.return_stmt();
+
+        if (this->_callees_cache.store_merged(context,
+                                              callee,
+                                              entry,
+                                              exit,
+                                              return_stmt)) {
+          break;
+        }
+      }
+
+      engine.set_inv(std::move(exit));
+      return return_stmt;
+    }
+
     /// \brief Join two workers
     void join(CalleeWorker& other) {
       if (other._post) {
@@ -459,8 +543,7 @@ private:
       }
       ikos_assert(callee->is_definition());
 
-      if (this->_caller.function() == callee ||
-          this->_caller.call_context()->contains(callee)) {
+      if (this->_caller.in_call_stack(callee)) {
         // Recursive function call
         //
         // TODO(jnavas): we can be more precise by making top only lhs of
@@ -489,14 +572,31 @@ private:
 
     // Non-thread safe
     for (CalleeAnalysis& analysis : callee_analyses) {
+      if (analysis.fixpoint == nullptr) {
+        // Callee in a merged calling context, checked after the entry points
+        continue;
+      }
+
       if (this->_check_callees) {
         // Run the checks on the callee
         analysis.fixpoint->run_checks();
       }
 
       if (_ctx.opts.use_fixpoint_cache) {
+        if (!this->_check_callees && this->exceeds_memory_budget() &&
+            !analysis.fixpoint->spill()) {
+          // The invariants cannot be spilled, e.g. the abstract domain cannot
+          // be serialized. Delete the callee fix-point, it will be computed
+          // again for the checks.
+          log::debug("Memory budget exceeded, dropping the fixpoint on '" +
+                     demangle(analysis.callee->name()) + "'");
+          analysis.fixpoint.reset();
+          continue;
+        }
+
         // Save the fix-point for later
-        this->_callees_cache.store(call,
+        this->_callees_cache.store(this->_caller.call_context(),
+                                   call,
                                    analysis.callee,
                                    std::move(analysis.fixpoint));
       }
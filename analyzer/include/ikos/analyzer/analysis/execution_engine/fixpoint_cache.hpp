@@ -43,8 +43,14 @@
 
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
 #include <memory>
 #include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
 
 #include <boost/container/flat_map.hpp>
 
@@ -53,12 +59,31 @@
 #include <ikos/ar/semantic/function.hpp>
 #include <ikos/ar/semantic/statement.hpp>
 
+#include <ikos/analyzer/analysis/call_context.hpp>
+#include <ikos/analyzer/support/assert.hpp>
+
 namespace ikos {
 namespace analyzer {
 
 /// \brief Function fixpoint cache for dynamic inlining
 ///
-/// This class stores computed function fixpoints for a given call site
+/// This class stores computed function fixpoints for a given call site in a
+/// given calling context. Since the calling context is part of the key, the
+/// cache can be shared by the analyses of several entry points.
+///
+/// The cache also holds the results of callees in merged calling contexts,
+/// i.e. contexts shared by several call strings when the depth of the calling
+/// contexts is bounded (see CallContextFactory). Such a callee is analyzed
+/// from the join of the entry invariants of its call strings, and its exit
+/// invariant is reused for all the entry invariants below that join. After
+/// `widening_delay` increases, entry invariants are widened instead of joined,
+/// so that recursions through merged contexts terminate.
+///
+/// The cache is split into shards, each protected by its own mutex. Keys are
+/// distributed over shards by call site, so that concurrent inliners working
+/// on different call sites rarely wait on each other. Each shard counts the
+/// number of accesses and the number of accesses that had to wait for the
+/// mutex.
 template < typename FunctionFixpoint, typename AbstractDomain >
 class FixpointCache {
 private:
@@ -67,16 +92,108 @@ private:
       boost::container::flat_map< ar::Function*,
                                   std::unique_ptr< FunctionFixpoint > >;
 
-  /// \brief Map from call statement to CalleeMap
-  using CallMap = llvm::DenseMap< ar::CallBase*, CalleeMap >;
+  /// \brief Key of the cache: (calling context, call statement)
+  using Key = std::pair< CallContext*, ar::CallBase* >;
+
+  /// \brief Map from (calling context, call statement) to CalleeMap
+  using CallMap = llvm::DenseMap< Key, CalleeMap >;
+
+  /// \brief Result of a callee in a merged calling context
+  struct MergedResult {
+    /// \brief Join of the entry invariants
+    AbstractDomain entry;
+
+    /// \brief Exit invariant, for that entry invariant
+    AbstractDomain exit;
+
+    /// \brief Return statement, or null
+    ar::ReturnValue* return_stmt;
+
+    /// \brief Order of insertion in the cache
+    std::size_t order;
+
+    /// \brief Number of increases of the entry invariant
+    unsigned num_increases;
+
+    /// \brief Whether the entry invariant increased since the last call to
+    /// take_increased_merged()
+    bool increased;
+  };
+
+  /// \brief Key of merged results: (merged calling context, callee)
+  using MergedKey = std::pair< CallContext*, ar::Function* >;
+
+  /// \brief Map from (merged calling context, callee) to MergedResult
+  using MergedMap = llvm::DenseMap< MergedKey, std::unique_ptr< MergedResult > >;
+
+  /// \brief Shard of the cache
+  ///
+  /// Aligned on a cache line to avoid false sharing between mutexes.
+  struct alignas(64) Shard {
+    std::mutex mutex;
+    CallMap call_map;
+    MergedMap merged_map;
+    uint64_t num_accesses = 0;
+    uint64_t num_contentions = 0;
+  };
+
+public:
+  /// \brief Statistics on the accesses to the cache
+  struct Statistics {
+    /// \brief Number of accesses
+    uint64_t num_accesses = 0;
+
+    /// \brief Number of accesses that had to wait for a mutex
+    uint64_t num_contentions = 0;
+  };
+
+  /// \brief Callee in a merged calling context
+  struct MergedCallee {
+    /// \brief Merged calling context of the callee
+    CallContext* context;
+
+    /// \brief Called function
+    ar::Function* callee;
+
+    /// \brief Join of the entry invariants
+    AbstractDomain entry;
+  };
 
 private:
-  std::mutex _mutex;
-  CallMap _call_map;
+  /// \brief Number of shards
+  std::size_t _num_shards;
+
+  /// \brief Storage of the shards
+  ///
+  /// Over-allocated by the alignment of a shard, since operator new ignores
+  /// extended alignments before C++17.
+  std::unique_ptr< unsigned char[] > _storage;
+
+  /// \brief Shards, within _storage
+  Shard* _shards = nullptr;
+
+  /// \brief Number of merged results inserted
+  std::atomic< std::size_t > _num_merged;
 
 public:
   /// \brief Constructor
-  FixpointCache() = default;
+  ///
+  /// \param num_shards Number of shards, 1 for a sequential analysis
+  explicit FixpointCache(std::size_t num_shards = 1)
+      : _num_shards(num_shards),
+        _storage(
+            new unsigned char[num_shards * sizeof(Shard) + alignof(Shard)]),
+        _num_merged(0) {
+    ikos_assert(num_shards > 0);
+    void* ptr = this->_storage.get();
+    std::size_t space = num_shards * sizeof(Shard) + alignof(Shard);
+    ptr = std::align(alignof(Shard), num_shards * sizeof(Shard), ptr, space);
+    ikos_assert(ptr != nullptr);
+    this->_shards = static_cast< Shard* >(ptr);
+    for (std::size_t i = 0; i < num_shards; i++) {
+      new (&this->_shards[i]) Shard();
+    }
+  }
 
   /// \brief No copy constructor
   FixpointCache(const FixpointCache&) = delete;
@@ -91,14 +208,57 @@ public:
   FixpointCache& operator=(FixpointCache&&) = delete;
 
   /// \brief Destructor
-  ~FixpointCache() = default;
+  ~FixpointCache() {
+    for (std::size_t i = 0; i < this->_num_shards; i++) {
+      this->_shards[i].~Shard();
+    }
+  }
 
+private:
+  /// \brief Return the shard for the given call statement
+  Shard& shard(ar::CallBase* call) const {
+    if (this->_num_shards == 1) {
+      return this->_shards[0];
+    }
+    return this->_shards[llvm::DenseMapInfo< ar::CallBase* >::getHashValue(
+                             call) %
+                         this->_num_shards];
+  }
+
+  /// \brief Return the shard for the given callee in a merged context
+  Shard& merged_shard(ar::Function* callee) const {
+    if (this->_num_shards == 1) {
+      return this->_shards[0];
+    }
+    return this->_shards[llvm::DenseMapInfo< ar::Function* >::getHashValue(
+                             callee) %
+                         this->_num_shards];
+  }
+
+  /// \brief Lock the given shard and update its counters
+  static std::unique_lock< std::mutex > lock(Shard& shard) {
+    std::unique_lock< std::mutex > lock(shard.mutex, std::try_to_lock);
+    if (!lock.owns_lock()) {
+      lock.lock();
+      shard.num_contentions++;
+    }
+    shard.num_accesses++;
+    return lock;
+  }
+
+public:
   /// \brief Try to fetch a fixpoint for a given call site and callee function
-  std::unique_ptr< FunctionFixpoint > try_fetch(ar::CallBase* call,
+  ///
+  /// \param context Calling context of the caller
+  /// \param call Call statement
+  /// \param callee Called function
+  std::unique_ptr< FunctionFixpoint > try_fetch(CallContext* context,
+                                                ar::CallBase* call,
                                                 ar::Function* callee) {
-    std::lock_guard< std::mutex > lock(this->_mutex);
-    auto call_it = this->_call_map.find(call);
-    if (call_it == this->_call_map.end()) {
+    Shard& shard = this->shard(call);
+    std::unique_lock< std::mutex > lock = FixpointCache::lock(shard);
+    auto call_it = shard.call_map.find({context, call});
+    if (call_it == shard.call_map.end()) {
       return nullptr;
     }
     CalleeMap& callee_map = call_it->second;
@@ -110,26 +270,212 @@ public:
   }
 
   /// \brief Erase the fixpoint for a given call site and callee function
-  void erase(ar::CallBase* call, ar::Function* callee) {
-    std::lock_guard< std::mutex > lock(this->_mutex);
-    auto call_it = this->_call_map.find(call);
-    if (call_it == this->_call_map.end()) {
-      return;
+  ///
+  /// \param context Calling context of the caller
+  /// \param call Call statement
+  /// \param callee Called function
+  void erase(CallContext* context, ar::CallBase* call, ar::Function* callee) {
+    std::unique_ptr< FunctionFixpoint > fixpoint;
+    {
+      Shard& shard = this->shard(call);
+      std::unique_lock< std::mutex > lock = FixpointCache::lock(shard);
+      auto call_it = shard.call_map.find({context, call});
+      if (call_it == shard.call_map.end()) {
+        return;
+      }
+      CalleeMap& callee_map = call_it->second;
+      auto callee_it = callee_map.find(callee);
+      if (callee_it == callee_map.end()) {
+        return;
+      }
+      fixpoint = std::move(callee_it->second);
     }
-    CalleeMap& callee_map = call_it->second;
-    auto callee_it = callee_map.find(callee);
-    if (callee_it == callee_map.end()) {
-      return;
-    }
-    callee_it->second.reset();
+    // Destroy the fixpoint without holding the mutex
   }
 
   /// \brief Store a fixpoint for a given call site and callee function
-  void store(ar::CallBase* call,
+  ///
+  /// \param context Calling context of the caller
+  /// \param call Call statement
+  /// \param callee Called function
+  /// \param fixpoint Fixpoint on the callee
+  void store(CallContext* context,
+             ar::CallBase* call,
              ar::Function* callee,
              std::unique_ptr< FunctionFixpoint > fixpoint) {
-    std::lock_guard< std::mutex > lock(this->_mutex);
-    this->_call_map[call][callee] = std::move(fixpoint);
+    Shard& shard = this->shard(call);
+    std::unique_lock< std::mutex > lock = FixpointCache::lock(shard);
+    std::swap(shard.call_map[{context, call}][callee], fixpoint);
+    lock.unlock();
+    // Destroy the previous fixpoint without holding the mutex
+    fixpoint.reset();
+  }
+
+  /// \brief Erase all the fixpoints computed from the given entry point
+  ///
+  /// This releases the memory once the entry point has been analyzed.
+  void erase_entry_point(ar::Function* entry_point) {
+    std::vector< CalleeMap > erased;
+    for (std::size_t i = 0; i < this->_num_shards; i++) {
+      Shard& shard = this->_shards[i];
+      std::unique_lock< std::mutex > lock = FixpointCache::lock(shard);
+      for (auto it = shard.call_map.begin(), et = shard.call_map.end();
+           it != et;
+           ++it) {
+        // Find the first call statement of the calling context
+        ar::CallBase* call = it->first.second;
+        for (CallContext* context = it->first.first; !context->empty();
+             context = context->parent()) {
+          call = context->call();
+        }
+
+        if (call->code()->function_or_null() == entry_point) {
+          erased.push_back(std::move(it->second));
+          shard.call_map.erase(it);
+        }
+      }
+      lock.unlock();
+      // Destroy the fixpoints without holding the mutex
+      erased.clear();
+    }
+  }
+
+  /// \brief Fetch the result of a callee in a merged calling context
+  ///
+  /// If the callee was analyzed from an entry invariant greater or equal to
+  /// `entry`, return true and set `exit` and `return_stmt`. Otherwise, return
+  /// false and join the previous entry invariant, if any, into `entry`, or
+  /// widen it once it increased more than `widening_delay` times.
+  ///
+  /// \param context Merged calling context of the callee
+  /// \param callee Called function
+  /// \param widening_delay Number of increases before widening
+  /// \param entry Entry invariant of the callee
+  /// \param exit Exit invariant of the callee
+  /// \param return_stmt Return statement of the callee, or null
+  bool fetch_merged(CallContext* context,
+                    ar::Function* callee,
+                    unsigned widening_delay,
+                    AbstractDomain& entry,
+                    AbstractDomain& exit,
+                    ar::ReturnValue*& return_stmt) {
+    Shard& shard = this->merged_shard(callee);
+    std::unique_lock< std::mutex > lock = FixpointCache::lock(shard);
+    auto it = shard.merged_map.find({context, callee});
+    if (it == shard.merged_map.end()) {
+      return false;
+    }
+    const MergedResult& result = *it->second;
+    if (entry.leq(result.entry)) {
+      exit = result.exit;
+      return_stmt = result.return_stmt;
+      return true;
+    }
+    if (result.num_increases < widening_delay) {
+      entry.join_with(result.entry);
+    } else {
+      entry = result.entry.widening(entry);
+    }
+    return false;
+  }
+
+  /// \brief Store the result of a callee in a merged calling context
+  ///
+  /// Return false if another result was stored in the meantime, for an entry
+  /// invariant that is not smaller than `entry`. The caller should fetch the
+  /// result again.
+  ///
+  /// \param context Merged calling context of the callee
+  /// \param callee Called function
+  /// \param entry Entry invariant of the callee
+  /// \param exit Exit invariant of the callee
+  /// \param return_stmt Return statement of the callee, or null
+  bool store_merged(CallContext* context,
+                    ar::Function* callee,
+                    const AbstractDomain& entry,
+                    const AbstractDomain& exit,
+                    ar::ReturnValue* return_stmt) {
+    Shard& shard = this->merged_shard(callee);
+    std::unique_lock< std::mutex > lock = FixpointCache::lock(shard);
+    std::unique_ptr< MergedResult >& result =
+        shard.merged_map[{context, callee}];
+    if (result == nullptr) {
+      result = std::unique_ptr< MergedResult >(
+          new MergedResult{entry,
+                           exit,
+                           return_stmt,
+                           this->_num_merged.fetch_add(1),
+                           /* num_increases = */ 0,
+                           /* increased = */ true});
+      return true;
+    }
+    if (!result->entry.leq(entry)) {
+      return false;
+    }
+    if (!entry.leq(result->entry)) {
+      result->entry = entry;
+      result->exit = exit;
+      result->return_stmt = return_stmt;
+      result->num_increases++;
+      result->increased = true;
+    }
+    return true;
+  }
+
+  /// \brief Return the callees in merged calling contexts whose entry
+  /// invariant increased since the last call, in the order of insertion
+  std::vector< MergedCallee > take_increased_merged() {
+    return this->collect_merged(/* only_increased = */ true);
+  }
+
+  /// \brief Return all the callees in merged calling contexts, in the order
+  /// of insertion
+  std::vector< MergedCallee > merged_callees() {
+    return this->collect_merged(/* only_increased = */ false);
+  }
+
+private:
+  /// \brief Collect the callees in merged calling contexts
+  std::vector< MergedCallee > collect_merged(bool only_increased) {
+    std::vector< std::pair< std::size_t, MergedCallee > > callees;
+    for (std::size_t i = 0; i < this->_num_shards; i++) {
+      Shard& shard = this->_shards[i];
+      std::unique_lock< std::mutex > lock = FixpointCache::lock(shard);
+      for (auto& entry : shard.merged_map) {
+        MergedResult& result = *entry.second;
+        if (only_increased && !result.increased) {
+          continue;
+        }
+        result.increased = false;
+        callees.emplace_back(result.order,
+                             MergedCallee{entry.first.first,
+                                          entry.first.second,
+                                          result.entry});
+      }
+    }
+    std::sort(callees.begin(),
+              callees.end(),
+              [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    std::vector< MergedCallee > result;
+    result.reserve(callees.size());
+    for (auto& entry : callees) {
+      result.push_back(std::move(entry.second));
+    }
+    return result;
+  }
+
+public:
+  /// \brief Return the statistics on the accesses to the cache
+  Statistics statistics() const {
+    Statistics stats;
+    for (std::size_t i = 0; i < this->_num_shards; i++) {
+      Shard& shard = this->_shards[i];
+      std::lock_guard< std::mutex > lock(shard.mutex);
+      stats.num_accesses += shard.num_accesses;
+      stats.num_contentions += shard.num_contentions;
+    }
+    return stats;
   }
 
 }; // end class FixpointCache
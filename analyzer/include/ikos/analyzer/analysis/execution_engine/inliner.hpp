@@ -47,6 +47,7 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include <ikos/ar/semantic/function.hpp>
 #include <ikos/ar/semantic/statement.hpp>
@@ -58,6 +59,7 @@
 #include <ikos/analyzer/analysis/pointer/value.hpp>
 #include <ikos/analyzer/util/demangle.hpp>
 #include <ikos/analyzer/util/log.hpp>
+#include <ikos/analyzer/util/memory.hpp>
 
 namespace ikos {
 namespace analyzer {
@@ -108,6 +110,17 @@ public:
   /// \brief Mark to check the callees
   void mark_check_callees() { this->_check_callees = true; }
 
+private:
+  /// \brief Return true if the memory usage exceeds the memory budget
+  ///
+  /// Above the budget, the invariants of callee fixpoints are spilled to
+  /// temporary files until the checks, trading time for memory.
+  bool exceeds_memory_budget() const {
+    return _ctx.opts.memory_budget &&
+           sampled_memory_usage() >= *_ctx.opts.memory_budget;
+  }
+
+public:
   /// \brief Exit a function
   ///
   /// This is called whenever we reach the exit node (if there is one).
@@ -267,8 +280,7 @@ private:
       }
       ikos_assert(callee->is_definition());
 
-      if (this->_caller.function() == callee ||
-          this->_caller.call_context()->contains(callee)) {
+      if (this->_caller.in_call_stack(callee)) {
         // Recursive function call
         //
         // TODO(jnavas): we can be more precise by making top only lhs of
@@ -286,6 +298,21 @@ private:
       // Assign parameters
       engine.match_down(call, callee);
 
+      if (_ctx.call_context_factory->is_merged(this->_caller.call_context())) {
+        // The calling context of the callee is shared by several call strings
+        ar::ReturnValue* return_stmt =
+            this->exec_merged_callee(engine, call, callee);
+
+        // Merge exceptions in caught_exceptions, in case it's an invoke
+        engine.inv().merge_propagated_in_caught_exceptions();
+
+        if (!engine.inv().is_normal_flow_bottom()) {
+          engine.match_up(call, return_stmt);
+        }
+        post.join_with(std::move(engine.inv()));
+        continue;
+      }
+
       //
       // Analyze recursively the callee
       //
@@ -294,13 +321,23 @@ private:
 
       if (_ctx.opts.use_fixpoint_cache && this->_caller.converged()) {
         // Try to fetch the previously computed fix-point
-        callee_fixpoint = this->_callees_cache.try_fetch(call, callee);
+        callee_fixpoint =
+            this->_callees_cache.try_fetch(this->_caller.call_context(),
+                                           call,
+                                           callee);
+
+        if (callee_fixpoint != nullptr) {
+          // Read back the invariants, if they were spilled
+          callee_fixpoint->restore();
+        }
       }
 
       if (callee_fixpoint == nullptr) {
         if (_ctx.opts.use_fixpoint_cache) {
           // Erase the previous fix-point on the callee
-          this->_callees_cache.erase(call, callee);
+          this->_callees_cache.erase(this->_caller.call_context(),
+                                     call,
+                                     callee);
         }
 
         // Create a fixpoint on the callee
@@ -309,12 +346,34 @@ private:
                                                                call,
                                                                callee);
 
-        // Run analysis on callee
-        log::debug("Analyzing function '" + demangle(callee->name()) + "'");
-        callee_fixpoint->run(std::move(engine.inv()));
+        auto* summary_cache = this->_caller.summary_cache();
+        std::vector< AbstractDomain > invariants;
+        engine.inv().normalize();
+        if (summary_cache != nullptr &&
+            summary_cache->load_fixpoint(callee,
+                                         callee_fixpoint->call_context(),
+                                         engine.inv(),
+                                         invariants)) {
+          // Reuse the fixpoint computed by a previous run
+          log::debug("Reusing cached fixpoint on function '" +
+                     demangle(callee->name()) + "'");
+          callee_fixpoint->set_invariants(std::move(invariants));
+        } else {
+          // Run analysis on callee
+          log::debug("Analyzing function '" + demangle(callee->name()) + "'");
+          callee_fixpoint->run(std::move(engine.inv()));
+        }
       }
 
       if (this->_check_callees) {
+        if (auto* summary_cache = this->_caller.summary_cache()) {
+          // Save the final fixpoint for the next runs
+          summary_cache->store_fixpoint(callee,
+                                        callee_fixpoint->call_context(),
+                                        callee_fixpoint->entry_invariant(),
+                                        callee_fixpoint->invariants());
+        }
+
         // Run the checks on the callee
         callee_fixpoint->run_checks();
       }
@@ -324,11 +383,25 @@ private:
 
       engine.set_inv(callee_fixpoint->exit_invariant());
 
-      if (_ctx.opts.use_fixpoint_cache) {
-        // Save the fix-point for later
-        this->_callees_cache.store(call, callee, std::move(callee_fixpoint));
+      if (_ctx.opts.use_fixpoint_cache && !this->_check_callees) {
+        if (this->exceeds_memory_budget() && !callee_fixpoint->spill()) {
+          // The invariants cannot be spilled, e.g. the abstract domain cannot
+          // be serialized. Delete the callee fix-point, it will be computed
+          // again for the checks.
+          log::debug("Memory budget exceeded, dropping the fixpoint on '" +
+                     demangle(callee->name()) + "'");
+          callee_fixpoint.reset();
+        } else {
+          // Save the fix-point for the checks
+          this->_callees_cache.store(this->_caller.call_context(),
+                                     call,
+                                     callee,
+                                     std::move(callee_fixpoint));
+        }
       } else {
         // Delete the callee fix-point
+        //
+        // After the checks, it will not be fetched again.
         callee_fixpoint.reset();
       }
 
@@ -348,6 +421,54 @@ private:
     this->_engine.set_inv(std::move(post));
   }
 
+  /// \brief Analyze a callee in a merged calling context
+  ///
+  /// The callee is analyzed from the join of the entry invariants of the call
+  /// strings sharing its calling context, unless a previous result covers the
+  /// current entry invariant. The checks on the callee run once all the entry
+  /// points are analyzed.
+  ///
+  /// Set the invariant of the engine to the exit invariant of the callee, and
+  /// return the return statement of the callee, or null.
+  ar::ReturnValue* exec_merged_callee(NumericalExecutionEngineT& engine,
+                                      ar::CallBase* call,
+                                      ar::Function* callee) {
+    FixpointCacheT& merged_cache = this->_caller.merged_cache();
+    CallContext* context =
+        _ctx.call_context_factory->get_context(this->_caller.call_context(),
+                                               call);
+
+    engine.inv().normalize();
+    AbstractDomain entry = std::move(engine.inv());
+    AbstractDomain exit = entry;
+    ar::ReturnValue* return_stmt = nullptr;
+
+    while (!merged_cache.fetch_merged(context,
+                                      callee,
+                                      _ctx.opts.widening_delay,
+                                      entry,
+                                      exit,
+                                      return_stmt)) {
+      // Run analysis on callee, from the joined entry invariant
+      log::debug("Analyzing function '" + demangle(callee->name()) + "'");
+      FunctionFixpoint callee_fixpoint(_ctx, this->_caller, call, callee);
+      callee_fixpoint.run(entry);
+      exit = callee_fixpoint.exit_invariant();
+      return_stmt = callee_fixpoint.return_stmt();
+
+      if (merged_cache.store_merged(context,
+                                    callee,
+                                    entry,
+                                    exit,
+                                    return_stmt)) {
+        break;
+      }
+    }
+
+    engine.set_inv(std::move(exit));
+    return return_stmt;
+  }
+
 }; // end class InlineCallExecutionEngine
 
 } // end namespace analyzer
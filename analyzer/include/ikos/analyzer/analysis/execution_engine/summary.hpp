@@ -0,0 +1,312 @@
+/*******************************************************************************
+ *
+ * \file
+ * \brief Execution of function calls using function summaries
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <ikos/ar/semantic/function.hpp>
+#include <ikos/ar/semantic/statement.hpp>
+#include <ikos/ar/verify/type.hpp>
+
+#include <ikos/analyzer/analysis/execution_engine/engine.hpp>
+#include <ikos/analyzer/analysis/execution_engine/numerical.hpp>
+#include <ikos/analyzer/analysis/pointer/value.hpp>
+
+namespace ikos {
+namespace analyzer {
+
+/// \brief Execution of function calls using summaries of the callees
+///
+/// Instead of analyzing the callee, the summary of the callee is applied: the
+/// actual parameters are assigned to the formal parameters, the memory that the
+/// callee might write or allocate is forgotten, and the result is refined with
+/// the invariant at the exit of the callee.
+///
+/// Calls to functions without summary, i.e. recursive calls, are treated as
+/// calls to unknown functions.
+template < typename FunctionFixpoint, typename AbstractDomain >
+class SummaryCallExecutionEngine final : public CallExecutionEngine {
+public:
+  using NumericalExecutionEngineT = NumericalExecutionEngine< AbstractDomain >;
+
+private:
+  /// \brief Analysis context
+  Context& _ctx;
+
+  /// \brief Numerical execution engine
+  NumericalExecutionEngineT& _engine;
+
+  /// \brief Function analyzer of the caller
+  FunctionFixpoint& _caller;
+
+public:
+  /// \brief Constructor
+  SummaryCallExecutionEngine(Context& ctx,
+                             NumericalExecutionEngineT& engine,
+                             FunctionFixpoint& caller)
+      : _ctx(ctx), _engine(engine), _caller(caller) {}
+
+  /// \brief Exit a function
+  ///
+  /// This is called whenever we reach the exit node (if there is one).
+  void exec_exit(ar::Function* fun) override {
+    this->_engine.deallocate_local_variables(fun->local_variable_begin(),
+                                             fun->local_variable_end());
+    this->_caller.set_exit_invariant(this->_engine.inv());
+  }
+
+  /// \brief Execute a ReturnValue statement
+  void exec(ar::ReturnValue* s) override { this->_caller.set_return_stmt(s); }
+
+  /// \brief Execute a Call statement
+  void exec(ar::Call* s) override {
+    // Execute the call base statement
+    this->exec(cast< ar::CallBase >(s));
+
+    // Exceptions aren't caught, propagate them
+    this->inv().merge_caught_in_propagated_exceptions();
+  }
+
+  /// \brief Execute an Invoke statement
+  void exec(ar::Invoke* s) override {
+    // Execute the call base statement
+    this->exec(cast< ar::CallBase >(s));
+
+    // Exceptions are caught.
+    // Nothing to do here.
+    // see NumericalExecutionEngine::exec_edge()
+  }
+
+private:
+  /// \brief Return a non-const reference on the current invariant
+  AbstractDomain& inv() { return this->_engine.inv(); }
+
+  /// \brief Execute any call statement
+  void exec(ar::CallBase* call) {
+    this->inv().normal().normalize();
+
+    if (this->inv().is_normal_flow_bottom()) {
+      return;
+    }
+
+    //
+    // Collect potential callees
+    //
+    auto callees = PointsToSet::bottom();
+    ar::Value* called = call->called();
+
+    if (isa< ar::UndefinedConstant >(called)) {
+      // Call on undefined pointer: error
+      this->inv().set_normal_flow_to_bottom();
+      return;
+    } else if (isa< ar::NullConstant >(called)) {
+      // Call on null pointer: error
+      this->inv().set_normal_flow_to_bottom();
+      return;
+    } else if (auto cst = dyn_cast< ar::FunctionPointerConstant >(called)) {
+      callees = {_ctx.mem_factory->get_function(cst->function())};
+    } else if (isa< ar::InlineAssemblyConstant >(called)) {
+      // Call to assembly
+      this->_engine.exec_unknown_extern_call(call);
+      return;
+    } else if (isa< ar::GlobalVariable >(called)) {
+      // Call to global variable: error
+      this->inv().set_normal_flow_to_bottom();
+      return;
+    } else if (isa< ar::LocalVariable >(called)) {
+      // Call to local variable: error
+      this->inv().set_normal_flow_to_bottom();
+      return;
+    } else if (auto ptr = dyn_cast< ar::InternalVariable >(called)) {
+      // Indirect call through a function pointer
+      Variable* ptr_var = _ctx.var_factory->get_internal(ptr);
+
+      // Assert `ptr != null`
+      this->inv().normal().nullity_assert_non_null(ptr_var);
+
+      // Reduction between value and pointer analysis
+      const PointerInfo* pointer_info = this->_engine.pointer_info();
+      if (pointer_info != nullptr) {
+        PointsToSet points_to = pointer_info->get(ptr_var).points_to();
+
+        // Pointer analysis and value analysis can be inconsistent
+        if (!points_to.is_bottom() && !points_to.is_top()) {
+          this->inv().normal().pointer_refine(ptr_var, points_to);
+        }
+      }
+
+      this->inv().normal().normalize();
+
+      if (this->inv().is_normal_flow_bottom()) {
+        return;
+      }
+
+      // Get the callees
+      callees = this->inv().normal().pointer_to_points_to(ptr_var);
+    } else {
+      ikos_unreachable("unexpected called operand");
+    }
+
+    //
+    // Check callees
+    //
+    ikos_assert(!callees.is_bottom());
+    if (callees.is_empty()) {
+      // Invalid pointer dereference
+      this->inv().set_normal_flow_to_bottom();
+      return;
+    } else if (callees.is_top()) {
+      // No points-to information
+      // ASSUMPTION: the callee has no side effects.
+      // Just set lhs and all actual parameters of pointer type to TOP.
+      this->_engine.exec_unknown_extern_call(call);
+      return;
+    }
+
+    //
+    // Compute the post invariant
+    //
+
+    // By default, propagate the exception states
+    AbstractDomain post = this->inv();
+    post.set_normal_flow_to_bottom();
+
+    // For each callee
+    for (MemoryLocation* mem : callees) {
+      if (!isa< FunctionMemoryLocation >(mem)) {
+        // Not a call to a function memory location
+        continue;
+      }
+
+      ar::Function* callee = cast< FunctionMemoryLocation >(mem)->function();
+
+      if (!ar::TypeVerifier::is_valid_call(call, callee->type())) {
+        // Ill-formed function call
+        //
+        // This could be because of an imprecision of the pointer analysis.
+        continue;
+      }
+
+      if (callee->is_declaration()) {
+        // Call to an extern function
+        //
+        // ASSUMPTION: if this is a call to an extern non-intrinsic function,
+        // treat it as a function call that has no side effects.
+        NumericalExecutionEngineT engine = this->_engine.fork();
+        engine.inv().ignore_exceptions();
+        engine.exec_extern_call(call, callee);
+        engine.inv().merge_propagated_in_caught_exceptions();
+        post.join_with(std::move(engine.inv()));
+        continue;
+      }
+      ikos_assert(callee->is_definition());
+
+      const auto* summary = this->_caller.callee_summary(callee);
+
+      if (summary == nullptr) {
+        // Recursive function call, or a callee unknown to the call graph
+        this->_engine.exec_unknown_intern_call(call);
+        return;
+      }
+
+      NumericalExecutionEngineT engine = this->_engine.fork();
+
+      // Do not propagate exceptions from the caller to the callee
+      engine.inv().ignore_exceptions();
+
+      // Assign parameters
+      engine.match_down(call, callee);
+
+      // Forget the memory that the callee might write, and throw exceptions
+      engine.exec_unknown_call(call,
+                               /* may_write_params = */
+                               summary->may_write_memory(),
+                               /* ignore_unknown_write = */ false,
+                               /* may_write_globals = */
+                               summary->may_write_memory(),
+                               /* may_throw_exc = */
+                               summary->may_throw_exceptions());
+
+      // The dynamic allocations of the callee are allocated again
+      for (MemoryLocation* addr : summary->allocations()) {
+        engine.inv().normal().lifetime_forget(addr);
+        engine.inv().normal().mem_forget(addr);
+        engine.inv().normal().scalar_forget(
+            _ctx.var_factory->get_alloc_size(addr));
+      }
+
+      // Refine with the exit invariant of the callee
+      engine.inv().normal().meet_with(summary->exit_invariant());
+
+      // Merge exceptions in caught_exceptions, in case it's an invoke
+      engine.inv().merge_propagated_in_caught_exceptions();
+
+      if (!engine.inv().is_normal_flow_bottom()) {
+        engine.match_up(call, summary->return_stmt());
+      }
+
+      this->forget_parameters(engine.inv(), callee);
+      post.join_with(std::move(engine.inv()));
+    }
+
+    this->_engine.set_inv(std::move(post));
+  }
+
+  /// \brief Forget the formal parameters of the callee
+  void forget_parameters(AbstractDomain& inv, ar::Function* callee) {
+    for (auto it = callee->param_begin(), et = callee->param_end(); it != et;
+         ++it) {
+      Variable* var = _ctx.var_factory->get_internal(*it);
+
+      if (var->type()->is_aggregate()) {
+        inv.normal().mem_forget_reachable(var);
+        inv.caught_exceptions().mem_forget_reachable(var);
+      }
+      inv.normal().scalar_forget(var);
+      inv.caught_exceptions().scalar_forget(var);
+    }
+  }
+
+}; // end class SummaryCallExecutionEngine
+
+} // end namespace analyzer
+} // end namespace ikos
@@ -46,6 +46,7 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
 
 #include <boost/optional.hpp>
 
@@ -162,6 +163,9 @@ private:
   llvm::DenseMap< ar::Function*, std::unique_ptr< CodeFixpointParameters > >
       _map;
 
+  /// \brief Mutex on the map, for the creation of parameters
+  std::mutex _mutex;
+
 public:
   /// \brief Constructor
   explicit FixpointParameters(const AnalysisOptions& opts);
@@ -187,6 +191,8 @@ public:
   }
 
   /// \brief Get or create the fixpoint parameters for the given function
+  ///
+  /// This is thread-safe.
   CodeFixpointParameters& get(ar::Function*);
 
   /// \brief Get the fixpoint parameters for the given function
@@ -46,6 +46,7 @@
 #pragma once
 
 #include <iosfwd>
+#include <mutex>
 #include <vector>
 #include <cstdint>
 
@@ -79,6 +80,9 @@ private:
   /// \brief List of dead variables at the end of a basic block
   VariableRefMap _dead_at_end_map;
 
+  /// \brief Mutex on the maps, when the analysis runs concurrently
+  std::mutex _mutex;
+
 public:
   /// \brief Constructor
   explicit LivenessAnalysis(Context& ctx);
@@ -113,8 +117,9 @@ public:
   /// \brief Run the analysis
   void run();
 
-private:
   /// \brief Run the analysis on the given code
+  ///
+  /// This can be called concurrently on different codes.
   void run(ar::Code* code);
 
 public:
@@ -45,11 +45,15 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstdint>
 #include <memory>
 #include <string>
 
 #include <boost/thread/shared_mutex.hpp>
 
+#include <tbb/concurrent_vector.h>
+
 #include <llvm/ADT/DenseMap.h>
 #include <llvm/ADT/StringMap.h>
 #include <llvm/ADT/StringRef.h>
@@ -90,10 +94,16 @@ public:
     DynAllocMemoryKind,
   };
 
+public:
+  friend class MemoryFactory;
+
 protected:
   /// \brief Kind of the memory location
   MemoryLocationKind _kind;
 
+  /// \brief Unique index of the memory location, assigned by the MemoryFactory
+  std::uint32_t _index;
+
 protected:
   /// \brief Protected constructor
   explicit MemoryLocation(MemoryLocationKind kind);
@@ -117,6 +127,11 @@ public:
   /// \brief Return the kind of the object
   MemoryLocationKind kind() const { return this->_kind; }
 
+  /// \brief Return the unique index of the memory location
+  ///
+  /// Indexes are dense and given in order of creation.
+  std::uint32_t index() const { return this->_index; }
+
   /// \brief Dump the memory location, for debugging purpose
   virtual void dump(std::ostream&) const = 0;
 
@@ -294,6 +309,12 @@ public:
 /// \brief Management of memory locations
 class MemoryFactory {
 private:
+  /// \brief Index of the next created memory location
+  std::atomic< std::uint32_t > _next_index;
+
+  /// \brief Memory locations, by index
+  tbb::concurrent_vector< MemoryLocation* > _index_map;
+
   boost::shared_mutex _local_memory_mutex;
 
   llvm::DenseMap< ar::LocalVariable*, std::unique_ptr< LocalMemoryLocation > >
@@ -375,6 +396,13 @@ public:
   DynAllocMemoryLocation* get_dyn_alloc(ar::CallBase* call,
                                         CallContext* context);
 
+  /// \brief Return the memory location with the given index, or null
+  MemoryLocation* get_by_index(std::uint32_t index) const;
+
+private:
+  /// \brief Give the next index to a new memory location
+  void set_index(MemoryLocation* ml);
+
 }; // end class MemoryFactory
 
 } // end namespace analyzer
@@ -385,13 +413,10 @@ namespace core {
 
 /// \brief Implement IndexableTraits for MemoryLocation*
 ///
-/// The index of MemoryLocation* is the address of the pointer
+/// The index of MemoryLocation* is the index given by the MemoryFactory
 template <>
 struct IndexableTraits< analyzer::MemoryLocation* > {
-  static Index index(const analyzer::MemoryLocation* m) {
-    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
-    return reinterpret_cast< Index >(m);
-  }
+  static Index index(const analyzer::MemoryLocation* m) { return m->index(); }
 };
 
 /// \brief Implement DumpableTraits for MemoryLocation*
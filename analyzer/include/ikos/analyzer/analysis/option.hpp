@@ -43,6 +43,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <vector>
 
 #include <boost/container/flat_map.hpp>
@@ -67,6 +68,9 @@ enum class MachineIntDomainOption {
   Congruence,
   IntervalCongruence,
   DBM,
+  SplitDBM,
+  FixedWidthDBM,
+  FixedWidthOctagon,
   VarPackDBM,
   VarPackDBMCongruence,
   Gauge,
@@ -97,6 +101,12 @@ inline const char* machine_int_domain_option_str(MachineIntDomainOption d) {
       return "interval-congruence";
     case MachineIntDomainOption::DBM:
       return "dbm";
+    case MachineIntDomainOption::SplitDBM:
+      return "split-dbm";
+    case MachineIntDomainOption::FixedWidthDBM:
+      return "fixed-width-dbm";
+    case MachineIntDomainOption::FixedWidthOctagon:
+      return "fixed-width-octagon";
     case MachineIntDomainOption::VarPackDBM:
       return "var-pack-dbm";
     case MachineIntDomainOption::VarPackDBMCongruence:
@@ -137,13 +147,16 @@ inline const char* machine_int_domain_option_str(MachineIntDomainOption d) {
   }
 }
 
-/// \brief Either Interprocedural or Intraprocedural
+/// \brief Either Interprocedural, Intraprocedural or Summary
 enum class Procedural {
   /// \brief Analyzes function by taking into account other functions
   Interprocedural,
 
   /// \brief Analyze function independently
   Intraprocedural,
+
+  /// \brief Analyze function independently, using summaries of the callees
+  Summary,
 };
 
 /// \brief Return a string representing a Procedural
@@ -153,6 +166,8 @@ inline const char* procedural_str(Procedural proc) {
       return "interprocedural";
     case Procedural::Intraprocedural:
       return "intraprocedural";
+    case Procedural::Summary:
+      return "summary";
     default: {
       ikos_unreachable("unreachable");
     }
@@ -296,6 +311,14 @@ public:
   /// \brief Number of threads
   int num_threads;
 
+  /// \brief Number of shards the function definitions are split into
+  ///
+  /// Shards are analyzed by separate processes, see `-shard-count`.
+  unsigned shard_count;
+
+  /// \brief Index of the shard to analyze, in [0, shard_count)
+  unsigned shard_index;
+
   /// \brief Strategy for the increasing iterations (before reaching a fixpoint)
   WideningStrategy widening_strategy;
 
@@ -332,6 +355,16 @@ public:
   /// \brief Wether we should save fixpoints on called functions or not
   bool use_fixpoint_cache;
 
+  /// \brief Memory usage, in bytes, above which the invariants of fixpoints on
+  /// called functions are spilled to temporary files, or boost::none
+  boost::optional< std::size_t > memory_budget;
+
+  /// \brief Maximum depth of the call contexts of the inliner
+  ///
+  /// Beyond that depth, call contexts with the same last call statements are
+  /// merged. boost::none for unbounded call contexts.
+  boost::optional< unsigned > context_depth;
+
   /// \brief Wether we should perform checks or not
   bool use_checks;
 
@@ -356,10 +389,19 @@ public:
   /// \brief Value of argc, or boost::none
   boost::optional< int > argc;
 
+  /// \brief Directory of the persistent summary cache, or boost::none
+  boost::optional< std::string > summary_cache;
+
 public:
   /// \brief Save the options in the output database
   void save(SettingsTable&);
 
+  /// \brief Return true if the i-th function definition of the bundle belongs
+  /// to the shard to analyze
+  bool in_shard(std::size_t i) const {
+    return i % this->shard_count == this->shard_index;
+  }
+
 }; // end class AnalysisOptions
 
 } // end namespace analyzer
@@ -47,6 +47,9 @@
 
 #pragma once
 
+#include <memory>
+#include <vector>
+
 #include <ikos/core/domain/pointer/solver.hpp>
 
 #include <ikos/ar/semantic/code.hpp>
@@ -71,6 +74,56 @@ namespace analyzer {
 using PointerConstraint =
     core::pointer::Constraint< Variable*, MemoryLocation* >;
 
+/// \brief List of pointer constraints, not yet added to a system
+///
+/// This allows to generate constraints for several functions concurrently,
+/// and to add them to the system in a deterministic order afterwards.
+class PointerConstraintList {
+private:
+  using ConstraintList = std::vector< std::unique_ptr< PointerConstraint > >;
+
+public:
+  using Iterator = ConstraintList::iterator;
+
+private:
+  /// \brief List of constraints
+  ConstraintList _csts;
+
+public:
+  /// \brief Constructor
+  PointerConstraintList() = default;
+
+  /// \brief No copy constructor
+  PointerConstraintList(const PointerConstraintList&) = delete;
+
+  /// \brief Move constructor
+  PointerConstraintList(PointerConstraintList&&) = default;
+
+  /// \brief No copy assignment operator
+  PointerConstraintList& operator=(const PointerConstraintList&) = delete;
+
+  /// \brief Move assignment operator
+  PointerConstraintList& operator=(PointerConstraintList&&) = default;
+
+  /// \brief Destructor
+  ~PointerConstraintList() = default;
+
+  /// \brief Add a pointer constraint
+  void add(std::unique_ptr< PointerConstraint > cst) {
+    this->_csts.push_back(std::move(cst));
+  }
+
+  /// \brief Begin iterator over the constraints
+  Iterator begin() { return this->_csts.begin(); }
+
+  /// \brief End iterator over the constraints
+  Iterator end() { return this->_csts.end(); }
+
+  /// \brief Remove all constraints
+  void clear() { this->_csts.clear(); }
+
+}; // end class PointerConstraintList
+
 /// \brief System of pointer constraints
 class PointerConstraints {
 private:
@@ -99,8 +152,17 @@ public:
   /// \brief Add a pointer constraint
   void add(std::unique_ptr< PointerConstraint > cst);
 
+  /// \brief Add all the pointer constraints of the given list
+  ///
+  /// The list is left empty.
+  void add(PointerConstraintList& csts);
+
   /// \brief Solve pointer constraints
-  void solve();
+  ///
+  /// If `num_threads` is different from 1, independent partitions of
+  /// constraints are solved in parallel, using at most `num_threads` threads
+  /// (or all threads if `num_threads` <= 0).
+  void solve(int num_threads);
 
   /// \brief Export results
   void results(PointerInfo&) const;
@@ -133,8 +195,8 @@ private:
   /// \brief Data layout
   const ar::DataLayout& _data_layout;
 
-  /// \brief System of pointer constraints
-  PointerConstraints& _csts;
+  /// \brief List of pointer constraints
+  PointerConstraintList& _csts;
 
   /// \brief Information about function pointers, or null
   const PointerInfo* _function_pointer;
@@ -142,7 +204,7 @@ private:
 public:
   /// \brief Constructor
   PointerConstraintsGenerator(Context& ctx,
-                              PointerConstraints& csts,
+                              PointerConstraintList& csts,
                               const PointerInfo* function_pointer = nullptr)
       : _ctx(ctx),
         _data_layout(ctx.bundle->data_layout()),
@@ -222,8 +284,8 @@ private:
     /// \brief Literal factory
     LiteralFactory& _lit_factory;
 
-    /// \brief System of pointer constraints
-    PointerConstraints& _csts;
+    /// \brief List of pointer constraints
+    PointerConstraintList& _csts;
 
     /// \brief Information about function pointers
     const PointerInfo* _function_pointer;
@@ -237,7 +299,7 @@ private:
   public:
     /// \brief Constructor
     BasicBlockVisitor(Context& ctx,
-                      PointerConstraints& csts,
+                      PointerConstraintList& csts,
                       const PointerInfo* function_pointer,
                       const CodeInvariants& invariants,
                       AbstractDomainT inv)
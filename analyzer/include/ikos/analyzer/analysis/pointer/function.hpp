@@ -54,6 +54,10 @@
 namespace ikos {
 namespace analyzer {
 
+// forward declaration
+class PointerConstraintList;
+class PointerConstraints;
+
 /// \brief Compute points-to set of function pointers for a whole bundle
 ///
 /// This pass is intended to be used as a pre-step for other analyses.
@@ -87,6 +91,19 @@ public:
   /// \brief Run the analysis
   void run();
 
+  /// \brief Generate the pointer constraints for the given global variable
+  ///
+  /// This can be called concurrently on different global variables.
+  void generate(ar::GlobalVariable* gv, PointerConstraintList& csts);
+
+  /// \brief Generate the pointer constraints for the given function
+  ///
+  /// This can be called concurrently on different functions.
+  void generate(ar::Function* fun, PointerConstraintList& csts);
+
+  /// \brief Solve the given pointer constraints and save the results
+  void solve(PointerConstraints& csts);
+
   /// \brief Dump the function pointer analysis results, for debugging purpose
   void dump(std::ostream& o) const;
 
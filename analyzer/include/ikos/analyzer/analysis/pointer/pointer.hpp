@@ -98,6 +98,21 @@ public:
   /// \brief Run the analysis
   void run();
 
+  /// \brief Generate the pointer constraints for the given global variable
+  ///
+  /// This computes the numerical invariants of the initializer first. It can
+  /// be called concurrently on different global variables.
+  void generate(ar::GlobalVariable* gv, PointerConstraintList& csts);
+
+  /// \brief Generate the pointer constraints for the given function
+  ///
+  /// This computes the numerical invariants of the body first. It can be
+  /// called concurrently on different functions.
+  void generate(ar::Function* fun, PointerConstraintList& csts);
+
+  /// \brief Solve the given pointer constraints and save the results
+  void solve(PointerConstraints& csts);
+
   /// \brief Dump the pointer analysis results, for debugging purpose
   void dump(std::ostream& o) const;
 
@@ -0,0 +1,141 @@
+/*******************************************************************************
+ *
+ * \file
+ * \brief Pre-analyses running concurrently on functions
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <ikos/analyzer/analysis/context.hpp>
+#include <ikos/analyzer/analysis/liveness.hpp>
+#include <ikos/analyzer/analysis/pointer/function.hpp>
+#include <ikos/analyzer/analysis/pointer/pointer.hpp>
+#include <ikos/analyzer/analysis/widening_hint.hpp>
+#include <ikos/analyzer/util/progress.hpp>
+
+namespace ikos {
+namespace analyzer {
+
+/// \brief Run the analyses required by the value analysis, concurrently
+///
+/// Global variables and functions are processed in parallel, in two stages:
+///   * The liveness, the widening hints and the function pointer constraints
+///     of a function are computed by the same task. Then, the function
+///     pointer constraints are solved.
+///   * The numerical invariants and the pointer constraints of a function are
+///     computed by the same task, using the results of the first stage. Then,
+///     the pointer constraints are solved.
+///
+/// Constraints are added to the constraint systems in the order of the bundle,
+/// hence the results are the same as running each analysis sequentially.
+class PreAnalysis {
+private:
+  /// \brief Analysis context
+  Context& _ctx;
+
+  /// \brief Liveness analysis, or null
+  LivenessAnalysis* _liveness;
+
+  /// \brief Widening hint analysis, or null
+  WideningHintAnalysis* _widening_hint;
+
+  /// \brief Function pointer analysis, or null
+  FunctionPointerAnalysis* _function_pointer;
+
+  /// \brief Pointer analysis, or null
+  ///
+  /// This requires the function pointer analysis.
+  PointerAnalysis* _pointer;
+
+public:
+  /// \brief Constructor
+  ///
+  /// A null analysis is not run.
+  PreAnalysis(Context& ctx,
+              LivenessAnalysis* liveness,
+              WideningHintAnalysis* widening_hint,
+              FunctionPointerAnalysis* function_pointer,
+              PointerAnalysis* pointer);
+
+  /// \brief No copy constructor
+  PreAnalysis(const PreAnalysis&) = delete;
+
+  /// \brief No move constructor
+  PreAnalysis(PreAnalysis&&) = delete;
+
+  /// \brief No copy assignment operator
+  PreAnalysis& operator=(const PreAnalysis&) = delete;
+
+  /// \brief No move assignment operator
+  PreAnalysis& operator=(PreAnalysis&&) = delete;
+
+  /// \brief Destructor
+  ~PreAnalysis();
+
+  /// \brief Run the analyses
+  ///
+  /// This updates the context with the results.
+  void run();
+
+private:
+  /// \brief Run the first stage on the given global variable
+  void run_first_stage(ar::GlobalVariable* gv,
+                       PointerConstraintList& csts,
+                       ProgressLogger& progress);
+
+  /// \brief Run the first stage on the given function
+  void run_first_stage(ar::Function* fun,
+                       PointerConstraintList& csts,
+                       ProgressLogger& progress);
+
+  /// \brief Run the second stage on the given global variable
+  void run_second_stage(ar::GlobalVariable* gv,
+                        PointerConstraintList& csts,
+                        ProgressLogger& progress);
+
+  /// \brief Run the second stage on the given function
+  void run_second_stage(ar::Function* fun,
+                        PointerConstraintList& csts,
+                        ProgressLogger& progress);
+
+}; // end class PreAnalysis
+
+} // end namespace analyzer
+} // end namespace ikos
@@ -45,7 +45,14 @@
 
 #pragma once
 
+#include <memory>
+#include <vector>
+
 #include <ikos/analyzer/analysis/context.hpp>
+#include <ikos/analyzer/analysis/value/abstract_domain.hpp>
+#include <ikos/analyzer/analysis/value/interprocedural/concurrent/function_fixpoint.hpp>
+#include <ikos/analyzer/analysis/value/summary_cache.hpp>
+#include <ikos/analyzer/checker/dispatcher.hpp>
 
 namespace ikos {
 namespace analyzer {
@@ -83,6 +90,21 @@ public:
   /// \brief Run the analysis
   void run();
 
+private:
+  /// \brief Analyze and check the given entry point
+  ///
+  /// Called concurrently on different entry points.
+  ///
+  /// \param summary_cache Persistent cache of results, or null
+  /// \param buffer Buffer for the checks, or null to insert them directly in
+  ///   the database. Required if summary_cache is not null.
+  void analyze_entry_point(ar::Function* entry_point,
+                           const AbstractDomain& init_inv,
+                           const CheckerDispatcher& dispatcher,
+                           FunctionFixpoint::FixpointCacheT& callees_cache,
+                           SummaryCache* summary_cache,
+                           ChecksTable::Buffer* buffer);
+
 }; // end class Analysis
 
 } // end namespace concurrent
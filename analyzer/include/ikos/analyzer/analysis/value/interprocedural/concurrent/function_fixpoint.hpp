@@ -45,6 +45,8 @@
 
 #pragma once
 
+#include <boost/filesystem.hpp>
+
 #include <ikos/ar/semantic/code.hpp>
 #include <ikos/ar/semantic/function.hpp>
 
@@ -55,7 +57,7 @@
 #include <ikos/analyzer/analysis/execution_engine/fixpoint_cache.hpp>
 #include <ikos/analyzer/analysis/fixpoint_parameters.hpp>
 #include <ikos/analyzer/analysis/value/abstract_domain.hpp>
-#include <ikos/analyzer/checker/checker.hpp>
+#include <ikos/analyzer/checker/dispatcher.hpp>
 
 namespace ikos {
 namespace analyzer {
@@ -73,6 +75,7 @@ private:
       core::InterleavedConcurrentFwdFixpointIterator< ar::Code*,
                                                       AbstractDomain >;
 
+public:
   /// \brief Function fixpoint cache of callees
   using FixpointCacheT = FixpointCache< FunctionFixpoint, AbstractDomain >;
 
@@ -86,11 +89,14 @@ private:
   /// \brief Current call context
   CallContext* _call_context;
 
+  /// \brief Function fixpoint of the caller, or null
+  const FunctionFixpoint* _caller;
+
   /// \brief Fixpoint parameters
   const CodeFixpointParameters& _fixpoint_parameters;
 
-  /// \brief List of property checks to run
-  const std::vector< std::unique_ptr< Checker > >& _checkers;
+  /// \brief Property checkers to run
+  const CheckerDispatcher& _dispatcher;
 
   /// \brief Mutex for _exit_invariant and _return_stmt
   std::mutex _mutex;
@@ -102,18 +108,39 @@ private:
   ar::ReturnValue* _return_stmt;
 
   /// \brief Function fixpoint cache of callees
-  FixpointCacheT _callees_cache;
+  ///
+  /// Shared by all the function fixpoints, see FixpointCache.
+  FixpointCacheT& _callees_cache;
+
+  /// \brief Temporary file holding the spilled invariants, or empty
+  boost::filesystem::path _spill_file;
 
 public:
   /// \brief Constructor for an entry point
   ///
   /// \param ctx Analysis context
-  /// \param checkers List of checkers to run
+  /// \param dispatcher Property checkers to run
+  /// \param callees_cache Function fixpoint cache of callees
   /// \param entry_point Function to analyze
   FunctionFixpoint(Context& ctx,
-                   const std::vector< std::unique_ptr< Checker > >& checkers,
+                   const CheckerDispatcher& dispatcher,
+                   FixpointCacheT& callees_cache,
                    ar::Function* entry_point);
 
+  /// \brief Constructor for a callee in a merged calling context, to check
+  /// the callee after the entry points
+  ///
+  /// \param ctx Analysis context
+  /// \param dispatcher Property checkers to run
+  /// \param callees_cache Function fixpoint cache of callees
+  /// \param callee Function to analyze
+  /// \param call_context Merged calling context
+  FunctionFixpoint(Context& ctx,
+                   const CheckerDispatcher& dispatcher,
+                   FixpointCacheT& callees_cache,
+                   ar::Function* callee,
+                   CallContext* call_context);
+
   /// \brief Constructor for a callee
   ///
   /// \param ctx Analysis context
@@ -125,6 +152,9 @@ public:
                    ar::CallBase* call,
                    ar::Function* callee);
 
+  /// \brief Destructor
+  ~FunctionFixpoint() override;
+
   /// \brief Compute the fixpoint
   void run(AbstractDomain inv) override;
 
@@ -161,6 +191,9 @@ public:
   void process_post(ar::BasicBlock* bb, const AbstractDomain& post) override;
 
   /// \brief Run the checks with the previously computed fix-point
+  ///
+  /// Basic blocks are checked in parallel. Checks are buffered per basic block
+  /// and inserted in the order of the basic blocks.
   void run_checks();
 
   /// \name Required by InlineCallExecutionEngine
@@ -172,6 +205,10 @@ public:
   /// \brief Return the call context
   CallContext* call_context() const { return this->_call_context; }
 
+  /// \brief Return true if the given function is analyzed by this fixpoint
+  /// or by one of its callers
+  bool in_call_stack(ar::Function* fun) const;
+
   /// \brief Return the exit invariant, or bottom
   const AbstractDomain& exit_invariant() const { return this->_exit_invariant; }
 
@@ -193,8 +230,22 @@ public:
     this->_return_stmt = s;
   }
 
+  /// \brief Write the pre invariants and the exit invariant in a temporary
+  /// file, and release the invariants
+  ///
+  /// Return false if the abstract domain cannot be serialized or the file
+  /// cannot be written, in which case the invariants are kept.
+  bool spill();
+
+  /// \brief Read back the invariants written by spill(), if any
+  void restore();
+
   /// @}
 
+private:
+  /// \brief Run the checks on the given basic block
+  void run_checks(ar::BasicBlock* bb);
+
 }; // end class FunctionFixpoint
 
 } // end namespace concurrent
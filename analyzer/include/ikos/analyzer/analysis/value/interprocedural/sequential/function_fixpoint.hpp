@@ -43,6 +43,10 @@
 
 #pragma once
 
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
 #include <ikos/ar/semantic/code.hpp>
 #include <ikos/ar/semantic/function.hpp>
 #include "ikos/ar/format/namer.hpp"
@@ -55,7 +59,8 @@
 #include <ikos/analyzer/analysis/fixpoint_parameters.hpp>
 #include <ikos/analyzer/analysis/value/abstract_domain.hpp>
 #include <ikos/analyzer/analysis/value/interprocedural/sequential/progress.hpp>
-#include <ikos/analyzer/checker/checker.hpp>
+#include <ikos/analyzer/analysis/value/summary_cache.hpp>
+#include <ikos/analyzer/checker/dispatcher.hpp>
 
 namespace ikos {
 namespace analyzer {
@@ -71,6 +76,7 @@ private:
   using FwdFixpointIterator =
       core::InterleavedFwdFixpointIterator< ar::Code*, AbstractDomain >;
 
+public:
   /// \brief Function fixpoint cache of callees
   using FixpointCacheT = FixpointCache< FunctionFixpoint, AbstractDomain >;
 
@@ -84,11 +90,14 @@ private:
   /// \brief Current call context
   CallContext* _call_context;
 
+  /// \brief Function fixpoint of the caller, or null
+  const FunctionFixpoint* _caller;
+
   /// \brief Fixpoint parameters
   const CodeFixpointParameters& _fixpoint_parameters;
 
-  /// \brief List of property checks to run
-  const std::vector< std::unique_ptr< Checker > >& _checkers;
+  /// \brief Property checkers to run
+  const CheckerDispatcher& _dispatcher;
 
   /// \brief Invariant at the end of the function
   AbstractDomain _exit_invariant;
@@ -96,25 +105,55 @@ private:
   /// \brief Return statement, or null
   ar::ReturnValue* _return_stmt;
 
+  /// \brief Persistent cache of analysis results, or null
+  SummaryCache* _summary_cache;
+
   /// \brief Function fixpoint cache of callees
   FixpointCacheT _callees_cache;
 
+  /// \brief Results of the callees in merged calling contexts
+  ///
+  /// Shared by all the function fixpoints, see FixpointCache.
+  FixpointCacheT& _merged_cache;
+
   /// \brief Progress logger
   ProgressLogger& _logger;
 
   std::unique_ptr< ar::Namer > _namer;
 
+  /// \brief Temporary file holding the spilled invariants, or empty
+  boost::filesystem::path _spill_file;
+
 public:
   /// \brief Constructor for an entry point
   ///
   /// \param ctx Analysis context
-  /// \param checkers List of checkers to run
+  /// \param dispatcher Property checkers to run
+  /// \param merged_cache Results of the callees in merged calling contexts
+  /// \param summary_cache Persistent cache of fixpoints on callees, or null
   /// \param entry_point Function to analyze
   FunctionFixpoint(Context& ctx,
-                   const std::vector< std::unique_ptr< Checker > >& checkers,
+                   const CheckerDispatcher& dispatcher,
                    ProgressLogger& logger,
+                   FixpointCacheT& merged_cache,
+                   SummaryCache* summary_cache,
                    ar::Function* entry_point);
 
+  /// \brief Constructor for a callee in a merged calling context, to check
+  /// the callee after the entry points
+  ///
+  /// \param ctx Analysis context
+  /// \param dispatcher Property checkers to run
+  /// \param merged_cache Results of the callees in merged calling contexts
+  /// \param callee Function to analyze
+  /// \param call_context Merged calling context
+  FunctionFixpoint(Context& ctx,
+                   const CheckerDispatcher& dispatcher,
+                   ProgressLogger& logger,
+                   FixpointCacheT& merged_cache,
+                   ar::Function* callee,
+                   CallContext* call_context);
+
   /// \brief Constructor for a callee
   ///
   /// \param ctx Analysis context
@@ -186,6 +225,16 @@ public:
   /// \brief Return the call context
   CallContext* call_context() const { return this->_call_context; }
 
+  /// \brief Return true if the given function is analyzed by this fixpoint
+  /// or by one of its callers
+  bool in_call_stack(ar::Function* fun) const;
+
+  /// \brief Return the results of the callees in merged calling contexts
+  FixpointCacheT& merged_cache() const { return this->_merged_cache; }
+
+  /// \brief Return the persistent cache of analysis results, or null
+  SummaryCache* summary_cache() const { return this->_summary_cache; }
+
   /// \brief Return the exit invariant, or bottom
   const AbstractDomain& exit_invariant() const { return this->_exit_invariant; }
 
@@ -205,6 +254,31 @@ public:
     this->_return_stmt = s;
   }
 
+  /// \brief Write the pre invariants and the exit invariant in a temporary
+  /// file, and release them
+  ///
+  /// Return false if the abstract domain cannot be serialized or the file
+  /// cannot be written, in which case the invariants are kept.
+  bool spill();
+
+  /// \brief Read back the invariants written by spill(), if any
+  void restore();
+
+  /// \brief Return the invariant at the entry of the function
+  const AbstractDomain& entry_invariant() const {
+    return this->pre(this->cfg()->entry_block());
+  }
+
+  /// \brief Return the pre invariants, in the order of the basic blocks,
+  /// followed by the exit invariant
+  std::vector< AbstractDomain > invariants() const;
+
+  /// \brief Set the invariants of a previous run, instead of running the
+  /// analysis
+  ///
+  /// \param invariants Invariants returned by invariants()
+  void set_invariants(std::vector< AbstractDomain > invariants);
+
   /// @}
 
 }; // end class FunctionFixpoint
@@ -0,0 +1,110 @@
+/*******************************************************************************
+ *
+ * \file
+ * \brief Summary-based interprocedural value analysis
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+
+#include <ikos/analyzer/analysis/context.hpp>
+#include <ikos/analyzer/analysis/value/abstract_domain.hpp>
+#include <ikos/analyzer/analysis/value/interprocedural/summary/function_summary.hpp>
+#include <ikos/analyzer/checker/dispatcher.hpp>
+#include <ikos/analyzer/util/progress.hpp>
+
+namespace ikos {
+namespace analyzer {
+namespace value {
+namespace interprocedural {
+namespace summary {
+
+/// \brief Summary-based interprocedural value analysis
+///
+/// Each function is analyzed once, from an unknown calling context, in a
+/// bottom-up traversal of the call graph. Calls are executed by applying the
+/// summaries of the callees. Strongly connected components that do not depend
+/// on each other are analyzed in parallel.
+class Analysis {
+private:
+  /// \brief Analysis context
+  Context& _ctx;
+
+public:
+  /// \brief Constructor
+  explicit Analysis(Context& ctx);
+
+  /// \brief No copy constructor
+  Analysis(const Analysis&) = delete;
+
+  /// \brief No move constructor
+  Analysis(Analysis&&) = delete;
+
+  /// \brief No copy assignment operator
+  Analysis& operator=(const Analysis&) = delete;
+
+  /// \brief No move assignment operator
+  Analysis& operator=(Analysis&&) = delete;
+
+  /// \brief Destructor
+  ~Analysis();
+
+  /// \brief Run the analysis
+  void run();
+
+private:
+  /// \brief Analyze, check and summarize the functions of the given strongly
+  /// connected component
+  ///
+  /// Called concurrently on components that do not depend on each other.
+  void analyze_scc(std::size_t scc,
+                   SummaryTable& summaries,
+                   const AbstractDomain& init_inv,
+                   const CheckerDispatcher& dispatcher,
+                   ProgressLogger& progress);
+
+}; // end class Analysis
+
+} // end namespace summary
+} // end namespace interprocedural
+} // end namespace value
+} // end namespace analyzer
+} // end namespace ikos
@@ -0,0 +1,195 @@
+/*******************************************************************************
+ *
+ * \file
+ * \brief Fixpoint on a function body using summaries of the callees
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <ikos/ar/semantic/code.hpp>
+#include <ikos/ar/semantic/function.hpp>
+#include <ikos/ar/semantic/statement.hpp>
+
+#include <ikos/core/fixpoint/fwd_fixpoint_iterator.hpp>
+
+#include <ikos/analyzer/analysis/call_context.hpp>
+#include <ikos/analyzer/analysis/context.hpp>
+#include <ikos/analyzer/analysis/fixpoint_parameters.hpp>
+#include <ikos/analyzer/analysis/value/abstract_domain.hpp>
+#include <ikos/analyzer/analysis/value/interprocedural/summary/function_summary.hpp>
+#include <ikos/analyzer/checker/dispatcher.hpp>
+
+namespace ikos {
+namespace analyzer {
+namespace value {
+namespace interprocedural {
+namespace summary {
+
+/// \brief Fixpoint on a function body, using the summaries of the callees
+///
+/// The function is analyzed once, from an unknown calling context.
+class FunctionFixpoint final
+    : public core::InterleavedFwdFixpointIterator< ar::Code*, AbstractDomain > {
+private:
+  /// \brief Parent class
+  using FwdFixpointIterator =
+      core::InterleavedFwdFixpointIterator< ar::Code*, AbstractDomain >;
+
+private:
+  /// \brief Analysis context
+  Context& _ctx;
+
+  /// \brief Analyzed function
+  ar::Function* _function;
+
+  /// \brief Empty call context
+  CallContext* _empty_call_context;
+
+  /// \brief Fixpoint parameters
+  const CodeFixpointParameters& _fixpoint_parameters;
+
+  /// \brief Summaries of the callees
+  const SummaryTable& _summaries;
+
+  /// \brief Invariant at the end of the function
+  AbstractDomain _exit_invariant;
+
+  /// \brief Return statement, or null
+  ar::ReturnValue* _return_stmt;
+
+public:
+  /// \brief Create a function fixpoint iterator
+  FunctionFixpoint(Context& ctx,
+                   const SummaryTable& summaries,
+                   ar::Function* function);
+
+  /// \brief Compute the fixpoint
+  ///
+  /// The parameters are assumed initialized, and their values are saved in
+  /// shadow variables for the summary.
+  void run(AbstractDomain inv) override;
+
+  /// \brief Extrapolate the new state after an increasing iteration
+  AbstractDomain extrapolate(ar::BasicBlock* head,
+                             unsigned iteration,
+                             const AbstractDomain& before,
+                             const AbstractDomain& after) override;
+
+  /// \brief Refine the new state after a decreasing iteration
+  AbstractDomain refine(ar::BasicBlock* head,
+                        unsigned iteration,
+                        const AbstractDomain& before,
+                        const AbstractDomain& after) override;
+
+  /// \brief Check if the decreasing iterations fixpoint is reached
+  bool is_decreasing_iterations_fixpoint(ar::BasicBlock* head,
+                                         unsigned iteration,
+                                         const AbstractDomain& before,
+                                         const AbstractDomain& after) override;
+
+  /// \brief Propagate the invariant through the basic block
+  AbstractDomain analyze_node(ar::BasicBlock* bb, AbstractDomain pre) override;
+
+  /// \brief Propagate the invariant through an edge
+  AbstractDomain analyze_edge(ar::BasicBlock* src,
+                              ar::BasicBlock* dest,
+                              AbstractDomain pre) override;
+
+  /// \brief Process the computed abstract value for a node
+  void process_pre(ar::BasicBlock* bb, const AbstractDomain& pre) override;
+
+  /// \brief Process the computed abstract value for a node
+  void process_post(ar::BasicBlock* bb, const AbstractDomain& post) override;
+
+  /// \brief Run the checks with the previously computed fix-point
+  void run_checks(const CheckerDispatcher& dispatcher);
+
+  /// \brief Build the summary of the function from the fix-point
+  std::unique_ptr< FunctionSummary > summary() const;
+
+  /// \name Required by SummaryCallExecutionEngine
+  /// @{
+
+  /// \brief Return the function
+  ar::Function* function() const { return this->_function; }
+
+  /// \brief Return the summary of the given callee, or null
+  const FunctionSummary* callee_summary(ar::Function* callee) const {
+    return this->_summaries.get(this->_function, callee);
+  }
+
+  /// \brief Set the exit invariant
+  void set_exit_invariant(AbstractDomain invariant) {
+    invariant.normalize();
+    this->_exit_invariant = std::move(invariant);
+  }
+
+  /// \brief Set the return statement
+  void set_return_stmt(ar::ReturnValue* s) {
+    ikos_assert_msg(this->_return_stmt == nullptr || this->_return_stmt == s,
+                    "code has more than one return statement");
+    this->_return_stmt = s;
+  }
+
+  /// @}
+
+private:
+  /// \brief Return the shadow variable holding the value of the i-th
+  /// parameter at the entry of the function, or null if it is not a scalar
+  Variable* parameter_shadow(std::size_t i) const;
+
+  /// \brief Return true if the function might write in the memory of its
+  /// callers
+  bool may_write_memory() const;
+
+  /// \brief Return the dynamic allocations of the function and its callees
+  std::vector< MemoryLocation* > allocations() const;
+
+}; // end class FunctionFixpoint
+
+} // end namespace summary
+} // end namespace interprocedural
+} // end namespace value
+} // end namespace analyzer
+} // end namespace ikos
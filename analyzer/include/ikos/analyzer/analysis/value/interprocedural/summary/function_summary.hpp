@@ -0,0 +1,173 @@
+/*******************************************************************************
+ *
+ * \file
+ * \brief Function summaries for the summary-based interprocedural analysis
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include <ikos/ar/semantic/function.hpp>
+#include <ikos/ar/semantic/statement.hpp>
+
+#include <ikos/analyzer/analysis/call_graph.hpp>
+#include <ikos/analyzer/analysis/memory_location.hpp>
+#include <ikos/analyzer/analysis/value/abstract_domain.hpp>
+
+namespace ikos {
+namespace analyzer {
+namespace value {
+namespace interprocedural {
+namespace summary {
+
+/// \brief Summary of a function
+///
+/// The summary is the invariant at the exit of the function, computed from an
+/// unknown calling context. The parameters are kept in the exit invariant with
+/// their value at the entry of the function, so that a relational domain can
+/// relate the returned value to the parameters.
+class FunctionSummary {
+private:
+  /// \brief Invariant at the exit of the function, on the normal flow
+  MemoryAbstractDomain _exit_invariant;
+
+  /// \brief Return statement, or null
+  ar::ReturnValue* _return_stmt;
+
+  /// \brief Dynamic allocations of the function and its callees
+  std::vector< MemoryLocation* > _allocations;
+
+  /// \brief True if the function might write in the memory of its callers
+  bool _may_write_memory;
+
+  /// \brief True if the function might throw exceptions
+  bool _may_throw_exceptions;
+
+public:
+  /// \brief Constructor
+  FunctionSummary(MemoryAbstractDomain exit_invariant,
+                  ar::ReturnValue* return_stmt,
+                  std::vector< MemoryLocation* > allocations,
+                  bool may_write_memory,
+                  bool may_throw_exceptions)
+      : _exit_invariant(std::move(exit_invariant)),
+        _return_stmt(return_stmt),
+        _allocations(std::move(allocations)),
+        _may_write_memory(may_write_memory),
+        _may_throw_exceptions(may_throw_exceptions) {}
+
+  /// \brief Return the invariant at the exit of the function
+  const MemoryAbstractDomain& exit_invariant() const {
+    return this->_exit_invariant;
+  }
+
+  /// \brief Return the return statement, or null
+  ar::ReturnValue* return_stmt() const { return this->_return_stmt; }
+
+  /// \brief Return the dynamic allocations of the function and its callees
+  ///
+  /// These memory locations are allocated again on each call.
+  const std::vector< MemoryLocation* >& allocations() const {
+    return this->_allocations;
+  }
+
+  /// \brief Return true if the function might write in the memory of its
+  /// callers
+  bool may_write_memory() const { return this->_may_write_memory; }
+
+  /// \brief Return true if the function might throw exceptions
+  bool may_throw_exceptions() const { return this->_may_throw_exceptions; }
+
+}; // end class FunctionSummary
+
+/// \brief Summaries of the function definitions of a bundle
+///
+/// The summary of a function is set once, by the task analyzing its strongly
+/// connected component.
+class SummaryTable {
+private:
+  /// \brief Call graph
+  const CallGraph& _call_graph;
+
+  /// \brief Summaries, indexed by function index in the call graph
+  std::vector< std::unique_ptr< FunctionSummary > > _summaries;
+
+public:
+  /// \brief Constructor
+  explicit SummaryTable(const CallGraph& call_graph);
+
+  /// \brief No copy constructor
+  SummaryTable(const SummaryTable&) = delete;
+
+  /// \brief No move constructor
+  SummaryTable(SummaryTable&&) = delete;
+
+  /// \brief No copy assignment operator
+  SummaryTable& operator=(const SummaryTable&) = delete;
+
+  /// \brief No move assignment operator
+  SummaryTable& operator=(SummaryTable&&) = delete;
+
+  /// \brief Destructor
+  ~SummaryTable();
+
+  /// \brief Return the call graph
+  const CallGraph& call_graph() const { return this->_call_graph; }
+
+  /// \brief Return the summary of `callee` for a call in `caller`, or null
+  ///
+  /// Only the summaries of functions in a component called by the component of
+  /// `caller`, or in the same component and already computed, are returned.
+  /// Hence the result does not depend on the order in which independent
+  /// components are analyzed.
+  const FunctionSummary* get(ar::Function* caller, ar::Function* callee) const;
+
+  /// \brief Set the summary of the given function
+  void set(ar::Function* fun, std::unique_ptr< FunctionSummary > summary);
+
+}; // end class SummaryTable
+
+} // end namespace summary
+} // end namespace interprocedural
+} // end namespace value
+} // end namespace analyzer
+} // end namespace ikos
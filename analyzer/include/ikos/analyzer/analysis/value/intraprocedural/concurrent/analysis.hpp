@@ -45,7 +45,14 @@
 
 #pragma once
 
+#include <memory>
+#include <vector>
+
 #include <ikos/analyzer/analysis/context.hpp>
+#include <ikos/analyzer/analysis/value/abstract_domain.hpp>
+#include <ikos/analyzer/analysis/value/summary_cache.hpp>
+#include <ikos/analyzer/checker/dispatcher.hpp>
+#include <ikos/analyzer/util/progress.hpp>
 
 namespace ikos {
 namespace analyzer {
@@ -81,6 +88,18 @@ public:
   /// \brief Run the analysis
   void run();
 
+private:
+  /// \brief Analyze and check the given function
+  ///
+  /// Called concurrently on different functions.
+  ///
+  /// \param summary_cache Persistent cache of results, or null
+  void analyze_function(ar::Function* function,
+                        const AbstractDomain& init_inv,
+                        const CheckerDispatcher& dispatcher,
+                        ProgressLogger& progress,
+                        SummaryCache* summary_cache);
+
 }; // end class Analysis
 
 } // end namespace concurrent
@@ -54,7 +54,7 @@
 #include <ikos/analyzer/analysis/context.hpp>
 #include <ikos/analyzer/analysis/fixpoint_parameters.hpp>
 #include <ikos/analyzer/analysis/value/abstract_domain.hpp>
-#include <ikos/analyzer/checker/checker.hpp>
+#include <ikos/analyzer/checker/dispatcher.hpp>
 
 namespace ikos {
 namespace analyzer {
@@ -122,7 +122,14 @@ public:
   void process_post(ar::BasicBlock* bb, const AbstractDomain& post) override;
 
   /// \brief Run the checks with the previously computed fix-point
-  void run_checks(const std::vector< std::unique_ptr< Checker > >& checkers);
+  ///
+  /// Basic blocks are checked in parallel. Checks are buffered per basic block
+  /// and inserted in the order of the basic blocks.
+  void run_checks(const CheckerDispatcher& dispatcher);
+
+private:
+  /// \brief Run the checks on the given basic block
+  void run_checks(const CheckerDispatcher& dispatcher, ar::BasicBlock* bb);
 
 }; // end class FunctionFixpoint
 
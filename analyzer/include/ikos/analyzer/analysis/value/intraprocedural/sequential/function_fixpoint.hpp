@@ -52,7 +52,7 @@
 #include <ikos/analyzer/analysis/context.hpp>
 #include <ikos/analyzer/analysis/fixpoint_parameters.hpp>
 #include <ikos/analyzer/analysis/value/abstract_domain.hpp>
-#include <ikos/analyzer/checker/checker.hpp>
+#include <ikos/analyzer/checker/dispatcher.hpp>
 
 namespace ikos {
 namespace analyzer {
@@ -118,7 +118,7 @@ public:
   void process_post(ar::BasicBlock* bb, const AbstractDomain& post) override;
 
   /// \brief Run the checks with the previously computed fix-point
-  void run_checks(const std::vector< std::unique_ptr< Checker > >& checkers);
+  void run_checks(const CheckerDispatcher& dispatcher);
 
 }; // end class FunctionFixpoint
 
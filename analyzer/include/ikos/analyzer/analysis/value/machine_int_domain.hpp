@@ -71,6 +71,13 @@ MachineIntAbstractDomain make_bottom_machine_int_interval_congruence();
 MachineIntAbstractDomain make_top_machine_int_dbm();
 MachineIntAbstractDomain make_bottom_machine_int_dbm();
 
+MachineIntAbstractDomain make_top_machine_int_split_dbm();
+MachineIntAbstractDomain make_bottom_machine_int_split_dbm();
+MachineIntAbstractDomain make_top_machine_int_fixed_width_dbm();
+MachineIntAbstractDomain make_bottom_machine_int_fixed_width_dbm();
+MachineIntAbstractDomain make_top_machine_int_fixed_width_octagon();
+MachineIntAbstractDomain make_bottom_machine_int_fixed_width_octagon();
+
 MachineIntAbstractDomain make_top_machine_int_var_pack_dbm();
 MachineIntAbstractDomain make_bottom_machine_int_var_pack_dbm();
 
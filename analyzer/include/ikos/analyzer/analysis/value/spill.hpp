@@ -0,0 +1,98 @@
+/*******************************************************************************
+ *
+ * \file
+ * \brief Spilling of invariants to temporary files
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <string>
+
+#include <boost/filesystem.hpp>
+
+#include <ikos/core/serialization/memory.hpp>
+
+#include <ikos/analyzer/analysis/context.hpp>
+#include <ikos/analyzer/analysis/memory_location.hpp>
+#include <ikos/analyzer/analysis/variable.hpp>
+
+namespace ikos {
+namespace analyzer {
+namespace value {
+
+/// \brief Resolver of the variables and memory locations of spilled
+/// invariants
+///
+/// Spilled invariants refer to variables and memory locations by their index
+/// in the factories, see `VariableFactory::get_by_index()`.
+class SpillResolver {
+private:
+  Context& _ctx;
+
+public:
+  /// \brief Constructor
+  explicit SpillResolver(Context& ctx) : _ctx(ctx) {}
+
+  /// \brief Resolve a variable
+  Variable* operator()(core::Index index,
+                       core::serialization::Tag< Variable* >) const;
+
+  /// \brief Resolve a memory location
+  MemoryLocation* operator()(core::Index index,
+                             core::serialization::Tag< MemoryLocation* >) const;
+
+}; // end class SpillResolver
+
+/// \brief Write the given bytes in a new temporary file
+///
+/// Return the path of the file, or an empty path if it cannot be written.
+boost::filesystem::path write_spill_file(const std::string& bytes);
+
+/// \brief Read and remove a file written by `write_spill_file()`
+///
+/// \throws LogicError if the file cannot be read
+std::string read_spill_file(const boost::filesystem::path& path);
+
+/// \brief Remove a file written by `write_spill_file()`, if any
+void remove_spill_file(const boost::filesystem::path& path);
+
+} // end namespace value
+} // end namespace analyzer
+} // end namespace ikos
@@ -0,0 +1,317 @@
+/*******************************************************************************
+ *
+ * \file
+ * \brief Persistent cache of analysis results
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include <llvm/ADT/DenseMap.h>
+
+#include <ikos/ar/semantic/function.hpp>
+#include <ikos/ar/semantic/statement.hpp>
+#include <ikos/ar/semantic/value.hpp>
+
+#include <ikos/core/serialization/stream.hpp>
+
+#include <ikos/analyzer/analysis/call_context.hpp>
+#include <ikos/analyzer/analysis/context.hpp>
+#include <ikos/analyzer/analysis/memory_location.hpp>
+#include <ikos/analyzer/analysis/value/abstract_domain.hpp>
+#include <ikos/analyzer/analysis/variable.hpp>
+#include <ikos/analyzer/database/table/checks.hpp>
+
+namespace ikos {
+namespace analyzer {
+namespace value {
+
+/// \brief Persistent on-disk cache of analysis results
+///
+/// The cache is a directory of files named after hashes of everything the
+/// stored results depend on, including the analysis options and the data
+/// layout.
+///
+/// In interprocedural mode, every function and global variable has a key,
+/// computed from its own definition and the keys of the functions and global
+/// variables it refers to. Functions in a recursive cycle share the hash of
+/// the whole cycle. The definition of a function includes its body and, with
+/// the pointer analysis, the points-to sets of its internal variables. Editing
+/// a function only changes the keys of the functions that can reach it.
+///
+/// The cache holds:
+///
+///   * The check results of an entry point, keyed on the keys of the entry
+///     point and of the global constructors.
+///   * The invariants of fixpoints on called functions, keyed on the key of
+///     the callee and the call context. A callee analyzed again on an equal
+///     entry invariant reuses the stored invariants, including the exit
+///     invariant, instead of being analyzed.
+///
+/// In intraprocedural mode, callees are not analyzed, so the check results of
+/// a function are keyed on its own definition and the declarations of the
+/// functions and global variables it refers to.
+///
+/// Check results referring to rows of the output database (e.g, points-to
+/// sets of warnings) are not cached, see
+/// `ChecksTable::Buffer::refers_to_rows()`.
+class SummaryCache {
+private:
+  /// \brief Maximum number of fixpoints stored per callee and call context
+  static constexpr std::size_t MaxFixpoints = 4;
+
+  /// \brief Fixpoint on a called function, stored by a run
+  struct Fixpoint {
+    /// \brief Encoded descriptions of the variables and memory locations
+    std::string refs;
+
+    /// \brief Encoded entry invariant
+    std::string entry;
+
+    /// \brief Encoded invariants
+    std::string invariants;
+
+    /// \brief True if the descriptions or the entry invariant could not be
+    /// read in this run
+    bool invalid = false;
+
+    /// \brief Variables, by index in the run that stored the fixpoint
+    llvm::DenseMap< core::Index, Variable* > variables;
+
+    /// \brief Memory locations, by index in the run that stored the fixpoint
+    llvm::DenseMap< core::Index, MemoryLocation* > memory_locations;
+
+    /// \brief Decoded entry invariant, or null
+    std::unique_ptr< AbstractDomain > entry_inv;
+  };
+
+private:
+  /// \brief Analysis context
+  Context& _ctx;
+
+  /// \brief Cache directory
+  boost::filesystem::path _directory;
+
+  /// \brief Hash of the options and the data layout
+  std::string _common_hash;
+
+  /// \brief Position of local and internal variables in their function or
+  /// global variable initializer
+  llvm::DenseMap< ar::Value*, std::size_t > _positions;
+
+  /// \brief Keys of the functions, in interprocedural mode
+  llvm::DenseMap< ar::Function*, std::string > _function_keys;
+
+  /// \brief Keys of the global variables, in interprocedural mode
+  llvm::DenseMap< ar::GlobalVariable*, std::string > _global_keys;
+
+  /// \brief Mutex protecting the fixpoints
+  std::mutex _fixpoints_mutex;
+
+  /// \brief Fixpoints on called functions, by key
+  std::unordered_map< std::string, std::vector< Fixpoint > > _fixpoints;
+
+  /// \brief Keys of the fixpoints stored by this run
+  std::unordered_set< std::string > _stored_fixpoints;
+
+public:
+  /// \brief Constructor
+  ///
+  /// \param ctx Analysis context
+  /// \param directory Cache directory, created if it does not exist
+  SummaryCache(Context& ctx, boost::filesystem::path directory);
+
+  /// \brief No copy constructor
+  SummaryCache(const SummaryCache&) = delete;
+
+  /// \brief No move constructor
+  SummaryCache(SummaryCache&&) = delete;
+
+  /// \brief No copy assignment operator
+  SummaryCache& operator=(const SummaryCache&) = delete;
+
+  /// \brief No move assignment operator
+  SummaryCache& operator=(SummaryCache&&) = delete;
+
+  /// \brief Destructor
+  ///
+  /// Write the fixpoints stored by this run.
+  ~SummaryCache();
+
+  /// \brief Return the key of an entry point, for interprocedural analyses
+  ///
+  /// Return an empty string if the results of the entry point cannot be
+  /// cached.
+  std::string entry_point_key(ar::Function* entry_point) const;
+
+  /// \brief Return the key of a function
+  ///
+  /// Return an empty string if the results of the function cannot be cached.
+  std::string function_key(ar::Function* fun) const;
+
+  /// \brief Load the check results for the given key
+  ///
+  /// \returns true on success, false if the key is not in the cache
+  bool load(const std::string& key, ChecksTable::Buffer& buffer) const;
+
+  /// \brief Store the check results for the given key, if possible
+  void store(const std::string& key, const ChecksTable::Buffer& buffer) const;
+
+  /// \brief Load the invariants of a fixpoint on a called function
+  ///
+  /// \param callee Called function
+  /// \param context Call context of the fixpoint
+  /// \param entry_inv Invariant at the entry of the callee
+  /// \param invariants Set to the invariants given to store_fixpoint()
+  ///
+  /// \returns true on success, false if there is no fixpoint on `callee` in
+  /// the call context `context` with an entry invariant equal to `entry_inv`
+  bool load_fixpoint(ar::Function* callee,
+                     CallContext* context,
+                     const AbstractDomain& entry_inv,
+                     std::vector< AbstractDomain >& invariants);
+
+  /// \brief Store the invariants of a fixpoint on a called function, if
+  /// possible
+  ///
+  /// Only the `MaxFixpoints` most recent fixpoints are kept for a callee and
+  /// a call context.
+  ///
+  /// \param callee Called function
+  /// \param context Call context of the fixpoint
+  /// \param entry_inv Invariant at the entry of the callee
+  /// \param invariants Invariants of the fixpoint
+  void store_fixpoint(ar::Function* callee,
+                      CallContext* context,
+                      const AbstractDomain& entry_inv,
+                      const std::vector< AbstractDomain >& invariants);
+
+private:
+  /// \brief Compute the keys of all functions and global variables
+  void compute_keys();
+
+  /// \brief Return the hash of the definition of a function
+  ///
+  /// Add the functions whose address can be taken by the internal variables
+  /// of the function, according to the pointer analysis, in `functions`.
+  std::string own_hash(ar::Function* fun,
+                       std::vector< ar::Function* >& functions) const;
+
+  /// \brief Return the key of the fixpoints on `callee` in `context`, or an
+  /// empty string
+  std::string fixpoint_key(ar::Function* callee, CallContext* context) const;
+
+  /// \brief Return the fixpoints for the given key, reading the cache file
+  /// if needed
+  ///
+  /// The fixpoints mutex must be held.
+  std::vector< Fixpoint >& fixpoints(const std::string& key);
+
+  /// \brief Resolve the descriptions and decode the entry invariant of a
+  /// fixpoint, if needed
+  ///
+  /// \returns false if the fixpoint cannot be used in this run
+  bool decode_entry(Fixpoint& fixpoint) const;
+
+  /// \brief Write the fixpoints for the given key in the cache file
+  void write_fixpoints(const std::string& key,
+                       const std::vector< Fixpoint >& fixpoints) const;
+
+  /// \brief Write a description of a variable that does not depend on the run
+  ///
+  /// \returns false if the variable cannot be described
+  bool write_variable(core::serialization::Encoder& e, Variable* var) const;
+
+  /// \brief Write a description of a memory location that does not depend on
+  /// the run
+  ///
+  /// \param with_keys Also write the key of function memory locations
+  ///
+  /// \returns false if the memory location cannot be described
+  bool write_memory_location(core::serialization::Encoder& e,
+                             MemoryLocation* mem,
+                             bool with_keys = true) const;
+
+  /// \brief Write a description of a call context that does not depend on
+  /// the run
+  bool write_call_context(core::serialization::Encoder& e,
+                          CallContext* context) const;
+
+  /// \brief Write a description of an internal variable that does not
+  /// depend on the run
+  bool write_internal_variable(core::serialization::Encoder& e,
+                               ar::InternalVariable* iv) const;
+
+  /// \brief Read a variable written by write_variable(), or return null
+  Variable* read_variable(core::serialization::Decoder& d) const;
+
+  /// \brief Read a memory location written by write_memory_location(), or
+  /// return null
+  MemoryLocation* read_memory_location(core::serialization::Decoder& d) const;
+
+  /// \brief Read a call context written by write_call_context(), or return
+  /// null
+  CallContext* read_call_context(core::serialization::Decoder& d) const;
+
+  /// \brief Read an internal variable written by write_internal_variable(),
+  /// or return null
+  ar::InternalVariable* read_internal_variable(
+      core::serialization::Decoder& d) const;
+
+  /// \brief Return the local variable at the given position, or null
+  ar::LocalVariable* local_variable(ar::Function* fun,
+                                    std::size_t position) const;
+
+}; // end class SummaryCache
+
+} // end namespace value
+} // end namespace analyzer
+} // end namespace ikos
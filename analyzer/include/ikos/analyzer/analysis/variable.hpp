@@ -45,13 +45,18 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstdint>
 #include <memory>
 #include <string>
-#include <unordered_map>
+#include <tuple>
 
 #include <boost/thread/mutex.hpp>
 #include <boost/thread/shared_mutex.hpp>
 
+#include <tbb/concurrent_unordered_map.h>
+#include <tbb/concurrent_vector.h>
+
 #include <llvm/ADT/DenseMap.h>
 #include <llvm/ADT/StringMap.h>
 #include <llvm/ADT/StringRef.h>
@@ -116,10 +121,16 @@ public:
     _EndShadowVariableKind,
   };
 
+public:
+  friend class VariableFactory;
+
 protected:
   /// \brief Kind of the variable
   VariableKind _kind;
 
+  /// \brief Unique index of the variable, assigned by the VariableFactory
+  std::uint32_t _index;
+
   /// \brief Type of the variable
   ar::Type* _type;
 
@@ -149,6 +160,11 @@ public:
   /// \brief Return the kind of the object
   VariableKind kind() const { return this->_kind; }
 
+  /// \brief Return the unique index of the variable
+  ///
+  /// Indexes are dense and given in order of creation.
+  std::uint32_t index() const { return this->_index; }
+
   /// \brief Return the type of the variable
   ar::Type* type() const { return this->_type; }
 
@@ -465,47 +481,68 @@ private:
   /// This is an unsigned integer with the bit-width of a pointer
   ar::IntegerType* _size_type;
 
-  boost::shared_mutex _local_variable_mutex;
+  /// \brief Index of the next created variable
+  std::atomic< std::uint32_t > _next_index;
 
-  llvm::DenseMap< ar::LocalVariable*, std::unique_ptr< LocalVariable > >
-      _local_variable_map;
+  /// \brief Variables, by index
+  tbb::concurrent_vector< Variable* > _index_map;
 
-  boost::shared_mutex _global_variable_mutex;
+  /// \brief Variables of the bundle, created by the constructor
+  ///
+  /// These maps are not modified after the constructor, hence lookups do not
+  /// need any synchronization. They are faster than lookups in the concurrent
+  /// maps below, which only hold the variables created afterwards.
+  llvm::DenseMap< ar::LocalVariable*, std::unique_ptr< LocalVariable > >
+      _bundle_local_variable_map;
 
   llvm::DenseMap< ar::GlobalVariable*, std::unique_ptr< GlobalVariable > >
-      _global_variable_map;
-
-  boost::shared_mutex _internal_variable_mutex;
+      _bundle_global_variable_map;
 
   llvm::DenseMap< ar::InternalVariable*, std::unique_ptr< InternalVariable > >
-      _internal_variable_map;
+      _bundle_internal_variable_map;
 
-  boost::shared_mutex _inline_asm_pointer_mutex;
+  llvm::DenseMap< ar::Function*, std::unique_ptr< FunctionPointerVariable > >
+      _bundle_function_pointer_map;
 
-  llvm::DenseMap< ar::InlineAssemblyConstant*,
-                  std::unique_ptr< InlineAssemblyPointerVariable > >
-      _inline_asm_pointer_map;
+  /// \brief Mutex held when creating a variable
+  ///
+  /// Lookups in the concurrent maps below do not take any lock. The mutex is
+  /// only held on a miss, to create the variable and insert it.
+  boost::mutex _creation_mutex;
 
-  boost::shared_mutex _function_pointer_mutex;
+  tbb::concurrent_unordered_map< ar::LocalVariable*,
+                                 std::unique_ptr< LocalVariable > >
+      _local_variable_map;
 
-  llvm::DenseMap< ar::Function*, std::unique_ptr< FunctionPointerVariable > >
-      _function_pointer_map;
+  tbb::concurrent_unordered_map< ar::GlobalVariable*,
+                                 std::unique_ptr< GlobalVariable > >
+      _global_variable_map;
 
-  boost::shared_mutex _cell_mutex;
+  tbb::concurrent_unordered_map< ar::InternalVariable*,
+                                 std::unique_ptr< InternalVariable > >
+      _internal_variable_map;
 
-  std::unordered_map< std::tuple< MemoryLocation*, MachineInt, MachineInt >,
-                      std::unique_ptr< CellVariable >,
-                      CellMapKeyHash >
-      _cell_map;
+  tbb::concurrent_unordered_map<
+      ar::InlineAssemblyConstant*,
+      std::unique_ptr< InlineAssemblyPointerVariable > >
+      _inline_asm_pointer_map;
 
-  boost::shared_mutex _alloc_size_mutex;
+  tbb::concurrent_unordered_map< ar::Function*,
+                                 std::unique_ptr< FunctionPointerVariable > >
+      _function_pointer_map;
 
-  llvm::DenseMap< MemoryLocation*, std::unique_ptr< AllocSizeVariable > >
-      _alloc_size_map;
+  tbb::concurrent_unordered_map<
+      std::tuple< MemoryLocation*, MachineInt, MachineInt >,
+      std::unique_ptr< CellVariable >,
+      CellMapKeyHash >
+      _cell_map;
 
-  boost::shared_mutex _return_variable_mutex;
+  tbb::concurrent_unordered_map< MemoryLocation*,
+                                 std::unique_ptr< AllocSizeVariable > >
+      _alloc_size_map;
 
-  llvm::DenseMap< ar::Function*, std::unique_ptr< ReturnVariable > >
+  tbb::concurrent_unordered_map< ar::Function*,
+                                 std::unique_ptr< ReturnVariable > >
       _return_variable_map;
 
   boost::shared_mutex _named_shadow_variable_mutex;
@@ -520,6 +557,9 @@ private:
 
 public:
   /// \brief Constructor
+  ///
+  /// Create the variables of all local variables, global variables, internal
+  /// variables and functions of the bundle, in order.
   explicit VariableFactory(ar::Bundle* bundle);
 
   /// \brief No copy constructor
@@ -574,6 +614,25 @@ public:
   /// \brief Create a new UnnamedShadowVariable
   UnnamedShadowVariable* create_unnamed_shadow(ar::Type* type);
 
+  /// \brief Return the variable with the given index, or null
+  Variable* get_by_index(std::uint32_t index) const;
+
+private:
+  /// \brief Move the variables of a concurrent map into a map of the bundle
+  template < typename Map, typename BundleMap >
+  static void move_to_bundle_map(Map& map, BundleMap& bundle_map);
+
+  /// \brief Insert a new variable in the given map, under _creation_mutex
+  ///
+  /// Return the variable already in the map if there is one.
+  template < typename Map, typename Key, typename Create >
+  typename Map::mapped_type::element_type* insert(Map& map,
+                                                  const Key& key,
+                                                  Create create);
+
+  /// \brief Give the next indexes to a new variable and its offset variable
+  void set_index(Variable* var);
+
 }; // end class VariableFactory
 
 } // end namespace analyzer
@@ -584,13 +643,10 @@ namespace core {
 
 /// \brief Implement IndexableTraits for Variable*
 ///
-/// The index of Variable* is the address of the pointer.
+/// The index of Variable* is the index given by the VariableFactory.
 template <>
 struct IndexableTraits< analyzer::Variable* > {
-  static Index index(const analyzer::Variable* v) {
-    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
-    return reinterpret_cast< Index >(v);
-  }
+  static Index index(const analyzer::Variable* v) { return v->index(); }
 };
 
 /// \brief Implement DumpableTraits for Variable*
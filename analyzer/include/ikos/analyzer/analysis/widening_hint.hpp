@@ -94,8 +94,9 @@ public:
   /// \brief Run the analysis
   void run();
 
-private:
   /// \brief Run the analysis on the given function
+  ///
+  /// This can be called concurrently on different functions.
   void run(ar::Function*);
 
 }; // end class WideningHintAnalysis
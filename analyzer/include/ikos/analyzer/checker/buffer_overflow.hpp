@@ -45,6 +45,7 @@
 
 #include <utility>
 
+#include <llvm/ADT/STLExtras.h>
 #include <llvm/ADT/SmallVector.h>
 
 #include <ikos/analyzer/checker/checker.hpp>
@@ -108,9 +109,14 @@ public:
   /// \brief Get the checker description
   const char* description() const override;
 
+  /// \brief Return true if the checker needs to check statements of the
+  /// given kind
+  bool handles(ar::Statement::StatementKind kind) const override;
+
   /// \brief Check a statement
   void check(ar::Statement* stmt,
              const value::AbstractDomain& inv,
+             QueryCache& queries,
              CallContext* call_context) override;
 
 private:
@@ -130,11 +136,12 @@ private:
 
   /// \brief Check a function call
   std::vector< CheckResult > check_call(ar::CallBase* call,
-                                        const value::AbstractDomain& inv);
+                                        QueryCache& queries);
 
   /// \brief Check an intrinsic function call
-  std::vector< CheckResult > check_intrinsic_call(
-      ar::CallBase* call, ar::Function* fun, const value::AbstractDomain& inv);
+  std::vector< CheckResult > check_intrinsic_call(ar::CallBase* call,
+                                                  ar::Function* fun,
+                                                  QueryCache& queries);
 
   /// \brief Check a memory access (read/write) for buffer overflow
   ///
@@ -156,7 +163,7 @@ private:
                                ar::Value* pointer,
                                ar::Value* access_size,
                                Result if_null,
-                               value::AbstractDomain inv);
+                               QueryCache& queries);
 
   /// \brief Check a memory access (read/write) at the given memory location
   ///
@@ -168,23 +175,28 @@ private:
   /// \param stmt The statement
   /// \param pointer The pointer operand
   /// \param access_size The access size operand (in bytes)
-  /// \param inv The invariant
+  /// \param queries The queries on the invariant
+  /// \param refined_inv Return the invariant with the pointer offset and the
+  ///   shadow variable equal to offset + access size, created on demand
   /// \param addr The memory location
   /// \param size_var The allocation size variable
   /// \param offset_var The pointer offset variable
   /// \param offset_plus_size The shadow variable equal to offset + access size
   /// \param offset_intv The pointer offset interval
+  /// \param access_size_intv The access size interval
   /// \param block_info JSON dictionary to add extra information
   MemoryLocationCheckResult check_memory_location_access(
       ar::Statement* stmt,
       ar::Value* pointer,
       ar::Value* access_size,
-      const value::AbstractDomain& inv,
+      QueryCache& queries,
+      llvm::function_ref< value::AbstractDomain&() > refined_inv,
       MemoryLocation* addr,
       AllocSizeVariable* size_var,
       Variable* offset_var,
       Variable* offset_plus_size,
       const IntInterval& offset_intv,
+      const IntInterval& access_size_intv,
       JsonDict& block_info);
 
   /// \brief Check a string access (read/write) for buffer overflow
@@ -198,7 +210,7 @@ private:
   CheckResult check_string_access(ar::Statement* stmt,
                                   ar::Value* pointer,
                                   Result if_null,
-                                  const value::AbstractDomain& inv);
+                                  QueryCache& queries);
 
   /// \brief Check a string access (read/write) for buffer overflow
   ///
@@ -213,7 +225,7 @@ private:
                                   ar::Value* pointer,
                                   ar::Value* max_access_size,
                                   Result if_null,
-                                  const value::AbstractDomain& inv);
+                                  QueryCache& queries);
 
   /// \brief Check a `va_list` access (read/write) for buffer overflow
   ///
@@ -224,7 +236,7 @@ private:
   /// \param inv The invariant
   CheckResult check_va_list_access(ar::Statement* stmt,
                                    ar::Value* pointer,
-                                   const value::AbstractDomain& inv);
+                                   QueryCache& queries);
 
   /// \brief Check a call to realloc for buffer overflow
   ///
@@ -235,7 +247,7 @@ private:
   /// \param inv The invariant
   CheckResult check_realloc(ar::CallBase* call,
                             ar::Value* pointer,
-                            const value::AbstractDomain& inv);
+                            QueryCache& queries);
 
   /// \brief Check a `FILE*` access (read/write) for buffer overflow
   ///
@@ -248,11 +260,35 @@ private:
   CheckResult check_file_access(ar::Statement* stmt,
                                 ar::Value* pointer,
                                 Result if_null,
-                                const value::AbstractDomain& inv);
+                                QueryCache& queries);
 
   /// \brief Return the store size for the given type, as an integer constant
   ar::IntegerConstant* store_size(ar::Type*) const;
 
+  /// \brief Return true if `offset + access_size <= size` holds on intervals
+  ///
+  /// If so, add the allocation size and `offset + access_size - size` to
+  /// block_info.
+  bool is_in_bounds(QueryCache& queries,
+                    MemoryLocation* addr,
+                    AllocSizeVariable* size_var,
+                    const IntInterval& offset_intv,
+                    const IntInterval& access_size_intv,
+                    JsonDict& block_info) const;
+
+  /// \brief Add the pointer offset and the shadow variable
+  /// `offset_plus_size = offset + access_size` in the invariant
+  void add_offset_plus_size(value::AbstractDomain& inv,
+                            const ScalarLit& ptr,
+                            const ScalarLit& size,
+                            ar::Value* access_size,
+                            Variable* offset_var,
+                            Variable* offset_plus_size) const;
+
+  /// \brief Return the memory location of a global variable pointer or a
+  /// function pointer, or nullptr
+  MemoryLocation* global_ptr_address(ar::Value* value) const;
+
   /// \brief Initialize global variable pointers and function pointers
   void init_global_ptr(value::AbstractDomain& inv, ar::Value* value) const;
 
@@ -261,6 +297,9 @@ private:
                               MemoryLocation* addr,
                               AllocSizeVariable* size_var) const;
 
+  /// \brief Return the size of a global variable, function or errno
+  boost::optional< MachineInt > global_alloc_size(MemoryLocation* addr) const;
+
   /// \brief Check whether a memory access is an array access
   ///
   /// \returns the size of an array element
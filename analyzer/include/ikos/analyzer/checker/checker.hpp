@@ -54,6 +54,7 @@
 #include <ikos/analyzer/analysis/literal.hpp>
 #include <ikos/analyzer/analysis/value/abstract_domain.hpp>
 #include <ikos/analyzer/checker/name.hpp>
+#include <ikos/analyzer/checker/query_cache.hpp>
 #include <ikos/analyzer/database/output.hpp>
 #include <ikos/analyzer/util/log.hpp>
 
@@ -115,9 +116,23 @@ public:
   /// \brief Get the checker description
   virtual const char* description() const = 0;
 
+  /// \brief Return true if the checker needs to check statements of the
+  /// given kind
+  ///
+  /// This is used to dispatch statements only to the relevant checkers.
+  virtual bool handles(ar::Statement::StatementKind /*kind*/) const {
+    return true;
+  }
+
   /// \brief Check a statement
+  ///
+  /// \param stmt The statement
+  /// \param inv The invariant before the statement
+  /// \param queries Cache of queries on `inv`, shared by all checkers
+  /// \param call_context The calling context
   virtual void check(ar::Statement* stmt,
                      const value::AbstractDomain& inv,
+                     QueryCache& queries,
                      CallContext* call_context) = 0;
 
 protected:
@@ -179,6 +194,16 @@ protected:
   /// \brief Display a check result
   void display_result(LogMessage& msg, Result result) const;
 
+protected:
+  // Helpers to refer to rows of the output database in check information
+
+  /// \brief Return the id of the given memory location in the output
+  /// database
+  sqlite::DbInt64 memory_location_id(MemoryLocation* mem) const;
+
+  /// \brief Return the id of the given function in the output database
+  sqlite::DbInt64 function_id(ar::Function* fun) const;
+
 }; // end class Checker
 
 /// \brief Create a checker, given its name
@@ -43,7 +43,7 @@
 
 #pragma once
 
-#include <llvm/ADT/DenseMap.h>
+#include <llvm/ADT/DenseSet.h>
 
 #include <ikos/analyzer/checker/checker.hpp>
 
@@ -53,11 +53,14 @@ namespace analyzer {
 /// \brief Dead code checker
 class DeadCodeChecker final : public Checker {
 private:
-  /// \brief Previous statement for each basic block currently analyzed
+  /// \brief Statements that need a check
   ///
-  /// Since we cannot get the previous statement of an `ar::Statement` in O(1),
-  /// we use this map to store the previously analyzed statement.
-  llvm::DenseMap< ar::BasicBlock*, ar::Statement* > _prev_stmts;
+  /// Whether a statement needs a check only depends on the previous checked
+  /// statement in its basic block. Since we cannot get the previous statement
+  /// of an `ar::Statement` in O(1), the statements are collected once, in the
+  /// constructor. The set is read-only afterwards, so that the checker can be
+  /// shared by concurrent checks.
+  llvm::DenseSet< ar::Statement* > _checked_stmts;
 
 public:
   /// \brief Constructor
@@ -72,14 +75,12 @@ public:
   /// \brief Check a statement
   void check(ar::Statement* stmt,
              const value::AbstractDomain& inv,
+             QueryCache& queries,
              CallContext* call_context) override;
 
 private:
-  /// \brief Return the previous statement
-  ar::Statement* previous_statement(ar::Statement* stmt) const;
-
-  /// \brief Save the current statement
-  void save_current_statement(ar::Statement* stmt);
+  /// \brief Collect the statements of the given code that need a check
+  void collect_checked_statements(ar::Code* code);
 
   /// \brief Return true if we need to skip the check for the given statement
   static bool skip_check(ar::Statement* stmt);
@@ -60,9 +60,14 @@ public:
   /// \brief Get the checker description
   const char* description() const override;
 
+  /// \brief Return true if the checker needs to check statements of the
+  /// given kind
+  bool handles(ar::Statement::StatementKind kind) const override;
+
   /// \brief Check a statement
   void check(ar::Statement* stmt,
              const value::AbstractDomain& inv,
+             QueryCache& queries,
              CallContext* call_context) override;
 
 private:
@@ -0,0 +1,109 @@
+/*******************************************************************************
+ *
+ * \file
+ * \brief Dispatch statements to the relevant checkers
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include <ikos/ar/semantic/statement.hpp>
+
+#include <ikos/analyzer/analysis/call_context.hpp>
+#include <ikos/analyzer/analysis/value/abstract_domain.hpp>
+#include <ikos/analyzer/checker/checker.hpp>
+
+namespace ikos {
+namespace analyzer {
+
+/// \brief Dispatch statements to the relevant checkers
+///
+/// The checkers are grouped by statement kind once, before the checking
+/// phase. Each statement is then only given to the checkers that handle its
+/// kind, with a QueryCache shared among them.
+class CheckerDispatcher {
+private:
+  /// \brief Number of statement kinds
+  static constexpr std::size_t NumStatementKinds =
+      static_cast< std::size_t >(ar::Statement::ResumeKind) + 1;
+
+  /// \brief Checkers for each statement kind
+  std::array< std::vector< Checker* >, NumStatementKinds > _table;
+
+  /// \brief True if there is no checker
+  bool _empty;
+
+public:
+  /// \brief Constructor
+  explicit CheckerDispatcher(
+      const std::vector< std::unique_ptr< Checker > >& checkers);
+
+  /// \brief No copy constructor
+  CheckerDispatcher(const CheckerDispatcher&) = delete;
+
+  /// \brief No move constructor
+  CheckerDispatcher(CheckerDispatcher&&) = delete;
+
+  /// \brief No copy assignment operator
+  CheckerDispatcher& operator=(const CheckerDispatcher&) = delete;
+
+  /// \brief No move assignment operator
+  CheckerDispatcher& operator=(CheckerDispatcher&&) = delete;
+
+  /// \brief Destructor
+  ~CheckerDispatcher() = default;
+
+  /// \brief Return true if there is no checker
+  bool empty() const { return this->_empty; }
+
+  /// \brief Check a statement
+  ///
+  /// The invariant is normalized only if a checker handles the statement.
+  void check(ar::Statement* stmt,
+             value::AbstractDomain& inv,
+             CallContext* call_context) const;
+
+}; // end class CheckerDispatcher
+
+} // end namespace analyzer
+} // end namespace ikos
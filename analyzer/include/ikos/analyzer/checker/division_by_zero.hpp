@@ -63,9 +63,14 @@ public:
   /// \brief Get the checker description
   const char* description() const override;
 
+  /// \brief Return true if the checker needs to check statements of the
+  /// given kind
+  bool handles(ar::Statement::StatementKind kind) const override;
+
   /// \brief Check a statement
   void check(ar::Statement* stmt,
              const value::AbstractDomain& inv,
+             QueryCache& queries,
              CallContext* call_context) override;
 
 private:
@@ -77,8 +82,7 @@ private:
   };
 
   /// \brief Check a division
-  CheckResult check_division(ar::BinaryOperation* stmt,
-                             const value::AbstractDomain& inv);
+  CheckResult check_division(ar::BinaryOperation* stmt, QueryCache& queries);
 
 private:
   /// \brief Dispay the check for the given division, if requested
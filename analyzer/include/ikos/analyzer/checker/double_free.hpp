@@ -69,9 +69,14 @@ public:
   /// \brief Get the checker description
   const char* description() const override;
 
+  /// \brief Return true if the checker needs to check statements of the
+  /// given kind
+  bool handles(ar::Statement::StatementKind kind) const override;
+
   /// \brief Check a statement
   void check(ar::Statement* stmt,
              const value::AbstractDomain& inv,
+             QueryCache& queries,
              CallContext* call_context) override;
 
 private:
@@ -85,16 +90,17 @@ private:
 
   /// \brief Check a function call
   std::vector< CheckResult > check_call(ar::CallBase* call,
-                                        const value::AbstractDomain& inv);
+                                        QueryCache& queries);
 
   /// \brief Check an intrinsic function call
-  boost::optional< CheckResult > check_intrinsic_call(
-      ar::CallBase* call, ar::Function* fun, const value::AbstractDomain& inv);
+  boost::optional< CheckResult > check_intrinsic_call(ar::CallBase* call,
+                                                      ar::Function* fun,
+                                                      QueryCache& queries);
 
   /// \brief Check a function call to free on the given pointer
   CheckResult check_double_free(ar::CallBase* call,
                                 ar::Value* pointer,
-                                const value::AbstractDomain& inv);
+                                QueryCache& queries);
 
   /// \brief Check for a double free call on a memory location
   Result check_memory_location_free(ar::CallBase* call,
@@ -77,9 +77,14 @@ public:
   /// \brief Get the checker description
   const char* description() const override;
 
+  /// \brief Return true if the checker needs to check statements of the
+  /// given kind
+  bool handles(ar::Statement::StatementKind kind) const override;
+
   /// \brief Check a statement
   void check(ar::Statement* stmt,
              const value::AbstractDomain& inv,
+             QueryCache& queries,
              CallContext* call_context) override;
 
 private:
@@ -92,7 +97,7 @@ private:
   };
 
   /// \brief Check a function call
-  CheckResult check_call(ar::CallBase* call, const value::AbstractDomain& inv);
+  CheckResult check_call(ar::CallBase* call, QueryCache& queries);
 
   /// \brief Dispay a function call check, if requested
   llvm::Optional< LogMessage > display_call_check(Result result,
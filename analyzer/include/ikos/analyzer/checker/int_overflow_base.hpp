@@ -61,10 +61,14 @@ public:
   /// \brief Constructor
   explicit IntOverflowCheckerBase(Context& ctx);
 
+  /// \brief Return true if the checker needs to check statements of the
+  /// given kind
+  bool handles(ar::Statement::StatementKind kind) const override;
+
 protected:
   /// \brief Check an integer overflow and insert the checks in the database
   void check_integer_overflow(ar::BinaryOperation* stmt,
-                              const value::AbstractDomain& inv,
+                              QueryCache& queries,
                               CallContext* call_context);
 
 private:
@@ -78,7 +82,7 @@ private:
 
   /// \brief Check an integer overflow
   llvm::SmallVector< CheckResult, 2 > check_integer_overflow(
-      ar::BinaryOperation* stmt, const value::AbstractDomain& inv);
+      ar::BinaryOperation* stmt, QueryCache& queries);
 
 private:
   /// \brief Display info about the check
@@ -43,6 +43,8 @@
 
 #pragma once
 
+#include <ikos/analyzer/support/assert.hpp>
+
 namespace ikos {
 namespace analyzer {
 
@@ -164,5 +166,80 @@ enum class CheckKind {
 
 };
 
+/// \brief Return the short name of the given check kind
+///
+/// This matches the names used by ikos-report.
+inline const char* check_kind_short_name(CheckKind kind) {
+  switch (kind) {
+    case CheckKind::Unreachable:
+      return "unreachable";
+    case CheckKind::UnexpectedOperand:
+      return "unexpected-operand";
+    case CheckKind::UninitializedVariable:
+      return "uninitialized-variable";
+    case CheckKind::Assert:
+      return "assert";
+    case CheckKind::DivisionByZero:
+      return "division-by-zero";
+    case CheckKind::ShiftCount:
+      return "shift-count";
+    case CheckKind::SignedIntUnderflow:
+      return "signed-int-underflow";
+    case CheckKind::SignedIntOverflow:
+      return "signed-int-overflow";
+    case CheckKind::UnsignedIntUnderflow:
+      return "unsigned-int-underflow";
+    case CheckKind::UnsignedIntOverflow:
+      return "unsigned-int-overflow";
+    case CheckKind::NullPointerDereference:
+      return "null-pointer-deref";
+    case CheckKind::NullPointerComparison:
+      return "null-pointer-comparison";
+    case CheckKind::InvalidPointerComparison:
+      return "invalid-pointer-comparison";
+    case CheckKind::PointerComparison:
+      return "pointer-comparison";
+    case CheckKind::PointerOverflow:
+      return "pointer-overflow";
+    case CheckKind::InvalidPointerDereference:
+      return "invalid-pointer-deref";
+    case CheckKind::UnknownMemoryAccess:
+      return "unknown-memory-access";
+    case CheckKind::UnalignedPointer:
+      return "unaligned-pointer";
+    case CheckKind::BufferOverflowGets:
+      return "buffer-overflow-gets";
+    case CheckKind::BufferOverflow:
+      return "buffer-overflow";
+    case CheckKind::IgnoredStore:
+      return "ignored-store";
+    case CheckKind::IgnoredMemoryCopy:
+      return "ignored-memory-copy";
+    case CheckKind::IgnoredMemoryMove:
+      return "ignored-memory-move";
+    case CheckKind::IgnoredMemorySet:
+      return "ignored-memory-set";
+    case CheckKind::IgnoredFree:
+      return "ignored-free";
+    case CheckKind::IgnoredCallSideEffectOnPointerParameter:
+      return "ignored-call-side-effect-pointer-param";
+    case CheckKind::IgnoredCallSideEffect:
+      return "ignored-call-side-effect";
+    case CheckKind::RecursiveFunctionCall:
+      return "recursive-function-call";
+    case CheckKind::FunctionCallInlineAssembly:
+      return "function-call-inline-asm";
+    case CheckKind::UnknownFunctionCallPointer:
+      return "unknown-function-call-pointer";
+    case CheckKind::FunctionCall:
+      return "function-call";
+    case CheckKind::Free:
+      return "free";
+    default: {
+      ikos_unreachable("unreachable");
+    }
+  }
+}
+
 } // end namespace analyzer
 } // end namespace ikos
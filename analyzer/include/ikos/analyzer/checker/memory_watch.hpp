@@ -82,33 +82,37 @@ public:
   /// \brief Get the checker description
   const char* description() const override;
 
+  /// \brief Return true if the checker needs to check statements of the
+  /// given kind
+  bool handles(ar::Statement::StatementKind kind) const override;
+
   /// \brief Check a statement
   void check(ar::Statement* stmt,
              const value::AbstractDomain& inv,
+             QueryCache& queries,
              CallContext* call_context) override;
 
 private:
   /// \brief Check a store
-  void check_store(ar::Store* store, const value::AbstractDomain& inv);
+  void check_store(ar::Store* store, QueryCache& queries);
 
   /// \brief Check a function call
   void check_call(ar::CallBase* call,
-                  const value::AbstractDomain& inv,
+                  QueryCache& queries,
                   CallContext* call_context);
 
   /// \brief Check a recursive function call
   void check_recursive_call(ar::CallBase* call,
                             ar::Function* fun,
-                            const value::AbstractDomain& inv);
+                            QueryCache& queries);
 
   /// \brief Check an intrinsic function call
   void check_intrinsic_call(ar::CallBase* call,
                             ar::Function* fun,
-                            const value::AbstractDomain& inv);
+                            QueryCache& queries);
 
   /// \brief Check a call to an unknown extern function
-  void check_unknown_extern_call(ar::CallBase* call,
-                                 const value::AbstractDomain& inv);
+  void check_unknown_extern_call(ar::CallBase* call, QueryCache& queries);
 
   /// \brief Check a call to an unknown function
   ///
@@ -127,7 +131,7 @@ private:
   /// \param may_throw_exc
   ///   True if the function call might throw an exception
   void check_unknown_call(ar::CallBase* call,
-                          value::AbstractDomain inv,
+                          QueryCache& queries,
                           bool may_write_params,
                           bool ignore_unknown_write,
                           bool may_write_globals,
@@ -144,7 +148,7 @@ private:
   void check_mem_write(ar::Statement* stmt,
                        ar::Value* pointer,
                        ar::Value* access_size,
-                       value::AbstractDomain inv);
+                       QueryCache& queries);
 
   /// \brief Check a memory write
   ///
@@ -155,7 +159,11 @@ private:
   /// \param inv The invariant
   void check_mem_write(ar::Statement* stmt,
                        ar::Value* pointer,
-                       value::AbstractDomain inv);
+                       QueryCache& queries);
+
+  /// \brief Return the memory location of a global variable pointer or a
+  /// function pointer, or nullptr
+  MemoryLocation* global_ptr_address(ar::Value* value) const;
 
   /// \brief Initialize global variable pointers and function pointers
   void init_global_ptr(value::AbstractDomain& inv, ar::Value* value) const;
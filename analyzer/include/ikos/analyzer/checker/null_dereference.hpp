@@ -67,9 +67,14 @@ public:
   /// \brief Get the checker description
   const char* description() const override;
 
+  /// \brief Return true if the checker needs to check statements of the
+  /// given kind
+  bool handles(ar::Statement::StatementKind kind) const override;
+
   /// \brief Check a statement
   void check(ar::Statement* stmt,
              const value::AbstractDomain& inv,
+             QueryCache& queries,
              CallContext* call_context) override;
 
 private:
@@ -82,16 +87,17 @@ private:
 
   /// \brief Check a function call
   std::vector< CheckResult > check_call(ar::CallBase* call,
-                                        const value::AbstractDomain& inv);
+                                        QueryCache& queries);
 
   /// \brief Check an intrinsic function call
-  std::vector< CheckResult > check_intrinsic_call(
-      ar::CallBase* call, ar::Function* fun, const value::AbstractDomain& inv);
+  std::vector< CheckResult > check_intrinsic_call(ar::CallBase* call,
+                                                  ar::Function* fun,
+                                                  QueryCache& queries);
 
   /// \brief Check a null dereference
   CheckResult check_null(ar::Statement* stmt,
                          ar::Value* operand,
-                         const value::AbstractDomain& inv);
+                         QueryCache& queries);
 
 private:
   /// \brief Dispay a null dereference check, if requested
@@ -70,9 +70,14 @@ public:
   /// \brief Get the checker description
   const char* description() const override;
 
+  /// \brief Return true if the checker needs to check statements of the
+  /// given kind
+  bool handles(ar::Statement::StatementKind kind) const override;
+
   /// \brief Check a statement
   void check(ar::Statement* stmt,
              const value::AbstractDomain& inv,
+             QueryCache& queries,
              CallContext* call_context) override;
 
 private:
@@ -80,7 +85,7 @@ private:
   void check_alignment(ar::Statement* stmt,
                        ar::Value* operand,
                        uint64_t alignment_req,
-                       const value::AbstractDomain& inv,
+                       QueryCache& queries,
                        CallContext* call_context);
 
   /// \brief Check result
@@ -94,7 +99,7 @@ private:
   CheckResult check_alignment(ar::Statement* stmt,
                               ar::Value* operand,
                               uint64_t alignment_req,
-                              const value::AbstractDomain& inv);
+                              QueryCache& queries);
 
   /// \brief Check the alignment of a memory location
   Result check_memory_location_alignment(MemoryLocation* memloc,
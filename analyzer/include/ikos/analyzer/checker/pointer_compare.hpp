@@ -66,9 +66,14 @@ public:
   /// \brief Get the checker description
   const char* description() const override;
 
+  /// \brief Return true if the checker needs to check statements of the
+  /// given kind
+  bool handles(ar::Statement::StatementKind kind) const override;
+
   /// \brief Check a statement
   void check(ar::Statement* stmt,
              const value::AbstractDomain& inv,
+             QueryCache& queries,
              CallContext* call_context) override;
 
 private:
@@ -81,8 +86,7 @@ private:
   };
 
   /// \brief Check a pointer comparison
-  CheckResult check_pointer_compare(ar::Comparison* stmt,
-                                    const value::AbstractDomain& inv);
+  CheckResult check_pointer_compare(ar::Comparison* stmt, QueryCache& queries);
 
   /// \brief Display the pointer comparison check, if requested
   llvm::Optional< LogMessage > display_pointer_compare_check(
@@ -69,9 +69,14 @@ public:
   /// \brief Get the checker description
   const char* description() const override;
 
+  /// \brief Return true if the checker needs to check statements of the
+  /// given kind
+  bool handles(ar::Statement::StatementKind kind) const override;
+
   /// \brief Check a statement
   void check(ar::Statement* stmt,
              const value::AbstractDomain& inv,
+             QueryCache& queries,
              CallContext* call_context) override;
 
 private:
@@ -84,7 +89,7 @@ private:
 
   /// \brief Check a pointer overflow
   CheckResult check_pointer_overflow(ar::PointerShift* stmt,
-                                     const value::AbstractDomain& inv);
+                                     QueryCache& queries);
 
   /// \brief Display the pointer overflow check, if requested
   llvm::Optional< LogMessage > display_pointer_overflow_check(
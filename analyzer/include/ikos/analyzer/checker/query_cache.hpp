@@ -0,0 +1,213 @@
+/*******************************************************************************
+ *
+ * \file
+ * \brief Cache of queries on an invariant, shared by the checkers
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <boost/optional.hpp>
+
+#include <llvm/ADT/SmallVector.h>
+
+#include <ikos/core/value/machine_int/interval.hpp>
+#include <ikos/core/value/nullity.hpp>
+#include <ikos/core/value/pointer/points_to_set.hpp>
+#include <ikos/core/value/uninitialized.hpp>
+
+#include <ikos/analyzer/analysis/memory_location.hpp>
+#include <ikos/analyzer/analysis/value/abstract_domain.hpp>
+#include <ikos/analyzer/analysis/variable.hpp>
+
+namespace ikos {
+namespace analyzer {
+
+/// \brief Cache of queries on the invariant of a statement
+///
+/// A QueryCache is created for each checked statement and shared by all the
+/// checkers of that statement, so that common sub-queries on the invariant
+/// (e.g, whether a pointer operand is null, its points-to set or its offset)
+/// are only evaluated once.
+///
+/// The invariant must not be modified while the cache is alive.
+class QueryCache {
+public:
+  using IntInterval = core::machine_int::Interval;
+  using PointsToSet = core::PointsToSet< MemoryLocation* >;
+
+private:
+  /// \brief Cached queries on a variable
+  struct Entry {
+    Variable* var;
+    boost::optional< bool > uninitialized;
+    boost::optional< core::Uninitialized > uninit;
+    boost::optional< bool > null;
+    boost::optional< core::Nullity > nullity;
+    boost::optional< PointsToSet > points_to;
+    boost::optional< IntInterval > offset;
+    boost::optional< IntInterval > interval;
+
+    explicit Entry(Variable* v) : var(v) {}
+  };
+
+private:
+  /// \brief Invariant
+  const value::AbstractDomain& _inv;
+
+  /// \brief Cached queries, per variable
+  ///
+  /// A statement only has a few operands, hence a linear search is enough.
+  llvm::SmallVector< Entry, 4 > _entries;
+
+public:
+  /// \brief Constructor
+  explicit QueryCache(const value::AbstractDomain& inv) : _inv(inv) {}
+
+  /// \brief No copy constructor
+  QueryCache(const QueryCache&) = delete;
+
+  /// \brief No move constructor
+  QueryCache(QueryCache&&) = delete;
+
+  /// \brief No copy assignment operator
+  QueryCache& operator=(const QueryCache&) = delete;
+
+  /// \brief No move assignment operator
+  QueryCache& operator=(QueryCache&&) = delete;
+
+  /// \brief Destructor
+  ~QueryCache() = default;
+
+  /// \brief Return the invariant
+  const value::AbstractDomain& inv() const { return this->_inv; }
+
+  /// \brief Return true if the variable is uninitialized
+  ///
+  /// Equivalent to `inv.normal().uninit_is_uninitialized(v)`
+  bool uninit_is_uninitialized(Variable* v) {
+    Entry& e = this->entry(v);
+    if (!e.uninitialized) {
+      e.uninitialized = this->_inv.normal().uninit_is_uninitialized(v);
+    }
+    return *e.uninitialized;
+  }
+
+  /// \brief Return the initialization state of the variable
+  ///
+  /// Equivalent to `inv.normal().uninit_to_uninitialized(v)`
+  core::Uninitialized uninit_to_uninitialized(Variable* v) {
+    Entry& e = this->entry(v);
+    if (!e.uninit) {
+      e.uninit = this->_inv.normal().uninit_to_uninitialized(v);
+    }
+    return *e.uninit;
+  }
+
+  /// \brief Return true if the pointer is null
+  ///
+  /// Equivalent to `inv.normal().nullity_is_null(v)`
+  bool nullity_is_null(Variable* v) {
+    Entry& e = this->entry(v);
+    if (!e.null) {
+      e.null = this->_inv.normal().nullity_is_null(v);
+    }
+    return *e.null;
+  }
+
+  /// \brief Return the nullity of the pointer
+  ///
+  /// Equivalent to `inv.normal().nullity_to_nullity(v)`
+  core::Nullity nullity_to_nullity(Variable* v) {
+    Entry& e = this->entry(v);
+    if (!e.nullity) {
+      e.nullity = this->_inv.normal().nullity_to_nullity(v);
+    }
+    return *e.nullity;
+  }
+
+  /// \brief Return the points-to set of the pointer
+  ///
+  /// Equivalent to `inv.normal().pointer_to_points_to(v)`
+  PointsToSet pointer_to_points_to(Variable* v) {
+    Entry& e = this->entry(v);
+    if (!e.points_to) {
+      e.points_to = this->_inv.normal().pointer_to_points_to(v);
+    }
+    return *e.points_to;
+  }
+
+  /// \brief Return the offset of the pointer as an interval
+  ///
+  /// Equivalent to `inv.normal().pointer_offset_to_interval(v)`
+  IntInterval pointer_offset_to_interval(Variable* v) {
+    Entry& e = this->entry(v);
+    if (!e.offset) {
+      e.offset = this->_inv.normal().pointer_offset_to_interval(v);
+    }
+    return *e.offset;
+  }
+
+  /// \brief Return the value of the integer variable as an interval
+  ///
+  /// Equivalent to `inv.normal().int_to_interval(v)`
+  IntInterval int_to_interval(Variable* v) {
+    Entry& e = this->entry(v);
+    if (!e.interval) {
+      e.interval = this->_inv.normal().int_to_interval(v);
+    }
+    return *e.interval;
+  }
+
+private:
+  /// \brief Return the cache entry for the given variable
+  Entry& entry(Variable* v) {
+    for (Entry& e : this->_entries) {
+      if (e.var == v) {
+        return e;
+      }
+    }
+    this->_entries.emplace_back(v);
+    return this->_entries.back();
+  }
+
+}; // end class QueryCache
+
+} // end namespace analyzer
+} // end namespace ikos
@@ -63,9 +63,14 @@ public:
   /// \brief Get the checker description
   const char* description() const override;
 
+  /// \brief Return true if the checker needs to check statements of the
+  /// given kind
+  bool handles(ar::Statement::StatementKind kind) const override;
+
   /// \brief Check a statement
   void check(ar::Statement* stmt,
              const value::AbstractDomain& inv,
+             QueryCache& queries,
              CallContext* call_context) override;
 
 private:
@@ -77,8 +82,7 @@ private:
   };
 
   /// \brief Check a shift count
-  CheckResult check_shift_count(ar::BinaryOperation* stmt,
-                                const value::AbstractDomain& inv);
+  CheckResult check_shift_count(ar::BinaryOperation* stmt, QueryCache& queries);
 
   /// \brief Display a shift count check, if requested
   llvm::Optional< LogMessage > display_shift_count_check(
@@ -71,9 +71,14 @@ public:
   /// \brief Get the checker description
   const char* description() const override;
 
+  /// \brief Return true if the checker needs to check statements of the
+  /// given kind
+  bool handles(ar::Statement::StatementKind kind) const override;
+
   /// \brief Check a statement
   void check(ar::Statement* stmt,
              const value::AbstractDomain& inv,
+             QueryCache& queries,
              CallContext* call_context) override;
 
 private:
@@ -87,7 +92,7 @@ private:
 
   /// \brief Check a function call
   std::vector< CheckResult > check_call(ar::CallBase* call,
-                                        const value::AbstractDomain& inv,
+                                        QueryCache& queries,
                                         CallContext* call_context);
 
   /// \brief Check for a recursive function call
@@ -95,18 +100,19 @@ private:
   /// Warn about RecursiveFunctionCall.
   CheckResult check_recursive_call(ar::CallBase* call,
                                    ar::Function* fun,
-                                   const value::AbstractDomain& inv);
+                                   QueryCache& queries);
 
   /// \brief Check an intrinsic function call
-  std::vector< CheckResult > check_intrinsic_call(
-      ar::CallBase* call, ar::Function* fun, const value::AbstractDomain& inv);
+  std::vector< CheckResult > check_intrinsic_call(ar::CallBase* call,
+                                                  ar::Function* fun,
+                                                  QueryCache& queries);
 
   /// \brief Check a call to an unknown extern function
   ///
   /// Warn about IgnoredCallSideEffect.
   CheckResult check_unknown_extern_call(ar::CallBase* call,
                                         ar::Function* fun,
-                                        const value::AbstractDomain& inv);
+                                        QueryCache& queries);
 
   /// \brief Check a memory write on an unknown pointer
   ///
@@ -114,11 +120,10 @@ private:
   ///
   /// Warn about IgnoredStore, IgnoredMemoryCopy, IgnoredMemoryMove and
   /// IgnoredMemorySet.
-  boost::optional< CheckResult > check_mem_write(
-      ar::Statement* stmt,
-      ar::Value* pointer,
-      CheckKind access_kind,
-      const value::AbstractDomain& inv);
+  boost::optional< CheckResult > check_mem_write(ar::Statement* stmt,
+                                                 ar::Value* pointer,
+                                                 CheckKind access_kind,
+                                                 QueryCache& queries);
 
   /// \brief Check a call for unknown pointer parameters
   ///
@@ -129,7 +134,7 @@ private:
       ar::CallBase* call,
       ar::Function* fun,
       const std::vector< ar::Value* >& pointers,
-      const value::AbstractDomain& inv);
+      QueryCache& queries);
 
   /// \brief Check a call to free()
   ///
@@ -138,7 +143,7 @@ private:
   /// Warn about IgnoredFree.
   boost::optional< CheckResult > check_free(ar::CallBase* call,
                                             ar::Value* pointer,
-                                            const value::AbstractDomain& inv);
+                                            QueryCache& queries);
 
   /// \brief Dispay a soundness check, if requested
   llvm::Optional< LogMessage > display_soundness_check(
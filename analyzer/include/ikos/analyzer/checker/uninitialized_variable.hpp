@@ -65,18 +65,19 @@ public:
   /// \brief Check a statement
   void check(ar::Statement* stmt,
              const value::AbstractDomain& inv,
+             QueryCache& queries,
              CallContext* call_context) override;
 
 private:
   /// \brief Check an operand and save the result
   void check_initialized(ar::Statement* stmt,
                          ar::Value* operand,
-                         const value::AbstractDomain& inv,
+                         QueryCache& queries,
                          CallContext* call_context);
 
   /// \brief Check an operand and return a result
   boost::optional< Result > check_initialized(ar::Value* operand,
-                                              const value::AbstractDomain& inv);
+                                              QueryCache& queries);
 
 private:
   /// \brief Dispay a uninitialized variable check, if requested
@@ -75,6 +75,14 @@ public:
   /// \brief Constructor
   explicit OutputDatabase(sqlite::DbConnection& db_);
 
+  /// \brief Number the rows inserted during the analysis starting from the
+  /// given id
+  ///
+  /// This is used by the shards of a distributed analysis, so that their
+  /// databases can be merged without renumbering rows. Functions keep their
+  /// numbering since every shard inserts all of them, in the same order.
+  void set_first_id(sqlite::DbInt64 id);
+
 }; // end class OutputDatabase
 
 } // end namespace analyzer
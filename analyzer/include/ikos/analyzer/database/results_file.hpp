@@ -0,0 +1,429 @@
+/*******************************************************************************
+ *
+ * \file
+ * \brief Compact binary results file
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <llvm/ADT/ArrayRef.h>
+#include <llvm/ADT/DenseMap.h>
+#include <llvm/ADT/StringMap.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/IR/DebugInfoMetadata.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <ikos/ar/semantic/function.hpp>
+#include <ikos/ar/semantic/statement.hpp>
+#include <ikos/ar/semantic/value.hpp>
+
+#include <ikos/analyzer/analysis/call_context.hpp>
+#include <ikos/analyzer/analysis/result.hpp>
+#include <ikos/analyzer/checker/kind.hpp>
+#include <ikos/analyzer/checker/name.hpp>
+#include <ikos/analyzer/exception.hpp>
+
+namespace ikos {
+namespace analyzer {
+
+/// \brief Compact binary results file
+///
+/// This is an alternative to the output database, holding only the checks and
+/// what is needed to report them. It is written while the analysis runs and
+/// can be memory-mapped by readers.
+///
+/// All integers are little-endian. The file is made of:
+///   * A header: the magic string and the format version (uint32);
+///   * The check records, in insertion order (see CheckRecord);
+///   * The operand records (see OperandRecord);
+///   * The statement records (see StatementRecord);
+///   * The call context records (see CallContextRecord);
+///   * The string table: one offset per string plus the end offset (uint64),
+///     followed by the concatenated string data;
+///   * The footer (see FooterSize), ending with the magic string.
+///
+/// Strings, operands, statements and call contexts are deduplicated and
+/// referred to by their index. A missing reference is NoIndex.
+namespace results_file {
+
+/// \brief Magic string, at the beginning and the end of the file
+constexpr char Magic[8] = {'I', 'K', 'O', 'S', 'R', 'E', 'S', '\0'};
+
+/// \brief Format version
+constexpr std::uint32_t Version = 1;
+
+/// \brief Missing reference
+constexpr std::uint32_t NoIndex = 0xFFFFFFFF;
+
+/// \brief Size of the header: magic, version, reserved (uint32)
+constexpr std::size_t HeaderSize = 16;
+
+/// \brief Size of a check record
+///
+/// kind, checker, status (uint8), reserved (uint8), statement, call context,
+/// info string, first operand, number of operands (uint32).
+constexpr std::size_t CheckRecordSize = 24;
+
+/// \brief Size of an operand record
+///
+/// operand number in the statement or -1 (int32), representation (uint32).
+constexpr std::size_t OperandRecordSize = 8;
+
+/// \brief Size of a statement record
+///
+/// function name, file path (uint32), line, column (uint32).
+constexpr std::size_t StatementRecordSize = 16;
+
+/// \brief Size of a call context record
+///
+/// call statement, parent call context (uint32).
+constexpr std::size_t CallContextRecordSize = 8;
+
+/// \brief Size of the footer
+///
+/// Offset and number of elements (uint64) for the checks, the operands, the
+/// statements, the call contexts and the string offsets, then the offset of
+/// the string data (uint64) and the magic string.
+constexpr std::size_t FooterSize = 11 * 8 + sizeof(Magic);
+
+/// \brief Check record
+struct CheckRecord {
+  CheckKind kind;
+  CheckerName checker;
+  Result status;
+  std::uint32_t statement;
+  std::uint32_t call_context;
+  std::uint32_t info;
+  std::uint32_t operands_begin;
+  std::uint32_t operands_count;
+};
+
+/// \brief Operand record
+struct OperandRecord {
+  std::int32_t number;
+  std::uint32_t repr;
+};
+
+/// \brief Statement record
+///
+/// The line and column are 0 if unknown.
+struct StatementRecord {
+  std::uint32_t function;
+  std::uint32_t file;
+  std::uint32_t line;
+  std::uint32_t column;
+};
+
+/// \brief Call context record
+///
+/// The call statement and the parent are NoIndex for the empty call context.
+struct CallContextRecord {
+  std::uint32_t call;
+  std::uint32_t parent;
+};
+
+/// \brief Error while reading or writing a results file
+class Error : public analyzer::Exception {
+private:
+  /// \brief Explanatory message
+  ///
+  /// See https://clang.llvm.org/extra/clang-tidy/checks/cert-err60-cpp.html
+  std::shared_ptr< const std::string > _msg;
+
+public:
+  /// \brief Constructor
+  ///
+  /// \param msg Explanatory message
+  explicit Error(const std::string& msg)
+      : _msg(std::make_shared< const std::string >(msg)) {}
+
+  /// \brief No default constructor
+  Error() = delete;
+
+  /// \brief Copy constructor
+  Error(const Error&) noexcept = default;
+
+  /// \brief Move constructor
+  Error(Error&&) noexcept = default;
+
+  /// \brief Copy assignment operator
+  Error& operator=(const Error&) noexcept = default;
+
+  /// \brief Move assignment operator
+  Error& operator=(Error&&) noexcept = default;
+
+  /// \brief Get the explanatory string
+  const char* what() const noexcept override;
+
+  /// \brief Destructor
+  ~Error() override;
+
+}; // end class Error
+
+/// \brief Return true if the given buffer starts with the magic string
+bool has_magic(llvm::StringRef buffer);
+
+/// \brief Writer of a results file
+///
+/// The check records are streamed to the file, everything else is kept in
+/// memory until close().
+///
+/// This class is not thread-safe.
+class Writer {
+private:
+  /// \brief File name
+  std::string _filename;
+
+  /// \brief Output stream
+  std::unique_ptr< llvm::raw_fd_ostream > _out;
+
+  /// \brief Number of check records written
+  std::uint64_t _num_checks = 0;
+
+  /// \brief Operand records
+  std::vector< OperandRecord > _operands;
+
+  /// \brief Statement records
+  std::vector< StatementRecord > _statements;
+
+  /// \brief Call context records
+  std::vector< CallContextRecord > _call_contexts;
+
+  /// \brief Strings, in index order
+  std::vector< llvm::StringRef > _strings;
+
+  /// \brief Map from string to index
+  llvm::StringMap< std::uint32_t > _string_map;
+
+  /// \brief Map from statement to index
+  llvm::DenseMap< ar::Statement*, std::uint32_t > _statement_map;
+
+  /// \brief Map from call context to index
+  llvm::DenseMap< CallContext*, std::uint32_t > _call_context_map;
+
+  /// \brief Map from operand to representation string
+  llvm::DenseMap< ar::Value*, std::uint32_t > _operand_map;
+
+  /// \brief Map from function to name string
+  llvm::DenseMap< ar::Function*, std::uint32_t > _function_map;
+
+  /// \brief Map from debug file to path string
+  llvm::DenseMap< llvm::DIFile*, std::uint32_t > _file_map;
+
+public:
+  /// \brief Create the results file
+  ///
+  /// \throws results_file::Error if the file cannot be created
+  explicit Writer(std::string filename);
+
+  /// \brief No copy constructor
+  Writer(const Writer&) = delete;
+
+  /// \brief No move constructor
+  Writer(Writer&&) = delete;
+
+  /// \brief No copy assignment operator
+  Writer& operator=(const Writer&) = delete;
+
+  /// \brief No move assignment operator
+  Writer& operator=(Writer&&) = delete;
+
+  /// \brief Destructor
+  ///
+  /// The file is incomplete if close() was not called.
+  ~Writer();
+
+  /// \brief Write a check
+  ///
+  /// Operands are only recorded for warnings and errors, as in the output
+  /// database.
+  void write(CheckKind kind,
+             CheckerName checker,
+             Result status,
+             ar::Statement* stmt,
+             CallContext* call_context,
+             llvm::ArrayRef< ar::Value* > operands,
+             const std::string& info);
+
+  /// \brief Write the remaining sections and close the file
+  ///
+  /// \throws results_file::Error if an I/O error occurred
+  void close();
+
+private:
+  /// \brief Return the index of the given string
+  std::uint32_t string(llvm::StringRef str);
+
+  /// \brief Return the index of the given statement
+  std::uint32_t statement(ar::Statement* stmt);
+
+  /// \brief Return the index of the given call context
+  std::uint32_t call_context(CallContext* call_context);
+
+  /// \brief Return the index of the name of the given function
+  std::uint32_t function(ar::Function* fun);
+
+  /// \brief Return the index of the path of the given debug file
+  std::uint32_t file(llvm::DIFile* file);
+
+  /// \brief Return the index of the representation of the given operand
+  std::uint32_t operand(ar::Value* value);
+
+}; // end class Writer
+
+/// \brief Reader of a results file
+///
+/// The file is memory-mapped, records are decoded on access.
+class Reader {
+private:
+  /// \brief File content
+  std::unique_ptr< llvm::MemoryBuffer > _buffer;
+
+  /// \brief Beginning of the check records
+  const char* _checks = nullptr;
+
+  /// \brief Number of check records
+  std::size_t _num_checks = 0;
+
+  /// \brief Beginning of the operand records
+  const char* _operands = nullptr;
+
+  /// \brief Number of operand records
+  std::size_t _num_operands = 0;
+
+  /// \brief Beginning of the statement records
+  const char* _statements = nullptr;
+
+  /// \brief Number of statement records
+  std::size_t _num_statements = 0;
+
+  /// \brief Beginning of the call context records
+  const char* _call_contexts = nullptr;
+
+  /// \brief Number of call context records
+  std::size_t _num_call_contexts = 0;
+
+  /// \brief Beginning of the string offsets
+  const char* _string_offsets = nullptr;
+
+  /// \brief Number of strings
+  std::size_t _num_strings = 0;
+
+  /// \brief Beginning of the string data
+  const char* _string_data = nullptr;
+
+  /// \brief Size of the string data
+  std::size_t _string_data_size = 0;
+
+public:
+  /// \brief Open the given results file
+  ///
+  /// \throws results_file::Error if the file cannot be read or is malformed
+  explicit Reader(const std::string& filename);
+
+  /// \brief No copy constructor
+  Reader(const Reader&) = delete;
+
+  /// \brief Move constructor
+  Reader(Reader&&) noexcept = default;
+
+  /// \brief No copy assignment operator
+  Reader& operator=(const Reader&) = delete;
+
+  /// \brief Move assignment operator
+  Reader& operator=(Reader&&) noexcept = default;
+
+  /// \brief Destructor
+  ~Reader();
+
+  /// \brief Return the number of checks
+  std::size_t num_checks() const { return this->_num_checks; }
+
+  /// \brief Return the number of operands
+  std::size_t num_operands() const { return this->_num_operands; }
+
+  /// \brief Return the number of statements
+  std::size_t num_statements() const { return this->_num_statements; }
+
+  /// \brief Return the number of call contexts
+  std::size_t num_call_contexts() const { return this->_num_call_contexts; }
+
+  /// \brief Return the number of strings
+  std::size_t num_strings() const { return this->_num_strings; }
+
+  /// \brief Return the check at the given index
+  ///
+  /// \throws results_file::Error if the index is out of range
+  CheckRecord check(std::size_t i) const;
+
+  /// \brief Return the operand at the given index
+  ///
+  /// \throws results_file::Error if the index is out of range
+  OperandRecord operand(std::size_t i) const;
+
+  /// \brief Return the statement at the given index
+  ///
+  /// \throws results_file::Error if the index is out of range
+  StatementRecord statement(std::size_t i) const;
+
+  /// \brief Return the call context at the given index
+  ///
+  /// \throws results_file::Error if the index is out of range
+  CallContextRecord call_context(std::size_t i) const;
+
+  /// \brief Return the string at the given index
+  ///
+  /// Returns an empty string for NoIndex.
+  ///
+  /// \throws results_file::Error if the index is out of range
+  llvm::StringRef string(std::uint32_t i) const;
+
+}; // end class Reader
+
+} // end namespace results_file
+} // end namespace analyzer
+} // end namespace ikos
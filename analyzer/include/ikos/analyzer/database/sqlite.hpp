@@ -45,8 +45,11 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 
 #include <sqlite3.h>
 
@@ -126,6 +129,12 @@ using DbInt64 = sqlite3_int64;
 /// \brief Double type for SQLite
 using DbDouble = double;
 
+/// \brief Text computed when the row is inserted in the database
+///
+/// This allows to format text on the writer thread, see
+/// DbConnection::start_writer().
+using DbLazyText = std::function< std::string() >;
+
 /// \brief Column type
 enum class DbColumnType { Text, Integer, Real, Blob };
 
@@ -148,12 +157,21 @@ enum class CommitPolicy {
   Auto = 1,
 };
 
+class DbOstream;
+class DbWriter;
+
 /// \brief SQLite connection
 class DbConnection {
 public:
   /// \brief Maximum number of rows per transaction, in CommitPolicy::Auto
   static const int MaxRowsPerTransaction = 8192;
 
+  /// \brief Maximum number of rows per INSERT statement, during a bulk load
+  static const int MaxRowsPerInsert = 64;
+
+  /// \brief Default capacity of the writer queue, in batches of rows
+  static const std::size_t DefaultWriterCapacity = 1024;
+
 private:
   /// \brief Filename
   std::string _filename;
@@ -167,6 +185,24 @@ private:
   /// \brief Number of inserted rows, in CommitPolicy::Auto
   std::size_t _inserted_rows = 0;
 
+  /// \brief True during a bulk load
+  bool _bulk_load = false;
+
+  /// \brief Output streams on this connection
+  std::vector< DbOstream* > _ostreams;
+
+  /// \brief Index creation commands deferred until the end of the bulk load
+  std::vector< std::string > _deferred_indexes;
+
+  /// \brief Writer thread, or null
+  std::unique_ptr< DbWriter > _writer;
+
+  /// \brief Mutex for row insertions
+  ///
+  /// Tables are populated concurrently by the analysis threads. Each table
+  /// protects its own prepared statement, this protects the connection.
+  std::mutex _mutex;
+
 public:
   /// \brief No default constructor
   DbConnection() = delete;
@@ -187,6 +223,8 @@ public:
   DbConnection& operator=(DbConnection&&) = delete;
 
   /// \brief Destructor
+  ///
+  /// Rows still queued on the writer thread are dropped.
   ~DbConnection();
 
   /// \brief Return the database filename
@@ -213,9 +251,49 @@ public:
   /// \brief Return the current commit policy
   CommitPolicy commit_policy() const { return this->_commit_policy; }
 
+  /// \brief Start a bulk load
+  ///
+  /// Output streams created during a bulk load insert their rows by batches
+  /// of MaxRowsPerInsert rows, using multi-row INSERT statements. Indexes are
+  /// created at the end of the bulk load, since building an index once is
+  /// cheaper than updating it on every insertion.
+  void begin_bulk_load();
+
+  /// \brief End a bulk load
+  ///
+  /// Insert the pending rows of all output streams and create the deferred
+  /// indexes. Output streams must not be used concurrently.
+  void end_bulk_load();
+
+  /// \brief Return true during a bulk load
+  bool bulk_load() const { return this->_bulk_load; }
+
+  /// \brief Start a writer thread
+  ///
+  /// Output streams created afterwards hand their rows to a dedicated thread
+  /// through a bounded queue of at most `capacity` batches of rows, so that
+  /// SQLite I/O and the formatting of DbLazyText overlap with the callers.
+  /// Callers block when the queue is full.
+  ///
+  /// Must not be called concurrently with insertions.
+  void start_writer(std::size_t capacity = DefaultWriterCapacity);
+
+  /// \brief Wait until the writer thread inserted all the queued rows
+  ///
+  /// Throws the first error raised on the writer thread, if any.
+  void wait_writer();
+
+  /// \brief Insert the queued rows and stop the writer thread
+  ///
+  /// Must not be called concurrently with insertions.
+  ///
+  /// Rows still queued when the connection or an output stream is destroyed
+  /// are dropped, without evaluating their DbLazyText.
+  void stop_writer();
+
 private:
-  /// \brief Called upon a row insertion
-  void row_inserted();
+  /// \brief Called upon the insertion of the given number of rows
+  void rows_inserted(std::size_t n);
 
 public:
   /// \brief Remove a table
@@ -232,6 +310,8 @@ public:
       llvm::ArrayRef< std::pair< StringRef, DbColumnType > > columns);
 
   /// \brief Create an index on the given column of the given table
+  ///
+  /// During a bulk load, the index is created by end_bulk_load().
   void create_index(StringRef index, StringRef table, StringRef column);
 
   /// \brief Set the journal mode
@@ -243,24 +323,52 @@ public:
   // friends
   friend class DbOstream;
   friend class DbIstream;
+  friend class DbWriter;
 
 }; // end class DbConnection
 
 /// \brief Stream-based interface for populating tables
 class DbOstream {
+private:
+  /// \brief Value of a pending row
+  struct Value {
+    /// \brief Kind of value
+    enum class Kind { Null, Integer, Real, Text, LazyText };
+
+    Kind kind = Kind::Null;
+    DbInt64 integer = 0;
+    DbDouble real = 0;
+    std::string text;
+    DbLazyText lazy_text;
+  };
+
 private:
   /// \brief Database connection
   DbConnection& _db;
 
-  /// \brief SQLite3 prepared statement
+  /// \brief SQLite3 prepared statement inserting one row
   sqlite3_stmt* _stmt = nullptr;
 
+  /// \brief SQLite3 prepared statement inserting _batch_rows rows, or null
+  sqlite3_stmt* _batch_stmt = nullptr;
+
   /// \brief Number of columns
   int _columns;
 
+  /// \brief Number of rows per batch
+  int _batch_rows = 1;
+
   /// \brief Current number of column entered
   int _current_column = 1;
 
+  /// \brief True if rows are buffered in _pending instead of bound directly
+  ///
+  /// This is the case during a bulk load or with a writer thread.
+  bool _buffered = false;
+
+  /// \brief Values of the pending rows, if buffered
+  std::vector< Value > _pending;
+
 public:
   /// \brief No default constructor
   DbOstream() = delete;
@@ -285,6 +393,8 @@ public:
   DbOstream& operator=(DbOstream&&) = delete;
 
   /// \brief Destructor
+  ///
+  /// Rows that are not inserted yet are dropped.
   ~DbOstream();
 
 public:
@@ -300,10 +410,43 @@ public:
   /// \brief Insert a double
   void add(DbDouble d);
 
+  /// \brief Insert a text computed later
+  ///
+  /// The function is called when the row is inserted, possibly on the writer
+  /// thread. It must not use the database.
+  void add(DbLazyText text);
+
   /// \brief Flush the row
+  ///
+  /// During a bulk load, the row is inserted with the next batch. With a
+  /// writer thread, the insertion is asynchronous.
   void flush();
 
+private:
+  /// \brief Prepare a statement inserting the given number of rows
+  sqlite3_stmt* prepare(StringRef table_name, int rows);
+
+  /// \brief Bind a pending value to the given parameter of a statement
+  static void bind(sqlite3_stmt* stmt, int index, const Value& value);
+
+  /// \brief Insert the given rows and clear them
+  ///
+  /// The database mutex must be held.
+  void insert(std::vector< Value >& values);
+
+  /// \brief Insert the pending rows
+  ///
+  /// The database mutex must be held.
+  void insert_pending() { this->insert(this->_pending); }
+
+  /// \brief Insert the pending rows and stop batching insertions
+  ///
+  /// The database mutex must be held.
+  void end_bulk_load();
+
   // friends
+  friend class DbConnection;
+  friend class DbWriter;
   friend DbOstream& end_row(DbOstream&);
 
 }; // end class DbOstream
@@ -338,6 +481,12 @@ inline DbOstream& operator<<(DbOstream& o, DbDouble d) {
   return o;
 }
 
+/// \brief Insert a text computed later
+inline DbOstream& operator<<(DbOstream& o, DbLazyText text) {
+  o.add(std::move(text));
+  return o;
+}
+
 /// \brief Insert sqlite::end_row or sqlite::null
 inline DbOstream& operator<<(DbOstream& o, DbOstream& (*m)(DbOstream&)) {
   if (m == &end_row) {
@@ -350,6 +499,38 @@ inline DbOstream& operator<<(DbOstream& o, DbOstream& (*m)(DbOstream&)) {
   return o;
 }
 
+/// \brief Insert the remaining rows of a database connection on destruction
+///
+/// Stop the writer thread and end the bulk load, if needed. A DbLazyText
+/// might refer to objects destroyed before the database connection, hence
+/// the guard must be declared after these objects, so that the rows are
+/// inserted while they are alive, including during stack unwinding.
+class DbFlushGuard {
+private:
+  /// \brief Database connection
+  DbConnection& _db;
+
+public:
+  /// \brief Constructor
+  explicit DbFlushGuard(DbConnection& db) : _db(db) {}
+
+  /// \brief No copy constructor
+  DbFlushGuard(const DbFlushGuard&) = delete;
+
+  /// \brief No move constructor
+  DbFlushGuard(DbFlushGuard&&) = delete;
+
+  /// \brief No copy assignment operator
+  DbFlushGuard& operator=(const DbFlushGuard&) = delete;
+
+  /// \brief No move assignment operator
+  DbFlushGuard& operator=(DbFlushGuard&&) = delete;
+
+  /// \brief Destructor
+  ~DbFlushGuard();
+
+}; // end class DbFlushGuard
+
 /// \brief Stream-based interface for retrieving results of a SQL query
 class DbIstream {
 private:
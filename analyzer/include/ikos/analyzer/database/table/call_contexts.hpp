@@ -43,6 +43,8 @@
 
 #pragma once
 
+#include <mutex>
+
 #include <llvm/ADT/DenseMap.h>
 
 #include <ikos/analyzer/analysis/call_context.hpp>
@@ -71,6 +73,11 @@ private:
   /// \brief Last inserted id
   sqlite::DbInt64 _last_insert_id = 0;
 
+  /// \brief Mutex
+  ///
+  /// Recursive since insert() first inserts the parent call context.
+  std::recursive_mutex _mutex;
+
 public:
   /// \brief Constructor
   explicit CallContextsTable(sqlite::DbConnection& db,
@@ -80,6 +87,9 @@ public:
   /// \brief Insert the given call context in the database and return the id
   sqlite::DbInt64 insert(CallContext* call_context);
 
+  /// \brief Number the next inserted rows starting from the given id
+  void set_next_id(sqlite::DbInt64 id) { this->_last_insert_id = id; }
+
 }; // end class CallContextsTable
 
 } // end namespace analyzer
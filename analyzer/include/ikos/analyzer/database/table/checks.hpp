@@ -43,9 +43,14 @@
 
 #pragma once
 
+#include <mutex>
+#include <string>
+#include <vector>
+
 #include <ikos/analyzer/analysis/result.hpp>
 #include <ikos/analyzer/checker/kind.hpp>
 #include <ikos/analyzer/checker/name.hpp>
+#include <ikos/analyzer/database/results_file.hpp>
 #include <ikos/analyzer/database/table.hpp>
 #include <ikos/analyzer/database/table/call_contexts.hpp>
 #include <ikos/analyzer/database/table/operands.hpp>
@@ -57,6 +62,111 @@ namespace analyzer {
 
 /// \brief Checks table
 class ChecksTable : public DatabaseTable {
+public:
+  /// \brief Buffer of checks, inserted later in the database
+  ///
+  /// Checks are buffered when several entry points are analyzed concurrently,
+  /// so that they are inserted in a deterministic order.
+  class Buffer {
+  public:
+    /// \brief Pending check
+    struct Check {
+      CheckKind kind;
+      CheckerName checker;
+      Result status;
+      ar::Statement* stmt;
+      CallContext* call_context;
+      std::vector< ar::Value* > operands;
+      std::string info;
+    };
+
+    /// \brief Iterator over the pending checks
+    using Iterator = std::vector< Check >::const_iterator;
+
+  private:
+    /// \brief List of pending checks
+    std::vector< Check > _checks;
+
+    /// \brief True if the information of a check refers to rows of other
+    /// tables, see `ChecksTable::mark_row_reference()`
+    bool _refers_to_rows = false;
+
+  public:
+    /// \brief Constructor
+    Buffer() = default;
+
+    /// \brief No copy constructor
+    Buffer(const Buffer&) = delete;
+
+    /// \brief Move constructor
+    Buffer(Buffer&&) = default;
+
+    /// \brief No copy assignment operator
+    Buffer& operator=(const Buffer&) = delete;
+
+    /// \brief Move assignment operator
+    Buffer& operator=(Buffer&&) = default;
+
+    /// \brief Destructor
+    ~Buffer() = default;
+
+    /// \brief Add a pending check
+    void add(Check check) { this->_checks.push_back(std::move(check)); }
+
+    /// \brief Return true if there is no pending check
+    bool empty() const { return this->_checks.empty(); }
+
+    /// \brief Begin iterator over the pending checks
+    Iterator begin() const { return this->_checks.cbegin(); }
+
+    /// \brief End iterator over the pending checks
+    Iterator end() const { return this->_checks.cend(); }
+
+    /// \brief Return true if the information of a check refers to rows of
+    /// other tables of the output database
+    ///
+    /// Such checks cannot be stored in a summary cache, since the rows are
+    /// numbered differently in another run.
+    bool refers_to_rows() const { return this->_refers_to_rows; }
+
+  private:
+    friend class ChecksTable;
+
+  }; // end class Buffer
+
+  /// \brief Redirect the checks of the current thread into a buffer
+  ///
+  /// The previous buffer, if any, is restored on destruction.
+  class ScopeBuffer {
+  private:
+    /// \brief Previous buffer, or null
+    Buffer* _prev;
+
+  public:
+    /// \brief Constructor
+    explicit ScopeBuffer(Buffer& buffer);
+
+    /// \brief No copy constructor
+    ScopeBuffer(const ScopeBuffer&) = delete;
+
+    /// \brief No move constructor
+    ScopeBuffer(ScopeBuffer&&) = delete;
+
+    /// \brief No copy assignment operator
+    ScopeBuffer& operator=(const ScopeBuffer&) = delete;
+
+    /// \brief No move assignment operator
+    ScopeBuffer& operator=(ScopeBuffer&&) = delete;
+
+    /// \brief Destructor
+    ~ScopeBuffer();
+
+  }; // end class ScopeBuffer
+
+private:
+  /// \brief Buffer of the current thread, or null
+  static thread_local Buffer* CurrentBuffer;
+
 private:
   /// \brief Statements table
   StatementsTable& _statements;
@@ -73,6 +183,12 @@ private:
   /// \brief Last inserted id
   sqlite::DbInt64 _last_insert_id = 0;
 
+  /// \brief Results file receiving the checks instead of the database, or null
+  results_file::Writer* _results_file = nullptr;
+
+  /// \brief Mutex
+  std::mutex _mutex;
+
 public:
   /// \brief Constructor
   explicit ChecksTable(sqlite::DbConnection& db,
@@ -80,6 +196,15 @@ public:
                        OperandsTable& operands,
                        CallContextsTable& call_contexts);
 
+  /// \brief Write the checks in the given results file instead of the
+  /// database
+  void set_results_file(results_file::Writer* results_file) {
+    this->_results_file = results_file;
+  }
+
+  /// \brief Number the next inserted rows starting from the given id
+  void set_next_id(sqlite::DbInt64 id) { this->_last_insert_id = id; }
+
   /// \brief Insert a check in the database
   void insert(CheckKind kind,
               CheckerName checker,
@@ -89,6 +214,37 @@ public:
               llvm::ArrayRef< ar::Value* > operands = {},
               const JsonDict& info = {});
 
+  /// \brief Insert all the checks of the given buffer in the database
+  void insert(Buffer& buffer);
+
+  /// \brief Record that the information of a check of the current thread
+  /// refers to a row of another table of the output database
+  ///
+  /// The flag is set on the buffer of the current thread, if any.
+  ///
+  /// This must be called by checkers whenever they put the id of a row (e.g,
+  /// a memory location or a function) in the information of a check.
+  static void mark_row_reference();
+
+  /// \brief Move all the checks of the given buffer in the buffer of the
+  /// current thread, or in the database if there is none
+  ///
+  /// This is used to merge checks computed by several threads, as if they
+  /// were all inserted by the current thread.
+  void merge(Buffer& buffer);
+
+private:
+  /// \brief Write a check in the database
+  ///
+  /// The mutex must be held.
+  void write(CheckKind kind,
+             CheckerName checker,
+             Result status,
+             ar::Statement* stmt,
+             CallContext* call_context,
+             llvm::ArrayRef< ar::Value* > operands,
+             const std::string& info);
+
 }; // end class ChecksTable
 
 } // end namespace analyzer
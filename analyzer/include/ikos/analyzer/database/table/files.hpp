@@ -43,6 +43,8 @@
 
 #pragma once
 
+#include <mutex>
+
 #include <llvm/ADT/DenseMap.h>
 #include <llvm/ADT/StringMap.h>
 #include <llvm/IR/DebugInfoMetadata.h>
@@ -67,6 +69,9 @@ private:
   /// \brief Last inserted id
   sqlite::DbInt64 _last_insert_id = 0;
 
+  /// \brief Mutex
+  std::mutex _mutex;
+
 public:
   /// \brief Constructor
   explicit FilesTable(sqlite::DbConnection& db);
@@ -74,6 +79,9 @@ public:
   /// \brief Insert the given file in the database and return the id
   sqlite::DbInt64 insert(llvm::DIFile* file);
 
+  /// \brief Number the next inserted rows starting from the given id
+  void set_next_id(sqlite::DbInt64 id) { this->_last_insert_id = id; }
+
 }; // end class FilesTable
 
 } // end namespace analyzer
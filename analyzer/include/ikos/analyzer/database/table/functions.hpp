@@ -43,6 +43,8 @@
 
 #pragma once
 
+#include <mutex>
+
 #include <llvm/ADT/DenseMap.h>
 #include <llvm/IR/Function.h>
 
@@ -70,6 +72,9 @@ private:
   /// \brief Last inserted id
   sqlite::DbInt64 _last_insert_id = 0;
 
+  /// \brief Mutex
+  std::mutex _mutex;
+
 public:
   /// \brief Constructor
   FunctionsTable(sqlite::DbConnection& db, FilesTable& files);
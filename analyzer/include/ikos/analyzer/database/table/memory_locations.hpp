@@ -43,6 +43,8 @@
 
 #pragma once
 
+#include <mutex>
+
 #include <llvm/ADT/DenseMap.h>
 
 #include <ikos/analyzer/analysis/memory_location.hpp>
@@ -76,6 +78,9 @@ private:
   /// \brief Last inserted id
   sqlite::DbInt64 _last_insert_id = 0;
 
+  /// \brief Mutex
+  std::mutex _mutex;
+
 public:
   /// \brief Constructor
   explicit MemoryLocationsTable(sqlite::DbConnection& db,
@@ -86,6 +91,9 @@ public:
   /// \brief Insert the given memory location in the database and return the id
   sqlite::DbInt64 insert(MemoryLocation* mem_loc);
 
+  /// \brief Number the next inserted rows starting from the given id
+  void set_next_id(sqlite::DbInt64 id) { this->_last_insert_id = id; }
+
   /// \brief Return the json info for the given memory location
   JsonDict info(MemoryLocation* mem_loc);
 
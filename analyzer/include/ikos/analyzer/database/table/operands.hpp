@@ -43,7 +43,11 @@
 
 #pragma once
 
+#include <mutex>
+#include <string>
+
 #include <llvm/ADT/DenseMap.h>
+#include <llvm/ADT/StringMap.h>
 #include <llvm/IR/Constant.h>
 #include <llvm/IR/Type.h>
 #include <llvm/IR/Value.h>
@@ -64,9 +68,18 @@ private:
   /// \brief Map from ar::Value* to id
   llvm::DenseMap< ar::Value*, sqlite::DbInt64 > _map;
 
+  /// \brief Map from the kind and representation of a scalar constant to id
+  ///
+  /// Distinct ar::Value* for the same constant (e.g, integers of different
+  /// types) share a single row.
+  llvm::StringMap< sqlite::DbInt64 > _constant_map;
+
   /// \brief Last inserted id
   sqlite::DbInt64 _last_insert_id = 0;
 
+  /// \brief Mutex
+  std::mutex _mutex;
+
 public:
   /// \brief Constructor
   explicit OperandsTable(sqlite::DbConnection& db);
@@ -74,6 +87,9 @@ public:
   /// \brief Insert the given operand in the database and return the id
   sqlite::DbInt64 insert(ar::Value* value);
 
+  /// \brief Number the next inserted rows starting from the given id
+  void set_next_id(sqlite::DbInt64 id) { this->_last_insert_id = id; }
+
   /// \brief Return a textual representation of a llvm::Type
   static std::string repr(llvm::Type* type);
 
@@ -86,6 +102,11 @@ public:
   /// \brief Return a textual representation of an ar::Value
   static std::string repr(ar::Value* value);
 
+private:
+  /// \brief Return true if the given value is a constant whose representation
+  /// is cheap to compute and does not depend on debug information
+  static bool is_scalar_constant(ar::Value* value);
+
 }; // end class OperandsTable
 
 } // end namespace analyzer
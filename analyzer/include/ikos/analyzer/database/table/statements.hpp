@@ -43,6 +43,8 @@
 
 #pragma once
 
+#include <mutex>
+
 #include <llvm/ADT/DenseMap.h>
 
 #include <ikos/ar/semantic/statement.hpp>
@@ -72,6 +74,9 @@ private:
   /// \brief Last inserted id
   sqlite::DbInt64 _last_insert_id = 0;
 
+  /// \brief Mutex
+  std::mutex _mutex;
+
 public:
   /// \brief Constructor
   StatementsTable(sqlite::DbConnection& db,
@@ -81,6 +86,9 @@ public:
   /// \brief Insert the given statement in the database and return the id
   sqlite::DbInt64 insert(ar::Statement* stmt);
 
+  /// \brief Number the next inserted rows starting from the given id
+  void set_next_id(sqlite::DbInt64 id) { this->_last_insert_id = id; }
+
 }; // end class StatementsTable
 
 } // end namespace analyzer
@@ -43,6 +43,8 @@
 
 #pragma once
 
+#include <mutex>
+
 #include <ikos/analyzer/database/table.hpp>
 
 namespace ikos {
@@ -53,6 +55,9 @@ class TimesTable : public DatabaseTable {
 private:
   sqlite::DbOstream _row;
 
+  /// \brief Mutex
+  std::mutex _mutex;
+
 public:
   /// \brief Constructor
   explicit TimesTable(sqlite::DbConnection& db);
@@ -44,6 +44,7 @@
 #pragma once
 
 #include <iostream>
+#include <mutex>
 
 #include <ikos/core/support/compiler.hpp>
 
@@ -178,6 +179,10 @@ public:
 
 /// \brief Logger on the terminal
 class TerminalLogger final : public Logger {
+private:
+  /// \brief Mutex
+  std::mutex _mutex;
+
 public:
   /// \brief Constructor
   explicit TerminalLogger(std::ostream& out) noexcept;
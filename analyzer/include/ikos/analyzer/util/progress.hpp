@@ -44,6 +44,7 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
 #include <string>
 
 #include <ikos/analyzer/analysis/option.hpp>
@@ -78,6 +79,9 @@ private:
   /// \brief Number of columns in the output stream
   std::size_t _out_columns;
 
+  /// \brief Mutex
+  std::mutex _mutex;
+
 public:
   /// \brief Constructor
   ///
@@ -121,6 +125,9 @@ private:
   /// \brief Number of tasks
   std::size_t _num_tasks;
 
+  /// \brief Mutex
+  std::mutex _mutex;
+
 public:
   /// \brief Constructor
   ///
@@ -147,6 +154,10 @@ public:
 
 /// \brief Progress logger that discards status updates
 class NoProgressLogger final : public ProgressLogger {
+private:
+  /// \brief Mutex
+  std::mutex _mutex;
+
 public:
   /// \brief Constructor
   explicit NoProgressLogger(std::ostream& out);
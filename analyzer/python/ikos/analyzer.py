@@ -82,6 +82,14 @@ def parse_arguments(argv):
                         metavar='<file>',
                         help='Output database file (default: output.db)',
                         default='output.db')
+    parser.add_argument('--output-format',
+                        dest='output_format',
+                        metavar='',
+                        help=args.help('Output format:',
+                                       args.output_formats,
+                                       args.default_output_format),
+                        choices=args.choices(args.output_formats),
+                        default=args.default_output_format)
     parser.add_argument('-v',
                         dest='verbosity',
                         help='Increase verbosity',
@@ -154,6 +162,12 @@ def parse_arguments(argv):
                           help='Disable the cache of fixpoints',
                           action='store_true',
                           default=False)
+    analysis.add_argument('--summary-cache',
+                          dest='summary_cache',
+                          metavar='<directory>',
+                          help='Directory of the persistent cache of analysis '
+                               'results, reused across runs',
+                          default=None)
     analysis.add_argument('--no-checks',
                           dest='no_checks',
                           help='Disable all the checks',
@@ -167,6 +181,13 @@ def parse_arguments(argv):
                                          args.default_procedurality),
                           choices=args.choices(args.proceduralities),
                           default=args.default_procedurality)
+    analysis.add_argument('--context-depth',
+                          dest='context_depth',
+                          metavar='',
+                          help='Maximum depth of the calling contexts, beyond '
+                               'which calling contexts with the same last '
+                               'calls are merged (requires --proc=inter)',
+                          type=args.Integer(min=0))
     analysis.add_argument('-j', '--jobs',
                           dest='jobs',
                           metavar='',
@@ -175,6 +196,14 @@ def parse_arguments(argv):
                           type=int,
                           const=0,
                           default=1)
+    analysis.add_argument('--workers',
+                          dest='workers',
+                          metavar='',
+                          help='Number of ikos-analyzer processes, each '
+                               'analyzing a shard of the functions '
+                               '(requires --proc=intra)',
+                          type=args.Integer(min=1),
+                          default=1)
     analysis.add_argument('--widening-strategy',
                           dest='widening_strategy',
                           metavar='',
@@ -498,6 +527,13 @@ def parse_arguments(argv):
                           dest='mem',
                           help='MEM limit (MB)',
                           type=args.Integer(min=1))
+    resource.add_argument('--mem-budget',
+                          dest='mem_budget',
+                          help='Memory usage (MB) above which fixpoints on '
+                               'called functions\nare spilled to temporary '
+                               'files (requires --proc=inter, '
+                               'default: unlimited)',
+                          type=args.Integer(min=0))
 
     opt = parser.parse_args(argv)
 
@@ -751,17 +787,12 @@ class AnalyzerError(Exception):
         self.returncode = returncode
 
 
-def ikos_analyzer(db_path, pp_path, opt):
-    if settings.BUILD_MODE == 'Debug':
-        log.warning('ikos was built in debug mode, the analysis might be slow')
-    if is_apron_domain(opt.domain) and opt.jobs != 1:
-        log.warning('apron abstract domains are not thread-safe, '
-                    'the analysis might crash')
-
-    # Fix huge slow down when ikos-analyzer uses DROP TABLE on an existing db
-    if os.path.isfile(db_path):
-        os.remove(db_path)
+def ikos_analyzer_command(db_path, pp_path, opt, shard=None):
+    '''
+    Return the ikos-analyzer command line
 
+    If shard is not None, only the functions of the given shard are analyzed.
+    '''
     cmd = [settings.ikos_analyzer()]
 
     # analysis options
@@ -783,6 +814,9 @@ def ikos_analyzer(db_path, pp_path, opt):
     else:
         cmd.append('-narrowing-strategy=%s' % opt.narrowing_strategy)
 
+    if opt.context_depth is not None:
+        cmd.append('-context-depth=%d' % opt.context_depth)
+
     if opt.narrowing_iterations is not None:
         cmd.append('-narrowing-iterations=%d' % opt.narrowing_iterations)
     elif (opt.narrowing_strategy == 'auto' and
@@ -808,12 +842,16 @@ def ikos_analyzer(db_path, pp_path, opt):
         cmd.append('-no-fixpoint-cache')
     if opt.no_checks:
         cmd.append('-no-checks')
+    if opt.summary_cache:
+        cmd.append('-summary-cache=%s' % opt.summary_cache)
     if opt.hardware_addresses:
         cmd.append('-hardware-addresses=%s' % ','.join(opt.hardware_addresses))
     if opt.hardware_addresses_file:
         cmd.append('-hardware-addresses-file=%s' % opt.hardware_addresses_file)
     if opt.argc is not None:
         cmd.append('-argc=%d' % opt.argc)
+    if opt.mem_budget is not None:
+        cmd.append('-mem-budget=%d' % opt.mem_budget)
 
     # import options
     cmd.append('-allow-dbg-mismatch')
@@ -874,11 +912,25 @@ def ikos_analyzer(db_path, pp_path, opt):
         cmd.append('-color=0')
 
     cmd.append('-log=%s' % opt.log_level)
-    cmd.append('-progress=%s' % opt.progress)
+
+    if shard is None:
+        cmd.append('-progress=%s' % opt.progress)
+    else:
+        # Progress reports of concurrent workers would be interleaved
+        cmd += ['-progress=no',
+                '-shard-count=%d' % opt.workers,
+                '-shard-index=%d' % shard]
 
     # input/output
+    if opt.output_format == 'binary':
+        cmd.append('-output-format=binary')
     cmd += [pp_path, '-o', db_path]
 
+    return cmd
+
+
+def start_ikos_analyzer(cmd, opt):
+    ''' Start an ikos-analyzer process, return the process and its timer '''
     # set resource limit, if requested
     if opt.mem:
         import resource  # fails on Windows
@@ -897,7 +949,6 @@ def ikos_analyzer(db_path, pp_path, opt):
         except OSError:
             pass
 
-    log.info('Running ikos analyzer')
     log.debug('Running %s' % command_string(cmd))
     p = subprocess.Popen(cmd, preexec_fn=set_limits)
     timer = threading.Timer(opt.cpu, kill, [p])
@@ -905,6 +956,11 @@ def ikos_analyzer(db_path, pp_path, opt):
     if opt.cpu:
         timer.start()
 
+    return p, timer
+
+
+def wait_ikos_analyzer(cmd, p, timer):
+    ''' Wait for an ikos-analyzer process, raise AnalyzerError on failure '''
     try:
         if sys.platform.startswith('win'):
             return_status = p.wait()
@@ -940,6 +996,110 @@ def ikos_analyzer(db_path, pp_path, opt):
                             signum)
 
 
+def ikos_analyzer(db_path, pp_path, opt, wd):
+    '''
+    Run ikos-analyzer, raise AnalyzerError on failure
+
+    Returns the list of (shard, AnalyzerError) of the workers that failed,
+    see ikos_analyzer_workers.
+    '''
+    if settings.BUILD_MODE == 'Debug':
+        log.warning('ikos was built in debug mode, the analysis might be slow')
+    if is_apron_domain(opt.domain) and opt.jobs != 1:
+        log.warning('apron abstract domains are not thread-safe, '
+                    'the analysis might crash')
+
+    # Fix huge slow down when ikos-analyzer uses DROP TABLE on an existing db
+    if os.path.isfile(db_path):
+        os.remove(db_path)
+
+    if opt.workers > 1:
+        return ikos_analyzer_workers(db_path, pp_path, opt, wd)
+
+    log.info('Running ikos analyzer')
+    cmd = ikos_analyzer_command(db_path, pp_path, opt)
+    p, timer = start_ikos_analyzer(cmd, opt)
+    wait_ikos_analyzer(cmd, p, timer)
+    return []
+
+
+def ikos_analyzer_workers(db_path, pp_path, opt, wd):
+    '''
+    Run one ikos-analyzer process per shard of functions, then merge their
+    output databases into db_path
+
+    A failing worker only loses the checks of its shard. Returns the list of
+    (shard, AnalyzerError) of the failed workers, and raises the first error
+    if every worker failed.
+    '''
+    log.info('Running ikos analyzer with %d workers' % opt.workers)
+    workers = []
+    for shard in range(opt.workers):
+        shard_path = os.path.join(wd, 'shard-%d.db' % shard)
+        if os.path.isfile(shard_path):
+            os.remove(shard_path)
+        cmd = ikos_analyzer_command(shard_path, pp_path, opt, shard)
+        p, timer = start_ikos_analyzer(cmd, opt)
+        workers.append((shard, shard_path, cmd, p, timer))
+
+    shard_paths = []
+    failures = []
+    for shard, shard_path, cmd, p, timer in workers:
+        try:
+            wait_ikos_analyzer(cmd, p, timer)
+            shard_paths.append(shard_path)
+        except AnalyzerError as e:
+            log.error('Worker %d: %s, the functions of its shard are not '
+                      'analyzed' % (shard, e))
+            log.debug('Failed command: %s' % command_string(e.cmd))
+            failures.append((shard, e))
+
+    if not shard_paths:
+        raise failures[0][1]
+
+    log.info('Merging the output databases of %d workers' % len(shard_paths))
+    shutil.copyfile(shard_paths[0], db_path)
+    db = OutputDatabase(path=db_path)
+    for shard_path in shard_paths[1:]:
+        db.merge(shard_path)
+    db.close()
+
+    return failures
+
+
+def report_results_file(opt):
+    '''
+    Print the timing results and the checks of the binary results file
+
+    The timing results of ikos-analyzer are not available, since the results
+    file only holds the checks. Returns the exit status.
+    '''
+    first = (log.LEVEL >= log.ERROR)
+
+    # display timing results
+    if opt.display_times != 'no':
+        if not first:
+            printf('\n')
+        report.print_timings(sorted(stats.rows()))
+        first = False
+
+    if opt.display_summary == 'no' and opt.format == 'no':
+        return 0
+
+    if not first and opt.report_file is sys.stdout:
+        printf('\n')
+
+    # the report is generated by ikos-results
+    if opt.format == 'auto':
+        opt.format = 'text'
+    status = report.report_results_file(opt.output_db, opt)
+
+    if opt.remove_db:
+        os.remove(opt.output_db)
+
+    return status
+
+
 def ikos_view(opt, db):
     from ikos import view
     v = view.View(db)
@@ -962,6 +1122,45 @@ def main(argv):
     colors.setup(opt.color, file=log.out)
     log.setup(opt.log_level)
 
+    if opt.workers > 1 and opt.procedural != 'intra':
+        printf('%s: error: --workers requires --proc=intra\n',
+               progname, file=sys.stderr)
+        sys.exit(1)
+
+    if opt.output_format == 'binary':
+        if opt.workers > 1:
+            printf('%s: error: --workers requires --output-format=db\n',
+                   progname, file=sys.stderr)
+            sys.exit(1)
+        if opt.display_raw_checks:
+            printf('%s: error: --display-raw-checks requires '
+                   '--output-format=db\n', progname, file=sys.stderr)
+            sys.exit(1)
+        if opt.format not in ('auto', 'text', 'no'):
+            printf('%s: error: --output-format=binary only supports the text '
+                   'report format\n', progname, file=sys.stderr)
+            sys.exit(1)
+
+    if opt.summary_cache and opt.procedural == 'summary':
+        printf('%s: error: --summary-cache cannot be used with '
+               '--proc=summary\n', progname, file=sys.stderr)
+        sys.exit(1)
+
+    if opt.context_depth is not None and opt.procedural != 'inter':
+        printf('%s: error: --context-depth requires --proc=inter\n',
+               progname, file=sys.stderr)
+        sys.exit(1)
+
+    if opt.context_depth is not None and opt.summary_cache:
+        printf('%s: error: --context-depth cannot be used with '
+               '--summary-cache\n', progname, file=sys.stderr)
+        sys.exit(1)
+
+    if opt.mem_budget is not None and opt.procedural != 'inter':
+        printf('%s: error: --mem-budget requires --proc=inter\n',
+               progname, file=sys.stderr)
+        sys.exit(1)
+
     if is_apron_domain(opt.domain) and not settings.HAS_APRON:
         printf('%s: error: cannot use apron abstract domains.\n'
                'ikos was compiled without apron support, '
@@ -1018,11 +1217,14 @@ def main(argv):
     # ikos-analyzer: analyze llvm bitcode
     try:
         with stats.timer('ikos-analyzer'):
-            ikos_analyzer(opt.output_db, pp_path, opt)
+            failures = ikos_analyzer(opt.output_db, pp_path, opt, wd)
     except AnalyzerError as e:
         printf('%s: error: %s\n', progname, e, file=sys.stderr)
         sys.exit(e.returncode)
 
+    if opt.output_format == 'binary':
+        sys.exit(report_results_file(opt))
+
     # open output database
     db = OutputDatabase(path=opt.output_db)
 
@@ -1053,6 +1255,10 @@ def main(argv):
         settings_rows.append(('cpu-limit', opt.cpu))
     if opt.mem:
         settings_rows.append(('mem-limit', opt.mem))
+    if opt.workers > 1:
+        settings_rows.append(('workers', opt.workers))
+        settings_rows.append(('failed-workers',
+                              json.dumps([shard for shard, _ in failures])))
     db.insert_settings(settings_rows)
 
     first = (log.LEVEL >= log.ERROR)
@@ -1078,9 +1284,20 @@ def main(argv):
         report.print_raw_checks(db, opt.procedural == 'inter')
         first = False
 
+    # the results are incomplete if a worker failed
+    if failures:
+        printf('%s: error: %d of %d workers failed, the functions of their '
+               'shards were not analyzed: %s\n',
+               progname, len(failures), opt.workers,
+               ', '.join('worker %d (%s)' % (shard, e)
+                         for shard, e in failures),
+               file=sys.stderr)
+
     # start ikos-view
     if opt.format == 'web':
         ikos_view(opt, db)
+        if failures:
+            sys.exit(failures[0][1].returncode or 1)
         return
 
     # report
@@ -1107,3 +1324,6 @@ def main(argv):
 
     if opt.remove_db:
         os.remove(opt.output_db)
+
+    if failures:
+        sys.exit(failures[0][1].returncode or 1)
@@ -206,6 +206,12 @@ domains = (
      'Reduced product of Interval and Congruence'),
     ('dbm',
      'Difference-Bound Matrices domain'),
+    ('split-dbm',
+     'Sparse Difference-Bound Matrices domain'),
+    ('fixed-width-dbm',
+     'Difference-Bound Matrices domain on machine integers'),
+    ('fixed-width-octagon',
+     'Octagon domain on machine integers'),
     ('var-pack-dbm',
      'Difference-Bound Matrices domain with variable packing'),
     ('var-pack-dbm-congruence',
@@ -257,6 +263,7 @@ default_globals_init_policy = 'skip-big-arrays'
 proceduralities = (
     ('inter', 'Interprocedural analysis'),
     ('intra', 'Intraprocedural analysis'),
+    ('summary', 'Summary-based interprocedural analysis'),
 )
 
 default_procedurality = 'inter'
@@ -345,6 +352,15 @@ progress_choices = (
 
 default_progress = 'auto'
 
+# Output options choices
+
+output_formats = (
+    ('db', 'SQLite database, for all report formats'),
+    ('binary', 'Compact binary results file, holding only the checks'),
+)
+
+default_output_format = 'db'
+
 # Report options choices
 
 display_times_choices = (
@@ -111,6 +111,35 @@ class OutputDatabase(object):
         c.executemany('INSERT INTO times VALUES (?, ?)', rows)
         self.con.commit()
 
+    def merge(self, path):
+        '''
+        Merge the output database of another shard of the same analysis
+
+        Shards number their rows from distinct bases, see ikos-analyzer
+        -shard-index, so rows are copied as is. Every shard inserts all the
+        functions, with the same ids, thus only files need to be deduplicated.
+        '''
+        c = self.con.cursor()
+        c.execute('ATTACH DATABASE ? AS shard', (path,))
+        for table in ('files', 'statements', 'operands', 'call_contexts',
+                      'memory_locations', 'checks'):
+            c.execute('INSERT OR IGNORE INTO %s SELECT * FROM shard.%s'
+                      % (table, table))
+        c.execute('INSERT INTO times SELECT * FROM shard.times')
+        self.con.commit()
+        c.execute('DETACH DATABASE shard')
+
+        # Use the smallest id for files with the same path
+        for table in ('functions', 'statements'):
+            c.execute('UPDATE %s SET file_id = ('
+                      ' SELECT MIN(f2.id) FROM files f1, files f2'
+                      ' WHERE f1.id = %s.file_id AND f2.path = f1.path)'
+                      ' WHERE file_id IN (SELECT id FROM files)'
+                      % (table, table))
+        c.execute('DELETE FROM files WHERE id NOT IN ('
+                  ' SELECT MIN(id) FROM files GROUP BY path)')
+        self.con.commit()
+
     @CachedProperty
     def files(self):
         return self._fetch_table('files', File)
@@ -50,6 +50,7 @@ import operator
 import os
 import os.path
 import sqlite3
+import subprocess
 import sys
 from xml.etree import ElementTree
 from xml.sax.saxutils import escape
@@ -102,8 +103,11 @@ def format_time(elapsed):
 
 def print_timing_results(db, full=True, sort=True):
     ''' Print the timing results from the database '''
-    results = db.load_timing_results(full, sort)
+    print_timings(db.load_timing_results(full, sort))
 
+
+def print_timings(results):
+    ''' Print a list of tuples (pass, elapsed) '''
     printf(bold('# Time stats:') + '\n')
     name_width = max(len(name) for name, _ in results)
     for name, elapsed in results:
@@ -399,6 +403,46 @@ def print_raw_checks(db, interprocedural):
     c.close()
 
 
+#######################
+# binary results file #
+#######################
+
+RESULTS_FILE_MAGIC = b'IKOSRES\0'
+
+
+def is_results_file(path):
+    ''' Return True if the file was created with --output-format=binary '''
+    with open(path, 'rb') as f:
+        return f.read(len(RESULTS_FILE_MAGIC)) == RESULTS_FILE_MAGIC
+
+
+def report_results_file(path, opt, analyses_filter=None):
+    '''
+    Print the checks of a binary results file, using ikos-results
+
+    Binary results files only hold the checks, hence only the summary and the
+    text format are available.
+
+    Returns the exit status of ikos-results.
+    '''
+    cmd = [settings.ikos_results()]
+    if (opt.format == 'no' or not opt.status_filter or
+            (analyses_filter is not None and not analyses_filter)):
+        cmd.append('-display-checks=false')
+    else:
+        cmd.append('-status-filter=' + ','.join(sorted(opt.status_filter)))
+        if analyses_filter is not None:
+            cmd.append('-analyses-filter=' + ','.join(sorted(analyses_filter)))
+    if opt.display_summary != 'no':
+        cmd.append('-summary')
+    if opt.report_verbosity > 1:
+        cmd.append('-display-info')
+    cmd.append(path)
+
+    opt.report_file.flush()
+    return subprocess.call(cmd, stdout=opt.report_file)
+
+
 ##########
 # report #
 ##########
@@ -2223,6 +2267,17 @@ def main(argv):
                progname, opt.file, file=sys.stderr)
         sys.exit(1)
 
+    if is_results_file(opt.file):
+        if opt.display_times != 'no' or opt.display_raw_checks:
+            printf('%s: error: binary results files do not hold timing '
+                   'results or raw checks\n', progname, file=sys.stderr)
+            sys.exit(1)
+        if opt.format not in ('text', 'no'):
+            printf('%s: error: binary results files only support the text '
+                   'format\n', progname, file=sys.stderr)
+            sys.exit(1)
+        sys.exit(report_results_file(opt.file, opt, opt.analyses_filter))
+
     try:
         # open result database
         db = OutputDatabase(opt.file)
@@ -41,6 +41,8 @@
  *
  ******************************************************************************/
 
+#include <vector>
+
 #include <boost/thread/locks.hpp>
 
 #include <ikos/analyzer/analysis/call_context.hpp>
@@ -48,8 +50,8 @@
 namespace ikos {
 namespace analyzer {
 
-CallContextFactory::CallContextFactory()
-    : _empty_call_context(new CallContext()) {}
+CallContextFactory::CallContextFactory(boost::optional< unsigned > max_depth)
+    : _empty_call_context(new CallContext()), _max_depth(max_depth) {}
 
 CallContextFactory::~CallContextFactory() = default;
 
@@ -57,6 +59,29 @@ CallContext* CallContextFactory::get_context(CallContext* parent,
                                              ar::CallBase* call) {
   ikos_assert(parent != nullptr && call != nullptr);
 
+  if (!this->_max_depth || parent->depth() < *this->_max_depth) {
+    return this->get_or_create(parent, call);
+  }
+
+  // Keep the last k - 1 call statements of the parent context
+  std::vector< ar::CallBase* > calls;
+  if (*this->_max_depth > 0) {
+    calls.push_back(call);
+  }
+  for (CallContext* context = parent; calls.size() < *this->_max_depth;
+       context = context->parent()) {
+    calls.push_back(context->call());
+  }
+
+  CallContext* context = this->get_empty();
+  for (auto it = calls.rbegin(), et = calls.rend(); it != et; ++it) {
+    context = this->get_or_create(context, *it);
+  }
+  return context;
+}
+
+CallContext* CallContextFactory::get_or_create(CallContext* parent,
+                                               ar::CallBase* call) {
   {
     boost::shared_lock< boost::shared_mutex > lock(this->_mutex);
     auto it = this->_map.find({parent, call});
@@ -0,0 +1,237 @@
+/*******************************************************************************
+ *
+ * \file
+ * \brief Call graph and its strongly connected components
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#include <algorithm>
+#include <limits>
+
+#include <ikos/ar/semantic/code.hpp>
+#include <ikos/ar/semantic/statement.hpp>
+
+#include <ikos/analyzer/analysis/call_graph.hpp>
+#include <ikos/analyzer/analysis/memory_location.hpp>
+#include <ikos/analyzer/analysis/pointer/function.hpp>
+#include <ikos/analyzer/analysis/variable.hpp>
+#include <ikos/analyzer/support/assert.hpp>
+#include <ikos/analyzer/support/cast.hpp>
+
+namespace ikos {
+namespace analyzer {
+
+CallGraph::CallGraph(Context& ctx) {
+  ar::Bundle* bundle = ctx.bundle;
+
+  for (auto it = bundle->function_begin(), et = bundle->function_end();
+       it != et;
+       ++it) {
+    ar::Function* fun = *it;
+    if (fun->is_definition()) {
+      this->_function_index.try_emplace(fun, this->_functions.size());
+      this->_functions.push_back(fun);
+    }
+  }
+
+  std::size_t n = this->_functions.size();
+
+  this->_successors.reserve(n);
+  for (ar::Function* fun : this->_functions) {
+    this->_successors.push_back(this->compute_successors(ctx, fun));
+  }
+  const auto& succs = this->_successors;
+
+  // Tarjan's algorithm, without recursion
+  //
+  // Components are found in reverse topological order, i.e bottom-up.
+  const std::size_t undefined = std::numeric_limits< std::size_t >::max();
+  std::vector< std::size_t > index(n, undefined);
+  std::vector< std::size_t > lowlink(n, 0);
+  std::vector< bool > on_stack(n, false);
+  std::vector< std::size_t > stack;
+  std::size_t counter = 0;
+
+  // Depth-first search stack of (node, index of the next successor)
+  std::vector< std::pair< std::size_t, std::size_t > > dfs;
+
+  this->_scc_index.resize(n, undefined);
+
+  for (std::size_t root = 0; root < n; root++) {
+    if (index[root] != undefined) {
+      continue;
+    }
+
+    index[root] = lowlink[root] = counter++;
+    stack.push_back(root);
+    on_stack[root] = true;
+    dfs.emplace_back(root, 0);
+
+    while (!dfs.empty()) {
+      std::size_t v = dfs.back().first;
+
+      if (dfs.back().second < succs[v].size()) {
+        std::size_t w = succs[v][dfs.back().second++];
+
+        if (index[w] == undefined) {
+          index[w] = lowlink[w] = counter++;
+          stack.push_back(w);
+          on_stack[w] = true;
+          dfs.emplace_back(w, 0);
+        } else if (on_stack[w]) {
+          lowlink[v] = std::min(lowlink[v], index[w]);
+        }
+        continue;
+      }
+
+      dfs.pop_back();
+      if (!dfs.empty()) {
+        std::size_t u = dfs.back().first;
+        lowlink[u] = std::min(lowlink[u], lowlink[v]);
+      }
+
+      if (lowlink[v] == index[v]) {
+        // v is the root of a component
+        std::size_t scc = this->_sccs.size();
+        std::vector< std::size_t > members;
+        std::size_t w;
+        do {
+          w = stack.back();
+          stack.pop_back();
+          on_stack[w] = false;
+          this->_scc_index[w] = scc;
+          members.push_back(w);
+        } while (w != v);
+
+        std::sort(members.begin(), members.end());
+        std::vector< ar::Function* > functions;
+        functions.reserve(members.size());
+        for (std::size_t m : members) {
+          functions.push_back(this->_functions[m]);
+        }
+        this->_sccs.push_back(std::move(functions));
+      }
+    }
+  }
+
+  // Edges between components
+  this->_callees.resize(this->_sccs.size());
+  this->_callers.resize(this->_sccs.size());
+  for (std::size_t v = 0; v < n; v++) {
+    std::size_t s = this->_scc_index[v];
+    for (std::size_t w : succs[v]) {
+      std::size_t t = this->_scc_index[w];
+      if (s != t) {
+        this->_callees[s].push_back(t);
+        this->_callers[t].push_back(s);
+      }
+    }
+  }
+  for (auto& edges : this->_callees) {
+    std::sort(edges.begin(), edges.end());
+    edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+  }
+  for (auto& edges : this->_callers) {
+    std::sort(edges.begin(), edges.end());
+    edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+  }
+}
+
+CallGraph::~CallGraph() = default;
+
+std::size_t CallGraph::function_index(ar::Function* fun) const {
+  auto it = this->_function_index.find(fun);
+  ikos_assert_msg(it != this->_function_index.end(),
+                  "function is not a definition");
+  return it->second;
+}
+
+bool CallGraph::calls(std::size_t caller, std::size_t callee) const {
+  const auto& edges = this->_callees[caller];
+  return std::binary_search(edges.begin(), edges.end(), callee);
+}
+
+std::vector< std::size_t > CallGraph::compute_successors(
+    Context& ctx, ar::Function* fun) const {
+  std::vector< std::size_t > succs;
+
+  auto add = [&](ar::Function* callee) {
+    if (callee->is_definition()) {
+      succs.push_back(this->function_index(callee));
+    }
+  };
+
+  for (ar::BasicBlock* bb : *fun->body()) {
+    for (ar::Statement* stmt : *bb) {
+      auto call = dyn_cast< ar::CallBase >(stmt);
+      if (call == nullptr) {
+        continue;
+      }
+
+      ar::Value* called = call->called();
+      if (auto cst = dyn_cast< ar::FunctionPointerConstant >(called)) {
+        add(cst->function());
+      } else if (auto ptr = dyn_cast< ar::InternalVariable >(called)) {
+        if (ctx.function_pointer == nullptr) {
+          continue;
+        }
+
+        Variable* ptr_var = ctx.var_factory->get_internal(ptr);
+        PointsToSet points_to =
+            ctx.function_pointer->results().get(ptr_var).points_to();
+        if (points_to.is_bottom() || points_to.is_top()) {
+          continue;
+        }
+
+        for (MemoryLocation* mem : points_to) {
+          if (auto fun_mem = dyn_cast< FunctionMemoryLocation >(mem)) {
+            add(fun_mem->function());
+          }
+        }
+      }
+    }
+  }
+
+  std::sort(succs.begin(), succs.end());
+  succs.erase(std::unique(succs.begin(), succs.end()), succs.end());
+  return succs;
+}
+
+} // end namespace analyzer
+} // end namespace ikos
@@ -483,6 +483,7 @@ void LivenessAnalysis::run(ar::Code* code) {
   fixpoint.run(LivenessDomain< Variable* >::bottom());
 
   // Store the results
+  std::lock_guard< std::mutex > lock(this->_mutex);
   for (auto it = fixpoint.live_at_entry_begin(),
             et = fixpoint.live_at_entry_end();
        it != et;
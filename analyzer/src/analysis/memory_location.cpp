@@ -43,9 +43,12 @@
  *
  ******************************************************************************/
 
+#include <limits>
+
 #include <boost/thread/locks.hpp>
 
 #include <ikos/analyzer/analysis/memory_location.hpp>
+#include <ikos/analyzer/exception.hpp>
 #include <ikos/analyzer/util/source_location.hpp>
 
 namespace ikos {
@@ -53,7 +56,8 @@ namespace analyzer {
 
 // MemoryLocation
 
-MemoryLocation::MemoryLocation(MemoryLocationKind kind) : _kind(kind) {}
+MemoryLocation::MemoryLocation(MemoryLocationKind kind)
+    : _kind(kind), _index(0) {}
 
 MemoryLocation::~MemoryLocation() = default;
 
@@ -162,9 +166,14 @@ void DynAllocMemoryLocation::dump(std::ostream& o) const {
 // MemoryFactory
 
 MemoryFactory::MemoryFactory()
-    : _absolute_zero(std::make_unique< AbsoluteZeroMemoryLocation >()),
+    : _next_index(0),
+      _absolute_zero(std::make_unique< AbsoluteZeroMemoryLocation >()),
       _argv(std::make_unique< ArgvMemoryLocation >()),
-      _libc_errno(std::make_unique< LibcErrnoMemoryLocation >()) {}
+      _libc_errno(std::make_unique< LibcErrnoMemoryLocation >()) {
+  this->set_index(this->_absolute_zero.get());
+  this->set_index(this->_argv.get());
+  this->set_index(this->_libc_errno.get());
+}
 
 MemoryFactory::~MemoryFactory() = default;
 
@@ -182,6 +191,9 @@ LocalMemoryLocation* MemoryFactory::get_local(ar::LocalVariable* var) {
   {
     boost::unique_lock< boost::shared_mutex > lock(this->_local_memory_mutex);
     auto res = this->_local_memory_map.try_emplace(var, std::move(ml));
+    if (res.second) {
+      this->set_index(res.first->second.get());
+    }
     return res.first->second.get();
   }
 }
@@ -200,6 +212,9 @@ GlobalMemoryLocation* MemoryFactory::get_global(ar::GlobalVariable* var) {
   {
     boost::unique_lock< boost::shared_mutex > lock(this->_global_memory_mutex);
     auto res = this->_global_memory_map.try_emplace(var, std::move(ml));
+    if (res.second) {
+      this->set_index(res.first->second.get());
+    }
     return res.first->second.get();
   }
 }
@@ -220,6 +235,9 @@ FunctionMemoryLocation* MemoryFactory::get_function(ar::Function* fun) {
     boost::unique_lock< boost::shared_mutex > lock(
         this->_function_memory_mutex);
     auto res = this->_function_memory_map.try_emplace(fun, std::move(ml));
+    if (res.second) {
+      this->set_index(res.first->second.get());
+    }
     return res.first->second.get();
   }
 }
@@ -246,6 +264,9 @@ AggregateMemoryLocation* MemoryFactory::get_aggregate(
     boost::unique_lock< boost::shared_mutex > lock(
         this->_aggregate_memory_mutex);
     auto res = this->_aggregate_memory_map.try_emplace(var, std::move(ml));
+    if (res.second) {
+      this->set_index(res.first->second.get());
+    }
     return res.first->second.get();
   }
 }
@@ -277,9 +298,33 @@ DynAllocMemoryLocation* MemoryFactory::get_dyn_alloc(ar::CallBase* call,
   {
     boost::unique_lock< boost::shared_mutex > lock(this->_dyn_alloc_mutex);
     auto res = this->_dyn_alloc_map.try_emplace({call, context}, std::move(ml));
+    if (res.second) {
+      this->set_index(res.first->second.get());
+    }
     return res.first->second.get();
   }
 }
 
+void MemoryFactory::set_index(MemoryLocation* ml) {
+  // The memory location is published through the mutex of its map
+  std::uint32_t index =
+      this->_next_index.fetch_add(1, std::memory_order_relaxed);
+  if (index == std::numeric_limits< std::uint32_t >::max()) {
+    throw LogicError("memory factory: too many memory locations");
+  }
+
+  ml->_index = index;
+
+  this->_index_map.grow_to_at_least(index + 1);
+  this->_index_map[index] = ml;
+}
+
+MemoryLocation* MemoryFactory::get_by_index(std::uint32_t index) const {
+  if (index >= this->_index_map.size()) {
+    return nullptr;
+  }
+  return this->_index_map[index];
+}
+
 } // end namespace analyzer
 } // end namespace ikos
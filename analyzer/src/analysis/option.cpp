@@ -111,6 +111,14 @@ void AnalysisOptions::save(SettingsTable& table) {
 
   table.insert("use-fixpoint-cache", this->use_fixpoint_cache);
 
+  if (this->memory_budget) {
+    table.insert("memory-budget", std::to_string(*this->memory_budget));
+  }
+
+  if (this->context_depth) {
+    table.insert("context-depth", std::to_string(*this->context_depth));
+  }
+
   table.insert("use-checks", this->use_checks);
 
   table.insert("trace-ar-statements", this->trace_ar_statements);
@@ -124,6 +132,10 @@ void AnalysisOptions::save(SettingsTable& table) {
   if (this->argc) {
     table.insert("argc", std::to_string(*this->argc));
   }
+
+  if (this->summary_cache) {
+    table.insert("summary-cache", *this->summary_cache);
+  }
 }
 
 } // end namespace analyzer
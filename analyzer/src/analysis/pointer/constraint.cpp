@@ -44,6 +44,8 @@
  *
  ******************************************************************************/
 
+#include <tbb/global_control.h>
+
 #include <ikos/analyzer/analysis/pointer/constraint.hpp>
 
 namespace ikos {
@@ -58,8 +60,28 @@ void PointerConstraints::add(std::unique_ptr< PointerConstraint > cst) {
   this->_system.add(std::move(cst));
 }
 
-void PointerConstraints::solve() {
-  this->_system.solve();
+void PointerConstraints::add(PointerConstraintList& csts) {
+  for (auto& cst : csts) {
+    this->_system.add(std::move(cst));
+  }
+  csts.clear();
+}
+
+void PointerConstraints::solve(int num_threads) {
+  if (num_threads == 1) {
+    this->_system.solve();
+    return;
+  }
+
+  // Set the number of threads, for the duration of the resolution
+  std::unique_ptr< tbb::global_control > init;
+  if (num_threads > 0) {
+    init = std::make_unique< tbb::global_control >(
+        tbb::global_control::max_allowed_parallelism,
+        static_cast< std::size_t >(num_threads));
+  }
+
+  this->_system.concurrent_solve();
 }
 
 void PointerConstraints::results(PointerInfo& info) const {
@@ -129,9 +129,7 @@ void FunctionPointerAnalysis::run() {
 
   log::debug("Generating pointer constraints");
   PointerConstraints constraints(bundle->data_layout());
-  PointerConstraintsGenerator< EmptyCodeInvariants > visitor(_ctx,
-                                                             constraints,
-                                                             nullptr);
+  PointerConstraintList csts;
 
   for (auto it = bundle->global_begin(), et = bundle->global_end(); it != et;
        ++it) {
@@ -141,10 +139,9 @@ void FunctionPointerAnalysis::run() {
           "Generating pointer constraints for initializer of global variable "
           "'" +
           demangle(gv->name()) + "'");
-      visitor.process_global_var_def(gv, EmptyCodeInvariants());
-    } else {
-      visitor.process_global_var_decl(gv);
     }
+    this->generate(gv, csts);
+    constraints.add(csts);
   }
 
   for (auto it = bundle->function_begin(), et = bundle->function_end();
@@ -154,18 +151,45 @@ void FunctionPointerAnalysis::run() {
     if (fun->is_definition()) {
       progress->start_task("Generating pointer constraints for function '" +
                            demangle(fun->name()) + "'");
-      visitor.process_function_def(fun, EmptyCodeInvariants());
-    } else {
-      visitor.process_function_decl(fun);
     }
+    this->generate(fun, csts);
+    constraints.add(csts);
   }
 
   log::debug("Solving pointer constraints");
   progress->start_task("Solving pointer constraints");
-  constraints.solve();
+  this->solve(constraints);
+}
+
+void FunctionPointerAnalysis::generate(ar::GlobalVariable* gv,
+                                       PointerConstraintList& csts) {
+  PointerConstraintsGenerator< EmptyCodeInvariants > visitor(_ctx,
+                                                             csts,
+                                                             nullptr);
+  if (gv->is_definition()) {
+    visitor.process_global_var_def(gv, EmptyCodeInvariants());
+  } else {
+    visitor.process_global_var_decl(gv);
+  }
+}
+
+void FunctionPointerAnalysis::generate(ar::Function* fun,
+                                       PointerConstraintList& csts) {
+  PointerConstraintsGenerator< EmptyCodeInvariants > visitor(_ctx,
+                                                             csts,
+                                                             nullptr);
+  if (fun->is_definition()) {
+    visitor.process_function_def(fun, EmptyCodeInvariants());
+  } else {
+    visitor.process_function_decl(fun);
+  }
+}
+
+void FunctionPointerAnalysis::solve(PointerConstraints& csts) {
+  csts.solve(_ctx.opts.num_threads);
 
   // Save information
-  constraints.results(this->_info);
+  csts.results(this->_info);
 }
 
 void FunctionPointerAnalysis::dump(std::ostream& o) const {
@@ -322,46 +322,34 @@ void PointerAnalysis::run() {
       make_progress_logger(_ctx.opts.progress,
                            LogLevel::Info,
                            /* num_tasks = */
-                           2 * std::count_if(bundle->global_begin(),
-                                             bundle->global_end(),
-                                             [](ar::GlobalVariable* gv) {
-                                               return gv->is_definition();
+                           std::count_if(bundle->global_begin(),
+                                         bundle->global_end(),
+                                         [](ar::GlobalVariable* gv) {
+                                           return gv->is_definition();
+                                         }) +
+                               std::count_if(bundle->function_begin(),
+                                             bundle->function_end(),
+                                             [](ar::Function* fun) {
+                                               return fun->is_definition();
                                              }) +
-                               2 * std::count_if(bundle->function_begin(),
-                                                 bundle->function_end(),
-                                                 [](ar::Function* fun) {
-                                                   return fun->is_definition();
-                                                 }) +
                                1);
   ScopeLogger scope(*progress);
 
   log::debug("Generating pointer constraints");
   PointerConstraints constraints(bundle->data_layout());
-
-  PointerConstraintsGenerator< NumericalCodeInvariants >
-      visitor(_ctx, constraints, &_function_pointer.results());
+  PointerConstraintList csts;
 
   for (auto it = bundle->global_begin(), et = bundle->global_end(); it != et;
        ++it) {
     ar::GlobalVariable* gv = *it;
     if (gv->is_definition()) {
-      progress->start_task(
-          "Generating intra-procedural numerical invariant for initializer of "
-          "global variable '" +
-          demangle(gv->name()) + "'");
-      NumericalCodeInvariants invariants(_ctx,
-                                         _function_pointer,
-                                         gv->initializer());
-      invariants.run(make_initial_abstract_value());
-
       progress->start_task(
           "Generating pointer constraints for initializer of global variable "
           "'" +
           demangle(gv->name()) + "'");
-      visitor.process_global_var_def(gv, invariants);
-    } else {
-      visitor.process_global_var_decl(gv);
     }
+    this->generate(gv, csts);
+    constraints.add(csts);
   }
 
   for (auto it = bundle->function_begin(), et = bundle->function_end();
@@ -369,26 +357,53 @@ void PointerAnalysis::run() {
        ++it) {
     ar::Function* fun = *it;
     if (fun->is_definition()) {
-      progress->start_task(
-          "Generating intra-procedural numerical invariant for function '" +
-          demangle(fun->name()) + "'");
-      NumericalCodeInvariants invariants(_ctx, _function_pointer, fun->body());
-      invariants.run(make_initial_abstract_value());
-
       progress->start_task("Generating pointer constraints for function '" +
                            demangle(fun->name()) + "'");
-      visitor.process_function_def(fun, invariants);
-    } else {
-      visitor.process_function_decl(fun);
     }
+    this->generate(fun, csts);
+    constraints.add(csts);
   }
 
   log::debug("Solving pointer constraints");
   progress->start_task("Solving pointer constraints");
-  constraints.solve();
+  this->solve(constraints);
+}
+
+void PointerAnalysis::generate(ar::GlobalVariable* gv,
+                               PointerConstraintList& csts) {
+  PointerConstraintsGenerator< NumericalCodeInvariants >
+      visitor(_ctx, csts, &_function_pointer.results());
+
+  if (gv->is_definition()) {
+    NumericalCodeInvariants invariants(_ctx,
+                                       _function_pointer,
+                                       gv->initializer());
+    invariants.run(make_initial_abstract_value());
+    visitor.process_global_var_def(gv, invariants);
+  } else {
+    visitor.process_global_var_decl(gv);
+  }
+}
+
+void PointerAnalysis::generate(ar::Function* fun,
+                               PointerConstraintList& csts) {
+  PointerConstraintsGenerator< NumericalCodeInvariants >
+      visitor(_ctx, csts, &_function_pointer.results());
+
+  if (fun->is_definition()) {
+    NumericalCodeInvariants invariants(_ctx, _function_pointer, fun->body());
+    invariants.run(make_initial_abstract_value());
+    visitor.process_function_def(fun, invariants);
+  } else {
+    visitor.process_function_decl(fun);
+  }
+}
+
+void PointerAnalysis::solve(PointerConstraints& csts) {
+  csts.solve(_ctx.opts.num_threads);
 
   // Save information
-  constraints.results(this->_info);
+  csts.results(this->_info);
 }
 
 /// \brief Dump the pointer analysis results, for debugging purpose
@@ -44,6 +44,9 @@
  *
  ******************************************************************************/
 
+#include <algorithm>
+#include <vector>
+
 #include <ikos/analyzer/analysis/pointer/value.hpp>
 
 namespace ikos {
@@ -73,10 +76,23 @@ void PointerInfo::insert(Variable* v, const PointerAbsValue& value) {
 }
 
 void PointerInfo::dump(std::ostream& o) const {
+  // Sort by variable index, for a reproducible output
+  std::vector< const PointerMap::value_type* > entries;
+  entries.reserve(this->_map.size());
   for (const auto& ptr : this->_map) {
-    ptr.first->dump(o);
+    entries.push_back(&ptr);
+  }
+  std::sort(entries.begin(),
+            entries.end(),
+            [](const PointerMap::value_type* a,
+               const PointerMap::value_type* b) {
+              return a->first->index() < b->first->index();
+            });
+
+  for (const auto* ptr : entries) {
+    ptr->first->dump(o);
     o << " -> ";
-    ptr.second.dump(o);
+    ptr->second.dump(o);
     o << "\n";
   }
 }
@@ -0,0 +1,233 @@
+/*******************************************************************************
+ *
+ * \file
+ * \brief Pre-analyses running concurrently on functions
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include <tbb/global_control.h>
+#include <tbb/parallel_for.h>
+
+#include <ikos/analyzer/analysis/pointer/constraint.hpp>
+#include <ikos/analyzer/analysis/pre_analysis.hpp>
+#include <ikos/analyzer/util/demangle.hpp>
+#include <ikos/analyzer/util/log.hpp>
+
+namespace ikos {
+namespace analyzer {
+
+PreAnalysis::PreAnalysis(Context& ctx,
+                         LivenessAnalysis* liveness,
+                         WideningHintAnalysis* widening_hint,
+                         FunctionPointerAnalysis* function_pointer,
+                         PointerAnalysis* pointer)
+    : _ctx(ctx),
+      _liveness(liveness),
+      _widening_hint(widening_hint),
+      _function_pointer(function_pointer),
+      _pointer(pointer) {
+  ikos_assert(pointer == nullptr || function_pointer != nullptr);
+}
+
+PreAnalysis::~PreAnalysis() = default;
+
+void PreAnalysis::run() {
+  ar::Bundle* bundle = _ctx.bundle;
+
+  std::vector< ar::GlobalVariable* > globals(bundle->global_begin(),
+                                             bundle->global_end());
+  std::vector< ar::Function* > functions(bundle->function_begin(),
+                                         bundle->function_end());
+  std::size_t num_definitions =
+      std::count_if(globals.begin(),
+                    globals.end(),
+                    [](ar::GlobalVariable* gv) {
+                      return gv->is_definition();
+                    }) +
+      std::count_if(functions.begin(), functions.end(), [](ar::Function* fun) {
+        return fun->is_definition();
+      });
+
+  // Setup a progress logger
+  std::size_t num_tasks = num_definitions;
+  if (this->_function_pointer != nullptr) {
+    num_tasks++;
+  }
+  if (this->_pointer != nullptr) {
+    num_tasks += num_definitions + 1;
+  }
+  std::unique_ptr< ProgressLogger > progress =
+      make_progress_logger(_ctx.opts.progress, LogLevel::Info, num_tasks);
+  ScopeLogger scope(*progress);
+
+  // Set the number of threads, for the duration of the analyses
+  std::unique_ptr< tbb::global_control > init;
+  if (_ctx.opts.num_threads > 0) {
+    init = std::make_unique< tbb::global_control >(
+        tbb::global_control::max_allowed_parallelism,
+        static_cast< std::size_t >(_ctx.opts.num_threads));
+  }
+
+  // Pointer constraints of each global variable and function
+  std::vector< PointerConstraintList > csts(globals.size() + functions.size());
+
+  // Add the pointer constraints to a system, in the order of the bundle
+  auto add_constraints = [&](PointerConstraints& constraints) {
+    for (PointerConstraintList& list : csts) {
+      constraints.add(list);
+    }
+  };
+
+  log::debug("Running liveness, widening hint and function pointer analyses");
+  tbb::parallel_for(std::size_t(0), csts.size(), [&](std::size_t i) {
+    if (i < globals.size()) {
+      this->run_first_stage(globals[i], csts[i], *progress);
+    } else {
+      this->run_first_stage(functions[i - globals.size()], csts[i], *progress);
+    }
+  });
+
+  if (this->_liveness != nullptr) {
+    _ctx.liveness = this->_liveness;
+  }
+
+  if (this->_function_pointer == nullptr) {
+    return;
+  }
+
+  log::debug("Solving function pointer constraints");
+  progress->start_task("Solving function pointer constraints");
+  {
+    PointerConstraints constraints(bundle->data_layout());
+    add_constraints(constraints);
+    this->_function_pointer->solve(constraints);
+  }
+  _ctx.function_pointer = this->_function_pointer;
+
+  if (this->_pointer == nullptr) {
+    return;
+  }
+
+  log::debug("Generating pointer constraints");
+  tbb::parallel_for(std::size_t(0), csts.size(), [&](std::size_t i) {
+    if (i < globals.size()) {
+      this->run_second_stage(globals[i], csts[i], *progress);
+    } else {
+      this->run_second_stage(functions[i - globals.size()], csts[i], *progress);
+    }
+  });
+
+  log::debug("Solving pointer constraints");
+  progress->start_task("Solving pointer constraints");
+  {
+    PointerConstraints constraints(bundle->data_layout());
+    add_constraints(constraints);
+    this->_pointer->solve(constraints);
+  }
+  _ctx.pointer = this->_pointer;
+}
+
+void PreAnalysis::run_first_stage(ar::GlobalVariable* gv,
+                                  PointerConstraintList& csts,
+                                  ProgressLogger& progress) {
+  if (gv->is_definition()) {
+    progress.start_task("Running pre-analyses on initializer of global "
+                        "variable '" +
+                        demangle(gv->name()) + "'");
+
+    if (this->_liveness != nullptr) {
+      this->_liveness->run(gv->initializer());
+    }
+  }
+
+  if (this->_function_pointer != nullptr) {
+    this->_function_pointer->generate(gv, csts);
+  }
+}
+
+void PreAnalysis::run_first_stage(ar::Function* fun,
+                                  PointerConstraintList& csts,
+                                  ProgressLogger& progress) {
+  if (fun->is_definition()) {
+    progress.start_task("Running pre-analyses on function '" +
+                        demangle(fun->name()) + "'");
+
+    if (this->_liveness != nullptr) {
+      this->_liveness->run(fun->body());
+    }
+    if (this->_widening_hint != nullptr) {
+      this->_widening_hint->run(fun);
+    }
+  }
+
+  if (this->_function_pointer != nullptr) {
+    this->_function_pointer->generate(fun, csts);
+  }
+}
+
+void PreAnalysis::run_second_stage(ar::GlobalVariable* gv,
+                                   PointerConstraintList& csts,
+                                   ProgressLogger& progress) {
+  if (gv->is_definition()) {
+    progress.start_task(
+        "Generating pointer constraints for initializer of global variable "
+        "'" +
+        demangle(gv->name()) + "'");
+  }
+
+  this->_pointer->generate(gv, csts);
+}
+
+void PreAnalysis::run_second_stage(ar::Function* fun,
+                                   PointerConstraintList& csts,
+                                   ProgressLogger& progress) {
+  if (fun->is_definition()) {
+    progress.start_task("Generating pointer constraints for function '" +
+                        demangle(fun->name()) + "'");
+  }
+
+  this->_pointer->generate(fun, csts);
+}
+
+} // end namespace analyzer
+} // end namespace ikos
@@ -47,6 +47,7 @@
 #include <ikos/core/domain/nullity/separate_domain.hpp>
 #include <ikos/core/domain/scalar/composite.hpp>
 #include <ikos/core/domain/uninitialized/separate_domain.hpp>
+#include <ikos/core/serialization/memory.hpp>
 
 #include <ikos/analyzer/analysis/value/abstract_domain.hpp>
 #include <ikos/analyzer/analysis/value/machine_int_domain.hpp>
@@ -44,21 +44,28 @@
  ******************************************************************************/
 
 #include <memory>
+#include <mutex>
 #include <vector>
 
+#include <llvm/ADT/SmallPtrSet.h>
+
 #include <ikos/analyzer/analysis/value/abstract_domain.hpp>
 #include <ikos/analyzer/analysis/value/global_variable.hpp>
 #include <ikos/analyzer/analysis/value/interprocedural/concurrent/analysis.hpp>
 #include <ikos/analyzer/analysis/value/interprocedural/concurrent/function_fixpoint.hpp>
 #include <ikos/analyzer/analysis/value/interprocedural/init_invariant.hpp>
 #include <ikos/analyzer/analysis/value/interprocedural/sequential/global_init_fixpoint.hpp>
+#include <ikos/analyzer/analysis/value/summary_cache.hpp>
 #include <ikos/analyzer/checker/checker.hpp>
+#include <ikos/analyzer/checker/dispatcher.hpp>
 #include <ikos/analyzer/util/demangle.hpp>
 #include <ikos/analyzer/util/log.hpp>
 #include <ikos/analyzer/util/progress.hpp>
 #include <ikos/analyzer/util/timer.hpp>
 
 #include <tbb/global_control.h>
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
 
 namespace ikos {
 namespace analyzer {
@@ -82,12 +89,24 @@ void Analysis::run() {
     }
   }
 
-  // Initialize the task scheduler
+  // Dispatch statements to the relevant checkers
+  CheckerDispatcher dispatcher(checkers);
+
+  // Set the number of threads, for the duration of the analysis
+  std::unique_ptr< tbb::global_control > init;
   if (_ctx.opts.num_threads > 0) {
-    tbb::global_control init(tbb::global_control::max_allowed_parallelism,
-                             static_cast< std::size_t >(_ctx.opts.num_threads));
+    init = std::make_unique< tbb::global_control >(
+        tbb::global_control::max_allowed_parallelism,
+        static_cast< std::size_t >(_ctx.opts.num_threads));
   }
 
+  // Function fixpoint cache of callees, shared by all the entry points
+  //
+  // Use a few shards per thread to reduce the contention on mutexes
+  FunctionFixpoint::FixpointCacheT callees_cache(
+      /* num_shards = */ 8 * tbb::global_control::active_value(
+                                 tbb::global_control::max_allowed_parallelism));
+
   // Initial invariant
   AbstractDomain init_inv = make_initial_abstract_value(_ctx);
 
@@ -147,7 +166,7 @@ void Analysis::run() {
       }
 
       // Create a function fixpoint
-      FunctionFixpoint fixpoint(_ctx, checkers, ctor);
+      FunctionFixpoint fixpoint(_ctx, dispatcher, callees_cache, ctor);
 
       {
         log::info("Analyzing global constructor '" + demangle(ctor->name()) +
@@ -157,7 +176,7 @@ void Analysis::run() {
         fixpoint.run(init_inv);
       }
 
-      if (!checkers.empty()) {
+      if (!dispatcher.empty()) {
         log::info("Checking properties for global constructor '" +
                   demangle(ctor->name()) + "'");
         ScopeTimerDatabase t(_ctx.output_db->times,
@@ -166,6 +185,7 @@ void Analysis::run() {
       }
 
       init_inv = fixpoint.exit_invariant();
+      callees_cache.erase_entry_point(ctor);
     }
 
     if (_ctx.opts.display_invariants == DisplayOption::All) {
@@ -176,7 +196,9 @@ void Analysis::run() {
     }
   }
 
-  // Analyze each entry point
+  // Collect the entry points
+  std::vector< ar::Function* > entry_points;
+  llvm::SmallPtrSet< ar::Function*, 4 > seen;
   for (ar::Function* entry_point : _ctx.opts.entry_points) {
     if (!entry_point->is_definition()) {
       log::error("missing implementation of function '" + entry_point->name() +
@@ -184,41 +206,69 @@ void Analysis::run() {
       continue;
     }
 
-    // Entry point initial invariant
-    AbstractDomain entry_inv = make_bottom_abstract_value(_ctx);
-
-    if (std::find(_ctx.opts.no_init_globals.begin(),
-                  _ctx.opts.no_init_globals.end(),
-                  entry_point) == _ctx.opts.no_init_globals.end()) {
-      // Use invariant with initialized global variables
-      entry_inv = init_inv;
-    } else {
-      // Default invariant
-      entry_inv = make_initial_abstract_value(_ctx);
+    // The fixpoint cache is indexed by calling context, which would be the
+    // same for two analyses of the same entry point.
+    if (seen.insert(entry_point).second) {
+      entry_points.push_back(entry_point);
     }
+  }
 
-    if (entry_point->name() == "main" && entry_point->num_parameters() >= 2) {
-      entry_inv = init_main_invariant(_ctx, entry_point, entry_inv);
-    }
-
-    // Create a function fixpoint
-    FunctionFixpoint fixpoint(_ctx, checkers, entry_point);
-
-    {
-      log::info("Analyzing entry point '" + demangle(entry_point->name()) +
-                "'");
-      ScopeTimerDatabase t(_ctx.output_db->times,
-                           "ikos-analyzer.value." + entry_point->name());
-      fixpoint.run(entry_inv);
-    }
+  // Persistent cache of results, or null
+  std::unique_ptr< SummaryCache > summary_cache;
+  if (_ctx.opts.summary_cache) {
+    summary_cache =
+        std::make_unique< SummaryCache >(_ctx, *_ctx.opts.summary_cache);
+  }
 
-    if (!checkers.empty()) {
-      log::info("Checking properties for entry point '" +
-                demangle(entry_point->name()) + "'");
-      ScopeTimerDatabase t(_ctx.output_db->times,
-                           "ikos-analyzer.check." + entry_point->name());
-      fixpoint.run_checks();
+  if (entry_points.size() == 1) {
+    if (summary_cache) {
+      ChecksTable::Buffer buffer;
+      this->analyze_entry_point(entry_points[0],
+                                init_inv,
+                                dispatcher,
+                                callees_cache,
+                                summary_cache.get(),
+                                &buffer);
+      _ctx.output_db->checks.insert(buffer);
+    } else {
+      this->analyze_entry_point(entry_points[0],
+                                init_inv,
+                                dispatcher,
+                                callees_cache,
+                                /* summary_cache = */ nullptr,
+                                /* buffer = */ nullptr);
     }
+  } else {
+    // Analyze the entry points in parallel
+    //
+    // Checks are buffered and inserted in the database in the order of the
+    // entry points, as soon as all the previous entry points are done.
+    std::vector< ChecksTable::Buffer > buffers(entry_points.size());
+    std::vector< bool > done(entry_points.size(), false);
+    std::size_t next = 0;
+    std::mutex mutex;
+
+    tbb::parallel_for(std::size_t(0),
+                      entry_points.size(),
+                      [&](std::size_t i) {
+                        // Do not execute tasks of other entry points while
+                        // waiting, since checks are buffered per thread
+                        tbb::this_task_arena::isolate([&] {
+                          this->analyze_entry_point(entry_points[i],
+                                                    init_inv,
+                                                    dispatcher,
+                                                    callees_cache,
+                                                    summary_cache.get(),
+                                                    &buffers[i]);
+                        });
+
+                        std::lock_guard< std::mutex > lock(mutex);
+                        done[i] = true;
+                        for (; next < entry_points.size() && done[next];
+                             ++next) {
+                          _ctx.output_db->checks.insert(buffers[next]);
+                        }
+                      });
   }
 
   // Call global destructors
@@ -238,7 +288,7 @@ void Analysis::run() {
       }
 
       // Create a function fixpoint
-      FunctionFixpoint fixpoint(_ctx, checkers, dtor);
+      FunctionFixpoint fixpoint(_ctx, dispatcher, callees_cache, dtor);
 
       {
         log::info("Analyzing global destructor '" + demangle(dtor->name()) +
@@ -249,7 +299,7 @@ void Analysis::run() {
         fixpoint.run(init_inv);
       }
 
-      if (!checkers.empty()) {
+      if (!dispatcher.empty()) {
         log::info("Checking properties for global destructor: '" +
                   demangle(dtor->name()) + "'");
         ScopeTimerDatabase t(_ctx.output_db->times,
@@ -258,9 +308,55 @@ void Analysis::run() {
       }
 
       init_inv = fixpoint.exit_invariant();
+      callees_cache.erase_entry_point(dtor);
     }
   }
 
+  // Check the callees in merged calling contexts, once all their call strings
+  // are analyzed
+  if (!dispatcher.empty()) {
+    std::vector< FunctionFixpoint::FixpointCacheT::MergedCallee > callees =
+        callees_cache.take_increased_merged();
+
+    if (!callees.empty()) {
+      log::info("Checking properties for functions in merged calling "
+                "contexts");
+    }
+
+    // Analyzing a callee outside of its call strings might analyze its own
+    // callees from a greater entry invariant: iterate until the entry
+    // invariants are stable, so that each callee is only checked once
+    for (; !callees.empty(); callees = callees_cache.take_increased_merged()) {
+      for (auto& callee : callees) {
+        FunctionFixpoint fixpoint(_ctx,
+                                  dispatcher,
+                                  callees_cache,
+                                  callee.callee,
+                                  callee.context);
+        fixpoint.run(std::move(callee.entry));
+      }
+    }
+
+    for (auto& callee : callees_cache.merged_callees()) {
+      log::debug("Checking properties for function '" +
+                 demangle(callee.callee->name()) + "'");
+      FunctionFixpoint fixpoint(_ctx,
+                                dispatcher,
+                                callees_cache,
+                                callee.callee,
+                                callee.context);
+      fixpoint.run(std::move(callee.entry));
+      fixpoint.run_checks();
+    }
+  }
+
+  if (log::is_enabled_for(LogLevel::Debug)) {
+    auto stats = callees_cache.statistics();
+    log::debug("Fixpoint cache: " + std::to_string(stats.num_accesses) +
+               " accesses, " + std::to_string(stats.num_contentions) +
+               " contended");
+  }
+
   // Insert all functions in the database
   for (auto it = bundle->function_begin(), et = bundle->function_end();
        it != et;
@@ -269,6 +365,76 @@ void Analysis::run() {
   }
 }
 
+void Analysis::analyze_entry_point(
+    ar::Function* entry_point,
+    const AbstractDomain& init_inv,
+    const CheckerDispatcher& dispatcher,
+    FunctionFixpoint::FixpointCacheT& callees_cache,
+    SummaryCache* summary_cache,
+    ChecksTable::Buffer* buffer) {
+  // Try to reuse the results of a previous run
+  std::string key;
+  if (summary_cache != nullptr) {
+    key = summary_cache->entry_point_key(entry_point);
+    if (summary_cache->load(key, *buffer)) {
+      log::info("Reusing cached results for entry point '" +
+                demangle(entry_point->name()) + "'");
+      return;
+    }
+  }
+
+  // Redirect the checks into the buffer, if any
+  std::unique_ptr< ChecksTable::ScopeBuffer > scope;
+  if (buffer != nullptr) {
+    scope = std::make_unique< ChecksTable::ScopeBuffer >(*buffer);
+  }
+
+  // Entry point initial invariant
+  AbstractDomain entry_inv = make_bottom_abstract_value(_ctx);
+
+  if (std::find(_ctx.opts.no_init_globals.begin(),
+                _ctx.opts.no_init_globals.end(),
+                entry_point) == _ctx.opts.no_init_globals.end()) {
+    // Use invariant with initialized global variables
+    entry_inv = init_inv;
+  } else {
+    // Default invariant
+    entry_inv = make_initial_abstract_value(_ctx);
+  }
+
+  if (entry_point->name() == "main" && entry_point->num_parameters() >= 2) {
+    entry_inv = init_main_invariant(_ctx, entry_point, entry_inv);
+  }
+
+  {
+    // Create a function fixpoint
+    FunctionFixpoint fixpoint(_ctx, dispatcher, callees_cache, entry_point);
+
+    {
+      log::info("Analyzing entry point '" + demangle(entry_point->name()) +
+                "'");
+      ScopeTimerDatabase t(_ctx.output_db->times,
+                           "ikos-analyzer.value." + entry_point->name());
+      fixpoint.run(entry_inv);
+    }
+
+    if (!dispatcher.empty()) {
+      log::info("Checking properties for entry point '" +
+                demangle(entry_point->name()) + "'");
+      ScopeTimerDatabase t(_ctx.output_db->times,
+                           "ikos-analyzer.check." + entry_point->name());
+      fixpoint.run_checks();
+    }
+  }
+
+  // Release the fixpoints on the callees
+  callees_cache.erase_entry_point(entry_point);
+
+  if (summary_cache != nullptr) {
+    summary_cache->store(key, *buffer);
+  }
+}
+
 } // end namespace concurrent
 } // end namespace interprocedural
 } // end namespace value
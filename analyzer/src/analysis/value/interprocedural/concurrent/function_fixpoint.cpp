@@ -43,10 +43,21 @@
  *
  ******************************************************************************/
 
+#include <string>
+#include <vector>
+
+#include <tbb/global_control.h>
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
+
+#include <ikos/core/serialization/memory.hpp>
+
 #include <ikos/analyzer/analysis/execution_engine/concurrent_inliner.hpp>
 #include <ikos/analyzer/analysis/execution_engine/numerical.hpp>
 #include <ikos/analyzer/analysis/pointer/pointer.hpp>
 #include <ikos/analyzer/analysis/value/interprocedural/concurrent/function_fixpoint.hpp>
+#include <ikos/analyzer/analysis/value/spill.hpp>
+#include <ikos/analyzer/database/output.hpp>
 
 namespace ikos {
 namespace analyzer {
@@ -65,18 +76,36 @@ using ConcurrentInlineCallExecutionEngineT =
 
 } // end anonymous namespace
 
-FunctionFixpoint::FunctionFixpoint(
-    Context& ctx,
-    const std::vector< std::unique_ptr< Checker > >& checkers,
-    ar::Function* entry_point)
+FunctionFixpoint::FunctionFixpoint(Context& ctx,
+                                   const CheckerDispatcher& dispatcher,
+                                   FixpointCacheT& callees_cache,
+                                   ar::Function* entry_point)
     : FwdFixpointIterator(entry_point->body(), make_bottom_abstract_value(ctx)),
       _ctx(ctx),
       _function(entry_point),
       _call_context(ctx.call_context_factory->get_empty()),
+      _caller(nullptr),
       _fixpoint_parameters(ctx.fixpoint_parameters->get(entry_point)),
-      _checkers(checkers),
+      _dispatcher(dispatcher),
       _exit_invariant(make_bottom_abstract_value(ctx)),
-      _return_stmt(nullptr) {}
+      _return_stmt(nullptr),
+      _callees_cache(callees_cache) {}
+
+FunctionFixpoint::FunctionFixpoint(Context& ctx,
+                                   const CheckerDispatcher& dispatcher,
+                                   FixpointCacheT& callees_cache,
+                                   ar::Function* callee,
+                                   CallContext* call_context)
+    : FwdFixpointIterator(callee->body(), make_bottom_abstract_value(ctx)),
+      _ctx(ctx),
+      _function(callee),
+      _call_context(call_context),
+      _caller(nullptr),
+      _fixpoint_parameters(ctx.fixpoint_parameters->get(callee)),
+      _dispatcher(dispatcher),
+      _exit_invariant(make_bottom_abstract_value(ctx)),
+      _return_stmt(nullptr),
+      _callees_cache(callees_cache) {}
 
 FunctionFixpoint::FunctionFixpoint(Context& ctx,
                                    const FunctionFixpoint& caller,
@@ -87,10 +116,26 @@ FunctionFixpoint::FunctionFixpoint(Context& ctx,
       _function(callee),
       _call_context(
           ctx.call_context_factory->get_context(caller._call_context, call)),
+      _caller(&caller),
       _fixpoint_parameters(ctx.fixpoint_parameters->get(callee)),
-      _checkers(caller._checkers),
+      _dispatcher(caller._dispatcher),
       _exit_invariant(make_bottom_abstract_value(ctx)),
-      _return_stmt(nullptr) {}
+      _return_stmt(nullptr),
+      _callees_cache(caller._callees_cache) {}
+
+FunctionFixpoint::~FunctionFixpoint() {
+  remove_spill_file(this->_spill_file);
+}
+
+bool FunctionFixpoint::in_call_stack(ar::Function* fun) const {
+  for (const FunctionFixpoint* fixpoint = this; fixpoint != nullptr;
+       fixpoint = fixpoint->_caller) {
+    if (fixpoint->_function == fun) {
+      return true;
+    }
+  }
+  return false;
+}
 
 void FunctionFixpoint::run(AbstractDomain inv) {
   FwdFixpointIterator::run(std::move(inv));
@@ -237,41 +282,120 @@ void FunctionFixpoint::process_post(ar::BasicBlock* bb,
 }
 
 void FunctionFixpoint::run_checks() {
-  for (ar::BasicBlock* bb : *this->cfg()) {
-    NumericalExecutionEngineT
-        exec_engine(this->pre(bb),
-                    this->_ctx,
-                    this->_call_context,
-                    ExecutionEngine::UpdateAllocSizeVar,
-                    /* liveness = */ this->_ctx.liveness,
-                    /* pointer_info = */ this->_ctx.pointer == nullptr
-                        ? nullptr
-                        : &this->_ctx.pointer->results());
-    ConcurrentInlineCallExecutionEngineT call_exec_engine(this->_ctx,
-                                                          exec_engine,
-                                                          *this,
-                                                          this->_callees_cache);
+  std::vector< ar::BasicBlock* > blocks(this->cfg()->begin(),
+                                        this->cfg()->end());
 
-    // Check called functions during the transfer function
-    call_exec_engine.mark_check_callees();
+  if (blocks.size() <= 1 ||
+      tbb::global_control::active_value(
+          tbb::global_control::max_allowed_parallelism) <= 1) {
+    for (ar::BasicBlock* bb : blocks) {
+      this->run_checks(bb);
+    }
+    return;
+  }
 
-    exec_engine.exec_enter(bb);
+  // Check the basic blocks in parallel, see intraprocedural::concurrent
+  //
+  // Checks on the callees end up in the buffer of the calling basic block.
+  std::vector< ChecksTable::Buffer > buffers(blocks.size());
 
-    for (ar::Statement* stmt : *bb) {
-      // Check the statement if it's related to an llvm instruction
-      if (stmt->has_frontend()) {
-        exec_engine.inv().normalize();
-        for (const auto& checker : this->_checkers) {
-          checker->check(stmt, exec_engine.inv(), this->_call_context);
-        }
-      }
+  // Do not execute unrelated tasks while waiting
+  tbb::this_task_arena::isolate([&] {
+    tbb::parallel_for(std::size_t(0), blocks.size(), [&](std::size_t i) {
+      ChecksTable::ScopeBuffer scope(buffers[i]);
+      this->run_checks(blocks[i]);
+    });
+  });
+
+  for (ChecksTable::Buffer& buffer : buffers) {
+    this->_ctx.output_db->checks.merge(buffer);
+  }
+}
 
-      // Propagate
-      transfer_function(exec_engine, call_exec_engine, stmt);
+void FunctionFixpoint::run_checks(ar::BasicBlock* bb) {
+  NumericalExecutionEngineT
+      exec_engine(this->pre(bb),
+                  this->_ctx,
+                  this->_call_context,
+                  ExecutionEngine::UpdateAllocSizeVar,
+                  /* liveness = */ this->_ctx.liveness,
+                  /* pointer_info = */ this->_ctx.pointer == nullptr
+                      ? nullptr
+                      : &this->_ctx.pointer->results());
+  ConcurrentInlineCallExecutionEngineT call_exec_engine(this->_ctx,
+                                                        exec_engine,
+                                                        *this,
+                                                        this->_callees_cache);
+
+  // Check called functions during the transfer function
+  call_exec_engine.mark_check_callees();
+
+  exec_engine.exec_enter(bb);
+
+  for (ar::Statement* stmt : *bb) {
+    // Check the statement if it's related to an llvm instruction
+    if (stmt->has_frontend()) {
+      this->_dispatcher.check(stmt, exec_engine.inv(), this->_call_context);
+    }
+
+    // Propagate
+    transfer_function(exec_engine, call_exec_engine, stmt);
+  }
+
+  exec_engine.exec_leave(bb);
+}
+
+bool FunctionFixpoint::spill() {
+  ikos_assert(this->_spill_file.empty());
+
+  core::serialization::Encoder e;
+  e.write_header();
+  try {
+    // Pre invariants, in the order of the basic blocks
+    for (ar::BasicBlock* bb : *this->cfg()) {
+      const AbstractDomain& pre = this->pre(bb);
+      e.write_bool(!pre.is_bottom());
+      if (!pre.is_bottom()) {
+        core::serialization::Serializer< AbstractDomain >::write(e, pre);
+      }
     }
+    core::serialization::Serializer< AbstractDomain >::write(
+        e, this->_exit_invariant);
+  } catch (const core::serialization::SerializationError&) {
+    // Unsupported abstract domain, e.g. the partitioning domain
+    return false;
+  }
+  boost::filesystem::path path = write_spill_file(e.release());
+  if (path.empty()) {
+    return false;
+  }
 
-    exec_engine.exec_leave(bb);
+  this->_spill_file = std::move(path);
+  this->clear_pre();
+  this->clear_post();
+  this->_exit_invariant.set_to_bottom();
+  return true;
+}
+
+void FunctionFixpoint::restore() {
+  if (this->_spill_file.empty()) {
+    return;
+  }
+
+  std::string bytes = read_spill_file(this->_spill_file);
+  this->_spill_file.clear();
+
+  SpillResolver resolve(this->_ctx);
+  core::serialization::Decoder d(bytes);
+  d.read_header();
+  for (ar::BasicBlock* bb : *this->cfg()) {
+    if (d.read_bool()) {
+      this->set_pre(bb,
+                    core::serialization::read_like(d, resolve, this->bottom()));
+    }
   }
+  this->_exit_invariant =
+      core::serialization::read_like(d, resolve, this->bottom());
 }
 
 } // end namespace concurrent
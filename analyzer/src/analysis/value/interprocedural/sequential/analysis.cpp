@@ -51,7 +51,9 @@
 #include <ikos/analyzer/analysis/value/interprocedural/sequential/function_fixpoint.hpp>
 #include <ikos/analyzer/analysis/value/interprocedural/sequential/global_init_fixpoint.hpp>
 #include <ikos/analyzer/analysis/value/interprocedural/sequential/progress.hpp>
+#include <ikos/analyzer/analysis/value/summary_cache.hpp>
 #include <ikos/analyzer/checker/checker.hpp>
+#include <ikos/analyzer/checker/dispatcher.hpp>
 #include <ikos/analyzer/util/demangle.hpp>
 #include <ikos/analyzer/util/log.hpp>
 #include <ikos/analyzer/util/progress.hpp>
@@ -79,6 +81,13 @@ void Analysis::run() {
     }
   }
 
+  // Dispatch statements to the relevant checkers
+  CheckerDispatcher dispatcher(checkers);
+
+  // Results of the callees in merged calling contexts, shared by all the
+  // entry points
+  FunctionFixpoint::FixpointCacheT merged_cache;
+
   // Initial invariant
   AbstractDomain init_inv = make_initial_abstract_value(_ctx);
 
@@ -143,7 +152,12 @@ void Analysis::run() {
       ScopeLogger scope(*logger);
 
       // Create a function fixpoint
-      FunctionFixpoint fixpoint(_ctx, checkers, *logger, ctor);
+      FunctionFixpoint fixpoint(_ctx,
+                                dispatcher,
+                                *logger,
+                                merged_cache,
+                                /* summary_cache = */ nullptr,
+                                ctor);
 
       {
         log::info("Analyzing global constructor '" + demangle(ctor->name()) +
@@ -153,7 +167,7 @@ void Analysis::run() {
         fixpoint.run(init_inv);
       }
 
-      if (!checkers.empty()) {
+      if (!dispatcher.empty()) {
         log::info("Checking properties for global constructor '" +
                   demangle(ctor->name()) + "'");
         ScopeTimerDatabase t(_ctx.output_db->times,
@@ -172,6 +186,13 @@ void Analysis::run() {
     }
   }
 
+  // Persistent cache of results, or null
+  std::unique_ptr< SummaryCache > summary_cache;
+  if (_ctx.opts.summary_cache) {
+    summary_cache =
+        std::make_unique< SummaryCache >(_ctx, *_ctx.opts.summary_cache);
+  }
+
   // Analyze each entry point
   for (ar::Function* entry_point : _ctx.opts.entry_points) {
     if (!entry_point->is_definition()) {
@@ -180,6 +201,21 @@ void Analysis::run() {
       continue;
     }
 
+    // Try to reuse the results of a previous run
+    std::string key;
+    ChecksTable::Buffer buffer;
+    std::unique_ptr< ChecksTable::ScopeBuffer > scope_buffer;
+    if (summary_cache) {
+      key = summary_cache->entry_point_key(entry_point);
+      if (summary_cache->load(key, buffer)) {
+        log::info("Reusing cached results for entry point '" +
+                  demangle(entry_point->name()) + "'");
+        _ctx.output_db->checks.insert(buffer);
+        continue;
+      }
+      scope_buffer = std::make_unique< ChecksTable::ScopeBuffer >(buffer);
+    }
+
     // Entry point initial invariant
     AbstractDomain entry_inv = make_bottom_abstract_value(_ctx);
 
@@ -203,7 +239,12 @@ void Analysis::run() {
     ScopeLogger scope(*logger);
 
     // Create a function fixpoint
-    FunctionFixpoint fixpoint(_ctx, checkers, *logger, entry_point);
+    FunctionFixpoint fixpoint(_ctx,
+                              dispatcher,
+                              *logger,
+                              merged_cache,
+                              summary_cache.get(),
+                              entry_point);
 
     {
       log::info("Analyzing entry point '" + demangle(entry_point->name()) +
@@ -213,13 +254,19 @@ void Analysis::run() {
       fixpoint.run(entry_inv);
     }
 
-    if (!checkers.empty()) {
+    if (!dispatcher.empty()) {
       log::info("Checking properties for entry point '" +
                 demangle(entry_point->name()) + "'");
       ScopeTimerDatabase t(_ctx.output_db->times,
                            "ikos-analyzer.check." + entry_point->name());
       fixpoint.run_checks();
     }
+
+    if (summary_cache) {
+      scope_buffer.reset();
+      summary_cache->store(key, buffer);
+      _ctx.output_db->checks.insert(buffer);
+    }
   }
 
   // Call global destructors
@@ -244,7 +291,12 @@ void Analysis::run() {
       ScopeLogger scope(*logger);
 
       // Create a function fixpoint
-      FunctionFixpoint fixpoint(_ctx, checkers, *logger, dtor);
+      FunctionFixpoint fixpoint(_ctx,
+                                dispatcher,
+                                *logger,
+                                merged_cache,
+                                /* summary_cache = */ nullptr,
+                                dtor);
 
       {
         log::info("Analyzing global destructor '" + demangle(dtor->name()) +
@@ -255,7 +307,7 @@ void Analysis::run() {
         fixpoint.run(init_inv);
       }
 
-      if (!checkers.empty()) {
+      if (!dispatcher.empty()) {
         log::info("Checking properties for global destructor: '" +
                   demangle(dtor->name()) + "'");
         ScopeTimerDatabase t(_ctx.output_db->times,
@@ -267,6 +319,51 @@ void Analysis::run() {
     }
   }
 
+  // Check the callees in merged calling contexts, once all their call strings
+  // are analyzed
+  if (!dispatcher.empty()) {
+    std::vector< FunctionFixpoint::FixpointCacheT::MergedCallee > callees =
+        merged_cache.take_increased_merged();
+
+    if (!callees.empty()) {
+      log::info("Checking properties for functions in merged calling "
+                "contexts");
+    }
+
+    // Setup a progress logger
+    std::unique_ptr< sequential::ProgressLogger > logger =
+        make_progress_logger(_ctx, _ctx.opts.progress, LogLevel::Info);
+    ScopeLogger scope(*logger);
+
+    // Analyzing a callee outside of its call strings might analyze its own
+    // callees from a greater entry invariant: iterate until the entry
+    // invariants are stable, so that each callee is only checked once
+    for (; !callees.empty(); callees = merged_cache.take_increased_merged()) {
+      for (auto& callee : callees) {
+        FunctionFixpoint fixpoint(_ctx,
+                                  dispatcher,
+                                  *logger,
+                                  merged_cache,
+                                  callee.callee,
+                                  callee.context);
+        fixpoint.run(std::move(callee.entry));
+      }
+    }
+
+    for (auto& callee : merged_cache.merged_callees()) {
+      log::debug("Checking properties for function '" +
+                 demangle(callee.callee->name()) + "'");
+      FunctionFixpoint fixpoint(_ctx,
+                                dispatcher,
+                                *logger,
+                                merged_cache,
+                                callee.callee,
+                                callee.context);
+      fixpoint.run(std::move(callee.entry));
+      fixpoint.run_checks();
+    }
+  }
+
   // Insert all functions in the database
   for (auto it = bundle->function_begin(), et = bundle->function_end();
        it != et;
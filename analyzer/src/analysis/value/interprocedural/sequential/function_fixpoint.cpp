@@ -41,10 +41,19 @@
  *
  ******************************************************************************/
 
+#include <string>
+
+#include <ikos/core/serialization/memory.hpp>
+
 #include <ikos/analyzer/analysis/execution_engine/inliner.hpp>
 #include <ikos/analyzer/analysis/execution_engine/numerical.hpp>
+#include <ikos/analyzer/analysis/memory_location.hpp>
 #include <ikos/analyzer/analysis/pointer/pointer.hpp>
 #include <ikos/analyzer/analysis/value/interprocedural/sequential/function_fixpoint.hpp>
+#include <ikos/analyzer/analysis/value/spill.hpp>
+#include <ikos/analyzer/analysis/variable.hpp>
+#include <ikos/analyzer/exception.hpp>
+#include <ikos/analyzer/support/cast.hpp>
 #include <ikos/ar/format/text.hpp>
 
 namespace ikos {
@@ -64,19 +73,23 @@ using InlineCallExecutionEngineT =
 
 } // end anonymous namespace
 
-FunctionFixpoint::FunctionFixpoint(
-    Context& ctx,
-    const std::vector< std::unique_ptr< Checker > >& checkers,
-    ProgressLogger& logger,
-    ar::Function* entry_point)
+FunctionFixpoint::FunctionFixpoint(Context& ctx,
+                                   const CheckerDispatcher& dispatcher,
+                                   ProgressLogger& logger,
+                                   FixpointCacheT& merged_cache,
+                                   SummaryCache* summary_cache,
+                                   ar::Function* entry_point)
     : FwdFixpointIterator(entry_point->body(), make_bottom_abstract_value(ctx)),
       _ctx(ctx),
       _function(entry_point),
       _call_context(ctx.call_context_factory->get_empty()),
+      _caller(nullptr),
       _fixpoint_parameters(ctx.fixpoint_parameters->get(entry_point)),
-      _checkers(checkers),
+      _dispatcher(dispatcher),
       _exit_invariant(make_bottom_abstract_value(ctx)),
       _return_stmt(nullptr),
+      _summary_cache(summary_cache),
+      _merged_cache(merged_cache),
       _logger(logger),
       _namer() {
   if (_ctx.opts.trace_ar_statements) {
@@ -90,6 +103,37 @@ FunctionFixpoint::FunctionFixpoint(
   }
 }
 
+FunctionFixpoint::FunctionFixpoint(Context& ctx,
+                                   const CheckerDispatcher& dispatcher,
+                                   ProgressLogger& logger,
+                                   FixpointCacheT& merged_cache,
+                                   ar::Function* callee,
+                                   CallContext* call_context)
+    : FwdFixpointIterator(callee->body(), make_bottom_abstract_value(ctx)),
+      _ctx(ctx),
+      _function(callee),
+      _call_context(call_context),
+      _caller(nullptr),
+      _fixpoint_parameters(ctx.fixpoint_parameters->get(callee)),
+      _dispatcher(dispatcher),
+      _exit_invariant(make_bottom_abstract_value(ctx)),
+      _return_stmt(nullptr),
+      _summary_cache(nullptr),
+      _merged_cache(merged_cache),
+      _logger(logger),
+      _namer() {
+  if (_ctx.opts.trace_ar_statements) {
+    this->_namer = std::make_unique< ar::Namer >(callee->body());
+    auto msg = analyzer::log::msg();
+    auto& stream = msg.stream();
+    msg << "\n>>>>>>>>>>>>>>\nEntering Interprocedural Sequential "
+           "FunctionFixpoint for ";
+    ar::TextFormatter().format_header(stream, _function, *_namer);
+    msg << "\n  in a merged calling context";
+    stream << std::endl;
+  }
+}
+
 FunctionFixpoint::FunctionFixpoint(Context& ctx,
                                    const FunctionFixpoint& caller,
                                    ar::CallBase* call,
@@ -99,10 +143,13 @@ FunctionFixpoint::FunctionFixpoint(Context& ctx,
       _function(callee),
       _call_context(
           ctx.call_context_factory->get_context(caller._call_context, call)),
+      _caller(&caller),
       _fixpoint_parameters(ctx.fixpoint_parameters->get(callee)),
-      _checkers(caller._checkers),
+      _dispatcher(caller._dispatcher),
       _exit_invariant(make_bottom_abstract_value(ctx)),
       _return_stmt(nullptr),
+      _summary_cache(caller._summary_cache),
+      _merged_cache(caller._merged_cache),
       _logger(caller._logger),
       _namer() {
   if (_ctx.opts.trace_ar_statements) {
@@ -122,6 +169,7 @@ FunctionFixpoint::FunctionFixpoint(Context& ctx,
 }
 
 FunctionFixpoint::~FunctionFixpoint() {
+  remove_spill_file(this->_spill_file);
   if (_ctx.opts.trace_ar_statements) {
     auto msg = analyzer::log::msg();
     auto& stream = msg.stream();
@@ -148,6 +196,16 @@ void FunctionFixpoint::run(AbstractDomain inv) {
   }
 }
 
+bool FunctionFixpoint::in_call_stack(ar::Function* fun) const {
+  for (const FunctionFixpoint* fixpoint = this; fixpoint != nullptr;
+       fixpoint = fixpoint->_caller) {
+    if (fixpoint->_function == fun) {
+      return true;
+    }
+  }
+  return false;
+}
+
 AbstractDomain FunctionFixpoint::extrapolate(ar::BasicBlock* head,
                                              unsigned iteration,
                                              const AbstractDomain& before,
@@ -377,10 +435,7 @@ void FunctionFixpoint::run_checks() {
 
       // Check the statement if it's related to an llvm instruction
       if (stmt->has_frontend()) {
-        exec_engine.inv().normalize();
-        for (const auto& checker : this->_checkers) {
-          checker->check(stmt, exec_engine.inv(), this->_call_context);
-        }
+        this->_dispatcher.check(stmt, exec_engine.inv(), this->_call_context);
       }
 
       // Propagate
@@ -403,6 +458,90 @@ void FunctionFixpoint::run_checks() {
   }
 }
 
+bool FunctionFixpoint::spill() {
+  ikos_assert(this->_spill_file.empty());
+
+  core::serialization::Encoder e;
+  e.write_header();
+  try {
+    // Pre invariants, in the order of the basic blocks
+    for (ar::BasicBlock* bb : *this->cfg()) {
+      const AbstractDomain& pre = this->pre(bb);
+      e.write_bool(!pre.is_bottom());
+      if (!pre.is_bottom()) {
+        core::serialization::Serializer< AbstractDomain >::write(e, pre);
+      }
+    }
+    core::serialization::Serializer< AbstractDomain >::write(
+        e, this->_exit_invariant);
+  } catch (const core::serialization::SerializationError&) {
+    // Unsupported abstract domain, e.g. the partitioning domain
+    return false;
+  }
+  boost::filesystem::path path = write_spill_file(e.release());
+  if (path.empty()) {
+    return false;
+  }
+
+  this->_spill_file = std::move(path);
+  this->clear_pre();
+  this->_exit_invariant.set_to_bottom();
+  return true;
+}
+
+void FunctionFixpoint::restore() {
+  if (this->_spill_file.empty()) {
+    return;
+  }
+
+  std::string bytes = read_spill_file(this->_spill_file);
+  this->_spill_file.clear();
+
+  SpillResolver resolve(this->_ctx);
+  core::serialization::Decoder d(bytes);
+  d.read_header();
+  for (ar::BasicBlock* bb : *this->cfg()) {
+    if (d.read_bool()) {
+      this->set_pre(bb,
+                    core::serialization::read_like(d, resolve, this->bottom()));
+    }
+  }
+  this->_exit_invariant =
+      core::serialization::read_like(d, resolve, this->bottom());
+}
+
+std::vector< AbstractDomain > FunctionFixpoint::invariants() const {
+  std::vector< AbstractDomain > invariants;
+  for (ar::BasicBlock* bb : *this->cfg()) {
+    invariants.push_back(this->pre(bb));
+  }
+  invariants.push_back(this->_exit_invariant);
+  return invariants;
+}
+
+void FunctionFixpoint::set_invariants(
+    std::vector< AbstractDomain > invariants) {
+  auto it = invariants.begin();
+  for (ar::BasicBlock* bb : *this->cfg()) {
+    ikos_assert(it != invariants.end());
+    if (!it->is_bottom()) {
+      this->set_pre(bb, std::move(*it));
+    }
+    ++it;
+  }
+  ikos_assert(it != invariants.end());
+  this->_exit_invariant = std::move(*it);
+
+  // The return statement is set when analyzing the function
+  for (ar::BasicBlock* bb : *this->cfg()) {
+    for (ar::Statement* stmt : *bb) {
+      if (auto ret = dyn_cast< ar::ReturnValue >(stmt)) {
+        this->set_return_stmt(ret);
+      }
+    }
+  }
+}
+
 } // end namespace sequential
 } // end namespace interprocedural
 } // end namespace value
@@ -0,0 +1,197 @@
+/*******************************************************************************
+ *
+ * \file
+ * \brief Summary-based interprocedural value analysis
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include <tbb/global_control.h>
+#include <tbb/parallel_for_each.h>
+
+#include <ikos/analyzer/analysis/call_graph.hpp>
+#include <ikos/analyzer/analysis/value/abstract_domain.hpp>
+#include <ikos/analyzer/analysis/value/interprocedural/summary/analysis.hpp>
+#include <ikos/analyzer/analysis/value/interprocedural/summary/function_fixpoint.hpp>
+#include <ikos/analyzer/checker/checker.hpp>
+#include <ikos/analyzer/checker/dispatcher.hpp>
+#include <ikos/analyzer/util/demangle.hpp>
+#include <ikos/analyzer/util/log.hpp>
+#include <ikos/analyzer/util/progress.hpp>
+#include <ikos/analyzer/util/timer.hpp>
+
+namespace ikos {
+namespace analyzer {
+namespace value {
+namespace interprocedural {
+namespace summary {
+
+Analysis::Analysis(Context& ctx) : _ctx(ctx) {}
+
+Analysis::~Analysis() = default;
+
+void Analysis::run() {
+  // Bundle
+  ar::Bundle* bundle = _ctx.bundle;
+
+  // Create checkers
+  std::vector< std::unique_ptr< Checker > > checkers;
+  if (_ctx.opts.use_checks) {
+    for (CheckerName name : _ctx.opts.analyses) {
+      checkers.emplace_back(make_checker(_ctx, name));
+    }
+  }
+
+  // Dispatch statements to the relevant checkers
+  CheckerDispatcher dispatcher(checkers);
+
+  // Insert all functions in the database
+  for (auto it = bundle->function_begin(), et = bundle->function_end();
+       it != et;
+       ++it) {
+    _ctx.output_db->functions.insert(*it);
+  }
+
+  // Build the call graph
+  log::debug("Computing the call graph");
+  CallGraph call_graph(_ctx);
+  log::debug("Call graph: " + std::to_string(call_graph.num_functions()) +
+             " functions, " + std::to_string(call_graph.num_sccs()) +
+             " strongly connected components");
+
+  // Summaries of the analyzed functions
+  SummaryTable summaries(call_graph);
+
+  // Initial invariant
+  AbstractDomain init_inv = make_initial_abstract_value(_ctx);
+
+  // Setup a progress logger
+  std::unique_ptr< ProgressLogger > progress =
+      make_progress_logger(_ctx.opts.progress,
+                           LogLevel::Info,
+                           /* num_tasks = */ 2 * call_graph.num_functions());
+  ScopeLogger scope(*progress);
+
+  if (_ctx.opts.num_threads == 1) {
+    // Components are already in bottom-up order
+    for (std::size_t scc = 0; scc < call_graph.num_sccs(); ++scc) {
+      this->analyze_scc(scc, summaries, init_inv, dispatcher, *progress);
+    }
+    return;
+  }
+
+  // Set the number of threads, for the duration of the analysis
+  std::unique_ptr< tbb::global_control > init;
+  if (_ctx.opts.num_threads > 0) {
+    init = std::make_unique< tbb::global_control >(
+        tbb::global_control::max_allowed_parallelism,
+        static_cast< std::size_t >(_ctx.opts.num_threads));
+  }
+
+  // Number of callee components not analyzed yet, for each component
+  std::vector< std::atomic< std::size_t > > pending(call_graph.num_sccs());
+  std::vector< std::size_t > roots;
+  for (std::size_t scc = 0; scc < call_graph.num_sccs(); ++scc) {
+    pending[scc].store(call_graph.callees(scc).size(),
+                       std::memory_order_relaxed);
+    if (call_graph.callees(scc).empty()) {
+      roots.push_back(scc);
+    }
+  }
+
+  // Analyze the components as soon as all their callees are summarized
+  tbb::parallel_for_each(roots.begin(),
+                         roots.end(),
+                         [&](std::size_t scc,
+                             tbb::feeder< std::size_t >& feeder) {
+                           this->analyze_scc(scc,
+                                             summaries,
+                                             init_inv,
+                                             dispatcher,
+                                             *progress);
+
+                           for (std::size_t caller : call_graph.callers(scc)) {
+                             if (pending[caller].fetch_sub(
+                                     1, std::memory_order_acq_rel) == 1) {
+                               feeder.add(caller);
+                             }
+                           }
+                         });
+}
+
+void Analysis::analyze_scc(std::size_t scc,
+                           SummaryTable& summaries,
+                           const AbstractDomain& init_inv,
+                           const CheckerDispatcher& dispatcher,
+                           ProgressLogger& progress) {
+  const CallGraph& call_graph = summaries.call_graph();
+
+  // Functions of a component are analyzed in order, each one using the
+  // summaries of the previous ones
+  for (ar::Function* function : call_graph.scc(scc)) {
+    FunctionFixpoint fixpoint(_ctx, summaries, function);
+
+    {
+      progress.start_task("Analyzing function '" +
+                          demangle(function->name()) + "'");
+      ScopeTimerDatabase t(_ctx.output_db->times,
+                           "ikos-analyzer.value." + function->name());
+      fixpoint.run(init_inv);
+    }
+
+    if (!dispatcher.empty()) {
+      progress.start_task("Checking properties for function '" +
+                          demangle(function->name()) + "'");
+      ScopeTimerDatabase t(_ctx.output_db->times,
+                           "ikos-analyzer.check." + function->name());
+      fixpoint.run_checks(dispatcher);
+    }
+
+    summaries.set(function, fixpoint.summary());
+  }
+}
+
+} // end namespace summary
+} // end namespace interprocedural
+} // end namespace value
+} // end namespace analyzer
+} // end namespace ikos
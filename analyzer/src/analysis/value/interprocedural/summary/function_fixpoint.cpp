@@ -0,0 +1,442 @@
+/*******************************************************************************
+ *
+ * \file
+ * \brief Fixpoint on a function body using summaries of the callees
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#include <algorithm>
+#include <string>
+
+#include <ikos/analyzer/analysis/execution_engine/numerical.hpp>
+#include <ikos/analyzer/analysis/execution_engine/summary.hpp>
+#include <ikos/analyzer/analysis/pointer/pointer.hpp>
+#include <ikos/analyzer/analysis/value/interprocedural/summary/function_fixpoint.hpp>
+
+namespace ikos {
+namespace analyzer {
+namespace value {
+namespace interprocedural {
+namespace summary {
+
+namespace {
+
+/// \brief Numerical execution engine
+using NumericalExecutionEngineT = NumericalExecutionEngine< AbstractDomain >;
+
+/// \brief Call execution engine
+using SummaryCallExecutionEngineT =
+    SummaryCallExecutionEngine< FunctionFixpoint, AbstractDomain >;
+
+/// \brief Assign `y` to `x`, where `x` and `y` are scalars of the same type
+void scalar_copy(MemoryAbstractDomain& inv, Variable* x, Variable* y) {
+  if (x->type()->is_integer()) {
+    inv.int_assign(x, y);
+  } else if (x->type()->is_float()) {
+    inv.float_assign(x, y);
+  } else if (x->type()->is_pointer()) {
+    inv.pointer_assign(x, y);
+  } else {
+    ikos_unreachable("unexpected type");
+  }
+}
+
+/// \brief Return true if the given call statement has a pointer argument
+bool has_pointer_argument(ar::CallBase* call) {
+  for (auto it = call->arg_begin(), et = call->arg_end(); it != et; ++it) {
+    if ((*it)->type()->is_pointer()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+} // end anonymous namespace
+
+FunctionFixpoint::FunctionFixpoint(Context& ctx,
+                                   const SummaryTable& summaries,
+                                   ar::Function* function)
+    : FwdFixpointIterator(function->body(), make_bottom_abstract_value(ctx)),
+      _ctx(ctx),
+      _function(function),
+      _empty_call_context(ctx.call_context_factory->get_empty()),
+      _fixpoint_parameters(ctx.fixpoint_parameters->get(function)),
+      _summaries(summaries),
+      _exit_invariant(make_bottom_abstract_value(ctx)),
+      _return_stmt(nullptr) {}
+
+void FunctionFixpoint::run(AbstractDomain inv) {
+  // The initialization of the actual parameters is checked at the call site
+  for (std::size_t i = 0; i < this->_function->num_parameters(); i++) {
+    Variable* shadow = this->parameter_shadow(i);
+    if (shadow == nullptr) {
+      continue;
+    }
+
+    Variable* param = _ctx.var_factory->get_internal(this->_function->param(i));
+    inv.normal().uninit_assert_initialized(param);
+    scalar_copy(inv.normal(), shadow, param);
+  }
+
+  FwdFixpointIterator::run(std::move(inv));
+}
+
+AbstractDomain FunctionFixpoint::extrapolate(ar::BasicBlock* head,
+                                             unsigned iteration,
+                                             const AbstractDomain& before,
+                                             const AbstractDomain& after) {
+  if (iteration <= this->_fixpoint_parameters.widening_delay) {
+    // Fixed number of iterations using join
+    return before.join_iter(after);
+  }
+
+  iteration -= this->_fixpoint_parameters.widening_delay;
+  iteration--;
+
+  if (iteration % this->_fixpoint_parameters.widening_period != 0) {
+    // Not the period, iteration using join
+    return before.join_iter(after);
+  }
+
+  switch (this->_fixpoint_parameters.widening_strategy) {
+    case WideningStrategy::Widen: {
+      if (iteration == 0) {
+        if (auto threshold =
+                this->_fixpoint_parameters.widening_hints.get(head)) {
+          // One iteration using widening with threshold
+          return before.widening_threshold(after, *threshold);
+        }
+      }
+
+      // Iterations using widening until convergence
+      return before.widening(after);
+    }
+    case WideningStrategy::Join: {
+      // Iterations using join until convergence
+      return before.join_iter(after);
+    }
+    default: {
+      ikos_unreachable("unexpected strategy");
+    }
+  }
+}
+
+AbstractDomain FunctionFixpoint::refine(ar::BasicBlock* head,
+                                        unsigned iteration,
+                                        const AbstractDomain& before,
+                                        const AbstractDomain& after) {
+  switch (this->_fixpoint_parameters.narrowing_strategy) {
+    case NarrowingStrategy::Narrow: {
+      if (iteration == 1) {
+        if (auto threshold =
+                this->_fixpoint_parameters.widening_hints.get(head)) {
+          // First iteration using narrowing with threshold
+          return before.narrowing_threshold(after, *threshold);
+        }
+      }
+
+      // Iterations using narrowing
+      return before.narrowing(after);
+    }
+    case NarrowingStrategy::Meet: {
+      // Iterations using meet
+      return before.meet(after);
+    }
+    default: {
+      ikos_unreachable("unexpected strategy");
+    }
+  }
+}
+
+bool FunctionFixpoint::is_decreasing_iterations_fixpoint(
+    ar::BasicBlock* /*head*/,
+    unsigned iteration,
+    const AbstractDomain& before,
+    const AbstractDomain& after) {
+  // Check if we reached the number of requested iterations, or convergence
+  return (this->_fixpoint_parameters.narrowing_iterations &&
+          iteration >= *this->_fixpoint_parameters.narrowing_iterations) ||
+         before.leq(after);
+}
+
+AbstractDomain FunctionFixpoint::analyze_node(ar::BasicBlock* bb,
+                                              AbstractDomain pre) {
+  NumericalExecutionEngineT
+      exec_engine(std::move(pre),
+                  this->_ctx,
+                  this->_empty_call_context,
+                  ExecutionEngine::UpdateAllocSizeVar,
+                  /* liveness = */ this->_ctx.liveness,
+                  /* pointer_info = */ this->_ctx.pointer == nullptr
+                      ? nullptr
+                      : &this->_ctx.pointer->results());
+  SummaryCallExecutionEngineT call_exec_engine(this->_ctx, exec_engine, *this);
+  exec_engine.exec_enter(bb);
+  for (ar::Statement* stmt : *bb) {
+    transfer_function(exec_engine, call_exec_engine, stmt);
+  }
+  exec_engine.exec_leave(bb);
+  return std::move(exec_engine.inv());
+}
+
+AbstractDomain FunctionFixpoint::analyze_edge(ar::BasicBlock* src,
+                                              ar::BasicBlock* dest,
+                                              AbstractDomain pre) {
+  NumericalExecutionEngineT
+      exec_engine(std::move(pre),
+                  this->_ctx,
+                  this->_empty_call_context,
+                  ExecutionEngine::UpdateAllocSizeVar,
+                  /* liveness = */ this->_ctx.liveness,
+                  /* pointer_info = */ this->_ctx.pointer == nullptr
+                      ? nullptr
+                      : &this->_ctx.pointer->results());
+  exec_engine.exec_edge(src, dest);
+  return std::move(exec_engine.inv());
+}
+
+void FunctionFixpoint::process_pre(ar::BasicBlock* /*bb*/,
+                                   const AbstractDomain& /*pre*/) {}
+
+void FunctionFixpoint::process_post(ar::BasicBlock* bb,
+                                    const AbstractDomain& post) {
+  if (this->_function->body()->exit_block_or_null() == bb) {
+    NumericalExecutionEngineT
+        exec_engine(post,
+                    this->_ctx,
+                    this->_empty_call_context,
+                    ExecutionEngine::UpdateAllocSizeVar,
+                    /* liveness = */ this->_ctx.liveness,
+                    /* pointer_info = */ this->_ctx.pointer == nullptr
+                        ? nullptr
+                        : &this->_ctx.pointer->results());
+    SummaryCallExecutionEngineT call_exec_engine(this->_ctx,
+                                                 exec_engine,
+                                                 *this);
+    call_exec_engine.exec_exit(this->_function);
+  }
+}
+
+void FunctionFixpoint::run_checks(const CheckerDispatcher& dispatcher) {
+  for (ar::BasicBlock* bb : *this->cfg()) {
+    NumericalExecutionEngineT
+        exec_engine(this->pre(bb),
+                    this->_ctx,
+                    this->_empty_call_context,
+                    ExecutionEngine::UpdateAllocSizeVar,
+                    /* liveness = */ this->_ctx.liveness,
+                    /* pointer_info = */ this->_ctx.pointer == nullptr
+                        ? nullptr
+                        : &this->_ctx.pointer->results());
+    SummaryCallExecutionEngineT call_exec_engine(this->_ctx,
+                                                 exec_engine,
+                                                 *this);
+
+    exec_engine.exec_enter(bb);
+
+    for (ar::Statement* stmt : *bb) {
+      // Check the statement if it's related to an llvm instruction
+      if (stmt->has_frontend()) {
+        dispatcher.check(stmt, exec_engine.inv(), this->_empty_call_context);
+      }
+
+      // Propagate
+      transfer_function(exec_engine, call_exec_engine, stmt);
+    }
+
+    exec_engine.exec_leave(bb);
+  }
+}
+
+std::unique_ptr< FunctionSummary > FunctionFixpoint::summary() const {
+  MemoryAbstractDomain inv = this->_exit_invariant.normal();
+
+  if (!inv.is_bottom()) {
+    ar::Value* returned = nullptr;
+    if (this->_return_stmt != nullptr && this->_return_stmt->has_operand()) {
+      returned = this->_return_stmt->operand();
+    }
+
+    // Forget the internal variables, except the returned one
+    ar::Code* body = this->_function->body();
+    for (auto it = body->internal_variable_begin(),
+              et = body->internal_variable_end();
+         it != et;
+         ++it) {
+      if (*it == returned) {
+        continue;
+      }
+
+      Variable* var = _ctx.var_factory->get_internal(*it);
+      if (var->type()->is_aggregate()) {
+        inv.mem_forget_reachable(var);
+      }
+      inv.scalar_forget(var);
+    }
+
+    // Restore the parameters to their value at the entry of the function
+    for (std::size_t i = 0; i < this->_function->num_parameters(); i++) {
+      Variable* shadow = this->parameter_shadow(i);
+      if (shadow == nullptr) {
+        continue;
+      }
+
+      Variable* param =
+          _ctx.var_factory->get_internal(this->_function->param(i));
+      scalar_copy(inv, param, shadow);
+      inv.scalar_forget(shadow);
+    }
+  }
+
+  bool may_throw_exceptions =
+      !this->_exit_invariant.is_caught_exceptions_bottom() ||
+      !this->_exit_invariant.is_propagated_exceptions_bottom();
+
+  return std::make_unique< FunctionSummary >(std::move(inv),
+                                             this->_return_stmt,
+                                             this->allocations(),
+                                             this->may_write_memory(),
+                                             may_throw_exceptions);
+}
+
+Variable* FunctionFixpoint::parameter_shadow(std::size_t i) const {
+  ar::InternalVariable* param = this->_function->param(i);
+  ar::Type* type = param->type();
+
+  if (!type->is_integer() && !type->is_float() && !type->is_pointer()) {
+    return nullptr;
+  }
+
+  return _ctx.var_factory->get_named_shadow(type,
+                                            "shadow.summary." +
+                                                this->_function->name() + "." +
+                                                std::to_string(i));
+}
+
+bool FunctionFixpoint::may_write_memory() const {
+  for (ar::BasicBlock* bb : *this->_function->body()) {
+    for (ar::Statement* stmt : *bb) {
+      if (auto store = dyn_cast< ar::Store >(stmt)) {
+        // Writes on local variables are not visible by the callers
+        if (!isa< ar::LocalVariable >(store->pointer())) {
+          return true;
+        }
+      } else if (auto call = dyn_cast< ar::CallBase >(stmt)) {
+        ar::Value* called = call->called();
+
+        if (auto cst = dyn_cast< ar::FunctionPointerConstant >(called)) {
+          ar::Function* callee = cst->function();
+
+          if (callee->is_declaration()) {
+            // ASSUMPTION: extern functions only write through their pointer
+            // parameters, see NumericalExecutionEngine::exec_unknown_call().
+            // Functions returning a pointer might also return the address of
+            // some internal state, such as __errno_location()
+            if (has_pointer_argument(call) ||
+                (call->has_result() && call->result()->type()->is_pointer())) {
+              return true;
+            }
+          } else {
+            const FunctionSummary* summary = this->callee_summary(callee);
+            if (summary == nullptr || summary->may_write_memory()) {
+              return true;
+            }
+          }
+        } else if (isa< ar::InlineAssemblyConstant >(called)) {
+          if (has_pointer_argument(call)) {
+            return true;
+          }
+        } else {
+          // Indirect call
+          return true;
+        }
+      }
+    }
+  }
+
+  return false;
+}
+
+std::vector< MemoryLocation* > FunctionFixpoint::allocations() const {
+  std::vector< MemoryLocation* > allocations;
+
+  // Calls to extern functions returning a pointer might allocate memory
+  for (ar::BasicBlock* bb : *this->_function->body()) {
+    for (ar::Statement* stmt : *bb) {
+      auto call = dyn_cast< ar::CallBase >(stmt);
+      if (call == nullptr || !call->has_result() ||
+          !call->result()->type()->is_pointer()) {
+        continue;
+      }
+
+      auto cst = dyn_cast< ar::FunctionPointerConstant >(call->called());
+      if (cst == nullptr || cst->function()->is_declaration()) {
+        allocations.push_back(
+            _ctx.mem_factory->get_dyn_alloc(call, this->_empty_call_context));
+      }
+    }
+  }
+
+  // Allocations of the callees with a summary
+  const CallGraph& call_graph = this->_summaries.call_graph();
+  for (std::size_t index : call_graph.successors(this->_function)) {
+    const FunctionSummary* summary =
+        this->callee_summary(call_graph.function(index));
+    if (summary != nullptr) {
+      allocations.insert(allocations.end(),
+                         summary->allocations().begin(),
+                         summary->allocations().end());
+    }
+  }
+
+  std::sort(allocations.begin(),
+            allocations.end(),
+            [](MemoryLocation* a, MemoryLocation* b) {
+              return a->index() < b->index();
+            });
+  allocations.erase(std::unique(allocations.begin(), allocations.end()),
+                    allocations.end());
+  return allocations;
+}
+
+} // end namespace summary
+} // end namespace interprocedural
+} // end namespace value
+} // end namespace analyzer
+} // end namespace ikos
@@ -43,11 +43,18 @@
  *
  ******************************************************************************/
 
+#include <vector>
+
+#include <tbb/global_control.h>
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
+
 #include <ikos/analyzer/analysis/execution_engine/context_insensitive.hpp>
 #include <ikos/analyzer/analysis/execution_engine/engine.hpp>
 #include <ikos/analyzer/analysis/execution_engine/numerical.hpp>
 #include <ikos/analyzer/analysis/pointer/pointer.hpp>
 #include <ikos/analyzer/analysis/value/intraprocedural/concurrent/function_fixpoint.hpp>
+#include <ikos/analyzer/database/output.hpp>
 
 namespace ikos {
 namespace analyzer {
@@ -196,37 +203,67 @@ void FunctionFixpoint::process_pre(ar::BasicBlock* /*bb*/,
 void FunctionFixpoint::process_post(ar::BasicBlock* /*bb*/,
                                     const AbstractDomain& /*post*/) {}
 
-void FunctionFixpoint::run_checks(
-    const std::vector< std::unique_ptr< Checker > >& checkers) {
-  for (ar::BasicBlock* bb : *this->cfg()) {
-    NumericalExecutionEngineT
-        exec_engine(this->pre(bb),
-                    this->_ctx,
-                    this->_empty_call_context,
-                    ExecutionEngine::UpdateAllocSizeVar,
-                    /* liveness = */ this->_ctx.liveness,
-                    /* pointer_info = */ this->_ctx.pointer == nullptr
-                        ? nullptr
-                        : &this->_ctx.pointer->results());
-    ContextInsensitiveCallExecutionEngineT call_exec_engine(exec_engine);
-
-    exec_engine.exec_enter(bb);
-
-    for (ar::Statement* stmt : *bb) {
-      // Check the statement if it's related to an llvm instruction
-      if (stmt->has_frontend()) {
-        exec_engine.inv().normalize();
-        for (const auto& checker : checkers) {
-          checker->check(stmt, exec_engine.inv(), this->_empty_call_context);
-        }
-      }
+void FunctionFixpoint::run_checks(const CheckerDispatcher& dispatcher) {
+  std::vector< ar::BasicBlock* > blocks(this->cfg()->begin(),
+                                        this->cfg()->end());
+
+  if (blocks.size() <= 1 ||
+      tbb::global_control::active_value(
+          tbb::global_control::max_allowed_parallelism) <= 1) {
+    for (ar::BasicBlock* bb : blocks) {
+      this->run_checks(dispatcher, bb);
+    }
+    return;
+  }
+
+  // Check the basic blocks in parallel
+  //
+  // Invariants at the entry of each basic block are fixed at this point, so
+  // blocks can be checked independently. Checks are buffered per basic block
+  // and merged in the order of the basic blocks, so that the output does not
+  // depend on the scheduling.
+  std::vector< ChecksTable::Buffer > buffers(blocks.size());
+
+  // Do not execute unrelated tasks while waiting, since checks are buffered
+  // per thread
+  tbb::this_task_arena::isolate([&] {
+    tbb::parallel_for(std::size_t(0), blocks.size(), [&](std::size_t i) {
+      ChecksTable::ScopeBuffer scope(buffers[i]);
+      this->run_checks(dispatcher, blocks[i]);
+    });
+  });
+
+  for (ChecksTable::Buffer& buffer : buffers) {
+    this->_ctx.output_db->checks.merge(buffer);
+  }
+}
+
+void FunctionFixpoint::run_checks(const CheckerDispatcher& dispatcher,
+                                  ar::BasicBlock* bb) {
+  NumericalExecutionEngineT
+      exec_engine(this->pre(bb),
+                  this->_ctx,
+                  this->_empty_call_context,
+                  ExecutionEngine::UpdateAllocSizeVar,
+                  /* liveness = */ this->_ctx.liveness,
+                  /* pointer_info = */ this->_ctx.pointer == nullptr
+                      ? nullptr
+                      : &this->_ctx.pointer->results());
+  ContextInsensitiveCallExecutionEngineT call_exec_engine(exec_engine);
+
+  exec_engine.exec_enter(bb);
 
-      // Propagate
-      transfer_function(exec_engine, call_exec_engine, stmt);
+  for (ar::Statement* stmt : *bb) {
+    // Check the statement if it's related to an llvm instruction
+    if (stmt->has_frontend()) {
+      dispatcher.check(stmt, exec_engine.inv(), this->_empty_call_context);
     }
 
-    exec_engine.exec_leave(bb);
+    // Propagate
+    transfer_function(exec_engine, call_exec_engine, stmt);
   }
+
+  exec_engine.exec_leave(bb);
 }
 
 } // end namespace concurrent
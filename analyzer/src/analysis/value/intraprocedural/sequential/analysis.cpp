@@ -47,7 +47,9 @@
 #include <ikos/analyzer/analysis/value/abstract_domain.hpp>
 #include <ikos/analyzer/analysis/value/intraprocedural/sequential/analysis.hpp>
 #include <ikos/analyzer/analysis/value/intraprocedural/sequential/function_fixpoint.hpp>
+#include <ikos/analyzer/analysis/value/summary_cache.hpp>
 #include <ikos/analyzer/checker/checker.hpp>
+#include <ikos/analyzer/checker/dispatcher.hpp>
 #include <ikos/analyzer/util/demangle.hpp>
 #include <ikos/analyzer/util/log.hpp>
 #include <ikos/analyzer/util/progress.hpp>
@@ -75,32 +77,59 @@ void Analysis::run() {
     }
   }
 
+  // Dispatch statements to the relevant checkers
+  CheckerDispatcher dispatcher(checkers);
+
   // Initial invariant
   AbstractDomain init_inv = make_initial_abstract_value(_ctx);
 
-  // Setup a progress logger
-  std::unique_ptr< ProgressLogger > progress =
-      make_progress_logger(_ctx.opts.progress,
-                           LogLevel::Info,
-                           /* num_tasks = */
-                           2 * std::count_if(bundle->function_begin(),
-                                             bundle->function_end(),
-                                             [](ar::Function* fun) {
-                                               return fun->is_definition();
-                                             }));
-  ScopeLogger scope(*progress);
-
-  // Analyze every function in the bundle
+  // Insert all the functions in the database, and collect the definitions of
+  // the shard to analyze
+  std::vector< ar::Function* > functions;
+  std::size_t num_definitions = 0;
   for (auto it = bundle->function_begin(), et = bundle->function_end();
        it != et;
        ++it) {
     ar::Function* function = *it;
 
-    // Insert the function in the database
     _ctx.output_db->functions.insert(function);
 
-    if (!function->is_definition()) {
-      continue;
+    if (function->is_definition() && _ctx.opts.in_shard(num_definitions++)) {
+      functions.push_back(function);
+    }
+  }
+
+  // Setup a progress logger
+  std::unique_ptr< ProgressLogger > progress =
+      make_progress_logger(_ctx.opts.progress,
+                           LogLevel::Info,
+                           /* num_tasks = */ 2 * functions.size());
+  ScopeLogger scope(*progress);
+
+  // Persistent cache of results, or null
+  std::unique_ptr< SummaryCache > summary_cache;
+  if (_ctx.opts.summary_cache) {
+    summary_cache =
+        std::make_unique< SummaryCache >(_ctx, *_ctx.opts.summary_cache);
+  }
+
+  // Analyze every function of the shard
+  for (ar::Function* function : functions) {
+    // Try to reuse the results of a previous run
+    std::string key;
+    ChecksTable::Buffer buffer;
+    std::unique_ptr< ChecksTable::ScopeBuffer > scope_buffer;
+    if (summary_cache) {
+      key = summary_cache->function_key(function);
+      if (summary_cache->load(key, buffer)) {
+        progress->start_task("Reusing cached results for function '" +
+                             demangle(function->name()) + "'");
+        progress->start_task("Inserting cached checks for function '" +
+                             demangle(function->name()) + "'");
+        _ctx.output_db->checks.insert(buffer);
+        continue;
+      }
+      scope_buffer = std::make_unique< ChecksTable::ScopeBuffer >(buffer);
     }
 
     FunctionFixpoint fixpoint(_ctx, function);
@@ -113,12 +142,18 @@ void Analysis::run() {
       fixpoint.run(init_inv);
     }
 
-    if (!checkers.empty()) {
+    if (!dispatcher.empty()) {
       progress->start_task("Checking properties for function '" +
                            demangle(function->name()) + "'");
       ScopeTimerDatabase t(_ctx.output_db->times,
                            "ikos-analyzer.check." + function->name());
-      fixpoint.run_checks(checkers);
+      fixpoint.run_checks(dispatcher);
+    }
+
+    if (summary_cache) {
+      scope_buffer.reset();
+      summary_cache->store(key, buffer);
+      _ctx.output_db->checks.insert(buffer);
     }
   }
 }
@@ -194,8 +194,7 @@ void FunctionFixpoint::process_pre(ar::BasicBlock* /*bb*/,
 void FunctionFixpoint::process_post(ar::BasicBlock* /*bb*/,
                                     const AbstractDomain& /*post*/) {}
 
-void FunctionFixpoint::run_checks(
-    const std::vector< std::unique_ptr< Checker > >& checkers) {
+void FunctionFixpoint::run_checks(const CheckerDispatcher& dispatcher) {
   for (ar::BasicBlock* bb : *this->cfg()) {
     NumericalExecutionEngineT
         exec_engine(this->pre(bb),
@@ -213,10 +212,7 @@ void FunctionFixpoint::run_checks(
     for (ar::Statement* stmt : *bb) {
       // Check the statement if it's related to an llvm instruction
       if (stmt->has_frontend()) {
-        exec_engine.inv().normalize();
-        for (const auto& checker : checkers) {
-          checker->check(stmt, exec_engine.inv(), this->_empty_call_context);
-        }
+        dispatcher.check(stmt, exec_engine.inv(), this->_empty_call_context);
       }
 
       // Propagate
@@ -58,6 +58,12 @@ MachineIntAbstractDomain make_top_machine_int_abstract_value(
       return make_top_machine_int_interval_congruence();
     case MachineIntDomainOption::DBM:
       return make_top_machine_int_dbm();
+    case MachineIntDomainOption::SplitDBM:
+      return make_top_machine_int_split_dbm();
+    case MachineIntDomainOption::FixedWidthDBM:
+      return make_top_machine_int_fixed_width_dbm();
+    case MachineIntDomainOption::FixedWidthOctagon:
+      return make_top_machine_int_fixed_width_octagon();
     case MachineIntDomainOption::VarPackDBM:
       return make_top_machine_int_var_pack_dbm();
     case MachineIntDomainOption::VarPackDBMCongruence:
@@ -109,6 +115,12 @@ MachineIntAbstractDomain make_bottom_machine_int_abstract_value(
       return make_bottom_machine_int_interval_congruence();
     case MachineIntDomainOption::DBM:
       return make_bottom_machine_int_dbm();
+    case MachineIntDomainOption::SplitDBM:
+      return make_bottom_machine_int_split_dbm();
+    case MachineIntDomainOption::FixedWidthDBM:
+      return make_bottom_machine_int_fixed_width_dbm();
+    case MachineIntDomainOption::FixedWidthOctagon:
+      return make_bottom_machine_int_fixed_width_octagon();
     case MachineIntDomainOption::VarPackDBM:
       return make_bottom_machine_int_var_pack_dbm();
     case MachineIntDomainOption::VarPackDBMCongruence:
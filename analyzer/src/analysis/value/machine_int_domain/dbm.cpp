@@ -43,6 +43,7 @@
 
 #include <ikos/core/domain/machine_int/numeric_domain_adapter.hpp>
 #include <ikos/core/domain/numeric/dbm.hpp>
+#include <ikos/core/serialization/domain.hpp>
 
 #include <ikos/analyzer/analysis/value/machine_int_domain.hpp>
 
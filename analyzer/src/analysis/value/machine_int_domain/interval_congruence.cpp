@@ -42,6 +42,7 @@
  ******************************************************************************/
 
 #include <ikos/core/domain/machine_int/interval_congruence.hpp>
+#include <ikos/core/serialization/domain.hpp>
 
 #include <ikos/analyzer/analysis/value/machine_int_domain.hpp>
 
@@ -45,6 +45,7 @@
 #include <ikos/core/domain/machine_int/numeric_domain_adapter.hpp>
 #include <ikos/core/domain/numeric/apron.hpp>
 #include <ikos/core/domain/numeric/var_packing_domain.hpp>
+#include <ikos/core/serialization/domain.hpp>
 #endif
 
 #include <ikos/analyzer/analysis/value/machine_int_domain.hpp>
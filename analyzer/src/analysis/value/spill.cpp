@@ -0,0 +1,133 @@
+/*******************************************************************************
+ *
+ * \file
+ * \brief Spilling of invariants to temporary files
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#include <cstdint>
+#include <iterator>
+#include <limits>
+
+#include <boost/filesystem/fstream.hpp>
+
+#include <ikos/analyzer/analysis/value/spill.hpp>
+#include <ikos/analyzer/exception.hpp>
+
+namespace ikos {
+namespace analyzer {
+namespace value {
+
+Variable* SpillResolver::operator()(
+    core::Index index, core::serialization::Tag< Variable* >) const {
+  Variable* var = nullptr;
+  if (index <= std::numeric_limits< std::uint32_t >::max()) {
+    var = this->_ctx.var_factory->get_by_index(
+        static_cast< std::uint32_t >(index));
+  }
+  if (var == nullptr) {
+    throw core::serialization::SerializationError(
+        "serialization: unknown variable");
+  }
+  return var;
+}
+
+MemoryLocation* SpillResolver::operator()(
+    core::Index index, core::serialization::Tag< MemoryLocation* >) const {
+  MemoryLocation* mem = nullptr;
+  if (index <= std::numeric_limits< std::uint32_t >::max()) {
+    mem = this->_ctx.mem_factory->get_by_index(
+        static_cast< std::uint32_t >(index));
+  }
+  if (mem == nullptr) {
+    throw core::serialization::SerializationError(
+        "serialization: unknown memory location");
+  }
+  return mem;
+}
+
+boost::filesystem::path write_spill_file(const std::string& bytes) {
+  boost::system::error_code err;
+  boost::filesystem::path path = boost::filesystem::temp_directory_path(err);
+  if (err) {
+    return {};
+  }
+  path /= boost::filesystem::unique_path("ikos-fixpoint-%%%%-%%%%-%%%%-%%%%",
+                                         err);
+  if (err) {
+    return {};
+  }
+
+  boost::filesystem::ofstream output(path,
+                                     std::ios::out | std::ios::binary |
+                                         std::ios::trunc);
+  output.write(bytes.data(), static_cast< std::streamsize >(bytes.size()));
+  if (!output) {
+    output.close();
+    boost::filesystem::remove(path, err);
+    return {};
+  }
+  return path;
+}
+
+std::string read_spill_file(const boost::filesystem::path& path) {
+  std::string bytes;
+  {
+    boost::filesystem::ifstream input(path, std::ios::in | std::ios::binary);
+    if (!input) {
+      throw LogicError("could not open spilled fixpoint '" + path.string() +
+                       "'");
+    }
+    bytes.assign(std::istreambuf_iterator< char >(input),
+                 std::istreambuf_iterator< char >());
+  }
+  remove_spill_file(path);
+  return bytes;
+}
+
+void remove_spill_file(const boost::filesystem::path& path) {
+  if (!path.empty()) {
+    boost::system::error_code err;
+    boost::filesystem::remove(path, err);
+  }
+}
+
+} // end namespace value
+} // end namespace analyzer
+} // end namespace ikos
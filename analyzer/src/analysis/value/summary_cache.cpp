@@ -0,0 +1,1482 @@
+/*******************************************************************************
+ *
+ * \file
+ * \brief Persistent cache of analysis results
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <sstream>
+#include <vector>
+
+#include <boost/filesystem/fstream.hpp>
+
+#include <llvm/ADT/SmallPtrSet.h>
+#include <llvm/Support/MD5.h>
+
+#include <ikos/ar/format/text.hpp>
+#include <ikos/ar/semantic/bundle.hpp>
+#include <ikos/ar/semantic/code.hpp>
+#include <ikos/ar/semantic/statement.hpp>
+
+#include <ikos/core/serialization/memory.hpp>
+
+#include <ikos/analyzer/analysis/pointer/pointer.hpp>
+#include <ikos/analyzer/analysis/value/machine_int_domain.hpp>
+#include <ikos/analyzer/analysis/value/summary_cache.hpp>
+#include <ikos/analyzer/exception.hpp>
+#include <ikos/analyzer/support/cast.hpp>
+#include <ikos/analyzer/util/log.hpp>
+
+namespace ikos {
+namespace analyzer {
+namespace value {
+
+namespace {
+
+/// \brief Header of cache files
+///
+/// Bump the version whenever the analysis or the file format changes.
+constexpr const char* FileHeader = "ikos-summary-cache 2";
+
+/// \brief Return the text formatter used for hashing
+ar::TextFormatter make_formatter() {
+  ar::Formatter::FormatOptions opts;
+  opts.set(ar::Formatter::ShowResultType, true);
+  opts.set(ar::Formatter::ShowOperandTypes, true);
+  opts.set(ar::Formatter::OrderGlobals, true);
+  return ar::TextFormatter(opts);
+}
+
+/// \brief Return the hexadecimal digest of the given hash
+std::string digest(llvm::MD5& hash) {
+  llvm::MD5::MD5Result result;
+  hash.final(result);
+  return result.digest().str().str();
+}
+
+/// \brief Return the hexadecimal digest of the given bytes
+std::string digest(llvm::StringRef bytes) {
+  llvm::MD5 hash;
+  hash.update(bytes);
+  return digest(hash);
+}
+
+/// \brief Add the functions and global variables referenced by the given
+/// value
+void collect_references(ar::Value* value,
+                        std::vector< ar::Function* >& functions,
+                        std::vector< ar::GlobalVariable* >& globals) {
+  if (auto cst = dyn_cast< ar::FunctionPointerConstant >(value)) {
+    functions.push_back(cst->function());
+  } else if (auto gv = dyn_cast< ar::GlobalVariable >(value)) {
+    globals.push_back(gv);
+  } else if (auto cst = dyn_cast< ar::StructConstant >(value)) {
+    for (auto it = cst->field_begin(), et = cst->field_end(); it != et; ++it) {
+      collect_references(it->value, functions, globals);
+    }
+  } else if (auto cst = dyn_cast< ar::SequentialConstant >(value)) {
+    for (auto it = cst->element_begin(), et = cst->element_end(); it != et;
+         ++it) {
+      collect_references(*it, functions, globals);
+    }
+  }
+}
+
+/// \brief Add the functions and global variables referenced by the given
+/// code
+void collect_references(ar::Code* code,
+                        std::vector< ar::Function* >& functions,
+                        std::vector< ar::GlobalVariable* >& globals) {
+  for (ar::BasicBlock* bb : *code) {
+    for (ar::Statement* stmt : *bb) {
+      for (auto it = stmt->op_begin(), et = stmt->op_end(); it != et; ++it) {
+        collect_references(*it, functions, globals);
+      }
+    }
+  }
+}
+
+/// \brief Function or global variable in the graph of references
+struct Node {
+  /// \brief Function, or null
+  ar::Function* fun = nullptr;
+
+  /// \brief Global variable, or null
+  ar::GlobalVariable* gv = nullptr;
+
+  /// \brief Hash of the definition, or empty if it cannot be cached
+  std::string hash;
+
+  /// \brief Referenced nodes
+  std::vector< std::size_t > succs;
+};
+
+/// \brief Return the strongly connected components of the graph, with the
+/// successors of a component before it
+///
+/// This is Tarjan's algorithm, with an explicit stack.
+std::vector< std::vector< std::size_t > > strongly_connected_components(
+    const std::vector< Node >& nodes) {
+  const std::size_t none = std::numeric_limits< std::size_t >::max();
+  std::vector< std::size_t > index(nodes.size(), none);
+  std::vector< std::size_t > lowlink(nodes.size(), 0);
+  std::vector< bool > on_stack(nodes.size(), false);
+  std::vector< std::size_t > stack;
+  std::vector< std::vector< std::size_t > > components;
+  std::size_t next_index = 0;
+
+  // Pairs (node, position of the next successor to visit)
+  std::vector< std::pair< std::size_t, std::size_t > > calls;
+
+  for (std::size_t root = 0; root < nodes.size(); root++) {
+    if (index[root] != none) {
+      continue;
+    }
+
+    calls.emplace_back(root, 0);
+    while (!calls.empty()) {
+      std::size_t v = calls.back().first;
+      if (index[v] == none) {
+        index[v] = lowlink[v] = next_index++;
+        stack.push_back(v);
+        on_stack[v] = true;
+      }
+
+      if (calls.back().second < nodes[v].succs.size()) {
+        std::size_t w = nodes[v].succs[calls.back().second++];
+        if (index[w] == none) {
+          calls.emplace_back(w, 0);
+        } else if (on_stack[w]) {
+          lowlink[v] = std::min(lowlink[v], index[w]);
+        }
+        continue;
+      }
+
+      if (lowlink[v] == index[v]) {
+        std::vector< std::size_t > component;
+        std::size_t w = none;
+        do {
+          w = stack.back();
+          stack.pop_back();
+          on_stack[w] = false;
+          component.push_back(w);
+        } while (w != v);
+        components.push_back(std::move(component));
+      }
+
+      calls.pop_back();
+      if (!calls.empty()) {
+        std::size_t u = calls.back().first;
+        lowlink[u] = std::min(lowlink[u], lowlink[v]);
+      }
+    }
+  }
+
+  return components;
+}
+
+/// \brief Write a string, prefixed by its length
+void write_string(std::ostream& o, const std::string& s) {
+  o << s.size() << ':' << s;
+}
+
+/// \brief Read a string, prefixed by its length
+bool read_string(std::istream& i, std::string& s) {
+  std::size_t size = 0;
+  char sep = 0;
+  if (!(i >> size) || !i.get(sep) || sep != ':') {
+    return false;
+  }
+  s.resize(size);
+  return static_cast< bool >(
+      i.read(&s[0], static_cast< std::streamsize >(size)));
+}
+
+/// \brief Read a string written by `Encoder::write_bytes()`
+std::string read_string(core::serialization::Decoder& d) {
+  core::StringRef bytes = d.read_bytes();
+  return std::string(bytes.data(), bytes.size());
+}
+
+/// \brief Write the given bytes in a cache file
+///
+/// Write in a temporary file, then rename it, so that concurrent writers and
+/// readers never see a partial file.
+void write_file(const boost::filesystem::path& directory,
+                const std::string& key,
+                const std::string& bytes) {
+  boost::filesystem::path tmp =
+      directory / boost::filesystem::unique_path(key + ".%%%%-%%%%-%%%%.tmp");
+  {
+    boost::filesystem::ofstream file(tmp, std::ios::out | std::ios::binary);
+    file << bytes;
+    if (!file) {
+      log::warning("could not write summary cache file " + tmp.string());
+      return;
+    }
+  }
+
+  boost::system::error_code err;
+  boost::filesystem::rename(tmp, directory / key, err);
+  if (err) {
+    log::warning("could not write summary cache file " + key + ": " +
+                 err.message());
+    boost::filesystem::remove(tmp, err);
+  }
+}
+
+/// \brief Compute the position of a statement in its function body
+///
+/// \returns false if the statement is not in a function body
+bool statement_position(ar::Statement* stmt,
+                        std::size_t& bb_index,
+                        std::size_t& stmt_index) {
+  ar::BasicBlock* parent = stmt->parent();
+  ar::Code* code = parent->code();
+  if (!code->is_function_body()) {
+    return false;
+  }
+
+  bb_index = 0;
+  for (ar::BasicBlock* bb : *code) {
+    if (bb == parent) {
+      break;
+    }
+    bb_index++;
+  }
+
+  stmt_index = 0;
+  for (ar::Statement* s : *parent) {
+    if (s == stmt) {
+      break;
+    }
+    stmt_index++;
+  }
+  return true;
+}
+
+/// \brief Return the statement at the given position, or null
+ar::Statement* statement_at(ar::Bundle* bundle,
+                            const std::string& name,
+                            std::size_t bb_index,
+                            std::size_t stmt_index) {
+  ar::Function* fun = bundle->function_or_null(name);
+  if (fun == nullptr || !fun->is_definition()) {
+    return nullptr;
+  }
+
+  for (ar::BasicBlock* bb : *fun->body()) {
+    if (bb_index-- == 0) {
+      for (ar::Statement* s : *bb) {
+        if (stmt_index-- == 0) {
+          return s;
+        }
+      }
+      return nullptr;
+    }
+  }
+  return nullptr;
+}
+
+/// \brief Write a reference to a statement
+///
+/// A statement is referenced by the name of its function, the index of its
+/// basic block and its index in the basic block.
+///
+/// \returns false if the statement is not in a function body
+bool write_statement(std::ostream& o, ar::Statement* stmt) {
+  std::size_t bb_index = 0;
+  std::size_t stmt_index = 0;
+  if (!statement_position(stmt, bb_index, stmt_index)) {
+    return false;
+  }
+
+  write_string(o, stmt->code()->function()->name());
+  o << ' ' << bb_index << ' ' << stmt_index;
+  return true;
+}
+
+/// \brief Read a reference to a statement, or return null
+ar::Statement* read_statement(std::istream& i, ar::Bundle* bundle) {
+  std::string name;
+  std::size_t bb_index = 0;
+  std::size_t stmt_index = 0;
+  if (!read_string(i, name) || !(i >> bb_index >> stmt_index)) {
+    return nullptr;
+  }
+  return statement_at(bundle, name, bb_index, stmt_index);
+}
+
+/// \brief Write a reference to a statement
+///
+/// \returns false if the statement is not in a function body
+bool write_statement(core::serialization::Encoder& e, ar::Statement* stmt) {
+  std::size_t bb_index = 0;
+  std::size_t stmt_index = 0;
+  if (!statement_position(stmt, bb_index, stmt_index)) {
+    return false;
+  }
+
+  e.write_bytes(stmt->code()->function()->name());
+  e.write_varint(bb_index);
+  e.write_varint(stmt_index);
+  return true;
+}
+
+/// \brief Read a reference to a statement, or return null
+ar::Statement* read_statement(core::serialization::Decoder& d,
+                              ar::Bundle* bundle) {
+  std::string name = read_string(d);
+  std::size_t bb_index = d.read_varint();
+  std::size_t stmt_index = d.read_varint();
+  return statement_at(bundle, name, bb_index, stmt_index);
+}
+
+/// \brief Write an invariant, or bottom
+void write_invariant(core::serialization::Encoder& e,
+                     const AbstractDomain& inv) {
+  e.write_bool(!inv.is_bottom());
+  if (!inv.is_bottom()) {
+    core::serialization::Serializer< AbstractDomain >::write(e, inv);
+  }
+}
+
+/// \brief Read an invariant written by write_invariant()
+template < typename Resolver >
+AbstractDomain read_invariant(core::serialization::Decoder& d,
+                              Resolver& resolve,
+                              const AbstractDomain& bottom) {
+  if (d.read_bool()) {
+    return core::serialization::read_like(d, resolve, bottom);
+  } else {
+    return bottom;
+  }
+}
+
+/// \brief Resolver collecting the variables and memory locations of encoded
+/// invariants of the current run
+class RecordingResolver {
+private:
+  Context& _ctx;
+  llvm::DenseMap< core::Index, Variable* > _variables;
+  llvm::DenseMap< core::Index, MemoryLocation* > _memory_locations;
+
+public:
+  /// \brief Constructor
+  explicit RecordingResolver(Context& ctx) : _ctx(ctx) {}
+
+  /// \brief Resolve a variable
+  Variable* operator()(core::Index index,
+                       core::serialization::Tag< Variable* >) {
+    Variable* var = nullptr;
+    if (index <= std::numeric_limits< std::uint32_t >::max()) {
+      var = this->_ctx.var_factory->get_by_index(
+          static_cast< std::uint32_t >(index));
+    }
+    if (var == nullptr) {
+      throw core::serialization::SerializationError(
+          "serialization: unknown variable");
+    }
+    this->_variables.try_emplace(index, var);
+    return var;
+  }
+
+  /// \brief Resolve a memory location
+  MemoryLocation* operator()(core::Index index,
+                             core::serialization::Tag< MemoryLocation* >) {
+    MemoryLocation* mem = nullptr;
+    if (index <= std::numeric_limits< std::uint32_t >::max()) {
+      mem = this->_ctx.mem_factory->get_by_index(
+          static_cast< std::uint32_t >(index));
+    }
+    if (mem == nullptr) {
+      throw core::serialization::SerializationError(
+          "serialization: unknown memory location");
+    }
+    this->_memory_locations.try_emplace(index, mem);
+    return mem;
+  }
+
+  /// \brief Return the collected variables
+  const llvm::DenseMap< core::Index, Variable* >& variables() const {
+    return this->_variables;
+  }
+
+  /// \brief Return the collected memory locations
+  const llvm::DenseMap< core::Index, MemoryLocation* >& memory_locations()
+      const {
+    return this->_memory_locations;
+  }
+
+}; // end class RecordingResolver
+
+/// \brief Resolver of the variables and memory locations of a stored fixpoint
+class TableResolver {
+private:
+  const llvm::DenseMap< core::Index, Variable* >& _variables;
+  const llvm::DenseMap< core::Index, MemoryLocation* >& _memory_locations;
+
+public:
+  /// \brief Constructor
+  TableResolver(
+      const llvm::DenseMap< core::Index, Variable* >& variables,
+      const llvm::DenseMap< core::Index, MemoryLocation* >& memory_locations)
+      : _variables(variables), _memory_locations(memory_locations) {}
+
+  /// \brief Resolve a variable
+  Variable* operator()(core::Index index,
+                       core::serialization::Tag< Variable* >) const {
+    auto it = this->_variables.find(index);
+    if (it == this->_variables.end()) {
+      throw core::serialization::SerializationError(
+          "serialization: unknown variable");
+    }
+    return it->second;
+  }
+
+  /// \brief Resolve a memory location
+  MemoryLocation* operator()(
+      core::Index index, core::serialization::Tag< MemoryLocation* >) const {
+    auto it = this->_memory_locations.find(index);
+    if (it == this->_memory_locations.end()) {
+      throw core::serialization::SerializationError(
+          "serialization: unknown memory location");
+    }
+    return it->second;
+  }
+
+}; // end class TableResolver
+
+} // end anonymous namespace
+
+SummaryCache::SummaryCache(Context& ctx, boost::filesystem::path directory)
+    : _ctx(ctx), _directory(std::move(directory)) {
+  boost::system::error_code err;
+  if (!boost::filesystem::exists(this->_directory)) {
+    if (!boost::filesystem::create_directories(this->_directory, err)) {
+      throw LogicError(this->_directory.string() + ": " + err.message());
+    }
+  }
+  if (!boost::filesystem::is_directory(this->_directory, err)) {
+    throw LogicError(this->_directory.string() + ": not a directory");
+  }
+
+  const AnalysisOptions& opts = _ctx.opts;
+  ar::Bundle* bundle = _ctx.bundle;
+  std::ostringstream buf;
+
+  // Options that can change the results
+  buf << FileHeader << '\n';
+  for (CheckerName name : opts.analyses) {
+    buf << checker_short_name(name) << ',';
+  }
+  buf << '\n'
+      << machine_int_domain_option_str(opts.machine_int_domain) << '\n'
+      << procedural_str(opts.procedural) << '\n'
+      << widening_strategy_str(opts.widening_strategy) << '\n'
+      << narrowing_strategy_str(opts.narrowing_strategy) << '\n'
+      << opts.widening_delay << '\n';
+  for (const auto& p : opts.widening_delay_functions) {
+    write_string(buf, p.first->name());
+    buf << '=' << p.second << ',';
+  }
+  buf << '\n' << opts.widening_period << '\n';
+  if (opts.narrowing_iterations) {
+    buf << *opts.narrowing_iterations;
+  }
+  buf << '\n'
+      << opts.use_liveness << opts.use_pointer << opts.use_widening_hints
+      << opts.use_partitioning_domain << opts.use_checks << '\n'
+      << globals_init_policy_str(opts.globals_init_policy) << '\n'
+      << hardware_addresses_str(opts.hardware_addresses) << '\n';
+  if (opts.argc) {
+    buf << *opts.argc;
+  }
+  buf << '\n';
+  if (opts.context_depth) {
+    buf << *opts.context_depth;
+  }
+  buf << '\n';
+
+  // Data layout
+  const ar::DataLayout& data_layout = bundle->data_layout();
+  buf << data_layout.is_little_endian() << '\n'
+      << data_layout.pointers.bit_width << '\n'
+      << bundle->target_triple() << '\n';
+
+  this->_common_hash = digest(buf.str());
+
+  // Number the local and internal variables
+  for (auto it = bundle->function_begin(), et = bundle->function_end();
+       it != et;
+       ++it) {
+    ar::Function* fun = *it;
+    std::size_t position = 0;
+    for (auto lv = fun->local_variable_begin(), le = fun->local_variable_end();
+         lv != le;
+         ++lv) {
+      this->_positions.try_emplace(*lv, position++);
+    }
+    if (fun->is_definition()) {
+      position = 0;
+      ar::Code* body = fun->body();
+      for (auto iv = body->internal_variable_begin(),
+                ie = body->internal_variable_end();
+           iv != ie;
+           ++iv) {
+        this->_positions.try_emplace(*iv, position++);
+      }
+    }
+  }
+  for (auto it = bundle->global_begin(), et = bundle->global_end(); it != et;
+       ++it) {
+    ar::GlobalVariable* gv = *it;
+    if (gv->is_definition()) {
+      std::size_t position = 0;
+      ar::Code* code = gv->initializer();
+      for (auto iv = code->internal_variable_begin(),
+                ie = code->internal_variable_end();
+           iv != ie;
+           ++iv) {
+        this->_positions.try_emplace(*iv, position++);
+      }
+    }
+  }
+
+  if (opts.procedural == Procedural::Interprocedural) {
+    this->compute_keys();
+  }
+}
+
+SummaryCache::~SummaryCache() {
+  for (const std::string& key : this->_stored_fixpoints) {
+    this->write_fixpoints(key, this->_fixpoints[key]);
+  }
+}
+
+void SummaryCache::compute_keys() {
+  ar::Bundle* bundle = _ctx.bundle;
+  ar::TextFormatter formatter = make_formatter();
+
+  // Build the graph of references between functions and global variables
+  std::vector< Node > nodes;
+  llvm::DenseMap< ar::Function*, std::size_t > function_nodes;
+  llvm::DenseMap< ar::GlobalVariable*, std::size_t > global_nodes;
+  for (auto it = bundle->function_begin(), et = bundle->function_end();
+       it != et;
+       ++it) {
+    function_nodes.try_emplace(*it, nodes.size());
+    nodes.emplace_back();
+    nodes.back().fun = *it;
+  }
+  for (auto it = bundle->global_begin(), et = bundle->global_end(); it != et;
+       ++it) {
+    global_nodes.try_emplace(*it, nodes.size());
+    nodes.emplace_back();
+    nodes.back().gv = *it;
+  }
+
+  for (Node& node : nodes) {
+    std::vector< ar::Function* > functions;
+    std::vector< ar::GlobalVariable* > globals;
+    if (node.fun != nullptr) {
+      node.hash = this->own_hash(node.fun, functions);
+      if (node.fun->is_definition()) {
+        collect_references(node.fun->body(), functions, globals);
+      }
+    } else {
+      std::ostringstream buf;
+      formatter.format(buf, node.gv);
+      node.hash = digest(buf.str());
+      if (node.gv->is_definition()) {
+        collect_references(node.gv->initializer(), functions, globals);
+      }
+    }
+
+    for (ar::Function* fun : functions) {
+      node.succs.push_back(function_nodes[fun]);
+    }
+    for (ar::GlobalVariable* gv : globals) {
+      node.succs.push_back(global_nodes[gv]);
+    }
+    std::sort(node.succs.begin(), node.succs.end());
+    node.succs.erase(std::unique(node.succs.begin(), node.succs.end()),
+                     node.succs.end());
+  }
+
+  // The key of a node is the hash of the definitions of its strongly
+  // connected component and the keys of the components it refers to.
+  std::vector< std::string > keys(nodes.size());
+  for (const std::vector< std::size_t >& component :
+       strongly_connected_components(nodes)) {
+    bool cacheable = true;
+    std::vector< std::string > hashes;
+    std::vector< std::string > succ_keys;
+    for (std::size_t v : component) {
+      const Node& node = nodes[v];
+      cacheable = cacheable && !node.hash.empty();
+      hashes.push_back(node.hash);
+      for (std::size_t w : node.succs) {
+        if (std::find(component.begin(), component.end(), w) ==
+            component.end()) {
+          cacheable = cacheable && !keys[w].empty();
+          succ_keys.push_back(keys[w]);
+        }
+      }
+    }
+
+    if (!cacheable) {
+      // Keys are left empty
+      continue;
+    }
+
+    std::sort(hashes.begin(), hashes.end());
+    std::sort(succ_keys.begin(), succ_keys.end());
+    succ_keys.erase(std::unique(succ_keys.begin(), succ_keys.end()),
+                    succ_keys.end());
+
+    core::serialization::Encoder e;
+    e.write_bytes(this->_common_hash);
+    e.write_varint(hashes.size());
+    for (const std::string& hash : hashes) {
+      e.write_bytes(hash);
+    }
+    e.write_varint(succ_keys.size());
+    for (const std::string& key : succ_keys) {
+      e.write_bytes(key);
+    }
+    std::string component_hash = digest(e.str());
+
+    for (std::size_t v : component) {
+      const Node& node = nodes[v];
+      core::serialization::Encoder k;
+      k.write_bytes(component_hash);
+      k.write_bool(node.fun != nullptr);
+      k.write_bytes(node.fun != nullptr ? node.fun->name() : node.gv->name());
+      keys[v] = digest(k.str());
+    }
+  }
+
+  for (std::size_t v = 0; v < nodes.size(); v++) {
+    if (nodes[v].fun != nullptr) {
+      this->_function_keys.try_emplace(nodes[v].fun, keys[v]);
+    } else {
+      this->_global_keys.try_emplace(nodes[v].gv, keys[v]);
+    }
+  }
+}
+
+std::string SummaryCache::own_hash(
+    ar::Function* fun, std::vector< ar::Function* >& functions) const {
+  std::ostringstream buf;
+  ar::TextFormatter formatter = make_formatter();
+  formatter.format(buf, fun);
+
+  if (_ctx.pointer != nullptr && fun->is_definition()) {
+    // The value analysis refines pointers with the pointer analysis, which is
+    // a whole program analysis.
+    const PointerInfo& info = _ctx.pointer->results();
+    core::serialization::Encoder e;
+    ar::Code* body = fun->body();
+    for (auto it = body->internal_variable_begin(),
+              et = body->internal_variable_end();
+         it != et;
+         ++it) {
+      PointerAbsValue value = info.get(_ctx.var_factory->get_internal(*it));
+      e.write_bool(value.is_bottom());
+      e.write_bool(value.is_top());
+      if (value.is_bottom() || value.is_top()) {
+        continue;
+      }
+
+      core::serialization::Serializer< core::Uninitialized >::write(
+          e, value.uninitialized());
+      core::serialization::Serializer< core::Nullity >::write(e,
+                                                              value.nullity());
+      core::serialization::Serializer< MachineIntInterval >::write(
+          e, value.offset());
+
+      const PointsToSet& points_to = value.points_to();
+      e.write_bool(points_to.is_top());
+      if (points_to.is_top()) {
+        continue;
+      }
+
+      // Points-to sets are ordered by index, sort the descriptions instead
+      std::vector< std::string > descriptions;
+      for (MemoryLocation* mem : points_to) {
+        core::serialization::Encoder m;
+        if (!this->write_memory_location(m, mem, /* with_keys = */ false)) {
+          return std::string();
+        }
+        descriptions.push_back(m.release());
+
+        if (auto fun_mem = dyn_cast< FunctionMemoryLocation >(mem)) {
+          functions.push_back(fun_mem->function());
+        }
+      }
+      std::sort(descriptions.begin(), descriptions.end());
+      e.write_varint(descriptions.size());
+      for (const std::string& description : descriptions) {
+        e.write_bytes(description);
+      }
+    }
+    buf << '\n';
+    write_string(buf, e.str());
+  }
+
+  return digest(buf.str());
+}
+
+std::string SummaryCache::entry_point_key(ar::Function* entry_point) const {
+  const AnalysisOptions& opts = _ctx.opts;
+  ar::Bundle* bundle = _ctx.bundle;
+
+  std::string key = this->function_key(entry_point);
+  if (key.empty()) {
+    return key;
+  }
+
+  bool init_globals = std::find(opts.no_init_globals.begin(),
+                                opts.no_init_globals.end(),
+                                entry_point) == opts.no_init_globals.end();
+
+  core::serialization::Encoder e;
+  e.write_bytes(entry_point->name());
+  e.write_bytes(key);
+  e.write_bool(init_globals);
+
+  if (init_globals) {
+    // The entry invariant depends on the global constructors. The initial
+    // values of the global variables used by the entry point are covered by
+    // its key.
+    ar::GlobalVariable* gv_ctors = bundle->global_or_null("ar.global_ctors");
+    if (gv_ctors != nullptr) {
+      auto it = this->_global_keys.find(gv_ctors);
+      if (it == this->_global_keys.end() || it->second.empty()) {
+        return std::string();
+      }
+      e.write_bytes(it->second);
+    }
+  }
+
+  return digest(e.str());
+}
+
+std::string SummaryCache::function_key(ar::Function* fun) const {
+  if (_ctx.opts.procedural == Procedural::Interprocedural) {
+    auto it = this->_function_keys.find(fun);
+    if (it == this->_function_keys.end()) {
+      return std::string();
+    }
+    return it->second;
+  }
+
+  // Callees are not analyzed, only their declarations matter
+  std::vector< ar::Function* > functions;
+  std::vector< ar::GlobalVariable* > globals;
+  std::string hash = this->own_hash(fun, functions);
+  if (hash.empty()) {
+    return hash;
+  }
+  if (fun->is_definition()) {
+    collect_references(fun->body(), functions, globals);
+  }
+
+  std::sort(functions.begin(),
+            functions.end(),
+            [](ar::Function* a, ar::Function* b) {
+              return a->name() < b->name();
+            });
+  functions.erase(std::unique(functions.begin(), functions.end()),
+                  functions.end());
+  std::sort(globals.begin(),
+            globals.end(),
+            [](ar::GlobalVariable* a, ar::GlobalVariable* b) {
+              return a->name() < b->name();
+            });
+  globals.erase(std::unique(globals.begin(), globals.end()), globals.end());
+
+  std::ostringstream buf;
+  buf << this->_common_hash << '\n' << hash << '\n';
+  ar::TextFormatter formatter = make_formatter();
+  for (ar::Function* callee : functions) {
+    write_string(buf, callee->name());
+    buf << ' ' << callee->is_definition() << ' ';
+    formatter.format(buf, callee->type());
+    buf << '\n';
+  }
+  for (ar::GlobalVariable* gv : globals) {
+    write_string(buf, gv->name());
+    buf << ' ' << gv->is_definition() << ' ';
+    formatter.format(buf, gv->type());
+    buf << '\n';
+  }
+
+  return digest(buf.str());
+}
+
+bool SummaryCache::load(const std::string& key,
+                        ChecksTable::Buffer& buffer) const {
+  if (key.empty()) {
+    return false;
+  }
+
+  std::ifstream file((this->_directory / key).string());
+  if (!file) {
+    return false;
+  }
+
+  std::string header;
+  if (!std::getline(file, header) || header != FileHeader) {
+    return false;
+  }
+
+  ar::Bundle* bundle = _ctx.bundle;
+  ChecksTable::Buffer result;
+  int kind = 0;
+  int checker = 0;
+  int status = 0;
+  while (file >> kind >> checker >> status) {
+    ChecksTable::Buffer::Check check{static_cast< CheckKind >(kind),
+                                     static_cast< CheckerName >(checker),
+                                     static_cast< Result >(status),
+                                     read_statement(file, bundle),
+                                     _ctx.call_context_factory->get_empty(),
+                                     {},
+                                     {}};
+    if (check.stmt == nullptr) {
+      return false;
+    }
+
+    std::size_t depth = 0;
+    if (!(file >> depth)) {
+      return false;
+    }
+    for (; depth > 0; depth--) {
+      auto call = dyn_cast_or_null< ar::CallBase >(read_statement(file, bundle));
+      if (call == nullptr) {
+        return false;
+      }
+      check.call_context =
+          _ctx.call_context_factory->get_context(check.call_context, call);
+    }
+
+    std::size_t num_operands = 0;
+    if (!(file >> num_operands)) {
+      return false;
+    }
+    for (; num_operands > 0; num_operands--) {
+      std::size_t operand_no = 0;
+      if (!(file >> operand_no) || operand_no >= check.stmt->num_operands()) {
+        return false;
+      }
+      check.operands.push_back(check.stmt->operand(operand_no));
+    }
+
+    if (!read_string(file, check.info)) {
+      return false;
+    }
+
+    result.add(std::move(check));
+  }
+
+  if (!file.eof()) {
+    return false;
+  }
+
+  for (const ChecksTable::Buffer::Check& check : result) {
+    buffer.add(check);
+  }
+  return true;
+}
+
+void SummaryCache::store(const std::string& key,
+                         const ChecksTable::Buffer& buffer) const {
+  if (key.empty() || buffer.refers_to_rows()) {
+    // Additional information refers to rows of the output database
+    return;
+  }
+
+  std::ostringstream buf;
+  buf << FileHeader << '\n';
+
+  for (const ChecksTable::Buffer::Check& check : buffer) {
+    buf << static_cast< int >(check.kind) << ' '
+        << static_cast< int >(check.checker) << ' '
+        << static_cast< int >(check.status) << ' ';
+    if (!write_statement(buf, check.stmt)) {
+      return;
+    }
+
+    // Calling context, from the entry point to the callee
+    std::vector< ar::CallBase* > calls;
+    for (CallContext* context = check.call_context; !context->empty();
+         context = context->parent()) {
+      calls.push_back(context->call());
+    }
+    buf << ' ' << calls.size();
+    for (auto it = calls.rbegin(), et = calls.rend(); it != et; ++it) {
+      buf << ' ';
+      if (!write_statement(buf, *it)) {
+        return;
+      }
+    }
+
+    buf << ' ' << check.operands.size();
+    for (ar::Value* operand : check.operands) {
+      auto it =
+          std::find(check.stmt->op_begin(), check.stmt->op_end(), operand);
+      if (it == check.stmt->op_end()) {
+        return;
+      }
+      buf << ' ' << (it - check.stmt->op_begin());
+    }
+    buf << ' ';
+    write_string(buf, check.info);
+    buf << '\n';
+  }
+
+  write_file(this->_directory, key, buf.str());
+}
+
+bool SummaryCache::load_fixpoint(ar::Function* callee,
+                                 CallContext* context,
+                                 const AbstractDomain& entry_inv,
+                                 std::vector< AbstractDomain >& invariants) {
+  std::string key = this->fixpoint_key(callee, context);
+  if (key.empty()) {
+    return false;
+  }
+
+  std::size_t num_invariants = 1;
+  for (auto it = callee->body()->begin(), et = callee->body()->end(); it != et;
+       ++it) {
+    num_invariants++;
+  }
+
+  std::lock_guard< std::mutex > lock(this->_fixpoints_mutex);
+  for (Fixpoint& fixpoint : this->fixpoints(key)) {
+    if (!this->decode_entry(fixpoint) ||
+        !fixpoint.entry_inv->equals(entry_inv)) {
+      continue;
+    }
+
+    try {
+      TableResolver resolve(fixpoint.variables, fixpoint.memory_locations);
+      AbstractDomain bottom = make_bottom_abstract_value(_ctx);
+      core::serialization::Decoder d(fixpoint.invariants);
+      std::vector< AbstractDomain > result;
+      for (std::uint64_t n = d.read_varint(); n > 0; n--) {
+        result.push_back(read_invariant(d, resolve, bottom));
+      }
+      if (d.at_end() && result.size() == num_invariants) {
+        invariants = std::move(result);
+        return true;
+      }
+    } catch (const core::serialization::SerializationError&) {
+      // Malformed invariants
+    }
+    fixpoint.invalid = true;
+  }
+
+  return false;
+}
+
+void SummaryCache::store_fixpoint(ar::Function* callee,
+                                  CallContext* context,
+                                  const AbstractDomain& entry_inv,
+                                  const std::vector< AbstractDomain >&
+                                      invariants) {
+  std::string key = this->fixpoint_key(callee, context);
+  if (key.empty()) {
+    return;
+  }
+
+  {
+    std::lock_guard< std::mutex > lock(this->_fixpoints_mutex);
+    for (Fixpoint& fixpoint : this->fixpoints(key)) {
+      if (this->decode_entry(fixpoint) &&
+          fixpoint.entry_inv->equals(entry_inv)) {
+        // Already stored
+        return;
+      }
+    }
+  }
+
+  Fixpoint fixpoint;
+  try {
+    core::serialization::Encoder entry;
+    write_invariant(entry, entry_inv);
+    fixpoint.entry = entry.release();
+
+    core::serialization::Encoder e;
+    e.write_varint(invariants.size());
+    for (const AbstractDomain& inv : invariants) {
+      write_invariant(e, inv);
+    }
+    fixpoint.invariants = e.release();
+
+    // Collect the variables and memory locations by decoding the invariants,
+    // and describe them.
+    RecordingResolver record(_ctx);
+    AbstractDomain bottom = make_bottom_abstract_value(_ctx);
+    {
+      core::serialization::Decoder d(fixpoint.entry);
+      read_invariant(d, record, bottom);
+    }
+    {
+      core::serialization::Decoder d(fixpoint.invariants);
+      for (std::uint64_t n = d.read_varint(); n > 0; n--) {
+        read_invariant(d, record, bottom);
+      }
+    }
+
+    core::serialization::Encoder refs;
+    refs.write_varint(record.variables().size());
+    for (const auto& p : record.variables()) {
+      refs.write_varint(p.first);
+      if (!this->write_variable(refs, p.second)) {
+        return;
+      }
+    }
+    refs.write_varint(record.memory_locations().size());
+    for (const auto& p : record.memory_locations()) {
+      refs.write_varint(p.first);
+      if (!this->write_memory_location(refs, p.second)) {
+        return;
+      }
+    }
+    fixpoint.refs = refs.release();
+  } catch (const core::serialization::SerializationError&) {
+    // Unsupported abstract domain, e.g. the partitioning domain
+    return;
+  }
+
+  std::lock_guard< std::mutex > lock(this->_fixpoints_mutex);
+  std::vector< Fixpoint >& fixpoints = this->fixpoints(key);
+  fixpoints.insert(fixpoints.begin(), std::move(fixpoint));
+  if (fixpoints.size() > MaxFixpoints) {
+    fixpoints.erase(fixpoints.begin() + MaxFixpoints, fixpoints.end());
+  }
+  this->_stored_fixpoints.insert(key);
+}
+
+std::string SummaryCache::fixpoint_key(ar::Function* callee,
+                                       CallContext* context) const {
+  std::string key = this->function_key(callee);
+  if (key.empty()) {
+    return key;
+  }
+
+  core::serialization::Encoder e;
+  e.write_bytes("fixpoint");
+  e.write_bytes(key);
+  if (!this->write_call_context(e, context)) {
+    return std::string();
+  }
+  return digest(e.str());
+}
+
+std::vector< SummaryCache::Fixpoint >& SummaryCache::fixpoints(
+    const std::string& key) {
+  auto it = this->_fixpoints.find(key);
+  if (it != this->_fixpoints.end()) {
+    return it->second;
+  }
+
+  std::vector< Fixpoint >& fixpoints = this->_fixpoints[key];
+
+  boost::filesystem::ifstream file(this->_directory / key,
+                                   std::ios::in | std::ios::binary);
+  if (!file) {
+    return fixpoints;
+  }
+  std::string bytes((std::istreambuf_iterator< char >(file)),
+                    std::istreambuf_iterator< char >());
+
+  try {
+    core::serialization::Decoder d(bytes);
+    d.read_header();
+    if (read_string(d) != FileHeader) {
+      return fixpoints;
+    }
+    std::vector< Fixpoint > result;
+    for (std::uint64_t n = d.read_varint(); n > 0; n--) {
+      Fixpoint fixpoint;
+      fixpoint.refs = read_string(d);
+      fixpoint.entry = read_string(d);
+      fixpoint.invariants = read_string(d);
+      result.push_back(std::move(fixpoint));
+    }
+    if (d.at_end()) {
+      fixpoints = std::move(result);
+    }
+  } catch (const core::serialization::SerializationError&) {
+    // Ignore malformed files
+  }
+  return fixpoints;
+}
+
+bool SummaryCache::decode_entry(Fixpoint& fixpoint) const {
+  if (fixpoint.invalid) {
+    return false;
+  }
+  if (fixpoint.entry_inv != nullptr) {
+    return true;
+  }
+
+  try {
+    core::serialization::Decoder refs(fixpoint.refs);
+    for (std::uint64_t n = refs.read_varint(); n > 0; n--) {
+      core::Index index = refs.read_varint();
+      Variable* var = this->read_variable(refs);
+      if (var == nullptr) {
+        fixpoint.invalid = true;
+        return false;
+      }
+      fixpoint.variables.try_emplace(index, var);
+    }
+    for (std::uint64_t n = refs.read_varint(); n > 0; n--) {
+      core::Index index = refs.read_varint();
+      MemoryLocation* mem = this->read_memory_location(refs);
+      if (mem == nullptr) {
+        fixpoint.invalid = true;
+        return false;
+      }
+      fixpoint.memory_locations.try_emplace(index, mem);
+    }
+
+    TableResolver resolve(fixpoint.variables, fixpoint.memory_locations);
+    core::serialization::Decoder d(fixpoint.entry);
+    fixpoint.entry_inv = std::make_unique< AbstractDomain >(
+        read_invariant(d, resolve, make_bottom_abstract_value(_ctx)));
+  } catch (const core::serialization::SerializationError&) {
+    fixpoint.invalid = true;
+    return false;
+  }
+
+  return true;
+}
+
+void SummaryCache::write_fixpoints(
+    const std::string& key, const std::vector< Fixpoint >& fixpoints) const {
+  core::serialization::Encoder e;
+  e.write_header();
+  e.write_bytes(FileHeader);
+  e.write_varint(fixpoints.size());
+  for (const Fixpoint& fixpoint : fixpoints) {
+    e.write_bytes(fixpoint.refs);
+    e.write_bytes(fixpoint.entry);
+    e.write_bytes(fixpoint.invariants);
+  }
+  write_file(this->_directory, key, e.str());
+}
+
+bool SummaryCache::write_variable(core::serialization::Encoder& e,
+                                  Variable* var) const {
+  e.write_byte(static_cast< std::uint8_t >(var->kind()));
+  if (auto local = dyn_cast< LocalVariable >(var)) {
+    ar::LocalVariable* lv = local->local_var();
+    auto it = this->_positions.find(lv);
+    if (it == this->_positions.end()) {
+      return false;
+    }
+    e.write_bytes(lv->function()->name());
+    e.write_varint(it->second);
+  } else if (auto global = dyn_cast< GlobalVariable >(var)) {
+    e.write_bytes(global->global_var()->name());
+  } else if (auto internal = dyn_cast< InternalVariable >(var)) {
+    return this->write_internal_variable(e, internal->internal_var());
+  } else if (auto fun_ptr = dyn_cast< FunctionPointerVariable >(var)) {
+    e.write_bytes(fun_ptr->function()->name());
+  } else if (auto cell = dyn_cast< CellVariable >(var)) {
+    auto type = dyn_cast< ar::IntegerType >(cell->type());
+    if (type == nullptr || !this->write_memory_location(e, cell->address())) {
+      return false;
+    }
+    core::serialization::Serializer< MachineInt >::write(e, cell->offset());
+    core::serialization::Serializer< MachineInt >::write(e, cell->size());
+    e.write_bool(type->sign() == Signed);
+  } else if (auto offset = dyn_cast< OffsetVariable >(var)) {
+    return this->write_variable(e, offset->pointer());
+  } else if (auto alloc_size = dyn_cast< AllocSizeVariable >(var)) {
+    return this->write_memory_location(e, alloc_size->address());
+  } else if (auto ret = dyn_cast< ReturnVariable >(var)) {
+    e.write_bytes(ret->function()->name());
+  } else {
+    // Inline assembly pointers and shadow variables
+    //
+    // Named shadow variables are not described, since reading their type
+    // could create types in the AR context, which is not thread-safe.
+    return false;
+  }
+  return true;
+}
+
+bool SummaryCache::write_memory_location(core::serialization::Encoder& e,
+                                         MemoryLocation* mem,
+                                         bool with_keys) const {
+  e.write_byte(static_cast< std::uint8_t >(mem->kind()));
+  if (auto local = dyn_cast< LocalMemoryLocation >(mem)) {
+    ar::LocalVariable* lv = local->local_var();
+    auto it = this->_positions.find(lv);
+    if (it == this->_positions.end()) {
+      return false;
+    }
+    e.write_bytes(lv->function()->name());
+    e.write_varint(it->second);
+  } else if (auto global = dyn_cast< GlobalMemoryLocation >(mem)) {
+    e.write_bytes(global->global_var()->name());
+  } else if (auto fun = dyn_cast< FunctionMemoryLocation >(mem)) {
+    e.write_bytes(fun->function()->name());
+    if (with_keys) {
+      // Calls through a pointer depend on the body of the function
+      std::string key = this->function_key(fun->function());
+      if (key.empty()) {
+        return false;
+      }
+      e.write_bytes(key);
+    }
+  } else if (auto aggregate = dyn_cast< AggregateMemoryLocation >(mem)) {
+    return this->write_internal_variable(e, aggregate->internal_var());
+  } else if (auto dyn_alloc = dyn_cast< DynAllocMemoryLocation >(mem)) {
+    return write_statement(e, dyn_alloc->call()) &&
+           this->write_call_context(e, dyn_alloc->context());
+  }
+  return true;
+}
+
+bool SummaryCache::write_call_context(core::serialization::Encoder& e,
+                                      CallContext* context) const {
+  std::vector< ar::CallBase* > calls;
+  for (; !context->empty(); context = context->parent()) {
+    calls.push_back(context->call());
+  }
+  e.write_varint(calls.size());
+  for (auto it = calls.rbegin(), et = calls.rend(); it != et; ++it) {
+    if (!write_statement(e, *it)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool SummaryCache::write_internal_variable(core::serialization::Encoder& e,
+                                           ar::InternalVariable* iv) const {
+  auto it = this->_positions.find(iv);
+  if (it == this->_positions.end()) {
+    return false;
+  }
+  ar::Code* code = iv->code();
+  e.write_bool(code->is_function_body());
+  e.write_bytes(code->is_function_body() ? code->function()->name()
+                                         : code->global_var()->name());
+  e.write_varint(it->second);
+  return true;
+}
+
+Variable* SummaryCache::read_variable(core::serialization::Decoder& d) const {
+  ar::Bundle* bundle = _ctx.bundle;
+  VariableFactory& vfac = *_ctx.var_factory;
+  core::serialization::NoResolver resolve;
+
+  switch (d.read_byte()) {
+    case Variable::LocalVariableKind: {
+      ar::Function* fun = bundle->function_or_null(read_string(d));
+      std::size_t position = d.read_varint();
+      ar::LocalVariable* lv =
+          (fun == nullptr) ? nullptr : this->local_variable(fun, position);
+      return (lv == nullptr) ? nullptr : vfac.get_local(lv);
+    }
+    case Variable::GlobalVariableKind: {
+      ar::GlobalVariable* gv = bundle->global_or_null(read_string(d));
+      return (gv == nullptr) ? nullptr : vfac.get_global(gv);
+    }
+    case Variable::InternalVariableKind: {
+      ar::InternalVariable* iv = this->read_internal_variable(d);
+      return (iv == nullptr) ? nullptr : vfac.get_internal(iv);
+    }
+    case Variable::FunctionPointerVariableKind: {
+      ar::Function* fun = bundle->function_or_null(read_string(d));
+      return (fun == nullptr) ? nullptr : vfac.get_function_ptr(fun);
+    }
+    case Variable::CellVariableKind: {
+      MemoryLocation* mem = this->read_memory_location(d);
+      if (mem == nullptr) {
+        return nullptr;
+      }
+      MachineInt offset =
+          core::serialization::Serializer< MachineInt >::read(d, resolve);
+      MachineInt size =
+          core::serialization::Serializer< MachineInt >::read(d, resolve);
+      Signedness sign = d.read_bool() ? Signed : Unsigned;
+      return vfac.get_cell(mem, offset, size, sign);
+    }
+    case Variable::OffsetVariableKind: {
+      Variable* pointer = this->read_variable(d);
+      return (pointer == nullptr) ? nullptr : pointer->offset_var();
+    }
+    case Variable::AllocSizeVariableKind: {
+      MemoryLocation* mem = this->read_memory_location(d);
+      return (mem == nullptr) ? nullptr : vfac.get_alloc_size(mem);
+    }
+    case Variable::ReturnVariableKind: {
+      ar::Function* fun = bundle->function_or_null(read_string(d));
+      return (fun == nullptr) ? nullptr : vfac.get_return(fun);
+    }
+    default: {
+      return nullptr;
+    }
+  }
+}
+
+MemoryLocation* SummaryCache::read_memory_location(
+    core::serialization::Decoder& d) const {
+  ar::Bundle* bundle = _ctx.bundle;
+  MemoryFactory& mfac = *_ctx.mem_factory;
+
+  switch (d.read_byte()) {
+    case MemoryLocation::LocalMemoryKind: {
+      ar::Function* fun = bundle->function_or_null(read_string(d));
+      std::size_t position = d.read_varint();
+      ar::LocalVariable* lv =
+          (fun == nullptr) ? nullptr : this->local_variable(fun, position);
+      return (lv == nullptr) ? nullptr : mfac.get_local(lv);
+    }
+    case MemoryLocation::GlobalMemoryKind: {
+      ar::GlobalVariable* gv = bundle->global_or_null(read_string(d));
+      return (gv == nullptr) ? nullptr : mfac.get_global(gv);
+    }
+    case MemoryLocation::FunctionMemoryKind: {
+      ar::Function* fun = bundle->function_or_null(read_string(d));
+      std::string key = read_string(d);
+      if (fun == nullptr || this->function_key(fun) != key) {
+        return nullptr;
+      }
+      return mfac.get_function(fun);
+    }
+    case MemoryLocation::AggregateMemoryKind: {
+      ar::InternalVariable* iv = this->read_internal_variable(d);
+      return (iv == nullptr) ? nullptr : mfac.get_aggregate(iv);
+    }
+    case MemoryLocation::AbsoluteZeroMemoryKind: {
+      return mfac.get_absolute_zero();
+    }
+    case MemoryLocation::ArgvMemoryKind: {
+      return mfac.get_argv();
+    }
+    case MemoryLocation::LibcErrnoMemoryKind: {
+      return mfac.get_libc_errno();
+    }
+    case MemoryLocation::DynAllocMemoryKind: {
+      auto call = dyn_cast_or_null< ar::CallBase >(read_statement(d, bundle));
+      CallContext* context = this->read_call_context(d);
+      if (call == nullptr || context == nullptr) {
+        return nullptr;
+      }
+      return mfac.get_dyn_alloc(call, context);
+    }
+    default: {
+      return nullptr;
+    }
+  }
+}
+
+CallContext* SummaryCache::read_call_context(
+    core::serialization::Decoder& d) const {
+  CallContext* context = _ctx.call_context_factory->get_empty();
+  for (std::uint64_t n = d.read_varint(); n > 0; n--) {
+    auto call =
+        dyn_cast_or_null< ar::CallBase >(read_statement(d, _ctx.bundle));
+    if (call == nullptr) {
+      return nullptr;
+    }
+    context = _ctx.call_context_factory->get_context(context, call);
+  }
+  return context;
+}
+
+ar::InternalVariable* SummaryCache::read_internal_variable(
+    core::serialization::Decoder& d) const {
+  bool is_function_body = d.read_bool();
+  std::string name = read_string(d);
+  std::size_t position = d.read_varint();
+
+  ar::Code* code = nullptr;
+  if (is_function_body) {
+    ar::Function* fun = _ctx.bundle->function_or_null(name);
+    if (fun != nullptr && fun->is_definition()) {
+      code = fun->body();
+    }
+  } else {
+    ar::GlobalVariable* gv = _ctx.bundle->global_or_null(name);
+    if (gv != nullptr && gv->is_definition()) {
+      code = gv->initializer();
+    }
+  }
+  if (code == nullptr) {
+    return nullptr;
+  }
+
+  auto begin = code->internal_variable_begin();
+  auto end = code->internal_variable_end();
+  if (position >= static_cast< std::size_t >(std::distance(begin, end))) {
+    return nullptr;
+  }
+  return *std::next(begin, static_cast< std::ptrdiff_t >(position));
+}
+
+ar::LocalVariable* SummaryCache::local_variable(ar::Function* fun,
+                                                std::size_t position) const {
+  auto begin = fun->local_variable_begin();
+  auto end = fun->local_variable_end();
+  if (position >= static_cast< std::size_t >(std::distance(begin, end))) {
+    return nullptr;
+  }
+  return *std::next(begin, static_cast< std::ptrdiff_t >(position));
+}
+
+} // end namespace value
+} // end namespace analyzer
+} // end namespace ikos
@@ -43,6 +43,8 @@
  *
  ******************************************************************************/
 
+#include <limits>
+
 #include <boost/thread/locks.hpp>
 
 #include <ikos/analyzer/analysis/variable.hpp>
@@ -54,7 +56,7 @@ namespace analyzer {
 // Variable
 
 Variable::Variable(VariableKind kind, ar::Type* type)
-    : _kind(kind), _type(type), _offset_var(nullptr) {
+    : _kind(kind), _index(0), _type(type), _offset_var(nullptr) {
   ikos_assert(this->_type != nullptr);
 }
 
@@ -197,119 +199,178 @@ void UnnamedShadowVariable::dump(std::ostream& o) const {
 
 VariableFactory::VariableFactory(ar::Bundle* bundle)
     : _ar_context(bundle->context()),
-      _size_type(ar::IntegerType::size_type(bundle)) {}
+      _size_type(ar::IntegerType::size_type(bundle)),
+      _next_index(0) {
+  // Create the variables of the bundle in a fixed order, so that most indexes
+  // do not depend on the scheduling of the analysis threads
+  for (auto it = bundle->global_begin(), et = bundle->global_end(); it != et;
+       ++it) {
+    ar::GlobalVariable* gv = *it;
+    this->get_global(gv);
+
+    if (gv->is_definition()) {
+      ar::Code* code = gv->initializer();
+      for (auto it2 = code->internal_variable_begin(),
+                et2 = code->internal_variable_end();
+           it2 != et2;
+           ++it2) {
+        this->get_internal(*it2);
+      }
+    }
+  }
+  for (auto it = bundle->function_begin(), et = bundle->function_end();
+       it != et;
+       ++it) {
+    ar::Function* fun = *it;
+    this->get_function_ptr(fun);
+
+    if (fun->is_definition()) {
+      for (auto it2 = fun->local_variable_begin(),
+                et2 = fun->local_variable_end();
+           it2 != et2;
+           ++it2) {
+        this->get_local(*it2);
+      }
+
+      ar::Code* code = fun->body();
+      for (auto it2 = code->internal_variable_begin(),
+                et2 = code->internal_variable_end();
+           it2 != et2;
+           ++it2) {
+        this->get_internal(*it2);
+      }
+    }
+  }
+
+  move_to_bundle_map(this->_local_variable_map,
+                     this->_bundle_local_variable_map);
+  move_to_bundle_map(this->_global_variable_map,
+                     this->_bundle_global_variable_map);
+  move_to_bundle_map(this->_internal_variable_map,
+                     this->_bundle_internal_variable_map);
+  move_to_bundle_map(this->_function_pointer_map,
+                     this->_bundle_function_pointer_map);
+}
+
+template < typename Map, typename BundleMap >
+void VariableFactory::move_to_bundle_map(Map& map, BundleMap& bundle_map) {
+  bundle_map.reserve(map.size());
+  for (auto& entry : map) {
+    bundle_map.try_emplace(entry.first, std::move(entry.second));
+  }
+  map.clear();
+}
 
 VariableFactory::~VariableFactory() = default;
 
-LocalVariable* VariableFactory::get_local(ar::LocalVariable* var) {
-  {
-    boost::shared_lock< boost::shared_mutex > lock(this->_local_variable_mutex);
-    auto it = this->_local_variable_map.find(var);
-    if (it != this->_local_variable_map.end()) {
-      return it->second.get();
-    }
+template < typename Map, typename Key, typename Create >
+typename Map::mapped_type::element_type* VariableFactory::insert(
+    Map& map, const Key& key, Create create) {
+  boost::lock_guard< boost::mutex > lock(this->_creation_mutex);
+
+  // Another thread might have created the variable in the meantime
+  auto it = map.find(key);
+  if (it != map.end()) {
+    return it->second.get();
   }
 
-  auto vn = std::make_unique< LocalVariable >(var);
-  vn->set_offset_var(
-      std::make_unique< OffsetVariable >(this->_size_type, vn.get()));
+  auto vn = create();
+  this->set_index(vn.get());
+  auto res = map.emplace(key, std::move(vn));
+  return res.first->second.get();
+}
 
-  {
-    boost::unique_lock< boost::shared_mutex > lock(this->_local_variable_mutex);
-    auto res = this->_local_variable_map.try_emplace(var, std::move(vn));
-    return res.first->second.get();
+LocalVariable* VariableFactory::get_local(ar::LocalVariable* var) {
+  auto bundle_it = this->_bundle_local_variable_map.find(var);
+  if (bundle_it != this->_bundle_local_variable_map.end()) {
+    return bundle_it->second.get();
   }
-}
 
-GlobalVariable* VariableFactory::get_global(ar::GlobalVariable* var) {
-  {
-    boost::shared_lock< boost::shared_mutex > lock(
-        this->_global_variable_mutex);
-    auto it = this->_global_variable_map.find(var);
-    if (it != this->_global_variable_map.end()) {
-      return it->second.get();
-    }
+  auto it = this->_local_variable_map.find(var);
+  if (it != this->_local_variable_map.end()) {
+    return it->second.get();
   }
 
-  auto vn = std::make_unique< GlobalVariable >(var);
-  vn->set_offset_var(
-      std::make_unique< OffsetVariable >(this->_size_type, vn.get()));
+  return this->insert(this->_local_variable_map, var, [&] {
+    auto vn = std::make_unique< LocalVariable >(var);
+    vn->set_offset_var(
+        std::make_unique< OffsetVariable >(this->_size_type, vn.get()));
+    return vn;
+  });
+}
 
-  {
-    boost::unique_lock< boost::shared_mutex > lock(
-        this->_global_variable_mutex);
-    auto res = this->_global_variable_map.try_emplace(var, std::move(vn));
-    return res.first->second.get();
+GlobalVariable* VariableFactory::get_global(ar::GlobalVariable* var) {
+  auto bundle_it = this->_bundle_global_variable_map.find(var);
+  if (bundle_it != this->_bundle_global_variable_map.end()) {
+    return bundle_it->second.get();
   }
-}
 
-InternalVariable* VariableFactory::get_internal(ar::InternalVariable* var) {
-  {
-    boost::shared_lock< boost::shared_mutex > lock(
-        this->_internal_variable_mutex);
-    auto it = this->_internal_variable_map.find(var);
-    if (it != this->_internal_variable_map.end()) {
-      return it->second.get();
-    }
+  auto it = this->_global_variable_map.find(var);
+  if (it != this->_global_variable_map.end()) {
+    return it->second.get();
   }
 
-  auto vn = std::make_unique< InternalVariable >(var);
-  if (vn->type()->is_pointer() || vn->type()->is_aggregate()) {
+  return this->insert(this->_global_variable_map, var, [&] {
+    auto vn = std::make_unique< GlobalVariable >(var);
     vn->set_offset_var(
         std::make_unique< OffsetVariable >(this->_size_type, vn.get()));
+    return vn;
+  });
+}
+
+InternalVariable* VariableFactory::get_internal(ar::InternalVariable* var) {
+  auto bundle_it = this->_bundle_internal_variable_map.find(var);
+  if (bundle_it != this->_bundle_internal_variable_map.end()) {
+    return bundle_it->second.get();
   }
 
-  {
-    boost::unique_lock< boost::shared_mutex > lock(
-        this->_internal_variable_mutex);
-    auto res = this->_internal_variable_map.try_emplace(var, std::move(vn));
-    return res.first->second.get();
+  auto it = this->_internal_variable_map.find(var);
+  if (it != this->_internal_variable_map.end()) {
+    return it->second.get();
   }
+
+  return this->insert(this->_internal_variable_map, var, [&] {
+    auto vn = std::make_unique< InternalVariable >(var);
+    if (vn->type()->is_pointer() || vn->type()->is_aggregate()) {
+      vn->set_offset_var(
+          std::make_unique< OffsetVariable >(this->_size_type, vn.get()));
+    }
+    return vn;
+  });
 }
 
 InlineAssemblyPointerVariable* VariableFactory::get_asm_ptr(
     ar::InlineAssemblyConstant* cst) {
-  {
-    boost::shared_lock< boost::shared_mutex > lock(
-        this->_inline_asm_pointer_mutex);
-    auto it = this->_inline_asm_pointer_map.find(cst);
-    if (it != this->_inline_asm_pointer_map.end()) {
-      return it->second.get();
-    }
+  auto it = this->_inline_asm_pointer_map.find(cst);
+  if (it != this->_inline_asm_pointer_map.end()) {
+    return it->second.get();
   }
 
-  auto vn = std::make_unique< InlineAssemblyPointerVariable >(cst);
-  vn->set_offset_var(
-      std::make_unique< OffsetVariable >(this->_size_type, vn.get()));
-
-  {
-    boost::unique_lock< boost::shared_mutex > lock(
-        this->_inline_asm_pointer_mutex);
-    auto res = this->_inline_asm_pointer_map.try_emplace(cst, std::move(vn));
-    return res.first->second.get();
-  }
+  return this->insert(this->_inline_asm_pointer_map, cst, [&] {
+    auto vn = std::make_unique< InlineAssemblyPointerVariable >(cst);
+    vn->set_offset_var(
+        std::make_unique< OffsetVariable >(this->_size_type, vn.get()));
+    return vn;
+  });
 }
 
 FunctionPointerVariable* VariableFactory::get_function_ptr(ar::Function* fun) {
-  {
-    boost::shared_lock< boost::shared_mutex > lock(
-        this->_function_pointer_mutex);
-    auto it = this->_function_pointer_map.find(fun);
-    if (it != this->_function_pointer_map.end()) {
-      return it->second.get();
-    }
+  auto bundle_it = this->_bundle_function_pointer_map.find(fun);
+  if (bundle_it != this->_bundle_function_pointer_map.end()) {
+    return bundle_it->second.get();
   }
 
-  auto vn = std::make_unique< FunctionPointerVariable >(fun);
-  vn->set_offset_var(
-      std::make_unique< OffsetVariable >(this->_size_type, vn.get()));
-
-  {
-    boost::unique_lock< boost::shared_mutex > lock(
-        this->_function_pointer_mutex);
-    auto res = this->_function_pointer_map.try_emplace(fun, std::move(vn));
-    return res.first->second.get();
+  auto it = this->_function_pointer_map.find(fun);
+  if (it != this->_function_pointer_map.end()) {
+    return it->second.get();
   }
+
+  return this->insert(this->_function_pointer_map, fun, [&] {
+    auto vn = std::make_unique< FunctionPointerVariable >(fun);
+    vn->set_offset_var(
+        std::make_unique< OffsetVariable >(this->_size_type, vn.get()));
+    return vn;
+  });
 }
 
 FunctionPointerVariable* VariableFactory::get_function_ptr(
@@ -323,22 +384,18 @@ CellVariable* VariableFactory::get_cell(MemoryLocation* address,
                                         Signedness sign) {
   auto key = std::make_tuple(address, offset, size);
 
-  {
-    boost::shared_lock< boost::shared_mutex > lock(this->_cell_mutex);
-    auto it = this->_cell_map.find(key);
-    if (it != this->_cell_map.end()) {
-      return it->second.get();
-    }
+  auto it = this->_cell_map.find(key);
+  if (it != this->_cell_map.end()) {
+    return it->second.get();
   }
 
-  {
+  // Note: IntegerType::get() is not thread safe, but it is only called while
+  // holding _creation_mutex
+  return this->insert(this->_cell_map, key, [&] {
     // Create a memory cell variable
     // A cell can be either an integer, a float or a pointer
     // The integer type should have the right bit-width and the given signedness
     // The parameter `size` is in bytes, compute bit-width = size * 8
-    //
-    // Note: IntegerType::get() is not thread safe, so lock the mutex here
-    boost::unique_lock< boost::shared_mutex > lock(this->_cell_mutex);
     bool overflow;
     MachineInt eight(8, size.bit_width(), Unsigned);
     MachineInt bit_width = mul(size, eight, overflow);
@@ -351,51 +408,35 @@ CellVariable* VariableFactory::get_cell(MemoryLocation* address,
     auto vn = std::make_unique< CellVariable >(type, address, offset, size);
     vn->set_offset_var(
         std::make_unique< OffsetVariable >(this->_size_type, vn.get()));
-    auto res = this->_cell_map.emplace(key, std::move(vn));
-    return res.first->second.get();
-  }
+    return vn;
+  });
 }
 
 AllocSizeVariable* VariableFactory::get_alloc_size(MemoryLocation* address) {
-  {
-    boost::shared_lock< boost::shared_mutex > lock(this->_alloc_size_mutex);
-    auto it = this->_alloc_size_map.find(address);
-    if (it != this->_alloc_size_map.end()) {
-      return it->second.get();
-    }
+  auto it = this->_alloc_size_map.find(address);
+  if (it != this->_alloc_size_map.end()) {
+    return it->second.get();
   }
 
-  auto vn = std::make_unique< AllocSizeVariable >(this->_size_type, address);
-
-  {
-    boost::unique_lock< boost::shared_mutex > lock(this->_alloc_size_mutex);
-    auto res = this->_alloc_size_map.try_emplace(address, std::move(vn));
-    return res.first->second.get();
-  }
+  return this->insert(this->_alloc_size_map, address, [&] {
+    return std::make_unique< AllocSizeVariable >(this->_size_type, address);
+  });
 }
 
 ReturnVariable* VariableFactory::get_return(ar::Function* fun) {
-  {
-    boost::shared_lock< boost::shared_mutex > lock(
-        this->_return_variable_mutex);
-    auto it = this->_return_variable_map.find(fun);
-    if (it != this->_return_variable_map.end()) {
-      return it->second.get();
-    }
+  auto it = this->_return_variable_map.find(fun);
+  if (it != this->_return_variable_map.end()) {
+    return it->second.get();
   }
 
-  auto vn = std::make_unique< ReturnVariable >(fun);
-  if (vn->type()->is_pointer() || vn->type()->is_aggregate()) {
-    vn->set_offset_var(
-        std::make_unique< OffsetVariable >(this->_size_type, vn.get()));
-  }
-
-  {
-    boost::unique_lock< boost::shared_mutex > lock(
-        this->_return_variable_mutex);
-    auto res = this->_return_variable_map.try_emplace(fun, std::move(vn));
-    return res.first->second.get();
-  }
+  return this->insert(this->_return_variable_map, fun, [&] {
+    auto vn = std::make_unique< ReturnVariable >(fun);
+    if (vn->type()->is_pointer() || vn->type()->is_aggregate()) {
+      vn->set_offset_var(
+          std::make_unique< OffsetVariable >(this->_size_type, vn.get()));
+    }
+    return vn;
+  });
 }
 
 NamedShadowVariable* VariableFactory::get_named_shadow(ar::Type* type,
@@ -420,6 +461,9 @@ NamedShadowVariable* VariableFactory::get_named_shadow(ar::Type* type,
         this->_named_shadow_variable_mutex);
     auto res =
         this->_named_shadow_variable_map.try_emplace(name, std::move(vn));
+    if (res.second) {
+      this->set_index(res.first->second.get());
+    }
     return res.first->second.get();
   }
 }
@@ -432,9 +476,39 @@ UnnamedShadowVariable* VariableFactory::create_unnamed_shadow(ar::Type* type) {
     vn->set_offset_var(
         std::make_unique< OffsetVariable >(this->_size_type, vn.get()));
   }
+  this->set_index(vn.get());
   this->_unnamed_shadow_variable_vec.emplace_back(std::move(vn));
   return this->_unnamed_shadow_variable_vec.back().get();
 }
 
+void VariableFactory::set_index(Variable* var) {
+  // Relaxed ordering is enough here, since the variable is published through
+  // the insertion in its map
+  std::uint32_t index =
+      this->_next_index.fetch_add(var->offset_var() != nullptr ? 2 : 1,
+                                  std::memory_order_relaxed);
+  if (index >= std::numeric_limits< std::uint32_t >::max() - 1) {
+    throw LogicError("variable factory: too many variables");
+  }
+
+  var->_index = index;
+  if (var->offset_var() != nullptr) {
+    var->offset_var()->_index = index + 1;
+  }
+
+  this->_index_map.grow_to_at_least(index + 2);
+  this->_index_map[index] = var;
+  if (var->offset_var() != nullptr) {
+    this->_index_map[index + 1] = var->offset_var();
+  }
+}
+
+Variable* VariableFactory::get_by_index(std::uint32_t index) const {
+  if (index >= this->_index_map.size()) {
+    return nullptr;
+  }
+  return this->_index_map[index];
+}
+
 } // end namespace analyzer
 } // end namespace ikos
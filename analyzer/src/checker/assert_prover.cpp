@@ -58,14 +58,19 @@ const char* AssertProverChecker::description() const {
   return "Assertion prover checker";
 }
 
+bool AssertProverChecker::handles(ar::Statement::StatementKind kind) const {
+  return kind == ar::Statement::CallKind;
+}
+
 void AssertProverChecker::check(ar::Statement* stmt,
                                 const value::AbstractDomain& inv,
+                                QueryCache& queries,
                                 CallContext* call_context) {
   if (auto call = dyn_cast< ar::IntrinsicCall >(stmt)) {
     ar::Function* fun = call->called_function();
 
     if (fun->intrinsic_id() == ar::Intrinsic::IkosAssert) {
-      CheckResult check = this->check_assert(call, inv);
+      CheckResult check = this->check_assert(call, queries);
       this->display_invariant(check.result, call, inv);
       this->_checks.insert(check.kind,
                            CheckerName::AssertProver,
@@ -78,7 +83,8 @@ void AssertProverChecker::check(ar::Statement* stmt,
 }
 
 AssertProverChecker::CheckResult AssertProverChecker::check_assert(
-    ar::IntrinsicCall* call, const value::AbstractDomain& inv) {
+    ar::IntrinsicCall* call, QueryCache& queries) {
+  const value::AbstractDomain& inv = queries.inv();
   if (inv.is_normal_flow_bottom()) {
     // Statement unreachable
     if (auto msg = this->display_assert_check(Result::Unreachable, call)) {
@@ -91,7 +97,7 @@ AssertProverChecker::CheckResult AssertProverChecker::check_assert(
 
   if (cond.is_undefined() ||
       (cond.is_machine_int_var() &&
-       inv.normal().uninit_is_uninitialized(cond.var()))) {
+       queries.uninit_is_uninitialized(cond.var()))) {
     // Undefined operand
     if (auto msg = this->display_assert_check(Result::Error, call)) {
       *msg << ": undefined operand\n";
@@ -103,7 +109,7 @@ AssertProverChecker::CheckResult AssertProverChecker::check_assert(
   if (cond.is_machine_int()) {
     flag = IntInterval(cond.machine_int());
   } else if (cond.is_machine_int_var()) {
-    flag = inv.normal().int_to_interval(cond.var());
+    flag = queries.int_to_interval(cond.var());
   } else {
     log::error("unexpected argument to __ikos_assert()");
     return {CheckKind::UnexpectedOperand, Result::Error};
@@ -69,8 +69,14 @@ const char* BufferOverflowChecker::description() const {
   return "Buffer overflow checker";
 }
 
+bool BufferOverflowChecker::handles(ar::Statement::StatementKind kind) const {
+  return kind == ar::Statement::LoadKind || kind == ar::Statement::StoreKind ||
+         kind == ar::Statement::CallKind || kind == ar::Statement::InvokeKind;
+}
+
 void BufferOverflowChecker::check(ar::Statement* stmt,
                                   const value::AbstractDomain& inv,
+                                  QueryCache& queries,
                                   CallContext* call_context) {
   if (auto load = dyn_cast< ar::Load >(stmt)) {
     CheckResult check =
@@ -78,7 +84,7 @@ void BufferOverflowChecker::check(ar::Statement* stmt,
                                load->operand(),
                                this->store_size(load->result()->type()),
                                /* if_null = */ Result::Error,
-                               inv);
+                               queries);
     this->display_invariant(check.result, stmt, inv);
     this->_checks.insert(check.kind,
                          CheckerName::BufferOverflow,
@@ -93,7 +99,7 @@ void BufferOverflowChecker::check(ar::Statement* stmt,
                                store->pointer(),
                                this->store_size(store->value()->type()),
                                /* if_null = */ Result::Error,
-                               inv);
+                               queries);
     this->display_invariant(check.result, stmt, inv);
     this->_checks.insert(check.kind,
                          CheckerName::BufferOverflow,
@@ -103,7 +109,7 @@ void BufferOverflowChecker::check(ar::Statement* stmt,
                          check.operands,
                          check.info);
   } else if (auto call = dyn_cast< ar::CallBase >(stmt)) {
-    std::vector< CheckResult > checks = this->check_call(call, inv);
+    std::vector< CheckResult > checks = this->check_call(call, queries);
     for (const auto& check : checks) {
       this->display_invariant(check.result, stmt, inv);
       this->_checks.insert(check.kind,
@@ -118,7 +124,8 @@ void BufferOverflowChecker::check(ar::Statement* stmt,
 }
 
 std::vector< BufferOverflowChecker::CheckResult > BufferOverflowChecker::
-    check_call(ar::CallBase* call, const value::AbstractDomain& inv) {
+    check_call(ar::CallBase* call, QueryCache& queries) {
+  const value::AbstractDomain& inv = queries.inv();
   if (inv.is_normal_flow_bottom()) {
     // Statement unreachable
     if (auto msg = this->display_mem_access_check(Result::Unreachable, call)) {
@@ -133,7 +140,7 @@ std::vector< BufferOverflowChecker::CheckResult > BufferOverflowChecker::
 
   if (called.is_undefined() ||
       (called.is_pointer_var() &&
-       inv.normal().uninit_is_uninitialized(called.var()))) {
+       queries.uninit_is_uninitialized(called.var()))) {
     // Undefined call pointer operand
     if (auto msg = this->display_mem_access_check(Result::Error, call)) {
       *msg << ": undefined call pointer operand\n";
@@ -147,7 +154,7 @@ std::vector< BufferOverflowChecker::CheckResult > BufferOverflowChecker::
   // Check null pointer dereference
 
   if (called.is_null() ||
-      (called.is_pointer_var() && inv.normal().nullity_is_null(called.var()))) {
+      (called.is_pointer_var() && queries.nullity_is_null(called.var()))) {
     // Null call pointer operand
     if (auto msg = this->display_mem_access_check(Result::Error, call)) {
       *msg << ": null call pointer operand\n";
@@ -175,7 +182,7 @@ std::vector< BufferOverflowChecker::CheckResult > BufferOverflowChecker::
     callees = {_ctx.mem_factory->get_local(lv)};
   } else if (isa< ar::InternalVariable >(call->called())) {
     // Indirect call through a function pointer
-    callees = inv.normal().pointer_to_points_to(called.var());
+    callees = queries.pointer_to_points_to(called.var());
   } else {
     log::error("unexpected call pointer operand");
     return {
@@ -221,7 +228,8 @@ std::vector< BufferOverflowChecker::CheckResult > BufferOverflowChecker::
     }
 
     if (callee->is_intrinsic()) {
-      for (const auto& check : this->check_intrinsic_call(call, callee, inv)) {
+      for (const auto& check :
+           this->check_intrinsic_call(call, callee, queries)) {
         checks.push_back(check);
       }
     }
@@ -233,7 +241,7 @@ std::vector< BufferOverflowChecker::CheckResult > BufferOverflowChecker::
 std::vector< BufferOverflowChecker::CheckResult > BufferOverflowChecker::
     check_intrinsic_call(ar::CallBase* call,
                          ar::Function* fun,
-                         const value::AbstractDomain& inv) {
+                         QueryCache& queries) {
   switch (fun->intrinsic_id()) {
     case ar::Intrinsic::MemoryCopy:
     case ar::Intrinsic::MemoryMove: {
@@ -241,28 +249,28 @@ std::vector< BufferOverflowChecker::CheckResult > BufferOverflowChecker::
                                      call->argument(1),
                                      call->argument(2),
                                      /* if_null = */ Result::Error,
-                                     inv),
+                                     queries),
               this->check_mem_access(call,
                                      call->argument(0),
                                      call->argument(2),
                                      /* if_null = */ Result::Error,
-                                     inv)};
+                                     queries)};
     }
     case ar::Intrinsic::MemorySet: {
       return {this->check_mem_access(call,
                                      call->argument(0),
                                      call->argument(2),
                                      /* if_null = */ Result::Error,
-                                     inv)};
+                                     queries)};
     }
     case ar::Intrinsic::VarArgStart:
     case ar::Intrinsic::VarArgEnd:
     case ar::Intrinsic::VarArgGet: {
-      return {this->check_va_list_access(call, call->argument(0), inv)};
+      return {this->check_va_list_access(call, call->argument(0), queries)};
     }
     case ar::Intrinsic::VarArgCopy: {
-      return {this->check_va_list_access(call, call->argument(0), inv),
-              this->check_va_list_access(call, call->argument(1), inv)};
+      return {this->check_va_list_access(call, call->argument(0), queries),
+              this->check_va_list_access(call, call->argument(1), queries)};
     }
     case ar::Intrinsic::StackSave:
     case ar::Intrinsic::StackRestore:
@@ -285,13 +293,13 @@ std::vector< BufferOverflowChecker::CheckResult > BufferOverflowChecker::
                                      call->argument(0),
                                      call->argument(1),
                                      /* if_null = */ Result::Error,
-                                     inv)};
+                                     queries)};
     }
     case ar::Intrinsic::IkosCheckStringAccess: {
       return {this->check_string_access(call,
                                         call->argument(0),
                                         /* if_null = */ Result::Error,
-                                        inv)};
+                                        queries)};
     }
     case ar::Intrinsic::IkosAssumeMemSize: {
       return {};
@@ -302,7 +310,7 @@ std::vector< BufferOverflowChecker::CheckResult > BufferOverflowChecker::
                                      call->argument(0),
                                      call->argument(1),
                                      /* if_null = */ Result::Error,
-                                     inv)};
+                                     queries)};
     }
     case ar::Intrinsic::IkosWatchMemory:
     case ar::Intrinsic::IkosPartitioningVar:
@@ -320,7 +328,7 @@ std::vector< BufferOverflowChecker::CheckResult > BufferOverflowChecker::
       return {};
     }
     case ar::Intrinsic::LibcRealloc: {
-      return {this->check_realloc(call, call->argument(0), inv)};
+      return {this->check_realloc(call, call->argument(0), queries)};
     }
     case ar::Intrinsic::LibcFree:
     case ar::Intrinsic::LibcAbs:
@@ -339,7 +347,7 @@ std::vector< BufferOverflowChecker::CheckResult > BufferOverflowChecker::
       return {this->check_string_access(call,
                                         call->argument(0),
                                         /* if_null = */ Result::Error,
-                                        inv)};
+                                        queries)};
     }
     // <unistd.h>
     case ar::Intrinsic::LibcClose: {
@@ -350,14 +358,14 @@ std::vector< BufferOverflowChecker::CheckResult > BufferOverflowChecker::
                                      call->argument(1),
                                      call->argument(2),
                                      /* if_null = */ Result::Error,
-                                     inv)};
+                                     queries)};
     }
     case ar::Intrinsic::LibcWrite: {
       return {this->check_mem_access(call,
                                      call->argument(1),
                                      call->argument(2),
                                      /* if_null = */ Result::Error,
-                                     inv)};
+                                     queries)};
     }
     // <stdio.h>
     case ar::Intrinsic::LibcGets: {
@@ -371,18 +379,18 @@ std::vector< BufferOverflowChecker::CheckResult > BufferOverflowChecker::
                                      call->argument(0),
                                      call->argument(1),
                                      /* if_null = */ Result::Error,
-                                     inv),
+                                     queries),
               this->check_file_access(call,
                                       call->argument(2),
                                       /* if_null = */ Result::Error,
-                                      inv)};
+                                      queries)};
     }
     case ar::Intrinsic::LibcGetc:
     case ar::Intrinsic::LibcFgetc: {
       return {this->check_file_access(call,
                                       call->argument(0),
                                       /* if_null = */ Result::Error,
-                                      inv)};
+                                      queries)};
     }
     case ar::Intrinsic::LibcGetchar: {
       return {};
@@ -391,31 +399,31 @@ std::vector< BufferOverflowChecker::CheckResult > BufferOverflowChecker::
       return {this->check_string_access(call,
                                         call->argument(0),
                                         /* if_null = */ Result::Error,
-                                        inv)};
+                                        queries)};
     }
     case ar::Intrinsic::LibcFputs: {
       return {this->check_string_access(call,
                                         call->argument(0),
                                         /* if_null = */ Result::Error,
-                                        inv),
+                                        queries),
               this->check_file_access(call,
                                       call->argument(1),
                                       /* if_null = */ Result::Error,
-                                      inv)};
+                                      queries)};
     }
     case ar::Intrinsic::LibcPutc:
     case ar::Intrinsic::LibcFputc: {
       return {this->check_file_access(call,
                                       call->argument(1),
                                       /* if_null = */ Result::Error,
-                                      inv)};
+                                      queries)};
     }
     case ar::Intrinsic::LibcPrintf: {
       std::vector< CheckResult > checks = {
           this->check_string_access(call,
                                     call->argument(0),
                                     /* if_null = */ Result::Error,
-                                    inv)};
+                                    queries)};
       for (auto it = call->arg_begin() + 1, et = call->arg_end(); it != et;
            ++it) {
         ar::Value* arg = *it;
@@ -423,7 +431,7 @@ std::vector< BufferOverflowChecker::CheckResult > BufferOverflowChecker::
           checks.push_back(this->check_string_access(call,
                                                      arg,
                                                      /* if_null = */ Result::Ok,
-                                                     inv));
+                                                     queries));
         }
       }
       return checks;
@@ -433,11 +441,11 @@ std::vector< BufferOverflowChecker::CheckResult > BufferOverflowChecker::
           {this->check_file_access(call,
                                    call->argument(0),
                                    /* if_null = */ Result::Error,
-                                   inv),
+                                   queries),
            this->check_string_access(call,
                                      call->argument(1),
                                      /* if_null = */ Result::Error,
-                                     inv)};
+                                     queries)};
       for (auto it = call->arg_begin() + 2, et = call->arg_end(); it != et;
            ++it) {
         ar::Value* arg = *it;
@@ -445,7 +453,7 @@ std::vector< BufferOverflowChecker::CheckResult > BufferOverflowChecker::
           checks.push_back(this->check_string_access(call,
                                                      arg,
                                                      /* if_null = */ Result::Ok,
-                                                     inv));
+                                                     queries));
         }
       }
       return checks;
@@ -455,11 +463,11 @@ std::vector< BufferOverflowChecker::CheckResult > BufferOverflowChecker::
           {this->check_string_access(call,
                                      call->argument(0),
                                      /* if_null = */ Result::Error,
-                                     inv),
+                                     queries),
            this->check_string_access(call,
                                      call->argument(1),
                                      /* if_null = */ Result::Error,
-                                     inv)};
+                                     queries)};
       for (auto it = call->arg_begin() + 2, et = call->arg_end(); it != et;
            ++it) {
         ar::Value* arg = *it;
@@ -467,7 +475,7 @@ std::vector< BufferOverflowChecker::CheckResult > BufferOverflowChecker::
           checks.push_back(this->check_string_access(call,
                                                      arg,
                                                      /* if_null = */ Result::Ok,
-                                                     inv));
+                                                     queries));
         }
       }
       return checks;
@@ -484,13 +492,13 @@ std::vector< BufferOverflowChecker::CheckResult > BufferOverflowChecker::
                                                 call->argument(0),
                                                 call->argument(1),
                                                 /* if_null = */ Result::Error,
-                                                inv));
+                                                queries));
       }
 
       checks.push_back(this->check_string_access(call,
                                                  call->argument(2),
                                                  /* if_null = */ Result::Error,
-                                                 inv));
+                                                 queries));
 
       for (auto it = call->arg_begin() + 3, et = call->arg_end(); it != et;
            ++it) {
@@ -499,7 +507,7 @@ std::vector< BufferOverflowChecker::CheckResult > BufferOverflowChecker::
           checks.push_back(this->check_string_access(call,
                                                      arg,
                                                      /* if_null = */ Result::Ok,
-                                                     inv));
+                                                     queries));
         }
       }
       return checks;
@@ -509,7 +517,7 @@ std::vector< BufferOverflowChecker::CheckResult > BufferOverflowChecker::
           this->check_string_access(call,
                                     call->argument(0),
                                     /* if_null = */ Result::Error,
-                                    inv)};
+                                    queries)};
       for (auto it = call->arg_begin() + 1, et = call->arg_end(); it != et;
            ++it) {
         ar::Value* arg = *it;
@@ -518,7 +526,7 @@ std::vector< BufferOverflowChecker::CheckResult > BufferOverflowChecker::
             this->check_string_access(call,
                                       arg,
                                       /* if_null = */ Result::Error,
-                                      inv));
+                                      queries));
       }
       return checks;
     }
@@ -527,11 +535,11 @@ std::vector< BufferOverflowChecker::CheckResult > BufferOverflowChecker::
           this->check_file_access(call,
                                   call->argument(0),
                                   /* if_null = */ Result::Error,
-                                  inv),
+                                  queries),
           this->check_string_access(call,
                                     call->argument(1),
                                     /* if_null = */ Result::Error,
-                                    inv),
+                                    queries),
       };
       for (auto it = call->arg_begin() + 2, et = call->arg_end(); it != et;
            ++it) {
@@ -541,7 +549,7 @@ std::vector< BufferOverflowChecker::CheckResult > BufferOverflowChecker::
             this->check_string_access(call,
                                       arg,
                                       /* if_null = */ Result::Error,
-                                      inv));
+                                      queries));
       }
       return checks;
     }
@@ -550,11 +558,11 @@ std::vector< BufferOverflowChecker::CheckResult > BufferOverflowChecker::
           this->check_string_access(call,
                                     call->argument(0),
                                     /* if_null = */ Result::Error,
-                                    inv),
+                                    queries),
           this->check_string_access(call,
                                     call->argument(1),
                                     /* if_null = */ Result::Error,
-                                    inv),
+                                    queries),
       };
       for (auto it = call->arg_begin() + 2, et = call->arg_end(); it != et;
            ++it) {
@@ -564,7 +572,7 @@ std::vector< BufferOverflowChecker::CheckResult > BufferOverflowChecker::
             this->check_string_access(call,
                                       arg,
                                       /* if_null = */ Result::Error,
-                                      inv));
+                                      queries));
       }
       return checks;
     }
@@ -572,86 +580,86 @@ std::vector< BufferOverflowChecker::CheckResult > BufferOverflowChecker::
       return {this->check_string_access(call,
                                         call->argument(0),
                                         /* if_null = */ Result::Error,
-                                        inv),
+                                        queries),
               this->check_string_access(call,
                                         call->argument(1),
                                         /* if_null = */ Result::Error,
-                                        inv)};
+                                        queries)};
     }
     case ar::Intrinsic::LibcFclose:
     case ar::Intrinsic::LibcFflush: {
       return {this->check_file_access(call,
                                       call->argument(0),
                                       /* if_null = */ Result::Error,
-                                      inv)};
+                                      queries)};
     }
     // <string.h>
     case ar::Intrinsic::LibcStrlen: {
       return {this->check_string_access(call,
                                         call->argument(0),
                                         /* if_null = */ Result::Error,
-                                        inv)};
+                                        queries)};
     }
     case ar::Intrinsic::LibcStrnlen: {
       return {this->check_mem_access(call,
                                      call->argument(0),
                                      call->argument(1),
                                      /* if_null = */ Result::Error,
-                                     inv)};
+                                     queries)};
     }
     case ar::Intrinsic::LibcStrcpy: {
       return {this->check_string_access(call,
                                         call->argument(0),
                                         /* if_null = */ Result::Error,
-                                        inv),
+                                        queries),
               this->check_string_access(call,
                                         call->argument(1),
                                         /* if_null = */ Result::Error,
-                                        inv)};
+                                        queries)};
     }
     case ar::Intrinsic::LibcStrncpy: {
       return {this->check_string_access(call,
                                         call->argument(0),
                                         /* if_null = */ Result::Error,
-                                        inv),
+                                        queries),
               this->check_string_access(call,
                                         call->argument(1),
                                         /* max_access_size = */
                                         call->argument(2),
                                         /* if_null = */ Result::Error,
-                                        inv)};
+                                        queries)};
     }
     case ar::Intrinsic::LibcStrcat: {
       return {this->check_string_access(call,
                                         call->argument(0),
                                         /* if_null = */ Result::Error,
-                                        inv),
+                                        queries),
               this->check_string_access(call,
                                         call->argument(1),
                                         /* if_null = */ Result::Error,
-                                        inv)};
+                                        queries)};
     }
     case ar::Intrinsic::LibcStrncat: {
       return {this->check_string_access(call,
                                         call->argument(0),
                                         /* if_null = */ Result::Error,
-                                        inv),
+                                        queries),
               this->check_string_access(call,
                                         call->argument(1),
                                         /* max_access_size = */
                                         call->argument(2),
                                         /* if_null = */ Result::Error,
-                                        inv)};
+                                        queries)};
     }
     case ar::Intrinsic::LibcStrcmp: {
       return {this->check_string_access(call,
                                         call->argument(0),
                                         /* if_null = */ Result::Error,
-                                        inv),
+                                        queries),
               this->check_string_access(call,
                                         call->argument(1),
                                         /* if_null = */ Result::Error,
-                                        inv)};
+                                        queries)};
     }
     case ar::Intrinsic::LibcStrncmp: {
       return {this->check_string_access(call,
@@ -659,54 +667,54 @@ std::vector< BufferOverflowChecker::CheckResult > BufferOverflowChecker::
                                         /* max_access_size = */
                                         call->argument(2),
                                         /* if_null = */ Result::Error,
-                                        inv),
+                                        queries),
               this->check_string_access(call,
                                         call->argument(1),
                                         /* max_access_size = */
                                         call->argument(2),
                                         /* if_null = */ Result::Error,
-                                        inv)};
+                                        queries)};
     }
     case ar::Intrinsic::LibcStrstr: {
       return {this->check_string_access(call,
                                         call->argument(0),
                                         /* if_null = */ Result::Error,
-                                        inv),
+                                        queries),
               this->check_string_access(call,
                                         call->argument(1),
                                         /* if_null = */ Result::Error,
-                                        inv)};
+                                        queries)};
     }
     case ar::Intrinsic::LibcStrchr: {
       return {this->check_string_access(call,
                                         call->argument(0),
                                         /* if_null = */ Result::Error,
-                                        inv)};
+                                        queries)};
     }
     case ar::Intrinsic::LibcStrdup: {
       return {this->check_string_access(call,
                                         call->argument(0),
                                         /* if_null = */ Result::Error,
-                                        inv)};
+                                        queries)};
     }
     case ar::Intrinsic::LibcStrndup: {
       return {this->check_mem_access(call,
                                      call->argument(0),
                                      call->argument(1),
                                      /* if_null = */ Result::Error,
-                                     inv)};
+                                     queries)};
     }
     case ar::Intrinsic::LibcStrcpyCheck: {
       return {this->check_mem_access(call,
                                      call->argument(0),
                                      call->argument(2),
                                      /* if_null = */ Result::Error,
-                                     inv),
+                                     queries),
               this->check_mem_access(call,
                                      call->argument(1),
                                      call->argument(2),
                                      /* if_null = */ Result::Error,
-                                     inv)};
+                                     queries)};
     }
     case ar::Intrinsic::LibcMemoryCopyCheck:
     case ar::Intrinsic::LibcMemoryMoveCheck: {
@@ -714,29 +722,29 @@ std::vector< BufferOverflowChecker::CheckResult > BufferOverflowChecker::
                                      call->argument(1),
                                      call->argument(2),
                                      /* if_null = */ Result::Error,
-                                     inv),
+                                     queries),
               this->check_mem_access(call,
                                      call->argument(0),
                                      call->argument(2),
                                      /* if_null = */ Result::Error,
-                                     inv)};
+                                     queries)};
     }
     case ar::Intrinsic::LibcMemorySetCheck: {
       return {this->check_mem_access(call,
                                      call->argument(0),
                                      call->argument(2),
                                      /* if_null = */ Result::Error,
-                                     inv)};
+                                     queries)};
     }
     case ar::Intrinsic::LibcStrcatCheck: {
       return {this->check_string_access(call,
                                         call->argument(0),
                                         /* if_null = */ Result::Error,
-                                        inv),
+                                        queries),
               this->check_string_access(call,
                                         call->argument(1),
                                         /* if_null = */ Result::Error,
-                                        inv)};
+                                        queries)};
     }
     case ar::Intrinsic::LibcppNew:
     case ar::Intrinsic::LibcppNewArray:
@@ -760,8 +768,8 @@ BufferOverflowChecker::CheckResult BufferOverflowChecker::check_mem_access(
     ar::Value* pointer,
     ar::Value* access_size,
     Result if_null,
-    value::AbstractDomain inv) {
-  if (inv.is_normal_flow_bottom()) {
+    QueryCache& queries) {
+  if (queries.inv().is_normal_flow_bottom()) {
     // Statement unreachable
     if (auto msg = this->display_mem_access_check(Result::Unreachable,
                                                   stmt,
@@ -777,8 +785,8 @@ BufferOverflowChecker::CheckResult BufferOverflowChecker::check_mem_access(
 
   // Check uninitialized
 
-  if (ptr.is_undefined() || (ptr.is_pointer_var() &&
-                             inv.normal().uninit_is_uninitialized(ptr.var()))) {
+  if (ptr.is_undefined() ||
+      (ptr.is_pointer_var() && queries.uninit_is_uninitialized(ptr.var()))) {
     // Undefined pointer operand
     if (auto msg = this->display_mem_access_check(Result::Error,
                                                   stmt,
@@ -791,7 +799,7 @@ BufferOverflowChecker::CheckResult BufferOverflowChecker::check_mem_access(
 
   if (size.is_undefined() ||
       (size.is_machine_int_var() &&
-       inv.normal().uninit_is_uninitialized(size.var()))) {
+       queries.uninit_is_uninitialized(size.var()))) {
     // Undefined size operand
     if (auto msg = this->display_mem_access_check(Result::Error,
                                                   stmt,
@@ -805,7 +813,7 @@ BufferOverflowChecker::CheckResult BufferOverflowChecker::check_mem_access(
   // Check null pointer dereference
 
   if (ptr.is_null() ||
-      (ptr.is_pointer_var() && inv.normal().nullity_is_null(ptr.var()))) {
+      (ptr.is_pointer_var() && queries.nullity_is_null(ptr.var()))) {
     // Null pointer operand
     if (auto msg = this->display_mem_access_check(if_null,
                                                   stmt,
@@ -826,11 +834,17 @@ BufferOverflowChecker::CheckResult BufferOverflowChecker::check_mem_access(
     return {CheckKind::UnexpectedOperand, Result::Error, {access_size}, {}};
   }
 
-  // Initialize global variable pointer and function pointer
-  this->init_global_ptr(inv, pointer);
-
   // Points-to set of the pointer
-  PointsToSet addrs = inv.normal().pointer_to_points_to(ptr.var());
+  PointsToSet addrs = PointsToSet::bottom();
+  IntInterval offset_intv = IntInterval::bottom(1, Signed);
+  if (MemoryLocation* addr = this->global_ptr_address(pointer)) {
+    // Global variable pointer or function pointer
+    addrs = PointsToSet{addr};
+    offset_intv = IntInterval(MachineInt::zero(this->_size_type->bit_width(),
+                                               this->_size_type->sign()));
+  } else {
+    addrs = queries.pointer_to_points_to(ptr.var());
+  }
 
   if (addrs.is_empty()) {
     // Pointer is invalid
@@ -855,12 +869,14 @@ BufferOverflowChecker::CheckResult BufferOverflowChecker::check_mem_access(
   JsonDict info;
   JsonList points_to_info;
 
-  IntInterval offset_intv = inv.normal().pointer_offset_to_interval(ptr.var());
+  if (offset_intv.is_bottom()) {
+    offset_intv = queries.pointer_offset_to_interval(ptr.var());
+  }
   info.put("offset", to_json(offset_intv));
 
   auto size_intv = IntInterval::bottom(1, Signed);
   if (size.is_machine_int_var()) {
-    size_intv = inv.normal().int_to_interval(size.var());
+    size_intv = queries.int_to_interval(size.var());
   } else if (size.is_machine_int()) {
     size_intv = IntInterval(size.machine_int());
   } else {
@@ -870,53 +886,33 @@ BufferOverflowChecker::CheckResult BufferOverflowChecker::check_mem_access(
 
   // Variable representing the pointer offset
   Variable* offset_var = ptr.var()->offset_var();
-  inv.normal().pointer_offset_to_int(offset_var, ptr.var());
 
-  // Add a shadow variable `offset_plus_size = offset + access_size`
+  // Shadow variable `offset_plus_size = offset + access_size`
   Variable* offset_plus_size =
       _ctx.var_factory->get_named_shadow(this->_size_type,
                                          "shadow.offset_plus_size");
 
-  if (access_size->type() == this->_size_type) {
-    if (size.is_machine_int_var()) {
-      inv.normal().int_apply(IntBinaryOperator::Add,
-                             offset_plus_size,
-                             offset_var,
-                             size.var());
-    } else if (size.is_machine_int()) {
-      inv.normal().int_apply(IntBinaryOperator::Add,
-                             offset_plus_size,
-                             offset_var,
-                             size.machine_int());
-    } else {
-      ikos_unreachable("unexpected access size");
-    }
-  } else {
-    // This happens in LibcFgets for instance
-    if (size.is_machine_int_var()) {
-      inv.normal().int_apply(IntUnaryOperator::Cast,
-                             offset_plus_size,
-                             size.var());
-      inv.normal().int_apply(IntBinaryOperator::Add,
-                             offset_plus_size,
-                             offset_plus_size,
-                             offset_var);
-    } else if (size.is_machine_int()) {
-      inv.normal()
-          .int_apply(IntBinaryOperator::Add,
-                     offset_plus_size,
-                     offset_var,
-                     size.machine_int().cast(this->_size_type->bit_width(),
-                                             ar::Unsigned));
-    } else {
-      ikos_unreachable("unexpected access size");
-    }
-  }
-
-  inv.normal().normalize();
+  // Copy of the invariant with the pointer offset and the shadow variable.
+  //
+  // Most accesses are proven safe with intervals, so the copy is only
+  // created when a memory location requires a relational check.
+  boost::optional< value::AbstractDomain > refined;
+  auto refined_inv = [&]() -> value::AbstractDomain& {
+    if (!refined) {
+      refined = queries.inv();
+      this->init_global_ptr(*refined, pointer);
+      this->add_offset_plus_size(*refined,
+                                 ptr,
+                                 size,
+                                 access_size,
+                                 offset_var,
+                                 offset_plus_size);
+    }
+    return *refined;
+  };
 
   if (auto element_size =
-          this->is_array_access(stmt, inv, offset_intv, addrs)) {
+          this->is_array_access(stmt, queries.inv(), offset_intv, addrs)) {
     info.put("array_element_size", *element_size);
   }
 
@@ -926,22 +922,22 @@ BufferOverflowChecker::CheckResult BufferOverflowChecker::check_mem_access(
 
   for (auto addr : addrs) {
     AllocSizeVariable* size_var = _ctx.var_factory->get_alloc_size(addr);
-    this->init_global_alloc_size(inv, addr, size_var);
 
     // Add block info
-    JsonDict block_info = {
-        {"id", _ctx.output_db->memory_locations.insert(addr)}};
+    JsonDict block_info = {{"id", this->memory_location_id(addr)}};
 
     // Perform analysis
     auto check = this->check_memory_location_access(stmt,
                                                     pointer,
                                                     access_size,
-                                                    inv,
+                                                    queries,
+                                                    refined_inv,
                                                     addr,
                                                     size_var,
                                                     offset_var,
                                                     offset_plus_size,
                                                     offset_intv,
+                                                    size_intv,
                                                     block_info);
 
     block_info.put("status", static_cast< int >(check.result));
@@ -980,12 +976,15 @@ BufferOverflowChecker::MemoryLocationCheckResult BufferOverflowChecker::
     check_memory_location_access(ar::Statement* stmt,
                                  ar::Value* pointer,
                                  ar::Value* access_size,
-                                 const value::AbstractDomain& inv,
+                                 QueryCache& queries,
+                                 llvm::function_ref< value::AbstractDomain&() >
+                                     refined_inv,
                                  MemoryLocation* addr,
                                  AllocSizeVariable* size_var,
                                  Variable* offset_var,
                                  Variable* offset_plus_size,
                                  const IntInterval& offset_intv,
+                                 const IntInterval& access_size_intv,
                                  JsonDict& block_info) {
   if (isa< FunctionMemoryLocation >(addr)) {
     // Try to dereference a function pointer, this is an error
@@ -1003,7 +1002,7 @@ BufferOverflowChecker::MemoryLocationCheckResult BufferOverflowChecker::
     // Dynamic allocated memory location
     // Check for use after free
 
-    auto lifetime = inv.normal().lifetime_to_lifetime(addr);
+    auto lifetime = queries.inv().normal().lifetime_to_lifetime(addr);
 
     if (lifetime.is_deallocated()) {
       // Use after free
@@ -1034,7 +1033,7 @@ BufferOverflowChecker::MemoryLocationCheckResult BufferOverflowChecker::
     // Stack memory location
     // Check for dangling stack pointer
 
-    auto lifetime = inv.normal().lifetime_to_lifetime(addr);
+    auto lifetime = queries.inv().normal().lifetime_to_lifetime(addr);
 
     if (lifetime.is_deallocated()) {
       // Access to a dangling stack pointer
@@ -1064,6 +1063,8 @@ BufferOverflowChecker::MemoryLocationCheckResult BufferOverflowChecker::
   if (isa< AbsoluteZeroMemoryLocation >(addr)) {
     // Checks: hardware addresses
 
+    value::AbstractDomain& inv = refined_inv();
+
     // Compute the writable interval for offset o ([o, o + access_size])
     auto offset_plus_size_intv = inv.normal().int_to_interval(offset_plus_size);
     auto one = IntInterval(MachineInt(1, offset_intv.bit_width(), Unsigned));
@@ -1121,6 +1122,31 @@ BufferOverflowChecker::MemoryLocationCheckResult BufferOverflowChecker::
     }
   }
 
+  if (this->is_in_bounds(queries,
+                         addr,
+                         size_var,
+                         offset_intv,
+                         access_size_intv,
+                         block_info)) {
+    // offset_var <= size_var and offset_plus_size <= size_var, so we're
+    // safe here
+    if (auto msg = this->display_mem_access_check(Result::Ok,
+                                                  stmt,
+                                                  pointer,
+                                                  access_size,
+                                                  addr)) {
+      *msg << ": ∀o ∈ offset, o <= ";
+      access_size->dump(msg->stream());
+      *msg << " && o + access_size <= ";
+      access_size->dump(msg->stream());
+      *msg << "\n";
+    }
+    return {BufferOverflowCheckKind::OutOfBound, Result::Ok};
+  }
+
+  value::AbstractDomain& inv = refined_inv();
+  this->init_global_alloc_size(inv, addr, size_var);
+
   // add `size` (min, max) to block_info
   IntInterval size_intv = inv.normal().int_to_interval(size_var);
   block_info.put("size", to_json(size_intv));
@@ -1202,7 +1228,7 @@ BufferOverflowChecker::CheckResult BufferOverflowChecker::check_string_access(
     ar::Statement* stmt,
     ar::Value* pointer,
     Result if_null,
-    const value::AbstractDomain& inv) {
+    QueryCache& queries) {
   /// Notes:
   ///
   /// Since we do not keep track of null-terminated string lengths, we cannot
@@ -1213,7 +1239,11 @@ BufferOverflowChecker::CheckResult BufferOverflowChecker::check_string_access(
   /// well-formed.
   ///
   /// TODO(marthaud): Improve checks for strings.
-  return this->check_mem_access(stmt, pointer, this->_size_one, if_null, inv);
+  return this->check_mem_access(stmt,
+                                pointer,
+                                this->_size_one,
+                                if_null,
+                                queries);
 }
 
 BufferOverflowChecker::CheckResult BufferOverflowChecker::check_string_access(
@@ -1221,7 +1251,7 @@ BufferOverflowChecker::CheckResult BufferOverflowChecker::check_string_access(
     ar::Value* pointer,
     ar::Value* max_access_size,
     Result if_null,
-    const value::AbstractDomain& inv) {
+    QueryCache& queries) {
   /// Notes:
   ///
   /// Since we do not keep track of null-terminated string lengths, we cannot
@@ -1233,11 +1263,15 @@ BufferOverflowChecker::CheckResult BufferOverflowChecker::check_string_access(
   ///
   /// TODO(marthaud): Improve checks for strings.
   ikos_ignore(max_access_size);
-  return this->check_mem_access(stmt, pointer, this->_size_one, if_null, inv);
+  return this->check_mem_access(stmt,
+                                pointer,
+                                this->_size_one,
+                                if_null,
+                                queries);
 }
 
 BufferOverflowChecker::CheckResult BufferOverflowChecker::check_va_list_access(
-    ar::Statement* stmt, ar::Value* pointer, const value::AbstractDomain& inv) {
+    ar::Statement* stmt, ar::Value* pointer, QueryCache& queries) {
   /// Notes:
   ///
   /// Since we do not have the size of `va_list`, we cannot prove if a `va_list`
@@ -1249,11 +1283,11 @@ BufferOverflowChecker::CheckResult BufferOverflowChecker::check_va_list_access(
                                 pointer,
                                 this->_size_zero,
                                 /* if_null = */ Result::Error,
-                                inv);
+                                queries);
 }
 
 BufferOverflowChecker::CheckResult BufferOverflowChecker::check_realloc(
-    ar::CallBase* call, ar::Value* pointer, const value::AbstractDomain& inv) {
+    ar::CallBase* call, ar::Value* pointer, QueryCache& queries) {
   /// Notes:
   ///
   /// Since `realloc` knows the size of the allocated memory block, we use zero
@@ -1267,24 +1301,30 @@ BufferOverflowChecker::CheckResult BufferOverflowChecker::check_realloc(
                                 pointer,
                                 this->_size_zero,
                                 /* if_null = */ Result::Ok,
-                                inv);
+                                queries);
 }
 
 BufferOverflowChecker::CheckResult BufferOverflowChecker::check_file_access(
     ar::Statement* stmt,
     ar::Value* pointer,
     Result if_null,
-    const value::AbstractDomain& inv) {
+    QueryCache& queries) {
   /// Notes:
   ///
   /// Since we do not have the size of `FILE*`, we cannot prove if a `FILE*`
   /// is safe. Thus, we use zero for the access size.
   ///
   /// ASSUMPTION: accesses of `FILE*` by libc functions are memory safe.
-  return this->check_mem_access(stmt, pointer, this->_size_zero, if_null, inv);
+  return this->check_mem_access(stmt,
+                                pointer,
+                                this->_size_zero,
+                                if_null,
+                                queries);
 }
 
 ar::IntegerConstant* BufferOverflowChecker::store_size(ar::Type* type) const {
+  // Note: IntegerConstant::get() is not thread safe, so lock the mutex here
+  std::lock_guard< std::mutex > lock(this->_ctx.ar_context_mutex);
   return ar::IntegerConstant::get(this->_ar_context,
                                   this->_size_type,
                                   MachineInt(this->_data_layout
@@ -1293,6 +1333,99 @@ ar::IntegerConstant* BufferOverflowChecker::store_size(ar::Type* type) const {
                                              this->_size_type->sign()));
 }
 
+bool BufferOverflowChecker::is_in_bounds(QueryCache& queries,
+                                         MemoryLocation* addr,
+                                         AllocSizeVariable* size_var,
+                                         const IntInterval& offset_intv,
+                                         const IntInterval& access_size_intv,
+                                         JsonDict& block_info) const {
+  IntInterval size_intv = IntInterval::bottom(1, Signed);
+  if (auto size = this->global_alloc_size(addr)) {
+    size_intv = IntInterval(*size);
+  } else {
+    size_intv = queries.int_to_interval(size_var);
+  }
+
+  if (offset_intv.is_bottom() || access_size_intv.is_bottom() ||
+      size_intv.is_bottom() || access_size_intv.lb().is_negative()) {
+    return false;
+  }
+
+  // Check `offset + access_size <= size` without wrap-around
+  if (offset_intv.ub().to_z_number() + access_size_intv.ub().to_z_number() >
+      size_intv.lb().to_z_number()) {
+    return false;
+  }
+
+  // add `size` (min, max) and `offset + access_size - size` (min, max) to
+  // block_info
+  IntInterval offset_plus_size_intv =
+      add(offset_intv,
+          access_size_intv.cast(offset_intv.bit_width(), offset_intv.sign()));
+  block_info.put("size", to_json(size_intv));
+  block_info.put("diff", to_json(sub(offset_plus_size_intv, size_intv)));
+  return true;
+}
+
+void BufferOverflowChecker::add_offset_plus_size(
+    value::AbstractDomain& inv,
+    const ScalarLit& ptr,
+    const ScalarLit& size,
+    ar::Value* access_size,
+    Variable* offset_var,
+    Variable* offset_plus_size) const {
+  inv.normal().pointer_offset_to_int(offset_var, ptr.var());
+
+  if (access_size->type() == this->_size_type) {
+    if (size.is_machine_int_var()) {
+      inv.normal().int_apply(IntBinaryOperator::Add,
+                             offset_plus_size,
+                             offset_var,
+                             size.var());
+    } else if (size.is_machine_int()) {
+      inv.normal().int_apply(IntBinaryOperator::Add,
+                             offset_plus_size,
+                             offset_var,
+                             size.machine_int());
+    } else {
+      ikos_unreachable("unexpected access size");
+    }
+  } else {
+    // This happens in LibcFgets for instance
+    if (size.is_machine_int_var()) {
+      inv.normal().int_apply(IntUnaryOperator::Cast,
+                             offset_plus_size,
+                             size.var());
+      inv.normal().int_apply(IntBinaryOperator::Add,
+                             offset_plus_size,
+                             offset_plus_size,
+                             offset_var);
+    } else if (size.is_machine_int()) {
+      inv.normal()
+          .int_apply(IntBinaryOperator::Add,
+                     offset_plus_size,
+                     offset_var,
+                     size.machine_int().cast(this->_size_type->bit_width(),
+                                             ar::Unsigned));
+    } else {
+      ikos_unreachable("unexpected access size");
+    }
+  }
+
+  inv.normal().normalize();
+}
+
+MemoryLocation* BufferOverflowChecker::global_ptr_address(
+    ar::Value* value) const {
+  if (auto gv = dyn_cast< ar::GlobalVariable >(value)) {
+    return _ctx.mem_factory->get_global(gv);
+  } else if (auto cst = dyn_cast< ar::FunctionPointerConstant >(value)) {
+    return _ctx.mem_factory->get_function(cst->function());
+  } else {
+    return nullptr;
+  }
+}
+
 void BufferOverflowChecker::init_global_ptr(value::AbstractDomain& inv,
                                             ar::Value* value) const {
   if (auto gv = dyn_cast< ar::GlobalVariable >(value)) {
@@ -1313,21 +1446,25 @@ void BufferOverflowChecker::init_global_alloc_size(
     value::AbstractDomain& inv,
     MemoryLocation* addr,
     AllocSizeVariable* size_var) const {
-  if (auto gv = dyn_cast< GlobalMemoryLocation >(addr)) {
-    MachineInt size(this->_data_layout.store_size_in_bytes(
-                        gv->global_var()->type()->pointee()),
-                    this->_data_layout.pointers.bit_width,
-                    Unsigned);
-    inv.normal().int_assign(size_var, size);
+  if (auto size = this->global_alloc_size(addr)) {
+    inv.normal().int_assign(size_var, *size);
     inv.normal().normalize();
+  }
+}
+
+boost::optional< MachineInt > BufferOverflowChecker::global_alloc_size(
+    MemoryLocation* addr) const {
+  if (auto gv = dyn_cast< GlobalMemoryLocation >(addr)) {
+    return MachineInt(this->_data_layout.store_size_in_bytes(
+                          gv->global_var()->type()->pointee()),
+                      this->_data_layout.pointers.bit_width,
+                      Unsigned);
   } else if (isa< FunctionMemoryLocation >(addr)) {
-    MachineInt size(0, this->_data_layout.pointers.bit_width, Unsigned);
-    inv.normal().int_assign(size_var, size);
-    inv.normal().normalize();
+    return MachineInt(0, this->_data_layout.pointers.bit_width, Unsigned);
   } else if (isa< LibcErrnoMemoryLocation >(addr)) {
-    MachineInt size(4, this->_data_layout.pointers.bit_width, Unsigned);
-    inv.normal().int_assign(size_var, size);
-    inv.normal().normalize();
+    return MachineInt(4, this->_data_layout.pointers.bit_width, Unsigned);
+  } else {
+    return boost::none;
   }
 }
 
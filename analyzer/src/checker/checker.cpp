@@ -93,6 +93,16 @@ void Checker::display_result(LogMessage& msg, Result result) const {
   }
 }
 
+sqlite::DbInt64 Checker::memory_location_id(MemoryLocation* mem) const {
+  ChecksTable::mark_row_reference();
+  return _ctx.output_db->memory_locations.insert(mem);
+}
+
+sqlite::DbInt64 Checker::function_id(ar::Function* fun) const {
+  ChecksTable::mark_row_reference();
+  return _ctx.output_db->functions.insert(fun);
+}
+
 // make_checker
 
 std::unique_ptr< Checker > make_checker(Context& ctx, CheckerName name) {
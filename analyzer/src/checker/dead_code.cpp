@@ -49,7 +49,17 @@
 namespace ikos {
 namespace analyzer {
 
-DeadCodeChecker::DeadCodeChecker(Context& ctx) : Checker(ctx) {}
+DeadCodeChecker::DeadCodeChecker(Context& ctx) : Checker(ctx) {
+  ar::Bundle* bundle = ctx.bundle;
+  for (auto it = bundle->function_begin(), et = bundle->function_end();
+       it != et;
+       ++it) {
+    ar::Function* fun = *it;
+    if (fun->is_definition()) {
+      this->collect_checked_statements(fun->body());
+    }
+  }
+}
 
 CheckerName DeadCodeChecker::name() const {
   return CheckerName::DeadCode;
@@ -61,16 +71,10 @@ const char* DeadCodeChecker::description() const {
 
 void DeadCodeChecker::check(ar::Statement* stmt,
                             const value::AbstractDomain& inv,
+                            QueryCache& queries,
                             CallContext* call_context) {
-  if (skip_check(stmt)) {
-    return;
-  }
-
-  ar::Statement* prev_stmt = this->previous_statement(stmt);
-  this->save_current_statement(stmt);
-
   // Check if the current statement needs a check
-  if (!needs_check(prev_stmt, stmt->parent())) {
+  if (this->_checked_stmts.count(stmt) == 0) {
     return;
   }
 
@@ -85,25 +89,20 @@ void DeadCodeChecker::check(ar::Statement* stmt,
                        call_context);
 }
 
-ar::Statement* DeadCodeChecker::previous_statement(ar::Statement* stmt) const {
-  auto it = this->_prev_stmts.find(stmt->parent());
-  if (it != this->_prev_stmts.end()) {
-    return it->second;
-  } else {
-    return nullptr; // First statement in the basic block
-  }
-}
-
-void DeadCodeChecker::save_current_statement(ar::Statement* stmt) {
-  ar::BasicBlock* bb = stmt->parent();
-
-  if (bb->back() == stmt) {
-    // Last statement in the basic block, no need to keep it in the map
-    this->_prev_stmts.erase(bb);
-    return;
+void DeadCodeChecker::collect_checked_statements(ar::Code* code) {
+  for (ar::BasicBlock* bb : *code) {
+    ar::Statement* prev_stmt = nullptr; // First statement in the basic block
+
+    for (ar::Statement* stmt : *bb) {
+      if (skip_check(stmt)) {
+        continue;
+      }
+      if (needs_check(prev_stmt, bb)) {
+        this->_checked_stmts.insert(stmt);
+      }
+      prev_stmt = stmt;
+    }
   }
-
-  this->_prev_stmts[bb] = stmt;
 }
 
 bool DeadCodeChecker::skip_check(ar::Statement* stmt) {
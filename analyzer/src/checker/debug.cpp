@@ -64,8 +64,13 @@ const char* DebugChecker::description() const {
   return "Debug checker";
 }
 
+bool DebugChecker::handles(ar::Statement::StatementKind kind) const {
+  return kind == ar::Statement::CallKind;
+}
+
 void DebugChecker::check(ar::Statement* stmt,
                          const value::AbstractDomain& inv,
+                         QueryCache& /*queries*/,
                          CallContext* /*call_context*/) {
   if (auto call = dyn_cast< ar::IntrinsicCall >(stmt)) {
     ar::Function* fun = call->called_function();
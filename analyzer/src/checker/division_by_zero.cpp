@@ -60,15 +60,20 @@ const char* DivisionByZeroChecker::description() const {
   return "Division by zero checker";
 }
 
+bool DivisionByZeroChecker::handles(ar::Statement::StatementKind kind) const {
+  return kind == ar::Statement::BinaryOperationKind;
+}
+
 void DivisionByZeroChecker::check(ar::Statement* stmt,
                                   const value::AbstractDomain& inv,
+                                  QueryCache& queries,
                                   CallContext* call_context) {
   if (auto bin = dyn_cast< ar::BinaryOperation >(stmt)) {
     if (bin->op() == ar::BinaryOperation::UDiv ||
         bin->op() == ar::BinaryOperation::SDiv ||
         bin->op() == ar::BinaryOperation::URem ||
         bin->op() == ar::BinaryOperation::SRem) {
-      CheckResult check = this->check_division(bin, inv);
+      CheckResult check = this->check_division(bin, queries);
       this->display_invariant(check.result, stmt, inv);
       this->_checks.insert(check.kind,
                            CheckerName::DivisionByZero,
@@ -82,7 +87,8 @@ void DivisionByZeroChecker::check(ar::Statement* stmt,
 }
 
 DivisionByZeroChecker::CheckResult DivisionByZeroChecker::check_division(
-    ar::BinaryOperation* stmt, const value::AbstractDomain& inv) {
+    ar::BinaryOperation* stmt, QueryCache& queries) {
+  const value::AbstractDomain& inv = queries.inv();
   if (inv.is_normal_flow_bottom()) {
     // Statement unreachable
     if (auto msg = this->display_division_check(Result::Unreachable, stmt)) {
@@ -94,7 +100,7 @@ DivisionByZeroChecker::CheckResult DivisionByZeroChecker::check_division(
   const ScalarLit& lit = this->_lit_factory.get_scalar(stmt->right());
 
   if (lit.is_undefined() || (lit.is_machine_int_var() &&
-                             inv.normal().uninit_is_uninitialized(lit.var()))) {
+                             queries.uninit_is_uninitialized(lit.var()))) {
     // Undefined operand
     if (auto msg = this->display_division_check(Result::Error, stmt)) {
       *msg << ": undefined operand\n";
@@ -106,7 +112,7 @@ DivisionByZeroChecker::CheckResult DivisionByZeroChecker::check_division(
   if (lit.is_machine_int()) {
     divisor = IntInterval(lit.machine_int());
   } else if (lit.is_machine_int_var()) {
-    divisor = inv.normal().int_to_interval(lit.var());
+    divisor = queries.int_to_interval(lit.var());
   } else {
     log::error("unexpected operand to binary operation");
     return {CheckKind::UnexpectedOperand, Result::Error, {}};
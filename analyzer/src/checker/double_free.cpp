@@ -60,11 +60,16 @@ const char* DoubleFreeChecker::description() const {
   return "Double free checker";
 }
 
+bool DoubleFreeChecker::handles(ar::Statement::StatementKind kind) const {
+  return kind == ar::Statement::CallKind || kind == ar::Statement::InvokeKind;
+}
+
 void DoubleFreeChecker::check(ar::Statement* stmt,
                               const value::AbstractDomain& inv,
+                              QueryCache& queries,
                               CallContext* call_context) {
   if (auto call = dyn_cast< ar::CallBase >(stmt)) {
-    std::vector< CheckResult > checks = this->check_call(call, inv);
+    std::vector< CheckResult > checks = this->check_call(call, queries);
     for (const auto& check : checks) {
       this->display_invariant(check.result, stmt, inv);
       this->_checks.insert(check.kind,
@@ -79,7 +84,8 @@ void DoubleFreeChecker::check(ar::Statement* stmt,
 }
 
 std::vector< DoubleFreeChecker::CheckResult > DoubleFreeChecker::check_call(
-    ar::CallBase* call, const value::AbstractDomain& inv) {
+    ar::CallBase* call, QueryCache& queries) {
+  const value::AbstractDomain& inv = queries.inv();
   if (inv.is_normal_flow_bottom()) {
     // Statement unreachable
     if (auto msg = this->display_double_free_check(Result::Unreachable, call)) {
@@ -94,7 +100,7 @@ std::vector< DoubleFreeChecker::CheckResult > DoubleFreeChecker::check_call(
 
   if (called.is_undefined() ||
       (called.is_pointer_var() &&
-       inv.normal().uninit_is_uninitialized(called.var()))) {
+       queries.uninit_is_uninitialized(called.var()))) {
     // Undefined call pointer operand
     if (auto msg = this->display_double_free_check(Result::Error, call)) {
       *msg << ": undefined call pointer operand\n";
@@ -108,7 +114,7 @@ std::vector< DoubleFreeChecker::CheckResult > DoubleFreeChecker::check_call(
   // Check null pointer dereference
 
   if (called.is_null() ||
-      (called.is_pointer_var() && inv.normal().nullity_is_null(called.var()))) {
+      (called.is_pointer_var() && queries.nullity_is_null(called.var()))) {
     // Null call pointer operand
     if (auto msg = this->display_double_free_check(Result::Error, call)) {
       *msg << ": null call pointer operand\n";
@@ -136,7 +142,7 @@ std::vector< DoubleFreeChecker::CheckResult > DoubleFreeChecker::check_call(
     callees = {_ctx.mem_factory->get_local(lv)};
   } else if (isa< ar::InternalVariable >(call->called())) {
     // Indirect call through a function pointer
-    callees = inv.normal().pointer_to_points_to(called.var());
+    callees = queries.pointer_to_points_to(called.var());
   } else {
     log::error("unexpected call pointer operand");
     return {
@@ -183,7 +189,7 @@ std::vector< DoubleFreeChecker::CheckResult > DoubleFreeChecker::check_call(
 
     if (callee->is_intrinsic()) {
       boost::optional< CheckResult > check =
-          this->check_intrinsic_call(call, callee, inv);
+          this->check_intrinsic_call(call, callee, queries);
       if (check) {
         checks.push_back(*check);
       }
@@ -196,7 +202,7 @@ std::vector< DoubleFreeChecker::CheckResult > DoubleFreeChecker::check_call(
 boost::optional< DoubleFreeChecker::CheckResult > DoubleFreeChecker::
     check_intrinsic_call(ar::CallBase* call,
                          ar::Function* fun,
-                         const value::AbstractDomain& inv) {
+                         QueryCache& queries) {
   switch (fun->intrinsic_id()) {
     case ar::Intrinsic::LibcRealloc:
     case ar::Intrinsic::LibcFree:
@@ -204,7 +210,7 @@ boost::optional< DoubleFreeChecker::CheckResult > DoubleFreeChecker::
     case ar::Intrinsic::LibcppDelete:
     case ar::Intrinsic::LibcppDeleteArray:
     case ar::Intrinsic::LibcppFreeException: {
-      return this->check_double_free(call, call->argument(0), inv);
+      return this->check_double_free(call, call->argument(0), queries);
     }
     default: {
       return boost::none;
@@ -213,7 +219,8 @@ boost::optional< DoubleFreeChecker::CheckResult > DoubleFreeChecker::
 }
 
 DoubleFreeChecker::CheckResult DoubleFreeChecker::check_double_free(
-    ar::CallBase* call, ar::Value* pointer, const value::AbstractDomain& inv) {
+    ar::CallBase* call, ar::Value* pointer, QueryCache& queries) {
+  const value::AbstractDomain& inv = queries.inv();
   if (inv.is_normal_flow_bottom()) {
     // Statement unreachable
     if (auto msg = this->display_double_free_check(Result::Unreachable, call)) {
@@ -224,8 +231,8 @@ DoubleFreeChecker::CheckResult DoubleFreeChecker::check_double_free(
 
   const ScalarLit& ptr = this->_lit_factory.get_scalar(pointer);
 
-  if (ptr.is_undefined() || (ptr.is_pointer_var() &&
-                             inv.normal().uninit_is_uninitialized(ptr.var()))) {
+  if (ptr.is_undefined() ||
+      (ptr.is_pointer_var() && queries.uninit_is_uninitialized(ptr.var()))) {
     if (auto msg = this->display_double_free_check(Result::Error, call)) {
       *msg << ": undefined operand\n";
     }
@@ -233,14 +240,14 @@ DoubleFreeChecker::CheckResult DoubleFreeChecker::check_double_free(
   }
 
   if (ptr.is_null() ||
-      (ptr.is_pointer_var() && inv.normal().nullity_is_null(ptr.var()))) {
+      (ptr.is_pointer_var() && queries.nullity_is_null(ptr.var()))) {
     if (auto msg = this->display_double_free_check(Result::Ok, call)) {
       *msg << ": safe call to free with NULL value\n";
     }
     return {CheckKind::Free, Result::Ok, {pointer}, {}};
   }
 
-  PointsToSet addrs = inv.normal().pointer_to_points_to(ptr.var());
+  PointsToSet addrs = queries.pointer_to_points_to(ptr.var());
 
   if (addrs.is_empty()) {
     if (auto msg = this->display_double_free_check(Result::Error, call)) {
@@ -261,8 +268,7 @@ DoubleFreeChecker::CheckResult DoubleFreeChecker::check_double_free(
   JsonList points_to_info;
 
   for (const auto& addr : addrs) {
-    JsonDict block_info = {
-        {"id", _ctx.output_db->memory_locations.insert(addr)}};
+    JsonDict block_info = {{"id", this->memory_location_id(addr)}};
     Result result = this->check_memory_location_free(call, inv, addr);
     block_info.put("status", static_cast< int >(result));
 
@@ -60,11 +60,16 @@ const char* FunctionCallChecker::description() const {
   return "Function call checker";
 }
 
+bool FunctionCallChecker::handles(ar::Statement::StatementKind kind) const {
+  return kind == ar::Statement::CallKind || kind == ar::Statement::InvokeKind;
+}
+
 void FunctionCallChecker::check(ar::Statement* stmt,
                                 const value::AbstractDomain& inv,
+                                QueryCache& queries,
                                 CallContext* call_context) {
   if (auto call = dyn_cast< ar::CallBase >(stmt)) {
-    CheckResult check = this->check_call(call, inv);
+    CheckResult check = this->check_call(call, queries);
     this->display_invariant(check.result, stmt, inv);
     this->_checks.insert(check.kind,
                          CheckerName::FunctionCall,
@@ -77,7 +82,8 @@ void FunctionCallChecker::check(ar::Statement* stmt,
 }
 
 FunctionCallChecker::CheckResult FunctionCallChecker::check_call(
-    ar::CallBase* call, const value::AbstractDomain& inv) {
+    ar::CallBase* call, QueryCache& queries) {
+  const value::AbstractDomain& inv = queries.inv();
   if (inv.is_normal_flow_bottom()) {
     // Statement unreachable
     if (auto msg = this->display_call_check(Result::Unreachable, call)) {
@@ -92,7 +98,7 @@ FunctionCallChecker::CheckResult FunctionCallChecker::check_call(
 
   if (called.is_undefined() ||
       (called.is_pointer_var() &&
-       inv.normal().uninit_is_uninitialized(called.var()))) {
+       queries.uninit_is_uninitialized(called.var()))) {
     // Undefined call pointer operand
     if (auto msg = this->display_call_check(Result::Error, call)) {
       *msg << ": undefined call pointer operand\n";
@@ -106,7 +112,7 @@ FunctionCallChecker::CheckResult FunctionCallChecker::check_call(
   // Check null pointer dereference
 
   if (called.is_null() ||
-      (called.is_pointer_var() && inv.normal().nullity_is_null(called.var()))) {
+      (called.is_pointer_var() && queries.nullity_is_null(called.var()))) {
     // Null call pointer operand
     if (auto msg = this->display_call_check(Result::Error, call)) {
       *msg << ": null call pointer operand\n";
@@ -134,7 +140,7 @@ FunctionCallChecker::CheckResult FunctionCallChecker::check_call(
     callees = {_ctx.mem_factory->get_local(lv)};
   } else if (isa< ar::InternalVariable >(call->called())) {
     // Indirect call through a function pointer
-    callees = inv.normal().pointer_to_points_to(called.var());
+    callees = queries.pointer_to_points_to(called.var());
   } else {
     log::error("unexpected call pointer operand");
     return {CheckKind::UnexpectedOperand, Result::Error, {call->called()}, {}};
@@ -170,8 +176,7 @@ FunctionCallChecker::CheckResult FunctionCallChecker::check_call(
   JsonList points_to_info;
 
   for (MemoryLocation* addr : callees) {
-    JsonDict block_info = {
-        {"id", _ctx.output_db->memory_locations.insert(addr)}};
+    JsonDict block_info = {{"id", this->memory_location_id(addr)}};
 
     if (!isa< FunctionMemoryLocation >(addr)) {
       // Not a call to a function memory location, emit a warning
@@ -186,7 +191,7 @@ FunctionCallChecker::CheckResult FunctionCallChecker::check_call(
       all_valid = false;
     } else {
       ar::Function* callee = cast< FunctionMemoryLocation >(addr)->function();
-      block_info.put("fun_id", _ctx.output_db->functions.insert(callee));
+      block_info.put("fun_id", this->function_id(callee));
 
       if (!ar::TypeVerifier::is_valid_call(call, callee->type())) {
         // Ill-formed function call
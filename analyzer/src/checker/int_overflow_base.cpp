@@ -75,12 +75,16 @@ static char op_char(ar::BinaryOperation::Operator op) {
 
 IntOverflowCheckerBase::IntOverflowCheckerBase(Context& ctx) : Checker(ctx) {}
 
-void IntOverflowCheckerBase::check_integer_overflow(
-    ar::BinaryOperation* stmt,
-    const value::AbstractDomain& inv,
-    CallContext* call_context) {
+bool IntOverflowCheckerBase::handles(ar::Statement::StatementKind kind) const {
+  return kind == ar::Statement::BinaryOperationKind;
+}
+
+void IntOverflowCheckerBase::check_integer_overflow(ar::BinaryOperation* stmt,
+                                                    QueryCache& queries,
+                                                    CallContext* call_context) {
+  const value::AbstractDomain& inv = queries.inv();
   llvm::SmallVector< CheckResult, 2 > checks =
-      this->check_integer_overflow(stmt, inv);
+      this->check_integer_overflow(stmt, queries);
   for (const auto& check : checks) {
     this->display_invariant(check.result, stmt, inv);
     this->_checks.insert(check.kind,
@@ -94,8 +98,9 @@ void IntOverflowCheckerBase::check_integer_overflow(
 }
 
 llvm::SmallVector< IntOverflowCheckerBase::CheckResult, 2 >
-IntOverflowCheckerBase::check_integer_overflow(
-    ar::BinaryOperation* stmt, const value::AbstractDomain& inv) {
+IntOverflowCheckerBase::check_integer_overflow(ar::BinaryOperation* stmt,
+                                               QueryCache& queries) {
+  const value::AbstractDomain& inv = queries.inv();
   if (inv.is_normal_flow_bottom()) {
     // Statement unreachable
     if (auto msg =
@@ -117,7 +122,7 @@ IntOverflowCheckerBase::check_integer_overflow(
 
   if (left_lit.is_undefined() ||
       (left_lit.is_machine_int_var() &&
-       inv.normal().uninit_is_uninitialized(left_lit.var()))) {
+       queries.uninit_is_uninitialized(left_lit.var()))) {
     // Undefined operand
     if (auto msg = this->display_int_overflow_check(Result::Error, stmt)) {
       *msg << ": undefined left operand\n";
@@ -127,7 +132,7 @@ IntOverflowCheckerBase::check_integer_overflow(
   } else if (left_lit.is_machine_int()) {
     left_interval = IntInterval(left_lit.machine_int());
   } else if (left_lit.is_machine_int_var()) {
-    left_interval = inv.normal().int_to_interval(left_lit.var());
+    left_interval = queries.int_to_interval(left_lit.var());
   } else {
     log::error("unexpected operand to binary operation");
     return {{CheckKind::UnexpectedOperand, Result::Error, {stmt->left()}, {}}};
@@ -135,7 +140,7 @@ IntOverflowCheckerBase::check_integer_overflow(
 
   if (right_lit.is_undefined() ||
       (right_lit.is_machine_int_var() &&
-       inv.normal().uninit_is_uninitialized(right_lit.var()))) {
+       queries.uninit_is_uninitialized(right_lit.var()))) {
     // Undefined operand
     if (auto msg = this->display_int_overflow_check(Result::Error, stmt)) {
       *msg << ": undefined right operand\n";
@@ -145,7 +150,7 @@ IntOverflowCheckerBase::check_integer_overflow(
   } else if (right_lit.is_machine_int()) {
     right_interval = IntInterval(right_lit.machine_int());
   } else if (right_lit.is_machine_int_var()) {
-    right_interval = inv.normal().int_to_interval(right_lit.var());
+    right_interval = queries.int_to_interval(right_lit.var());
   } else {
     log::error("unexpected operand to binary operation");
     return {{CheckKind::UnexpectedOperand, Result::Error, {stmt->right()}, {}}};
@@ -72,27 +72,33 @@ const char* MemoryWatchChecker::description() const {
   return "Memory watch checker";
 }
 
+bool MemoryWatchChecker::handles(ar::Statement::StatementKind kind) const {
+  return kind == ar::Statement::StoreKind || kind == ar::Statement::CallKind ||
+         kind == ar::Statement::InvokeKind;
+}
+
 void MemoryWatchChecker::check(ar::Statement* stmt,
                                const value::AbstractDomain& inv,
+                               QueryCache& queries,
                                CallContext* call_context) {
   if (auto store = dyn_cast< ar::Store >(stmt)) {
-    this->check_store(store, inv);
+    this->check_store(store, queries);
   } else if (auto call = dyn_cast< ar::CallBase >(stmt)) {
-    this->check_call(call, inv, call_context);
+    this->check_call(call, queries, call_context);
   }
 }
 
-void MemoryWatchChecker::check_store(ar::Store* store,
-                                     const value::AbstractDomain& inv) {
+void MemoryWatchChecker::check_store(ar::Store* store, QueryCache& queries) {
   this->check_mem_write(store,
                         store->pointer(),
                         this->store_size(store->value()->type()),
-                        inv);
+                        queries);
 }
 
 void MemoryWatchChecker::check_call(ar::CallBase* call,
-                                    const value::AbstractDomain& inv,
+                                    QueryCache& queries,
                                     CallContext* call_context) {
+  const value::AbstractDomain& inv = queries.inv();
   if (inv.is_normal_flow_bottom()) {
     // Statement unreachable
     return;
@@ -102,13 +108,13 @@ void MemoryWatchChecker::check_call(ar::CallBase* call,
 
   if (called.is_undefined() ||
       (called.is_pointer_var() &&
-       inv.normal().uninit_is_uninitialized(called.var()))) {
+       queries.uninit_is_uninitialized(called.var()))) {
     // Undefined call pointer operand
     return;
   }
 
   if (called.is_null() ||
-      (called.is_pointer_var() && inv.normal().nullity_is_null(called.var()))) {
+      (called.is_pointer_var() && queries.nullity_is_null(called.var()))) {
     // Null call pointer operand
     return;
   }
@@ -120,7 +126,7 @@ void MemoryWatchChecker::check_call(ar::CallBase* call,
     callees = {_ctx.mem_factory->get_function(cst->function())};
   } else if (isa< ar::InlineAssemblyConstant >(call->called())) {
     // Call to assembly
-    this->check_unknown_extern_call(call, inv);
+    this->check_unknown_extern_call(call, queries);
     return;
   } else if (isa< ar::GlobalVariable >(call->called())) {
     // Call to global variable: error
@@ -130,7 +136,7 @@ void MemoryWatchChecker::check_call(ar::CallBase* call,
     return;
   } else if (isa< ar::InternalVariable >(call->called())) {
     // Indirect call through a function pointer
-    callees = inv.normal().pointer_to_points_to(called.var());
+    callees = queries.pointer_to_points_to(called.var());
   } else {
     log::error("unexpected call pointer operand");
     return;
@@ -144,7 +150,7 @@ void MemoryWatchChecker::check_call(ar::CallBase* call,
     return;
   } else if (callees.is_top()) {
     // No points-to information
-    this->check_unknown_extern_call(call, inv);
+    this->check_unknown_extern_call(call, queries);
     return;
   }
 
@@ -163,27 +169,26 @@ void MemoryWatchChecker::check_call(ar::CallBase* call,
       continue;
     } else if (caller == callee || call_context->contains(callee)) {
       // Recursive function call
-      this->check_recursive_call(call, callee, inv);
+      this->check_recursive_call(call, callee, queries);
     } else if (callee->is_intrinsic()) {
-      this->check_intrinsic_call(call, callee, inv);
+      this->check_intrinsic_call(call, callee, queries);
     } else if (callee->is_declaration()) {
-      this->check_unknown_extern_call(call, inv);
+      this->check_unknown_extern_call(call, queries);
     }
   }
 }
 
-void MemoryWatchChecker::check_recursive_call(
-    ar::CallBase* call,
-    ar::Function* /*fun*/,
-    const value::AbstractDomain& inv) {
+void MemoryWatchChecker::check_recursive_call(ar::CallBase* call,
+                                              ar::Function* /*fun*/,
+                                              QueryCache& queries) {
+  const value::AbstractDomain& inv = queries.inv();
   if (inv.is_normal_flow_bottom()) {
     // Statement unreachable
     return;
   }
 
   // Watched addresses
-  PointsToSet watch_addrs =
-      inv.normal().pointer_to_points_to(this->_watch_mem_ptr);
+  PointsToSet watch_addrs = queries.pointer_to_points_to(this->_watch_mem_ptr);
 
   if (watch_addrs.is_empty() || watch_addrs.is_top()) {
     // Not watching anything, __ikos_watch_mem was not called
@@ -195,20 +200,24 @@ void MemoryWatchChecker::check_recursive_call(
   msg << "potential memory write at a watched memory location\n";
 }
 
-void MemoryWatchChecker::check_intrinsic_call(
-    ar::CallBase* call, ar::Function* fun, const value::AbstractDomain& inv) {
+void MemoryWatchChecker::check_intrinsic_call(ar::CallBase* call,
+                                              ar::Function* fun,
+                                              QueryCache& queries) {
   switch (fun->intrinsic_id()) {
     case ar::Intrinsic::MemoryCopy:
     case ar::Intrinsic::MemoryMove:
     case ar::Intrinsic::MemorySet: {
-      this->check_mem_write(call, call->argument(0), call->argument(2), inv);
+      this->check_mem_write(call,
+                            call->argument(0),
+                            call->argument(2),
+                            queries);
     } break;
     case ar::Intrinsic::VarArgStart:
     case ar::Intrinsic::VarArgEnd:
     case ar::Intrinsic::VarArgGet:
     case ar::Intrinsic::VarArgCopy: {
       this->check_unknown_call(call,
-                               inv,
+                               queries,
                                /* may_write_params = */ true,
                                /* ignore_unknown_write = */ true,
                                /* may_write_globals = */ false,
@@ -233,7 +242,10 @@ void MemoryWatchChecker::check_intrinsic_call(
     } break;
     case ar::Intrinsic::IkosForgetMemory:
     case ar::Intrinsic::IkosAbstractMemory: {
-      this->check_mem_write(call, call->argument(0), call->argument(1), inv);
+      this->check_mem_write(call,
+                            call->argument(0),
+                            call->argument(1),
+                            queries);
     } break;
     case ar::Intrinsic::IkosWatchMemory:
     case ar::Intrinsic::IkosPartitioningVar:
@@ -265,16 +277,22 @@ void MemoryWatchChecker::check_intrinsic_call(
     case ar::Intrinsic::LibcClose: {
     } break;
     case ar::Intrinsic::LibcRead: {
-      this->check_mem_write(call, call->argument(1), call->argument(2), inv);
+      this->check_mem_write(call,
+                            call->argument(1),
+                            call->argument(2),
+                            queries);
     } break;
     case ar::Intrinsic::LibcWrite: {
     } break;
     // <stdio.h>
     case ar::Intrinsic::LibcGets: {
-      this->check_mem_write(call, call->argument(0), inv);
+      this->check_mem_write(call, call->argument(0), queries);
     } break;
     case ar::Intrinsic::LibcFgets: {
-      this->check_mem_write(call, call->argument(0), call->argument(1), inv);
+      this->check_mem_write(call,
+                            call->argument(0),
+                            call->argument(1),
+                            queries);
     } break;
     case ar::Intrinsic::LibcGetc:
     case ar::Intrinsic::LibcFgetc:
@@ -287,14 +305,17 @@ void MemoryWatchChecker::check_intrinsic_call(
     case ar::Intrinsic::LibcFprintf: {
     } break;
     case ar::Intrinsic::LibcSprintf: {
-      this->check_mem_write(call, call->argument(0), inv);
+      this->check_mem_write(call, call->argument(0), queries);
     } break;
     case ar::Intrinsic::LibcSnprintf: {
-      this->check_mem_write(call, call->argument(0), call->argument(1), inv);
+      this->check_mem_write(call,
+                            call->argument(0),
+                            call->argument(1),
+                            queries);
     } break;
     case ar::Intrinsic::LibcScanf: {
       this->check_unknown_call(call,
-                               inv,
+                               queries,
                                /* may_write_params = */ true,
                                /* ignore_unknown_write = */ true,
                                /* may_write_globals = */ false,
@@ -302,7 +323,7 @@ void MemoryWatchChecker::check_intrinsic_call(
     } break;
     case ar::Intrinsic::LibcFscanf: {
       this->check_unknown_call(call,
-                               inv,
+                               queries,
                                /* may_write_params = */ true,
                                /* ignore_unknown_write = */ true,
                                /* may_write_globals = */ false,
@@ -310,7 +331,7 @@ void MemoryWatchChecker::check_intrinsic_call(
     } break;
     case ar::Intrinsic::LibcSscanf: {
       this->check_unknown_call(call,
-                               inv,
+                               queries,
                                /* may_write_params = */ true,
                                /* ignore_unknown_write = */ true,
                                /* may_write_globals = */ false,
@@ -325,16 +346,19 @@ void MemoryWatchChecker::check_intrinsic_call(
     case ar::Intrinsic::LibcStrnlen: {
     } break;
     case ar::Intrinsic::LibcStrcpy: {
-      this->check_mem_write(call, call->argument(0), inv);
+      this->check_mem_write(call, call->argument(0), queries);
     } break;
     case ar::Intrinsic::LibcStrncpy: {
-      this->check_mem_write(call, call->argument(0), call->argument(2), inv);
+      this->check_mem_write(call,
+                            call->argument(0),
+                            call->argument(2),
+                            queries);
     } break;
     case ar::Intrinsic::LibcStrcat: {
-      this->check_mem_write(call, call->argument(0), inv);
+      this->check_mem_write(call, call->argument(0), queries);
     } break;
     case ar::Intrinsic::LibcStrncat: {
-      this->check_mem_write(call, call->argument(0), inv);
+      this->check_mem_write(call, call->argument(0), queries);
     } break;
     case ar::Intrinsic::LibcStrcmp:
     case ar::Intrinsic::LibcStrncmp:
@@ -344,15 +368,18 @@ void MemoryWatchChecker::check_intrinsic_call(
     case ar::Intrinsic::LibcStrndup: {
     } break;
     case ar::Intrinsic::LibcStrcpyCheck: {
-      this->check_mem_write(call, call->argument(0), inv);
+      this->check_mem_write(call, call->argument(0), queries);
     } break;
     case ar::Intrinsic::LibcMemoryCopyCheck:
     case ar::Intrinsic::LibcMemoryMoveCheck:
     case ar::Intrinsic::LibcMemorySetCheck: {
-      this->check_mem_write(call, call->argument(0), call->argument(2), inv);
+      this->check_mem_write(call,
+                            call->argument(0),
+                            call->argument(2),
+                            queries);
     } break;
     case ar::Intrinsic::LibcStrcatCheck: {
-      this->check_mem_write(call, call->argument(0), inv);
+      this->check_mem_write(call, call->argument(0), queries);
     } break;
     case ar::Intrinsic::LibcppNew:
     case ar::Intrinsic::LibcppNewArray:
@@ -370,10 +397,10 @@ void MemoryWatchChecker::check_intrinsic_call(
   }
 }
 
-void MemoryWatchChecker::check_unknown_extern_call(
-    ar::CallBase* call, const value::AbstractDomain& inv) {
+void MemoryWatchChecker::check_unknown_extern_call(ar::CallBase* call,
+                                                   QueryCache& queries) {
   this->check_unknown_call(call,
-                           inv,
+                           queries,
                            /* may_write_params = */ true,
                            /* ignore_unknown_write = */ true,
                            /* may_write_globals = */ false,
@@ -381,19 +408,18 @@ void MemoryWatchChecker::check_unknown_extern_call(
 }
 
 void MemoryWatchChecker::check_unknown_call(ar::CallBase* call,
-                                            value::AbstractDomain inv,
+                                            QueryCache& queries,
                                             bool may_write_params,
                                             bool ignore_unknown_write,
                                             bool may_write_globals,
                                             bool /*may_throw_exc*/) {
-  if (inv.is_normal_flow_bottom()) {
+  if (queries.inv().is_normal_flow_bottom()) {
     // Statement unreachable
     return;
   }
 
   // Watched addresses
-  PointsToSet watch_addrs =
-      inv.normal().pointer_to_points_to(this->_watch_mem_ptr);
+  PointsToSet watch_addrs = queries.pointer_to_points_to(this->_watch_mem_ptr);
 
   if (watch_addrs.is_empty() || watch_addrs.is_top()) {
     // Not watching anything, __ikos_watch_mem was not called
@@ -413,6 +439,9 @@ void MemoryWatchChecker::check_unknown_call(ar::CallBase* call,
     return;
   }
 
+  // Copy the invariant, since global pointers are initialized below
+  value::AbstractDomain inv = queries.inv();
+
   for (auto it = call->arg_begin(), et = call->arg_end(); it != et; ++it) {
     ar::Value* arg = *it;
 
@@ -462,15 +491,14 @@ void MemoryWatchChecker::check_unknown_call(ar::CallBase* call,
 void MemoryWatchChecker::check_mem_write(ar::Statement* stmt,
                                          ar::Value* pointer,
                                          ar::Value* access_size,
-                                         value::AbstractDomain inv) {
-  if (inv.is_normal_flow_bottom()) {
+                                         QueryCache& queries) {
+  if (queries.inv().is_normal_flow_bottom()) {
     // Statement unreachable
     return;
   }
 
   // Watched addresses
-  PointsToSet watch_addrs =
-      inv.normal().pointer_to_points_to(this->_watch_mem_ptr);
+  PointsToSet watch_addrs = queries.pointer_to_points_to(this->_watch_mem_ptr);
 
   if (watch_addrs.is_empty() || watch_addrs.is_top()) {
     // Not watching anything, __ikos_watch_mem was not called
@@ -480,21 +508,21 @@ void MemoryWatchChecker::check_mem_write(ar::Statement* stmt,
   const ScalarLit& ptr = this->_lit_factory.get_scalar(pointer);
   const ScalarLit& size = this->_lit_factory.get_scalar(access_size);
 
-  if (ptr.is_undefined() || (ptr.is_pointer_var() &&
-                             inv.normal().uninit_is_uninitialized(ptr.var()))) {
+  if (ptr.is_undefined() ||
+      (ptr.is_pointer_var() && queries.uninit_is_uninitialized(ptr.var()))) {
     // Undefined pointer operand
     return;
   }
 
   if (size.is_undefined() ||
       (size.is_machine_int_var() &&
-       inv.normal().uninit_is_uninitialized(size.var()))) {
+       queries.uninit_is_uninitialized(size.var()))) {
     // Undefined pointer operand
     return;
   }
 
   if (ptr.is_null() ||
-      (ptr.is_pointer_var() && inv.normal().nullity_is_null(ptr.var()))) {
+      (ptr.is_pointer_var() && queries.nullity_is_null(ptr.var()))) {
     // Null pointer operand
     return;
   }
@@ -509,11 +537,14 @@ void MemoryWatchChecker::check_mem_write(ar::Statement* stmt,
     return;
   }
 
-  // Initialize global variable pointer and function pointer
-  this->init_global_ptr(inv, pointer);
-
   // Points-to set of the pointer
-  PointsToSet addrs = inv.normal().pointer_to_points_to(ptr.var());
+  PointsToSet addrs = PointsToSet::bottom();
+  if (MemoryLocation* addr = this->global_ptr_address(pointer)) {
+    // Global variable pointer or function pointer
+    addrs = PointsToSet{addr};
+  } else {
+    addrs = queries.pointer_to_points_to(ptr.var());
+  }
 
   if (addrs.is_empty()) {
     // Pointer is invalid
@@ -526,6 +557,12 @@ void MemoryWatchChecker::check_mem_write(ar::Statement* stmt,
     return;
   }
 
+  // Copy the invariant, since shadow variables are added below
+  value::AbstractDomain inv = queries.inv();
+
+  // Initialize global variable pointer and function pointer
+  this->init_global_ptr(inv, pointer);
+
   // Variable representing the pointer offset
   Variable* offset = ptr.var()->offset_var();
   inv.normal().pointer_offset_to_int(offset, ptr.var());
@@ -630,15 +667,14 @@ void MemoryWatchChecker::check_mem_write(ar::Statement* stmt,
 
 void MemoryWatchChecker::check_mem_write(ar::Statement* stmt,
                                          ar::Value* pointer,
-                                         value::AbstractDomain inv) {
-  if (inv.is_normal_flow_bottom()) {
+                                         QueryCache& queries) {
+  if (queries.inv().is_normal_flow_bottom()) {
     // Statement unreachable
     return;
   }
 
   // Watched addresses
-  PointsToSet watch_addrs =
-      inv.normal().pointer_to_points_to(this->_watch_mem_ptr);
+  PointsToSet watch_addrs = queries.pointer_to_points_to(this->_watch_mem_ptr);
 
   if (watch_addrs.is_empty() || watch_addrs.is_top()) {
     // Not watching anything, __ikos_watch_mem was not called
@@ -647,14 +683,14 @@ void MemoryWatchChecker::check_mem_write(ar::Statement* stmt,
 
   const ScalarLit& ptr = this->_lit_factory.get_scalar(pointer);
 
-  if (ptr.is_undefined() || (ptr.is_pointer_var() &&
-                             inv.normal().uninit_is_uninitialized(ptr.var()))) {
+  if (ptr.is_undefined() ||
+      (ptr.is_pointer_var() && queries.uninit_is_uninitialized(ptr.var()))) {
     // Undefined pointer operand
     return;
   }
 
   if (ptr.is_null() ||
-      (ptr.is_pointer_var() && inv.normal().nullity_is_null(ptr.var()))) {
+      (ptr.is_pointer_var() && queries.nullity_is_null(ptr.var()))) {
     // Null pointer operand
     return;
   }
@@ -665,11 +701,14 @@ void MemoryWatchChecker::check_mem_write(ar::Statement* stmt,
     return;
   }
 
-  // Initialize global variable pointer and function pointer
-  this->init_global_ptr(inv, pointer);
-
   // Points-to set of the pointer
-  PointsToSet addrs = inv.normal().pointer_to_points_to(ptr.var());
+  PointsToSet addrs = PointsToSet::bottom();
+  if (MemoryLocation* addr = this->global_ptr_address(pointer)) {
+    // Global variable pointer or function pointer
+    addrs = PointsToSet{addr};
+  } else {
+    addrs = queries.pointer_to_points_to(ptr.var());
+  }
 
   if (addrs.is_empty()) {
     // Pointer is invalid
@@ -687,6 +726,17 @@ void MemoryWatchChecker::check_mem_write(ar::Statement* stmt,
   }
 }
 
+MemoryLocation* MemoryWatchChecker::global_ptr_address(
+    ar::Value* value) const {
+  if (auto gv = dyn_cast< ar::GlobalVariable >(value)) {
+    return _ctx.mem_factory->get_global(gv);
+  } else if (auto cst = dyn_cast< ar::FunctionPointerConstant >(value)) {
+    return _ctx.mem_factory->get_function(cst->function());
+  } else {
+    return nullptr;
+  }
+}
+
 void MemoryWatchChecker::init_global_ptr(value::AbstractDomain& inv,
                                          ar::Value* value) const {
   if (auto gv = dyn_cast< ar::GlobalVariable >(value)) {
@@ -702,6 +752,8 @@ void MemoryWatchChecker::init_global_ptr(value::AbstractDomain& inv,
 }
 
 ar::IntegerConstant* MemoryWatchChecker::store_size(ar::Type* type) const {
+  // Note: IntegerConstant::get() is not thread safe, so lock the mutex here
+  std::lock_guard< std::mutex > lock(this->_ctx.ar_context_mutex);
   return ar::IntegerConstant::get(this->_ar_context,
                                   this->_size_type,
                                   MachineInt(this->_data_layout
@@ -61,11 +61,17 @@ const char* NullDereferenceChecker::description() const {
   return "Null dereference checker";
 }
 
+bool NullDereferenceChecker::handles(ar::Statement::StatementKind kind) const {
+  return kind == ar::Statement::LoadKind || kind == ar::Statement::StoreKind ||
+         kind == ar::Statement::CallKind || kind == ar::Statement::InvokeKind;
+}
+
 void NullDereferenceChecker::check(ar::Statement* stmt,
                                    const value::AbstractDomain& inv,
+                                   QueryCache& queries,
                                    CallContext* call_context) {
   if (auto load = dyn_cast< ar::Load >(stmt)) {
-    CheckResult check = this->check_null(stmt, load->operand(), inv);
+    CheckResult check = this->check_null(stmt, load->operand(), queries);
     this->display_invariant(check.result, stmt, inv);
     this->_checks.insert(check.kind,
                          CheckerName::NullPointerDereference,
@@ -74,7 +80,7 @@ void NullDereferenceChecker::check(ar::Statement* stmt,
                          call_context,
                          check.operands);
   } else if (auto store = dyn_cast< ar::Store >(stmt)) {
-    CheckResult check = this->check_null(stmt, store->pointer(), inv);
+    CheckResult check = this->check_null(stmt, store->pointer(), queries);
     this->display_invariant(check.result, stmt, inv);
     this->_checks.insert(check.kind,
                          CheckerName::NullPointerDereference,
@@ -83,7 +89,7 @@ void NullDereferenceChecker::check(ar::Statement* stmt,
                          call_context,
                          check.operands);
   } else if (auto call = dyn_cast< ar::CallBase >(stmt)) {
-    std::vector< CheckResult > checks = this->check_call(call, inv);
+    std::vector< CheckResult > checks = this->check_call(call, queries);
     for (const auto& check : checks) {
       this->display_invariant(check.result, stmt, inv);
       this->_checks.insert(check.kind,
@@ -97,7 +103,8 @@ void NullDereferenceChecker::check(ar::Statement* stmt,
 }
 
 std::vector< NullDereferenceChecker::CheckResult > NullDereferenceChecker::
-    check_call(ar::CallBase* call, const value::AbstractDomain& inv) {
+    check_call(ar::CallBase* call, QueryCache& queries) {
+  const value::AbstractDomain& inv = queries.inv();
   if (inv.is_normal_flow_bottom()) {
     // Statement unreachable
     if (auto msg = this->display_null_check(Result::Unreachable, call)) {
@@ -112,7 +119,7 @@ std::vector< NullDereferenceChecker::CheckResult > NullDereferenceChecker::
 
   if (called.is_undefined() ||
       (called.is_pointer_var() &&
-       inv.normal().uninit_is_uninitialized(called.var()))) {
+       queries.uninit_is_uninitialized(called.var()))) {
     // Undefined call pointer operand
     if (auto msg =
             this->display_null_check(Result::Error, call, call->called())) {
@@ -125,7 +132,7 @@ std::vector< NullDereferenceChecker::CheckResult > NullDereferenceChecker::
   // Check null pointer dereference
 
   if (called.is_null() ||
-      (called.is_pointer_var() && inv.normal().nullity_is_null(called.var()))) {
+      (called.is_pointer_var() && queries.nullity_is_null(called.var()))) {
     // Null call pointer operand
     if (auto msg =
             this->display_null_check(Result::Error, call, call->called())) {
@@ -152,7 +159,7 @@ std::vector< NullDereferenceChecker::CheckResult > NullDereferenceChecker::
     callees = {_ctx.mem_factory->get_local(lv)};
   } else if (isa< ar::InternalVariable >(call->called())) {
     // Indirect call through a function pointer
-    callees = inv.normal().pointer_to_points_to(called.var());
+    callees = queries.pointer_to_points_to(called.var());
   } else {
     log::error("unexpected call pointer operand");
     return {{CheckKind::UnexpectedOperand, Result::Error, {call->called()}}};
@@ -173,7 +180,7 @@ std::vector< NullDereferenceChecker::CheckResult > NullDereferenceChecker::
   }
 
   std::vector< CheckResult > checks = {
-      this->check_null(call, call->called(), inv)};
+      this->check_null(call, call->called(), queries)};
 
   if (callees.is_top()) {
     // No points-to set
@@ -201,7 +208,8 @@ std::vector< NullDereferenceChecker::CheckResult > NullDereferenceChecker::
     }
 
     if (callee->is_intrinsic()) {
-      for (const auto& check : this->check_intrinsic_call(call, callee, inv)) {
+      for (const auto& check :
+           this->check_intrinsic_call(call, callee, queries)) {
         checks.push_back(check);
       }
     }
@@ -213,24 +221,24 @@ std::vector< NullDereferenceChecker::CheckResult > NullDereferenceChecker::
 std::vector< NullDereferenceChecker::CheckResult > NullDereferenceChecker::
     check_intrinsic_call(ar::CallBase* call,
                          ar::Function* fun,
-                         const value::AbstractDomain& inv) {
+                         QueryCache& queries) {
   switch (fun->intrinsic_id()) {
     case ar::Intrinsic::MemoryCopy:
     case ar::Intrinsic::MemoryMove: {
-      return {this->check_null(call, call->argument(0), inv),
-              this->check_null(call, call->argument(1), inv)};
+      return {this->check_null(call, call->argument(0), queries),
+              this->check_null(call, call->argument(1), queries)};
     }
     case ar::Intrinsic::MemorySet: {
-      return {this->check_null(call, call->argument(0), inv)};
+      return {this->check_null(call, call->argument(0), queries)};
     }
     case ar::Intrinsic::VarArgStart:
     case ar::Intrinsic::VarArgEnd:
     case ar::Intrinsic::VarArgGet: {
-      return {this->check_null(call, call->argument(0), inv)};
+      return {this->check_null(call, call->argument(0), queries)};
     }
     case ar::Intrinsic::VarArgCopy: {
-      return {this->check_null(call, call->argument(0), inv),
-              this->check_null(call, call->argument(1), inv)};
+      return {this->check_null(call, call->argument(0), queries),
+              this->check_null(call, call->argument(1), queries)};
     }
     case ar::Intrinsic::StackSave:
     case ar::Intrinsic::StackRestore:
@@ -254,7 +262,7 @@ std::vector< NullDereferenceChecker::CheckResult > NullDereferenceChecker::
     case ar::Intrinsic::IkosForgetMemory:
     case ar::Intrinsic::IkosAbstractMemory:
     case ar::Intrinsic::IkosWatchMemory: {
-      return {this->check_null(call, call->argument(0), inv)};
+      return {this->check_null(call, call->argument(0), queries)};
     }
     case ar::Intrinsic::IkosPartitioningVar:
     case ar::Intrinsic::IkosPartitioningJoin:
@@ -283,54 +291,54 @@ std::vector< NullDereferenceChecker::CheckResult > NullDereferenceChecker::
     }
     // <fcntl.h>
     case ar::Intrinsic::LibcOpen: {
-      return {this->check_null(call, call->argument(0), inv)};
+      return {this->check_null(call, call->argument(0), queries)};
     }
     // <unistd.h>
     case ar::Intrinsic::LibcClose: {
       return {};
     }
     case ar::Intrinsic::LibcRead: {
-      return {this->check_null(call, call->argument(1), inv)};
+      return {this->check_null(call, call->argument(1), queries)};
     }
     case ar::Intrinsic::LibcWrite: {
-      return {this->check_null(call, call->argument(1), inv)};
+      return {this->check_null(call, call->argument(1), queries)};
     }
     // <stdio.h>
     case ar::Intrinsic::LibcGets: {
-      return {this->check_null(call, call->argument(0), inv)};
+      return {this->check_null(call, call->argument(0), queries)};
     }
     case ar::Intrinsic::LibcFgets: {
-      return {this->check_null(call, call->argument(0), inv),
-              this->check_null(call, call->argument(2), inv)};
+      return {this->check_null(call, call->argument(0), queries),
+              this->check_null(call, call->argument(2), queries)};
     }
     case ar::Intrinsic::LibcGetc:
     case ar::Intrinsic::LibcFgetc: {
-      return {this->check_null(call, call->argument(0), inv)};
+      return {this->check_null(call, call->argument(0), queries)};
     }
     case ar::Intrinsic::LibcGetchar: {
       return {};
     }
     case ar::Intrinsic::LibcPuts: {
-      return {this->check_null(call, call->argument(0), inv)};
+      return {this->check_null(call, call->argument(0), queries)};
     }
     case ar::Intrinsic::LibcFputs: {
-      return {this->check_null(call, call->argument(0), inv),
-              this->check_null(call, call->argument(1), inv)};
+      return {this->check_null(call, call->argument(0), queries),
+              this->check_null(call, call->argument(1), queries)};
     }
     case ar::Intrinsic::LibcPutc:
     case ar::Intrinsic::LibcFputc: {
-      return {this->check_null(call, call->argument(1), inv)};
+      return {this->check_null(call, call->argument(1), queries)};
     }
     case ar::Intrinsic::LibcPrintf: {
-      return {this->check_null(call, call->argument(0), inv)};
+      return {this->check_null(call, call->argument(0), queries)};
     }
     case ar::Intrinsic::LibcFprintf: {
-      return {this->check_null(call, call->argument(0), inv),
-              this->check_null(call, call->argument(1), inv)};
+      return {this->check_null(call, call->argument(0), queries),
+              this->check_null(call, call->argument(1), queries)};
     }
     case ar::Intrinsic::LibcSprintf: {
-      return {this->check_null(call, call->argument(0), inv),
-              this->check_null(call, call->argument(1), inv)};
+      return {this->check_null(call, call->argument(0), queries),
+              this->check_null(call, call->argument(1), queries)};
     }
     case ar::Intrinsic::LibcSnprintf: {
       std::vector< CheckResult > checks = {};
@@ -340,10 +348,10 @@ std::vector< NullDereferenceChecker::CheckResult > NullDereferenceChecker::
       // is allowed. Otherwise, check first argument.
       auto bufsz = this->_lit_factory.get_scalar(call->argument(1));
       if (!(bufsz.is_machine_int() && bufsz.machine_int().is_zero())) {
-        checks.push_back(this->check_null(call, call->argument(0), inv));
+        checks.push_back(this->check_null(call, call->argument(0), queries));
       }
 
-      checks.push_back(this->check_null(call, call->argument(2), inv));
+      checks.push_back(this->check_null(call, call->argument(2), queries));
 
       return checks;
     }
@@ -354,64 +362,64 @@ std::vector< NullDereferenceChecker::CheckResult > NullDereferenceChecker::
       std::transform(call->arg_begin(),
                      call->arg_end(),
                      std::back_inserter(checks),
-                     [=](ar::Value* arg) {
-                       return this->check_null(call, arg, inv);
+                     [&](ar::Value* arg) {
+                       return this->check_null(call, arg, queries);
                      });
       return checks;
     }
     case ar::Intrinsic::LibcFopen: {
-      return {this->check_null(call, call->argument(0), inv),
-              this->check_null(call, call->argument(1), inv)};
+      return {this->check_null(call, call->argument(0), queries),
+              this->check_null(call, call->argument(1), queries)};
     }
     case ar::Intrinsic::LibcFclose: {
-      return {this->check_null(call, call->argument(0), inv)};
+      return {this->check_null(call, call->argument(0), queries)};
     }
     case ar::Intrinsic::LibcFflush: {
-      return {this->check_null(call, call->argument(0), inv)};
+      return {this->check_null(call, call->argument(0), queries)};
     }
     // <string.h>
     case ar::Intrinsic::LibcStrlen:
     case ar::Intrinsic::LibcStrnlen: {
-      return {this->check_null(call, call->argument(0), inv)};
+      return {this->check_null(call, call->argument(0), queries)};
     }
     case ar::Intrinsic::LibcStrcpy:
     case ar::Intrinsic::LibcStrncpy: {
-      return {this->check_null(call, call->argument(0), inv),
-              this->check_null(call, call->argument(1), inv)};
+      return {this->check_null(call, call->argument(0), queries),
+              this->check_null(call, call->argument(1), queries)};
     }
     case ar::Intrinsic::LibcStrcat:
     case ar::Intrinsic::LibcStrncat: {
-      return {this->check_null(call, call->argument(0), inv),
-              this->check_null(call, call->argument(1), inv)};
+      return {this->check_null(call, call->argument(0), queries),
+              this->check_null(call, call->argument(1), queries)};
     }
     case ar::Intrinsic::LibcStrcmp:
     case ar::Intrinsic::LibcStrncmp: {
-      return {this->check_null(call, call->argument(0), inv),
-              this->check_null(call, call->argument(1), inv)};
+      return {this->check_null(call, call->argument(0), queries),
+              this->check_null(call, call->argument(1), queries)};
     }
     case ar::Intrinsic::LibcStrstr: {
-      return {this->check_null(call, call->argument(0), inv),
-              this->check_null(call, call->argument(1), inv)};
+      return {this->check_null(call, call->argument(0), queries),
+              this->check_null(call, call->argument(1), queries)};
     }
     case ar::Intrinsic::LibcStrchr: {
-      return {this->check_null(call, call->argument(0), inv)};
+      return {this->check_null(call, call->argument(0), queries)};
     }
     case ar::Intrinsic::LibcStrdup:
     case ar::Intrinsic::LibcStrndup: {
-      return {this->check_null(call, call->argument(0), inv)};
+      return {this->check_null(call, call->argument(0), queries)};
     }
     case ar::Intrinsic::LibcStrcpyCheck:
     case ar::Intrinsic::LibcMemoryCopyCheck:
     case ar::Intrinsic::LibcMemoryMoveCheck: {
-      return {this->check_null(call, call->argument(0), inv),
-              this->check_null(call, call->argument(1), inv)};
+      return {this->check_null(call, call->argument(0), queries),
+              this->check_null(call, call->argument(1), queries)};
     }
     case ar::Intrinsic::LibcMemorySetCheck: {
-      return {this->check_null(call, call->argument(0), inv)};
+      return {this->check_null(call, call->argument(0), queries)};
     }
     case ar::Intrinsic::LibcStrcatCheck: {
-      return {this->check_null(call, call->argument(0), inv),
-              this->check_null(call, call->argument(1), inv)};
+      return {this->check_null(call, call->argument(0), queries),
+              this->check_null(call, call->argument(1), queries)};
     }
     case ar::Intrinsic::LibcppNew:
     case ar::Intrinsic::LibcppNewArray:
@@ -431,7 +439,8 @@ std::vector< NullDereferenceChecker::CheckResult > NullDereferenceChecker::
 }
 
 NullDereferenceChecker::CheckResult NullDereferenceChecker::check_null(
-    ar::Statement* stmt, ar::Value* operand, const value::AbstractDomain& inv) {
+    ar::Statement* stmt, ar::Value* operand, QueryCache& queries) {
+  const value::AbstractDomain& inv = queries.inv();
   if (inv.is_normal_flow_bottom()) {
     // Statement unreachable
     if (auto msg =
@@ -443,8 +452,8 @@ NullDereferenceChecker::CheckResult NullDereferenceChecker::check_null(
 
   const ScalarLit& ptr = this->_lit_factory.get_scalar(operand);
 
-  if (ptr.is_undefined() || (ptr.is_pointer_var() &&
-                             inv.normal().uninit_is_uninitialized(ptr.var()))) {
+  if (ptr.is_undefined() ||
+      (ptr.is_pointer_var() && queries.uninit_is_uninitialized(ptr.var()))) {
     // Undefined operand
     if (auto msg = this->display_null_check(Result::Error, stmt, operand)) {
       *msg << ": undefined operand\n";
@@ -491,7 +500,7 @@ NullDereferenceChecker::CheckResult NullDereferenceChecker::check_null(
     return {CheckKind::NullPointerDereference, Result::Ok, {operand}};
   }
 
-  core::Nullity nullity = inv.normal().nullity_to_nullity(ptr.var());
+  core::Nullity nullity = queries.nullity_to_nullity(ptr.var());
   if (nullity.is_null()) {
     // Pointer is definitely null
     if (auto msg = this->display_null_check(Result::Error, stmt, operand)) {
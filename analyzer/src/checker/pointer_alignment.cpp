@@ -61,48 +61,54 @@ const char* PointerAlignmentChecker::description() const {
   return "pointer alignment checker";
 }
 
+bool PointerAlignmentChecker::handles(ar::Statement::StatementKind kind) const {
+  return kind == ar::Statement::LoadKind || kind == ar::Statement::StoreKind ||
+         kind == ar::Statement::CallKind;
+}
+
 void PointerAlignmentChecker::check(ar::Statement* stmt,
                                     const value::AbstractDomain& inv,
+                                    QueryCache& queries,
                                     CallContext* call_context) {
   if (auto store = dyn_cast< ar::Store >(stmt)) {
     this->check_alignment(store,
                           store->pointer(),
                           store->alignment(),
-                          inv,
+                          queries,
                           call_context);
   } else if (auto load = dyn_cast< ar::Load >(stmt)) {
     this->check_alignment(load,
                           load->operand(),
                           load->alignment(),
-                          inv,
+                          queries,
                           call_context);
   } else if (auto memcpy = dyn_cast< ar::MemoryCopy >(stmt)) {
     this->check_alignment(memcpy,
                           memcpy->source(),
                           memcpy->source_alignment(),
-                          inv,
+                          queries,
                           call_context);
     this->check_alignment(memcpy,
                           memcpy->destination(),
                           memcpy->destination_alignment(),
-                          inv,
+                          queries,
                           call_context);
   } else if (auto memmove = dyn_cast< ar::MemoryMove >(stmt)) {
     this->check_alignment(memmove,
                           memmove->source(),
                           memmove->source_alignment(),
-                          inv,
+                          queries,
                           call_context);
     this->check_alignment(memmove,
                           memmove->destination(),
                           memmove->destination_alignment(),
-                          inv,
+                          queries,
                           call_context);
   } else if (auto memset = dyn_cast< ar::MemorySet >(stmt)) {
     this->check_alignment(memset,
                           memset->pointer(),
                           memset->alignment(),
-                          inv,
+                          queries,
                           call_context);
   }
 }
@@ -110,9 +116,13 @@ void PointerAlignmentChecker::check(ar::Statement* stmt,
 void PointerAlignmentChecker::check_alignment(ar::Statement* stmt,
                                               ar::Value* operand,
                                               uint64_t alignment_req,
-                                              const value::AbstractDomain& inv,
+                                              QueryCache& queries,
                                               CallContext* call_context) {
-  CheckResult check = this->check_alignment(stmt, operand, alignment_req, inv);
+  const value::AbstractDomain& inv = queries.inv();
+  CheckResult check = this->check_alignment(stmt,
+                                            operand,
+                                            alignment_req,
+                                            queries);
   this->display_invariant(check.result, stmt, inv);
   this->_checks.insert(check.kind,
                        CheckerName::UnalignedPointer,
@@ -127,7 +137,8 @@ PointerAlignmentChecker::CheckResult PointerAlignmentChecker::check_alignment(
     ar::Statement* stmt,
     ar::Value* operand,
     uint64_t alignment_req,
-    const value::AbstractDomain& inv) {
+    QueryCache& queries) {
+  const value::AbstractDomain& inv = queries.inv();
   if (inv.is_normal_flow_bottom()) {
     // Statement unreachable
     if (auto msg =
@@ -139,8 +150,8 @@ PointerAlignmentChecker::CheckResult PointerAlignmentChecker::check_alignment(
 
   const ScalarLit& ptr = this->_lit_factory.get_scalar(operand);
 
-  if (ptr.is_undefined() || (ptr.is_pointer_var() &&
-                             inv.normal().uninit_is_uninitialized(ptr.var()))) {
+  if (ptr.is_undefined() ||
+      (ptr.is_pointer_var() && queries.uninit_is_uninitialized(ptr.var()))) {
     // Undefined operand
     if (auto msg =
             this->display_alignment_check(Result::Error, stmt, operand)) {
@@ -150,7 +161,7 @@ PointerAlignmentChecker::CheckResult PointerAlignmentChecker::check_alignment(
   }
 
   if (ptr.is_null() ||
-      (ptr.is_pointer_var() && inv.normal().nullity_is_null(ptr.var()))) {
+      (ptr.is_pointer_var() && queries.nullity_is_null(ptr.var()))) {
     // Null operand
     if (auto msg =
             this->display_alignment_check(Result::Error, stmt, operand)) {
@@ -176,7 +187,7 @@ PointerAlignmentChecker::CheckResult PointerAlignmentChecker::check_alignment(
   Variable* ptr_var = ptr.var();
 
   // Points-to set of the pointer
-  PointsToSet addrs = inv.normal().pointer_to_points_to(ptr_var);
+  PointsToSet addrs = queries.pointer_to_points_to(ptr_var);
 
   if (auto gv = dyn_cast< ar::GlobalVariable >(operand)) {
     addrs = PointsToSet{_ctx.mem_factory->get_global(gv)};
@@ -231,8 +242,7 @@ PointerAlignmentChecker::CheckResult PointerAlignmentChecker::check_alignment(
 
   for (MemoryLocation* addr : addrs) {
     // Add info to json
-    JsonDict block_info = {
-        {"id", _ctx.output_db->memory_locations.insert(addr)}};
+    JsonDict block_info = {{"id", this->memory_location_id(addr)}};
 
     // Is the points_to correctly aligned?
     Result is_correctly_aligned =
@@ -59,14 +59,19 @@ const char* PointerCompareChecker::description() const {
   return "Pointer compare checker";
 }
 
+bool PointerCompareChecker::handles(ar::Statement::StatementKind kind) const {
+  return kind == ar::Statement::ComparisonKind;
+}
+
 void PointerCompareChecker::check(ar::Statement* stmt,
                                   const value::AbstractDomain& inv,
+                                  QueryCache& queries,
                                   CallContext* call_context) {
   if (auto cmp = dyn_cast< ar::Comparison >(stmt)) {
     if (cmp->is_pointer_predicate() &&
         cmp->predicate() != ar::Comparison::PEQ &&
         cmp->predicate() != ar::Comparison::PNE) {
-      CheckResult check = this->check_pointer_compare(cmp, inv);
+      CheckResult check = this->check_pointer_compare(cmp, queries);
       this->display_invariant(check.result, stmt, inv);
       this->_checks.insert(check.kind,
                            CheckerName::PointerCompare,
@@ -80,7 +85,8 @@ void PointerCompareChecker::check(ar::Statement* stmt,
 }
 
 PointerCompareChecker::CheckResult PointerCompareChecker::check_pointer_compare(
-    ar::Comparison* stmt, const value::AbstractDomain& inv) {
+    ar::Comparison* stmt, QueryCache& queries) {
+  const value::AbstractDomain& inv = queries.inv();
   if (inv.is_normal_flow_bottom()) {
     // Statement unreachable
     if (auto msg =
@@ -97,7 +103,7 @@ PointerCompareChecker::CheckResult PointerCompareChecker::check_pointer_compare(
 
   if (left_ptr.is_undefined() ||
       (left_ptr.is_pointer_var() &&
-       inv.normal().uninit_is_uninitialized(left_ptr.var()))) {
+       queries.uninit_is_uninitialized(left_ptr.var()))) {
     if (auto msg = this->display_pointer_compare_check(Result::Error, stmt)) {
       *msg << ": undefined left operand\n";
     }
@@ -107,7 +113,7 @@ PointerCompareChecker::CheckResult PointerCompareChecker::check_pointer_compare(
             {}};
   } else if (right_ptr.is_undefined() ||
              (right_ptr.is_pointer_var() &&
-              inv.normal().uninit_is_uninitialized(right_ptr.var()))) {
+              queries.uninit_is_uninitialized(right_ptr.var()))) {
     if (auto msg = this->display_pointer_compare_check(Result::Error, stmt)) {
       *msg << ": undefined right operand\n";
     }
@@ -119,8 +125,8 @@ PointerCompareChecker::CheckResult PointerCompareChecker::check_pointer_compare(
 
   // Check for null operands
 
-  if (left_ptr.is_null() || (left_ptr.is_pointer_var() &&
-                             inv.normal().nullity_is_null(left_ptr.var()))) {
+  if (left_ptr.is_null() ||
+      (left_ptr.is_pointer_var() && queries.nullity_is_null(left_ptr.var()))) {
     if (auto msg = this->display_pointer_compare_check(Result::Error, stmt)) {
       *msg << ": null left operand\n";
     }
@@ -130,7 +136,7 @@ PointerCompareChecker::CheckResult PointerCompareChecker::check_pointer_compare(
             {}};
   } else if (right_ptr.is_null() ||
              (right_ptr.is_pointer_var() &&
-              inv.normal().nullity_is_null(right_ptr.var()))) {
+              queries.nullity_is_null(right_ptr.var()))) {
     if (auto msg = this->display_pointer_compare_check(Result::Error, stmt)) {
       *msg << ": null right operand\n";
     }
@@ -154,7 +160,7 @@ PointerCompareChecker::CheckResult PointerCompareChecker::check_pointer_compare(
   } else if (auto cst = dyn_cast< ar::FunctionPointerConstant >(stmt->left())) {
     left_addrs = {_ctx.mem_factory->get_function(cst->function())};
   } else {
-    left_addrs = inv.normal().pointer_to_points_to(left_ptr.var());
+    left_addrs = queries.pointer_to_points_to(left_ptr.var());
   }
 
   auto right_addrs = PointsToSet::bottom();
@@ -164,7 +170,7 @@ PointerCompareChecker::CheckResult PointerCompareChecker::check_pointer_compare(
                  dyn_cast< ar::FunctionPointerConstant >(stmt->right())) {
     right_addrs = {_ctx.mem_factory->get_function(cst->function())};
   } else {
-    right_addrs = inv.normal().pointer_to_points_to(right_ptr.var());
+    right_addrs = queries.pointer_to_points_to(right_ptr.var());
   }
 
   if (left_addrs.is_empty()) {
@@ -207,7 +213,7 @@ PointerCompareChecker::CheckResult PointerCompareChecker::check_pointer_compare(
     if (left_addrs.is_set()) {
       JsonList left_points_to;
       for (MemoryLocation* mem_loc : left_addrs) {
-        left_points_to.add(_ctx.output_db->memory_locations.insert(mem_loc));
+        left_points_to.add(this->memory_location_id(mem_loc));
       }
       info.put("left_points_to", left_points_to);
     } else {
@@ -217,7 +223,7 @@ PointerCompareChecker::CheckResult PointerCompareChecker::check_pointer_compare(
     if (right_addrs.is_set()) {
       JsonList right_points_to;
       for (MemoryLocation* mem_loc : right_addrs) {
-        right_points_to.add(_ctx.output_db->memory_locations.insert(mem_loc));
+        right_points_to.add(this->memory_location_id(mem_loc));
       }
       info.put("right_points_to", right_points_to);
     } else {
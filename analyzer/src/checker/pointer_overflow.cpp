@@ -60,11 +60,16 @@ const char* PointerOverflowChecker::description() const {
   return "Pointer overflow checker";
 }
 
+bool PointerOverflowChecker::handles(ar::Statement::StatementKind kind) const {
+  return kind == ar::Statement::PointerShiftKind;
+}
+
 void PointerOverflowChecker::check(ar::Statement* stmt,
                                    const value::AbstractDomain& inv,
+                                   QueryCache& queries,
                                    CallContext* call_context) {
   if (auto bin = dyn_cast< ar::PointerShift >(stmt)) {
-    CheckResult check = this->check_pointer_overflow(bin, inv);
+    CheckResult check = this->check_pointer_overflow(bin, queries);
     this->display_invariant(check.result, stmt, inv);
     this->_checks.insert(check.kind,
                          CheckerName::PointerOverflow,
@@ -76,8 +81,8 @@ void PointerOverflowChecker::check(ar::Statement* stmt,
 }
 
 PointerOverflowChecker::CheckResult PointerOverflowChecker::
-    check_pointer_overflow(ar::PointerShift* stmt,
-                           const value::AbstractDomain& inv) {
+    check_pointer_overflow(ar::PointerShift* stmt, QueryCache& queries) {
+  const value::AbstractDomain& inv = queries.inv();
   if (inv.is_normal_flow_bottom()) {
     // Statement unreachable
     if (auto msg =
@@ -90,8 +95,7 @@ PointerOverflowChecker::CheckResult PointerOverflowChecker::
   const ScalarLit& base = this->_lit_factory.get_scalar(stmt->pointer());
 
   if (base.is_undefined() ||
-      (base.is_pointer_var() &&
-       inv.normal().uninit_is_uninitialized(base.var()))) {
+      (base.is_pointer_var() && queries.uninit_is_uninitialized(base.var()))) {
     if (auto msg = this->display_pointer_overflow_check(Result::Error, stmt)) {
       *msg << ": undefined base operand\n";
     }
@@ -106,7 +110,7 @@ PointerOverflowChecker::CheckResult PointerOverflowChecker::
     base_interval = ZInterval(0);
   } else if (isa< ar::InternalVariable >(stmt->pointer())) {
     base_interval =
-        inv.normal().pointer_offset_to_interval(base.var()).to_z_interval();
+        queries.pointer_offset_to_interval(base.var()).to_z_interval();
   } else {
     log::error("unexpected operand to ptrshift");
     return {CheckKind::UnexpectedOperand, Result::Error, {stmt->pointer()}};
@@ -128,7 +132,7 @@ PointerOverflowChecker::CheckResult PointerOverflowChecker::
 
     if (offset.is_undefined() ||
         (offset.is_machine_int_var() &&
-         inv.normal().uninit_is_uninitialized(offset.var()))) {
+         queries.uninit_is_uninitialized(offset.var()))) {
       if (auto msg =
               this->display_pointer_overflow_check(Result::Error, stmt)) {
         *msg << ": undefined operand\n";
@@ -137,8 +141,7 @@ PointerOverflowChecker::CheckResult PointerOverflowChecker::
     } else if (offset.is_machine_int()) {
       offset_interval = ZInterval(offset.machine_int().to_z_number());
     } else if (offset.is_machine_int_var()) {
-      offset_interval =
-          inv.normal().int_to_interval(offset.var()).to_z_interval();
+      offset_interval = queries.int_to_interval(offset.var()).to_z_interval();
     } else {
       log::error("unexpected operand to ptrshift");
       return {CheckKind::UnexpectedOperand, Result::Error, {term.second}};
@@ -60,8 +60,13 @@ const char* ShiftCountChecker::description() const {
   return "Shift count checker";
 }
 
+bool ShiftCountChecker::handles(ar::Statement::StatementKind kind) const {
+  return kind == ar::Statement::BinaryOperationKind;
+}
+
 void ShiftCountChecker::check(ar::Statement* stmt,
                               const value::AbstractDomain& inv,
+                              QueryCache& queries,
                               CallContext* call_context) {
   if (auto bin = dyn_cast< ar::BinaryOperation >(stmt)) {
     if (bin->op() == ar::BinaryOperation::SShl ||
@@ -70,7 +75,7 @@ void ShiftCountChecker::check(ar::Statement* stmt,
         bin->op() == ar::BinaryOperation::ULShr ||
         bin->op() == ar::BinaryOperation::SAShr ||
         bin->op() == ar::BinaryOperation::UAShr) {
-      CheckResult check = this->check_shift_count(bin, inv);
+      CheckResult check = this->check_shift_count(bin, queries);
       this->display_invariant(check.result, stmt, inv);
       this->_checks.insert(check.kind,
                            CheckerName::ShiftCount,
@@ -84,7 +89,8 @@ void ShiftCountChecker::check(ar::Statement* stmt,
 }
 
 ShiftCountChecker::CheckResult ShiftCountChecker::check_shift_count(
-    ar::BinaryOperation* stmt, const value::AbstractDomain& inv) {
+    ar::BinaryOperation* stmt, QueryCache& queries) {
+  const value::AbstractDomain& inv = queries.inv();
   if (inv.is_normal_flow_bottom()) {
     // Statement unreachable
     if (auto msg = this->display_shift_count_check(Result::Unreachable, stmt)) {
@@ -98,7 +104,7 @@ ShiftCountChecker::CheckResult ShiftCountChecker::check_shift_count(
   auto shift_count_interval = IntInterval::bottom(1, Signed);
   if (shift_count.is_undefined() ||
       (shift_count.is_machine_int_var() &&
-       inv.normal().uninit_is_uninitialized(shift_count.var()))) {
+       queries.uninit_is_uninitialized(shift_count.var()))) {
     if (auto msg = this->display_shift_count_check(Result::Error, stmt)) {
       *msg << ": undefined shift count\n";
     }
@@ -106,7 +112,7 @@ ShiftCountChecker::CheckResult ShiftCountChecker::check_shift_count(
   } else if (shift_count.is_machine_int()) {
     shift_count_interval = IntInterval(shift_count.machine_int());
   } else if (shift_count.is_machine_int_var()) {
-    shift_count_interval = inv.normal().int_to_interval(shift_count.var());
+    shift_count_interval = queries.int_to_interval(shift_count.var());
   } else {
     log::error("unexpected shit count operand");
     return {CheckKind::UnexpectedOperand, Result::Error, {}};
@@ -59,6 +59,7 @@ const char* SignedIntOverflowChecker::description() const {
 
 void SignedIntOverflowChecker::check(ar::Statement* stmt,
                                      const value::AbstractDomain& inv,
+                                     QueryCache& queries,
                                      CallContext* call_context) {
   if (auto bin = dyn_cast< ar::BinaryOperation >(stmt)) {
     if (bin->op() == ar::BinaryOperation::SAdd ||
@@ -66,7 +67,7 @@ void SignedIntOverflowChecker::check(ar::Statement* stmt,
         bin->op() == ar::BinaryOperation::SMul ||
         bin->op() == ar::BinaryOperation::SDiv ||
         bin->op() == ar::BinaryOperation::SRem) {
-      this->check_integer_overflow(bin, inv, call_context);
+      this->check_integer_overflow(bin, queries, call_context);
     }
   }
 }
@@ -59,15 +59,21 @@ const char* SoundnessChecker::description() const {
   return "Soundness checker";
 }
 
+bool SoundnessChecker::handles(ar::Statement::StatementKind kind) const {
+  return kind == ar::Statement::StoreKind || kind == ar::Statement::CallKind ||
+         kind == ar::Statement::InvokeKind;
+}
+
 void SoundnessChecker::check(ar::Statement* stmt,
                              const value::AbstractDomain& inv,
+                             QueryCache& queries,
                              CallContext* call_context) {
   if (auto store = dyn_cast< ar::Store >(stmt)) {
     boost::optional< CheckResult > check =
         this->check_mem_write(store,
                               store->pointer(),
                               CheckKind::IgnoredStore,
-                              inv);
+                              queries);
     if (check) {
       this->display_invariant(check->result, stmt, inv);
       this->_checks.insert(check->kind,
@@ -80,7 +86,7 @@ void SoundnessChecker::check(ar::Statement* stmt,
     }
   } else if (auto call = dyn_cast< ar::CallBase >(stmt)) {
     std::vector< CheckResult > checks =
-        this->check_call(call, inv, call_context);
+        this->check_call(call, queries, call_context);
     for (const auto& check : checks) {
       this->display_invariant(check.result, stmt, inv);
       this->_checks.insert(check.kind,
@@ -96,8 +102,9 @@ void SoundnessChecker::check(ar::Statement* stmt,
 
 std::vector< SoundnessChecker::CheckResult > SoundnessChecker::check_call(
     ar::CallBase* call,
-    const value::AbstractDomain& inv,
+    QueryCache& queries,
     CallContext* call_context) {
+  const value::AbstractDomain& inv = queries.inv();
   if (inv.is_normal_flow_bottom()) {
     // Statement unreachable
     if (auto msg = this->display_soundness_check(Result::Unreachable, call)) {
@@ -112,7 +119,7 @@ std::vector< SoundnessChecker::CheckResult > SoundnessChecker::check_call(
 
   if (called.is_undefined() ||
       (called.is_pointer_var() &&
-       inv.normal().uninit_is_uninitialized(called.var()))) {
+       queries.uninit_is_uninitialized(called.var()))) {
     // Undefined call pointer operand
     if (auto msg = this->display_soundness_check(Result::Error, call)) {
       *msg << ": undefined call pointer operand\n";
@@ -126,7 +133,7 @@ std::vector< SoundnessChecker::CheckResult > SoundnessChecker::check_call(
   // Check null pointer dereference
 
   if (called.is_null() ||
-      (called.is_pointer_var() && inv.normal().nullity_is_null(called.var()))) {
+      (called.is_pointer_var() && queries.nullity_is_null(called.var()))) {
     // Null call pointer operand
     if (auto msg = this->display_soundness_check(Result::Error, call)) {
       *msg << ": null call pointer operand\n";
@@ -154,7 +161,7 @@ std::vector< SoundnessChecker::CheckResult > SoundnessChecker::check_call(
     callees = {_ctx.mem_factory->get_local(lv)};
   } else if (isa< ar::InternalVariable >(call->called())) {
     // Indirect call through a function pointer
-    callees = inv.normal().pointer_to_points_to(called.var());
+    callees = queries.pointer_to_points_to(called.var());
   } else {
     log::error("unexpected call pointer operand");
     return {
@@ -201,13 +208,14 @@ std::vector< SoundnessChecker::CheckResult > SoundnessChecker::check_call(
       continue;
     } else if (caller == callee || call_context->contains(callee)) {
       // Recursive function call
-      checks.push_back(this->check_recursive_call(call, callee, inv));
+      checks.push_back(this->check_recursive_call(call, callee, queries));
     } else if (callee->is_intrinsic()) {
-      for (const auto& check : this->check_intrinsic_call(call, callee, inv)) {
+      for (const auto& check :
+           this->check_intrinsic_call(call, callee, queries)) {
         checks.push_back(check);
       }
     } else if (callee->is_declaration()) {
-      checks.push_back(this->check_unknown_extern_call(call, callee, inv));
+      checks.push_back(this->check_unknown_extern_call(call, callee, queries));
     } else if (callee->is_definition()) {
       // This is sound
       continue;
@@ -220,7 +228,8 @@ std::vector< SoundnessChecker::CheckResult > SoundnessChecker::check_call(
 }
 
 SoundnessChecker::CheckResult SoundnessChecker::check_recursive_call(
-    ar::CallBase* call, ar::Function* fun, const value::AbstractDomain& inv) {
+    ar::CallBase* call, ar::Function* fun, QueryCache& queries) {
+  const value::AbstractDomain& inv = queries.inv();
   if (inv.is_normal_flow_bottom()) {
     // Statement unreachable
     if (auto msg = this->display_soundness_check(Result::Unreachable, call)) {
@@ -235,7 +244,7 @@ SoundnessChecker::CheckResult SoundnessChecker::check_recursive_call(
   return {CheckKind::RecursiveFunctionCall,
           Result::Warning,
           {},
-          JsonDict{{"fun_id", _ctx.output_db->functions.insert(fun)}}};
+          JsonDict{{"fun_id", this->function_id(fun)}}};
 }
 
 namespace {
@@ -255,25 +264,25 @@ inline std::vector< T > to_vector(boost::optional< T > check) {
 std::vector< SoundnessChecker::CheckResult > SoundnessChecker::
     check_intrinsic_call(ar::CallBase* call,
                          ar::Function* fun,
-                         const value::AbstractDomain& inv) {
+                         QueryCache& queries) {
   switch (fun->intrinsic_id()) {
     case ar::Intrinsic::MemoryCopy: {
       return to_vector(this->check_mem_write(call,
                                              call->argument(0),
                                              CheckKind::IgnoredMemoryCopy,
-                                             inv));
+                                             queries));
     }
     case ar::Intrinsic::MemoryMove: {
       return to_vector(this->check_mem_write(call,
                                              call->argument(0),
                                              CheckKind::IgnoredMemoryMove,
-                                             inv));
+                                             queries));
     }
     case ar::Intrinsic::MemorySet: {
       return to_vector(this->check_mem_write(call,
                                              call->argument(0),
                                              CheckKind::IgnoredMemorySet,
-                                             inv));
+                                             queries));
     }
     case ar::Intrinsic::VarArgStart:
     case ar::Intrinsic::VarArgEnd:
@@ -282,7 +291,7 @@ std::vector< SoundnessChecker::CheckResult > SoundnessChecker::
       return this->check_call_pointer_params(call,
                                              fun,
                                              {call->argument(0)},
-                                             inv);
+                                             queries);
     }
     case ar::Intrinsic::StackSave:
     case ar::Intrinsic::StackRestore:
@@ -319,10 +328,10 @@ std::vector< SoundnessChecker::CheckResult > SoundnessChecker::
       return {};
     }
     case ar::Intrinsic::LibcRealloc: {
-      return to_vector(this->check_free(call, call->argument(0), inv));
+      return to_vector(this->check_free(call, call->argument(0), queries));
     }
     case ar::Intrinsic::LibcFree: {
-      return to_vector(this->check_free(call, call->argument(0), inv));
+      return to_vector(this->check_free(call, call->argument(0), queries));
     }
     case ar::Intrinsic::LibcAbs:
     case ar::Intrinsic::LibcRand:
@@ -347,7 +356,7 @@ std::vector< SoundnessChecker::CheckResult > SoundnessChecker::
       return this->check_call_pointer_params(call,
                                              fun,
                                              {call->argument(1)},
-                                             inv);
+                                             queries);
     }
     case ar::Intrinsic::LibcWrite: {
       return {};
@@ -357,13 +366,13 @@ std::vector< SoundnessChecker::CheckResult > SoundnessChecker::
       return this->check_call_pointer_params(call,
                                              fun,
                                              {call->argument(0)},
-                                             inv);
+                                             queries);
     }
     case ar::Intrinsic::LibcFgets: {
       return this->check_call_pointer_params(call,
                                              fun,
                                              {call->argument(0)},
-                                             inv);
+                                             queries);
     }
     case ar::Intrinsic::LibcGetc:
     case ar::Intrinsic::LibcFgetc:
@@ -380,40 +389,40 @@ std::vector< SoundnessChecker::CheckResult > SoundnessChecker::
       return this->check_call_pointer_params(call,
                                              fun,
                                              {call->argument(0)},
-                                             inv);
+                                             queries);
     }
     case ar::Intrinsic::LibcSnprintf: {
       return this->check_call_pointer_params(call,
                                              fun,
                                              {call->argument(0)},
-                                             inv);
+                                             queries);
     }
     case ar::Intrinsic::LibcScanf: {
       return this->check_call_pointer_params(call,
                                              fun,
                                              {call->arg_begin() + 1,
                                               call->arg_end()},
-                                             inv);
+                                             queries);
     }
     case ar::Intrinsic::LibcFscanf: {
       return this->check_call_pointer_params(call,
                                              fun,
                                              {call->arg_begin() + 2,
                                               call->arg_end()},
-                                             inv);
+                                             queries);
     }
     case ar::Intrinsic::LibcSscanf: {
       return this->check_call_pointer_params(call,
                                              fun,
                                              {call->arg_begin() + 2,
                                               call->arg_end()},
-                                             inv);
+                                             queries);
     }
     case ar::Intrinsic::LibcFopen: {
       return {};
     }
     case ar::Intrinsic::LibcFclose: {
-      return to_vector(this->check_free(call, call->argument(0), inv));
+      return to_vector(this->check_free(call, call->argument(0), queries));
     }
     case ar::Intrinsic::LibcFflush: {
       return {};
@@ -430,7 +439,7 @@ std::vector< SoundnessChecker::CheckResult > SoundnessChecker::
       return this->check_call_pointer_params(call,
                                              fun,
                                              {call->argument(0)},
-                                             inv);
+                                             queries);
     }
     case ar::Intrinsic::LibcStrcmp:
     case ar::Intrinsic::LibcStrncmp:
@@ -444,31 +453,31 @@ std::vector< SoundnessChecker::CheckResult > SoundnessChecker::
       return this->check_call_pointer_params(call,
                                              fun,
                                              {call->argument(0)},
-                                             inv);
+                                             queries);
     }
     case ar::Intrinsic::LibcMemoryCopyCheck: {
       return to_vector(this->check_mem_write(call,
                                              call->argument(0),
                                              CheckKind::IgnoredMemoryCopy,
-                                             inv));
+                                             queries));
     }
     case ar::Intrinsic::LibcMemoryMoveCheck: {
       return to_vector(this->check_mem_write(call,
                                              call->argument(0),
                                              CheckKind::IgnoredMemoryMove,
-                                             inv));
+                                             queries));
     }
     case ar::Intrinsic::LibcMemorySetCheck: {
       return to_vector(this->check_mem_write(call,
                                              call->argument(0),
                                              CheckKind::IgnoredMemorySet,
-                                             inv));
+                                             queries));
     }
     case ar::Intrinsic::LibcStrcatCheck: {
       return this->check_call_pointer_params(call,
                                              fun,
                                              {call->argument(0)},
-                                             inv);
+                                             queries);
     }
     case ar::Intrinsic::LibcppNew:
     case ar::Intrinsic::LibcppNewArray: {
@@ -476,13 +485,13 @@ std::vector< SoundnessChecker::CheckResult > SoundnessChecker::
     }
     case ar::Intrinsic::LibcppDelete:
     case ar::Intrinsic::LibcppDeleteArray: {
-      return to_vector(this->check_free(call, call->argument(0), inv));
+      return to_vector(this->check_free(call, call->argument(0), queries));
     }
     case ar::Intrinsic::LibcppAllocateException: {
       return {};
     }
     case ar::Intrinsic::LibcppFreeException: {
-      return to_vector(this->check_free(call, call->argument(0), inv));
+      return to_vector(this->check_free(call, call->argument(0), queries));
     }
     case ar::Intrinsic::LibcppThrow:
     case ar::Intrinsic::LibcppBeginCatch:
@@ -496,7 +505,8 @@ std::vector< SoundnessChecker::CheckResult > SoundnessChecker::
 }
 
 SoundnessChecker::CheckResult SoundnessChecker::check_unknown_extern_call(
-    ar::CallBase* call, ar::Function* fun, const value::AbstractDomain& inv) {
+    ar::CallBase* call, ar::Function* fun, QueryCache& queries) {
+  const value::AbstractDomain& inv = queries.inv();
   if (inv.is_normal_flow_bottom()) {
     // Statement unreachable
     if (auto msg = this->display_soundness_check(Result::Unreachable, call)) {
@@ -511,14 +521,15 @@ SoundnessChecker::CheckResult SoundnessChecker::check_unknown_extern_call(
   return {CheckKind::IgnoredCallSideEffect,
           Result::Warning,
           {},
-          JsonDict{{"fun_id", _ctx.output_db->functions.insert(fun)}}};
+          JsonDict{{"fun_id", this->function_id(fun)}}};
 }
 
 boost::optional< SoundnessChecker::CheckResult > SoundnessChecker::
     check_mem_write(ar::Statement* stmt,
                     ar::Value* pointer,
                     CheckKind access_kind,
-                    const value::AbstractDomain& inv) {
+                    QueryCache& queries) {
+  const value::AbstractDomain& inv = queries.inv();
   if (inv.is_normal_flow_bottom()) {
     // Statement unreachable
     if (auto msg = this->display_soundness_check(Result::Unreachable, stmt)) {
@@ -530,8 +541,8 @@ boost::optional< SoundnessChecker::CheckResult > SoundnessChecker::
   const ScalarLit& ptr = this->_lit_factory.get_scalar(pointer);
 
   // Check uninitialized
-  if (ptr.is_undefined() || (ptr.is_pointer_var() &&
-                             inv.normal().uninit_is_uninitialized(ptr.var()))) {
+  if (ptr.is_undefined() ||
+      (ptr.is_pointer_var() && queries.uninit_is_uninitialized(ptr.var()))) {
     // Undefined pointer operand
     if (auto msg = this->display_soundness_check(Result::Error, stmt)) {
       *msg << ": undefined pointer operand\n";
@@ -541,7 +552,7 @@ boost::optional< SoundnessChecker::CheckResult > SoundnessChecker::
 
   // Check null pointer dereference
   if (ptr.is_null() ||
-      (ptr.is_pointer_var() && inv.normal().nullity_is_null(ptr.var()))) {
+      (ptr.is_pointer_var() && queries.nullity_is_null(ptr.var()))) {
     // Null pointer operand
     if (auto msg = this->display_soundness_check(Result::Error, stmt)) {
       *msg << ": null pointer dereference\n";
@@ -562,7 +573,7 @@ boost::optional< SoundnessChecker::CheckResult > SoundnessChecker::
   }
 
   // Points-to set of the pointer
-  PointsToSet addrs = inv.normal().pointer_to_points_to(ptr.var());
+  PointsToSet addrs = queries.pointer_to_points_to(ptr.var());
 
   if (addrs.is_empty()) {
     // Pointer is invalid
@@ -588,7 +599,8 @@ std::vector< SoundnessChecker::CheckResult > SoundnessChecker::
     check_call_pointer_params(ar::CallBase* call,
                               ar::Function* fun,
                               const std::vector< ar::Value* >& pointers,
-                              const value::AbstractDomain& inv) {
+                              QueryCache& queries) {
+  const value::AbstractDomain& inv = queries.inv();
   if (inv.is_normal_flow_bottom()) {
     // Statement unreachable
     if (auto msg = this->display_soundness_check(Result::Unreachable, call)) {
@@ -607,8 +619,7 @@ std::vector< SoundnessChecker::CheckResult > SoundnessChecker::
 
     // Check uninitialized argument
     if (ptr.is_undefined() ||
-        (ptr.is_pointer_var() &&
-         inv.normal().uninit_is_uninitialized(ptr.var()))) {
+        (ptr.is_pointer_var() && queries.uninit_is_uninitialized(ptr.var()))) {
       // Undefined pointer argument
       if (auto msg = this->display_soundness_check(Result::Error, call)) {
         *msg << ": undefined pointer argument\n";
@@ -618,7 +629,7 @@ std::vector< SoundnessChecker::CheckResult > SoundnessChecker::
 
     // Check null pointer argument
     if (ptr.is_null() ||
-        (ptr.is_pointer_var() && inv.normal().nullity_is_null(ptr.var()))) {
+        (ptr.is_pointer_var() && queries.nullity_is_null(ptr.var()))) {
       // This is sound
       continue;
     }
@@ -637,7 +648,7 @@ std::vector< SoundnessChecker::CheckResult > SoundnessChecker::
     }
 
     // Points-to set of the pointer
-    PointsToSet addrs = inv.normal().pointer_to_points_to(ptr.var());
+    PointsToSet addrs = queries.pointer_to_points_to(ptr.var());
 
     if (addrs.is_empty()) {
       // Pointer is invalid
@@ -659,7 +670,7 @@ std::vector< SoundnessChecker::CheckResult > SoundnessChecker::
           {CheckKind::IgnoredCallSideEffectOnPointerParameter,
            Result::Warning,
            {pointer},
-           JsonDict{{"fun_id", _ctx.output_db->functions.insert(fun)}}});
+           JsonDict{{"fun_id", this->function_id(fun)}}});
     }
   }
 
@@ -667,7 +678,8 @@ std::vector< SoundnessChecker::CheckResult > SoundnessChecker::
 }
 
 boost::optional< SoundnessChecker::CheckResult > SoundnessChecker::check_free(
-    ar::CallBase* call, ar::Value* pointer, const value::AbstractDomain& inv) {
+    ar::CallBase* call, ar::Value* pointer, QueryCache& queries) {
+  const value::AbstractDomain& inv = queries.inv();
   if (inv.is_normal_flow_bottom()) {
     // Statement unreachable
     if (auto msg = this->display_soundness_check(Result::Unreachable, call)) {
@@ -679,8 +691,8 @@ boost::optional< SoundnessChecker::CheckResult > SoundnessChecker::check_free(
   const ScalarLit& ptr = this->_lit_factory.get_scalar(pointer);
 
   // Check uninitialized
-  if (ptr.is_undefined() || (ptr.is_pointer_var() &&
-                             inv.normal().uninit_is_uninitialized(ptr.var()))) {
+  if (ptr.is_undefined() ||
+      (ptr.is_pointer_var() && queries.uninit_is_uninitialized(ptr.var()))) {
     // Undefined pointer operand
     if (auto msg = this->display_soundness_check(Result::Error, call)) {
       *msg << ": undefined pointer operand\n";
@@ -690,7 +702,7 @@ boost::optional< SoundnessChecker::CheckResult > SoundnessChecker::check_free(
 
   // Check null pointer dereference
   if (ptr.is_null() ||
-      (ptr.is_pointer_var() && inv.normal().nullity_is_null(ptr.var()))) {
+      (ptr.is_pointer_var() && queries.nullity_is_null(ptr.var()))) {
     // Null pointer argument, safe
     if (auto msg = this->display_soundness_check(Result::Ok, call)) {
       *msg << ": safe call to free with NULL value\n";
@@ -711,7 +723,7 @@ boost::optional< SoundnessChecker::CheckResult > SoundnessChecker::check_free(
   }
 
   // Points-to set of the pointer
-  PointsToSet addrs = inv.normal().pointer_to_points_to(ptr.var());
+  PointsToSet addrs = queries.pointer_to_points_to(ptr.var());
 
   if (addrs.is_top()) {
     // Ignored memory deallocation because points-to set is top
@@ -60,6 +60,7 @@ const char* UninitializedVariableChecker::description() const {
 
 void UninitializedVariableChecker::check(ar::Statement* stmt,
                                          const value::AbstractDomain& inv,
+                                         QueryCache& queries,
                                          CallContext* call_context) {
   if (inv.is_normal_flow_bottom()) {
     // Statement is unreachable
@@ -96,23 +97,24 @@ void UninitializedVariableChecker::check(ar::Statement* stmt,
 
   if (auto insert = dyn_cast< ar::InsertElement >(stmt)) {
     // InsertElement accepts undefined aggregate operands
-    this->check_initialized(stmt, insert->offset(), inv, call_context);
-    this->check_initialized(stmt, insert->element(), inv, call_context);
+    this->check_initialized(stmt, insert->offset(), queries, call_context);
+    this->check_initialized(stmt, insert->element(), queries, call_context);
     return;
   }
 
   // Check each operand
   for (auto it = stmt->op_begin(), et = stmt->op_end(); it != et; ++it) {
-    this->check_initialized(stmt, *it, inv, call_context);
+    this->check_initialized(stmt, *it, queries, call_context);
   }
 }
 
 void UninitializedVariableChecker::check_initialized(
     ar::Statement* stmt,
     ar::Value* operand,
-    const value::AbstractDomain& inv,
+    QueryCache& queries,
     CallContext* call_context) {
-  if (auto result = this->check_initialized(operand, inv)) {
+  const value::AbstractDomain& inv = queries.inv();
+  if (auto result = this->check_initialized(operand, queries)) {
     this->display_initialized_check(*result, stmt, operand);
     this->display_invariant(*result, stmt, inv);
     this->_checks.insert(CheckKind::UninitializedVariable,
@@ -125,7 +127,7 @@ void UninitializedVariableChecker::check_initialized(
 }
 
 boost::optional< Result > UninitializedVariableChecker::check_initialized(
-    ar::Value* operand, const value::AbstractDomain& inv) {
+    ar::Value* operand, QueryCache& queries) {
   if (isa< ar::UndefinedConstant >(operand)) {
     return Result::Error;
   } else if (isa< ar::IntegerConstant >(operand)) {
@@ -152,7 +154,7 @@ boost::optional< Result > UninitializedVariableChecker::check_initialized(
     return Result::Ok;
   } else if (auto iv = dyn_cast< ar::InternalVariable >(operand)) {
     Variable* var = _ctx.var_factory->get_internal(iv);
-    core::Uninitialized uninit = inv.normal().uninit_to_uninitialized(var);
+    core::Uninitialized uninit = queries.uninit_to_uninitialized(var);
 
     if (uninit.is_uninitialized()) {
       return Result::Error;
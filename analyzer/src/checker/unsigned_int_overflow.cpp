@@ -59,13 +59,14 @@ const char* UnsignedIntOverflowChecker::description() const {
 
 void UnsignedIntOverflowChecker::check(ar::Statement* stmt,
                                        const value::AbstractDomain& inv,
+                                       QueryCache& queries,
                                        CallContext* call_context) {
   if (auto bin = dyn_cast< ar::BinaryOperation >(stmt)) {
     if (bin->op() == ar::BinaryOperation::UAdd ||
         bin->op() == ar::BinaryOperation::USub ||
         bin->op() == ar::BinaryOperation::UMul ||
         bin->op() == ar::BinaryOperation::UDiv) {
-      this->check_integer_overflow(bin, inv, call_context);
+      this->check_integer_overflow(bin, queries, call_context);
     }
   }
 }
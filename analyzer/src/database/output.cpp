@@ -60,5 +60,14 @@ OutputDatabase::OutputDatabase(sqlite::DbConnection& db_)
   this->db.set_commit_policy(sqlite::CommitPolicy::Auto);
 }
 
+void OutputDatabase::set_first_id(sqlite::DbInt64 id) {
+  this->files.set_next_id(id);
+  this->statements.set_next_id(id);
+  this->operands.set_next_id(id);
+  this->call_contexts.set_next_id(id);
+  this->memory_locations.set_next_id(id);
+  this->checks.set_next_id(id);
+}
+
 } // end namespace analyzer
 } // end namespace ikos
@@ -0,0 +1,218 @@
+/*******************************************************************************
+ *
+ * \file
+ * \brief Compact binary results file
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#include <cstring>
+#include <string>
+#include <tuple>
+#include <utility>
+
+#include <llvm/Support/Endian.h>
+
+#include <ikos/analyzer/database/results_file.hpp>
+
+namespace ikos {
+namespace analyzer {
+namespace results_file {
+
+// Error
+
+const char* Error::what() const noexcept {
+  return this->_msg->c_str();
+}
+
+Error::~Error() = default;
+
+bool has_magic(llvm::StringRef buffer) {
+  return buffer.size() >= sizeof(Magic) &&
+         std::memcmp(buffer.data(), Magic, sizeof(Magic)) == 0;
+}
+
+// Reader
+
+namespace {
+
+/// \brief Read a uint8 at the given address
+std::uint8_t read8(const char* p) {
+  return static_cast< std::uint8_t >(*p);
+}
+
+/// \brief Read a little-endian uint32 at the given address
+std::uint32_t read32(const char* p) {
+  return llvm::support::endian::read32le(p);
+}
+
+/// \brief Read a little-endian uint64 at the given address
+std::uint64_t read64(const char* p) {
+  return llvm::support::endian::read64le(p);
+}
+
+} // end anonymous namespace
+
+Reader::Reader(const std::string& filename) {
+  llvm::ErrorOr< std::unique_ptr< llvm::MemoryBuffer > > buffer =
+      llvm::MemoryBuffer::getFile(filename,
+                                  /*IsText=*/false,
+                                  /*RequiresNullTerminator=*/false);
+  if (!buffer) {
+    throw Error("could not open '" + filename +
+                "': " + buffer.getError().message());
+  }
+  this->_buffer = std::move(*buffer);
+
+  const char* begin = this->_buffer->getBufferStart();
+  std::size_t size = this->_buffer->getBufferSize();
+
+  if (size < HeaderSize + FooterSize ||
+      !has_magic(this->_buffer->getBuffer()) ||
+      !has_magic(llvm::StringRef(begin + size - sizeof(Magic),
+                                 sizeof(Magic)))) {
+    throw Error("'" + filename + "' is not a results file");
+  }
+  if (read32(begin + sizeof(Magic)) != Version) {
+    throw Error("'" + filename + "' has an unsupported version");
+  }
+
+  const char* footer = begin + size - FooterSize;
+
+  // Return the beginning of a section, checking its bounds
+  auto section = [&](std::size_t field, std::size_t element_size) {
+    std::uint64_t offset = read64(footer + field * 16);
+    std::uint64_t count = read64(footer + field * 16 + 8);
+    std::uint64_t limit = size - FooterSize;
+    if (offset < HeaderSize || offset > limit ||
+        count > (limit - offset) / element_size) {
+      throw Error("'" + filename + "' is corrupted");
+    }
+    return std::make_pair(begin + offset, static_cast< std::size_t >(count));
+  };
+
+  std::tie(this->_checks, this->_num_checks) = section(0, CheckRecordSize);
+  std::tie(this->_operands, this->_num_operands) =
+      section(1, OperandRecordSize);
+  std::tie(this->_statements, this->_num_statements) =
+      section(2, StatementRecordSize);
+  std::tie(this->_call_contexts, this->_num_call_contexts) =
+      section(3, CallContextRecordSize);
+
+  const char* string_offsets = nullptr;
+  std::size_t num_string_offsets = 0;
+  std::tie(string_offsets, num_string_offsets) = section(4, 8);
+  if (num_string_offsets == 0) {
+    throw Error("'" + filename + "' is corrupted");
+  }
+  this->_string_offsets = string_offsets;
+  this->_num_strings = num_string_offsets - 1;
+
+  std::uint64_t data_offset = read64(footer + 5 * 16);
+  std::uint64_t data_size = read64(string_offsets + this->_num_strings * 8);
+  if (data_offset < HeaderSize || data_offset > size - FooterSize ||
+      data_size > size - FooterSize - data_offset) {
+    throw Error("'" + filename + "' is corrupted");
+  }
+  this->_string_data = begin + data_offset;
+  this->_string_data_size = static_cast< std::size_t >(data_size);
+}
+
+Reader::~Reader() = default;
+
+CheckRecord Reader::check(std::size_t i) const {
+  if (i >= this->_num_checks) {
+    throw Error("invalid check index " + std::to_string(i));
+  }
+  const char* p = this->_checks + i * CheckRecordSize;
+  return CheckRecord{static_cast< CheckKind >(read8(p)),
+                     static_cast< CheckerName >(read8(p + 1)),
+                     static_cast< Result >(read8(p + 2)),
+                     read32(p + 4),
+                     read32(p + 8),
+                     read32(p + 12),
+                     read32(p + 16),
+                     read32(p + 20)};
+}
+
+OperandRecord Reader::operand(std::size_t i) const {
+  if (i >= this->_num_operands) {
+    throw Error("invalid operand index " + std::to_string(i));
+  }
+  const char* p = this->_operands + i * OperandRecordSize;
+  return OperandRecord{static_cast< std::int32_t >(read32(p)), read32(p + 4)};
+}
+
+StatementRecord Reader::statement(std::size_t i) const {
+  if (i >= this->_num_statements) {
+    throw Error("invalid statement index " + std::to_string(i));
+  }
+  const char* p = this->_statements + i * StatementRecordSize;
+  return StatementRecord{read32(p),
+                         read32(p + 4),
+                         read32(p + 8),
+                         read32(p + 12)};
+}
+
+CallContextRecord Reader::call_context(std::size_t i) const {
+  if (i >= this->_num_call_contexts) {
+    throw Error("invalid call context index " + std::to_string(i));
+  }
+  const char* p = this->_call_contexts + i * CallContextRecordSize;
+  return CallContextRecord{read32(p), read32(p + 4)};
+}
+
+llvm::StringRef Reader::string(std::uint32_t i) const {
+  if (i == NoIndex) {
+    return {};
+  }
+  if (i >= this->_num_strings) {
+    throw Error("invalid string index " + std::to_string(i));
+  }
+  std::uint64_t begin = read64(this->_string_offsets + i * 8);
+  std::uint64_t end = read64(this->_string_offsets + (i + 1) * 8);
+  if (begin > end || end > this->_string_data_size) {
+    return {};
+  }
+  return llvm::StringRef(this->_string_data + begin,
+                         static_cast< std::size_t >(end - begin));
+}
+
+} // end namespace results_file
+} // end namespace analyzer
+} // end namespace ikos
@@ -0,0 +1,297 @@
+/*******************************************************************************
+ *
+ * \file
+ * \brief Writer of compact binary results files
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#include <algorithm>
+#include <utility>
+
+#include <llvm/Support/EndianStream.h>
+#include <llvm/Support/FileSystem.h>
+
+#include <ikos/analyzer/database/results_file.hpp>
+#include <ikos/analyzer/database/table/functions.hpp>
+#include <ikos/analyzer/database/table/operands.hpp>
+#include <ikos/analyzer/support/assert.hpp>
+#include <ikos/analyzer/util/demangle.hpp>
+#include <ikos/analyzer/util/source_location.hpp>
+
+namespace ikos {
+namespace analyzer {
+namespace results_file {
+
+namespace {
+
+/// \brief Write a uint8
+void write8(llvm::raw_ostream& out, std::uint8_t v) {
+  out << static_cast< char >(v);
+}
+
+/// \brief Write a little-endian uint32
+void write32(llvm::raw_ostream& out, std::uint32_t v) {
+  llvm::support::endian::write(out, v, llvm::support::little);
+}
+
+/// \brief Write a little-endian uint64
+void write64(llvm::raw_ostream& out, std::uint64_t v) {
+  llvm::support::endian::write(out, v, llvm::support::little);
+}
+
+} // end anonymous namespace
+
+Writer::Writer(std::string filename) : _filename(std::move(filename)) {
+  std::error_code ec;
+  this->_out = std::make_unique< llvm::raw_fd_ostream >(this->_filename,
+                                                        ec,
+                                                        llvm::sys::fs::OF_None);
+  if (ec) {
+    throw Error("could not create '" + this->_filename + "': " + ec.message());
+  }
+
+  // Header
+  this->_out->write(Magic, sizeof(Magic));
+  write32(*this->_out, Version);
+  write32(*this->_out, 0);
+}
+
+Writer::~Writer() {
+  // raw_fd_ostream aborts on destruction if an error was not handled
+  if (this->_out != nullptr) {
+    this->_out->clear_error();
+  }
+}
+
+void Writer::write(CheckKind kind,
+                   CheckerName checker,
+                   Result status,
+                   ar::Statement* stmt,
+                   CallContext* call_context,
+                   llvm::ArrayRef< ar::Value* > operands,
+                   const std::string& info) {
+  ikos_assert(this->_out != nullptr);
+
+  auto operands_begin = static_cast< std::uint32_t >(this->_operands.size());
+  if (status == Result::Warning || status == Result::Error) {
+    for (ar::Value* operand : operands) {
+      // Find operand number
+      auto it = std::find(stmt->op_begin(), stmt->op_end(), operand);
+      std::int32_t operand_no = -1;
+      if (it != stmt->op_end()) {
+        operand_no = static_cast< std::int32_t >(it - stmt->op_begin());
+      }
+      this->_operands.push_back(
+          OperandRecord{operand_no, this->operand(operand)});
+    }
+  }
+  auto operands_count =
+      static_cast< std::uint32_t >(this->_operands.size()) - operands_begin;
+
+  llvm::raw_ostream& out = *this->_out;
+  write8(out, static_cast< std::uint8_t >(kind));
+  write8(out, static_cast< std::uint8_t >(checker));
+  write8(out, static_cast< std::uint8_t >(status));
+  write8(out, 0);
+  write32(out, this->statement(stmt));
+  write32(out, this->call_context(call_context));
+  write32(out, info.empty() ? NoIndex : this->string(info));
+  write32(out, operands_count > 0 ? operands_begin : 0);
+  write32(out, operands_count);
+  this->_num_checks++;
+}
+
+void Writer::close() {
+  ikos_assert(this->_out != nullptr);
+  llvm::raw_fd_ostream& out = *this->_out;
+
+  std::uint64_t checks_offset = HeaderSize;
+
+  std::uint64_t operands_offset = out.tell();
+  for (const OperandRecord& operand : this->_operands) {
+    write32(out, static_cast< std::uint32_t >(operand.number));
+    write32(out, operand.repr);
+  }
+
+  std::uint64_t statements_offset = out.tell();
+  for (const StatementRecord& stmt : this->_statements) {
+    write32(out, stmt.function);
+    write32(out, stmt.file);
+    write32(out, stmt.line);
+    write32(out, stmt.column);
+  }
+
+  std::uint64_t call_contexts_offset = out.tell();
+  for (const CallContextRecord& call_context : this->_call_contexts) {
+    write32(out, call_context.call);
+    write32(out, call_context.parent);
+  }
+
+  std::uint64_t string_offsets_offset = out.tell();
+  std::uint64_t string_offset = 0;
+  for (llvm::StringRef str : this->_strings) {
+    write64(out, string_offset);
+    string_offset += str.size();
+  }
+  write64(out, string_offset);
+
+  std::uint64_t string_data_offset = out.tell();
+  for (llvm::StringRef str : this->_strings) {
+    out << str;
+  }
+
+  // Footer
+  write64(out, checks_offset);
+  write64(out, this->_num_checks);
+  write64(out, operands_offset);
+  write64(out, this->_operands.size());
+  write64(out, statements_offset);
+  write64(out, this->_statements.size());
+  write64(out, call_contexts_offset);
+  write64(out, this->_call_contexts.size());
+  write64(out, string_offsets_offset);
+  write64(out, this->_strings.size() + 1);
+  write64(out, string_data_offset);
+  out.write(Magic, sizeof(Magic));
+
+  out.close();
+  if (out.has_error()) {
+    std::string msg = out.error().message();
+    out.clear_error();
+    this->_out.reset();
+    throw Error("could not write '" + this->_filename + "': " + msg);
+  }
+  this->_out.reset();
+}
+
+std::uint32_t Writer::string(llvm::StringRef str) {
+  auto res = this->_string_map.try_emplace(
+      str, static_cast< std::uint32_t >(this->_strings.size()));
+  if (res.second) {
+    // Keys of a StringMap are stable
+    this->_strings.push_back(res.first->getKey());
+  }
+  return res.first->second;
+}
+
+std::uint32_t Writer::statement(ar::Statement* stmt) {
+  ikos_assert(stmt != nullptr);
+
+  auto it = this->_statement_map.find(stmt);
+  if (it != this->_statement_map.end()) {
+    return it->second;
+  }
+
+  ar::Code* code = stmt->parent()->code();
+  ikos_assert(code->is_function_body());
+  StatementRecord record{this->function(code->function()), NoIndex, 0, 0};
+
+  ikos_assert(stmt->has_frontend());
+  SourceLocation loc = source_location(stmt);
+  if (loc) {
+    record.file = this->file(loc.file());
+    record.line = loc.line();
+    record.column = loc.column();
+  }
+
+  auto id = static_cast< std::uint32_t >(this->_statements.size());
+  this->_statements.push_back(record);
+  this->_statement_map.try_emplace(stmt, id);
+  return id;
+}
+
+std::uint32_t Writer::call_context(CallContext* call_context) {
+  ikos_assert(call_context != nullptr);
+
+  auto it = this->_call_context_map.find(call_context);
+  if (it != this->_call_context_map.end()) {
+    return it->second;
+  }
+
+  // Insert the parent first
+  CallContextRecord record{NoIndex, NoIndex};
+  if (!call_context->empty()) {
+    record.parent = this->call_context(call_context->parent());
+    record.call = this->statement(call_context->call());
+  }
+
+  auto id = static_cast< std::uint32_t >(this->_call_contexts.size());
+  this->_call_contexts.push_back(record);
+  this->_call_context_map.try_emplace(call_context, id);
+  return id;
+}
+
+std::uint32_t Writer::function(ar::Function* fun) {
+  auto it = this->_function_map.find(fun);
+  if (it != this->_function_map.end()) {
+    return it->second;
+  }
+
+  StringRef name = FunctionsTable::name(fun);
+  std::uint32_t id = this->string(demangle(name));
+  this->_function_map.try_emplace(fun, id);
+  return id;
+}
+
+std::uint32_t Writer::file(llvm::DIFile* file) {
+  auto it = this->_file_map.find(file);
+  if (it != this->_file_map.end()) {
+    return it->second;
+  }
+
+  // llvm::DIFile* are not unique, the string table deduplicates paths
+  std::uint32_t id = this->string(source_path(file).string());
+  this->_file_map.try_emplace(file, id);
+  return id;
+}
+
+std::uint32_t Writer::operand(ar::Value* value) {
+  auto it = this->_operand_map.find(value);
+  if (it != this->_operand_map.end()) {
+    return it->second;
+  }
+
+  std::uint32_t id = this->string(OperandsTable::repr(value));
+  this->_operand_map.try_emplace(value, id);
+  return id;
+}
+
+} // end namespace results_file
+} // end namespace analyzer
+} // end namespace ikos
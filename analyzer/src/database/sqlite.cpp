@@ -43,7 +43,14 @@
  *
  ******************************************************************************/
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
 #include <sstream>
+#include <thread>
+
+#include <tbb/concurrent_queue.h>
 
 #include <ikos/core/support/compiler.hpp>
 
@@ -161,8 +168,148 @@ const char* column_type_str(DbColumnType t) {
   }
 }
 
+// DbWriter
+
+/// \brief Writer thread inserting the rows of output streams
+class DbWriter {
+private:
+  /// \brief Rows to insert, or a request to stop if ostream is null
+  struct Job {
+    DbOstream* ostream = nullptr;
+    std::vector< DbOstream::Value > values;
+  };
+
+private:
+  /// \brief Database connection
+  DbConnection& _db;
+
+  /// \brief Queue of jobs
+  tbb::concurrent_bounded_queue< Job > _queue;
+
+  /// \brief Mutex for _pending_jobs and _error
+  std::mutex _mutex;
+
+  /// \brief Notified when there is no pending job
+  std::condition_variable _idle;
+
+  /// \brief Number of queued or running jobs
+  std::size_t _pending_jobs = 0;
+
+  /// \brief First error raised on the writer thread, or null
+  std::exception_ptr _error;
+
+  /// \brief Whether queued rows are dropped instead of inserted
+  std::atomic< bool > _drop{false};
+
+  /// \brief Writer thread
+  std::thread _thread;
+
+public:
+  /// \brief Constructor
+  DbWriter(DbConnection& db, std::size_t capacity) : _db(db) {
+    this->_queue.set_capacity(static_cast< std::ptrdiff_t >(capacity));
+    this->_thread = std::thread([this] { this->run(); });
+  }
+
+  /// \brief No copy constructor
+  DbWriter(const DbWriter&) = delete;
+
+  /// \brief No move constructor
+  DbWriter(DbWriter&&) = delete;
+
+  /// \brief No copy assignment operator
+  DbWriter& operator=(const DbWriter&) = delete;
+
+  /// \brief No move assignment operator
+  DbWriter& operator=(DbWriter&&) = delete;
+
+  /// \brief Destructor
+  ///
+  /// Drop the queued rows and stop the writer thread.
+  ~DbWriter() {
+    this->_drop = true;
+    this->_queue.push(Job{});
+    this->_thread.join();
+  }
+
+  /// \brief Queue rows of the given output stream
+  ///
+  /// Blocks if the queue is full.
+  void push(DbOstream* ostream, std::vector< DbOstream::Value > values) {
+    {
+      std::lock_guard< std::mutex > lock(this->_mutex);
+      this->rethrow();
+      this->_pending_jobs++;
+    }
+    this->_queue.push(Job{ostream, std::move(values)});
+  }
+
+  /// \brief Wait until all the queued rows are inserted
+  void wait() {
+    std::unique_lock< std::mutex > lock(this->_mutex);
+    this->_idle.wait(lock, [this] { return this->_pending_jobs == 0; });
+    this->rethrow();
+  }
+
+  /// \brief Drop the queued rows and the rows queued afterwards
+  ///
+  /// Lazy texts of the dropped rows are not evaluated. Returns when the row
+  /// being inserted, if any, is done.
+  void drop() {
+    this->_drop = true;
+    std::unique_lock< std::mutex > lock(this->_mutex);
+    this->_idle.wait(lock, [this] { return this->_pending_jobs == 0; });
+  }
+
+private:
+  /// \brief Throw the error raised on the writer thread, if any
+  ///
+  /// The mutex must be held.
+  void rethrow() {
+    if (this->_error) {
+      std::exception_ptr error = this->_error;
+      this->_error = nullptr;
+      std::rethrow_exception(error);
+    }
+  }
+
+  /// \brief Main loop of the writer thread
+  void run() {
+    while (true) {
+      Job job;
+      this->_queue.pop(job);
+
+      if (job.ostream == nullptr) {
+        return;
+      }
+
+      std::exception_ptr error;
+      if (!this->_drop) {
+        try {
+          std::lock_guard< std::mutex > lock(this->_db._mutex);
+          job.ostream->insert(job.values);
+        } catch (...) {
+          error = std::current_exception();
+        }
+      }
+
+      std::lock_guard< std::mutex > lock(this->_mutex);
+      if (error && !this->_error) {
+        this->_error = error;
+      }
+      if (--this->_pending_jobs == 0) {
+        this->_idle.notify_all();
+      }
+    }
+  }
+
+}; // end class DbWriter
+
 // DbConnection
 
+const int DbConnection::MaxRowsPerInsert;
+const std::size_t DbConnection::DefaultWriterCapacity;
+
 DbConnection::DbConnection(std::string filename)
     : _filename(std::move(filename)) {
   int status = sqlite3_open_v2(this->_filename.c_str(),
@@ -177,6 +324,10 @@ DbConnection::DbConnection(std::string filename)
 
 DbConnection::~DbConnection() {
   // The destructor shall not throw an exception. No error check.
+  //
+  // Rows still queued on the writer thread are dropped, see stop_writer().
+  this->_writer.reset();
+
   if (this->_commit_policy == CommitPolicy::Auto) {
     sqlite3_exec(this->_handle, "COMMIT", nullptr, nullptr, nullptr);
   }
@@ -226,9 +377,51 @@ void DbConnection::set_commit_policy(CommitPolicy policy) {
   }
 }
 
-void DbConnection::row_inserted() {
+void DbConnection::begin_bulk_load() {
+  ikos_assert(!this->_bulk_load);
+  this->_bulk_load = true;
+}
+
+void DbConnection::end_bulk_load() {
+  ikos_assert(this->_bulk_load);
+
+  this->wait_writer();
+
+  {
+    std::lock_guard< std::mutex > lock(this->_mutex);
+    for (DbOstream* ostream : this->_ostreams) {
+      ostream->end_bulk_load();
+    }
+  }
+
+  this->_bulk_load = false;
+
+  for (const std::string& cmd : this->_deferred_indexes) {
+    this->exec_command(cmd);
+  }
+  this->_deferred_indexes.clear();
+}
+
+void DbConnection::start_writer(std::size_t capacity) {
+  ikos_assert(this->_writer == nullptr);
+  ikos_assert(capacity > 0);
+  this->_writer = std::make_unique< DbWriter >(*this, capacity);
+}
+
+void DbConnection::wait_writer() {
+  if (this->_writer != nullptr) {
+    this->_writer->wait();
+  }
+}
+
+void DbConnection::stop_writer() {
+  this->wait_writer();
+  this->_writer.reset();
+}
+
+void DbConnection::rows_inserted(std::size_t n) {
   if (this->_commit_policy == CommitPolicy::Auto) {
-    this->_inserted_rows++;
+    this->_inserted_rows += n;
 
     if (this->_inserted_rows >= MaxRowsPerTransaction) {
       this->exec_command("COMMIT");
@@ -282,6 +475,12 @@ void DbConnection::create_index(StringRef index,
   cmd += '(';
   cmd += column;
   cmd += ')';
+
+  if (this->_bulk_load) {
+    this->_deferred_indexes.push_back(std::move(cmd));
+    return;
+  }
+
   this->exec_command(cmd.c_str());
 }
 
@@ -327,40 +526,110 @@ void DbConnection::set_synchronous_flag(SynchronousFlag flag) {
 
 // DbOstream
 
+/// \brief Execute an INSERT statement and reset it
+static void step_insert(sqlite3_stmt* stmt, const char* context) {
+  int status = sqlite3_step(stmt);
+  if (status != SQLITE_DONE) {
+    throw DbError(status, std::string(context) + ": step failed");
+  }
+
+  status = sqlite3_clear_bindings(stmt);
+  if (status != SQLITE_OK) {
+    throw DbError(status, std::string(context) + ": clear bindings failed");
+  }
+
+  status = sqlite3_reset(stmt);
+  if (status != SQLITE_OK) {
+    throw DbError(status, std::string(context) + ": reset failed");
+  }
+}
+
 DbOstream::DbOstream(DbConnection& db, StringRef table_name, int columns)
     : _db(db), _columns(columns) {
   ikos_assert_msg(columns > 0, "invalid number of columns");
 
+  this->_stmt = this->prepare(table_name, 1);
+  this->_buffered = this->_db._bulk_load || this->_db._writer != nullptr;
+
+  if (this->_db._bulk_load) {
+    // Insert as many rows as possible per statement, within the limit on the
+    // number of parameters
+    int max_params =
+        sqlite3_limit(this->_db._handle, SQLITE_LIMIT_VARIABLE_NUMBER, -1);
+    this->_batch_rows = std::max(1,
+                                 std::min(DbConnection::MaxRowsPerInsert,
+                                          max_params / columns));
+    if (this->_batch_rows > 1) {
+      this->_batch_stmt = this->prepare(table_name, this->_batch_rows);
+      this->_pending.reserve(
+          static_cast< std::size_t >(this->_batch_rows * columns));
+    }
+  }
+
+  std::lock_guard< std::mutex > lock(this->_db._mutex);
+  this->_db._ostreams.push_back(this);
+}
+
+DbOstream::~DbOstream() {
+  // The destructor shall not throw an exception.
+  //
+  // Rows that are not inserted yet are dropped: they might hold lazy texts
+  // referring to objects that are already destroyed, e.g during stack
+  // unwinding. See DbConnection::end_bulk_load() and stop_writer().
+  if (this->_db._writer != nullptr) {
+    // Queued rows refer to this output stream
+    this->_db._writer->drop();
+  }
+
+  std::lock_guard< std::mutex > lock(this->_db._mutex);
+  this->_pending.clear();
+  this->_db._ostreams.erase(std::find(this->_db._ostreams.begin(),
+                                      this->_db._ostreams.end(),
+                                      this));
+  sqlite3_finalize(this->_batch_stmt);
+  sqlite3_finalize(this->_stmt);
+}
+
+sqlite3_stmt* DbOstream::prepare(StringRef table_name, int rows) {
   // Create SQL command
   std::string insert("INSERT INTO ");
   insert += table_name;
-  insert += " VALUES (";
-  for (int i = 0; i < columns; i++) {
-    insert += '?';
-    insert += (i + 1 < columns) ? ',' : ')';
+  insert += " VALUES ";
+  for (int r = 0; r < rows; r++) {
+    insert += (r == 0) ? "(" : ",(";
+    for (int i = 0; i < this->_columns; i++) {
+      insert += (i == 0) ? "?" : ",?";
+    }
+    insert += ')';
   }
 
+  sqlite3_stmt* stmt = nullptr;
   int status = sqlite3_prepare_v2(this->_db._handle,
                                   insert.c_str(),
                                   -1,
-                                  &this->_stmt,
+                                  &stmt,
                                   nullptr);
   if (status != SQLITE_OK) {
     throw DbError(status,
                   "DbOstream: cannot populate " + table_name.to_string() +
                       " in database " + this->_db.filename());
   }
-}
-
-DbOstream::~DbOstream() {
-  // The destructor shall not throw an exception. No error check is performed.
-  sqlite3_finalize(_stmt);
+  return stmt;
 }
 
 void DbOstream::add(StringRef s) {
   ikos_assert(s.size() <=
               static_cast< std::size_t >(std::numeric_limits< int >::max()));
 
+  if (this->_buffered) {
+    Value value;
+    value.kind = Value::Kind::Text;
+    value.text = s.to_string();
+    this->_pending.push_back(std::move(value));
+    this->_current_column++;
+    return;
+  }
+
   int status = sqlite3_bind_text(this->_stmt,
                                  this->_current_column++,
                                  s.data(),
@@ -372,6 +641,12 @@ void DbOstream::add(StringRef s) {
 }
 
 void DbOstream::add_null() {
+  if (this->_buffered) {
+    this->_pending.emplace_back();
+    this->_current_column++;
+    return;
+  }
+
   int status = sqlite3_bind_null(this->_stmt, this->_current_column++);
   if (status != SQLITE_OK) {
     throw DbError(status, "DbOstream::add_null()");
@@ -379,6 +654,15 @@ void DbOstream::add_null() {
 }
 
 void DbOstream::add(DbInt64 n) {
+  if (this->_buffered) {
+    Value value;
+    value.kind = Value::Kind::Integer;
+    value.integer = n;
+    this->_pending.push_back(std::move(value));
+    this->_current_column++;
+    return;
+  }
+
   int status = sqlite3_bind_int64(this->_stmt, this->_current_column++, n);
   if (status != SQLITE_OK) {
     throw DbError(status, "DbOstream::add(DbInt64)");
@@ -386,34 +670,147 @@ void DbOstream::add(DbInt64 n) {
 }
 
 void DbOstream::add(DbDouble d) {
+  if (this->_buffered) {
+    Value value;
+    value.kind = Value::Kind::Real;
+    value.real = d;
+    this->_pending.push_back(std::move(value));
+    this->_current_column++;
+    return;
+  }
+
   int status = sqlite3_bind_double(this->_stmt, this->_current_column++, d);
   if (status != SQLITE_OK) {
     throw DbError(status, "DbOstream::add(DbDouble)");
   }
 }
 
+void DbOstream::add(DbLazyText text) {
+  if (this->_buffered) {
+    Value value;
+    value.kind = Value::Kind::LazyText;
+    value.lazy_text = std::move(text);
+    this->_pending.push_back(std::move(value));
+    this->_current_column++;
+    return;
+  }
+
+  this->add(StringRef(text()));
+}
+
 void DbOstream::flush() {
   ikos_assert_msg(this->_current_column == this->_columns + 1,
                   "incomplete row");
   ikos_ignore(this->_columns);
 
-  int status = sqlite3_step(this->_stmt);
-  if (status != SQLITE_DONE) {
-    throw DbError(status, "DbOstream::flush(): step failed");
+  this->_current_column = 1;
+
+  if (this->_buffered) {
+    if (this->_pending.size() <
+        static_cast< std::size_t >(this->_batch_rows * this->_columns)) {
+      return;
+    }
+
+    if (this->_db._writer != nullptr) {
+      // Insert the rows on the writer thread
+      std::vector< Value > values;
+      values.reserve(this->_pending.size());
+      values.swap(this->_pending);
+      this->_db._writer->push(this, std::move(values));
+      return;
+    }
+
+    std::lock_guard< std::mutex > lock(this->_db._mutex);
+    this->insert_pending();
+    return;
   }
 
-  status = sqlite3_clear_bindings(this->_stmt);
+  std::lock_guard< std::mutex > lock(this->_db._mutex);
+  step_insert(this->_stmt, "DbOstream::flush()");
+  this->_db.rows_inserted(1);
+}
+
+void DbOstream::bind(sqlite3_stmt* stmt, int index, const Value& value) {
+  int status = SQLITE_OK;
+  switch (value.kind) {
+    case Value::Kind::Null: {
+      status = sqlite3_bind_null(stmt, index);
+    } break;
+    case Value::Kind::Integer: {
+      status = sqlite3_bind_int64(stmt, index, value.integer);
+    } break;
+    case Value::Kind::Real: {
+      status = sqlite3_bind_double(stmt, index, value.real);
+    } break;
+    case Value::Kind::Text: {
+      status = sqlite3_bind_text(stmt,
+                                 index,
+                                 value.text.data(),
+                                 static_cast< int >(value.text.size()),
+                                 SQLITE_STATIC);
+    } break;
+    case Value::Kind::LazyText: {
+      std::string text = value.lazy_text();
+      status = sqlite3_bind_text(stmt,
+                                 index,
+                                 text.data(),
+                                 static_cast< int >(text.size()),
+                                 SQLITE_TRANSIENT);
+    } break;
+  }
   if (status != SQLITE_OK) {
-    throw DbError(status, "DbOstream::flush(): clear bindings failed");
+    throw DbError(status, "DbOstream::bind()");
   }
+}
 
-  status = sqlite3_reset(this->_stmt);
-  if (status != SQLITE_OK) {
-    throw DbError(status, "DbOstream::flush(): reset failed");
+void DbOstream::insert(std::vector< Value >& values) {
+  auto columns = static_cast< std::size_t >(this->_columns);
+  std::size_t rows = values.size() / columns;
+  if (rows == 0) {
+    return;
   }
 
-  this->_current_column = 1;
-  this->_db.row_inserted();
+  if (this->_batch_stmt != nullptr &&
+      rows == static_cast< std::size_t >(this->_batch_rows)) {
+    // Full batch
+    for (std::size_t i = 0; i < rows * columns; i++) {
+      bind(this->_batch_stmt, static_cast< int >(i + 1), values[i]);
+    }
+    step_insert(this->_batch_stmt, "DbOstream::insert()");
+  } else {
+    // Insert the rows one by one
+    for (std::size_t r = 0; r < rows; r++) {
+      for (std::size_t i = 0; i < columns; i++) {
+        bind(this->_stmt, static_cast< int >(i + 1), values[r * columns + i]);
+      }
+      step_insert(this->_stmt, "DbOstream::insert()");
+    }
+  }
+
+  values.clear();
+  this->_db.rows_inserted(rows);
+}
+
+void DbOstream::end_bulk_load() {
+  ikos_assert_msg(this->_current_column == 1, "incomplete row");
+
+  this->insert_pending();
+  sqlite3_finalize(this->_batch_stmt);
+  this->_batch_stmt = nullptr;
+  this->_batch_rows = 1;
+}
+
+// DbFlushGuard
+
+DbFlushGuard::~DbFlushGuard() {
+  // The destructor shall not throw an exception. Errors are ignored.
+  try {
+    this->_db.stop_writer();
+    if (this->_db.bulk_load()) {
+      this->_db.end_bulk_load();
+    }
+  } catch (...) {
+  }
 }
 
 // DbIstream
@@ -62,6 +62,7 @@ CallContextsTable::CallContextsTable(sqlite::DbConnection& db,
 
 sqlite::DbInt64 CallContextsTable::insert(CallContext* call_context) {
   ikos_assert(call_context != nullptr);
+  std::lock_guard< std::recursive_mutex > lock(this->_mutex);
 
   auto it = this->_map.find(call_context);
   if (it != this->_map.end()) {
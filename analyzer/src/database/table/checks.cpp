@@ -41,11 +41,25 @@
  *
  ******************************************************************************/
 
+#include <iterator>
+
 #include <ikos/analyzer/database/table/checks.hpp>
+#include <ikos/analyzer/support/assert.hpp>
 
 namespace ikos {
 namespace analyzer {
 
+thread_local ChecksTable::Buffer* ChecksTable::CurrentBuffer = nullptr;
+
+ChecksTable::ScopeBuffer::ScopeBuffer(Buffer& buffer)
+    : _prev(ChecksTable::CurrentBuffer) {
+  ChecksTable::CurrentBuffer = &buffer;
+}
+
+ChecksTable::ScopeBuffer::~ScopeBuffer() {
+  ChecksTable::CurrentBuffer = this->_prev;
+}
+
 ChecksTable::ChecksTable(sqlite::DbConnection& db,
                          StatementsTable& statements,
                          OperandsTable& operands,
@@ -73,6 +87,79 @@ void ChecksTable::insert(CheckKind kind,
                          CallContext* call_context,
                          llvm::ArrayRef< ar::Value* > operands,
                          const JsonDict& info) {
+  if (Buffer* buffer = CurrentBuffer) {
+    buffer->_checks.push_back(
+        Buffer::Check{kind,
+                      checker,
+                      status,
+                      stmt,
+                      call_context,
+                      std::vector< ar::Value* >(operands.begin(),
+                                                operands.end()),
+                      info.empty() ? std::string() : info.str()});
+    return;
+  }
+
+  std::lock_guard< std::mutex > lock(this->_mutex);
+  this->write(kind,
+              checker,
+              status,
+              stmt,
+              call_context,
+              operands,
+              info.empty() ? std::string() : info.str());
+}
+
+void ChecksTable::insert(Buffer& buffer) {
+  std::lock_guard< std::mutex > lock(this->_mutex);
+  for (const Buffer::Check& check : buffer._checks) {
+    this->write(check.kind,
+                check.checker,
+                check.status,
+                check.stmt,
+                check.call_context,
+                check.operands,
+                check.info);
+  }
+  buffer._checks.clear();
+  buffer._refers_to_rows = false;
+}
+
+void ChecksTable::mark_row_reference() {
+  if (Buffer* buffer = CurrentBuffer) {
+    buffer->_refers_to_rows = true;
+  }
+}
+
+void ChecksTable::merge(Buffer& buffer) {
+  if (Buffer* current = CurrentBuffer) {
+    ikos_assert(current != &buffer);
+    current->_checks.insert(current->_checks.end(),
+                            std::make_move_iterator(buffer._checks.begin()),
+                            std::make_move_iterator(buffer._checks.end()));
+    current->_refers_to_rows =
+        current->_refers_to_rows || buffer._refers_to_rows;
+    buffer._checks.clear();
+    buffer._refers_to_rows = false;
+    return;
+  }
+
+  this->insert(buffer);
+}
+
+void ChecksTable::write(CheckKind kind,
+                        CheckerName checker,
+                        Result status,
+                        ar::Statement* stmt,
+                        CallContext* call_context,
+                        llvm::ArrayRef< ar::Value* > operands,
+                        const std::string& info) {
+  if (this->_results_file != nullptr) {
+    this->_results_file
+        ->write(kind, checker, status, stmt, call_context, operands, info);
+    return;
+  }
+
   sqlite::DbInt64 id = this->_last_insert_id++;
 
   this->_row << id;
@@ -98,7 +185,7 @@ void ChecksTable::insert(CheckKind kind,
   }
   this->_row << this->_call_contexts.insert(call_context);
   if (!info.empty()) {
-    this->_row << info.str();
+    this->_row << info;
   } else {
     this->_row << sqlite::null;
   }
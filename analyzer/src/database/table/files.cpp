@@ -57,6 +57,7 @@ FilesTable::FilesTable(sqlite::DbConnection& db)
 
 sqlite::DbInt64 FilesTable::insert(llvm::DIFile* file) {
   ikos_assert(file != nullptr);
+  std::lock_guard< std::mutex > lock(this->_mutex);
 
   // Check in _di_file_map
   {
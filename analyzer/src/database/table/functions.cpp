@@ -65,6 +65,7 @@ FunctionsTable::FunctionsTable(sqlite::DbConnection& db, FilesTable& files)
 
 sqlite::DbInt64 FunctionsTable::insert(ar::Function* fun) {
   ikos_assert(fun != nullptr);
+  std::lock_guard< std::mutex > lock(this->_mutex);
 
   auto it = this->_map.find(fun);
   if (it != this->_map.end()) {
@@ -76,22 +76,52 @@ OperandsTable::OperandsTable(sqlite::DbConnection& db)
 
 sqlite::DbInt64 OperandsTable::insert(ar::Value* value) {
   ikos_assert(value != nullptr);
+  std::lock_guard< std::mutex > lock(this->_mutex);
 
   auto it = this->_map.find(value);
   if (it != this->_map.end()) {
     return it->second;
   }
 
-  sqlite::DbInt64 id = this->_last_insert_id++;
-  this->_row << id;
-  this->_row << static_cast< sqlite::DbInt64 >(value->kind());
-  this->_row << repr(value);
-  this->_row << sqlite::end_row;
+  sqlite::DbInt64 id = 0;
+  if (is_scalar_constant(value)) {
+    // Cheap to format, intern on the representation
+    std::string str = repr(value);
+    std::string key = std::to_string(value->kind()) + ":" + str;
+    auto res = this->_constant_map.try_emplace(key, this->_last_insert_id);
+    id = res.first->second;
+    if (res.second) {
+      this->_last_insert_id++;
+      this->_row << id;
+      this->_row << static_cast< sqlite::DbInt64 >(value->kind());
+      this->_row << str;
+      this->_row << sqlite::end_row;
+    }
+  } else {
+    id = this->_last_insert_id++;
+    this->_row << id;
+    this->_row << static_cast< sqlite::DbInt64 >(value->kind());
+    this->_row << sqlite::DbLazyText([value] { return repr(value); });
+    this->_row << sqlite::end_row;
+  }
 
   this->_map.try_emplace(value, id);
   return id;
 }
 
+bool OperandsTable::is_scalar_constant(ar::Value* value) {
+  switch (value->kind()) {
+    case ar::Value::UndefinedConstantKind:
+    case ar::Value::IntegerConstantKind:
+    case ar::Value::FloatConstantKind:
+    case ar::Value::NullConstantKind:
+    case ar::Value::AggregateZeroConstantKind:
+      return true;
+    default:
+      return false;
+  }
+}
+
 namespace detail {
 namespace {
 
@@ -81,15 +81,18 @@
 #include <ikos/analyzer/analysis/option.hpp>
 #include <ikos/analyzer/analysis/pointer/function.hpp>
 #include <ikos/analyzer/analysis/pointer/pointer.hpp>
+#include <ikos/analyzer/analysis/pre_analysis.hpp>
 #include <ikos/analyzer/analysis/result.hpp>
 #include <ikos/analyzer/analysis/value/interprocedural/concurrent/analysis.hpp>
 #include <ikos/analyzer/analysis/value/interprocedural/sequential/analysis.hpp>
+#include <ikos/analyzer/analysis/value/interprocedural/summary/analysis.hpp>
 #include <ikos/analyzer/analysis/value/intraprocedural/concurrent/analysis.hpp>
 #include <ikos/analyzer/analysis/value/intraprocedural/sequential/analysis.hpp>
 #include <ikos/analyzer/analysis/variable.hpp>
 #include <ikos/analyzer/analysis/widening_hint.hpp>
 #include <ikos/analyzer/checker/name.hpp>
 #include <ikos/analyzer/database/output.hpp>
+#include <ikos/analyzer/database/results_file.hpp>
 #include <ikos/analyzer/util/color.hpp>
 #include <ikos/analyzer/util/log.hpp>
 #include <ikos/analyzer/util/timer.hpp>
@@ -111,11 +114,27 @@ static llvm::cl::opt< std::string > InputFilename(
 
 static llvm::cl::opt< std::string > OutputFilename(
     "o",
-    llvm::cl::desc("Output database filename (default: output.db)"),
+    llvm::cl::desc("Output filename (default: output.db)"),
     llvm::cl::value_desc("file"),
     llvm::cl::init("output.db"),
     llvm::cl::cat(MainCategory));
 
+/// \brief Format of the output file
+enum class OutputFormat { Database, Binary };
+
+static llvm::cl::opt< OutputFormat > OutputFormatOpt(
+    "output-format",
+    llvm::cl::desc("Output format:"),
+    llvm::cl::values(
+        clEnumValN(OutputFormat::Database,
+                   "db",
+                   "SQLite database (default)"),
+        clEnumValN(OutputFormat::Binary,
+                   "binary",
+                   "Compact binary results file, holding only the checks")),
+    llvm::cl::init(OutputFormat::Database),
+    llvm::cl::cat(MainCategory));
+
 static llvm::cl::opt< analyzer::LogLevel > LogLevel(
     "log",
     llvm::cl::desc("Log level:"),
@@ -237,6 +256,18 @@ static llvm::cl::opt< analyzer::MachineIntDomainOption > Domain(
                    machine_int_domain_option_str(
                        analyzer::MachineIntDomainOption::DBM),
                    "Difference-Bound Matrices domain"),
+        clEnumValN(analyzer::MachineIntDomainOption::SplitDBM,
+                   machine_int_domain_option_str(
+                       analyzer::MachineIntDomainOption::SplitDBM),
+                   "Sparse Difference-Bound Matrices domain"),
+        clEnumValN(analyzer::MachineIntDomainOption::FixedWidthDBM,
+                   machine_int_domain_option_str(
+                       analyzer::MachineIntDomainOption::FixedWidthDBM),
+                   "Difference-Bound Matrices domain on machine integers"),
+        clEnumValN(analyzer::MachineIntDomainOption::FixedWidthOctagon,
+                   machine_int_domain_option_str(
+                       analyzer::MachineIntDomainOption::FixedWidthOctagon),
+                   "Octagon domain on machine integers"),
         clEnumValN(analyzer::MachineIntDomainOption::VarPackDBM,
                    machine_int_domain_option_str(
                        analyzer::MachineIntDomainOption::VarPackDBM),
@@ -346,7 +377,10 @@ static llvm::cl::opt< analyzer::Procedural > Procedural(
                                 "Interprocedural analysis (default)"),
                      clEnumValN(analyzer::Procedural::Intraprocedural,
                                 "intra",
-                                "Intraprocedural analysis")),
+                                "Intraprocedural analysis"),
+                     clEnumValN(analyzer::Procedural::Summary,
+                                "summary",
+                                "Summary-based interprocedural analysis")),
     llvm::cl::init(analyzer::Procedural::Interprocedural),
     llvm::cl::cat(AnalysisCategory));
 
@@ -355,6 +389,20 @@ static llvm::cl::opt< int > Jobs("j",
                                  llvm::cl::init(1),
                                  llvm::cl::cat(AnalysisCategory));
 
+static llvm::cl::opt< unsigned > ShardCount(
+    "shard-count",
+    llvm::cl::desc("Split the function definitions into the given number of "
+                   "shards\nand only analyze one of them (requires "
+                   "-proc=intra)"),
+    llvm::cl::init(1),
+    llvm::cl::cat(AnalysisCategory));
+
+static llvm::cl::opt< unsigned > ShardIndex(
+    "shard-index",
+    llvm::cl::desc("Index of the shard to analyze, see -shard-count"),
+    llvm::cl::init(0),
+    llvm::cl::cat(AnalysisCategory));
+
 static llvm::cl::opt< analyzer::WideningStrategy > WideningStrategy(
     "widening-strategy",
     llvm::cl::desc("Strategy for increasing iterations"),
@@ -434,6 +482,30 @@ static llvm::cl::opt< bool > NoFixpointCache(
     llvm::cl::desc("Disable the cache of fixpoints"),
     llvm::cl::cat(AnalysisCategory));
 
+static llvm::cl::opt< int > MemoryBudget(
+    "mem-budget",
+    llvm::cl::desc("Memory usage above which fixpoints on called functions "
+                   "are spilled\nto temporary files (requires -proc=inter, "
+                   "default: unlimited)"),
+    llvm::cl::value_desc("MB"),
+    llvm::cl::init(-1),
+    llvm::cl::cat(AnalysisCategory));
+
+static llvm::cl::opt< int > ContextDepth(
+    "context-depth",
+    llvm::cl::desc("Maximum depth of the call contexts, beyond which call "
+                   "contexts\nwith the same last calls are merged "
+                   "(default: unlimited)"),
+    llvm::cl::init(-1),
+    llvm::cl::cat(AnalysisCategory));
+
+static llvm::cl::opt< std::string > SummaryCache(
+    "summary-cache",
+    llvm::cl::desc("Directory of the persistent cache of analysis results "
+                   "(requires -proc=inter or -proc=intra)"),
+    llvm::cl::value_desc("directory"),
+    llvm::cl::cat(AnalysisCategory));
+
 static llvm::cl::opt< bool > NoChecks("no-checks",
                                       llvm::cl::desc("Disable all the checks"),
                                       llvm::cl::cat(AnalysisCategory));
@@ -796,6 +868,8 @@ static analyzer::AnalysisOptions make_analysis_options(ar::Bundle* bundle) {
       .machine_int_domain = Domain,
       .procedural = Procedural,
       .num_threads = Jobs,
+      .shard_count = ShardCount,
+      .shard_index = ShardIndex,
       .widening_strategy = WideningStrategy,
       .narrowing_strategy = NarrowingStrategy,
       .widening_delay = WideningDelay,
@@ -811,6 +885,13 @@ static analyzer::AnalysisOptions make_analysis_options(ar::Bundle* bundle) {
       .use_widening_hints = !NoWideningHints,
       .use_partitioning_domain = EnablePartitioningDomain,
       .use_fixpoint_cache = !NoFixpointCache,
+      .memory_budget =
+          ((MemoryBudget >= 0) ? boost::optional< std::size_t >(
+                                     std::size_t(MemoryBudget) * 1024 * 1024)
+                               : boost::none),
+      .context_depth = ((ContextDepth >= 0)
+                            ? boost::optional< unsigned >(ContextDepth)
+                            : boost::none),
       .use_checks = !NoChecks,
       .trace_ar_statements = TraceARStmts,
       .globals_init_policy = GlobalsInitPolicy,
@@ -819,6 +900,9 @@ static analyzer::AnalysisOptions make_analysis_options(ar::Bundle* bundle) {
       .display_checks = DisplayChecks,
       .hardware_addresses = {bundle, HardwareAddresses, HardwareAddressesFile},
       .argc = ((Argc >= 0) ? boost::optional< int >(Argc) : boost::none),
+      .summary_cache =
+          (!SummaryCache.empty() ? boost::optional< std::string >(SummaryCache)
+                                 : boost::none),
   };
 }
 
@@ -890,14 +974,63 @@ int main(int argc, char** argv) {
   // Enable colors, if asked
   analyzer::color::Enable = colors_enabled();
 
+  if (ShardCount == 0 || ShardIndex >= ShardCount) {
+    llvm::errs() << progname
+                 << ": error: -shard-index must be lower than -shard-count\n";
+    return 1;
+  }
+  if (ShardCount > 1 && Procedural != analyzer::Procedural::Intraprocedural) {
+    llvm::errs() << progname << ": error: -shard-count requires -proc=intra\n";
+    return 1;
+  }
+  if (ContextDepth >= 0 &&
+      Procedural != analyzer::Procedural::Interprocedural) {
+    llvm::errs() << progname
+                 << ": error: -context-depth requires -proc=inter\n";
+    return 1;
+  }
+  if (MemoryBudget >= 0 &&
+      Procedural != analyzer::Procedural::Interprocedural) {
+    llvm::errs() << progname << ": error: -mem-budget requires -proc=inter\n";
+    return 1;
+  }
+  if (Procedural == analyzer::Procedural::Summary && !SummaryCache.empty()) {
+    llvm::errs() << progname
+                 << ": error: -summary-cache cannot be used with "
+                    "-proc=summary\n";
+    return 1;
+  }
+  if (ContextDepth >= 0 && !SummaryCache.empty()) {
+    llvm::errs() << progname
+                 << ": error: -context-depth cannot be used with "
+                    "-summary-cache\n";
+    return 1;
+  }
+
   try {
     // Initialize output database
-    // This might throw DbError, see catch()
-    analyzer::log::debug("Creating output database '" + OutputFilename + "'");
-    analyzer::sqlite::DbConnection db(OutputFilename);
+    //
+    // With a binary output, the database is only kept in memory and the checks
+    // are written in the results file.
+    // This might throw DbError or results_file::Error, see catch()
+    std::string db_filename = OutputFilename;
+    std::unique_ptr< analyzer::results_file::Writer > results_file;
+    if (OutputFormatOpt == OutputFormat::Binary) {
+      analyzer::log::debug("Creating results file '" + OutputFilename + "'");
+      results_file =
+          std::make_unique< analyzer::results_file::Writer >(OutputFilename);
+      db_filename = ":memory:";
+    } else {
+      analyzer::log::debug("Creating output database '" + OutputFilename +
+                           "'");
+    }
+    analyzer::sqlite::DbConnection db(db_filename);
     db.set_journal_mode(analyzer::sqlite::JournalMode::Off);
     db.set_synchronous_flag(analyzer::sqlite::SynchronousFlag::Off);
+    db.begin_bulk_load();
+    db.start_writer();
     analyzer::OutputDatabase output_db(db);
+    output_db.checks.set_results_file(results_file.get());
 
     // Load the input module
     std::unique_ptr< llvm::Module > module = nullptr;
@@ -937,6 +1070,10 @@ int main(int argc, char** argv) {
     // AR context
     ar::Context ar_context;
 
+    // Rows of the output database format AR values lazily, hence they must
+    // be inserted before the AR context is destroyed
+    analyzer::sqlite::DbFlushGuard db_flush_guard(db);
+
     // Translate LLVM bitcode into AR
     // This might throw ImportError, see catch()
     ar::Bundle* bundle = nullptr;
@@ -1026,11 +1163,17 @@ int main(int argc, char** argv) {
     analyzer::AnalysisOptions opts = make_analysis_options(bundle);
     opts.save(output_db.settings);
 
+    // Shards number their rows from distinct bases, so that the coordinator
+    // can merge their output databases
+    if (opts.shard_count > 1) {
+      output_db.set_first_id(analyzer::sqlite::DbInt64(opts.shard_index) << 40);
+    }
+
     // Initialize factories
     analyzer::MemoryFactory mem_factory;
     analyzer::VariableFactory var_factory(bundle);
     analyzer::LiteralFactory lit_factory(var_factory, bundle->data_layout());
-    analyzer::CallContextFactory call_context_factory;
+    analyzer::CallContextFactory call_context_factory(opts.context_depth);
 
     // Fixpoint parameters
     analyzer::FixpointParameters fixpoint_parameters(opts);
@@ -1046,62 +1189,83 @@ int main(int argc, char** argv) {
                           call_context_factory,
                           fixpoint_parameters);
 
-    // Run a liveness analysis
+    // Liveness analysis
     //
     // The goal is to detect unused variables to speed up the following
     // analyses
     analyzer::LivenessAnalysis liveness(ctx);
-    if (!NoLiveness) {
-      analyzer::log::info("Running liveness analysis");
-      analyzer::ScopeTimerDatabase t(output_db.times,
-                                     "ikos-analyzer.liveness-analysis");
-      liveness.run();
-      ctx.liveness = &liveness;
-    }
-    if (DisplayLiveness) {
-      liveness.dump(analyzer::log::msg().stream());
-    }
 
-    // Run a widening hint analysis
+    // Widening hint analysis
     //
     // This is used to detect widening hints, useful for other analyses
-    if (!NoWideningHints) {
-      analyzer::WideningHintAnalysis widening_hint(ctx);
-      analyzer::log::info("Running widening hint analysis");
-      analyzer::ScopeTimerDatabase t(output_db.times,
-                                     "ikos-analyzer.widening-hint-analysis");
-      widening_hint.run();
-    }
-    if (DisplayFixpointParameters) {
-      fixpoint_parameters.dump(analyzer::log::msg().stream());
-    }
+    analyzer::WideningHintAnalysis widening_hint(ctx);
 
-    // Run a fast intraprocedural function pointer analysis
+    // Fast intraprocedural function pointer analysis
     //
     // The goal here is to get all function pointers so that we can analyse
     // precisely indirect calls in the following analyses
     analyzer::FunctionPointerAnalysis function_pointer(ctx);
-    if (Procedural == analyzer::Procedural::Intraprocedural && !NoPointer) {
-      analyzer::log::info("Running function pointer analysis");
-      analyzer::ScopeTimerDatabase t(output_db.times,
-                                     "ikos-analyzer.function-pointer-analysis");
-      function_pointer.run();
-      ctx.function_pointer = &function_pointer;
-    }
-    if (DisplayFunctionPointer) {
-      function_pointer.dump(analyzer::log::msg().stream());
-    }
 
-    // Run a deep (still intraprocedural) pointer analysis
+    // Deep (still intraprocedural) pointer analysis
     //
     // That step uses the result of the previous function pointer analysis.
     analyzer::PointerAnalysis pointer(ctx, function_pointer);
-    if (Procedural == analyzer::Procedural::Intraprocedural && !NoPointer) {
-      analyzer::log::info("Running pointer analysis");
+
+    // The interprocedural analysis computes its own pointer information
+    bool use_pointer =
+        Procedural != analyzer::Procedural::Interprocedural && !NoPointer;
+
+    if (Jobs == 1) {
+      if (!NoLiveness) {
+        analyzer::log::info("Running liveness analysis");
+        analyzer::ScopeTimerDatabase t(output_db.times,
+                                       "ikos-analyzer.liveness-analysis");
+        liveness.run();
+        ctx.liveness = &liveness;
+      }
+
+      if (!NoWideningHints) {
+        analyzer::log::info("Running widening hint analysis");
+        analyzer::ScopeTimerDatabase t(output_db.times,
+                                       "ikos-analyzer.widening-hint-analysis");
+        widening_hint.run();
+      }
+
+      if (use_pointer) {
+        analyzer::log::info("Running function pointer analysis");
+        analyzer::ScopeTimerDatabase
+            t(output_db.times, "ikos-analyzer.function-pointer-analysis");
+        function_pointer.run();
+        ctx.function_pointer = &function_pointer;
+      }
+
+      if (use_pointer) {
+        analyzer::log::info("Running pointer analysis");
+        analyzer::ScopeTimerDatabase t(output_db.times,
+                                       "ikos-analyzer.pointer-analysis");
+        pointer.run();
+        ctx.pointer = &pointer;
+      }
+    } else {
+      analyzer::log::info("Running pre-analyses");
       analyzer::ScopeTimerDatabase t(output_db.times,
-                                     "ikos-analyzer.pointer-analysis");
-      pointer.run();
-      ctx.pointer = &pointer;
+                                     "ikos-analyzer.pre-analysis");
+      analyzer::PreAnalysis(ctx,
+                            NoLiveness ? nullptr : &liveness,
+                            NoWideningHints ? nullptr : &widening_hint,
+                            use_pointer ? &function_pointer : nullptr,
+                            use_pointer ? &pointer : nullptr)
+          .run();
+    }
+
+    if (DisplayLiveness) {
+      liveness.dump(analyzer::log::msg().stream());
+    }
+    if (DisplayFixpointParameters) {
+      fixpoint_parameters.dump(analyzer::log::msg().stream());
+    }
+    if (DisplayFunctionPointer) {
+      function_pointer.dump(analyzer::log::msg().stream());
     }
     if (DisplayPointer) {
       pointer.dump(analyzer::log::msg().stream());
@@ -1126,14 +1290,34 @@ int main(int argc, char** argv) {
       } else {
         analyzer::value::intraprocedural::concurrent::Analysis(ctx).run();
       }
+    } else if (Procedural == analyzer::Procedural::Summary) {
+      analyzer::log::info(
+          "Running summary-based interprocedural value analysis");
+      analyzer::ScopeTimerDatabase t(output_db.times,
+                                     "ikos-analyzer.value-analysis");
+      analyzer::value::interprocedural::summary::Analysis(ctx).run();
     } else {
       ikos_unreachable("unreachable");
     }
+
+    // Insert the remaining rows and create the indexes
+    analyzer::log::debug("Creating indexes in output database");
+    db.stop_writer();
+    db.end_bulk_load();
+
+    if (results_file) {
+      analyzer::log::debug("Writing results file");
+      results_file->close();
+    }
     return 0;
   } catch (analyzer::sqlite::DbError& err) {
     llvm::errs() << progname << ": " << OutputFilename
                  << ": error: " << err.what() << "\n";
     return 1;
+  } catch (analyzer::results_file::Error& err) {
+    llvm::errs() << progname << ": " << OutputFilename
+                 << ": error: " << err.what() << "\n";
+    return 1;
   } catch (llvm_to_ar::ImportError& err) {
     llvm::errs() << progname << ": " << InputFilename
                  << ": error: " << err.what() << "\n";
@@ -0,0 +1,210 @@
+/*******************************************************************************
+ *
+ * ikos-results -- Print the checks of a binary results file
+ *
+ * See ikos-analyzer -output-format=binary
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <string>
+
+#include <boost/filesystem.hpp>
+
+#include <llvm/Support/CommandLine.h>
+#include <llvm/Support/InitLLVM.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <ikos/analyzer/analysis/result.hpp>
+#include <ikos/analyzer/checker/kind.hpp>
+#include <ikos/analyzer/checker/name.hpp>
+#include <ikos/analyzer/database/results_file.hpp>
+
+namespace analyzer = ikos::analyzer;
+namespace results_file = ikos::analyzer::results_file;
+
+static llvm::cl::opt< std::string > InputFilename(
+    llvm::cl::Positional,
+    llvm::cl::desc("<results file>"),
+    llvm::cl::Required,
+    llvm::cl::value_desc("file"));
+
+static llvm::cl::list< analyzer::Result > StatusFilter(
+    "status-filter",
+    llvm::cl::desc("Status of the checks to display (default: "
+                   "error,warning,unreachable):"),
+    llvm::cl::CommaSeparated,
+    llvm::cl::values(clEnumValN(analyzer::Result::Error, "error", "Error"),
+                     clEnumValN(analyzer::Result::Warning,
+                                "warning",
+                                "Warning"),
+                     clEnumValN(analyzer::Result::Ok, "safe", "Safe"),
+                     clEnumValN(analyzer::Result::Unreachable,
+                                "unreachable",
+                                "Unreachable")));
+
+static llvm::cl::list< std::string > AnalysesFilter(
+    "analyses-filter",
+    llvm::cl::desc("Short names of the checkers to display (default: all)"),
+    llvm::cl::CommaSeparated,
+    llvm::cl::value_desc("checker"));
+
+static llvm::cl::opt< bool > DisplayChecks(
+    "display-checks",
+    llvm::cl::desc("Display the checks (default: true)"),
+    llvm::cl::init(true));
+
+static llvm::cl::opt< bool > DisplaySummary(
+    "summary",
+    llvm::cl::desc("Display the number of checks per status"));
+
+static llvm::cl::opt< bool > DisplayInfo(
+    "display-info",
+    llvm::cl::desc("Display the additional information of each check"));
+
+/// \brief Print a check
+static void print_check(llvm::raw_ostream& out,
+                        const results_file::Reader& reader,
+                        const results_file::CheckRecord& check) {
+  results_file::StatementRecord stmt = reader.statement(check.statement);
+
+  if (stmt.file != results_file::NoIndex) {
+    out << reader.string(stmt.file) << ":" << stmt.line << ":" << stmt.column
+        << ": ";
+  }
+  out << analyzer::result_str(check.status) << ": "
+      << analyzer::check_kind_short_name(check.kind) << " ["
+      << analyzer::checker_short_name(check.checker) << "] in function '"
+      << reader.string(stmt.function) << "'";
+
+  for (std::uint32_t i = 0; i < check.operands_count; i++) {
+    results_file::OperandRecord operand =
+        reader.operand(check.operands_begin + i);
+    out << (i == 0 ? " (" : ", ");
+    if (operand.number >= 0) {
+      out << "#" << operand.number << ": ";
+    }
+    out << reader.string(operand.repr);
+    out << (i + 1 == check.operands_count ? ")" : "");
+  }
+
+  if (DisplayInfo && check.info != results_file::NoIndex) {
+    out << " " << reader.string(check.info);
+  }
+  out << "\n";
+}
+
+/// \brief Main for ikos-results
+int main(int argc, char** argv) {
+  llvm::InitLLVM x(argc, argv);
+
+  // Program name
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+  std::string progname = boost::filesystem::path(argv[0]).filename().string();
+
+  const char* overview =
+      "ikos-results -- Print the checks of a binary results file\n\n"
+      "Results files are created by ikos-analyzer -output-format=binary";
+  llvm::cl::ParseCommandLineOptions(argc, argv, overview);
+
+  // Status to display, indexed by analyzer::Result
+  std::array< bool, 4 > display = {false, false, false, false};
+  if (StatusFilter.empty()) {
+    display[static_cast< std::size_t >(analyzer::Result::Error)] = true;
+    display[static_cast< std::size_t >(analyzer::Result::Warning)] = true;
+    display[static_cast< std::size_t >(analyzer::Result::Unreachable)] = true;
+  } else {
+    for (analyzer::Result status : StatusFilter) {
+      display[static_cast< std::size_t >(status)] = true;
+    }
+  }
+
+  try {
+    results_file::Reader reader(InputFilename);
+
+    // Number of checks, indexed by analyzer::Result
+    std::array< std::size_t, 4 > count = {0, 0, 0, 0};
+
+    llvm::raw_ostream& out = llvm::outs();
+    for (std::size_t i = 0; i < reader.num_checks(); i++) {
+      results_file::CheckRecord check = reader.check(i);
+      auto status = static_cast< std::size_t >(check.status);
+      if (status >= count.size() ||
+          check.statement >= reader.num_statements()) {
+        throw results_file::Error("'" + InputFilename + "' is corrupted");
+      }
+      if (!AnalysesFilter.empty() &&
+          std::find(AnalysesFilter.begin(),
+                    AnalysesFilter.end(),
+                    analyzer::checker_short_name(check.checker)) ==
+              AnalysesFilter.end()) {
+        continue;
+      }
+      count[status]++;
+      if (DisplayChecks && display[status]) {
+        print_check(out, reader, check);
+      }
+    }
+
+    if (DisplaySummary) {
+      std::size_t ok = count[static_cast< std::size_t >(analyzer::Result::Ok)];
+      std::size_t warning =
+          count[static_cast< std::size_t >(analyzer::Result::Warning)];
+      std::size_t error =
+          count[static_cast< std::size_t >(analyzer::Result::Error)];
+      std::size_t unreachable =
+          count[static_cast< std::size_t >(analyzer::Result::Unreachable)];
+
+      out << "# Summary:\n";
+      out << "Total number of checks                : "
+          << (ok + warning + error + unreachable) << "\n";
+      out << "Total number of unreachable checks    : " << unreachable << "\n";
+      out << "Total number of safe checks           : " << ok << "\n";
+      out << "Total number of definite unsafe checks: " << error << "\n";
+      out << "Total number of warnings              : " << warning << "\n";
+    }
+
+    return 0;
+  } catch (results_file::Error& err) {
+    llvm::errs() << progname << ": error: " << err.what() << "\n";
+    return 1;
+  }
+}
@@ -68,10 +68,16 @@ void TerminalLogger::end_logger() {
   this->_out.flush();
 }
 
-void TerminalLogger::start_message() {}
+void TerminalLogger::start_message() {
+  // Lock the mutex, unlock in end_message()
+  this->_mutex.lock();
+}
 
 void TerminalLogger::end_message() {
   this->_out.flush();
+
+  // Unlock the mutex
+  this->_mutex.unlock();
 }
 
 // ScopeLogger
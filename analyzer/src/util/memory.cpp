@@ -0,0 +1,97 @@
+/*******************************************************************************
+ *
+ * \file
+ * \brief Memory usage utilities
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+
+#include <llvm/Support/Process.h>
+
+#include <ikos/analyzer/util/memory.hpp>
+
+namespace ikos {
+namespace analyzer {
+
+namespace {
+
+/// \brief Minimum interval between two reads of the memory usage
+constexpr std::chrono::milliseconds SamplingInterval(100);
+
+/// \brief Read the memory used by the process, in bytes
+std::size_t read_memory_usage() {
+#if defined(__linux__)
+  std::ifstream statm("/proc/self/statm");
+  std::size_t size = 0;
+  std::size_t resident = 0;
+  if (statm >> size >> resident) {
+    return resident * llvm::sys::Process::getPageSizeEstimate();
+  }
+#endif
+  // Fall back on the heap size
+  return llvm::sys::Process::GetMallocUsage();
+}
+
+} // end anonymous namespace
+
+std::size_t sampled_memory_usage() {
+  using Clock = std::chrono::steady_clock;
+
+  static std::atomic< Clock::rep > next_sample(0);
+  static std::atomic< std::size_t > usage(0);
+
+  Clock::rep now = Clock::now().time_since_epoch().count();
+  Clock::rep next = next_sample.load(std::memory_order_relaxed);
+  if (now >= next &&
+      next_sample.compare_exchange_strong(
+          next,
+          now + std::chrono::duration_cast< Clock::duration >(SamplingInterval)
+                    .count(),
+          std::memory_order_relaxed)) {
+    // Only one thread reads the memory usage for a given interval
+    usage.store(read_memory_usage(), std::memory_order_relaxed);
+  }
+  return usage.load(std::memory_order_relaxed);
+}
+
+} // end namespace analyzer
+} // end namespace ikos
@@ -65,6 +65,8 @@ InteractiveProgressLogger::InteractiveProgressLogger(std::ostream& out,
       _out_columns(std::max(out_columns, std::size_t{3})) {}
 
 void InteractiveProgressLogger::start_task(StringRef status) {
+  std::lock_guard< std::mutex > lock(this->_mutex);
+
   // Update the current task
   this->_current_task++;
 
@@ -97,12 +99,18 @@ void InteractiveProgressLogger::end_logger() {
 }
 
 void InteractiveProgressLogger::start_message() {
+  // Lock the mutex, unlock in end_message()
+  this->_mutex.lock();
+
   this->erase_line();
 }
 
 void InteractiveProgressLogger::end_message() {
   this->print_status();
   this->_out.flush();
+
+  // Unlock the mutex
+  this->_mutex.unlock();
 }
 
 void InteractiveProgressLogger::erase_line() {
@@ -120,6 +128,7 @@ LinearProgressLogger::LinearProgressLogger(std::ostream& out,
     : ProgressLogger(out), _current_task(0), _num_tasks(num_tasks) {}
 
 void LinearProgressLogger::start_task(StringRef status) {
+  std::lock_guard< std::mutex > lock(this->_mutex);
   this->_current_task++;
   this->_out << "[" << this->_current_task << "/" << this->_num_tasks << "] "
              << status << "\n";
@@ -132,10 +141,16 @@ void LinearProgressLogger::end_logger() {
   this->_out.flush();
 }
 
-void LinearProgressLogger::start_message() {}
+void LinearProgressLogger::start_message() {
+  // Lock the mutex, unlock in end_message()
+  this->_mutex.lock();
+}
 
 void LinearProgressLogger::end_message() {
   this->_out.flush();
+
+  // Unlock the mutex
+  this->_mutex.unlock();
 }
 
 // NoProgressLogger
@@ -150,10 +165,16 @@ void NoProgressLogger::end_logger() {
   this->_out.flush();
 }
 
-void NoProgressLogger::start_message() {}
+void NoProgressLogger::start_message() {
+  // Lock the mutex, unlock in end_message()
+  this->_mutex.lock();
+}
 
 void NoProgressLogger::end_message() {
   this->_out.flush();
+
+  // Unlock the mutex
+  this->_mutex.unlock();
 }
 
 // make_progress_logger
@@ -0,0 +1,233 @@
+/*******************************************************************************
+ *
+ * Benchmark of concurrent lookups in the VariableFactory
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <boost/thread/locks.hpp>
+#include <boost/thread/shared_mutex.hpp>
+
+#include <llvm/ADT/DenseMap.h>
+
+#include <ikos/ar/semantic/bundle.hpp>
+#include <ikos/ar/semantic/context.hpp>
+#include <ikos/ar/semantic/data_layout.hpp>
+#include <ikos/ar/semantic/function.hpp>
+#include <ikos/ar/semantic/type.hpp>
+#include <ikos/ar/semantic/value.hpp>
+
+#include <ikos/analyzer/analysis/memory_location.hpp>
+#include <ikos/analyzer/analysis/variable.hpp>
+
+namespace ar = ikos::ar;
+namespace analyzer = ikos::analyzer;
+
+using analyzer::CellVariable;
+using analyzer::LocalVariable;
+using analyzer::MachineInt;
+using analyzer::MemoryLocation;
+using analyzer::Signed;
+using analyzer::Unsigned;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/// \brief Number of functions in the bundle
+constexpr std::size_t NumFunctions = 1000;
+
+/// \brief Number of local variables per function
+constexpr std::size_t NumLocals = 20;
+
+/// \brief Number of cells per local variable
+constexpr std::size_t NumCells = 4;
+
+/// \brief Number of lookups per thread
+constexpr std::size_t NumLookups = 2000000;
+
+/// \brief Keys of the lookups
+struct Keys {
+  std::vector< ar::LocalVariable* > locals;
+  std::vector< MemoryLocation* > cell_bases;
+  std::vector< MachineInt > cell_offsets;
+};
+
+/// \brief Locked map of local variables, as the VariableFactory used to be
+class LockedLocalMap {
+private:
+  boost::shared_mutex _mutex;
+  llvm::DenseMap< ar::LocalVariable*, LocalVariable* > _map;
+
+public:
+  void insert(ar::LocalVariable* var, LocalVariable* v) {
+    boost::unique_lock< boost::shared_mutex > lock(this->_mutex);
+    this->_map.try_emplace(var, v);
+  }
+
+  LocalVariable* get(ar::LocalVariable* var) {
+    boost::shared_lock< boost::shared_mutex > lock(this->_mutex);
+    auto it = this->_map.find(var);
+    return it != this->_map.end() ? it->second : nullptr;
+  }
+};
+
+/// \brief Run `lookup(keys, rng)` NumLookups times in each of `num_threads`
+/// threads
+///
+/// \returns the number of lookups per second
+template < typename Lookup >
+double throughput(std::size_t num_threads, Lookup lookup) {
+  std::vector< std::thread > threads;
+  Clock::time_point start = Clock::now();
+  for (std::size_t t = 0; t < num_threads; t++) {
+    threads.emplace_back([t, &lookup] {
+      std::minstd_rand rng(static_cast< unsigned >(t + 1));
+      std::size_t found = 0;
+      for (std::size_t i = 0; i < NumLookups; i++) {
+        found += (lookup(rng) != nullptr) ? 1 : 0;
+      }
+      if (found != NumLookups) {
+        std::fprintf(stderr, "error: missing variable\n");
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  double elapsed =
+      std::chrono::duration< double >(Clock::now() - start).count();
+  return static_cast< double >(num_threads * NumLookups) / elapsed;
+}
+
+/// \brief Print the throughput of `lookup` for 1, 2, 4 and 8 threads
+template < typename Lookup >
+void report(const char* name, Lookup lookup) {
+  // Warm up the caches
+  throughput(1, lookup);
+
+  double base = 0;
+  for (std::size_t num_threads : {1, 2, 4, 8}) {
+    double t = throughput(num_threads, lookup);
+    if (num_threads == 1) {
+      base = t;
+    }
+    std::printf("%-14s %-8zu %14.0f %9.1fx\n", name, num_threads, t, t / base);
+  }
+}
+
+} // end anonymous namespace
+
+int main() {
+  // Build a bundle with NumFunctions functions of NumLocals local variables
+  ar::Context context;
+  ar::Bundle* bundle =
+      ar::Bundle::create(context,
+                         ar::DataLayout::create(ar::LittleEndian,
+                                                ar::DataLayoutInfo(64, 64, 64)),
+                         "x86_64-unknown-linux-gnu");
+  ar::IntegerType* int_type = ar::IntegerType::si32(context);
+  ar::PointerType* ptr_type = ar::PointerType::get(context, int_type);
+  ar::FunctionType* fun_type =
+      ar::FunctionType::get(context, ar::VoidType::get(context), {}, false);
+
+  Keys keys;
+  for (std::size_t i = 0; i < NumFunctions; i++) {
+    ar::Function* fun = ar::Function::create(bundle,
+                                             fun_type,
+                                             "f" + std::to_string(i),
+                                             /* is_definition = */ true);
+    for (std::size_t j = 0; j < NumLocals; j++) {
+      keys.locals.push_back(ar::LocalVariable::create(fun, ptr_type, 4));
+    }
+  }
+
+  analyzer::MemoryFactory mem_factory;
+  analyzer::VariableFactory var_factory(bundle);
+  LockedLocalMap locked_map;
+
+  for (ar::LocalVariable* var : keys.locals) {
+    locked_map.insert(var, var_factory.get_local(var));
+  }
+
+  // Create the cells, so that all lookups hit
+  MachineInt size(4, 64, Unsigned);
+  for (ar::LocalVariable* var : keys.locals) {
+    keys.cell_bases.push_back(mem_factory.get_local(var));
+  }
+  for (std::size_t k = 0; k < NumCells; k++) {
+    keys.cell_offsets.emplace_back(4 * k, 64, Unsigned);
+  }
+  for (MemoryLocation* base : keys.cell_bases) {
+    for (const MachineInt& offset : keys.cell_offsets) {
+      var_factory.get_cell(base, offset, size, Signed);
+    }
+  }
+
+  auto locked_local = [&](std::minstd_rand& rng) {
+    return locked_map.get(keys.locals[rng() % keys.locals.size()]);
+  };
+  auto get_local = [&](std::minstd_rand& rng) {
+    return var_factory.get_local(keys.locals[rng() % keys.locals.size()]);
+  };
+  auto get_cell = [&](std::minstd_rand& rng) {
+    return var_factory.get_cell(keys.cell_bases[rng() %
+                                                keys.cell_bases.size()],
+                                keys.cell_offsets[rng() % NumCells],
+                                size,
+                                Signed);
+  };
+
+  std::printf("hardware threads: %u\n", std::thread::hardware_concurrency());
+  std::printf("%-14s %-8s %14s %10s\n",
+              "lookup",
+              "threads",
+              "lookups/s",
+              "speedup");
+  report("locked-local", locked_local);
+  report("get_local", get_local);
+  report("get_cell", get_cell);
+
+  return 0;
+}
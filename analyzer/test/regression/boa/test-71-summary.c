@@ -0,0 +1,16 @@
+static int clamp(int x) {
+  if (x < 0) {
+    return 0;
+  }
+  if (x > 9) {
+    return 9;
+  }
+  return x;
+}
+
+int main(int argc, char** argv) {
+  int a[10];
+  a[clamp(argc)] = 1;
+  a[clamp(argc - 20)] = 2;
+  return 0;
+}
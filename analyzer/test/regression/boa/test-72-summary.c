@@ -0,0 +1,10 @@
+static int next(int x) {
+  return x + 1;
+}
+
+int main(int argc, char** argv) {
+  int a[10];
+  int i = next(8);
+  a[i] = 1;
+  return 0;
+}
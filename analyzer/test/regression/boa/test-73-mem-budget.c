@@ -0,0 +1,23 @@
+// DEFINITE UNSAFE
+// With -mem-budget=0, the fixpoints on called functions are spilled to
+// temporary files after their analysis, and read back for the checks.
+int fill(int* p, int n, int v) {
+  int i;
+  for (i = 0; i < n; i++) {
+    p[i] = v;
+  }
+  return i;
+}
+
+int get(int* p, int i) {
+  return p[i];
+}
+
+int main(int argc, char** argv) {
+  int a[10];
+  int b[20];
+  int n = fill(a, 10, 1);
+  fill(b, 20, n);
+  int x = get(a, 9) + get(b, n + 9);
+  return x + get(a, n);
+}
@@ -0,0 +1,12 @@
+static int distance(int x) {
+  if (x < 0) {
+    return 1 - x;
+  }
+  return x + 1;
+}
+
+int main(int argc, char* argv[]) {
+  int a = 100 / distance(argc);
+  int b = 100 / (distance(argc) - 1);
+  return a + b;
+}
@@ -0,0 +1,22 @@
+static int d(int x, int y) {
+  if (y) {
+    return 100 / x;
+  }
+  return 0;
+}
+
+static int c(int x, int y) {
+  return d(x, y);
+}
+
+static int b(int x, int y) {
+  return c(x, y);
+}
+
+static int a(int x, int y) {
+  return b(x, y);
+}
+
+int main(int argc, char* argv[]) {
+  return a(0, 0) + a(5, 1);
+}
@@ -0,0 +1,16 @@
+static int h(int n, int x);
+
+static int g(int n, int x) {
+  return h(n - 1, x);
+}
+
+static int h(int n, int x) {
+  if (n <= 0) {
+    return 100 / x;
+  }
+  return g(n, x);
+}
+
+int main(int argc, char* argv[]) {
+  return h(2, 5);
+}
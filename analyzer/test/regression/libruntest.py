@@ -42,6 +42,7 @@
 import argparse
 import atexit
 import os
+import re
 import shutil
 import sqlite3
 import subprocess
@@ -54,6 +55,7 @@ VERBOSE = False
 CLANG = 'clang'
 IKOS_PP = 'ikos-pp'
 IKOS_ANALYZER = 'ikos-analyzer'
+IKOS_RESULTS = 'ikos-results'
 
 # available ikos analyses
 ANALYSES = (
@@ -176,6 +178,12 @@ def find_ikos_analyzer():
     return path
 
 
+def find_ikos_results():
+    path = which(IKOS_RESULTS)
+    assert is_executable(path), 'could not find ikos-results'
+    return path
+
+
 def clang_emit_llvm_flags():
     ''' Clang flags to emit llvm bitcode '''
     # see analyzer.clang_emit_llvm_flags()
@@ -231,6 +239,45 @@ class Database:
         self.cursor.execute('SELECT checks.status FROM checks INNER JOIN statements ON checks.statement_id = statements.id WHERE statements.line=%d' % line)
         return [row[0] for row in self.cursor.fetchall()]
 
+    def get_checks(self):
+        self.cursor.execute('SELECT IFNULL(statements.line, 0), checks.status FROM checks INNER JOIN statements ON checks.statement_id = statements.id')
+        return sorted(self.cursor.fetchall())
+
+
+class ResultsFile:
+    ''' Checks of a binary results file, read back with ikos-results '''
+
+    STATUS = {
+        'ok': Result.OK,
+        'warning': Result.WARNING,
+        'error': Result.ERROR,
+        'unreachable': Result.UNREACHABLE,
+    }
+
+    LINE_RE = re.compile(r'^(?:.*:(\d+):\d+: )?(ok|warning|error|unreachable): ')
+
+    def __init__(self, path):
+        cmd = [find_ikos_results(),
+               '-status-filter=error,warning,safe,unreachable',
+               path]
+        output = subprocess.check_output(cmd, stderr=subprocess.PIPE)
+        self.checks = []
+        for line in output.decode('utf-8').splitlines():
+            match = self.LINE_RE.match(line)
+            assert match, 'unexpected ikos-results output: %r' % line
+            self.checks.append((int(match.group(1) or 0),
+                                self.STATUS[match.group(2)]))
+        self.checks.sort()
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *args):
+        pass
+
+    def get_checks(self):
+        return self.checks
+
 
 class TestResult:
     def __init__(self, code, comments=None):
@@ -254,6 +301,8 @@ class Test:
                  entry_points=None,
                  procedural=None,
                  options=None,
+                 output_format=None,
+                 reference_options=None,
                  line_checks=None):
         if not isinstance(analyses, list):
             analyses = [analyses]
@@ -261,6 +310,7 @@ class Test:
         assert all(a in ANALYSES for a in analyses)
         assert result in ('safe', 'unsafe', 'error')
         assert expected in (None, 'safe', 'unsafe', 'error')
+        assert output_format in (None, 'db', 'binary')
 
         self.filename = filename
         self.description = description
@@ -272,6 +322,8 @@ class Test:
         self.entry_points = entry_points or ('main',)
         self.procedural = procedural or 'inter'
         self.options = options or []
+        self.output_format = output_format or 'db'
+        self.reference_options = reference_options
         self.line_checks = line_checks or []
 
     def run(self, root, output_db):
@@ -306,87 +358,129 @@ class Test:
                               stderr=subprocess.PIPE)
 
         # run ikos analyzer
+        cmd = self.analyzer_command(pp_path, self.options)
+        db_cmd = cmd + ['-o', output_db]
+        subprocess.check_call(db_cmd,
+                              stdout=subprocess.PIPE,
+                              stderr=subprocess.PIPE)
+
+        with Database(output_db) as db:
+            ret = self.check_results(db)
+            if ret.code == 'FAIL':
+                ret.comments.insert(0, 'Running %r' % db_cmd)
+            db_checks = db.get_checks()
+
+        if self.output_format == 'binary':
+            # write the same checks into a results file, then read it back
+            results_path = os.path.join(wd, '%s.res' % self.filename)
+            results_cmd = cmd + ['-output-format=binary', '-o', results_path]
+            subprocess.check_call(results_cmd,
+                                  stdout=subprocess.PIPE,
+                                  stderr=subprocess.PIPE)
+
+            with ResultsFile(results_path) as results:
+                if results.get_checks() != db_checks:
+                    ret.code = 'FAIL'
+                    ret.comments.insert(0, 'Running %r' % results_cmd)
+                    ret.add_comment('The results file does not hold the '
+                                    'checks of the output database.')
+
+        if self.reference_options is not None:
+            # the same checks are expected with the reference options
+            ref_db = os.path.join(wd, '%s.ref.db' % self.filename)
+            ref_cmd = self.analyzer_command(pp_path, self.reference_options)
+            ref_cmd += ['-o', ref_db]
+            subprocess.check_call(ref_cmd,
+                                  stdout=subprocess.PIPE,
+                                  stderr=subprocess.PIPE)
+
+            with Database(ref_db) as db:
+                if db.get_checks() != db_checks:
+                    ret.code = 'FAIL'
+                    ret.comments.insert(0, 'Running %r' % ref_cmd)
+                    ret.add_comment('The checks differ from the ones with '
+                                    'the reference options.')
+
+        return ret
+
+    def analyzer_command(self, pp_path, options):
+        ''' Return the ikos-analyzer command, without the output '''
         cmd = [find_ikos_analyzer(),
                '-a=%s' % ','.join(self.analyses),
                '-d=%s' % self.domain,
                '-entry-points=%s' % ','.join(self.entry_points),
                '-proc=%s' % self.procedural]
-        cmd.extend(self.options)
+        cmd.extend(options)
         if self.opt_level == 'aggressive':
             cmd.append('-allow-dbg-mismatch')
         if 'gauge' in self.domain:
             cmd.append('-add-loop-counters')
-        cmd += [pp_path, '-o', output_db]
-        subprocess.check_call(cmd,
-                              stdout=subprocess.PIPE,
-                              stderr=subprocess.PIPE)
+        cmd.append(pp_path)
+        return cmd
+
+    def check_results(self, db):
+        # Get the global result
+        errors = db.get_num_checks(Result.ERROR)
+        warnings = db.get_num_checks(Result.WARNING)
+
+        if errors == 0 and warnings == 0:
+            result = 'safe'
+        elif errors != 0:
+            result = 'error'
+        else:
+            result = 'unsafe'
+
+        # Set the test result (passed or failed)
+        ret = TestResult('PASS')
+
+        if result not in (self.result, self.expected):
+            ret.code = 'FAIL'
+            ret.add_comment('Got %d errors and %d warnings, was expecting "%s".'
+                            % (errors, warnings, self.expected))
+        elif result == self.result and result != self.expected:
+            ret.code = 'PASS_IMPROVE'
+            ret.add_comment('improvement: IKOS returned the right result '
+                            '(%s) and not the expected one (%s).'
+                            % (self.result, self.expected))
+
+        # Line by line check
+        for line_check in self.line_checks:
+            if len(line_check) == 3:
+                line_num, line_result, line_expected = line_check
+            elif len(line_check) == 2:
+                line_num, line_result = line_check
+                line_expected = line_result
+            else:
+                assert False, 'Unexpected line_checks'
 
-        with Database(output_db) as db:
-            # Get the global result
-            errors = db.get_num_checks(Result.ERROR)
-            warnings = db.get_num_checks(Result.WARNING)
+            assert line_result in ('ok', 'warning', 'error', 'unreachable')
+            assert line_expected in ('ok', 'warning', 'error', 'unreachable')
+
+            result = db.get_line_status(line_num)
 
-            if errors == 0 and warnings == 0:
-                result = 'safe'
-            elif errors != 0:
+            if Result.ERROR in result:
                 result = 'error'
+            elif Result.WARNING in result:
+                result = 'warning'
+            elif Result.OK in result and all(s in (Result.OK, Result.UNREACHABLE) for s in result):
+                result = 'ok'
+            elif result and all(s == Result.UNREACHABLE for s in result):
+                result = 'unreachable'
             else:
-                result = 'unsafe'
+                result = 'unknown'
 
-            # Set the test result (passed or failed)
-            ret = TestResult('PASS')
-
-            if result not in (self.result, self.expected):
+            if result not in (line_result, line_expected):
                 ret.code = 'FAIL'
-                ret.add_comment('Got %d errors and %d warnings, was expecting "%s".'
-                                % (errors, warnings, self.expected))
-            elif result == self.result and result != self.expected:
-                ret.code = 'PASS_IMPROVE'
+                ret.add_comment('Got status "%s" for line %d, was expecting "%s".'
+                                % (result, line_num, line_expected))
+            elif result == line_result and line_result != line_expected:
+                if ret.code == 'PASS':
+                    ret.code = 'PASS_IMPROVE'
                 ret.add_comment('improvement: IKOS returned the right result '
-                                '(%s) and not the expected one (%s).'
-                                % (self.result, self.expected))
-
-            # Line by line check
-            for line_check in self.line_checks:
-                if len(line_check) == 3:
-                    line_num, line_result, line_expected = line_check
-                elif len(line_check) == 2:
-                    line_num, line_result = line_check
-                    line_expected = line_result
-                else:
-                    assert False, 'Unexpected line_checks'
-
-                assert line_result in ('ok', 'warning', 'error', 'unreachable')
-                assert line_expected in ('ok', 'warning', 'error', 'unreachable')
-
-                result = db.get_line_status(line_num)
-
-                if Result.ERROR in result:
-                    result = 'error'
-                elif Result.WARNING in result:
-                    result = 'warning'
-                elif Result.OK in result and all(s in (Result.OK, Result.UNREACHABLE) for s in result):
-                    result = 'ok'
-                elif result and all(s == Result.UNREACHABLE for s in result):
-                    result = 'unreachable'
-                else:
-                    result = 'unknown'
-
-                if result not in (line_result, line_expected):
-                    ret.code = 'FAIL'
-                    ret.add_comment('Got status "%s" for line %d, was expecting "%s".'
-                                    % (result, line_num, line_expected))
-                elif result == line_result and line_result != line_expected:
-                    if ret.code == 'PASS':
-                        ret.code = 'PASS_IMPROVE'
-                    ret.add_comment('improvement: IKOS returned the right result '
-                                    '(%s) for line %d and not the expected one (%s).'
-                                    % (line_result, line_num, line_expected))
-
-            if ret.code == 'FAIL':
-                ret.comments.insert(0, 'Running %r' % cmd)
+                                '(%s) for line %d and not the expected one (%s).'
+                                % (line_result, line_num, line_expected))
 
-            return ret
+        return ret
 
 
 class TestManager:
@@ -484,13 +578,18 @@ def parse_args(description=None):
     parser.add_argument('--ikos-analyzer', dest='ikos_analyzer',
                         help='Path to the ikos-analyzer binary',
                         default='ikos-analyzer')
+    parser.add_argument('--ikos-results', dest='ikos_results',
+                        help='Path to the ikos-results binary',
+                        default='ikos-results')
 
     args = parser.parse_args()
 
     global VERBOSE, USE_COLORS, INTERACTIVE, CLANG, IKOS_PP, IKOS_ANALYZER
+    global IKOS_RESULTS
     VERBOSE = args.verbose
     USE_COLORS = False if args.no_colors else os.isatty(sys.stdout.fileno())
     INTERACTIVE = False if args.no_interactive else os.isatty(sys.stdout.fileno())
     CLANG = args.clang
     IKOS_PP = args.ikos_pp
     IKOS_ANALYZER = args.ikos_analyzer
+    IKOS_RESULTS = args.ikos_results
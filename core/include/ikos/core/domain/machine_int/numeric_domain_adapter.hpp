@@ -50,6 +50,7 @@
 #include <ikos/core/number/machine_int.hpp>
 #include <ikos/core/number/z_number.hpp>
 #include <ikos/core/semantic/machine_int/variable.hpp>
+#include <ikos/core/serialization/stream.hpp>
 #include <ikos/core/support/assert.hpp>
 
 namespace ikos {
@@ -94,6 +95,9 @@ public:
   using ZCongruence = numeric::Congruence< ZNumber >;
   using ZIntervalCongruence = numeric::IntervalCongruence< ZNumber >;
 
+public:
+  friend struct serialization::Serializer< NumericDomainAdapter >;
+
 private:
   NumDomain _inv;
 
@@ -253,7 +257,19 @@ private:
   ///
   /// Apply the wrap-around semantic for machine integers of the given bit-width
   /// and sign.
+  ///
+  /// If `y` is already within the bounds of the machine integer type, this is
+  /// the identity and we avoid the modular emulation, which is costly and
+  /// loses precision on relational domains.
   void wrap(VariableRef x, VariableRef y, uint64_t bit_width, Signedness sign) {
+    ZInterval range = MachIntInterval::top(bit_width, sign).to_z_interval();
+    if (this->_inv.to_interval(y).leq(range)) {
+      if (x != y) {
+        this->_inv.assign(x, y);
+      }
+      return;
+    }
+
     if (sign == Signed) {
       ZNumber n = power_of_2(bit_width);
       ZNumber m = power_of_2(bit_width - 1);
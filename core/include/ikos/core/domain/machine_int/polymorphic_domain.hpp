@@ -50,6 +50,7 @@
 #include <memory>
 
 #include <ikos/core/domain/machine_int/abstract_domain.hpp>
+#include <ikos/core/serialization/stream.hpp>
 #include <ikos/core/support/assert.hpp>
 #include <ikos/core/support/mpl.hpp>
 
@@ -62,6 +63,11 @@ namespace machine_int {
 /// The PolymorphicDomain is a machine integer abstract domain whose behavior
 /// depends on the abstract domain it is constructed with. It allows the use of
 /// different abstract domains at runtime.
+///
+/// The abstract value can be serialized if a `serialization::Serializer` of
+/// the runtime domain is visible where the polymorphic domain is constructed,
+/// see `ikos/core/serialization/domain.hpp`. Otherwise, serializing it throws a
+/// `serialization::SerializationError`.
 template < typename VariableRef >
 class PolymorphicDomain final
     : public machine_int::AbstractDomain< VariableRef,
@@ -70,6 +76,12 @@ public:
   using LinearExpressionT = LinearExpression< MachineInt, VariableRef >;
   using VariableTrait = machine_int::VariableTraits< VariableRef >;
 
+public:
+  friend struct serialization::Serializer< PolymorphicDomain >;
+
+private:
+  using ResolverT = serialization::ErasedResolver< VariableRef >;
+
 private:
   /// Type erasure idiom
   ///
@@ -301,6 +313,18 @@ private:
     /// \brief Dump the abstract value, for debugging purpose
     virtual void dump(std::ostream&) const = 0;
 
+    /// \name Serialization methods
+    /// @{
+
+    /// \brief Write the abstract value
+    virtual void serialize(serialization::Encoder& e) const = 0;
+
+    /// \brief Read an abstract value of the same runtime domain
+    virtual std::unique_ptr< PolymorphicBase > deserialize(
+        serialization::Decoder& d, ResolverT& resolve) const = 0;
+
+    /// @}
+
   }; // end class PolymorphicBase
 
 private:
@@ -631,6 +655,21 @@ private:
 
     void dump(std::ostream& o) const override { this->_inv.dump(o); }
 
+    /// \name Serialization methods
+    /// @{
+
+    void serialize(serialization::Encoder& e) const override {
+      serialization::write_or_throw(e, this->_inv);
+    }
+
+    std::unique_ptr< PolymorphicBase > deserialize(
+        serialization::Decoder& d, ResolverT& resolve) const override {
+      return std::make_unique< PolymorphicDerivedT >(
+          serialization::read_like_or_throw(d, resolve, this->_inv));
+    }
+
+    /// @}
+
   }; // end class PolymorphicDerived
 
 private:
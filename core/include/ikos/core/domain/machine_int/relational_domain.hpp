@@ -0,0 +1,638 @@
+/*******************************************************************************
+ *
+ * \file
+ * \brief Relational abstract domain on machine integers
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2018-2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <type_traits>
+
+#include <boost/optional.hpp>
+
+#include <ikos/core/domain/machine_int/abstract_domain.hpp>
+#include <ikos/core/domain/machine_int/operator.hpp>
+#include <ikos/core/domain/numeric/abstract_domain.hpp>
+#include <ikos/core/domain/numeric/operator.hpp>
+#include <ikos/core/number/machine_int.hpp>
+#include <ikos/core/number/z_number.hpp>
+#include <ikos/core/semantic/machine_int/variable.hpp>
+#include <ikos/core/support/assert.hpp>
+
+namespace ikos {
+namespace core {
+namespace machine_int {
+
+/// \brief Relational abstract domain on machine integers
+///
+/// This uses a relational `numeric::AbstractDomain` on `ZNumber` (e.g, DBM or
+/// octagon) to hold the relations between machine integer variables. Bounds
+/// are stored as unbounded integers, and operands and results are converted
+/// from and to machine integers with `to_z_number()`/`to_z_interval()`.
+///
+/// Unlike `NumericDomainAdapter`, the wrap-around semantic is not emulated
+/// with integer operations. An arithmetic operation is performed on the
+/// numeric abstract domain only if the machine integer intervals of the
+/// operands prove that it cannot overflow, in which case the integer and
+/// machine integer semantics agree. Otherwise, the result is the machine
+/// integer interval of the operation, which forgets the relations on the
+/// result. This avoids the temporary constraints and normalizations of the
+/// modular emulation.
+template < typename VariableRef, typename NumDomain >
+class RelationalDomain final
+    : public machine_int::AbstractDomain<
+          VariableRef,
+          RelationalDomain< VariableRef, NumDomain > > {
+public:
+  static_assert(
+      numeric::IsAbstractDomain< NumDomain, ZNumber, VariableRef >::value,
+      "NumDomain must implement numeric::AbstractDomain");
+
+private:
+  using Parent = machine_int::AbstractDomain<
+      VariableRef,
+      RelationalDomain< VariableRef, NumDomain > >;
+  using VariableTrait = machine_int::VariableTraits< VariableRef >;
+
+public:
+  using MachIntVariableExpression =
+      VariableExpression< MachineInt, VariableRef >;
+  using MachIntLinearExpression = LinearExpression< MachineInt, VariableRef >;
+  using MachIntUnaryOperator = machine_int::UnaryOperator;
+  using MachIntBinaryOperator = machine_int::BinaryOperator;
+  using MachIntPredicate = machine_int::Predicate;
+  using MachIntInterval = machine_int::Interval;
+  using MachIntCongruence = machine_int::Congruence;
+  using MachIntIntervalCongruence = machine_int::IntervalCongruence;
+
+  using ZBinaryOperator = numeric::BinaryOperator;
+  using ZVariableExpression = VariableExpression< ZNumber, VariableRef >;
+  using ZLinearExpression = LinearExpression< ZNumber, VariableRef >;
+  using ZInterval = numeric::Interval< ZNumber >;
+  using ZCongruence = numeric::Congruence< ZNumber >;
+  using ZIntervalCongruence = numeric::IntervalCongruence< ZNumber >;
+
+private:
+  NumDomain _inv;
+
+public:
+  /// \brief Create an abstract value from the given numeric abstract domain
+  explicit RelationalDomain(NumDomain inv) : _inv(std::move(inv)) {}
+
+  /// \brief Create the top abstract value
+  static RelationalDomain top() { return RelationalDomain(NumDomain::top()); }
+
+  /// \brief Create the bottom abstract value
+  static RelationalDomain bottom() {
+    return RelationalDomain(NumDomain::bottom());
+  }
+
+  /// \brief Copy constructor
+  RelationalDomain(const RelationalDomain&) noexcept(
+      std::is_nothrow_copy_constructible< NumDomain >::value) = default;
+
+  /// \brief Move constructor
+  RelationalDomain(RelationalDomain&&) noexcept(
+      std::is_nothrow_move_constructible< NumDomain >::value) = default;
+
+  /// \brief Copy assignment operator
+  RelationalDomain& operator=(const RelationalDomain&) noexcept(
+      std::is_nothrow_copy_assignable< NumDomain >::value) = default;
+
+  /// \brief Move assignment operator
+  RelationalDomain& operator=(RelationalDomain&&) noexcept(
+      std::is_nothrow_move_assignable< NumDomain >::value) = default;
+
+  /// \brief Destructor
+  ~RelationalDomain() override = default;
+
+  void normalize() override { this->_inv.normalize(); }
+
+  bool is_bottom() const override { return this->_inv.is_bottom(); }
+
+  bool is_top() const override { return this->_inv.is_top(); }
+
+  void set_to_bottom() override { this->_inv.set_to_bottom(); }
+
+  void set_to_top() override { this->_inv.set_to_top(); }
+
+  bool leq(const RelationalDomain& other) const override {
+    return this->_inv.leq(other._inv);
+  }
+
+  bool equals(const RelationalDomain& other) const override {
+    return this->_inv.equals(other._inv);
+  }
+
+  void join_with(RelationalDomain&& other) override {
+    this->_inv.join_with(std::move(other._inv));
+  }
+
+  void join_with(const RelationalDomain& other) override {
+    this->_inv.join_with(other._inv);
+  }
+
+  void join_loop_with(RelationalDomain&& other) override {
+    this->_inv.join_loop_with(std::move(other._inv));
+  }
+
+  void join_loop_with(const RelationalDomain& other) override {
+    this->_inv.join_loop_with(other._inv);
+  }
+
+  void join_iter_with(RelationalDomain&& other) override {
+    this->_inv.join_iter_with(std::move(other._inv));
+  }
+
+  void join_iter_with(const RelationalDomain& other) override {
+    this->_inv.join_iter_with(other._inv);
+  }
+
+  void widen_with(const RelationalDomain& other) override {
+    this->_inv.widen_with(other._inv);
+  }
+
+  void widen_threshold_with(const RelationalDomain& other,
+                            const MachineInt& threshold) override {
+    this->_inv.widen_threshold_with(other._inv, threshold.to_z_number());
+  }
+
+  void meet_with(const RelationalDomain& other) override {
+    this->_inv.meet_with(other._inv);
+  }
+
+  void narrow_with(const RelationalDomain& other) override {
+    this->_inv.narrow_with(other._inv);
+  }
+
+  void narrow_threshold_with(const RelationalDomain& other,
+                             const MachineInt& threshold) override {
+    this->_inv.narrow_threshold_with(other._inv, threshold.to_z_number());
+  }
+
+  RelationalDomain join(const RelationalDomain& other) const override {
+    return RelationalDomain(this->_inv.join(other._inv));
+  }
+
+  RelationalDomain join_loop(
+      const RelationalDomain& other) const override {
+    return RelationalDomain(this->_inv.join_loop(other._inv));
+  }
+
+  RelationalDomain join_iter(
+      const RelationalDomain& other) const override {
+    return RelationalDomain(this->_inv.join_iter(other._inv));
+  }
+
+  RelationalDomain widening(
+      const RelationalDomain& other) const override {
+    return RelationalDomain(this->_inv.widening(other._inv));
+  }
+
+  RelationalDomain widening_threshold(
+      const RelationalDomain& other,
+      const MachineInt& threshold) const override {
+    return RelationalDomain(
+        this->_inv.widening_threshold(other._inv, threshold.to_z_number()));
+  }
+
+  RelationalDomain meet(const RelationalDomain& other) const override {
+    return RelationalDomain(this->_inv.meet(other._inv));
+  }
+
+  RelationalDomain narrowing(
+      const RelationalDomain& other) const override {
+    return RelationalDomain(this->_inv.narrowing(other._inv));
+  }
+
+  RelationalDomain narrowing_threshold(
+      const RelationalDomain& other,
+      const MachineInt& threshold) const override {
+    return RelationalDomain(
+        this->_inv.narrowing_threshold(other._inv, threshold.to_z_number()));
+  }
+
+private:
+  /// \brief Return the range of the machine integer type of the given variable
+  static ZInterval range(VariableRef x) {
+    return MachIntInterval::top(VariableTrait::bit_width(x),
+                                VariableTrait::sign(x))
+        .to_z_interval();
+  }
+
+  /// \brief Convert a linear expression on machine integers to a linear
+  /// expression on integers
+  static ZLinearExpression to_z_linear_expression(
+      const MachIntLinearExpression& e) {
+    ZLinearExpression r(e.constant().to_z_number());
+    for (const auto& term : e) {
+      r.add(term.second.to_z_number(), term.first);
+    }
+    return r;
+  }
+
+  /// \brief Return the integer operator equivalent to the given machine
+  /// integer operator when there is no overflow, or boost::none
+  static boost::optional< ZBinaryOperator > exact_operator(
+      MachIntBinaryOperator op) {
+    switch (op) {
+      case MachIntBinaryOperator::Add:
+      case MachIntBinaryOperator::AddNoWrap:
+        return ZBinaryOperator::Add;
+      case MachIntBinaryOperator::Sub:
+      case MachIntBinaryOperator::SubNoWrap:
+        return ZBinaryOperator::Sub;
+      case MachIntBinaryOperator::Mul:
+      case MachIntBinaryOperator::MulNoWrap:
+        return ZBinaryOperator::Mul;
+      default:
+        return boost::none;
+    }
+  }
+
+  /// \brief Return true if the given operator has an undefined behavior on
+  /// overflow
+  static bool is_no_wrap(MachIntBinaryOperator op) {
+    return op == MachIntBinaryOperator::AddNoWrap ||
+           op == MachIntBinaryOperator::SubNoWrap ||
+           op == MachIntBinaryOperator::MulNoWrap;
+  }
+
+  /// \brief Return true if the given operator is a shift
+  static bool is_shift(MachIntBinaryOperator op) {
+    switch (op) {
+      case MachIntBinaryOperator::Shl:
+      case MachIntBinaryOperator::ShlNoWrap:
+      case MachIntBinaryOperator::LShr:
+      case MachIntBinaryOperator::LShrExact:
+      case MachIntBinaryOperator::AShr:
+      case MachIntBinaryOperator::AShrExact:
+        return true;
+      default:
+        return false;
+    }
+  }
+
+  /// \brief Return the machine integer interval of an operand
+  MachIntInterval operand_interval(VariableRef x) const {
+    return this->to_interval(x);
+  }
+
+  /// \brief Return the machine integer interval of an operand
+  static MachIntInterval operand_interval(const MachineInt& n) {
+    return MachIntInterval(n);
+  }
+
+  /// \brief Return an operand for the numeric abstract domain
+  static VariableRef z_operand(VariableRef x) { return x; }
+
+  /// \brief Return an operand for the numeric abstract domain
+  static ZNumber z_operand(const MachineInt& n) { return n.to_z_number(); }
+
+  /// \brief Refine the shift count `z` of `x = y op z` to [0, bit_width - 1]
+  ///
+  /// A shift by a larger count is an undefined behavior.
+  void refine_shift_count(VariableRef x, VariableRef z) {
+    uint64_t bit_width = VariableTrait::bit_width(x);
+    this->_inv.refine(z, ZInterval(ZBound(0), ZBound(ZNumber(bit_width - 1))));
+  }
+
+  /// \brief Refine the shift count `z` of `x = y op z` to [0, bit_width - 1]
+  ///
+  /// Constant shift counts are handled by the machine integer intervals.
+  void refine_shift_count(VariableRef, const MachineInt&) {}
+
+  /// \brief Set the value of `x` to the given machine integer interval
+  ///
+  /// This forgets all the relations on `x`.
+  void set_interval(VariableRef x, const MachIntInterval& value) {
+    if (value.is_bottom()) {
+      this->set_to_bottom();
+    } else {
+      this->_inv.set(x, value.to_z_interval());
+    }
+  }
+
+  /// \brief Apply `x = y op z`
+  template < typename Y, typename Z >
+  void apply_binary(MachIntBinaryOperator op,
+                    VariableRef x,
+                    const Y& y,
+                    const Z& z) {
+    // Requires normalization
+    this->_inv.normalize();
+
+    if (this->is_bottom()) {
+      return;
+    }
+
+    if (is_shift(op)) {
+      this->refine_shift_count(x, z);
+    }
+
+    MachIntInterval y_interval = this->operand_interval(y);
+    MachIntInterval z_interval = this->operand_interval(z);
+    boost::optional< ZBinaryOperator > z_op = exact_operator(op);
+
+    if (z_op) {
+      ZInterval exact = numeric::apply_bin_operator(*z_op,
+                                                    y_interval.to_z_interval(),
+                                                    z_interval.to_z_interval());
+      if (exact.leq(range(x))) {
+        // No overflow, the integer semantic is exact
+        this->_inv.apply(*z_op, x, z_operand(y), z_operand(z));
+        return;
+      }
+
+      if (is_no_wrap(op)) {
+        // Overflow is an undefined behavior, keep the relation
+        this->_inv.apply(*z_op, x, z_operand(y), z_operand(z));
+        this->_inv.refine(x, range(x));
+        return;
+      }
+    }
+
+    this->set_interval(x, apply_bin_operator(op, y_interval, z_interval));
+  }
+
+public:
+  void assign(VariableRef x, const MachineInt& n) override {
+    this->_inv.assign(x, n.to_z_number());
+  }
+
+  void assign(VariableRef x, VariableRef y) override {
+    this->_inv.assign(x, y);
+  }
+
+  void assign(VariableRef x, const MachIntLinearExpression& e) override {
+    // Requires normalization
+    this->_inv.normalize();
+
+    if (this->is_bottom()) {
+      return;
+    }
+
+    ZInterval exact(e.constant().to_z_number());
+    for (const auto& term : e) {
+      exact = exact + ZInterval(term.second.to_z_number()) *
+                          this->to_interval(term.first).to_z_interval();
+    }
+
+    if (exact.leq(range(x))) {
+      // No overflow, the integer semantic is exact
+      this->_inv.assign(x, to_z_linear_expression(e));
+    } else {
+      this->set_interval(x,
+                         MachIntInterval::
+                             from_z_interval(exact,
+                                             VariableTrait::bit_width(x),
+                                             VariableTrait::sign(x),
+                                             MachIntInterval::WrapTag{}));
+    }
+  }
+
+  void apply(MachIntUnaryOperator op, VariableRef x, VariableRef y) override {
+    // Add bound information on y
+    this->_inv.refine(y, range(y));
+
+    // Requires normalization
+    this->_inv.normalize();
+
+    if (this->is_bottom()) {
+      return;
+    }
+
+    MachIntInterval y_interval = this->to_interval(y);
+    if (op == MachIntUnaryOperator::Ext ||
+        y_interval.to_z_interval().leq(range(x))) {
+      // The value is preserved
+      this->_inv.assign(x, y);
+    } else {
+      this->set_interval(x,
+                         apply_unary_operator(op,
+                                              y_interval,
+                                              VariableTrait::bit_width(x),
+                                              VariableTrait::sign(x)));
+    }
+  }
+
+  void apply(MachIntBinaryOperator op,
+             VariableRef x,
+             VariableRef y,
+             VariableRef z) override {
+    this->apply_binary(op, x, y, z);
+  }
+
+  void apply(MachIntBinaryOperator op,
+             VariableRef x,
+             VariableRef y,
+             const MachineInt& z) override {
+    this->apply_binary(op, x, y, z);
+  }
+
+  void apply(MachIntBinaryOperator op,
+             VariableRef x,
+             const MachineInt& y,
+             VariableRef z) override {
+    this->apply_binary(op, x, y, z);
+  }
+
+  void add(MachIntPredicate pred, VariableRef x, VariableRef y) override {
+    switch (pred) {
+      case MachIntPredicate::EQ: {
+        this->_inv.add(ZVariableExpression(x) == ZVariableExpression(y));
+      } break;
+      case MachIntPredicate::NE: {
+        this->_inv.add(ZVariableExpression(x) != ZVariableExpression(y));
+      } break;
+      case MachIntPredicate::GT: {
+        this->_inv.add(ZVariableExpression(x) >= ZVariableExpression(y) + 1);
+      } break;
+      case MachIntPredicate::GE: {
+        this->_inv.add(ZVariableExpression(x) >= ZVariableExpression(y));
+      } break;
+      case MachIntPredicate::LT: {
+        this->_inv.add(ZVariableExpression(x) <= ZVariableExpression(y) - 1);
+      } break;
+      case MachIntPredicate::LE: {
+        this->_inv.add(ZVariableExpression(x) <= ZVariableExpression(y));
+      } break;
+      default: {
+        ikos_unreachable("unreachable");
+      }
+    }
+  }
+
+  void add(MachIntPredicate pred, VariableRef x, const MachineInt& y) override {
+    switch (pred) {
+      case MachIntPredicate::EQ: {
+        this->_inv.add(ZVariableExpression(x) == y.to_z_number());
+      } break;
+      case MachIntPredicate::NE: {
+        this->_inv.add(ZVariableExpression(x) != y.to_z_number());
+      } break;
+      case MachIntPredicate::GT: {
+        this->_inv.add(ZVariableExpression(x) >= y.to_z_number() + 1);
+      } break;
+      case MachIntPredicate::GE: {
+        this->_inv.add(ZVariableExpression(x) >= y.to_z_number());
+      } break;
+      case MachIntPredicate::LT: {
+        this->_inv.add(ZVariableExpression(x) <= y.to_z_number() - 1);
+      } break;
+      case MachIntPredicate::LE: {
+        this->_inv.add(ZVariableExpression(x) <= y.to_z_number());
+      } break;
+      default: {
+        ikos_unreachable("unreachable");
+      }
+    }
+  }
+
+  void add(MachIntPredicate pred, const MachineInt& x, VariableRef y) override {
+    Parent::add(pred, x, y);
+  }
+
+  void set(VariableRef x, const MachIntInterval& value) override {
+    this->_inv.set(x, value.to_z_interval());
+  }
+
+  void set(VariableRef x, const MachIntCongruence& value) override {
+    this->_inv.set(x, value.to_z_congruence());
+  }
+
+  void set(VariableRef x, const MachIntIntervalCongruence& value) override {
+    this->_inv.set(x, value.to_z_interval_congruence());
+  }
+
+  void refine(VariableRef x, const MachIntInterval& value) override {
+    this->_inv.refine(x, value.to_z_interval());
+  }
+
+  void refine(VariableRef x, const MachIntCongruence& value) override {
+    this->_inv.refine(x, value.to_z_congruence());
+  }
+
+  void refine(VariableRef x, const MachIntIntervalCongruence& value) override {
+    this->_inv.refine(x, value.to_z_interval_congruence());
+  }
+
+  void forget(VariableRef x) override { this->_inv.forget(x); }
+
+  MachIntInterval to_interval(VariableRef x) const override {
+    return MachIntInterval::from_z_interval(this->_inv.to_interval(x),
+                                            VariableTrait::bit_width(x),
+                                            VariableTrait::sign(x),
+                                            MachIntInterval::TruncTag{});
+  }
+
+  MachIntInterval to_interval(const MachIntLinearExpression& e) const override {
+    return MachIntInterval::from_z_interval(this->_inv.to_interval(
+                                                to_z_linear_expression(e)),
+                                            e.constant().bit_width(),
+                                            e.constant().sign(),
+                                            MachIntInterval::WrapTag{});
+  }
+
+  MachIntCongruence to_congruence(VariableRef x) const override {
+    return MachIntCongruence::from_z_congruence(this->_inv.to_congruence(x),
+                                                VariableTrait::bit_width(x),
+                                                VariableTrait::sign(x),
+                                                MachIntCongruence::TruncTag{});
+  }
+
+  MachIntCongruence to_congruence(
+      const MachIntLinearExpression& e) const override {
+    return MachIntCongruence::from_z_congruence(this->_inv.to_congruence(
+                                                    to_z_linear_expression(e)),
+                                                e.constant().bit_width(),
+                                                e.constant().sign(),
+                                                MachIntCongruence::WrapTag{});
+  }
+
+  MachIntIntervalCongruence to_interval_congruence(
+      VariableRef x) const override {
+    return MachIntIntervalCongruence::
+        from_z_interval_congruence(this->_inv.to_interval_congruence(x),
+                                   VariableTrait::bit_width(x),
+                                   VariableTrait::sign(x),
+                                   MachIntIntervalCongruence::TruncTag{});
+  }
+
+  MachIntIntervalCongruence to_interval_congruence(
+      const MachIntLinearExpression& e) const override {
+    return MachIntIntervalCongruence::
+        from_z_interval_congruence(this->_inv.to_interval_congruence(
+                                       to_z_linear_expression(e)),
+                                   e.constant().bit_width(),
+                                   e.constant().sign(),
+                                   MachIntIntervalCongruence::WrapTag{});
+  }
+
+  /// \name Non-negative loop counter abstract domain methods
+  /// @{
+
+  void counter_mark(VariableRef x) override { this->_inv.counter_mark(x); }
+
+  void counter_unmark(VariableRef x) override { this->_inv.counter_unmark(x); }
+
+  void counter_init(VariableRef x, const MachineInt& c) override {
+    this->_inv.counter_init(x, c.to_z_number());
+  }
+
+  void counter_incr(VariableRef x, const MachineInt& k) override {
+    this->_inv.counter_incr(x, k.to_z_number());
+  }
+
+  void counter_forget(VariableRef x) override { this->_inv.counter_forget(x); }
+
+  /// @}
+
+  void dump(std::ostream& o) const override { return this->_inv.dump(o); }
+
+  static std::string name() {
+    return "machine integer " + NumDomain::name();
+  }
+
+}; // end class RelationalDomain
+
+} // end namespace machine_int
+} // end namespace core
+} // end namespace ikos
@@ -50,6 +50,7 @@
 #include <memory>
 
 #include <ikos/core/domain/memory/abstract_domain.hpp>
+#include <ikos/core/serialization/stream.hpp>
 #include <ikos/core/support/assert.hpp>
 #include <ikos/core/support/mpl.hpp>
 
@@ -62,6 +63,11 @@ namespace memory {
 /// The PolymorphicDomain is a memory abstract domain whose behavior depends on
 /// the abstract domain it is constructed with. It allows the use of different
 /// abstract domains at runtime.
+///
+/// The abstract value can be serialized if a `serialization::Serializer` of
+/// the runtime domain is visible where the polymorphic domain is constructed,
+/// see `ikos/core/serialization/memory.hpp`. Otherwise, serializing it throws
+/// a `serialization::SerializationError`.
 template < typename VariableRef, typename MemoryLocationRef >
 class PolymorphicDomain final
     : public memory::AbstractDomain<
@@ -82,6 +88,13 @@ public:
   using PointerSetT = PointerSet< MemoryLocationRef >;
   using LiteralT = Literal< VariableRef, MemoryLocationRef >;
 
+public:
+  friend struct serialization::Serializer< PolymorphicDomain >;
+
+private:
+  using ResolverT =
+      serialization::ErasedResolver< VariableRef, MemoryLocationRef >;
+
 private:
   /// Type erasure idiom
   ///
@@ -728,6 +741,18 @@ private:
     /// \brief Dump the abstract value, for debugging purpose
     virtual void dump(std::ostream&) const = 0;
 
+    /// \name Serialization methods
+    /// @{
+
+    /// \brief Write the abstract value
+    virtual void serialize(serialization::Encoder& e) const = 0;
+
+    /// \brief Read an abstract value of the same runtime domain
+    virtual std::unique_ptr< PolymorphicBase > deserialize(
+        serialization::Decoder& d, ResolverT& resolve) const = 0;
+
+    /// @}
+
   }; // end class PolymorphicBase
 
 private:
@@ -1456,6 +1481,21 @@ private:
 
     void dump(std::ostream& o) const override { this->_inv.dump(o); }
 
+    /// \name Serialization methods
+    /// @{
+
+    void serialize(serialization::Encoder& e) const override {
+      serialization::write_or_throw(e, this->_inv);
+    }
+
+    std::unique_ptr< PolymorphicBase > deserialize(
+        serialization::Decoder& d, ResolverT& resolve) const override {
+      return std::make_unique< PolymorphicDerivedT >(
+          serialization::read_like_or_throw(d, resolve, this->_inv));
+    }
+
+    /// @}
+
   }; // end class PolymorphicDerived
 
 private:
@@ -61,6 +61,7 @@
 #include <ikos/core/semantic/machine_int/variable.hpp>
 #include <ikos/core/semantic/memory/value/cell_factory.hpp>
 #include <ikos/core/semantic/memory/value/cell_variable.hpp>
+#include <ikos/core/serialization/stream.hpp>
 #include <ikos/core/support/cast.hpp>
 
 namespace ikos {
@@ -129,6 +130,9 @@ public:
   using PointerSetT = PointerSet< MemoryLocationRef >;
   using LiteralT = Literal< VariableRef, MemoryLocationRef >;
 
+public:
+  friend struct serialization::Serializer< ValueDomain >;
+
 private:
   using CellSetT = CellSet< VariableRef >;
   using MemLocToCellSetT = MemLocToCellSet< MemoryLocationRef, VariableRef >;
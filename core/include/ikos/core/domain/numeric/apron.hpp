@@ -44,8 +44,10 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
 #include <memory>
 #include <mutex>
+#include <unordered_map>
 #include <vector>
 
 #include <ap_global0.h>
@@ -232,6 +234,96 @@ inline ap_manager_t* alloc_domain_manager(Domain d) {
   }
 }
 
+/// \brief APRON manager owned by a thread
+///
+/// Reference counts of APRON managers are not atomic, hence only the owner
+/// thread updates them. References released by other threads are counted in
+/// `_pending` and released by the owner thread the next time it requests its
+/// manager. Once the owner thread has exited, references are released under
+/// the lock of the registry.
+class ThreadManager {
+private:
+  ap_manager_t* _man;
+  std::atomic< std::size_t > _pending;
+
+private:
+  /// \brief Map from managers to their owner, for the live threads
+  struct Registry {
+    std::mutex mutex;
+    std::unordered_map< ap_manager_t*, ThreadManager* > owners;
+  };
+
+  /// \brief Return the registry
+  static Registry& registry() {
+    static Registry R;
+    return R;
+  }
+
+public:
+  /// \brief Allocate a manager for the given domain
+  explicit ThreadManager(Domain d)
+      : _man(alloc_domain_manager(d)), _pending(0) {
+    Registry& r = registry();
+    std::lock_guard< std::mutex > lock(r.mutex);
+    r.owners.emplace(this->_man, this);
+  }
+
+  /// \brief No copy constructor
+  ThreadManager(const ThreadManager&) = delete;
+
+  /// \brief No move constructor
+  ThreadManager(ThreadManager&&) = delete;
+
+  /// \brief No copy assignment operator
+  ThreadManager& operator=(const ThreadManager&) = delete;
+
+  /// \brief No move assignment operator
+  ThreadManager& operator=(ThreadManager&&) = delete;
+
+  /// \brief Release the reference of the thread, at thread exit
+  ///
+  /// The manager is freed if no abstract value refers to it anymore.
+  ~ThreadManager() {
+    Registry& r = registry();
+    std::lock_guard< std::mutex > lock(r.mutex);
+    r.owners.erase(this->_man);
+    this->release_pending();
+    ap_manager_free(this->_man);
+  }
+
+  /// \brief Return the manager, for the owner thread only
+  ap_manager_t* get() {
+    this->release_pending();
+    return this->_man;
+  }
+
+  /// \brief Release a reference on a manager owned by another thread
+  static void release(ap_manager_t* man) {
+    Registry& r = registry();
+    std::lock_guard< std::mutex > lock(r.mutex);
+    auto it = r.owners.find(man);
+    if (it != r.owners.end()) {
+      // The owner thread is alive, it will release the reference
+      it->second->_pending.fetch_add(1, std::memory_order_relaxed);
+    } else {
+      // The owner thread has exited, nobody else updates the reference count
+      ap_manager_free(man);
+    }
+  }
+
+private:
+  /// \brief Release the references released by other threads
+  ///
+  /// The thread holds a reference, so this never frees the manager.
+  void release_pending() {
+    std::size_t n = this->_pending.exchange(0, std::memory_order_relaxed);
+    for (; n > 0; n--) {
+      ap_manager_free(this->_man);
+    }
+  }
+
+}; // end class ThreadManager
+
 } // end namespace apron
 
 /// \brief Wrapper for APRON abstract domains
@@ -256,7 +348,9 @@ private:
 
   /// \brief Deleter for ap_abstract0_t*
   struct InvDeleter {
-    void operator()(ap_abstract0_t* inv) { ap_abstract0_free(manager(), inv); }
+    void operator()(ap_abstract0_t* inv) {
+      ap_abstract0_free(manager(), bind(inv));
+    }
   };
 
   /// \brief Wrapper for ap_abstract0_t
@@ -269,10 +363,29 @@ private:
 
 private:
   /// \brief Get the manager for the given apron domain
+  ///
+  /// APRON managers are not thread-safe, so each thread uses its own manager.
   static ap_manager_t* manager() {
-    // Initialized at first call
-    static ap_manager_t* Man = apron::alloc_domain_manager(Domain);
-    return Man;
+    // Initialized at first call in each thread
+    static thread_local apron::ThreadManager Man(Domain);
+    return Man.get();
+  }
+
+  /// \brief Bind the given abstract value to the manager of the current thread
+  ///
+  /// An abstract value holds a reference on the manager that created it, which
+  /// is released by destructive operations. Reference counts of managers are
+  /// not atomic, hence an abstract value coming from another thread must be
+  /// bound to the current manager before a destructive operation. The
+  /// reference on the previous manager is handed back to its owner thread.
+  static ap_abstract0_t* bind(ap_abstract0_t* inv) {
+    ap_manager_t* man = manager();
+    if (inv->man != man) {
+      ap_manager_t* prev = inv->man;
+      inv->man = ap_manager_copy(man);
+      apron::ThreadManager::release(prev);
+    }
+    return inv;
   }
 
   /*
@@ -337,7 +450,7 @@ private:
     ap_dimchange_t* dimchange = add_dimensions(this->_inv.get(), 1);
     ap_abstract0_add_dimensions(manager(),
                                 true,
-                                this->_inv.get(),
+                                bind(this->_inv.get()),
                                 dimchange,
                                 false);
     ap_dimchange_free(dimchange);
@@ -355,6 +468,8 @@ private:
                                     ap_abstract0_t* rhs_inv) {
     ikos_assert(lhs_var_map.size() == dimension(lhs_inv));
     ikos_assert(rhs_var_map.size() == dimension(rhs_inv));
+    bind(lhs_inv);
+    bind(rhs_inv);
 
     // Build a result variable map, based on lhs_var_map
     VariableMap result = lhs_var_map;
@@ -663,13 +778,19 @@ public:
     } else if (ap_abstract0_is_bottom(manager(), other._inv.get())) {
       return;
     } else if (this->same_var_map(other)) {
-      ap_abstract0_join(manager(), true, this->_inv.get(), other._inv.get());
+      ap_abstract0_join(manager(),
+                        true,
+                        bind(this->_inv.get()),
+                        other._inv.get());
     } else {
       this->_var_map = merge_var_maps(this->_var_map,
                                       this->_inv.get(),
                                       other._var_map,
                                       other._inv.get());
-      ap_abstract0_join(manager(), true, this->_inv.get(), other._inv.get());
+      ap_abstract0_join(manager(),
+                        true,
+                        bind(this->_inv.get()),
+                        other._inv.get());
     }
   }
 
@@ -688,14 +809,17 @@ public:
     } else if (ap_abstract0_is_bottom(manager(), other._inv.get())) {
       return;
     } else if (this->same_var_map(other)) {
-      ap_abstract0_join(manager(), true, this->_inv.get(), other._inv.get());
+      ap_abstract0_join(manager(),
+                        true,
+                        bind(this->_inv.get()),
+                        other._inv.get());
     } else {
       InvPtr rhs = InvPtr(ap_abstract0_copy(manager(), other._inv.get()));
       this->_var_map = merge_var_maps(this->_var_map,
                                       this->_inv.get(),
                                       other._var_map,
                                       rhs.get());
-      ap_abstract0_join(manager(), true, this->_inv.get(), rhs.get());
+      ap_abstract0_join(manager(), true, bind(this->_inv.get()), rhs.get());
     }
   }
 
@@ -871,7 +995,7 @@ public:
     ap_dim_t v_dim = this->var_dim_insert(x);
     ap_abstract0_assign_texpr(manager(),
                               true,
-                              this->_inv.get(),
+                              bind(this->_inv.get()),
                               v_dim,
                               t,
                               nullptr);
@@ -925,7 +1049,7 @@ private:
     ap_dim_t x_dim = this->var_dim_insert(x);
     ap_abstract0_assign_texpr(manager(),
                               true,
-                              this->_inv.get(),
+                              bind(this->_inv.get()),
                               x_dim,
                               t,
                               nullptr);
@@ -1022,7 +1146,10 @@ public:
       ap_csts.p[i++] = this->to_ap_constraint(cst);
     }
 
-    ap_abstract0_meet_tcons_array(manager(), true, this->_inv.get(), &ap_csts);
+    ap_abstract0_meet_tcons_array(manager(),
+                                  true,
+                                  bind(this->_inv.get()),
+                                  &ap_csts);
 
     // Improve the precision
     for (i = 0; i < csts.size() &&
@@ -1110,7 +1237,10 @@ public:
           ap_tcons0_make(AP_CONS_EQMOD,
                          this->to_ap_expr(VariableExprT(x) - value.residue()),
                          apron::to_ap_scalar(value.modulus()));
-      ap_abstract0_meet_tcons_array(manager(), true, this->_inv.get(), &csts);
+      ap_abstract0_meet_tcons_array(manager(),
+                                    true,
+                                    bind(this->_inv.get()),
+                                    &csts);
       ap_tcons0_array_clear(&csts);
     }
   }
@@ -1138,7 +1268,7 @@ public:
     std::vector< ap_dim_t > vector_dims{dim};
     ap_abstract0_forget_array(manager(),
                               true,
-                              this->_inv.get(),
+                              bind(this->_inv.get()),
                               &vector_dims[0],
                               vector_dims.size(),
                               false);
@@ -1146,7 +1276,7 @@ public:
         remove_dimensions(this->_inv.get(), vector_dims);
     ap_abstract0_remove_dimensions(manager(),
                                    true,
-                                   this->_inv.get(),
+                                   bind(this->_inv.get()),
                                    dimchange);
     ap_dimchange_free(dimchange);
     this->_var_map.transform([dim](VariableRef, ap_dim_t d) {
@@ -46,9 +46,13 @@
 
 #pragma once
 
+#include <type_traits>
+#include <vector>
+
 #include <boost/iterator/transform_iterator.hpp>
 
 #include <ikos/core/domain/numeric/abstract_domain.hpp>
+#include <ikos/core/domain/numeric/dense_closure.hpp>
 #include <ikos/core/domain/numeric/linear_interval_solver.hpp>
 #include <ikos/core/number/bound.hpp>
 #include <ikos/core/support/assert.hpp>
@@ -181,6 +185,10 @@ private:
         this->_matrix[n * i + i] = BoundT(0);
       }
 
+      if (this->dense_normalize(std::is_same< Number, ZNumber >{})) {
+        return;
+      }
+
       for (MatrixIndex k = 0; k < n; k++) {
         for (MatrixIndex i = 0; i < n; i++) {
           for (MatrixIndex j = 0; j < n; j++) {
@@ -192,6 +200,36 @@ private:
       }
     }
 
+  private:
+    /// \brief Apply Floyd-Warshall algorithm on a dense copy of the matrix
+    ///
+    /// \returns false if the matrix cannot be represented with machine
+    /// integers, in which case the matrix is left unchanged.
+    bool dense_normalize(std::true_type) {
+      const std::size_t size = this->_matrix.size();
+      std::vector< dense_closure::Weight > dense(size);
+
+      for (std::size_t i = 0; i < size; i++) {
+        if (!dense_closure::to_weight(this->_matrix[i], dense[i])) {
+          return false;
+        }
+      }
+
+      if (dense_closure::floyd_warshall(dense.data(), this->_num_vars) ==
+          dense_closure::Result::Overflow) {
+        return false;
+      }
+
+      for (std::size_t i = 0; i < size; i++) {
+        this->_matrix[i] = dense_closure::to_bound(dense[i]);
+      }
+      return true;
+    }
+
+    /// \brief Only matrices of `Bound< ZNumber >` have a dense representation
+    bool dense_normalize(std::false_type) { return false; }
+
+  public:
     /// \brief Return true if the matrix has a negative cycle
     ///
     /// Precondition: matrix is normalized
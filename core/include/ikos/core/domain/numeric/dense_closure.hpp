@@ -0,0 +1,584 @@
+/*******************************************************************************
+ *
+ * \file
+ * \brief Dense min-plus closure kernels for DBM-like matrices
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <boost/optional.hpp>
+
+#include <ikos/core/number/bound.hpp>
+#include <ikos/core/number/z_number.hpp>
+#include <ikos/core/support/compiler.hpp>
+
+// clang-format off
+
+/// \macro IKOS_DENSE_CLOSURE_X86
+/// \brief Defined to 1 if the SSE4.2 and AVX2 kernels are available
+#if defined(__x86_64__) && \
+    (defined(__clang__) || IKOS_GNUC_PREREQ(4, 9, 0))
+# define IKOS_DENSE_CLOSURE_X86 1
+# include <immintrin.h>
+#else
+# define IKOS_DENSE_CLOSURE_X86 0
+#endif
+
+// clang-format on
+
+namespace ikos {
+namespace core {
+namespace numeric {
+namespace dense_closure {
+
+/// \brief Weight of a dense matrix
+///
+/// The closure of a matrix of `Bound< ZNumber >` cannot be vectorized. When all
+/// the finite bounds fit in a machine integer, the matrix is copied into a
+/// dense matrix of machine integers where +oo is represented by a sentinel,
+/// and the closure is computed with the kernels below.
+using Weight = int64_t;
+
+/// \brief Sentinel for +oo
+constexpr Weight PlusInfinity = Weight(1) << 62;
+
+/// \brief Largest absolute value of a finite weight in the input matrix
+constexpr Weight MaxInputWeight = Weight(1) << 58;
+
+/// \brief Smallest weight allowed during the closure
+///
+/// Weights only decrease during the closure. If a weight goes below this
+/// limit, the closure is aborted and the caller falls back to the closure on
+/// `Bound< ZNumber >`, to avoid any overflow.
+constexpr Weight MinWeight = -(Weight(1) << 60);
+
+/// \brief Convert a bound into a weight
+///
+/// \returns false if the bound cannot be represented
+inline bool to_weight(const Bound< ZNumber >& b, Weight& w) {
+  if (b.is_plus_infinity()) {
+    w = PlusInfinity;
+    return true;
+  } else if (b.is_minus_infinity()) {
+    return false;
+  }
+  boost::optional< ZNumber > n = b.number();
+  if (!n->fits< int64_t >()) {
+    return false;
+  }
+  w = n->to< int64_t >();
+  return -MaxInputWeight <= w && w <= MaxInputWeight;
+}
+
+/// \brief Convert a weight into a bound
+inline Bound< ZNumber > to_bound(Weight w) {
+  if (w >= PlusInfinity) {
+    return Bound< ZNumber >::plus_infinity();
+  } else {
+    return Bound< ZNumber >(ZNumber(w));
+  }
+}
+
+namespace detail {
+
+/// \brief Row kernel: dst[j] = min(dst[j], c + src[j])
+///
+/// Precondition: c != +oo
+///
+/// \returns the minimum of the updated row
+using MinPlusRowFn = Weight (*)(Weight* dst,
+                                const Weight* src,
+                                Weight c,
+                                std::size_t n);
+
+/// \brief Row kernel: dst[j] = min(dst[j], c1 + src1[j], c2 + src2[j])
+///
+/// Precondition: c1 != +oo and c2 != +oo
+///
+/// \returns the minimum of the updated row
+using MinPlusRow2Fn = Weight (*)(Weight* dst,
+                                 const Weight* src1,
+                                 Weight c1,
+                                 const Weight* src2,
+                                 Weight c2,
+                                 std::size_t n);
+
+/// \brief Row kernel: dst[j] = min(dst[j], (c + src[j]) / 2)
+///
+/// The division rounds towards zero, as `Bound< ZNumber >`.
+///
+/// Precondition: c != +oo
+using MinHalfRowFn = void (*)(Weight* dst,
+                              const Weight* src,
+                              Weight c,
+                              std::size_t n);
+
+inline Weight min_plus_row_scalar(Weight* dst,
+                                  const Weight* src,
+                                  Weight c,
+                                  std::size_t n) {
+  Weight row_min = PlusInfinity;
+  for (std::size_t j = 0; j < n; j++) {
+    Weight s = src[j];
+    Weight v = c + s;
+    Weight d = dst[j];
+    d = (s != PlusInfinity && v < d) ? v : d;
+    dst[j] = d;
+    row_min = std::min(row_min, d);
+  }
+  return row_min;
+}
+
+inline Weight min_plus_row2_scalar(Weight* dst,
+                                   const Weight* src1,
+                                   Weight c1,
+                                   const Weight* src2,
+                                   Weight c2,
+                                   std::size_t n) {
+  Weight row_min = PlusInfinity;
+  for (std::size_t j = 0; j < n; j++) {
+    Weight s1 = src1[j];
+    Weight s2 = src2[j];
+    Weight v1 = c1 + s1;
+    Weight v2 = c2 + s2;
+    Weight d = dst[j];
+    d = (s1 != PlusInfinity && v1 < d) ? v1 : d;
+    d = (s2 != PlusInfinity && v2 < d) ? v2 : d;
+    dst[j] = d;
+    row_min = std::min(row_min, d);
+  }
+  return row_min;
+}
+
+inline void min_half_row_scalar(Weight* dst,
+                                const Weight* src,
+                                Weight c,
+                                std::size_t n) {
+  for (std::size_t j = 0; j < n; j++) {
+    Weight s = src[j];
+    Weight v = (c + s) / 2;
+    Weight d = dst[j];
+    dst[j] = (s != PlusInfinity && v < d) ? v : d;
+  }
+}
+
+#if IKOS_DENSE_CLOSURE_X86
+
+// The SSE4.2 and AVX2 kernels are compiled with the target attribute, so that
+// the rest of the code does not depend on the instruction set of the host.
+// There is no 64-bit integer minimum before AVX-512, hence the compare and
+// blend sequences.
+
+__attribute__((target("sse4.2"))) inline Weight min_plus_row_sse42(
+    Weight* dst, const Weight* src, Weight c, std::size_t n) {
+  const __m128i inf = _mm_set1_epi64x(PlusInfinity);
+  const __m128i vc = _mm_set1_epi64x(c);
+  __m128i vmin = inf;
+  std::size_t j = 0;
+  for (; j + 2 <= n; j += 2) {
+    __m128i s = _mm_loadu_si128(reinterpret_cast< const __m128i* >(src + j));
+    __m128i d = _mm_loadu_si128(reinterpret_cast< const __m128i* >(dst + j));
+    __m128i v = _mm_add_epi64(vc, s);
+    __m128i take = _mm_andnot_si128(_mm_cmpeq_epi64(s, inf),
+                                    _mm_cmpgt_epi64(d, v));
+    d = _mm_blendv_epi8(d, v, take);
+    _mm_storeu_si128(reinterpret_cast< __m128i* >(dst + j), d);
+    vmin = _mm_blendv_epi8(vmin, d, _mm_cmpgt_epi64(vmin, d));
+  }
+  Weight row_min =
+      std::min(_mm_extract_epi64(vmin, 0), _mm_extract_epi64(vmin, 1));
+  return std::min(row_min, min_plus_row_scalar(dst + j, src + j, c, n - j));
+}
+
+__attribute__((target("sse4.2"))) inline Weight min_plus_row2_sse42(
+    Weight* dst,
+    const Weight* src1,
+    Weight c1,
+    const Weight* src2,
+    Weight c2,
+    std::size_t n) {
+  const __m128i inf = _mm_set1_epi64x(PlusInfinity);
+  const __m128i vc1 = _mm_set1_epi64x(c1);
+  const __m128i vc2 = _mm_set1_epi64x(c2);
+  __m128i vmin = inf;
+  std::size_t j = 0;
+  for (; j + 2 <= n; j += 2) {
+    __m128i s1 = _mm_loadu_si128(reinterpret_cast< const __m128i* >(src1 + j));
+    __m128i s2 = _mm_loadu_si128(reinterpret_cast< const __m128i* >(src2 + j));
+    __m128i d = _mm_loadu_si128(reinterpret_cast< const __m128i* >(dst + j));
+    __m128i v1 = _mm_add_epi64(vc1, s1);
+    __m128i v2 = _mm_add_epi64(vc2, s2);
+    d = _mm_blendv_epi8(d,
+                        v1,
+                        _mm_andnot_si128(_mm_cmpeq_epi64(s1, inf),
+                                         _mm_cmpgt_epi64(d, v1)));
+    d = _mm_blendv_epi8(d,
+                        v2,
+                        _mm_andnot_si128(_mm_cmpeq_epi64(s2, inf),
+                                         _mm_cmpgt_epi64(d, v2)));
+    _mm_storeu_si128(reinterpret_cast< __m128i* >(dst + j), d);
+    vmin = _mm_blendv_epi8(vmin, d, _mm_cmpgt_epi64(vmin, d));
+  }
+  Weight row_min =
+      std::min(_mm_extract_epi64(vmin, 0), _mm_extract_epi64(vmin, 1));
+  return std::min(row_min,
+                  min_plus_row2_scalar(dst + j,
+                                       src1 + j,
+                                       c1,
+                                       src2 + j,
+                                       c2,
+                                       n - j));
+}
+
+__attribute__((target("sse4.2"))) inline void min_half_row_sse42(
+    Weight* dst, const Weight* src, Weight c, std::size_t n) {
+  const __m128i inf = _mm_set1_epi64x(PlusInfinity);
+  const __m128i sign = _mm_set1_epi64x(std::numeric_limits< Weight >::min());
+  const __m128i vc = _mm_set1_epi64x(c);
+  const __m128i zero = _mm_setzero_si128();
+  std::size_t j = 0;
+  for (; j + 2 <= n; j += 2) {
+    __m128i s = _mm_loadu_si128(reinterpret_cast< const __m128i* >(src + j));
+    __m128i d = _mm_loadu_si128(reinterpret_cast< const __m128i* >(dst + j));
+    __m128i v = _mm_add_epi64(vc, s);
+    // Round towards zero: add 1 if negative, then arithmetic shift
+    v = _mm_sub_epi64(v, _mm_cmpgt_epi64(zero, v));
+    v = _mm_or_si128(_mm_srli_epi64(v, 1), _mm_and_si128(v, sign));
+    __m128i take = _mm_andnot_si128(_mm_cmpeq_epi64(s, inf),
+                                    _mm_cmpgt_epi64(d, v));
+    d = _mm_blendv_epi8(d, v, take);
+    _mm_storeu_si128(reinterpret_cast< __m128i* >(dst + j), d);
+  }
+  min_half_row_scalar(dst + j, src + j, c, n - j);
+}
+
+__attribute__((target("avx2"))) inline Weight min_plus_row_avx2(
+    Weight* dst, const Weight* src, Weight c, std::size_t n) {
+  const __m256i inf = _mm256_set1_epi64x(PlusInfinity);
+  const __m256i vc = _mm256_set1_epi64x(c);
+  __m256i vmin = inf;
+  std::size_t j = 0;
+  for (; j + 4 <= n; j += 4) {
+    __m256i s =
+        _mm256_loadu_si256(reinterpret_cast< const __m256i* >(src + j));
+    __m256i d =
+        _mm256_loadu_si256(reinterpret_cast< const __m256i* >(dst + j));
+    __m256i v = _mm256_add_epi64(vc, s);
+    __m256i take = _mm256_andnot_si256(_mm256_cmpeq_epi64(s, inf),
+                                       _mm256_cmpgt_epi64(d, v));
+    d = _mm256_blendv_epi8(d, v, take);
+    _mm256_storeu_si256(reinterpret_cast< __m256i* >(dst + j), d);
+    vmin = _mm256_blendv_epi8(vmin, d, _mm256_cmpgt_epi64(vmin, d));
+  }
+  alignas(32) Weight mins[4];
+  _mm256_store_si256(reinterpret_cast< __m256i* >(mins), vmin);
+  Weight row_min =
+      std::min(std::min(mins[0], mins[1]), std::min(mins[2], mins[3]));
+  return std::min(row_min, min_plus_row_scalar(dst + j, src + j, c, n - j));
+}
+
+__attribute__((target("avx2"))) inline Weight min_plus_row2_avx2(
+    Weight* dst,
+    const Weight* src1,
+    Weight c1,
+    const Weight* src2,
+    Weight c2,
+    std::size_t n) {
+  const __m256i inf = _mm256_set1_epi64x(PlusInfinity);
+  const __m256i vc1 = _mm256_set1_epi64x(c1);
+  const __m256i vc2 = _mm256_set1_epi64x(c2);
+  __m256i vmin = inf;
+  std::size_t j = 0;
+  for (; j + 4 <= n; j += 4) {
+    __m256i s1 =
+        _mm256_loadu_si256(reinterpret_cast< const __m256i* >(src1 + j));
+    __m256i s2 =
+        _mm256_loadu_si256(reinterpret_cast< const __m256i* >(src2 + j));
+    __m256i d =
+        _mm256_loadu_si256(reinterpret_cast< const __m256i* >(dst + j));
+    __m256i v1 = _mm256_add_epi64(vc1, s1);
+    __m256i v2 = _mm256_add_epi64(vc2, s2);
+    d = _mm256_blendv_epi8(d,
+                           v1,
+                           _mm256_andnot_si256(_mm256_cmpeq_epi64(s1, inf),
+                                               _mm256_cmpgt_epi64(d, v1)));
+    d = _mm256_blendv_epi8(d,
+                           v2,
+                           _mm256_andnot_si256(_mm256_cmpeq_epi64(s2, inf),
+                                               _mm256_cmpgt_epi64(d, v2)));
+    _mm256_storeu_si256(reinterpret_cast< __m256i* >(dst + j), d);
+    vmin = _mm256_blendv_epi8(vmin, d, _mm256_cmpgt_epi64(vmin, d));
+  }
+  alignas(32) Weight mins[4];
+  _mm256_store_si256(reinterpret_cast< __m256i* >(mins), vmin);
+  Weight row_min =
+      std::min(std::min(mins[0], mins[1]), std::min(mins[2], mins[3]));
+  return std::min(row_min,
+                  min_plus_row2_scalar(dst + j,
+                                       src1 + j,
+                                       c1,
+                                       src2 + j,
+                                       c2,
+                                       n - j));
+}
+
+__attribute__((target("avx2"))) inline void min_half_row_avx2(
+    Weight* dst, const Weight* src, Weight c, std::size_t n) {
+  const __m256i inf = _mm256_set1_epi64x(PlusInfinity);
+  const __m256i sign =
+      _mm256_set1_epi64x(std::numeric_limits< Weight >::min());
+  const __m256i vc = _mm256_set1_epi64x(c);
+  const __m256i zero = _mm256_setzero_si256();
+  std::size_t j = 0;
+  for (; j + 4 <= n; j += 4) {
+    __m256i s =
+        _mm256_loadu_si256(reinterpret_cast< const __m256i* >(src + j));
+    __m256i d =
+        _mm256_loadu_si256(reinterpret_cast< const __m256i* >(dst + j));
+    __m256i v = _mm256_add_epi64(vc, s);
+    // Round towards zero: add 1 if negative, then arithmetic shift
+    v = _mm256_sub_epi64(v, _mm256_cmpgt_epi64(zero, v));
+    v = _mm256_or_si256(_mm256_srli_epi64(v, 1), _mm256_and_si256(v, sign));
+    __m256i take = _mm256_andnot_si256(_mm256_cmpeq_epi64(s, inf),
+                                       _mm256_cmpgt_epi64(d, v));
+    d = _mm256_blendv_epi8(d, v, take);
+    _mm256_storeu_si256(reinterpret_cast< __m256i* >(dst + j), d);
+  }
+  min_half_row_scalar(dst + j, src + j, c, n - j);
+}
+
+#endif // IKOS_DENSE_CLOSURE_X86
+
+/// \brief Set of row kernels for a given instruction set
+struct Kernels {
+  const char* name;
+  MinPlusRowFn min_plus_row;
+  MinPlusRow2Fn min_plus_row2;
+  MinHalfRowFn min_half_row;
+};
+
+/// \brief Return the scalar kernels
+inline Kernels scalar_kernels() {
+  return Kernels{"scalar",
+                 min_plus_row_scalar,
+                 min_plus_row2_scalar,
+                 min_half_row_scalar};
+}
+
+/// \brief Return the SSE4.2 kernels, or the scalar ones if not supported
+inline Kernels sse42_kernels() {
+#if IKOS_DENSE_CLOSURE_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("sse4.2")) {
+    return Kernels{"sse4.2",
+                   min_plus_row_sse42,
+                   min_plus_row2_sse42,
+                   min_half_row_sse42};
+  }
+#endif
+  return scalar_kernels();
+}
+
+/// \brief Return the AVX2 kernels, or the SSE4.2 ones if not supported
+inline Kernels avx2_kernels() {
+#if IKOS_DENSE_CLOSURE_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    return Kernels{"avx2",
+                   min_plus_row_avx2,
+                   min_plus_row2_avx2,
+                   min_half_row_avx2};
+  }
+#endif
+  return sse42_kernels();
+}
+
+/// \brief Return the best kernels for the host, selected at runtime
+inline const Kernels& kernels() {
+  static const Kernels k = avx2_kernels();
+  return k;
+}
+
+} // end namespace detail
+
+/// \brief Return the name of the instruction set used by the kernels
+inline const char* kernels_name() {
+  return detail::kernels().name;
+}
+
+/// \brief Result of a closure
+enum class Result {
+  /// \brief The matrix is closed
+  Closed,
+
+  /// \brief The matrix has a negative cycle
+  ///
+  /// At least one element of the diagonal is negative.
+  NegativeCycle,
+
+  /// \brief A weight went out of range, the matrix is in an undefined state
+  Overflow,
+};
+
+/// \brief Floyd-Warshall algorithm on a dense n x n matrix
+///
+/// The matrix is stored in row-major order. This computes the same closure as
+/// the Floyd-Warshall algorithm on `Bound< ZNumber >`, as long as there is no
+/// negative cycle. The diagonal must be initialized to 0.
+inline Result floyd_warshall(
+    Weight* m,
+    std::size_t n,
+    const detail::Kernels& k = detail::kernels()) {
+  for (std::size_t p = 0; p < n; p++) {
+    if (m[n * p + p] < 0) {
+      return Result::NegativeCycle;
+    }
+
+    const Weight* row_p = m + n * p;
+    for (std::size_t i = 0; i < n; i++) {
+      Weight c = m[n * i + p];
+      if (i == p || c == PlusInfinity) {
+        // Row p does not change since m[p, p] >= 0
+        continue;
+      }
+      if (k.min_plus_row(m + n * i, row_p, c, n) < MinWeight) {
+        return Result::Overflow;
+      }
+    }
+  }
+
+  for (std::size_t i = 0; i < n; i++) {
+    if (m[n * i + i] < 0) {
+      return Result::NegativeCycle;
+    }
+  }
+
+  return Result::Closed;
+}
+
+/// \brief One step of the strong closure of an octagon, for variable `v`
+///
+/// The dense n x n matrix is stored in row-major order, and the variable `v`
+/// is represented by the rows and columns 2v and 2v+1. This computes the same
+/// result as the step of the strong closure on `Bound< ZNumber >`, as long as
+/// there is no negative cycle.
+///
+/// \param m The matrix
+/// \param n The dimension of the matrix (i.e, twice the number of variables)
+/// \param v The variable
+/// \param diag Buffer used to store the elements m[i', i]
+/// \param k The row kernels
+inline Result octagon_strong_closure_step(
+    Weight* m,
+    std::size_t n,
+    std::size_t v,
+    std::vector< Weight >& diag,
+    const detail::Kernels& k = detail::kernels()) {
+  const std::size_t p = 2 * v;
+  const std::size_t q = 2 * v + 1;
+  const Weight m_pq = m[n * p + q];
+  const Weight m_qp = m[n * q + p];
+
+  if (m[n * p + p] < 0 || m[n * q + q] < 0) {
+    return Result::NegativeCycle;
+  }
+  if (m_pq != PlusInfinity && m_qp != PlusInfinity && m_pq + m_qp < 0) {
+    m[n * p + p] = m_pq + m_qp;
+    return Result::NegativeCycle;
+  }
+
+  // m[i, j] = min(m[i, j],
+  //               m[i, p] + m[p, j],
+  //               m[i, q] + m[q, j],
+  //               m[i, p] + m[p, q] + m[q, j],
+  //               m[i, q] + m[q, p] + m[p, j])
+  for (std::size_t i = 0; i < n; i++) {
+    Weight m_ip = m[n * i + p];
+    Weight m_iq = m[n * i + q];
+    Weight c1 = m_ip;
+    if (m_iq != PlusInfinity && m_qp != PlusInfinity) {
+      c1 = std::min(c1, m_iq + m_qp);
+    }
+    Weight c2 = m_iq;
+    if (m_ip != PlusInfinity && m_pq != PlusInfinity) {
+      c2 = std::min(c2, m_ip + m_pq);
+    }
+
+    Weight row_min;
+    if (c1 != PlusInfinity && c2 != PlusInfinity) {
+      row_min =
+          k.min_plus_row2(m + n * i, m + n * p, c1, m + n * q, c2, n);
+    } else if (c1 != PlusInfinity) {
+      row_min = k.min_plus_row(m + n * i, m + n * p, c1, n);
+    } else if (c2 != PlusInfinity) {
+      row_min = k.min_plus_row(m + n * i, m + n * q, c2, n);
+    } else {
+      continue;
+    }
+    if (row_min < MinWeight) {
+      return Result::Overflow;
+    }
+  }
+
+  // m[i, j] = min(m[i, j], (m[i, i'] + m[j', j]) / 2)
+  diag.resize(n);
+  for (std::size_t j = 0; j < n; j++) {
+    diag[j] = m[n * (j ^ 1) + j];
+  }
+  for (std::size_t i = 0; i < n; i++) {
+    Weight c = m[n * i + (i ^ 1)];
+    if (c != PlusInfinity) {
+      k.min_half_row(m + n * i, diag.data(), c, n);
+    }
+  }
+
+  return Result::Closed;
+}
+
+} // end namespace dense_closure
+} // end namespace numeric
+} // end namespace core
+} // end namespace ikos
@@ -54,6 +54,7 @@
 #include <ikos/core/domain/numeric/interval.hpp>
 #include <ikos/core/linear_constraint.hpp>
 #include <ikos/core/linear_expression.hpp>
+#include <ikos/core/serialization/stream.hpp>
 #include <ikos/core/value/numeric/gauge.hpp>
 
 namespace ikos {
@@ -78,6 +79,9 @@ public:
 private:
   using PatriciaTreeMapT = PatriciaTreeMap< VariableRef, GaugeT >;
 
+public:
+  friend struct serialization::Serializer< GaugeSemiLattice >;
+
 private:
   PatriciaTreeMapT _tree;
   bool _is_bottom;
@@ -474,6 +478,9 @@ public:
   using CounterSetT = PatriciaTreeSet< VariableRef >;
   using IntervalDomainT = IntervalDomain< Number, VariableRef >;
 
+public:
+  friend struct serialization::Serializer< GaugeDomain >;
+
 private:
   SectionDomainT _sections;
   GaugeSemiLatticeT _gauges;
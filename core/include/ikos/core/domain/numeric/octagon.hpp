@@ -48,12 +48,14 @@
 
 #pragma once
 
+#include <type_traits>
 #include <vector>
 
 #include <boost/container/flat_map.hpp>
 #include <boost/optional.hpp>
 
 #include <ikos/core/domain/numeric/abstract_domain.hpp>
+#include <ikos/core/domain/numeric/dense_closure.hpp>
 #include <ikos/core/domain/numeric/interval.hpp>
 #include <ikos/core/number/bound.hpp>
 #include <ikos/core/support/assert.hpp>
@@ -302,6 +304,57 @@ private:
     this->_norm_vector.resize(this->_var_index_map.size(), 0);
   }
 
+  /// \brief Compute the strong closure on a dense copy of the matrix
+  ///
+  /// If all the bounds fit in machine integers, this computes the strong
+  /// closure for all variables and marks them in the normalization vector.
+  /// Otherwise, the matrix is left unchanged.
+  void dense_strong_closure(std::true_type) {
+    const MatrixIndex num_var = this->_matrix.size();
+    const MatrixIndex n = 2 * num_var;
+    std::vector< dense_closure::Weight > dense(n * n);
+    std::vector< dense_closure::Weight > diag;
+
+    for (MatrixIndex i = 1; i <= n; ++i) {
+      for (MatrixIndex j = 1; j <= n; ++j) {
+        if (!dense_closure::to_weight(this->_matrix(i, j),
+                                      dense[n * (i - 1) + (j - 1)])) {
+          return;
+        }
+      }
+    }
+
+    for (MatrixIndex k = 1; k <= num_var; ++k) {
+      if (this->_norm_vector[k - 1]) {
+        continue;
+      }
+
+      dense_closure::Result result =
+          dense_closure::octagon_strong_closure_step(dense.data(),
+                                                     n,
+                                                     k - 1,
+                                                     diag);
+      if (result == dense_closure::Result::Overflow) {
+        return;
+      } else if (result == dense_closure::Result::NegativeCycle) {
+        break; // The diagonal has a negative element
+      }
+    }
+
+    for (MatrixIndex i = 1; i <= n; ++i) {
+      for (MatrixIndex j = 1; j <= n; ++j) {
+        this->_matrix(i, j) =
+            dense_closure::to_bound(dense[n * (i - 1) + (j - 1)]);
+      }
+    }
+    for (auto it = _norm_vector.begin(); it != _norm_vector.end(); ++it) {
+      *it = 1;
+    }
+  }
+
+  /// \brief Only matrices of `Bound< ZNumber >` have a dense representation
+  void dense_strong_closure(std::false_type) {}
+
   /// \brief Compute the strong closure algorithm
   ///
   /// TODO(marthaud): This is not thread-safe.
@@ -319,6 +372,9 @@ private:
 
     const MatrixIndex num_var = this->_matrix.size();
 
+    // Use the dense kernels when possible, this marks the closed variables
+    self->dense_strong_closure(std::is_same< Number, ZNumber >{});
+
     for (MatrixIndex k = 1; k <= num_var; ++k) {
       if (this->_norm_vector[k - 1]) {
         continue;
@@ -1017,6 +1073,10 @@ private:
 
   void apply_constraint(MatrixIndex var, bool is_positive, BoundT constraint) {
     // Application of single variable octagonal constraints.
+    if (this->_is_bottom) {
+      // The matrix has been cleared by a previous constraint
+      return;
+    }
     constraint *= BoundT(2);
     if (is_positive) { // 2*v1 <= constraint
       this->_matrix(2 * var, 2 * var - 1) =
@@ -1038,6 +1098,10 @@ private:
                         bool is2_positive,
                         const BoundT& constraint) {
     // Application of double variable octagonal constraints.
+    if (this->_is_bottom) {
+      // The matrix has been cleared by a previous constraint
+      return;
+    }
     if (is1_positive && is2_positive) { // v1 + v2 <= constraint
       this->_matrix(2 * j, 2 * i - 1) =
           min(this->_matrix(2 * j, 2 * i - 1), constraint);
@@ -1520,17 +1584,33 @@ public:
     this->set(x, value.interval());
   }
 
-  void refine(VariableRef /*x*/, const IntervalT& /*value*/) override {
-    // TODO(marthaud)
+  void refine(VariableRef x, const IntervalT& value) override {
+    if (this->_is_bottom) {
+      return;
+    }
+    if (value.is_bottom()) {
+      this->set_to_bottom();
+      return;
+    }
+    // add x in the matrix if not found
+    MatrixIndex idx =
+        this->_var_index_map.emplace(x, this->_var_index_map.size() + 1)
+            .first->second;
+    this->resize();
+    this->apply_constraint(idx, true, value.ub()); // x <= ub
+    if (this->_is_bottom) {
+      return;
+    }
+    this->apply_constraint(idx, false, -value.lb()); // -x <= -lb
+    this->_is_normalized = false;
   }
 
   void refine(VariableRef /*x*/, const CongruenceT& /*value*/) override {
     // TODO(marthaud)
   }
 
-  void refine(VariableRef /*x*/,
-              const IntervalCongruenceT& /*value*/) override {
-    // TODO(marthaud)
+  void refine(VariableRef x, const IntervalCongruenceT& value) override {
+    this->refine(x, value.interval());
   }
 
   void forget(VariableRef x) override {
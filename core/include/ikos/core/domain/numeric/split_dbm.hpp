@@ -0,0 +1,1585 @@
+/*******************************************************************************
+ *
+ * \file
+ * \brief Sparse domain of Difference-Bound Matrices with split normal form
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Based on Graeme Gange, Jorge A. Navas, Peter Schachte, Harald Sondergaard
+ * and Peter J. Stuckey's paper: Exploiting Sparsity in Difference-Bound
+ * Matrices, in SAS, 189-211, 2016.
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include <boost/container/flat_map.hpp>
+#include <boost/container/flat_set.hpp>
+#include <boost/iterator/transform_iterator.hpp>
+
+#include <ikos/core/domain/numeric/abstract_domain.hpp>
+#include <ikos/core/domain/numeric/linear_interval_solver.hpp>
+#include <ikos/core/number/bound.hpp>
+#include <ikos/core/support/assert.hpp>
+#include <ikos/core/value/numeric/congruence.hpp>
+#include <ikos/core/value/numeric/interval.hpp>
+#include <ikos/core/value/numeric/interval_congruence.hpp>
+
+namespace ikos {
+namespace core {
+namespace numeric {
+
+/// \brief Sparse Difference-Bound Matrices abstract domain
+///
+/// The constraints are stored in a sparse graph instead of a dense matrix.
+///
+/// Variable bounds (edges from and to the special vertex 0) are split from the
+/// relational edges: the graph is kept closed without using the vertex 0 as an
+/// intermediate vertex, and relational edges implied by the variable bounds are
+/// not stored. This avoids the quadratic number of edges created by the
+/// closure of a dense matrix when most variables have bounds.
+///
+/// The closure is maintained incrementally on assignments, constraints and
+/// joins. Only the widening, the meet and the narrowing require a full closure.
+template < typename Number,
+           typename VariableRef,
+           std::size_t MaxReductionCycles = 10 >
+class SplitDBM final
+    : public numeric::AbstractDomain<
+          Number,
+          VariableRef,
+          SplitDBM< Number, VariableRef, MaxReductionCycles > > {
+public:
+  using BoundT = Bound< Number >;
+  using IntervalT = Interval< Number >;
+  using CongruenceT = Congruence< Number >;
+  using IntervalCongruenceT = IntervalCongruence< Number >;
+  using VariableExprT = VariableExpression< Number, VariableRef >;
+  using LinearExpressionT = LinearExpression< Number, VariableRef >;
+  using LinearConstraintT = LinearConstraint< Number, VariableRef >;
+  using LinearConstraintSystemT = LinearConstraintSystem< Number, VariableRef >;
+
+private:
+  /// \brief Index of a variable in the graph
+  using VertexIndex = unsigned;
+
+  /// \brief Map from variable to vertex
+  using VarIndexMap = boost::container::flat_map< VariableRef, VertexIndex >;
+
+  /// \brief Solver
+  using LinearIntervalSolverT =
+      LinearIntervalSolver< Number, VariableRef, SplitDBM >;
+
+  /// \brief Parent
+  using Parent = numeric::AbstractDomain< Number, VariableRef, SplitDBM >;
+
+  /// \brief Marker for an invalid vertex
+  static constexpr VertexIndex None = std::numeric_limits< VertexIndex >::max();
+
+  /// \brief Sparse weighted graph
+  ///
+  /// An edge i -> j of weight w represents the constraint v_j - v_i <= w.
+  /// The vertex 0 represents the constant zero, so the edge 0 -> i is the
+  /// upper bound of v_i and the edge i -> 0 is the opposite of its lower bound.
+  class Graph {
+  public:
+    using SuccMap = boost::container::flat_map< VertexIndex, Number >;
+    using PredSet = boost::container::flat_set< VertexIndex >;
+
+  private:
+    struct Vertex {
+      SuccMap succs;
+      PredSet preds;
+    };
+
+  private:
+    std::vector< Vertex > _vertices;
+    std::vector< VertexIndex > _unused;
+
+  public:
+    /// \brief Create a graph with only the vertex 0
+    Graph() : _vertices(1) {}
+
+    /// \brief Copy constructor
+    Graph(const Graph&) = default;
+
+    /// \brief Move constructor
+    Graph(Graph&&) = default;
+
+    /// \brief Copy assignment operator
+    Graph& operator=(const Graph&) = default;
+
+    /// \brief Move assignment operator
+    Graph& operator=(Graph&&) = default;
+
+    /// \brief Destructor
+    ~Graph() = default;
+
+    /// \brief Return the number of vertices, including unused ones
+    VertexIndex num_vertices() const {
+      return static_cast< VertexIndex >(this->_vertices.size());
+    }
+
+    /// \brief Add a vertex without edges
+    VertexIndex add_vertex() {
+      if (!this->_unused.empty()) {
+        VertexIndex v = this->_unused.back();
+        this->_unused.pop_back();
+        return v;
+      }
+      this->_vertices.emplace_back();
+      return this->num_vertices() - 1;
+    }
+
+    /// \brief Remove a vertex and its edges
+    void remove_vertex(VertexIndex v) {
+      ikos_assert(v != 0);
+      this->clear_vertex(v);
+      this->_unused.push_back(v);
+    }
+
+    /// \brief Remove all the edges from and to the given vertex
+    void clear_vertex(VertexIndex v) {
+      Vertex& vertex = this->_vertices[v];
+      for (const auto& succ : vertex.succs) {
+        this->_vertices[succ.first].preds.erase(v);
+      }
+      for (VertexIndex pred : vertex.preds) {
+        this->_vertices[pred].succs.erase(v);
+      }
+      vertex.succs.clear();
+      vertex.preds.clear();
+    }
+
+    /// \brief Remove all the vertices
+    void clear() {
+      this->_vertices.clear();
+      this->_vertices.emplace_back();
+      this->_unused.clear();
+    }
+
+    /// \brief Return true if the graph has no edges
+    bool empty() const {
+      for (const Vertex& vertex : this->_vertices) {
+        if (!vertex.succs.empty()) {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    /// \brief Return true if the given vertex has no edges
+    bool empty(VertexIndex v) const {
+      return this->_vertices[v].succs.empty() &&
+             this->_vertices[v].preds.empty();
+    }
+
+    /// \brief Return the weight of the edge i -> j, or nullptr
+    const Number* edge(VertexIndex i, VertexIndex j) const {
+      const SuccMap& succs = this->_vertices[i].succs;
+      auto it = succs.find(j);
+      if (it == succs.end()) {
+        return nullptr;
+      }
+      return &it->second;
+    }
+
+    /// \brief Return the weight of the edge i -> j, or +oo
+    BoundT weight(VertexIndex i, VertexIndex j) const {
+      const Number* w = this->edge(i, j);
+      if (w == nullptr) {
+        return BoundT::plus_infinity();
+      }
+      return BoundT(*w);
+    }
+
+    /// \brief Set the weight of the edge i -> j
+    void set_edge(VertexIndex i, VertexIndex j, const Number& w) {
+      ikos_assert(i != j);
+      this->_vertices[i].succs[j] = w;
+      this->_vertices[j].preds.insert(i);
+    }
+
+    /// \brief Set the weight of the edge i -> j to min(weight(i, j), w)
+    ///
+    /// \returns true if the weight decreased
+    bool update_edge(VertexIndex i, VertexIndex j, const Number& w) {
+      ikos_assert(i != j);
+      SuccMap& succs = this->_vertices[i].succs;
+      auto it = succs.find(j);
+      if (it == succs.end()) {
+        succs.emplace(j, w);
+        this->_vertices[j].preds.insert(i);
+        return true;
+      } else if (w < it->second) {
+        it->second = w;
+        return true;
+      } else {
+        return false;
+      }
+    }
+
+    /// \brief Remove the edge i -> j
+    void remove_edge(VertexIndex i, VertexIndex j) {
+      this->_vertices[i].succs.erase(j);
+      this->_vertices[j].preds.erase(i);
+    }
+
+    /// \brief Return the successors of a vertex, with the edge weights
+    const SuccMap& succs(VertexIndex v) const {
+      return this->_vertices[v].succs;
+    }
+
+    /// \brief Return the predecessors of a vertex
+    const PredSet& preds(VertexIndex v) const {
+      return this->_vertices[v].preds;
+    }
+
+    /// \brief Apply v = v + c on the edges of v
+    void shift(VertexIndex v, const Number& c) {
+      for (auto& succ : this->_vertices[v].succs) {
+        succ.second -= c;
+      }
+      for (VertexIndex pred : this->_vertices[v].preds) {
+        this->_vertices[pred].succs.find(v)->second += c;
+      }
+    }
+
+  }; // end class Graph
+
+  /// \brief Edge to add in the graph
+  struct Edge {
+    VertexIndex src;
+    VertexIndex dest;
+    Number weight;
+  };
+
+private:
+  bool _is_bottom;
+  bool _is_normalized;
+  Graph _graph;
+  VarIndexMap _var_index_map;
+
+private:
+  struct TopTag {};
+  struct BottomTag {};
+
+  /// \brief Create the top abstract value
+  explicit SplitDBM(TopTag) : _is_bottom(false), _is_normalized(true) {}
+
+  /// \brief Create the bottom abstract value
+  explicit SplitDBM(BottomTag) : _is_bottom(true), _is_normalized(true) {}
+
+public:
+  /// \brief Create the top abstract value
+  static SplitDBM top() { return SplitDBM(TopTag{}); }
+
+  /// \brief Create the bottom abstract value
+  static SplitDBM bottom() { return SplitDBM(BottomTag{}); }
+
+  /// \brief Copy constructor
+  SplitDBM(const SplitDBM&) = default;
+
+  /// \brief Move constructor
+  SplitDBM(SplitDBM&&) = default;
+
+  /// \brief Copy assignment operator
+  SplitDBM& operator=(const SplitDBM&) = default;
+
+  /// \brief Move assignment operator
+  SplitDBM& operator=(SplitDBM&&) = default;
+
+  /// \brief Destructor
+  ~SplitDBM() override = default;
+
+private:
+  /// \brief Return the upper bound of v_j - v_i, using the variable bounds
+  ///
+  /// Precondition: the graph is closed
+  BoundT value(VertexIndex i, VertexIndex j) const {
+    if (i == j) {
+      return BoundT(0);
+    }
+    BoundT w = this->_graph.weight(i, j);
+    if (i != 0 && j != 0) {
+      BoundT implied = this->_graph.weight(0, j) + this->_graph.weight(i, 0);
+      if (implied < w) {
+        return implied;
+      }
+    }
+    return w;
+  }
+
+  /// \brief Return true if v_j - v_i <= w is implied by the variable bounds
+  bool is_implied(VertexIndex i, VertexIndex j, const Number& w) const {
+    return i != 0 && j != 0 &&
+           this->_graph.weight(0, j) + this->_graph.weight(i, 0) <= BoundT(w);
+  }
+
+  /// \brief Add the constraint v_j - v_i <= c and restore the closure
+  ///
+  /// Precondition: the graph is closed
+  void close_over_edge(VertexIndex i, VertexIndex j, const Number& c) {
+    ikos_assert(this->_is_normalized && !this->_is_bottom);
+    ikos_assert(i != j);
+
+    if (this->value(i, j) <= BoundT(c)) {
+      return; // Already implied
+    }
+    if (this->value(j, i) + BoundT(c) < BoundT(0)) {
+      this->set_to_bottom();
+      return;
+    }
+
+    // Paths a -> i -> j -> b, where 0 is not an intermediate vertex
+    std::vector< std::pair< VertexIndex, Number > > srcs;
+    std::vector< std::pair< VertexIndex, Number > > dests;
+    srcs.emplace_back(i, Number(0));
+    dests.emplace_back(j, Number(0));
+    if (i != 0) {
+      for (VertexIndex a : this->_graph.preds(i)) {
+        srcs.emplace_back(a, *this->_graph.edge(a, i));
+      }
+    }
+    if (j != 0) {
+      for (const auto& succ : this->_graph.succs(j)) {
+        dests.emplace_back(succ.first, succ.second);
+      }
+    }
+
+    // Compute the new weights before updating the graph
+    std::vector< Edge > bounds;
+    std::vector< Edge > relations;
+    for (const auto& src : srcs) {
+      for (const auto& dest : dests) {
+        if (src.first == dest.first) {
+          continue;
+        }
+        Number w = src.second + c + dest.second;
+        if (BoundT(w) < this->_graph.weight(src.first, dest.first)) {
+          if (src.first == 0 || dest.first == 0) {
+            bounds.push_back(Edge{src.first, dest.first, std::move(w)});
+          } else {
+            relations.push_back(Edge{src.first, dest.first, std::move(w)});
+          }
+        }
+      }
+    }
+
+    // Update the variable bounds first, to drop implied relations
+    for (const Edge& e : bounds) {
+      this->_graph.update_edge(e.src, e.dest, e.weight);
+    }
+    for (const Edge& e : relations) {
+      if (!this->is_implied(e.src, e.dest, e.weight)) {
+        this->_graph.update_edge(e.src, e.dest, e.weight);
+      }
+    }
+  }
+
+  /// \brief Remove the relational edges implied by the variable bounds
+  void remove_implied_edges() {
+    std::vector< std::pair< VertexIndex, VertexIndex > > implied;
+    for (VertexIndex i = 1; i < this->_graph.num_vertices(); i++) {
+      for (const auto& succ : this->_graph.succs(i)) {
+        if (this->is_implied(i, succ.first, succ.second)) {
+          implied.emplace_back(i, succ.first);
+        }
+      }
+    }
+    for (const auto& e : implied) {
+      this->_graph.remove_edge(e.first, e.second);
+    }
+  }
+
+public:
+  void normalize() override {
+    if (this->_is_normalized) {
+      return;
+    }
+
+    if (this->_is_bottom) {
+      this->set_to_bottom();
+      return;
+    }
+
+    // Floyd-Warshall algorithm on the sparse graph, without using 0 as an
+    // intermediate vertex
+    std::vector< std::pair< VertexIndex, Number > > preds;
+    std::vector< std::pair< VertexIndex, Number > > succs;
+    for (VertexIndex k = 1; k < this->_graph.num_vertices(); k++) {
+      preds.clear();
+      succs.clear();
+      for (VertexIndex i : this->_graph.preds(k)) {
+        preds.emplace_back(i, *this->_graph.edge(i, k));
+      }
+      for (const auto& succ : this->_graph.succs(k)) {
+        succs.emplace_back(succ.first, succ.second);
+      }
+
+      for (const auto& pred : preds) {
+        for (const auto& succ : succs) {
+          if (pred.first == succ.first) {
+            if (pred.second + succ.second < 0) {
+              this->set_to_bottom();
+              return;
+            }
+          } else {
+            this->_graph.update_edge(pred.first,
+                                     succ.first,
+                                     pred.second + succ.second);
+          }
+        }
+      }
+    }
+
+    // Check for negative cycle going through 0
+    for (VertexIndex i : this->_graph.preds(0)) {
+      if (this->_graph.weight(0, i) + this->_graph.weight(i, 0) < BoundT(0)) {
+        this->set_to_bottom();
+        return;
+      }
+    }
+
+    this->remove_implied_edges();
+    this->_is_normalized = true;
+  }
+
+  bool is_bottom() const override {
+    if (this->_is_normalized) {
+      return this->_is_bottom;
+    } else if (this->_is_bottom) {
+      return true;
+    } else {
+      // Inefficient, make sure this is not in a hot path
+      return this->normalize_copy()._is_bottom;
+    }
+  }
+
+  bool is_top() const override {
+    return !this->_is_bottom && this->_graph.empty();
+  }
+
+  void set_to_bottom() override {
+    this->_is_bottom = true;
+    this->_is_normalized = true;
+    this->_graph.clear();
+    this->_var_index_map.clear();
+  }
+
+  void set_to_top() override {
+    this->_is_bottom = false;
+    this->_is_normalized = true;
+    this->_graph.clear();
+    this->_var_index_map.clear();
+  }
+
+private:
+  /// \brief Return a normalized copy
+  SplitDBM normalize_copy() const {
+    SplitDBM tmp = *this;
+    tmp.normalize();
+    return tmp;
+  }
+
+  /// \brief Map the variables common to `this` and `other` to new vertices
+  ///
+  /// Create the vertices in `result`, and return the pairs of vertices of
+  /// `this` and `other` for each vertex of `result`. If `union_vars` is true,
+  /// also add the variables only in `this` or `other`, paired with None.
+  std::vector< std::pair< VertexIndex, VertexIndex > > merge_vertices(
+      const SplitDBM& other, SplitDBM& result, bool union_vars) const {
+    std::vector< std::pair< VertexIndex, VertexIndex > > vertices;
+    vertices.reserve(this->_var_index_map.size() + 1);
+    vertices.emplace_back(0, 0);
+
+    // Iterate over this->_var_index_map and other._var_index_map in parallel
+    // This is possible because var_index_map is sorted.
+    for (auto l = this->_var_index_map.begin(),
+              r = other._var_index_map.begin();
+         l != this->_var_index_map.end() || r != other._var_index_map.end();) {
+      if (l == this->_var_index_map.end() ||
+          (r != other._var_index_map.end() && r->first < l->first)) {
+        // Variable in `other` but not in `this`
+        if (union_vars) {
+          result._var_index_map.emplace_hint(result._var_index_map.end(),
+                                             r->first,
+                                             result._graph.add_vertex());
+          vertices.emplace_back(None, r->second);
+        }
+        ++r;
+      } else if (r == other._var_index_map.end() || l->first < r->first) {
+        // Variable in `this` but not in `other`
+        if (union_vars) {
+          result._var_index_map.emplace_hint(result._var_index_map.end(),
+                                             l->first,
+                                             result._graph.add_vertex());
+          vertices.emplace_back(l->second, None);
+        }
+        ++l;
+      } else {
+        result._var_index_map.emplace_hint(result._var_index_map.end(),
+                                           l->first,
+                                           result._graph.add_vertex());
+        vertices.emplace_back(l->second, r->second);
+        ++l;
+        ++r;
+      }
+    }
+
+    return vertices;
+  }
+
+  /// \brief Return the map from the vertices of `this` to the vertices of the
+  /// result, given the result of merge_vertices()
+  static std::vector< VertexIndex > left_map(
+      const SplitDBM& dbm,
+      const std::vector< std::pair< VertexIndex, VertexIndex > >& vertices) {
+    std::vector< VertexIndex > map(dbm._graph.num_vertices(), None);
+    for (VertexIndex v = 0; v < vertices.size(); v++) {
+      if (vertices[v].first != None) {
+        map[vertices[v].first] = v;
+      }
+    }
+    return map;
+  }
+
+  /// \brief Return the map from the vertices of `other` to the vertices of the
+  /// result, given the result of merge_vertices()
+  static std::vector< VertexIndex > right_map(
+      const SplitDBM& dbm,
+      const std::vector< std::pair< VertexIndex, VertexIndex > >& vertices) {
+    std::vector< VertexIndex > map(dbm._graph.num_vertices(), None);
+    for (VertexIndex v = 0; v < vertices.size(); v++) {
+      if (vertices[v].second != None) {
+        map[vertices[v].second] = v;
+      }
+    }
+    return map;
+  }
+
+  /// \brief Set the weight of the edge i -> j if it is finite
+  void set_edge(VertexIndex i, VertexIndex j, const BoundT& w) {
+    boost::optional< Number > n = w.number();
+    if (n && !this->is_implied(i, j, *n)) {
+      this->_graph.set_edge(i, j, *n);
+    }
+  }
+
+public:
+  bool leq(const SplitDBM& other) const override {
+    // Requires normalization
+    if (!this->_is_normalized) {
+      return this->normalize_copy().leq(other);
+    }
+    if (!other._is_normalized) {
+      return this->leq(other.normalize_copy());
+    }
+
+    ikos_assert(this->_is_normalized);
+    ikos_assert(other._is_normalized);
+
+    if (this->_is_bottom) {
+      return true;
+    } else if (other._is_bottom) {
+      return false;
+    }
+
+    // Map the vertices of `other` to the vertices of `this`
+    std::vector< VertexIndex > map(other._graph.num_vertices(), None);
+    map[0] = 0;
+    for (auto l = this->_var_index_map.begin(),
+              r = other._var_index_map.begin();
+         r != other._var_index_map.end();) {
+      if (l == this->_var_index_map.end() || r->first < l->first) {
+        // Variable in `other` but not in `this`
+        if (!other._graph.empty(r->second)) {
+          return false;
+        }
+        ++r;
+      } else if (l->first < r->first) {
+        // Variable in `this` but not in `other`, this is fine.
+        ++l;
+      } else {
+        map[r->second] = l->second;
+        ++l;
+        ++r;
+      }
+    }
+
+    // Check that all the constraints of `other` are implied by `this`
+    for (VertexIndex i = 0; i < other._graph.num_vertices(); i++) {
+      if (map[i] == None) {
+        continue;
+      }
+      for (const auto& succ : other._graph.succs(i)) {
+        if (!(this->value(map[i], map[succ.first]) <= BoundT(succ.second))) {
+          return false;
+        }
+      }
+    }
+
+    return true;
+  }
+
+  bool equals(const SplitDBM& other) const override {
+    return this->leq(other) && other.leq(*this);
+  }
+
+private:
+  /// \brief Join two normalized abstract values
+  ///
+  /// The result is normalized.
+  SplitDBM join_normalized(const SplitDBM& other) const {
+    ikos_assert(this->_is_normalized && !this->_is_bottom);
+    ikos_assert(other._is_normalized && !other._is_bottom);
+
+    SplitDBM result = SplitDBM::top();
+    auto vertices = this->merge_vertices(other, result, false);
+    auto l_map = left_map(*this, vertices);
+    auto r_map = right_map(other, vertices);
+    auto num_vertices = static_cast< VertexIndex >(vertices.size());
+
+    // Variable bounds
+    for (VertexIndex v = 1; v < num_vertices; v++) {
+      VertexIndex l = vertices[v].first;
+      VertexIndex r = vertices[v].second;
+      result.set_edge(0,
+                      v,
+                      max(this->_graph.weight(0, l), other._graph.weight(0, r)));
+      result.set_edge(v,
+                      0,
+                      max(this->_graph.weight(l, 0), other._graph.weight(r, 0)));
+    }
+
+    auto join_edge = [&](VertexIndex i, VertexIndex j) {
+      result.set_edge(i,
+                      j,
+                      max(this->value(vertices[i].first, vertices[j].first),
+                          other.value(vertices[i].second,
+                                      vertices[j].second)));
+    };
+
+    // Relations in `this` or `other`
+    for (VertexIndex l = 1; l < this->_graph.num_vertices(); l++) {
+      if (l_map[l] == None) {
+        continue;
+      }
+      for (const auto& succ : this->_graph.succs(l)) {
+        if (succ.first != 0 && l_map[succ.first] != None) {
+          join_edge(l_map[l], l_map[succ.first]);
+        }
+      }
+    }
+    for (VertexIndex r = 1; r < other._graph.num_vertices(); r++) {
+      if (r_map[r] == None) {
+        continue;
+      }
+      for (const auto& succ : other._graph.succs(r)) {
+        if (succ.first != 0 && r_map[succ.first] != None &&
+            result._graph.edge(r_map[r], r_map[succ.first]) == nullptr) {
+          join_edge(r_map[r], r_map[succ.first]);
+        }
+      }
+    }
+
+    // Relations implied by the bounds in both `this` and `other`, but not by
+    // the joined bounds. This happens when the lower bound of v_i comes from
+    // one side and the upper bound of v_j comes from the other side.
+    std::vector< VertexIndex > lb_left;
+    std::vector< VertexIndex > lb_right;
+    std::vector< VertexIndex > ub_left;
+    std::vector< VertexIndex > ub_right;
+    for (VertexIndex v = 1; v < num_vertices; v++) {
+      const Number* l_lb = this->_graph.edge(vertices[v].first, 0);
+      const Number* r_lb = other._graph.edge(vertices[v].second, 0);
+      if (l_lb != nullptr && r_lb != nullptr) {
+        if (*r_lb < *l_lb) {
+          lb_left.push_back(v);
+        } else if (*l_lb < *r_lb) {
+          lb_right.push_back(v);
+        }
+      }
+      const Number* l_ub = this->_graph.edge(0, vertices[v].first);
+      const Number* r_ub = other._graph.edge(0, vertices[v].second);
+      if (l_ub != nullptr && r_ub != nullptr) {
+        if (*r_ub < *l_ub) {
+          ub_left.push_back(v);
+        } else if (*l_ub < *r_ub) {
+          ub_right.push_back(v);
+        }
+      }
+    }
+    for (VertexIndex i : lb_left) {
+      for (VertexIndex j : ub_right) {
+        if (i != j && result._graph.edge(i, j) == nullptr) {
+          join_edge(i, j);
+        }
+      }
+    }
+    for (VertexIndex i : lb_right) {
+      for (VertexIndex j : ub_left) {
+        if (i != j && result._graph.edge(i, j) == nullptr) {
+          join_edge(i, j);
+        }
+      }
+    }
+
+    return result;
+  }
+
+  /// \brief Widen two abstract values
+  ///
+  /// Only the explicit edges of `this` are kept, and the result is not
+  /// normalized, to ensure termination.
+  template < typename WideningOperator >
+  SplitDBM widening_op(const SplitDBM& other,
+                       const WideningOperator& op) const {
+    ikos_assert(other._is_normalized);
+
+    SplitDBM result = SplitDBM::top();
+    auto vertices = this->merge_vertices(other, result, false);
+    auto l_map = left_map(*this, vertices);
+
+    for (VertexIndex l = 0; l < this->_graph.num_vertices(); l++) {
+      if (l_map[l] == None) {
+        continue;
+      }
+      VertexIndex i = l_map[l];
+      for (const auto& succ : this->_graph.succs(l)) {
+        VertexIndex j = l_map[succ.first];
+        if (j == None) {
+          continue;
+        }
+        boost::optional< Number > w =
+            op(BoundT(succ.second),
+               other.value(vertices[i].second, vertices[j].second))
+                .number();
+        if (w) {
+          result._graph.set_edge(i, j, *w);
+        }
+      }
+    }
+
+    result._is_normalized = false;
+    return result;
+  }
+
+  struct WideningOperator {
+    BoundT operator()(const BoundT& x, const BoundT& y) const {
+      if (y <= x) {
+        return x;
+      } else {
+        return BoundT::plus_infinity();
+      }
+    }
+  };
+
+  struct WideningThresholdOperator {
+    BoundT threshold;
+
+    explicit WideningThresholdOperator(const Number& threshold_)
+        : threshold(threshold_) {}
+
+    BoundT operator()(const BoundT& x, const BoundT& y) const {
+      if (y <= x) {
+        return x;
+      } else if (threshold >= y) {
+        return threshold;
+      } else {
+        return BoundT::plus_infinity();
+      }
+    }
+  };
+
+  /// \brief Narrow two normalized abstract values
+  ///
+  /// Unbounded constraints of `this` (or constraints equal to the threshold)
+  /// are replaced by the constraints of `other`. The result is not
+  /// normalized.
+  SplitDBM narrowing_op(const SplitDBM& other,
+                        const boost::optional< Number >& threshold) const {
+    ikos_assert(this->_is_normalized && !this->_is_bottom);
+    ikos_assert(other._is_normalized && !other._is_bottom);
+
+    SplitDBM result = SplitDBM::top();
+    auto vertices = this->merge_vertices(other, result, true);
+    auto l_map = left_map(*this, vertices);
+    auto r_map = right_map(other, vertices);
+
+    // Constraints of `this`
+    for (VertexIndex l = 0; l < this->_graph.num_vertices(); l++) {
+      if (l_map[l] == None) {
+        continue;
+      }
+      VertexIndex i = l_map[l];
+      for (const auto& succ : this->_graph.succs(l)) {
+        VertexIndex j = l_map[succ.first];
+        if (threshold && succ.second == *threshold &&
+            vertices[i].second != None && vertices[j].second != None) {
+          boost::optional< Number > w =
+              other.value(vertices[i].second, vertices[j].second).number();
+          if (w) {
+            result._graph.set_edge(i, j, *w);
+          }
+        } else {
+          result._graph.set_edge(i, j, succ.second);
+        }
+      }
+    }
+
+    // Constraints of `other` that are unbounded in `this`
+    for (VertexIndex r = 0; r < other._graph.num_vertices(); r++) {
+      if (r_map[r] == None) {
+        continue;
+      }
+      VertexIndex i = r_map[r];
+      for (const auto& succ : other._graph.succs(r)) {
+        VertexIndex j = r_map[succ.first];
+        if (vertices[i].first == None || vertices[j].first == None ||
+            this->value(vertices[i].first, vertices[j].first)
+                .is_plus_infinity()) {
+          result._graph.set_edge(i, j, succ.second);
+        }
+      }
+    }
+
+    result._is_normalized = false;
+    return result;
+  }
+
+public:
+  void join_with(const SplitDBM& other) override {
+    this->operator=(this->join(other));
+  }
+
+  SplitDBM join(const SplitDBM& other) const override {
+    // Requires normalization
+    if (!this->_is_normalized) {
+      return this->normalize_copy().join(other);
+    } else if (!other._is_normalized) {
+      return this->join(other.normalize_copy());
+    }
+
+    if (this->_is_bottom) {
+      return other;
+    } else if (other._is_bottom) {
+      return *this;
+    } else {
+      return this->join_normalized(other);
+    }
+  }
+
+  void widen_with(const SplitDBM& other) override {
+    this->operator=(this->widening(other));
+  }
+
+  SplitDBM widening(const SplitDBM& other) const override {
+    // Requires the normalization of the right hand side.
+    // The left hand side should not be normalized.
+    if (!other._is_normalized) {
+      return this->widening(other.normalize_copy());
+    }
+
+    if (this->_is_bottom) {
+      return other;
+    } else if (other._is_bottom) {
+      return *this;
+    } else {
+      return this->widening_op(other, WideningOperator{});
+    }
+  }
+
+  void widen_threshold_with(const SplitDBM& other,
+                            const Number& threshold) override {
+    this->operator=(this->widening_threshold(other, threshold));
+  }
+
+  SplitDBM widening_threshold(const SplitDBM& other,
+                              const Number& threshold) const override {
+    // Requires the normalization of the right hand side.
+    // The left hand side should not be normalized.
+    if (!other._is_normalized) {
+      return this->widening_threshold(other.normalize_copy(), threshold);
+    }
+
+    if (this->_is_bottom) {
+      return other;
+    } else if (other._is_bottom) {
+      return *this;
+    } else {
+      return this->widening_op(other, WideningThresholdOperator{threshold});
+    }
+  }
+
+  void meet_with(const SplitDBM& other) override {
+    this->operator=(this->meet(other));
+  }
+
+  SplitDBM meet(const SplitDBM& other) const override {
+    if (this->is_bottom() || other.is_bottom()) {
+      return bottom();
+    }
+
+    SplitDBM result = SplitDBM::top();
+    auto vertices = this->merge_vertices(other, result, true);
+    auto l_map = left_map(*this, vertices);
+    auto r_map = right_map(other, vertices);
+
+    for (VertexIndex l = 0; l < this->_graph.num_vertices(); l++) {
+      if (l_map[l] != None) {
+        for (const auto& succ : this->_graph.succs(l)) {
+          result._graph.update_edge(l_map[l], l_map[succ.first], succ.second);
+        }
+      }
+    }
+    for (VertexIndex r = 0; r < other._graph.num_vertices(); r++) {
+      if (r_map[r] != None) {
+        for (const auto& succ : other._graph.succs(r)) {
+          result._graph.update_edge(r_map[r], r_map[succ.first], succ.second);
+        }
+      }
+    }
+
+    result._is_normalized = false;
+    return result;
+  }
+
+  void narrow_with(const SplitDBM& other) override {
+    this->operator=(this->narrowing(other));
+  }
+
+  SplitDBM narrowing(const SplitDBM& other) const override {
+    // Requires normalization
+    if (!this->_is_normalized) {
+      return this->normalize_copy().narrowing(other);
+    } else if (!other._is_normalized) {
+      return this->narrowing(other.normalize_copy());
+    }
+
+    if (this->_is_bottom || other._is_bottom) {
+      return bottom();
+    } else {
+      return this->narrowing_op(other, boost::none);
+    }
+  }
+
+  void narrow_threshold_with(const SplitDBM& other,
+                             const Number& threshold) override {
+    this->operator=(this->narrowing_threshold(other, threshold));
+  }
+
+  SplitDBM narrowing_threshold(const SplitDBM& other,
+                               const Number& threshold) const override {
+    // Requires normalization
+    if (!this->_is_normalized) {
+      return this->normalize_copy().narrowing_threshold(other, threshold);
+    } else if (!other._is_normalized) {
+      return this->narrowing_threshold(other.normalize_copy(), threshold);
+    }
+
+    if (this->_is_bottom || other._is_bottom) {
+      return bottom();
+    } else {
+      return this->narrowing_op(other, threshold);
+    }
+  }
+
+private:
+  /// \brief Get the vertex of variable x
+  ///
+  /// Create a new one if not found
+  VertexIndex var_index(VariableRef x) {
+    auto it = this->_var_index_map.find(x);
+    if (it != this->_var_index_map.end()) {
+      return it->second;
+    }
+
+    VertexIndex v = this->_graph.add_vertex();
+    this->_var_index_map.emplace(x, v);
+    return v;
+  }
+
+  /// \brief Add constraint v_i - v_j <= c
+  ///
+  /// Precondition: the graph is closed
+  void add_constraint(VertexIndex i, VertexIndex j, const Number& c) {
+    if (this->_is_bottom) {
+      return;
+    }
+    this->close_over_edge(j, i, c);
+  }
+
+  /// \brief Add constraint v_i - v_j <= c
+  ///
+  /// Precondition: the graph is closed
+  void add_constraint(VertexIndex i, VertexIndex j, const BoundT& c) {
+    boost::optional< Number > n = c.number();
+    if (n) {
+      this->add_constraint(i, j, *n);
+    }
+  }
+
+  /// \brief Apply v_i = v_j + c
+  ///
+  /// Precondition: the graph is closed. The result is closed.
+  void assign_shift(VertexIndex i, VertexIndex j, const Number& c) {
+    ikos_assert(this->_is_normalized && !this->_is_bottom);
+
+    if (i == j) {
+      this->_graph.shift(i, c);
+      return;
+    }
+
+    this->_graph.clear_vertex(i);
+
+    // v_i has the same constraints as v_j, shifted by c
+    std::vector< Edge > edges;
+    for (const auto& succ : this->_graph.succs(j)) {
+      edges.push_back(Edge{i, succ.first, succ.second - c});
+    }
+    for (VertexIndex pred : this->_graph.preds(j)) {
+      edges.push_back(Edge{pred, i, *this->_graph.edge(pred, j) + c});
+    }
+    for (const Edge& e : edges) {
+      this->_graph.set_edge(e.src, e.dest, e.weight);
+    }
+    this->_graph.set_edge(j, i, c);
+    this->_graph.set_edge(i, j, -c);
+  }
+
+  /// \brief Apply v_i = c
+  ///
+  /// Precondition: the graph is closed. The result is closed.
+  void assign_constant(VertexIndex i, const Number& c) {
+    this->_graph.clear_vertex(i);
+    this->_graph.set_edge(0, i, c);
+    this->_graph.set_edge(i, 0, -c);
+  }
+
+public:
+  void assign(VariableRef x, int n) override { this->assign(x, Number(n)); }
+
+  void assign(VariableRef x, const Number& n) override {
+    this->normalize();
+
+    if (this->_is_bottom) {
+      return;
+    }
+
+    this->assign_constant(this->var_index(x), n);
+  }
+
+  void assign(VariableRef x, VariableRef y) override {
+    this->normalize();
+
+    if (this->_is_bottom) {
+      return;
+    }
+
+    if (x == y) {
+      return;
+    }
+
+    this->assign_shift(this->var_index(x), this->var_index(y), Number(0));
+  }
+
+  void assign(VariableRef x, const LinearExpressionT& e) override {
+    this->normalize();
+
+    if (this->_is_bottom) {
+      return;
+    }
+
+    if (e.is_constant()) { // x = c
+      this->assign_constant(this->var_index(x), e.constant());
+      return;
+    }
+
+    if (e.num_terms() == 1 && e.begin()->second == 1) { // x = y + c
+      this->assign_shift(this->var_index(x),
+                         this->var_index(e.begin()->first),
+                         e.constant());
+      return;
+    }
+
+    // Projection using intervals
+    this->set(x, this->to_interval(e));
+  }
+
+  void apply(BinaryOperator op,
+             VariableRef x,
+             VariableRef y,
+             VariableRef z) override {
+    this->normalize();
+
+    if (this->_is_bottom) {
+      return;
+    }
+
+    IntervalT v_y = this->to_interval(y);
+    IntervalT v_z = this->to_interval(z);
+
+    if (v_z.singleton()) {
+      this->apply(op, x, y, *v_z.singleton());
+    } else if (v_y.singleton()) {
+      this->apply(op, x, *v_y.singleton(), z);
+    } else {
+      this->set(x, apply_bin_operator(op, v_y, v_z));
+    }
+  }
+
+  void apply(BinaryOperator op,
+             VariableRef x,
+             VariableRef y,
+             const Number& z) override {
+    this->normalize();
+
+    if (this->_is_bottom) {
+      return;
+    }
+
+    switch (op) {
+      case BinaryOperator::Add: {
+        this->assign_shift(this->var_index(x), this->var_index(y), z);
+      } break;
+      case BinaryOperator::Sub: {
+        this->assign_shift(this->var_index(x), this->var_index(y), -z);
+      } break;
+      case BinaryOperator::Mul: {
+        if (z == 1) { // x = y
+          this->assign(x, y);
+        } else {
+          this->set(x, this->to_interval(y) * IntervalT(z));
+        }
+      } break;
+      case BinaryOperator::Div: {
+        if (z == 1) { // x = y
+          this->assign(x, y);
+        } else {
+          this->set(x, this->to_interval(y) / IntervalT(z));
+        }
+      } break;
+      case BinaryOperator::Mod: {
+        if (z == 0) {
+          this->set_to_bottom();
+          return;
+        }
+
+        IntervalT v_y = this->to_interval(y);
+        boost::optional< Number > n = v_y.mod_to_sub(z);
+
+        if (n) {
+          // Equivalent to x = y - n
+          this->assign_shift(this->var_index(x), this->var_index(y), -(*n));
+        } else {
+          this->set(x, IntervalT(BoundT(0), BoundT(abs(z) - 1)));
+
+          if (x == y) {
+            return;
+          }
+
+          // If y < abs(z) then x >= y
+          if (v_y.ub() < BoundT(abs(z))) {
+            this->add_constraint(this->var_index(y),
+                                 this->var_index(x),
+                                 Number(0));
+          }
+
+          // If y >= -abs(z) then x <= y + abs(z)
+          if (v_y.lb() >= BoundT(-abs(z))) {
+            this->add_constraint(this->var_index(x),
+                                 this->var_index(y),
+                                 abs(z));
+          }
+        }
+      } break;
+      case BinaryOperator::Rem:
+      case BinaryOperator::Shl:
+      case BinaryOperator::Shr:
+      case BinaryOperator::And:
+      case BinaryOperator::Or:
+      case BinaryOperator::Xor: {
+        this->set(x,
+                  apply_bin_operator(op, this->to_interval(y), IntervalT(z)));
+      } break;
+    }
+  }
+
+  void apply(BinaryOperator op,
+             VariableRef x,
+             const Number& y,
+             VariableRef z) override {
+    this->normalize();
+
+    if (this->_is_bottom) {
+      return;
+    }
+
+    switch (op) {
+      case BinaryOperator::Add: {
+        this->assign_shift(this->var_index(x), this->var_index(z), y);
+      } break;
+      case BinaryOperator::Mul: {
+        if (y == 1) { // x = z
+          this->assign(x, z);
+        } else {
+          this->set(x, IntervalT(y) * this->to_interval(z));
+        }
+      } break;
+      case BinaryOperator::Sub:
+      case BinaryOperator::Div:
+      case BinaryOperator::Rem:
+      case BinaryOperator::Mod:
+      case BinaryOperator::Shl:
+      case BinaryOperator::Shr:
+      case BinaryOperator::And:
+      case BinaryOperator::Or:
+      case BinaryOperator::Xor: {
+        this->set(x,
+                  apply_bin_operator(op, IntervalT(y), this->to_interval(z)));
+      } break;
+    }
+  }
+
+private:
+  /// \brief Add a constraint of the form `x <= c`, `-x <= c`, `x - y <= c`
+  /// or the equality variants
+  ///
+  /// \returns false if the constraint has another form
+  bool add_difference_constraint(const LinearConstraintT& cst) {
+    if (!cst.is_inequality() && !cst.is_equality()) {
+      return false;
+    }
+
+    auto it = cst.begin();
+    auto it2 = ++cst.begin();
+    VertexIndex i;
+    VertexIndex j;
+    const Number& c = cst.constant();
+
+    if (cst.num_terms() == 1 && it->second == 1) {
+      i = this->var_index(it->first);
+      j = 0;
+    } else if (cst.num_terms() == 1 && it->second == -1) {
+      i = 0;
+      j = this->var_index(it->first);
+    } else if (cst.num_terms() == 2 && it->second == 1 && it2->second == -1) {
+      i = this->var_index(it->first);
+      j = this->var_index(it2->first);
+    } else if (cst.num_terms() == 2 && it->second == -1 && it2->second == 1) {
+      i = this->var_index(it2->first);
+      j = this->var_index(it->first);
+    } else {
+      return false;
+    }
+
+    this->add_constraint(i, j, c);
+    if (cst.is_equality()) {
+      this->add_constraint(j, i, -c);
+    }
+    return true;
+  }
+
+public:
+  void add(const LinearConstraintT& cst) override {
+    this->normalize();
+
+    if (this->_is_bottom) {
+      return;
+    }
+
+    if (cst.num_terms() == 0) {
+      if (cst.is_contradiction()) {
+        this->set_to_bottom();
+      }
+      return;
+    }
+
+    if (!this->add_difference_constraint(cst)) {
+      // Use the linear interval solver
+      LinearIntervalSolverT solver(MaxReductionCycles);
+      solver.add(cst);
+      solver.run(*this);
+    }
+  }
+
+  void add(const LinearConstraintSystemT& csts) override {
+    this->normalize();
+
+    if (this->_is_bottom) {
+      return;
+    }
+
+    LinearIntervalSolverT solver(MaxReductionCycles);
+
+    for (const LinearConstraintT& cst : csts) {
+      if (cst.num_terms() == 0) {
+        if (cst.is_contradiction()) {
+          this->set_to_bottom();
+          return;
+        }
+      } else if (!this->add_difference_constraint(cst)) {
+        solver.add(cst);
+      }
+
+      if (this->_is_bottom) {
+        return;
+      }
+    }
+
+    if (!solver.empty()) {
+      // Use the linear interval solver
+      solver.run(*this);
+    }
+  }
+
+  void set(VariableRef x, const IntervalT& value) override {
+    this->normalize();
+
+    if (this->_is_bottom) {
+      return;
+    } else if (value.is_bottom()) {
+      this->set_to_bottom();
+    } else {
+      VertexIndex i = this->var_index(x);
+      this->_graph.clear_vertex(i);
+      boost::optional< Number > ub = value.ub().number();
+      if (ub) {
+        this->_graph.set_edge(0, i, *ub);
+      }
+      boost::optional< Number > lb = value.lb().number();
+      if (lb) {
+        this->_graph.set_edge(i, 0, -*lb);
+      }
+    }
+  }
+
+  void set(VariableRef x, const CongruenceT& value) override {
+    this->normalize();
+
+    if (this->_is_bottom) {
+      return;
+    } else if (value.is_bottom()) {
+      this->set_to_bottom();
+    } else {
+      boost::optional< Number > n = value.singleton();
+      if (n) {
+        this->assign_constant(this->var_index(x), *n);
+      } else {
+        this->forget(x);
+      }
+    }
+  }
+
+  void set(VariableRef x, const IntervalCongruenceT& value) override {
+    this->set(x, value.interval());
+  }
+
+  void refine(VariableRef x, const IntervalT& value) override {
+    this->normalize();
+
+    if (this->_is_bottom) {
+      return;
+    } else if (value.is_bottom()) {
+      this->set_to_bottom();
+    } else {
+      VertexIndex i = this->var_index(x);
+      this->add_constraint(i, 0, value.ub());
+      this->add_constraint(0, i, -value.lb());
+    }
+  }
+
+  void refine(VariableRef x, const CongruenceT& value) override {
+    if (this->is_bottom()) {
+      return;
+    } else if (value.is_bottom()) {
+      this->set_to_bottom();
+    } else {
+      IntervalCongruenceT iv(this->to_interval(x), value);
+      this->refine(x, iv.interval());
+    }
+  }
+
+  void refine(VariableRef x, const IntervalCongruenceT& value) override {
+    if (this->is_bottom()) {
+      return;
+    } else if (value.is_bottom()) {
+      this->set_to_bottom();
+    } else {
+      IntervalCongruenceT iv(this->to_interval(x));
+      iv.meet_with(value);
+      this->refine(x, iv.interval());
+    }
+  }
+
+  void forget(VariableRef x) override {
+    // The graph needs to be closed, to keep the constraints implied by x
+    this->normalize();
+
+    if (this->_is_bottom) {
+      return;
+    }
+
+    auto it = this->_var_index_map.find(x);
+    if (it != this->_var_index_map.end()) {
+      this->_graph.remove_vertex(it->second);
+      this->_var_index_map.erase(it);
+    }
+  }
+
+private:
+  struct GetVar {
+    const VariableRef& operator()(
+        const std::pair< VariableRef, VertexIndex >& p) const {
+      return p.first;
+    }
+  };
+
+public:
+  /// \brief Iterator over a list of variables
+  using VariableIterator =
+      boost::transform_iterator< GetVar, typename VarIndexMap::const_iterator >;
+
+  /// \brief Begin iterator over the list of variables
+  VariableIterator var_begin() const {
+    return boost::make_transform_iterator(this->_var_index_map.cbegin(),
+                                          GetVar());
+  }
+
+  /// \brief End iterator over the list of variables
+  VariableIterator var_end() const {
+    return boost::make_transform_iterator(this->_var_index_map.cend(),
+                                          GetVar());
+  }
+
+  IntervalT to_interval(VariableRef x) const override {
+    if (this->_is_bottom) {
+      return IntervalT::bottom();
+    } else {
+      auto it = this->_var_index_map.find(x);
+
+      if (it == this->_var_index_map.cend()) {
+        return IntervalT::top();
+      } else {
+        return IntervalT(-this->_graph.weight(it->second, 0),
+                         this->_graph.weight(0, it->second));
+      }
+    }
+  }
+
+  IntervalT to_interval(const LinearExpressionT& e) const override {
+    return Parent::to_interval(e);
+  }
+
+  CongruenceT to_congruence(VariableRef x) const override {
+    if (this->_is_bottom) {
+      return CongruenceT::bottom();
+    } else {
+      boost::optional< Number > n = this->to_interval(x).singleton();
+      if (n) {
+        return CongruenceT(*n);
+      } else {
+        return CongruenceT::top();
+      }
+    }
+  }
+
+  CongruenceT to_congruence(const LinearExpressionT& e) const override {
+    return Parent::to_congruence(e);
+  }
+
+  IntervalCongruenceT to_interval_congruence(VariableRef x) const override {
+    return IntervalCongruenceT(this->to_interval(x));
+  }
+
+  IntervalCongruenceT to_interval_congruence(
+      const LinearExpressionT& e) const override {
+    return Parent::to_interval_congruence(e);
+  }
+
+  LinearConstraintSystemT to_linear_constraint_system() const override {
+    if (this->_is_bottom) {
+      return LinearConstraintSystemT(LinearConstraintT::contradiction());
+    }
+
+    std::vector< const VariableRef* > vars(this->_graph.num_vertices(),
+                                           nullptr);
+    for (const auto& p : this->_var_index_map) {
+      vars[p.second] = &p.first;
+    }
+
+    LinearConstraintSystemT csts;
+    for (const auto& p : this->_var_index_map) {
+      csts.add(within_interval(p.first,
+                               IntervalT(-this->_graph.weight(p.second, 0),
+                                         this->_graph.weight(0, p.second))));
+    }
+    for (const auto& p : this->_var_index_map) {
+      for (const auto& succ : this->_graph.succs(p.second)) {
+        if (succ.first != 0) {
+          csts.add(VariableExprT(*vars[succ.first]) - VariableExprT(p.first) <=
+                   succ.second);
+        }
+      }
+    }
+
+    return csts;
+  }
+
+  void dump(std::ostream& o) const override {
+    this->to_linear_constraint_system().dump(o);
+  }
+
+  static std::string name() { return "split dbm"; }
+
+}; // end class SplitDBM
+
+template < typename Number,
+           typename VariableRef,
+           std::size_t MaxReductionCycles >
+constexpr
+    typename SplitDBM< Number, VariableRef, MaxReductionCycles >::VertexIndex
+        SplitDBM< Number, VariableRef, MaxReductionCycles >::None;
+
+} // end namespace numeric
+} // end namespace core
+} // end namespace ikos
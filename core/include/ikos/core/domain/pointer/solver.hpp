@@ -55,15 +55,23 @@
 
 #pragma once
 
+#include <algorithm>
+#include <deque>
 #include <iosfwd>
 #include <memory>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
+#include <boost/container/flat_set.hpp>
+
+#include <tbb/parallel_for_each.h>
+
 #include <ikos/core/semantic/dumpable.hpp>
 #include <ikos/core/semantic/indexable.hpp>
 #include <ikos/core/semantic/memory_location.hpp>
 #include <ikos/core/semantic/variable.hpp>
+#include <ikos/core/support/assert.hpp>
 #include <ikos/core/value/machine_int/interval.hpp>
 #include <ikos/core/value/pointer/pointer.hpp>
 
@@ -439,12 +447,6 @@ private:
   // Signedness of pointer offsets (usually Unsigned)
   Signedness _offsets_sign;
 
-  // Number of iterations
-  std::size_t _iteration = 0;
-
-  // Change seen during iteration
-  bool _change_seen = false;
-
 public:
   /// \brief Default constructor
   ConstraintSystem(uint64_t offsets_bit_width, Signedness offsets_sign)
@@ -471,154 +473,572 @@ public:
   }
 
 private:
-  class BinaryOp {
+  /// \brief Worklist solver for the constraint system
+  ///
+  /// Pointer variables and memory locations are mapped to dense node
+  /// identifiers. Each constraint is processed again only when one of the
+  /// values it reads has changed, and stores and loads only process the
+  /// addresses they have not seen yet (difference propagation), unless their
+  /// operand has changed.
+  ///
+  /// Cycles of copy constraints `p = q + 0` are detected lazily and collapsed
+  /// into a single node, since all pointers in such a cycle have the same
+  /// abstract value.
+  ///
+  /// Constraints are split into independent partitions: constraints that do
+  /// not share any pointer variable or memory location cannot influence each
+  /// other, because addresses only flow along constraints. Partitions can be
+  /// solved in parallel.
+  class Solver {
+  private:
+    /// \brief Constraint reading a pointer variable
+    struct Use {
+      // Index of the constraint
+      std::size_t cst;
+
+      // True if all the addresses of the constraint should be processed again
+      bool full;
+    };
+
+    /// \brief Node for a pointer variable
+    struct PointerNode {
+      // Pointer variable
+      VariableRef var;
+
+      // Representative of the node, after cycle collapsing
+      std::size_t rep;
+
+      // True if the pointer was assigned by a constraint
+      bool defined;
+
+      // Number of updates of the abstract value, used for widening
+      std::size_t updates;
+
+      // Abstract value (only meaningful for representatives)
+      PointerAbsValueT value;
+
+      // Constraints reading the pointer (only meaningful for representatives)
+      std::vector< Use > uses;
+    };
+
+    /// \brief Node for a memory location
+    struct MemoryNode {
+      // Memory location
+      MemoryLocationRef loc;
+
+      // True if a pointer was stored at the memory location
+      bool defined;
+
+      // Number of updates of the abstract value, used for widening
+      std::size_t updates;
+
+      // Abstract value
+      PointerAbsValueT value;
+
+      // Load constraints reading the memory location
+      std::vector< std::size_t > loads;
+    };
+
+    /// \brief Pre-processed constraint
+    struct Entry {
+      // Constraint
+      const ConstraintT* cst;
+
+      // Operand of the constraint
+      const OperandT* operand;
+
+      // Result (assign, load) or pointer (store) variable node
+      std::size_t lhs;
+
+      // Operand variable node or memory location node
+      std::size_t rhs;
+
+      // True if the constraint is a copy `p = q + 0`
+      bool copy;
+
+      // True if the constraint is in the worklist
+      bool queued;
+
+      // True if all the addresses should be processed again
+      bool full;
+
+      // True if the lazy cycle detection already ran for this copy
+      bool cycle_checked;
+
+      // Memory locations already processed by a store or load
+      boost::container::flat_set< std::size_t > seen;
+
+      // Memory locations updated since the last run of a load
+      std::vector< std::size_t > dirty;
+    };
+
+    using Partition = std::vector< std::size_t >;
+
+  private:
+    // Constraint system
+    ConstraintSystem& _system;
+
+    // Widening threshold
+    std::size_t _widening_threshold;
+
+    // Pointer variable nodes
+    std::vector< PointerNode > _pointers;
+
+    // Memory location nodes
+    std::vector< MemoryNode > _memory;
+
+    // Pre-processed constraints
+    std::vector< Entry > _entries;
+
+    // Map from pointer variables to node identifiers
+    std::unordered_map< VariableRef, std::size_t, VariableHash > _pointer_ids;
+
+    // Map from memory locations to node identifiers
+    std::unordered_map< MemoryLocationRef, std::size_t, MemoryLocationHash >
+        _memory_ids;
+
   public:
     /// \brief Constructor
-    BinaryOp() = default;
+    Solver(ConstraintSystem& system, std::size_t widening_threshold)
+        : _system(system), _widening_threshold(widening_threshold) {
+      this->_entries.reserve(system._csts.size());
+      for (std::size_t i = 0; i < system._csts.size(); i++) {
+        this->add_entry(system._csts[i].get(), i);
+      }
+    }
 
     /// \brief No copy constructor
-    BinaryOp(const BinaryOp&) = delete;
+    Solver(const Solver&) = delete;
 
     /// \brief No move constructor
-    BinaryOp(BinaryOp&&) = delete;
+    Solver(Solver&&) = delete;
 
     /// \brief No copy assignment operator
-    BinaryOp& operator=(const BinaryOp&) = delete;
+    Solver& operator=(const Solver&) = delete;
 
     /// \brief No move assignment operator
-    BinaryOp& operator=(BinaryOp&&) = delete;
+    Solver& operator=(Solver&&) = delete;
 
     /// \brief Destructor
-    virtual ~BinaryOp() = default;
+    ~Solver() = default;
 
-    virtual bool convergence_achieved(const PointerAbsValueT& before,
-                                      const PointerAbsValueT& after) const = 0;
+  private:
+    /// \brief Return the node identifier of the given pointer variable
+    std::size_t pointer_id(VariableRef v) {
+      auto res = this->_pointer_ids.emplace(v, this->_pointers.size());
+      if (res.second) {
+        std::size_t id = this->_pointers.size();
+        this->_pointers.push_back(
+            PointerNode{v, id, false, 0, this->bottom(), {}});
+      }
+      return res.first->second;
+    }
 
-    virtual void apply(PointerAbsValueT& before,
-                       const PointerAbsValueT& after,
-                       std::size_t iteration) const = 0;
-  };
+    /// \brief Return the node identifier of the given memory location
+    std::size_t memory_id(MemoryLocationRef m) {
+      auto res = this->_memory_ids.emplace(m, this->_memory.size());
+      if (res.second) {
+        this->_memory.push_back(MemoryNode{m, false, 0, this->bottom(), {}});
+      }
+      return res.first->second;
+    }
 
-  class Extrapolate final : public BinaryOp {
-  private:
-    std::size_t _threshold;
+    /// \brief Return the node identifier of an address found in a points-to
+    /// set
+    ///
+    /// This does not modify the solver, thus it is safe to call it in parallel.
+    std::size_t address_id(MemoryLocationRef m) const {
+      auto it = this->_memory_ids.find(m);
+      ikos_assert_msg(it != this->_memory_ids.end(),
+                      "unexpected memory location");
+      return it->second;
+    }
 
-  public:
-    explicit Extrapolate(std::size_t threshold) : _threshold(threshold) {}
+    /// \brief Return the bottom pointer abstract value
+    PointerAbsValueT bottom() const {
+      return PointerAbsValueT::bottom(this->_system._offsets_bit_width,
+                                      this->_system._offsets_sign);
+    }
 
-    bool convergence_achieved(const PointerAbsValueT& before,
-                              const PointerAbsValueT& after) const override {
-      return after.leq(before);
+    /// \brief Pre-process the given constraint
+    void add_entry(const ConstraintT* cst, std::size_t index) {
+      Entry entry{cst, nullptr, 0, 0, false, false, true, false, {}, {}};
+      std::size_t pointer = 0;
+      switch (cst->kind()) {
+        case ConstraintT::AssignKind: {
+          auto assign = static_cast< const AssignConstraintT* >(cst);
+          entry.operand = assign->operand();
+          entry.lhs = this->pointer_id(assign->result());
+        } break;
+        case ConstraintT::StoreKind: {
+          auto store = static_cast< const StoreConstraintT* >(cst);
+          entry.operand = store->operand();
+          entry.lhs = this->pointer_id(store->pointer());
+          pointer = entry.lhs;
+        } break;
+        case ConstraintT::LoadKind: {
+          auto load = static_cast< const LoadConstraintT* >(cst);
+          entry.operand = load->operand();
+          entry.lhs = this->pointer_id(load->result());
+        } break;
+        default: {
+          ikos_unreachable("unexpected kind");
+        }
+      }
+      switch (entry.operand->kind()) {
+        case OperandT::VariableKind: {
+          auto variable_op =
+              static_cast< const VariableOperandT* >(entry.operand);
+          entry.rhs = this->pointer_id(variable_op->var());
+          entry.copy = cst->kind() == ConstraintT::AssignKind &&
+                       variable_op->offset().is_zero();
+          // A store needs to update all its addresses when the operand
+          // changes, other constraints only read new addresses
+          this->_pointers[entry.rhs].uses.push_back(
+              Use{index, cst->kind() == ConstraintT::StoreKind});
+        } break;
+        case OperandT::AddressKind: {
+          auto address_op =
+              static_cast< const AddressOperandT* >(entry.operand);
+          entry.rhs = this->memory_id(address_op->address());
+        } break;
+        default: {
+          ikos_unreachable("unexpected kind");
+        }
+      }
+      if (cst->kind() == ConstraintT::StoreKind) {
+        this->_pointers[pointer].uses.push_back(Use{index, false});
+      }
+      this->_entries.push_back(std::move(entry));
     }
 
-    void apply(PointerAbsValueT& before,
-               const PointerAbsValueT& after,
-               std::size_t iteration) const override {
-      if (iteration < this->_threshold) {
-        before.join_with(after);
-      } else {
-        before.widen_with(after);
+    /// \brief Return the representative of the given pointer node
+    std::size_t find(std::size_t n) {
+      while (this->_pointers[n].rep != n) {
+        std::size_t parent = this->_pointers[n].rep;
+        this->_pointers[n].rep = this->_pointers[parent].rep;
+        n = parent;
       }
+      return n;
     }
-  };
 
-  class Refine final : public BinaryOp {
   public:
-    // This refinement is not a narrowing since it will not ensure
-    // convergence. Thus, we need to make sure it is called a finite
-    // number of times.
+    /// \brief Compute the independent partitions of constraints
+    std::vector< Partition > partitions() const {
+      // Union-find on pointer nodes [0, n) and memory nodes [n, n + m)
+      std::size_t n = this->_pointers.size();
+      std::vector< std::size_t > parent(n + this->_memory.size());
+      for (std::size_t i = 0; i < parent.size(); i++) {
+        parent[i] = i;
+      }
+      auto find = [&parent](std::size_t x) {
+        while (parent[x] != x) {
+          parent[x] = parent[parent[x]];
+          x = parent[x];
+        }
+        return x;
+      };
+
+      for (const Entry& entry : this->_entries) {
+        std::size_t rhs = (entry.operand->kind() == OperandT::VariableKind)
+                              ? entry.rhs
+                              : n + entry.rhs;
+        parent[find(entry.lhs)] = find(rhs);
+      }
 
-  public:
-    Refine() = default;
+      std::unordered_map< std::size_t, std::size_t > index;
+      std::vector< Partition > result;
+      for (std::size_t i = 0; i < this->_entries.size(); i++) {
+        auto res = index.emplace(find(this->_entries[i].lhs), result.size());
+        if (res.second) {
+          result.emplace_back();
+        }
+        result[res.first->second].push_back(i);
+      }
+      return result;
+    }
 
-    bool convergence_achieved(
-        const PointerAbsValueT& /*before*/,
-        const PointerAbsValueT& /*after*/) const override {
-      return false;
+    /// \brief Solve the given partition of constraints
+    void solve(const Partition& partition) {
+      std::deque< std::size_t > worklist;
+      for (std::size_t i : partition) {
+        this->_entries[i].queued = true;
+        worklist.push_back(i);
+      }
+
+      while (!worklist.empty()) {
+        std::size_t i = worklist.front();
+        worklist.pop_front();
+        this->_entries[i].queued = false;
+        this->process(i, worklist);
+      }
     }
 
-    void apply(PointerAbsValueT& before,
-               const PointerAbsValueT& after,
-               std::size_t /*iteration*/) const override {
-      if (after.leq(before)) {
-        // descending chain
-        before.narrow_with(after);
-      } else {
-        // no descending chain
-        before.join_with(after);
+    /// \brief Write the results in the constraint system
+    void export_results() {
+      this->_system._pointers.clear();
+      for (std::size_t i = 0; i < this->_pointers.size(); i++) {
+        if (this->_pointers[i].defined) {
+          this->_system._pointers.emplace(this->_pointers[i].var,
+                                          this->_pointers[this->find(i)].value);
+        }
+      }
+
+      this->_system._memory.clear();
+      for (const MemoryNode& node : this->_memory) {
+        if (node.defined) {
+          this->_system._memory.emplace(node.loc, node.value);
+        }
       }
     }
-  };
 
-  /// \brief Perform a step of the fixpoint convergence using the given operator
-  ///
-  /// It processes all the constraints once.
-  void step(const BinaryOp& op) {
-    for (auto it = this->_csts.begin(), et = this->_csts.end(); it != et;
-         ++it) {
-      this->process_constraint(it->get(), op);
+  private:
+    /// \brief Add the given constraint in the worklist
+    void push(std::size_t i, bool full, std::deque< std::size_t >& worklist) {
+      Entry& entry = this->_entries[i];
+      entry.full = entry.full || full;
+      if (!entry.queued) {
+        entry.queued = true;
+        worklist.push_back(i);
+      }
     }
-  }
 
-  /// \brief Process the given constraint
-  ///
-  /// It updates this->_pointers and this->_memory
-  void process_constraint(const ConstraintT* cst, const BinaryOp& op) {
-    switch (cst->kind()) {
-      case ConstraintT::AssignKind: {
-        auto assign = static_cast< const AssignConstraintT* >(cst);
-        PointerAbsValueT op_value = this->process_operand(assign->operand());
-        this->add_pointer(assign->result(), op_value, op);
-      } break;
-      case ConstraintT::StoreKind: {
-        auto store = static_cast< const StoreConstraintT* >(cst);
-        PointerAbsValueT ptr_value = this->get_pointer(store->pointer());
-        PointerAbsValueT op_value = this->process_operand(store->operand());
-        if (ptr_value.is_bottom()) {
-          return;
+    /// \brief Process the given constraint
+    void process(std::size_t i, std::deque< std::size_t >& worklist) {
+      Entry& entry = this->_entries[i];
+      bool full = entry.full;
+      entry.full = false;
+
+      switch (entry.cst->kind()) {
+        case ConstraintT::AssignKind: {
+          this->update_pointer(entry.lhs, this->operand_value(entry), worklist);
+
+          if (entry.copy && !entry.cycle_checked) {
+            std::size_t p = this->find(entry.lhs);
+            std::size_t q = this->find(entry.rhs);
+            if (p != q &&
+                this->_pointers[p].value == this->_pointers[q].value) {
+              entry.cycle_checked = true;
+              this->collapse_cycles(p, worklist);
+            }
+          }
+        } break;
+        case ConstraintT::StoreKind: {
+          const PointerAbsValueT& ptr_value =
+              this->_pointers[this->find(entry.lhs)].value;
+          PointerAbsValueT op_value = this->operand_value(entry);
+          if (ptr_value.is_bottom()) {
+            return;
+          }
+          for (MemoryLocationRef addr : ptr_value.points_to()) {
+            std::size_t m = this->address_id(addr);
+            if (entry.seen.insert(m).second || full) {
+              this->update_memory(m, op_value, worklist);
+            }
+          }
+        } break;
+        case ConstraintT::LoadKind: {
+          PointerAbsValueT op_value = this->operand_value(entry);
+          if (op_value.is_bottom()) {
+            return;
+          }
+          if (full) {
+            entry.dirty.assign(entry.seen.begin(), entry.seen.end());
+          }
+          for (MemoryLocationRef addr : op_value.points_to()) {
+            std::size_t m = this->address_id(addr);
+            if (entry.seen.insert(m).second) {
+              this->_memory[m].loads.push_back(i);
+              entry.dirty.push_back(m);
+            }
+          }
+          std::vector< std::size_t > dirty;
+          dirty.swap(entry.dirty);
+          std::sort(dirty.begin(), dirty.end());
+          dirty.erase(std::unique(dirty.begin(), dirty.end()), dirty.end());
+          for (std::size_t m : dirty) {
+            this->update_pointer(entry.lhs, this->_memory[m].value, worklist);
+          }
+        } break;
+        default: {
+          ikos_unreachable("unexpected kind");
         }
-        for (MemoryLocationRef addr : ptr_value.points_to()) {
-          this->add_memory(addr, op_value, op);
+      }
+    }
+
+    /// \brief Return the abstract value of the operand of the given constraint
+    PointerAbsValueT operand_value(const Entry& entry) {
+      switch (entry.operand->kind()) {
+        case OperandT::VariableKind: {
+          auto variable_op =
+              static_cast< const VariableOperandT* >(entry.operand);
+          PointerAbsValueT value = this->_pointers[this->find(entry.rhs)].value;
+          value.add_offset(variable_op->offset());
+          return value;
         }
-      } break;
-      case ConstraintT::LoadKind: {
-        auto load = static_cast< const LoadConstraintT* >(cst);
-        PointerAbsValueT op_value = this->process_operand(load->operand());
-        if (op_value.is_bottom()) {
-          return;
+        case OperandT::AddressKind: {
+          auto address_op =
+              static_cast< const AddressOperandT* >(entry.operand);
+          return PointerAbsValueT(Uninitialized::top(),
+                                  Nullity::top(),
+                                  PointsToSetT{address_op->address()},
+                                  address_op->offset());
         }
-        for (MemoryLocationRef addr : op_value.points_to()) {
-          this->add_pointer(load->result(), this->get_memory(addr), op);
+        default: {
+          ikos_unreachable("unexpected kind");
         }
-      } break;
-      default: {
-        ikos_unreachable("unexpected kind");
       }
     }
-  }
 
-  /// \brief Return the abstract value for the given operand
-  PointerAbsValueT process_operand(const OperandT* op) {
-    switch (op->kind()) {
-      case OperandT::VariableKind: {
-        auto variable_op = static_cast< const VariableOperandT* >(op);
-        PointerAbsValueT value = this->get_pointer(variable_op->var());
-        value.add_offset(variable_op->offset());
-        return value;
+    /// \brief Add `value` in `before`, using a widening after a given number of
+    /// updates
+    ///
+    /// Returns true if `before` has changed.
+    bool extrapolate(PointerAbsValueT& before,
+                     std::size_t& updates,
+                     const PointerAbsValueT& value) const {
+      if (value.leq(before)) {
+        return false;
       }
-      case OperandT::AddressKind: {
-        auto address_op = static_cast< const AddressOperandT* >(op);
-        return PointerAbsValueT(Uninitialized::top(),
-                                Nullity::top(),
-                                PointsToSetT{address_op->address()},
-                                address_op->offset());
+      if (updates < this->_widening_threshold) {
+        before.join_with(value);
+      } else {
+        before.widen_with(value);
       }
-      default: {
-        ikos_unreachable("unexpected kind");
+      updates++;
+      return true;
+    }
+
+    /// \brief Add a pointer abstraction for the given pointer node
+    void update_pointer(std::size_t p,
+                        const PointerAbsValueT& value,
+                        std::deque< std::size_t >& worklist) {
+      this->_pointers[p].defined = true;
+      PointerNode& node = this->_pointers[this->find(p)];
+      if (this->extrapolate(node.value, node.updates, value)) {
+        for (const Use& use : node.uses) {
+          this->push(use.cst, use.full, worklist);
+        }
+      }
+    }
+
+    /// \brief Add a pointer abstraction for the given memory node
+    void update_memory(std::size_t m,
+                       const PointerAbsValueT& value,
+                       std::deque< std::size_t >& worklist) {
+      MemoryNode& node = this->_memory[m];
+      node.defined = true;
+      if (this->extrapolate(node.value, node.updates, value)) {
+        for (std::size_t i : node.loads) {
+          this->_entries[i].dirty.push_back(m);
+          this->push(i, false, worklist);
+        }
+      }
+    }
+
+    /// \brief Collapse the cycles of copy constraints reachable from the given
+    /// pointer node
+    ///
+    /// This is an iterative version of Tarjan's algorithm.
+    void collapse_cycles(std::size_t root,
+                         std::deque< std::size_t >& worklist) {
+      struct Visit {
+        std::size_t index;
+        std::size_t lowlink;
+        bool on_stack;
+      };
+
+      std::unordered_map< std::size_t, Visit > visits;
+      std::vector< std::size_t > stack;
+      std::vector< std::pair< std::size_t, std::size_t > > calls;
+      std::vector< std::vector< std::size_t > > cycles;
+
+      auto enter = [&](std::size_t n) {
+        std::size_t index = visits.size();
+        visits.emplace(n, Visit{index, index, true});
+        stack.push_back(n);
+        calls.emplace_back(n, 0);
+      };
+
+      enter(root);
+      while (!calls.empty()) {
+        std::size_t n = calls.back().first;
+        std::size_t pos = calls.back().second++;
+        const std::vector< Use >& uses = this->_pointers[n].uses;
+
+        if (pos < uses.size()) {
+          const Entry& entry = this->_entries[uses[pos].cst];
+          if (!entry.copy) {
+            continue;
+          }
+          std::size_t s = this->find(entry.lhs);
+          auto it = visits.find(s);
+          if (it == visits.end()) {
+            enter(s);
+          } else if (it->second.on_stack) {
+            Visit& visit = visits.at(n);
+            visit.lowlink = std::min(visit.lowlink, it->second.index);
+          }
+        } else {
+          calls.pop_back();
+          Visit& visit = visits.at(n);
+          if (!calls.empty()) {
+            Visit& caller = visits.at(calls.back().first);
+            caller.lowlink = std::min(caller.lowlink, visit.lowlink);
+          }
+          if (visit.lowlink == visit.index) {
+            std::vector< std::size_t > cycle;
+            std::size_t m;
+            do {
+              m = stack.back();
+              stack.pop_back();
+              visits.at(m).on_stack = false;
+              cycle.push_back(m);
+            } while (m != n);
+            if (cycle.size() > 1) {
+              cycles.push_back(std::move(cycle));
+            }
+          }
+        }
+      }
+
+      for (const std::vector< std::size_t >& cycle : cycles) {
+        this->collapse(cycle, worklist);
       }
     }
-  }
 
+    /// \brief Merge the given pointer nodes into a single node
+    void collapse(const std::vector< std::size_t >& cycle,
+                  std::deque< std::size_t >& worklist) {
+      // Use the node with the most uses as the representative
+      std::size_t rep = *std::max_element(
+          cycle.begin(), cycle.end(), [this](std::size_t a, std::size_t b) {
+            return this->_pointers[a].uses.size() <
+                   this->_pointers[b].uses.size();
+          });
+      PointerNode& rep_node = this->_pointers[rep];
+
+      for (std::size_t n : cycle) {
+        if (n == rep) {
+          continue;
+        }
+        PointerNode& node = this->_pointers[n];
+        node.rep = rep;
+        rep_node.value.join_with(node.value);
+        rep_node.updates = std::max(rep_node.updates, node.updates);
+        rep_node.uses.insert(rep_node.uses.end(),
+                             node.uses.begin(),
+                             node.uses.end());
+        node.value = this->bottom();
+        std::vector< Use >().swap(node.uses);
+      }
+
+      for (const Use& use : rep_node.uses) {
+        this->push(use.cst, true, worklist);
+      }
+    }
+
+  }; // end class Solver
 public:
   /// \brief Return the abstract value for the given pointer
   PointerAbsValueT get_pointer(VariableRef p) {
@@ -655,80 +1075,33 @@ public:
   /// \brief End iterator over the pairs (memory location, abstract value)
   MemoryIterator memory_end() const { return this->_memory.cend(); }
 
-private:
-  /// \brief Add a pointer abstraction for the given pointer
-  void add_pointer(VariableRef p,
-                   const PointerAbsValueT& value,
-                   const BinaryOp& op) {
-    // Get a reference on the current value
-    auto it = this->_pointers.find(p);
-    if (it == this->_pointers.end()) {
-      // add default value
-      auto res = this->_pointers
-                     .emplace(p,
-                              PointerAbsValueT::bottom(this->_offsets_bit_width,
-                                                       this->_offsets_sign));
-      it = res.first;
-    }
-    this->add_apply(it->second, value, op);
-  }
-
-  /// \brief Add a pointer abstraction for the given memory location
-  void add_memory(MemoryLocationRef m,
-                  const PointerAbsValueT& value,
-                  const BinaryOp& op) {
-    // Get a reference on the current value
-    auto it = this->_memory.find(m);
-    if (it == this->_memory.end()) {
-      // add default value
-      auto res = this->_memory
-                     .emplace(m,
-                              PointerAbsValueT::bottom(this->_offsets_bit_width,
-                                                       this->_offsets_sign));
-      it = res.first;
-    }
-    this->add_apply(it->second, value, op);
-  }
-
-  /// \brief Add `after` in `before`, applying the given binary operator `op`
-  void add_apply(PointerAbsValueT& before,
-                 const PointerAbsValueT& after,
-                 const BinaryOp& op) {
-    if (!op.convergence_achieved(before, after)) {
-      this->_change_seen = true;
-      op.apply(before, after, this->_iteration);
-    }
-  }
-
 public:
   /// \brief Solve the constraint system
   void solve(std::size_t widening_threshold = 50,
              std::size_t /*narrowing_threshold*/ = 1) {
-    this->_iteration = 0;
-    Extrapolate widening_op(widening_threshold);
-    do {
-      this->_iteration++;
-      this->_change_seen = false;
-      this->step(widening_op);
-    } while (this->_change_seen);
-
-    // TODO(marthaud): commented out because this is unsound.
-    //
-    // The algorithm here does not compute a proper fixpoint, because the
-    // widening and narrowing operations should be applied between two
-    // consecutive iterations. We can have several constraints updating the
-    // same pointer, thus calling the widening/narrowing several times on the
-    // same iteration. This is unsound.
-    //
-    // As a short fix, the narrowing step is disabled.
-    //
-    // See https://babelfish.arc.nasa.gov/jira/projects/IKOS/issues/IKOS-71
-
-    // Refine narrowing_op;
-    // this->_iteration = 0;
-    // for (; this->_iteration < narrowing_threshold; ++this->_iteration) {
-    //  this->step(narrowing_op);
-    // }
+    Solver solver(*this, widening_threshold);
+    for (const auto& partition : solver.partitions()) {
+      solver.solve(partition);
+    }
+    solver.export_results();
+  }
+
+  /// \brief Solve the constraint system, processing the independent
+  /// partitions of constraints in parallel
+  void concurrent_solve(std::size_t widening_threshold = 50) {
+    Solver solver(*this, widening_threshold);
+    auto partitions = solver.partitions();
+
+    // Start with the largest partitions, for a better load balancing
+    std::sort(partitions.begin(),
+              partitions.end(),
+              [](const auto& a, const auto& b) { return a.size() > b.size(); });
+    tbb::parallel_for_each(partitions.begin(),
+                           partitions.end(),
+                           [&solver](const auto& partition) {
+                             solver.solve(partition);
+                           });
+    solver.export_results();
   }
 
   /// \brief Dump the constraint system, for debugging purpose
@@ -48,6 +48,7 @@
 #include <ikos/core/domain/scalar/abstract_domain.hpp>
 #include <ikos/core/domain/separate_domain.hpp>
 #include <ikos/core/domain/uninitialized/abstract_domain.hpp>
+#include <ikos/core/serialization/stream.hpp>
 
 namespace ikos {
 namespace core {
@@ -122,6 +123,9 @@ public:
   using PointerAbsValueT = PointerAbsValue< MemoryLocationRef >;
   using PointerSetT = PointerSet< MemoryLocationRef >;
 
+public:
+  friend struct serialization::Serializer< CompositeDomain >;
+
 private:
   using PointsToMap = SeparateDomain< VariableRef, PointsToSetT >;
   using IntVariableTrait = machine_int::VariableTraits< VariableRef >;
@@ -46,9 +46,15 @@
 #include <string>
 #include <unordered_map>
 
+#include <boost/optional.hpp>
+
+#include <ikos/core/example/memory_factory.hpp>
+#include <ikos/core/number/machine_int.hpp>
 #include <ikos/core/semantic/dumpable.hpp>
 #include <ikos/core/semantic/indexable.hpp>
 #include <ikos/core/semantic/machine_int/variable.hpp>
+#include <ikos/core/semantic/memory/value/cell_factory.hpp>
+#include <ikos/core/semantic/memory/value/cell_variable.hpp>
 #include <ikos/core/semantic/scalar/variable.hpp>
 #include <ikos/core/semantic/variable.hpp>
 #include <ikos/core/support/assert.hpp>
@@ -95,6 +101,15 @@ public:
     /// \brief Offset variable (if any)
     Variable* _offset_var;
 
+    /// \brief Base memory location (memory cells only)
+    MemoryFactory::MemoryLocationRef _base = nullptr;
+
+    /// \brief Offset (memory cells only)
+    boost::optional< MachineInt > _offset;
+
+    /// \brief Size (memory cells only)
+    boost::optional< MachineInt > _size;
+
   private:
     /// \brief Private constructor
     Variable(std::string name,
@@ -141,6 +156,24 @@ public:
               offset_var};
     }
 
+    static Variable make_cell(std::string name,
+                              Index id,
+                              MemoryFactory::MemoryLocationRef base,
+                              const MachineInt& offset,
+                              const MachineInt& size,
+                              Signedness sign,
+                              Variable* offset_var) {
+      Variable var = make_dynamic(std::move(name),
+                                  id,
+                                  size.to< uint64_t >() * 8,
+                                  sign,
+                                  offset_var);
+      var._base = base;
+      var._offset = offset;
+      var._size = size;
+      return var;
+    }
+
     /// \brief No default constructor
     Variable() = delete;
 
@@ -189,6 +222,27 @@ public:
       return this->_offset_var;
     }
 
+    /// \brief Return true if the variable is a memory cell
+    bool is_cell() const { return this->_base != nullptr; }
+
+    /// \brief Return the base memory location of the memory cell
+    MemoryFactory::MemoryLocationRef base() const {
+      ikos_assert(this->is_cell());
+      return this->_base;
+    }
+
+    /// \brief Return the offset of the memory cell
+    const MachineInt& offset() const {
+      ikos_assert(this->is_cell());
+      return *this->_offset;
+    }
+
+    /// \brief Return the size of the memory cell
+    const MachineInt& size() const {
+      ikos_assert(this->is_cell());
+      return *this->_size;
+    }
+
   }; // end class Variable
 
 public:
@@ -320,6 +374,45 @@ public:
     return &(res.first->second);
   }
 
+  /// \brief Get or create a memory cell variable
+  ///
+  /// A memory cell is a dynamically typed variable of `size` bytes, at the
+  /// given offset of the given memory location.
+  VariableRef get_cell(MemoryFactory::MemoryLocationRef base,
+                       const MachineInt& offset,
+                       const MachineInt& size,
+                       Signedness sign) {
+    // This is sound because references are kept valid when using
+    // std::unordered_map::emplace()
+
+    std::string name = "C{" + base->name() + "," + offset.str() + "," +
+                       size.str() + "}";
+
+    auto it = this->_map.find(name);
+    if (it != this->_map.end()) {
+      return &(it->second);
+    }
+
+    auto res = this->_map.emplace(name + ".offset",
+                                  Variable::make_int(name + ".offset",
+                                                     this->_next_id++,
+                                                     offset.bit_width(),
+                                                     Unsigned));
+    ikos_assert(res.second);
+    Variable* offset_var = &(res.first->second);
+
+    res = this->_map.emplace(name,
+                             Variable::make_cell(name,
+                                                 this->_next_id++,
+                                                 base,
+                                                 offset,
+                                                 size,
+                                                 sign,
+                                                 offset_var));
+    ikos_assert(res.second);
+    return &(res.first->second);
+  }
+
 }; // end class VariableFactory
 
 /// \brief Write a variable on a stream
@@ -403,5 +496,50 @@ struct VariableTraits< example::scalar::VariableFactory::VariableRef > {
 
 } // end namespace scalar
 
+namespace memory {
+
+/// \brief Implement memory::CellVariableTraits for
+/// example::scalar::VariableFactory::VariableRef
+template <>
+struct CellVariableTraits< example::scalar::VariableFactory::VariableRef,
+                           example::MemoryFactory::MemoryLocationRef > {
+  static bool is_cell(example::scalar::VariableFactory::VariableRef var) {
+    return var->is_cell();
+  }
+
+  static example::MemoryFactory::MemoryLocationRef base(
+      example::scalar::VariableFactory::VariableRef var) {
+    return var->base();
+  }
+
+  static const MachineInt& offset(
+      example::scalar::VariableFactory::VariableRef var) {
+    return var->offset();
+  }
+
+  static const MachineInt& size(
+      example::scalar::VariableFactory::VariableRef var) {
+    return var->size();
+  }
+};
+
+/// \brief Implement memory::CellFactoryTraits for
+/// example::scalar::VariableFactory
+template <>
+struct CellFactoryTraits< example::scalar::VariableFactory::VariableRef,
+                          example::MemoryFactory::MemoryLocationRef,
+                          example::scalar::VariableFactory* > {
+  static example::scalar::VariableFactory::VariableRef cell(
+      example::scalar::VariableFactory* vfac,
+      example::MemoryFactory::MemoryLocationRef base,
+      const MachineInt& offset,
+      const MachineInt& size,
+      Signedness sign) {
+    return vfac->get_cell(base, offset, size, sign);
+  }
+};
+
+} // end namespace memory
+
 } // end namespace core
 } // end namespace ikos
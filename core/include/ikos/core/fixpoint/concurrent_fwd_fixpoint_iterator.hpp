@@ -156,6 +156,17 @@ public:
     }
   }
 
+protected:
+  /// \brief Set the pre invariant for the given node
+  ///
+  /// The fixpoint must have been computed.
+  void set_pre(NodeRef node, AbstractValue inv) {
+    auto it = this->_node_to_work.find(node);
+    ikos_assert(it != this->_node_to_work.end());
+    it->second->set_pre(std::move(inv));
+  }
+
+public:
   /// \brief Extrapolate the new state after an increasing iteration
   ///
   /// This is called after each iteration of a cycle, until the fixpoint is
@@ -372,6 +383,19 @@ private:
       return this->_post;
     }
 
+    /// \brief Set the pre invariant
+    ///
+    /// This is not thread-safe, and should only be called after the fixpoint.
+    void set_pre(AbstractValue pre) {
+      ikos_assert(this->_kind != WpoNodeKind::Exit);
+      this->_pre = std::move(pre);
+    }
+
+    /// \brief Set the post invariant to bottom
+    ///
+    /// This is not thread-safe, and should only be called after the fixpoint.
+    void clear_post() { this->_post = this->_iterator.bottom(); }
+
     /// \brief Update the node
     const WorkNodeVector& update() {
       std::lock_guard< std::mutex > lock(this->_mutex);
@@ -673,6 +697,24 @@ public:
     }
   }
 
+  /// \brief Set the pre invariants to bottom
+  void clear_pre() {
+    for (WorkNode& work_node : this->_work_nodes) {
+      if (work_node.kind() != WpoNodeKind::Exit) {
+        work_node.set_pre(this->_bottom);
+      }
+    }
+  }
+
+  /// \brief Set the post invariants to bottom
+  void clear_post() {
+    for (WorkNode& work_node : this->_work_nodes) {
+      if (work_node.kind() != WpoNodeKind::Exit) {
+        work_node.clear_post();
+      }
+    }
+  }
+
   /// \brief Clear the current fixpoint
   void clear() override {
     this->_converged = false;
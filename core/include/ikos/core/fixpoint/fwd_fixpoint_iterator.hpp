@@ -143,11 +143,13 @@ private:
     }
   }
 
+protected:
   /// \brief Set the pre invariant for the given node
   void set_pre(NodeRef node, AbstractValue inv) {
     this->set(this->_pre, node, std::move(inv));
   }
 
+private:
   /// \brief Set the post invariant for the given node
   void set_post(NodeRef node, AbstractValue inv) {
     this->set(this->_post, node, std::move(inv));
@@ -46,8 +46,10 @@
 
 #pragma once
 
+#include <cstdint>
 #include <functional>
 #include <iosfwd>
+#include <limits>
 #include <sstream>
 #include <string>
 #include <type_traits>
@@ -60,6 +62,7 @@
 #include <ikos/core/number/exception.hpp>
 #include <ikos/core/number/supported_integral.hpp>
 #include <ikos/core/support/assert.hpp>
+#include <ikos/core/support/compiler.hpp>
 
 namespace ikos {
 namespace core {
@@ -283,12 +286,269 @@ template <>
 struct MpzTo< long long >
     : public MpzToLongLong< sizeof(long long) == sizeof(long) > {};
 
+/// \brief Helper to check if an integer of type T fits in a int64_t
+template < typename T,
+           bool AlwaysFits = std::is_signed< T >::value ||
+                             (sizeof(T) < sizeof(int64_t)) >
+struct Int64Fits {
+  bool operator()(T) { return true; }
+};
+
+template < typename T >
+struct Int64Fits< T, false > {
+  bool operator()(T n) {
+    return n <= static_cast< T >(std::numeric_limits< int64_t >::max());
+  }
+};
+
+/// \brief Helper to check if an int64_t fits in the given integer type
+template < typename T, bool Signed = std::is_signed< T >::value >
+struct Int64FitsIn;
+
+template < typename T >
+struct Int64FitsIn< T, true > {
+  bool operator()(int64_t n) {
+    return n >= static_cast< int64_t >(std::numeric_limits< T >::min()) &&
+           n <= static_cast< int64_t >(std::numeric_limits< T >::max());
+  }
+};
+
+template < typename T >
+struct Int64FitsIn< T, false > {
+  bool operator()(int64_t n) {
+    return n >= 0 && static_cast< uint64_t >(n) <=
+                         static_cast< uint64_t >(std::numeric_limits< T >::max());
+  }
+};
+
+/// \brief Compute `r = a + b`, return true on overflow
+inline bool add_overflow(int64_t a, int64_t b, int64_t& r) {
+#if __has_builtin(__builtin_add_overflow) || IKOS_GNUC_PREREQ(5, 0, 0)
+  return __builtin_add_overflow(a, b, &r);
+#else
+  if ((b > 0 && a > std::numeric_limits< int64_t >::max() - b) ||
+      (b < 0 && a < std::numeric_limits< int64_t >::min() - b)) {
+    return true;
+  }
+  r = a + b;
+  return false;
+#endif
+}
+
+/// \brief Compute `r = a - b`, return true on overflow
+inline bool sub_overflow(int64_t a, int64_t b, int64_t& r) {
+#if __has_builtin(__builtin_sub_overflow) || IKOS_GNUC_PREREQ(5, 0, 0)
+  return __builtin_sub_overflow(a, b, &r);
+#else
+  if ((b < 0 && a > std::numeric_limits< int64_t >::max() + b) ||
+      (b > 0 && a < std::numeric_limits< int64_t >::min() + b)) {
+    return true;
+  }
+  r = a - b;
+  return false;
+#endif
+}
+
+/// \brief Compute `r = a * b`, return true on overflow
+inline bool mul_overflow(int64_t a, int64_t b, int64_t& r) {
+#if __has_builtin(__builtin_mul_overflow) || IKOS_GNUC_PREREQ(5, 0, 0)
+  return __builtin_mul_overflow(a, b, &r);
+#else
+  const int64_t max = std::numeric_limits< int64_t >::max();
+  const int64_t min = std::numeric_limits< int64_t >::min();
+  if (a > 0) {
+    if ((b > 0 && a > max / b) || (b < 0 && b < min / a)) {
+      return true;
+    }
+  } else if (a < 0) {
+    if ((b > 0 && a < min / b) || (b < 0 && a < max / b)) {
+      return true;
+    }
+  }
+  r = a * b;
+  return false;
+#endif
+}
+
+/// \brief Return the absolute value of a int64_t, as a uint64_t
+inline uint64_t abs_uint64(int64_t n) {
+  return n < 0 ? (~static_cast< uint64_t >(n) + 1) : static_cast< uint64_t >(n);
+}
+
+/// \brief Return the number of trailing '0' bits in a non-zero uint64_t
+inline uint64_t trailing_zeros_uint64(uint64_t n) {
+#if __has_builtin(__builtin_ctzll) || IKOS_GNUC_PREREQ(4, 0, 0)
+  // NOLINTNEXTLINE(google-runtime-int)
+  return static_cast< uint64_t >(__builtin_ctzll(n));
+#else
+  uint64_t zeros = 0;
+  for (; (n & 1U) == 0; n >>= 1U) {
+    zeros++;
+  }
+  return zeros;
+#endif
+}
+
+/// \brief Return the number of significant bits in a uint64_t
+inline uint64_t size_in_bits_uint64(uint64_t n) {
+#if __has_builtin(__builtin_clzll) || IKOS_GNUC_PREREQ(4, 0, 0)
+  // NOLINTNEXTLINE(google-runtime-int)
+  return n == 0 ? 1 : 64 - static_cast< uint64_t >(__builtin_clzll(n));
+#else
+  uint64_t bits = 1;
+  for (n >>= 1U; n != 0; n >>= 1U) {
+    bits++;
+  }
+  return bits;
+#endif
+}
+
+/// \brief Return the greatest common divisor of two uint64_t
+inline uint64_t gcd_uint64(uint64_t a, uint64_t b) {
+  while (b != 0) {
+    uint64_t t = a % b;
+    a = b;
+    b = t;
+  }
+  return a;
+}
+
 } // end namespace detail
 
 /// \brief Class for unlimited precision integers
+///
+/// Integers that fit in 64 bits are stored inline, without any memory
+/// allocation. Arithmetic operations on these use checked arithmetic and only
+/// fall back to GMP on overflow.
+///
+/// Integers that do not fit in 64 bits are stored in a heap-allocated
+/// mpz_class. The representation is canonical: a GMP integer is used if and
+/// only if the value does not fit in a int64_t.
 class ZNumber {
 private:
-  mpz_class _n;
+  union {
+    int64_t i;     /// Used to store the integer value if it fits in 64 bits.
+    mpz_class* p;  /// Used to store the integer value otherwise.
+  } _n;
+  bool _large;
+
+private:
+  /// \brief Return true if the integer is stored in a int64_t
+  bool is_small() const { return ikos_likely(!this->_large); }
+
+  /// \brief Return true if the integer is stored in a mpz_class
+  bool is_large() const { return !this->is_small(); }
+
+  /// \brief Return -1, 0 or 1 depending on the sign of the integer
+  int sign() const {
+    if (this->is_small()) {
+      return (this->_n.i > 0) - (this->_n.i < 0);
+    }
+    return sgn(*this->_n.p);
+  }
+
+  /// \brief Set the integer to the given int64_t
+  void set_small(int64_t n) {
+    if (this->is_large()) {
+      delete this->_n.p;
+      this->_large = false;
+    }
+    this->_n.i = n;
+  }
+
+  /// \brief Set the integer to the given mpz_class
+  template < typename Mpz >
+  void set_mpz(Mpz&& n) {
+    if (detail::MpzFits< int64_t >()(n)) {
+      this->set_small(detail::MpzTo< int64_t >()(n));
+    } else if (this->is_large()) {
+      *this->_n.p = std::forward< Mpz >(n);
+    } else {
+      this->_n.p = new mpz_class(std::forward< Mpz >(n));
+      this->_large = true;
+    }
+  }
+
+  /// \brief Set the integer to the given integral value
+  template < typename T >
+  void set_integral(T n) {
+    if (detail::Int64Fits< T >()(n)) {
+      this->set_small(static_cast< int64_t >(n));
+    } else {
+      this->set_mpz(mpz_class(detail::MpzAdapter< T >()(n)));
+    }
+  }
+
+  /// \brief Switch to the GMP representation and return the mpz_class
+  ///
+  /// This breaks the invariant, normalize() must be called afterwards.
+  mpz_class& promote() {
+    if (this->is_small()) {
+      this->_n.p = new mpz_class(detail::MpzAdapter< int64_t >()(this->_n.i));
+      this->_large = true;
+    }
+    return *this->_n.p;
+  }
+
+  /// \brief Switch back to a int64_t if the integer fits
+  void normalize() {
+    if (this->is_large() && detail::MpzFits< int64_t >()(*this->_n.p)) {
+      int64_t n = detail::MpzTo< int64_t >()(*this->_n.p);
+      delete this->_n.p;
+      this->_large = false;
+      this->_n.i = n;
+    }
+  }
+
+  /// \brief Apply the given GMP operation on this integer and `x`
+  ///
+  /// This is the slow path of all arithmetic operations.
+  template < typename Operation >
+  ZNumber& apply_mpz(const ZNumber& x, Operation op) {
+    mpz_class& n = this->promote();
+    if (x.is_small()) {
+      op(n, mpz_class(detail::MpzAdapter< int64_t >()(x._n.i)));
+    } else {
+      op(n, *x._n.p);
+    }
+    this->normalize();
+    return *this;
+  }
+
+  /// \brief Left binary shift assignment by an unsigned integer
+  ZNumber& shift_left(unsigned long s) {
+    if (this->is_small()) {
+      if (this->_n.i == 0) {
+        return *this;
+      }
+      if (s < 63) {
+        auto r = static_cast< int64_t >(static_cast< uint64_t >(this->_n.i)
+                                        << s);
+        // NOLINTNEXTLINE(hicpp-signed-bitwise)
+        if ((r >> s) == this->_n.i) {
+          this->_n.i = r;
+          return *this;
+        }
+      }
+    }
+    this->promote() <<= s;
+    this->normalize();
+    return *this;
+  }
+
+  /// \brief Right binary shift assignment by an unsigned integer
+  ///
+  /// This rounds towards negative infinity, like GMP.
+  ZNumber& shift_right(unsigned long s) {
+    if (this->is_small()) {
+      // NOLINTNEXTLINE(hicpp-signed-bitwise)
+      this->_n.i = (s >= 64) ? (this->_n.i < 0 ? -1 : 0) : (this->_n.i >> s);
+      return *this;
+    }
+    *this->_n.p >>= s;
+    this->normalize();
+    return *this;
+  }
 
 public:
   /// \brief Create a ZNumber from a string representation
@@ -331,96 +591,165 @@ public:
   /// @{
 
   /// \brief Default constructor that creates a ZNumber equals to 0
-  ZNumber() = default;
+  ZNumber() noexcept : _large(false) { this->_n.i = 0; }
 
   /// \brief Copy constructor
-  ZNumber(const ZNumber&) = default;
+  ZNumber(const ZNumber& o) : _large(o._large) {
+    if (o.is_small()) {
+      this->_n.i = o._n.i;
+    } else {
+      this->_n.p = new mpz_class(*o._n.p);
+    }
+  }
 
   /// \brief Move constructor
-  // TODO(marthaud): Add noexcept when mpz_class(mpz_class&&) becomes noexcept
-  ZNumber(ZNumber&&) = default;
+  ZNumber(ZNumber&& o) noexcept : _n(o._n), _large(o._large) {
+    o._n.i = 0;
+    o._large = false; // do not delete o._n.p
+  }
 
   /// \brief Create a ZNumber from a mpz_class
-  explicit ZNumber(const mpz_class& n) : _n(n) {}
+  explicit ZNumber(const mpz_class& n) : _large(false) { this->set_mpz(n); }
 
   /// \brief Create a ZNumber from a mpz_class
-  explicit ZNumber(mpz_class&& n) : _n(std::move(n)) {}
+  explicit ZNumber(mpz_class&& n) : _large(false) {
+    this->set_mpz(std::move(n));
+  }
 
   /// \brief Create a ZNumber from an integral type
   template < typename T,
              class = std::enable_if_t< IsSupportedIntegral< T >::value > >
-  explicit ZNumber(T n) : _n(detail::MpzAdapter< T >()(n)) {}
+  explicit ZNumber(T n) : _large(false) {
+    this->set_integral(n);
+  }
 
   /// \brief Destructor
-  ~ZNumber() = default;
+  ~ZNumber() {
+    if (this->is_large()) {
+      delete this->_n.p;
+    }
+  }
 
   /// @}
   /// \name Assignment Operators
   /// @{
 
   /// \brief Copy assignment
-  ZNumber& operator=(const ZNumber&) = default;
+  ZNumber& operator=(const ZNumber& o) {
+    if (this == &o) {
+      return *this;
+    }
+
+    if (o.is_small()) {
+      this->set_small(o._n.i);
+    } else if (this->is_large()) {
+      *this->_n.p = *o._n.p;
+    } else {
+      this->_n.p = new mpz_class(*o._n.p);
+      this->_large = true;
+    }
+    return *this;
+  }
 
   /// \brief Move assignment
-  ZNumber& operator=(ZNumber&&) noexcept = default;
+  ZNumber& operator=(ZNumber&& o) noexcept {
+    if (this == &o) {
+      return *this;
+    }
+
+    if (this->is_large()) {
+      delete this->_n.p;
+    }
+
+    this->_n = o._n;
+    this->_large = o._large;
+    o._n.i = 0;
+    o._large = false; // do not delete o._n.p
+    return *this;
+  }
 
   /// \brief Assignment for integral types
   template < typename T,
              class = std::enable_if_t< IsSupportedIntegral< T >::value > >
   ZNumber& operator=(T n) {
-    this->_n = detail::MpzAdapter< T >()(n);
+    this->set_integral(n);
     return *this;
   }
 
   /// \brief Addition assignment
   ZNumber& operator+=(const ZNumber& x) {
-    this->_n += x._n;
-    return *this;
+    int64_t r;
+    if (this->is_small() && x.is_small() &&
+        !detail::add_overflow(this->_n.i, x._n.i, r)) {
+      this->_n.i = r;
+      return *this;
+    }
+    return this->apply_mpz(x, [](mpz_class& n, const mpz_class& y) {
+      n += y;
+    });
   }
 
   /// \brief Addition assignment with integral types
   template < typename T,
              class = std::enable_if_t< IsSupportedIntegral< T >::value > >
   ZNumber& operator+=(T x) {
-    this->_n += detail::MpzAdapter< T >()(x);
-    return *this;
+    return this->operator+=(ZNumber(x));
   }
 
   /// \brief Subtraction assignment
   ZNumber& operator-=(const ZNumber& x) {
-    this->_n -= x._n;
-    return *this;
+    int64_t r;
+    if (this->is_small() && x.is_small() &&
+        !detail::sub_overflow(this->_n.i, x._n.i, r)) {
+      this->_n.i = r;
+      return *this;
+    }
+    return this->apply_mpz(x, [](mpz_class& n, const mpz_class& y) {
+      n -= y;
+    });
   }
 
   /// \brief Subtraction assignment with integral types
   template < typename T,
              class = std::enable_if_t< IsSupportedIntegral< T >::value > >
   ZNumber& operator-=(T x) {
-    this->_n -= detail::MpzAdapter< T >()(x);
-    return *this;
+    return this->operator-=(ZNumber(x));
   }
 
   /// \brief Multiplication assignment
   ZNumber& operator*=(const ZNumber& x) {
-    this->_n *= x._n;
-    return *this;
+    int64_t r;
+    if (this->is_small() && x.is_small() &&
+        !detail::mul_overflow(this->_n.i, x._n.i, r)) {
+      this->_n.i = r;
+      return *this;
+    }
+    return this->apply_mpz(x, [](mpz_class& n, const mpz_class& y) {
+      n *= y;
+    });
   }
 
   /// \brief Multiplication assignment with integral types
   template < typename T,
              class = std::enable_if_t< IsSupportedIntegral< T >::value > >
   ZNumber& operator*=(T x) {
-    this->_n *= detail::MpzAdapter< T >()(x);
-    return *this;
+    return this->operator*=(ZNumber(x));
   }
 
   /// \brief Integer division assignment
   ///
   /// Integer division with rounding towards zero.
   ZNumber& operator/=(const ZNumber& x) {
-    ikos_assert_msg(x._n != 0, "division by zero");
-    this->_n /= x._n;
-    return *this;
+    ikos_assert_msg(x.sign() != 0, "division by zero");
+    if (this->is_small() && x.is_small() &&
+        (x._n.i != -1 ||
+         this->_n.i != std::numeric_limits< int64_t >::min())) {
+      this->_n.i /= x._n.i;
+      return *this;
+    }
+    return this->apply_mpz(x, [](mpz_class& n, const mpz_class& y) {
+      n /= y;
+    });
   }
 
   /// \brief Integer division assignment with integral types
@@ -430,8 +759,7 @@ public:
              class = std::enable_if_t< IsSupportedIntegral< T >::value > >
   ZNumber& operator/=(T x) {
     ikos_assert_msg(x != 0, "division by zero");
-    this->_n /= detail::MpzAdapter< T >()(x);
-    return *this;
+    return this->operator/=(ZNumber(x));
   }
 
   /// \brief Remainder assignment
@@ -442,9 +770,14 @@ public:
   /// The sign of `x` is ignored, and the result will have the same sign as
   /// `this`.
   ZNumber& operator%=(const ZNumber& x) {
-    ikos_assert_msg(x._n != 0, "division by zero");
-    this->_n %= x._n;
-    return *this;
+    ikos_assert_msg(x.sign() != 0, "division by zero");
+    if (this->is_small() && x.is_small()) {
+      this->_n.i = (x._n.i == -1) ? 0 : (this->_n.i % x._n.i);
+      return *this;
+    }
+    return this->apply_mpz(x, [](mpz_class& n, const mpz_class& y) {
+      n %= y;
+    });
   }
 
   /// \brief Remainder assignment with integral types
@@ -458,60 +791,73 @@ public:
              class = std::enable_if_t< IsSupportedIntegral< T >::value > >
   ZNumber& operator%=(T x) {
     ikos_assert_msg(x != 0, "division by zero");
-    this->_n %= detail::MpzAdapter< T >()(x);
-    return *this;
+    return this->operator%=(ZNumber(x));
   }
 
   /// \brief Bitwise AND assignment
   ZNumber& operator&=(const ZNumber& x) {
-    this->_n &= x._n;
-    return *this;
+    if (this->is_small() && x.is_small()) {
+      // NOLINTNEXTLINE(hicpp-signed-bitwise)
+      this->_n.i &= x._n.i;
+      return *this;
+    }
+    return this->apply_mpz(x, [](mpz_class& n, const mpz_class& y) {
+      n &= y;
+    });
   }
 
   /// \brief Bitwise AND assignment with integral types
   template < typename T,
              class = std::enable_if_t< IsSupportedIntegral< T >::value > >
   ZNumber& operator&=(T x) {
-    this->_n &= detail::MpzAdapter< T >()(x);
-    return *this;
+    return this->operator&=(ZNumber(x));
   }
 
   /// \brief Bitwise OR assignment
   ZNumber& operator|=(const ZNumber& x) {
-    this->_n |= x._n;
-    return *this;
+    if (this->is_small() && x.is_small()) {
+      // NOLINTNEXTLINE(hicpp-signed-bitwise)
+      this->_n.i |= x._n.i;
+      return *this;
+    }
+    return this->apply_mpz(x, [](mpz_class& n, const mpz_class& y) {
+      n |= y;
+    });
   }
 
   /// \brief Bitwise OR assignment with integral types
   template < typename T,
              class = std::enable_if_t< IsSupportedIntegral< T >::value > >
   ZNumber& operator|=(T x) {
-    this->_n |= detail::MpzAdapter< T >()(x);
-    return *this;
+    return this->operator|=(ZNumber(x));
   }
 
   /// \brief Bitwise XOR assignment
   ZNumber& operator^=(const ZNumber& x) {
-    this->_n ^= x._n;
-    return *this;
+    if (this->is_small() && x.is_small()) {
+      // NOLINTNEXTLINE(hicpp-signed-bitwise)
+      this->_n.i ^= x._n.i;
+      return *this;
+    }
+    return this->apply_mpz(x, [](mpz_class& n, const mpz_class& y) {
+      n ^= y;
+    });
   }
 
   /// \brief Bitwise XOR assignment with integral types
   template < typename T,
              class = std::enable_if_t< IsSupportedIntegral< T >::value > >
   ZNumber& operator^=(T x) {
-    this->_n ^= detail::MpzAdapter< T >()(x);
-    return *this;
+    return this->operator^=(ZNumber(x));
   }
 
   /// \brief Left binary shift assignment
   ///
   /// This is undefined if `x` isn't between 0 and 2**32 - 1
   ZNumber& operator<<=(const ZNumber& x) {
-    ikos_assert_msg(x._n >= 0, "shift count is negative");
-    ikos_assert_msg(x._n.fits_ulong_p(), "shift count is too big");
-    this->_n <<= x._n.get_ui();
-    return *this;
+    ikos_assert_msg(x.sign() >= 0, "shift count is negative");
+    ikos_assert_msg(x.fits< unsigned long >(), "shift count is too big");
+    return this->shift_left(x.to< unsigned long >());
   }
 
   /// \brief Left binary shift assignment with integral types
@@ -521,18 +867,16 @@ public:
              class = std::enable_if_t< IsSupportedIntegral< T >::value > >
   ZNumber& operator<<=(T x) {
     ikos_assert_msg(x >= 0, "shift count is negative");
-    this->_n <<= static_cast< unsigned long int >(x);
-    return *this;
+    return this->shift_left(static_cast< unsigned long int >(x));
   }
 
   /// \brief Right binary shift
   ///
   /// This is undefined if `x` isn't between 0 and 2**32 - 1
   ZNumber& operator>>=(const ZNumber& x) {
-    ikos_assert_msg(x._n >= 0, "shift count is negative");
-    ikos_assert_msg(x._n.fits_ulong_p(), "shift count is too big");
-    this->_n >>= x._n.get_ui();
-    return *this;
+    ikos_assert_msg(x.sign() >= 0, "shift count is negative");
+    ikos_assert_msg(x.fits< unsigned long >(), "shift count is too big");
+    return this->shift_right(x.to< unsigned long >());
   }
 
   /// \brief Right binary shift with integral types
@@ -542,8 +886,7 @@ public:
              class = std::enable_if_t< IsSupportedIntegral< T >::value > >
   ZNumber& operator>>=(T x) {
     ikos_assert_msg(x >= 0, "shift count is negative");
-    this->_n >>= static_cast< unsigned long int >(x);
-    return *this;
+    return this->shift_right(static_cast< unsigned long int >(x));
   }
 
   /// @}
@@ -555,30 +898,48 @@ public:
 
   /// \brief Prefix increment
   ZNumber& operator++() {
-    ++this->_n;
+    if (this->is_small() &&
+        this->_n.i != std::numeric_limits< int64_t >::max()) {
+      ++this->_n.i;
+      return *this;
+    }
+    ++this->promote();
+    this->normalize();
     return *this;
   }
 
   /// \brief Postfix increment
   const ZNumber operator++(int) {
     ZNumber r(*this);
-    ++this->_n;
+    ++(*this);
     return r;
   }
 
   /// \brief Unary minus
-  const ZNumber operator-() const { return ZNumber(-this->_n); }
+  const ZNumber operator-() const {
+    if (this->is_small() &&
+        this->_n.i != std::numeric_limits< int64_t >::min()) {
+      return ZNumber(-this->_n.i);
+    }
+    return ZNumber(mpz_class(-this->mpz()));
+  }
 
   /// \brief Prefix decrement
   ZNumber& operator--() {
-    --this->_n;
+    if (this->is_small() &&
+        this->_n.i != std::numeric_limits< int64_t >::min()) {
+      --this->_n.i;
+      return *this;
+    }
+    --this->promote();
+    this->normalize();
     return *this;
   }
 
   /// \brief Postfix decrement
   const ZNumber operator--(int) {
     ZNumber r(*this);
-    --this->_n;
+    --(*this);
     return r;
   }
 
@@ -586,14 +947,17 @@ public:
   ///
   /// This is undefined for negative numbers.
   ZNumber next_power_of_2() const {
-    ikos_assert(this->_n >= 0);
+    ikos_assert(this->sign() >= 0);
 
-    if (this->_n <= 1) {
+    if (this->is_small() && this->_n.i <= 1) {
       return ZNumber(1);
     }
 
-    ZNumber n(this->_n - 1);
-    return ZNumber(mpz_class(1) << n.size_in_bits());
+    ZNumber n(*this);
+    --n;
+    ZNumber r(1);
+    r.shift_left(n.size_in_bits());
+    return r;
   }
 
   /// @}
@@ -604,75 +968,94 @@ public:
   ///
   /// This is undefined if the number is 0.
   uint64_t trailing_zeros() const {
-    ikos_assert(this->_n != 0);
-    return mpz_scan1(this->_n.get_mpz_t(), 0);
+    ikos_assert(this->sign() != 0);
+    if (this->is_small()) {
+      return detail::trailing_zeros_uint64(
+          static_cast< uint64_t >(this->_n.i));
+    }
+    return mpz_scan1(this->_n.p->get_mpz_t(), 0);
   }
 
   /// \brief Return the number of trailing '1' bits
   ///
   /// This is undefined if the number is -1.
   uint64_t trailing_ones() const {
-    ikos_assert(this->_n != -1);
-    return mpz_scan0(this->_n.get_mpz_t(), 0);
+    ikos_assert(this->is_large() || this->_n.i != -1);
+    if (this->is_small()) {
+      return detail::trailing_zeros_uint64(
+          ~static_cast< uint64_t >(this->_n.i));
+    }
+    return mpz_scan0(this->_n.p->get_mpz_t(), 0);
   }
 
   /// \brief Return the number of bits
   ///
   /// The sign is ignored.
   uint64_t size_in_bits() const {
-    return mpz_sizeinbase(this->_n.get_mpz_t(), 2);
+    if (this->is_small()) {
+      return detail::size_in_bits_uint64(detail::abs_uint64(this->_n.i));
+    }
+    return mpz_sizeinbase(this->_n.p->get_mpz_t(), 2);
   }
 
   /// @}
   /// \name Conversion Functions
   /// @{
 
-  /// \brief Get the internal representation
-  const mpz_class& mpz() const { return this->_n; }
+  /// \brief Return the number as a mpz_class
+  mpz_class mpz() const {
+    if (this->is_small()) {
+      return mpz_class(detail::MpzAdapter< int64_t >()(this->_n.i));
+    }
+    return *this->_n.p;
+  }
 
   /// \brief Return true if the number fits in the given integer type
   template < typename T,
              class = std::enable_if_t< IsSupportedIntegral< T >::value > >
   bool fits() const {
-    return detail::MpzFits< T >()(this->_n);
+    if (this->is_small()) {
+      return detail::Int64FitsIn< T >()(this->_n.i);
+    }
+    return detail::MpzFits< T >()(*this->_n.p);
   }
 
   /// \brief Return the number as the given integer type
   template < typename T,
              class = std::enable_if_t< IsSupportedIntegral< T >::value > >
   T to() const {
-    ikos_assert_msg(detail::MpzFits< T >()(this->_n), "does not fit");
-    return detail::MpzTo< T >()(this->_n);
+    ikos_assert_msg(this->fits< T >(), "does not fit");
+    if (this->is_small()) {
+      return static_cast< T >(this->_n.i);
+    }
+    return detail::MpzTo< T >()(*this->_n.p);
   }
 
   /// \brief Return a string representation of the ZNumber in the given base
   ///
   /// The base can vary from 2 to 36, or from -2 to -36
-  std::string str(int base = 10) const { return this->_n.get_str(base); }
+  std::string str(int base = 10) const {
+    if (this->is_small() && base == 10) {
+      return std::to_string(this->_n.i);
+    }
+    return this->mpz().get_str(base);
+  }
 
   /// @}
 
+  friend bool operator==(const ZNumber&, const ZNumber&);
+
+  friend bool operator<(const ZNumber&, const ZNumber&);
+
   friend ZNumber mod(const ZNumber&, const ZNumber&);
 
   friend ZNumber gcd(const ZNumber&, const ZNumber&);
 
   friend ZNumber lcm(const ZNumber&, const ZNumber&);
 
-  friend void gcd_extended(
-      const ZNumber&, const ZNumber&, ZNumber&, ZNumber&, ZNumber&);
-
-  friend std::istream& operator>>(std::istream& i, ZNumber& n);
-
-  friend class QNumber;
+  friend std::ostream& operator<<(std::ostream& o, const ZNumber& n);
 
-  friend ZNumber single_mask(const ZNumber& size);
-
-  friend ZNumber double_mask(const ZNumber& low, const ZNumber& high);
-
-  friend ZNumber make_clipped_mask(const ZNumber& low,
-                                   const ZNumber& size,
-                                   const ZNumber& lower_clip,
-                                   const ZNumber& size_clip);
+  friend std::size_t hash_value(const ZNumber&);
 
 }; // end class ZNumber
 
@@ -681,67 +1064,86 @@ public:
 
 /// \brief Addition
 inline ZNumber operator+(const ZNumber& lhs, const ZNumber& rhs) {
-  return ZNumber(lhs.mpz() + rhs.mpz());
+  ZNumber r(lhs);
+  r += rhs;
+  return r;
 }
 
 /// \brief Addition with integral types
 template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline ZNumber operator+(const ZNumber& lhs, T rhs) {
-  return ZNumber(lhs.mpz() + detail::MpzAdapter< T >()(rhs));
+  ZNumber r(lhs);
+  r += rhs;
+  return r;
 }
 
 /// \brief Addition with integral types
 template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline ZNumber operator+(T lhs, const ZNumber& rhs) {
-  return ZNumber(detail::MpzAdapter< T >()(lhs) + rhs.mpz());
+  ZNumber r(lhs);
+  r += rhs;
+  return r;
 }
 
 /// \brief Subtraction
 inline ZNumber operator-(const ZNumber& lhs, const ZNumber& rhs) {
-  return ZNumber(lhs.mpz() - rhs.mpz());
+  ZNumber r(lhs);
+  r -= rhs;
+  return r;
 }
 
 /// \brief Subtraction with integral types
 template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline ZNumber operator-(const ZNumber& lhs, T rhs) {
-  return ZNumber(lhs.mpz() - detail::MpzAdapter< T >()(rhs));
+  ZNumber r(lhs);
+  r -= rhs;
+  return r;
 }
 
 /// \brief Subtraction with integral types
 template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline ZNumber operator-(T lhs, const ZNumber& rhs) {
-  return ZNumber(detail::MpzAdapter< T >()(lhs) - rhs.mpz());
+  ZNumber r(lhs);
+  r -= rhs;
+  return r;
 }
 
 /// \brief Multiplication
 inline ZNumber operator*(const ZNumber& lhs, const ZNumber& rhs) {
-  return ZNumber(lhs.mpz() * rhs.mpz());
+  ZNumber r(lhs);
+  r *= rhs;
+  return r;
 }
 
 /// \brief Multiplication with integral types
 template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline ZNumber operator*(const ZNumber& lhs, T rhs) {
-  return ZNumber(lhs.mpz() * detail::MpzAdapter< T >()(rhs));
+  ZNumber r(lhs);
+  r *= rhs;
+  return r;
 }
 
 /// \brief Multiplication with integral types
 template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline ZNumber operator*(T lhs, const ZNumber& rhs) {
-  return ZNumber(detail::MpzAdapter< T >()(lhs) * rhs.mpz());
+  ZNumber r(lhs);
+  r *= rhs;
+  return r;
 }
 
 /// \brief Integer division
 ///
 /// Integer division with rounding towards zero.
 inline ZNumber operator/(const ZNumber& lhs, const ZNumber& rhs) {
-  ikos_assert_msg(rhs.mpz() != 0, "division by zero");
-  return ZNumber(lhs.mpz() / rhs.mpz());
+  ZNumber r(lhs);
+  r /= rhs;
+  return r;
 }
 
 /// \brief Integer division with integral types
@@ -750,8 +1152,9 @@ inline ZNumber operator/(const ZNumber& lhs, const ZNumber& rhs) {
 template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline ZNumber operator/(const ZNumber& lhs, T rhs) {
-  ikos_assert_msg(rhs != 0, "division by zero");
-  return ZNumber(lhs.mpz() / detail::MpzAdapter< T >()(rhs));
+  ZNumber r(lhs);
+  r /= rhs;
+  return r;
 }
 
 /// \brief Integer division with integral types
@@ -760,8 +1163,9 @@ inline ZNumber operator/(const ZNumber& lhs, T rhs) {
 template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline ZNumber operator/(T lhs, const ZNumber& rhs) {
-  ikos_assert_msg(rhs.mpz() != 0, "division by zero");
-  return ZNumber(detail::MpzAdapter< T >()(lhs) / rhs.mpz());
+  ZNumber r(lhs);
+  r /= rhs;
+  return r;
 }
 
 /// \brief Remainder
@@ -772,8 +1176,9 @@ inline ZNumber operator/(T lhs, const ZNumber& rhs) {
 /// The sign of `rhs` is ignored, and the result will have the same sign as
 /// `lhs`.
 inline ZNumber operator%(const ZNumber& lhs, const ZNumber& rhs) {
-  ikos_assert_msg(rhs.mpz() != 0, "division by zero");
-  return ZNumber(lhs.mpz() % rhs.mpz());
+  ZNumber r(lhs);
+  r %= rhs;
+  return r;
 }
 
 /// \brief Remainder with integral types
@@ -786,8 +1191,9 @@ inline ZNumber operator%(const ZNumber& lhs, const ZNumber& rhs) {
 template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline ZNumber operator%(const ZNumber& lhs, T rhs) {
-  ikos_assert_msg(rhs != 0, "division by zero");
-  return ZNumber(lhs.mpz() % detail::MpzAdapter< T >()(rhs));
+  ZNumber r(lhs);
+  r %= rhs;
+  return r;
 }
 
 /// \brief Remainder with integral types
@@ -800,74 +1206,93 @@ inline ZNumber operator%(const ZNumber& lhs, T rhs) {
 template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline ZNumber operator%(T lhs, const ZNumber& rhs) {
-  ikos_assert_msg(rhs.mpz() != 0, "division by zero");
-  return ZNumber(detail::MpzAdapter< T >()(lhs) % rhs.mpz());
+  ZNumber r(lhs);
+  r %= rhs;
+  return r;
 }
 
 /// \brief Bitwise AND
 inline ZNumber operator&(const ZNumber& lhs, const ZNumber& rhs) {
-  return ZNumber(lhs.mpz() & rhs.mpz());
+  ZNumber r(lhs);
+  r &= rhs;
+  return r;
 }
 
 /// \brief Bitwise AND with integral types
 template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline ZNumber operator&(const ZNumber& lhs, T rhs) {
-  return ZNumber(lhs.mpz() & detail::MpzAdapter< T >()(rhs));
+  ZNumber r(lhs);
+  r &= rhs;
+  return r;
 }
 
 /// \brief Bitwise AND with integral types
 template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline ZNumber operator&(T lhs, const ZNumber& rhs) {
-  return ZNumber(detail::MpzAdapter< T >()(lhs) & rhs.mpz());
+  ZNumber r(lhs);
+  r &= rhs;
+  return r;
 }
 
 /// \brief Bitwise OR
 inline ZNumber operator|(const ZNumber& lhs, const ZNumber& rhs) {
-  return ZNumber(lhs.mpz() | rhs.mpz());
+  ZNumber r(lhs);
+  r |= rhs;
+  return r;
 }
 
 /// \brief Bitwise OR with integral types
 template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline ZNumber operator|(const ZNumber& lhs, T rhs) {
-  return ZNumber(lhs.mpz() | detail::MpzAdapter< T >()(rhs));
+  ZNumber r(lhs);
+  r |= rhs;
+  return r;
 }
 
 /// \brief Bitwise OR with integral types
 template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline ZNumber operator|(T lhs, const ZNumber& rhs) {
-  return ZNumber(detail::MpzAdapter< T >()(lhs) | rhs.mpz());
+  ZNumber r(lhs);
+  r |= rhs;
+  return r;
 }
 
 /// \brief Bitwise XOR
 inline ZNumber operator^(const ZNumber& lhs, const ZNumber& rhs) {
-  return ZNumber(lhs.mpz() ^ rhs.mpz());
+  ZNumber r(lhs);
+  r ^= rhs;
+  return r;
 }
 
 /// \brief Bitwise XOR with integral types
 template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline ZNumber operator^(const ZNumber& lhs, T rhs) {
-  return ZNumber(lhs.mpz() ^ detail::MpzAdapter< T >()(rhs));
+  ZNumber r(lhs);
+  r ^= rhs;
+  return r;
 }
 
 /// \brief Bitwise XOR with integral types
 template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline ZNumber operator^(T lhs, const ZNumber& rhs) {
-  return ZNumber(detail::MpzAdapter< T >()(lhs) ^ rhs.mpz());
+  ZNumber r(lhs);
+  r ^= rhs;
+  return r;
 }
 
 /// \brief Left binary shift
 ///
 /// This is undefined if `rhs` isn't between 0 and 2**32 - 1
 inline ZNumber operator<<(const ZNumber& lhs, const ZNumber& rhs) {
-  ikos_assert_msg(rhs.mpz() >= 0, "shift count is negative");
-  ikos_assert_msg(rhs.mpz().fits_ulong_p(), "shift count is too big");
-  return ZNumber(lhs.mpz() << rhs.mpz().get_ui());
+  ZNumber r(lhs);
+  r <<= rhs;
+  return r;
 }
 
 /// \brief Left binary shift with integral types
@@ -876,8 +1301,9 @@ inline ZNumber operator<<(const ZNumber& lhs, const ZNumber& rhs) {
 template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline ZNumber operator<<(const ZNumber& lhs, T rhs) {
-  ikos_assert_msg(rhs >= 0, "shift count is negative");
-  return ZNumber(lhs.mpz() << static_cast< unsigned long int >(rhs));
+  ZNumber r(lhs);
+  r <<= rhs;
+  return r;
 }
 
 /// \brief Left binary shift with integral types
@@ -895,9 +1321,9 @@ inline ZNumber operator<<(T lhs, const ZNumber& rhs) {
 ///
 /// This is undefined if `rhs` isn't between 0 and 2**32 - 1
 inline ZNumber operator>>(const ZNumber& lhs, const ZNumber& rhs) {
-  ikos_assert_msg(rhs.mpz() >= 0, "shift count is negative");
-  ikos_assert_msg(rhs.mpz().fits_ulong_p(), "shift count is too big");
-  return ZNumber(lhs.mpz() >> rhs.mpz().get_ui());
+  ZNumber r(lhs);
+  r >>= rhs;
+  return r;
 }
 
 /// \brief Right binary shift with integral types
@@ -906,8 +1332,9 @@ inline ZNumber operator>>(const ZNumber& lhs, const ZNumber& rhs) {
 template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline ZNumber operator>>(const ZNumber& lhs, T rhs) {
-  ikos_assert_msg(rhs >= 0, "shift count is negative");
-  return ZNumber(lhs.mpz() >> static_cast< unsigned long int >(rhs));
+  ZNumber r(lhs);
+  r >>= rhs;
+  return r;
 }
 
 /// \brief Right binary shift with integral types
@@ -927,116 +1354,133 @@ inline ZNumber operator>>(T lhs, const ZNumber& rhs) {
 
 /// \brief Equality operator
 inline bool operator==(const ZNumber& lhs, const ZNumber& rhs) {
-  return lhs.mpz() == rhs.mpz();
+  if (lhs.is_small() && rhs.is_small()) {
+    return lhs._n.i == rhs._n.i;
+  } else if (lhs.is_large() && rhs.is_large()) {
+    return *lhs._n.p == *rhs._n.p;
+  } else {
+    // The representation is canonical
+    return false;
+  }
 }
 
 /// \brief Equality operator with integral types
 template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline bool operator==(const ZNumber& lhs, T rhs) {
-  return lhs.mpz() == detail::MpzAdapter< T >()(rhs);
+  return lhs == ZNumber(rhs);
 }
 
 /// \brief Equality operator with integral types
 template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline bool operator==(T lhs, const ZNumber& rhs) {
-  return detail::MpzAdapter< T >()(lhs) == rhs.mpz();
+  return ZNumber(lhs) == rhs;
 }
 
 /// \brief Inequality operator
 inline bool operator!=(const ZNumber& lhs, const ZNumber& rhs) {
-  return lhs.mpz() != rhs.mpz();
+  return !(lhs == rhs);
 }
 
 /// \brief Inequality operator with integral types
 template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline bool operator!=(const ZNumber& lhs, T rhs) {
-  return lhs.mpz() != detail::MpzAdapter< T >()(rhs);
+  return !(lhs == ZNumber(rhs));
 }
 
 /// \brief Inequality operator with integral types
 template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline bool operator!=(T lhs, const ZNumber& rhs) {
-  return detail::MpzAdapter< T >()(lhs) != rhs.mpz();
+  return !(ZNumber(lhs) == rhs);
 }
 
 /// \brief Less than comparison
 inline bool operator<(const ZNumber& lhs, const ZNumber& rhs) {
-  return lhs.mpz() < rhs.mpz();
+  if (lhs.is_small() && rhs.is_small()) {
+    return lhs._n.i < rhs._n.i;
+  } else if (lhs.is_large() && rhs.is_large()) {
+    return *lhs._n.p < *rhs._n.p;
+  } else if (lhs.is_small()) {
+    // rhs does not fit in a int64_t
+    return sgn(*rhs._n.p) > 0;
+  } else {
+    // lhs does not fit in a int64_t
+    return sgn(*lhs._n.p) < 0;
+  }
 }
 
 /// \brief Less than comparison with integral types
 template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline bool operator<(const ZNumber& lhs, T rhs) {
-  return lhs.mpz() < detail::MpzAdapter< T >()(rhs);
+  return lhs < ZNumber(rhs);
 }
 
 /// \brief Less than comparison with integral types
 template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline bool operator<(T lhs, const ZNumber& rhs) {
-  return detail::MpzAdapter< T >()(lhs) < rhs.mpz();
+  return ZNumber(lhs) < rhs;
 }
 
 /// \brief Less or equal comparison
 inline bool operator<=(const ZNumber& lhs, const ZNumber& rhs) {
-  return lhs.mpz() <= rhs.mpz();
+  return !(rhs < lhs);
 }
 
 /// \brief Less or equal comparison with integral types
 template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline bool operator<=(const ZNumber& lhs, T rhs) {
-  return lhs.mpz() <= detail::MpzAdapter< T >()(rhs);
+  return !(ZNumber(rhs) < lhs);
 }
 
 /// \brief Less or equal comparison with integral types
 template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline bool operator<=(T lhs, const ZNumber& rhs) {
-  return detail::MpzAdapter< T >()(lhs) <= rhs.mpz();
+  return !(rhs < ZNumber(lhs));
 }
 
 /// \brief Greater than comparison
 inline bool operator>(const ZNumber& lhs, const ZNumber& rhs) {
-  return lhs.mpz() > rhs.mpz();
+  return rhs < lhs;
 }
 
 /// \brief Greater than comparison with integral types
 template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline bool operator>(const ZNumber& lhs, T rhs) {
-  return lhs.mpz() > detail::MpzAdapter< T >()(rhs);
+  return ZNumber(rhs) < lhs;
 }
 
 /// \brief Greater than comparison with integral types
 template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline bool operator>(T lhs, const ZNumber& rhs) {
-  return detail::MpzAdapter< T >()(lhs) > rhs.mpz();
+  return rhs < ZNumber(lhs);
 }
 
 /// \brief Greater or equal comparison
 inline bool operator>=(const ZNumber& lhs, const ZNumber& rhs) {
-  return lhs.mpz() >= rhs.mpz();
+  return !(lhs < rhs);
 }
 
 /// \brief Greater or equal comparison with integral types
 template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline bool operator>=(const ZNumber& lhs, T rhs) {
-  return lhs.mpz() >= detail::MpzAdapter< T >()(rhs);
+  return !(lhs < ZNumber(rhs));
 }
 
 /// \brief Greater or equal comparison with integral types
 template < typename T,
            class = std::enable_if_t< IsSupportedIntegral< T >::value > >
 inline bool operator>=(T lhs, const ZNumber& rhs) {
-  return detail::MpzAdapter< T >()(lhs) >= rhs.mpz();
+  return !(ZNumber(lhs) < rhs);
 }
 
 /// @}
@@ -1090,15 +1534,28 @@ inline const ZNumber& max(const ZNumber& a,
 ///
 /// The sign of `d` is ignored, and the result is always non-negative.
 inline ZNumber mod(const ZNumber& n, const ZNumber& d) {
-  ikos_assert_msg(d.mpz() != 0, "division by zero");
-  ZNumber r;
-  mpz_mod(r._n.get_mpz_t(), n._n.get_mpz_t(), d._n.get_mpz_t());
-  return r;
+  ikos_assert_msg(d != 0, "division by zero");
+  if (n.is_small() && d.is_small() &&
+      d._n.i != std::numeric_limits< int64_t >::min()) {
+    if (d._n.i == -1) {
+      return ZNumber(0);
+    }
+    int64_t r = n._n.i % d._n.i;
+    if (r < 0) {
+      r += (d._n.i < 0) ? -d._n.i : d._n.i;
+    }
+    return ZNumber(r);
+  }
+  mpz_class r;
+  mpz_class m = n.mpz();
+  mpz_class e = d.mpz();
+  mpz_mod(r.get_mpz_t(), m.get_mpz_t(), e.get_mpz_t());
+  return ZNumber(std::move(r));
 }
 
 /// \brief Return the absolute value of the given number
 inline ZNumber abs(const ZNumber& n) {
-  return ZNumber(abs(n.mpz()));
+  return (n < 0) ? -n : n;
 }
 
 /// \brief Return the greatest common divisor of the given numbers
@@ -1107,9 +1564,16 @@ inline ZNumber abs(const ZNumber& n) {
 /// negative. Except if both inputs are zero; then this function defines
 /// `gcd(0, 0) = 0`.
 inline ZNumber gcd(const ZNumber& a, const ZNumber& b) {
-  ZNumber r;
-  mpz_gcd(r._n.get_mpz_t(), a._n.get_mpz_t(), b._n.get_mpz_t());
-  return r;
+  if (a.is_small() && b.is_small()) {
+    uint64_t r = detail::gcd_uint64(detail::abs_uint64(a._n.i),
+                                    detail::abs_uint64(b._n.i));
+    return ZNumber(r);
+  }
+  mpz_class r;
+  mpz_class m = a.mpz();
+  mpz_class e = b.mpz();
+  mpz_gcd(r.get_mpz_t(), m.get_mpz_t(), e.get_mpz_t());
+  return ZNumber(std::move(r));
 }
 
 /// \brief Return the greatest common divisor of the given numbers
@@ -1119,9 +1583,22 @@ inline ZNumber gcd(const ZNumber& a, const ZNumber& b, const ZNumber& c) {
 
 /// \brief Return the least common multiple of the given numbers
 inline ZNumber lcm(const ZNumber& a, const ZNumber& b) {
-  ZNumber r;
-  mpz_lcm(r._n.get_mpz_t(), a._n.get_mpz_t(), b._n.get_mpz_t());
-  return r;
+  if (a.is_small() && b.is_small()) {
+    if (a._n.i == 0 || b._n.i == 0) {
+      return ZNumber(0);
+    }
+    uint64_t x = detail::abs_uint64(a._n.i);
+    uint64_t y = detail::abs_uint64(b._n.i);
+    uint64_t q = x / detail::gcd_uint64(x, y);
+    if (q <= std::numeric_limits< uint64_t >::max() / y) {
+      return ZNumber(q * y);
+    }
+  }
+  mpz_class r;
+  mpz_class m = a.mpz();
+  mpz_class e = b.mpz();
+  mpz_lcm(r.get_mpz_t(), m.get_mpz_t(), e.get_mpz_t());
+  return ZNumber(std::move(r));
 }
 
 /// \brief Run Euclid's algorithm
@@ -1132,11 +1609,19 @@ inline ZNumber lcm(const ZNumber& a, const ZNumber& b) {
 /// negative (or zero if both inputs are zero).
 inline void gcd_extended(
     const ZNumber& a, const ZNumber& b, ZNumber& g, ZNumber& u, ZNumber& v) {
-  mpz_gcdext(g._n.get_mpz_t(),
-             u._n.get_mpz_t(),
-             v._n.get_mpz_t(),
-             a._n.get_mpz_t(),
-             b._n.get_mpz_t());
+  mpz_class m = a.mpz();
+  mpz_class e = b.mpz();
+  mpz_class g_n;
+  mpz_class u_n;
+  mpz_class v_n;
+  mpz_gcdext(g_n.get_mpz_t(),
+             u_n.get_mpz_t(),
+             v_n.get_mpz_t(),
+             m.get_mpz_t(),
+             e.get_mpz_t());
+  g = ZNumber(std::move(g_n));
+  u = ZNumber(std::move(u_n));
+  v = ZNumber(std::move(v_n));
 }
 
 /// @}
@@ -1145,13 +1630,20 @@ inline void gcd_extended(
 
 /// \brief Write a ZNumber on a stream, in base 10
 inline std::ostream& operator<<(std::ostream& o, const ZNumber& n) {
-  o << n.mpz();
+  if (n.is_small() &&
+      (o.flags() & std::ios_base::basefield) == std::ios_base::dec) {
+    o << n._n.i;
+  } else {
+    o << n.mpz();
+  }
   return o;
 }
 
 /// \brief Read a ZNumber from a stream, in base 10
 inline std::istream& operator>>(std::istream& i, ZNumber& n) {
-  i >> n._n;
+  mpz_class m;
+  i >> m;
+  n = ZNumber(std::move(m));
   return i;
 }
 
@@ -1159,7 +1651,10 @@ inline std::istream& operator>>(std::istream& i, ZNumber& n) {
 
 /// \brief Return the hash of a ZNumber
 inline std::size_t hash_value(const ZNumber& n) {
-  const mpz_class& m = n.mpz();
+  if (n.is_small()) {
+    return boost::hash_value(n._n.i);
+  }
+  const mpz_class& m = *n._n.p;
   std::size_t result = 0;
   boost::hash_combine(result, m.get_mpz_t()[0]._mp_size);
   for (int i = 0, e = std::abs(m.get_mpz_t()[0]._mp_size); i < e; ++i) {
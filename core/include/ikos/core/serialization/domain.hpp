@@ -0,0 +1,469 @@
+/*******************************************************************************
+ *
+ * \file
+ * \brief Serialization of abstract domains
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <ikos/core/adt/patricia_tree/map.hpp>
+#include <ikos/core/adt/patricia_tree/set.hpp>
+#include <ikos/core/domain/lifetime/separate_domain.hpp>
+#include <ikos/core/domain/machine_int/congruence.hpp>
+#include <ikos/core/domain/machine_int/interval.hpp>
+#include <ikos/core/domain/machine_int/interval_congruence.hpp>
+#include <ikos/core/domain/machine_int/numeric_domain_adapter.hpp>
+#include <ikos/core/domain/machine_int/polymorphic_domain.hpp>
+#include <ikos/core/domain/nullity/separate_domain.hpp>
+#include <ikos/core/domain/numeric/congruence.hpp>
+#include <ikos/core/domain/numeric/constant.hpp>
+#include <ikos/core/domain/numeric/dbm.hpp>
+#include <ikos/core/domain/numeric/gauge.hpp>
+#include <ikos/core/domain/numeric/interval.hpp>
+#include <ikos/core/domain/numeric/interval_congruence.hpp>
+#include <ikos/core/domain/numeric/octagon.hpp>
+#include <ikos/core/domain/numeric/separate_domain.hpp>
+#include <ikos/core/domain/numeric/split_dbm.hpp>
+#include <ikos/core/domain/separate_domain.hpp>
+#include <ikos/core/domain/uninitialized/separate_domain.hpp>
+#include <ikos/core/linear_constraint.hpp>
+#include <ikos/core/serialization/value.hpp>
+
+namespace ikos {
+namespace core {
+namespace serialization {
+
+/// \brief Serializer for PatriciaTreeMap
+template < typename Key, typename Value >
+struct Serializer< PatriciaTreeMap< Key, Value > > {
+  using PatriciaTreeMapT = PatriciaTreeMap< Key, Value >;
+
+  static void write(Encoder& e, const PatriciaTreeMapT& map) {
+    e.write_varint(map.size());
+    for (const auto& binding : map) {
+      e.write_ref(binding.first);
+      Serializer< Value >::write(e, binding.second);
+    }
+  }
+
+  template < typename Resolver >
+  static PatriciaTreeMapT read(Decoder& d, Resolver& resolve) {
+    PatriciaTreeMapT map;
+    for (uint64_t n = d.read_varint(); n > 0; --n) {
+      auto key = d.read_ref< Key >(resolve);
+      map.insert_or_assign(key, Serializer< Value >::read(d, resolve));
+    }
+    return map;
+  }
+};
+
+/// \brief Serializer for PatriciaTreeSet
+template < typename Key >
+struct Serializer< PatriciaTreeSet< Key > > {
+  using PatriciaTreeSetT = PatriciaTreeSet< Key >;
+
+  static void write(Encoder& e, const PatriciaTreeSetT& set) {
+    e.write_varint(set.size());
+    for (const auto& key : set) {
+      e.write_ref(key);
+    }
+  }
+
+  template < typename Resolver >
+  static PatriciaTreeSetT read(Decoder& d, Resolver& resolve) {
+    PatriciaTreeSetT set;
+    for (uint64_t n = d.read_varint(); n > 0; --n) {
+      set.insert(d.read_ref< Key >(resolve));
+    }
+    return set;
+  }
+};
+
+/// \brief Serializer for domains mapping keys to non-relational values
+///
+/// The domain is encoded as a bottom flag followed by the list of non-top
+/// (key, value) bindings. Domain should provide top(), bottom(), is_bottom(),
+/// begin(), end() and set(key, value).
+template < typename Domain, typename Key, typename Value >
+struct SeparateDomainSerializer {
+  static void write(Encoder& e, const Domain& inv) {
+    e.write_bool(inv.is_bottom());
+    if (inv.is_bottom()) {
+      return;
+    }
+    uint64_t size = 0;
+    for (auto it = inv.begin(), et = inv.end(); it != et; ++it) {
+      size++;
+    }
+    e.write_varint(size);
+    for (auto it = inv.begin(), et = inv.end(); it != et; ++it) {
+      e.write_ref(it->first);
+      Serializer< Value >::write(e, it->second);
+    }
+  }
+
+  template < typename Resolver >
+  static Domain read(Decoder& d, Resolver& resolve) {
+    if (d.read_bool()) {
+      return Domain::bottom();
+    }
+    Domain inv = Domain::top();
+    for (uint64_t n = d.read_varint(); n > 0; --n) {
+      auto key = d.read_ref< Key >(resolve);
+      inv.set(key, Serializer< Value >::read(d, resolve));
+    }
+    return inv;
+  }
+};
+
+/// \brief Serializer for core::SeparateDomain
+template < typename Key, typename Value >
+struct Serializer< SeparateDomain< Key, Value > >
+    : SeparateDomainSerializer< SeparateDomain< Key, Value >, Key, Value > {};
+
+/// \brief Serializer for numeric::SeparateDomain
+template < typename Number, typename VariableRef, typename Value >
+struct Serializer< numeric::SeparateDomain< Number, VariableRef, Value > >
+    : SeparateDomainSerializer<
+          numeric::SeparateDomain< Number, VariableRef, Value >,
+          VariableRef,
+          Value > {};
+
+/// \brief Serializer for numeric::IntervalDomain
+template < typename Number, typename VariableRef, std::size_t MaxCycles >
+struct Serializer< numeric::IntervalDomain< Number, VariableRef, MaxCycles > >
+    : SeparateDomainSerializer<
+          numeric::IntervalDomain< Number, VariableRef, MaxCycles >,
+          VariableRef,
+          numeric::Interval< Number > > {};
+
+/// \brief Serializer for numeric::CongruenceDomain
+template < typename Number, typename VariableRef, std::size_t MaxCycles >
+struct Serializer<
+    numeric::CongruenceDomain< Number, VariableRef, MaxCycles > >
+    : SeparateDomainSerializer<
+          numeric::CongruenceDomain< Number, VariableRef, MaxCycles >,
+          VariableRef,
+          numeric::Congruence< Number > > {};
+
+/// \brief Serializer for numeric::IntervalCongruenceDomain
+template < typename Number, typename VariableRef, std::size_t MaxCycles >
+struct Serializer<
+    numeric::IntervalCongruenceDomain< Number, VariableRef, MaxCycles > >
+    : SeparateDomainSerializer<
+          numeric::IntervalCongruenceDomain< Number, VariableRef, MaxCycles >,
+          VariableRef,
+          numeric::IntervalCongruence< Number > > {};
+
+/// \brief Serializer for numeric::ConstantDomain
+template < typename Number, typename VariableRef, std::size_t MaxCycles >
+struct Serializer<
+    numeric::ConstantDomain< Number, VariableRef, MaxCycles > >
+    : SeparateDomainSerializer<
+          numeric::ConstantDomain< Number, VariableRef, MaxCycles >,
+          VariableRef,
+          numeric::Constant< Number > > {};
+
+/// \brief Serializer for machine_int::IntervalDomain
+template < typename VariableRef >
+struct Serializer< machine_int::IntervalDomain< VariableRef > >
+    : SeparateDomainSerializer< machine_int::IntervalDomain< VariableRef >,
+                                VariableRef,
+                                machine_int::Interval > {};
+
+/// \brief Serializer for machine_int::CongruenceDomain
+template < typename VariableRef >
+struct Serializer< machine_int::CongruenceDomain< VariableRef > >
+    : SeparateDomainSerializer< machine_int::CongruenceDomain< VariableRef >,
+                                VariableRef,
+                                machine_int::Congruence > {};
+
+/// \brief Serializer for machine_int::IntervalCongruenceDomain
+template < typename VariableRef >
+struct Serializer< machine_int::IntervalCongruenceDomain< VariableRef > >
+    : SeparateDomainSerializer<
+          machine_int::IntervalCongruenceDomain< VariableRef >,
+          VariableRef,
+          machine_int::IntervalCongruence > {};
+
+/// \brief Serializer for nullity::SeparateDomain
+template < typename VariableRef >
+struct Serializer< nullity::SeparateDomain< VariableRef > >
+    : SeparateDomainSerializer< nullity::SeparateDomain< VariableRef >,
+                                VariableRef,
+                                Nullity > {};
+
+/// \brief Serializer for uninitialized::SeparateDomain
+template < typename VariableRef >
+struct Serializer< uninitialized::SeparateDomain< VariableRef > >
+    : SeparateDomainSerializer< uninitialized::SeparateDomain< VariableRef >,
+                                VariableRef,
+                                Uninitialized > {};
+
+/// \brief Serializer for lifetime::SeparateDomain
+template < typename MemoryLocationRef >
+struct Serializer< lifetime::SeparateDomain< MemoryLocationRef > >
+    : SeparateDomainSerializer< lifetime::SeparateDomain< MemoryLocationRef >,
+                                MemoryLocationRef,
+                                Lifetime > {};
+
+/// \brief Serializer for LinearConstraint
+template < typename Number, typename VariableRef >
+struct Serializer< LinearConstraint< Number, VariableRef > > {
+  using LinearConstraintT = LinearConstraint< Number, VariableRef >;
+  using LinearExpressionT = LinearExpression< Number, VariableRef >;
+
+  static void write(Encoder& e, const LinearConstraintT& cst) {
+    e.write_byte(static_cast< uint8_t >(cst.kind()));
+    Serializer< Number >::write(e, cst.expression().constant());
+    e.write_varint(cst.num_terms());
+    for (const auto& term : cst) {
+      e.write_ref(term.first);
+      Serializer< Number >::write(e, term.second);
+    }
+  }
+
+  template < typename Resolver >
+  static LinearConstraintT read(Decoder& d, Resolver& resolve) {
+    uint8_t kind = d.read_byte();
+    if (kind != LinearConstraintT::Equality &&
+        kind != LinearConstraintT::Disequation &&
+        kind != LinearConstraintT::Inequality) {
+      throw SerializationError("serialization: invalid constraint kind");
+    }
+    LinearExpressionT expr(Serializer< Number >::read(d, resolve));
+    for (uint64_t n = d.read_varint(); n > 0; --n) {
+      auto v = d.read_ref< VariableRef >(resolve);
+      expr.add(Serializer< Number >::read(d, resolve), v);
+    }
+    return LinearConstraintT(std::move(expr),
+                             static_cast< typename LinearConstraintT::Kind >(
+                                 kind));
+  }
+};
+
+/// \brief Serializer for LinearConstraintSystem
+template < typename Number, typename VariableRef >
+struct Serializer< LinearConstraintSystem< Number, VariableRef > > {
+  using LinearConstraintSystemT = LinearConstraintSystem< Number, VariableRef >;
+  using ConstraintSerializer =
+      Serializer< LinearConstraint< Number, VariableRef > >;
+
+  static void write(Encoder& e, const LinearConstraintSystemT& csts) {
+    e.write_varint(csts.size());
+    for (const auto& cst : csts) {
+      ConstraintSerializer::write(e, cst);
+    }
+  }
+
+  template < typename Resolver >
+  static LinearConstraintSystemT read(Decoder& d, Resolver& resolve) {
+    LinearConstraintSystemT csts;
+    for (uint64_t n = d.read_varint(); n > 0; --n) {
+      csts.add(ConstraintSerializer::read(d, resolve));
+    }
+    return csts;
+  }
+};
+
+/// \brief Serializer for relational numeric domains
+///
+/// The domain is encoded as a bottom flag followed by the system of linear
+/// constraints it represents, and decoded by adding the constraints to top.
+/// This is exact for domains that are closed under their constraints, such as
+/// difference-bound matrices and octagons.
+template < typename Domain, typename Number, typename VariableRef >
+struct RelationalDomainSerializer {
+  using ConstraintSystemSerializer =
+      Serializer< LinearConstraintSystem< Number, VariableRef > >;
+
+  static void write(Encoder& e, const Domain& inv) {
+    e.write_bool(inv.is_bottom());
+    if (!inv.is_bottom()) {
+      ConstraintSystemSerializer::write(e, inv.to_linear_constraint_system());
+    }
+  }
+
+  template < typename Resolver >
+  static Domain read(Decoder& d, Resolver& resolve) {
+    if (d.read_bool()) {
+      return Domain::bottom();
+    }
+    Domain inv = Domain::top();
+    inv.add(ConstraintSystemSerializer::read(d, resolve));
+    return inv;
+  }
+};
+
+/// \brief Serializer for numeric::DBM
+template < typename Number, typename VariableRef, std::size_t MaxCycles >
+struct Serializer< numeric::DBM< Number, VariableRef, MaxCycles > >
+    : RelationalDomainSerializer<
+          numeric::DBM< Number, VariableRef, MaxCycles >,
+          Number,
+          VariableRef > {};
+
+/// \brief Serializer for numeric::SplitDBM
+template < typename Number, typename VariableRef, std::size_t MaxCycles >
+struct Serializer< numeric::SplitDBM< Number, VariableRef, MaxCycles > >
+    : RelationalDomainSerializer<
+          numeric::SplitDBM< Number, VariableRef, MaxCycles >,
+          Number,
+          VariableRef > {};
+
+/// \brief Serializer for numeric::Octagon
+template < typename Number, typename VariableRef >
+struct Serializer< numeric::Octagon< Number, VariableRef > >
+    : RelationalDomainSerializer< numeric::Octagon< Number, VariableRef >,
+                                  Number,
+                                  VariableRef > {};
+
+/// \brief Serializer for numeric::GaugeSemiLattice
+template < typename Number, typename VariableRef >
+struct Serializer< numeric::GaugeSemiLattice< Number, VariableRef > > {
+  using GaugeSemiLatticeT = numeric::GaugeSemiLattice< Number, VariableRef >;
+  using GaugeT = numeric::Gauge< Number, VariableRef >;
+  using MapSerializer = Serializer< PatriciaTreeMap< VariableRef, GaugeT > >;
+
+  static void write(Encoder& e, const GaugeSemiLatticeT& inv) {
+    e.write_bool(inv.is_bottom());
+    if (!inv.is_bottom()) {
+      MapSerializer::write(e, inv._tree);
+    }
+  }
+
+  template < typename Resolver >
+  static GaugeSemiLatticeT read(Decoder& d, Resolver& resolve) {
+    if (d.read_bool()) {
+      return GaugeSemiLatticeT::bottom();
+    }
+    GaugeSemiLatticeT inv = GaugeSemiLatticeT::top();
+    for (const auto& binding : MapSerializer::read(d, resolve)) {
+      inv.set(binding.first, binding.second);
+    }
+    return inv;
+  }
+};
+
+/// \brief Serializer for numeric::GaugeDomain
+///
+/// The domain is encoded as a bottom flag followed by its sections, gauges,
+/// loop counters and intervals.
+template < typename Number, typename VariableRef >
+struct Serializer< numeric::GaugeDomain< Number, VariableRef > > {
+  using GaugeDomainT = numeric::GaugeDomain< Number, VariableRef >;
+  using SectionSerializer =
+      Serializer< typename GaugeDomainT::SectionDomainT >;
+  using GaugeSerializer =
+      Serializer< typename GaugeDomainT::GaugeSemiLatticeT >;
+  using CounterSerializer = Serializer< typename GaugeDomainT::CounterSetT >;
+  using IntervalSerializer =
+      Serializer< typename GaugeDomainT::IntervalDomainT >;
+
+  static void write(Encoder& e, const GaugeDomainT& inv) {
+    e.write_bool(inv.is_bottom());
+    if (!inv.is_bottom()) {
+      SectionSerializer::write(e, inv._sections);
+      GaugeSerializer::write(e, inv._gauges);
+      CounterSerializer::write(e, inv._counters);
+      IntervalSerializer::write(e, inv._intervals);
+    }
+  }
+
+  template < typename Resolver >
+  static GaugeDomainT read(Decoder& d, Resolver& resolve) {
+    if (d.read_bool()) {
+      return GaugeDomainT::bottom();
+    }
+    GaugeDomainT inv = GaugeDomainT::top();
+    inv._sections = SectionSerializer::read(d, resolve);
+    inv._gauges = GaugeSerializer::read(d, resolve);
+    inv._counters = CounterSerializer::read(d, resolve);
+    inv._intervals = IntervalSerializer::read(d, resolve);
+    inv.normalize();
+    return inv;
+  }
+};
+
+/// \brief Serializer for machine_int::NumericDomainAdapter
+///
+/// This is only defined if the underlying numeric domain is serializable.
+template < typename VariableRef, typename NumDomain >
+struct Serializer<
+    machine_int::NumericDomainAdapter< VariableRef, NumDomain >,
+    std::enable_if_t< IsSerializable< NumDomain >::value > > {
+  using NumericDomainAdapterT =
+      machine_int::NumericDomainAdapter< VariableRef, NumDomain >;
+
+  static void write(Encoder& e, const NumericDomainAdapterT& inv) {
+    Serializer< NumDomain >::write(e, inv._inv);
+  }
+
+  template < typename Resolver >
+  static NumericDomainAdapterT read(Decoder& d, Resolver& resolve) {
+    return NumericDomainAdapterT(Serializer< NumDomain >::read(d, resolve));
+  }
+};
+
+/// \brief Serializer for machine_int::PolymorphicDomain
+///
+/// The runtime domain is not encoded, so the value must be decoded with a
+/// prototype of the same runtime domain. Throws a SerializationError if the
+/// runtime domain is not serializable.
+template < typename VariableRef >
+struct Serializer< machine_int::PolymorphicDomain< VariableRef > > {
+  using PolymorphicDomainT = machine_int::PolymorphicDomain< VariableRef >;
+
+  static void write(Encoder& e, const PolymorphicDomainT& inv) {
+    inv._ptr->serialize(e);
+  }
+
+  template < typename Resolver >
+  static PolymorphicDomainT read(Decoder& d,
+                                 Resolver& resolve,
+                                 const PolymorphicDomainT& prototype) {
+    typename PolymorphicDomainT::ResolverT erased(resolve);
+    return PolymorphicDomainT(prototype._ptr->deserialize(d, erased));
+  }
+};
+
+} // end namespace serialization
+} // end namespace core
+} // end namespace ikos
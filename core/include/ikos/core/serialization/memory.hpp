@@ -0,0 +1,241 @@
+/*******************************************************************************
+ *
+ * \file
+ * \brief Serialization of scalar and memory abstract domains
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <ikos/core/domain/exception/exception.hpp>
+#include <ikos/core/domain/memory/polymorphic_domain.hpp>
+#include <ikos/core/domain/memory/value.hpp>
+#include <ikos/core/domain/memory/value/cell_set.hpp>
+#include <ikos/core/domain/memory/value/mem_loc_to_pointer_set.hpp>
+#include <ikos/core/domain/scalar/composite.hpp>
+#include <ikos/core/serialization/domain.hpp>
+#include <ikos/core/support/mpl.hpp>
+
+namespace ikos {
+namespace core {
+namespace serialization {
+
+/// \brief Serializer for memory::CellSet
+template < typename VariableRef >
+struct Serializer< memory::CellSet< VariableRef > > {
+  using CellSetT = memory::CellSet< VariableRef >;
+
+  static void write(Encoder& e, const CellSetT& cells) {
+    e.write_varint(cells.size());
+    for (VariableRef cell : cells) {
+      e.write_ref(cell);
+    }
+  }
+
+  template < typename Resolver >
+  static CellSetT read(Decoder& d, Resolver& resolve) {
+    CellSetT cells = CellSetT::empty();
+    for (uint64_t n = d.read_varint(); n > 0; --n) {
+      cells.add(d.read_ref< VariableRef >(resolve));
+    }
+    return cells;
+  }
+};
+
+/// \brief Serializer for memory::MemLocToPointerSet
+template < typename MemoryLocationRef >
+struct Serializer< memory::MemLocToPointerSet< MemoryLocationRef > >
+    : SeparateDomainSerializer<
+          memory::MemLocToPointerSet< MemoryLocationRef >,
+          MemoryLocationRef,
+          PointerSet< MemoryLocationRef > > {};
+
+/// \brief Serializer for scalar::CompositeDomain
+///
+/// The value is decoded with a prototype, which provides the runtime domains
+/// of the underlying polymorphic domains, if any.
+template < typename VariableRef,
+           typename MemoryLocationRef,
+           typename UninitializedDomain,
+           typename MachineIntDomain,
+           typename NullityDomain >
+struct Serializer<
+    scalar::CompositeDomain< VariableRef,
+                             MemoryLocationRef,
+                             UninitializedDomain,
+                             MachineIntDomain,
+                             NullityDomain >,
+    std::enable_if_t< conjunction< IsSerializable< UninitializedDomain >,
+                                   IsSerializable< MachineIntDomain >,
+                                   IsSerializable< NullityDomain > >::value > > {
+  using CompositeDomainT = scalar::CompositeDomain< VariableRef,
+                                                    MemoryLocationRef,
+                                                    UninitializedDomain,
+                                                    MachineIntDomain,
+                                                    NullityDomain >;
+  using PointsToMapSerializer =
+      Serializer< typename CompositeDomainT::PointsToMap >;
+
+  static void write(Encoder& e, const CompositeDomainT& inv) {
+    Serializer< UninitializedDomain >::write(e, inv._uninitialized);
+    Serializer< MachineIntDomain >::write(e, inv._integer);
+    Serializer< NullityDomain >::write(e, inv._nullity);
+    PointsToMapSerializer::write(e, inv._points_to_map);
+  }
+
+  template < typename Resolver >
+  static CompositeDomainT read(Decoder& d,
+                               Resolver& resolve,
+                               const CompositeDomainT& prototype) {
+    auto uninitialized = read_like(d, resolve, prototype._uninitialized);
+    auto integer = read_like(d, resolve, prototype._integer);
+    auto nullity = read_like(d, resolve, prototype._nullity);
+    auto points_to_map = PointsToMapSerializer::read(d, resolve);
+    return CompositeDomainT(std::move(uninitialized),
+                            std::move(integer),
+                            std::move(nullity),
+                            std::move(points_to_map));
+  }
+};
+
+/// \brief Serializer for memory::ValueDomain
+///
+/// The cell factory is not encoded: the value is decoded with a prototype,
+/// which provides the cell factory and the runtime domains of the underlying
+/// polymorphic domains, if any.
+template < typename VariableRef,
+           typename MemoryLocationRef,
+           typename CellFactoryRef,
+           typename ScalarDomain,
+           typename LifetimeDomain >
+struct Serializer<
+    memory::ValueDomain< VariableRef,
+                         MemoryLocationRef,
+                         CellFactoryRef,
+                         ScalarDomain,
+                         LifetimeDomain >,
+    std::enable_if_t< conjunction< IsSerializable< ScalarDomain >,
+                                   IsSerializable< LifetimeDomain > >::value > > {
+  using ValueDomainT = memory::ValueDomain< VariableRef,
+                                            MemoryLocationRef,
+                                            CellFactoryRef,
+                                            ScalarDomain,
+                                            LifetimeDomain >;
+  using CellsSerializer = Serializer< typename ValueDomainT::MemLocToCellSetT >;
+  using PointerSetsSerializer =
+      Serializer< typename ValueDomainT::MemLocToPointerSetT >;
+
+  static void write(Encoder& e, const ValueDomainT& inv) {
+    Serializer< ScalarDomain >::write(e, inv._scalar);
+    CellsSerializer::write(e, inv._cells);
+    PointerSetsSerializer::write(e, inv._pointer_sets);
+    Serializer< LifetimeDomain >::write(e, inv._lifetime);
+  }
+
+  template < typename Resolver >
+  static ValueDomainT read(Decoder& d,
+                           Resolver& resolve,
+                           const ValueDomainT& prototype) {
+    auto scalar = read_like(d, resolve, prototype._scalar);
+    auto cells = CellsSerializer::read(d, resolve);
+    auto pointer_sets = PointerSetsSerializer::read(d, resolve);
+    auto lifetime = read_like(d, resolve, prototype._lifetime);
+    return ValueDomainT(prototype._cell_factory,
+                        std::move(scalar),
+                        std::move(cells),
+                        std::move(pointer_sets),
+                        std::move(lifetime));
+  }
+};
+
+/// \brief Serializer for memory::PolymorphicDomain
+///
+/// The runtime domain is not encoded, so the value must be decoded with a
+/// prototype of the same runtime domain. Throws a SerializationError if the
+/// runtime domain is not serializable.
+template < typename VariableRef, typename MemoryLocationRef >
+struct Serializer< memory::PolymorphicDomain< VariableRef, MemoryLocationRef > > {
+  using PolymorphicDomainT =
+      memory::PolymorphicDomain< VariableRef, MemoryLocationRef >;
+
+  static void write(Encoder& e, const PolymorphicDomainT& inv) {
+    inv._ptr->serialize(e);
+  }
+
+  template < typename Resolver >
+  static PolymorphicDomainT read(Decoder& d,
+                                 Resolver& resolve,
+                                 const PolymorphicDomainT& prototype) {
+    typename PolymorphicDomainT::ResolverT erased(resolve);
+    return PolymorphicDomainT(prototype._ptr->deserialize(d, erased));
+  }
+};
+
+/// \brief Serializer for exception::ExceptionDomain
+///
+/// The value is encoded as its normal, caught and propagated states.
+template < typename UnderlyingDomain >
+struct Serializer<
+    exception::ExceptionDomain< UnderlyingDomain >,
+    std::enable_if_t< IsSerializable< UnderlyingDomain >::value > > {
+  using ExceptionDomainT = exception::ExceptionDomain< UnderlyingDomain >;
+  using UnderlyingSerializer = Serializer< UnderlyingDomain >;
+
+  static void write(Encoder& e, const ExceptionDomainT& inv) {
+    UnderlyingSerializer::write(e, inv.normal());
+    UnderlyingSerializer::write(e, inv.caught_exceptions());
+    UnderlyingSerializer::write(e, inv.propagated_exceptions());
+  }
+
+  template < typename Resolver >
+  static ExceptionDomainT read(Decoder& d,
+                               Resolver& resolve,
+                               const ExceptionDomainT& prototype) {
+    auto normal = read_like(d, resolve, prototype.normal());
+    auto caught = read_like(d, resolve, prototype.caught_exceptions());
+    auto propagated = read_like(d, resolve, prototype.propagated_exceptions());
+    return ExceptionDomainT(std::move(normal),
+                            std::move(caught),
+                            std::move(propagated));
+  }
+};
+
+} // end namespace serialization
+} // end namespace core
+} // end namespace ikos
@@ -0,0 +1,186 @@
+/*******************************************************************************
+ *
+ * \file
+ * \brief Serialization of numbers and bounds
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <ikos/core/number/bound.hpp>
+#include <ikos/core/number/machine_int.hpp>
+#include <ikos/core/number/q_number.hpp>
+#include <ikos/core/number/z_number.hpp>
+#include <ikos/core/serialization/stream.hpp>
+
+namespace ikos {
+namespace core {
+namespace serialization {
+
+/// \brief Serializer for ZNumber
+///
+/// Integers fitting in 64 bits are written as a zigzag varint, others are
+/// written as their sign followed by the big-endian bytes of their magnitude.
+template <>
+struct Serializer< ZNumber > {
+  enum Kind : uint8_t { Small = 0, LargePositive = 1, LargeNegative = 2 };
+
+  static void write(Encoder& e, const ZNumber& n) {
+    if (n.fits< int64_t >()) {
+      e.write_byte(Small);
+      e.write_svarint(n.to< int64_t >());
+    } else {
+      mpz_class m = n.mpz();
+      std::string bytes((mpz_sizeinbase(m.get_mpz_t(), 2) + 7) / 8, '\0');
+      std::size_t count = 0;
+      mpz_export(&bytes[0], &count, 1, 1, 1, 0, m.get_mpz_t());
+      bytes.resize(count);
+      e.write_byte(sgn(m) < 0 ? LargeNegative : LargePositive);
+      e.write_bytes(bytes);
+    }
+  }
+
+  template < typename Resolver >
+  static ZNumber read(Decoder& d, Resolver& /*resolve*/) {
+    uint8_t kind = d.read_byte();
+    if (kind == Small) {
+      return ZNumber(d.read_svarint());
+    } else if (kind == LargePositive || kind == LargeNegative) {
+      StringRef bytes = d.read_bytes();
+      mpz_class m;
+      mpz_import(m.get_mpz_t(), bytes.size(), 1, 1, 1, 0, bytes.data());
+      if (kind == LargeNegative) {
+        m = -m;
+      }
+      return ZNumber(std::move(m));
+    } else {
+      throw SerializationError("serialization: invalid integer kind");
+    }
+  }
+};
+
+/// \brief Serializer for QNumber
+template <>
+struct Serializer< QNumber > {
+  static void write(Encoder& e, const QNumber& q) {
+    Serializer< ZNumber >::write(e, q.numerator());
+    Serializer< ZNumber >::write(e, q.denominator());
+  }
+
+  template < typename Resolver >
+  static QNumber read(Decoder& d, Resolver& resolve) {
+    ZNumber num = Serializer< ZNumber >::read(d, resolve);
+    ZNumber den = Serializer< ZNumber >::read(d, resolve);
+    if (den <= 0) {
+      throw SerializationError("serialization: invalid denominator");
+    }
+    return QNumber(mpq_class(num.mpz(), den.mpz()));
+  }
+};
+
+/// \brief Serializer for Bound< Number >
+template < typename Number >
+struct Serializer< Bound< Number > > {
+  enum Kind : uint8_t { Finite = 0, PlusInfinity = 1, MinusInfinity = 2 };
+
+  static void write(Encoder& e, const Bound< Number >& b) {
+    if (b.is_plus_infinity()) {
+      e.write_byte(PlusInfinity);
+    } else if (b.is_minus_infinity()) {
+      e.write_byte(MinusInfinity);
+    } else {
+      e.write_byte(Finite);
+      Serializer< Number >::write(e, *b.number());
+    }
+  }
+
+  template < typename Resolver >
+  static Bound< Number > read(Decoder& d, Resolver& resolve) {
+    switch (d.read_byte()) {
+      case Finite:
+        return Bound< Number >(Serializer< Number >::read(d, resolve));
+      case PlusInfinity:
+        return Bound< Number >::plus_infinity();
+      case MinusInfinity:
+        return Bound< Number >::minus_infinity();
+      default:
+        throw SerializationError("serialization: invalid bound kind");
+    }
+  }
+};
+
+/// \brief Serializer for the bit-width and signedness of machine integers
+struct MachineIntTypeSerializer {
+  static void write(Encoder& e, uint64_t bit_width, Signedness sign) {
+    e.write_varint(bit_width);
+    e.write_byte(sign == Signed ? 0 : 1);
+  }
+
+  static std::pair< uint64_t, Signedness > read(Decoder& d) {
+    uint64_t bit_width = d.read_varint();
+    if (bit_width == 0) {
+      throw SerializationError("serialization: invalid bit-width");
+    }
+    uint8_t sign = d.read_byte();
+    if (sign > 1) {
+      throw SerializationError("serialization: invalid signedness");
+    }
+    return {bit_width, sign == 0 ? Signed : Unsigned};
+  }
+};
+
+/// \brief Serializer for MachineInt
+template <>
+struct Serializer< MachineInt > {
+  static void write(Encoder& e, const MachineInt& n) {
+    MachineIntTypeSerializer::write(e, n.bit_width(), n.sign());
+    Serializer< ZNumber >::write(e, n.to_z_number());
+  }
+
+  template < typename Resolver >
+  static MachineInt read(Decoder& d, Resolver& resolve) {
+    auto type = MachineIntTypeSerializer::read(d);
+    ZNumber n = Serializer< ZNumber >::read(d, resolve);
+    return MachineInt(n, type.first, type.second);
+  }
+};
+
+} // end namespace serialization
+} // end namespace core
+} // end namespace ikos
@@ -0,0 +1,447 @@
+/*******************************************************************************
+ *
+ * \file
+ * \brief Binary encoder and decoder for serialized abstract values
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include <ikos/core/adt/string_ref.hpp>
+#include <ikos/core/exception.hpp>
+#include <ikos/core/semantic/indexable.hpp>
+#include <ikos/core/support/mpl.hpp>
+
+namespace ikos {
+namespace core {
+namespace serialization {
+
+/// \brief Magic bytes at the beginning of a serialized value
+constexpr const char Magic[4] = {'I', 'K', 'A', 'V'};
+
+/// \brief Version of the encoding
+///
+/// This must be incremented on any change of the encoding of a type.
+constexpr uint64_t Version = 1;
+
+/// \brief Exception raised when decoding malformed data
+class SerializationError final : public LogicError {
+public:
+  /// \brief Constructor
+  explicit SerializationError(const std::string& msg) : LogicError(msg) {}
+
+}; // end class SerializationError
+
+/// \brief Tag used to request the reference type to a resolver
+///
+/// References (variables, memory locations) are encoded using their index,
+/// see IndexableTraits. When decoding, the index is given back to a resolver
+/// callable `resolve(Index, Tag< Ref >) -> Ref`.
+template < typename Ref >
+struct Tag {};
+
+/// \brief Binary encoder
+///
+/// Integers are written using the LEB128 variable-length encoding, so that
+/// small integers (the common case) only take one byte.
+class Encoder {
+private:
+  std::string _buffer;
+
+public:
+  /// \brief Create an empty encoder
+  Encoder() = default;
+
+  /// \brief No copy constructor
+  Encoder(const Encoder&) = delete;
+
+  /// \brief Move constructor
+  Encoder(Encoder&&) = default;
+
+  /// \brief No copy assignment operator
+  Encoder& operator=(const Encoder&) = delete;
+
+  /// \brief Move assignment operator
+  Encoder& operator=(Encoder&&) = default;
+
+  /// \brief Destructor
+  ~Encoder() = default;
+
+  /// \brief Write the magic bytes and the version
+  void write_header() {
+    this->_buffer.append(Magic, sizeof(Magic));
+    this->write_varint(Version);
+  }
+
+  /// \brief Write a byte
+  void write_byte(uint8_t b) {
+    this->_buffer.push_back(static_cast< char >(b));
+  }
+
+  /// \brief Write a boolean
+  void write_bool(bool b) { this->write_byte(b ? 1 : 0); }
+
+  /// \brief Write an unsigned integer
+  void write_varint(uint64_t n) {
+    while (n >= 0x80) {
+      this->write_byte(static_cast< uint8_t >(n | 0x80));
+      n >>= 7;
+    }
+    this->write_byte(static_cast< uint8_t >(n));
+  }
+
+  /// \brief Write a signed integer, using the zigzag encoding
+  void write_svarint(int64_t n) {
+    this->write_varint((static_cast< uint64_t >(n) << 1) ^
+                       static_cast< uint64_t >(n >> 63));
+  }
+
+  /// \brief Write raw bytes, prefixed by their size
+  void write_bytes(StringRef bytes) {
+    this->write_varint(bytes.size());
+    this->_buffer += bytes;
+  }
+
+  /// \brief Write a reference, using its index
+  template < typename Ref >
+  void write_ref(const Ref& ref) {
+    this->write_varint(IndexableTraits< Ref >::index(ref));
+  }
+
+  /// \brief Return the encoded bytes
+  const std::string& str() const { return this->_buffer; }
+
+  /// \brief Return the encoded bytes, leaving the encoder empty
+  std::string release() { return std::move(this->_buffer); }
+
+}; // end class Encoder
+
+/// \brief Binary decoder
+///
+/// The decoder does not own the data.
+class Decoder {
+private:
+  const char* _cur;
+  const char* _end;
+
+public:
+  /// \brief Create a decoder on the given bytes
+  explicit Decoder(StringRef bytes)
+      : _cur(bytes.data()), _end(bytes.data() + bytes.size()) {}
+
+  /// \brief No copy constructor
+  Decoder(const Decoder&) = delete;
+
+  /// \brief No copy assignment operator
+  Decoder& operator=(const Decoder&) = delete;
+
+  /// \brief Destructor
+  ~Decoder() = default;
+
+  /// \brief Read and check the magic bytes and the version
+  void read_header() {
+    if (static_cast< std::size_t >(this->_end - this->_cur) < sizeof(Magic) ||
+        !std::equal(Magic, Magic + sizeof(Magic), this->_cur)) {
+      throw SerializationError("serialization: invalid magic bytes");
+    }
+    this->_cur += sizeof(Magic);
+    if (this->read_varint() != Version) {
+      throw SerializationError("serialization: unsupported version");
+    }
+  }
+
+  /// \brief Read a byte
+  uint8_t read_byte() {
+    if (this->_cur == this->_end) {
+      throw SerializationError("serialization: unexpected end of data");
+    }
+    return static_cast< uint8_t >(*this->_cur++);
+  }
+
+  /// \brief Read a boolean
+  bool read_bool() {
+    uint8_t b = this->read_byte();
+    if (b > 1) {
+      throw SerializationError("serialization: invalid boolean");
+    }
+    return b == 1;
+  }
+
+  /// \brief Read an unsigned integer
+  uint64_t read_varint() {
+    uint64_t n = 0;
+    for (unsigned shift = 0; shift < 64; shift += 7) {
+      uint8_t b = this->read_byte();
+      n |= static_cast< uint64_t >(b & 0x7f) << shift;
+      if ((b & 0x80) == 0) {
+        return n;
+      }
+    }
+    throw SerializationError("serialization: integer is too large");
+  }
+
+  /// \brief Read a signed integer, using the zigzag encoding
+  int64_t read_svarint() {
+    uint64_t n = this->read_varint();
+    return static_cast< int64_t >((n >> 1) ^ (~(n & 1) + 1));
+  }
+
+  /// \brief Read raw bytes, prefixed by their size
+  StringRef read_bytes() {
+    uint64_t size = this->read_varint();
+    if (size > static_cast< uint64_t >(this->_end - this->_cur)) {
+      throw SerializationError("serialization: unexpected end of data");
+    }
+    StringRef bytes(this->_cur, size);
+    this->_cur += size;
+    return bytes;
+  }
+
+  /// \brief Read an index and resolve it into a reference
+  template < typename Ref, typename Resolver >
+  Ref read_ref(Resolver& resolve) {
+    return resolve(static_cast< Index >(this->read_varint()), Tag< Ref >{});
+  }
+
+  /// \brief Return true if all the data has been read
+  bool at_end() const { return this->_cur == this->_end; }
+
+}; // end class Decoder
+
+/// \brief Serializer of values of type T
+///
+/// Specializations should provide:
+///
+/// static void write(Encoder&, const T&)
+///
+/// template < typename Resolver >
+/// static T read(Decoder&, Resolver&)
+///
+/// Values holding a context that is not encoded, such as a cell factory or the
+/// runtime domain of a polymorphic domain, provide instead:
+///
+/// template < typename Resolver >
+/// static T read(Decoder&, Resolver&, const T& prototype)
+///
+/// The decoded value then takes its context from `prototype`.
+///
+/// The second parameter allows to enable partial specializations only for
+/// some types, using `std::enable_if_t`.
+template < typename T, typename = void >
+struct Serializer;
+
+/// \brief Check if a Serializer is defined for T
+template < typename T, typename = void >
+struct IsSerializable : std::false_type {};
+
+template < typename T >
+struct IsSerializable< T, void_t< decltype(sizeof(Serializer< T >)) > >
+    : std::true_type {};
+
+/// \brief Resolver for values that do not hold any reference
+struct NoResolver {
+  template < typename Ref >
+  Ref operator()(Index, Tag< Ref >) const {
+    throw SerializationError("serialization: unexpected reference");
+  }
+};
+
+/// \brief Type-erased resolver for the references of type `Refs...`
+///
+/// This is used by virtual methods, which cannot be templates, e.g. in
+/// polymorphic domains.
+template < typename... Refs >
+class ErasedResolver;
+
+template <>
+class ErasedResolver<> {
+public:
+  /// \brief Constructor
+  template < typename Resolver >
+  explicit ErasedResolver(Resolver& /*resolve*/) {}
+
+  /// \brief Resolve nothing
+  void operator()() const = delete;
+
+}; // end class ErasedResolver
+
+template < typename Ref, typename... Refs >
+class ErasedResolver< Ref, Refs... > : public ErasedResolver< Refs... > {
+private:
+  std::function< Ref(Index) > _resolve;
+
+public:
+  /// \brief Create a type-erased resolver forwarding to `resolve`
+  ///
+  /// The resolver must outlive this object.
+  template < typename Resolver >
+  explicit ErasedResolver(Resolver& resolve)
+      : ErasedResolver< Refs... >(resolve),
+        _resolve([&resolve](Index index) {
+          return resolve(index, Tag< Ref >{});
+        }) {}
+
+  using ErasedResolver< Refs... >::operator();
+
+  /// \brief Resolve a reference of type Ref
+  Ref operator()(Index index, Tag< Ref >) const {
+    return this->_resolve(index);
+  }
+
+}; // end class ErasedResolver
+
+namespace detail {
+
+template < typename T, typename Resolver >
+auto read_like(Decoder& d, Resolver& resolve, const T& prototype, int)
+    -> decltype(Serializer< T >::read(d, resolve, prototype)) {
+  return Serializer< T >::read(d, resolve, prototype);
+}
+
+template < typename T, typename Resolver >
+T read_like(Decoder& d, Resolver& resolve, const T& /*prototype*/, long) {
+  return Serializer< T >::read(d, resolve);
+}
+
+template < typename T >
+void write_or_throw(Encoder& e, const T& value, std::true_type) {
+  Serializer< T >::write(e, value);
+}
+
+template < typename T >
+void write_or_throw(Encoder&, const T&, std::false_type) {
+  throw SerializationError("serialization: unsupported domain");
+}
+
+template < typename T, typename Resolver >
+T read_like_or_throw(Decoder& d,
+                     Resolver& resolve,
+                     const T& prototype,
+                     std::true_type) {
+  return read_like(d, resolve, prototype, 0);
+}
+
+template < typename T, typename Resolver >
+T read_like_or_throw(Decoder&, Resolver&, const T&, std::false_type) {
+  throw SerializationError("serialization: unsupported domain");
+}
+
+} // end namespace detail
+
+/// \brief Read a value of the same kind as `prototype`
+///
+/// This calls the `read` taking a prototype if the serializer provides it.
+template < typename T, typename Resolver >
+inline T read_like(Decoder& d, Resolver& resolve, const T& prototype) {
+  return detail::read_like(d, resolve, prototype, 0);
+}
+
+/// \brief Write a value, or throw a SerializationError if T is not
+/// serializable
+///
+/// This is used for the runtime domains of polymorphic domains.
+template < typename T >
+inline void write_or_throw(Encoder& e, const T& value) {
+  detail::write_or_throw(e, value, IsSerializable< T >{});
+}
+
+/// \brief Read a value like read_like(), or throw a SerializationError if T
+/// is not serializable
+template < typename T, typename Resolver >
+inline T read_like_or_throw(Decoder& d, Resolver& resolve, const T& prototype) {
+  return detail::read_like_or_throw(d,
+                                    resolve,
+                                    prototype,
+                                    IsSerializable< T >{});
+}
+
+/// \brief Serialize a value, with the header
+template < typename T >
+inline std::string serialize(const T& value) {
+  Encoder e;
+  e.write_header();
+  Serializer< T >::write(e, value);
+  return e.release();
+}
+
+/// \brief Deserialize a value serialized with serialize()
+///
+/// \throws SerializationError if the data is malformed
+template < typename T, typename Resolver >
+inline T deserialize(StringRef bytes, Resolver resolve) {
+  Decoder d(bytes);
+  d.read_header();
+  T value = Serializer< T >::read(d, resolve);
+  if (!d.at_end()) {
+    throw SerializationError("serialization: trailing data");
+  }
+  return value;
+}
+
+/// \brief Deserialize a value serialized with serialize(), taking the context
+/// that is not encoded from `prototype`
+///
+/// \throws SerializationError if the data is malformed
+template < typename T, typename Resolver >
+inline T deserialize(StringRef bytes, Resolver resolve, const T& prototype) {
+  Decoder d(bytes);
+  d.read_header();
+  T value = read_like(d, resolve, prototype);
+  if (!d.at_end()) {
+    throw SerializationError("serialization: trailing data");
+  }
+  return value;
+}
+
+/// \brief Deserialize a value that does not hold any reference
+template < typename T >
+inline T deserialize(StringRef bytes) {
+  return deserialize< T >(bytes, NoResolver{});
+}
+
+} // end namespace serialization
+} // end namespace core
+} // end namespace ikos
@@ -0,0 +1,481 @@
+/*******************************************************************************
+ *
+ * \file
+ * \brief Serialization of non-relational abstract values
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <ikos/core/serialization/number.hpp>
+#include <ikos/core/value/lifetime.hpp>
+#include <ikos/core/value/machine_int/congruence.hpp>
+#include <ikos/core/value/machine_int/interval.hpp>
+#include <ikos/core/value/machine_int/interval_congruence.hpp>
+#include <ikos/core/value/nullity.hpp>
+#include <ikos/core/value/numeric/congruence.hpp>
+#include <ikos/core/value/numeric/constant.hpp>
+#include <ikos/core/value/numeric/gauge.hpp>
+#include <ikos/core/value/numeric/interval.hpp>
+#include <ikos/core/value/numeric/interval_congruence.hpp>
+#include <ikos/core/value/pointer/pointer_set.hpp>
+#include <ikos/core/value/pointer/points_to_set.hpp>
+#include <ikos/core/value/uninitialized.hpp>
+
+namespace ikos {
+namespace core {
+namespace serialization {
+
+/// \brief Serializer for numeric::Interval
+///
+/// The bottom interval is encoded as [1, 0].
+template < typename Number >
+struct Serializer< numeric::Interval< Number > > {
+  using IntervalT = numeric::Interval< Number >;
+  using BoundSerializer = Serializer< Bound< Number > >;
+
+  static void write(Encoder& e, const IntervalT& i) {
+    BoundSerializer::write(e, i.lb());
+    BoundSerializer::write(e, i.ub());
+  }
+
+  template < typename Resolver >
+  static IntervalT read(Decoder& d, Resolver& resolve) {
+    Bound< Number > lb = BoundSerializer::read(d, resolve);
+    Bound< Number > ub = BoundSerializer::read(d, resolve);
+    if (lb.is_infinite() && lb == ub) {
+      throw SerializationError("serialization: invalid interval");
+    }
+    return IntervalT(std::move(lb), std::move(ub));
+  }
+};
+
+/// \brief Serializer for numeric::Congruence< ZNumber >
+template <>
+struct Serializer< numeric::ZCongruence > {
+  static void write(Encoder& e, const numeric::ZCongruence& c) {
+    e.write_bool(c.is_bottom());
+    if (!c.is_bottom()) {
+      Serializer< ZNumber >::write(e, c.modulus());
+      Serializer< ZNumber >::write(e, c.residue());
+    }
+  }
+
+  template < typename Resolver >
+  static numeric::ZCongruence read(Decoder& d, Resolver& resolve) {
+    if (d.read_bool()) {
+      return numeric::ZCongruence::bottom();
+    }
+    ZNumber a = Serializer< ZNumber >::read(d, resolve);
+    ZNumber b = Serializer< ZNumber >::read(d, resolve);
+    if (a < 0) {
+      throw SerializationError("serialization: invalid congruence");
+    }
+    return numeric::ZCongruence(std::move(a), std::move(b));
+  }
+};
+
+/// \brief Serializer for numeric::IntervalCongruence< ZNumber >
+template <>
+struct Serializer< numeric::IntervalCongruence< ZNumber > > {
+  using IntervalCongruenceT = numeric::IntervalCongruence< ZNumber >;
+
+  static void write(Encoder& e, const IntervalCongruenceT& ic) {
+    e.write_bool(ic.is_bottom());
+    if (!ic.is_bottom()) {
+      Serializer< numeric::ZInterval >::write(e, ic.interval());
+      Serializer< numeric::ZCongruence >::write(e, ic.congruence());
+    }
+  }
+
+  template < typename Resolver >
+  static IntervalCongruenceT read(Decoder& d, Resolver& resolve) {
+    if (d.read_bool()) {
+      return IntervalCongruenceT::bottom();
+    }
+    numeric::ZInterval i = Serializer< numeric::ZInterval >::read(d, resolve);
+    numeric::ZCongruence c =
+        Serializer< numeric::ZCongruence >::read(d, resolve);
+    return IntervalCongruenceT(std::move(i), std::move(c));
+  }
+};
+
+/// \brief Serializer for numeric::Constant
+template < typename Number >
+struct Serializer< numeric::Constant< Number > > {
+  using ConstantT = numeric::Constant< Number >;
+
+  enum Kind : uint8_t { Bottom = 0, Top = 1, Value = 2 };
+
+  static void write(Encoder& e, const ConstantT& c) {
+    if (c.is_bottom()) {
+      e.write_byte(Bottom);
+    } else if (c.is_top()) {
+      e.write_byte(Top);
+    } else {
+      e.write_byte(Value);
+      Serializer< Number >::write(e, *c.number());
+    }
+  }
+
+  template < typename Resolver >
+  static ConstantT read(Decoder& d, Resolver& resolve) {
+    switch (d.read_byte()) {
+      case Bottom:
+        return ConstantT::bottom();
+      case Top:
+        return ConstantT::top();
+      case Value:
+        return ConstantT(Serializer< Number >::read(d, resolve));
+      default:
+        throw SerializationError("serialization: invalid constant");
+    }
+  }
+};
+
+/// \brief Serializer for numeric::GaugeBound
+///
+/// A finite gauge bound is encoded as its constant followed by the list of
+/// (counter, coefficient) pairs.
+template < typename Number, typename VariableRef >
+struct Serializer< numeric::GaugeBound< Number, VariableRef > > {
+  using GaugeBoundT = numeric::GaugeBound< Number, VariableRef >;
+
+  enum Kind : uint8_t { Finite = 0, PlusInfinity = 1, MinusInfinity = 2 };
+
+  static void write(Encoder& e, const GaugeBoundT& b) {
+    if (b.is_plus_infinity()) {
+      e.write_byte(PlusInfinity);
+    } else if (b.is_minus_infinity()) {
+      e.write_byte(MinusInfinity);
+    } else {
+      e.write_byte(Finite);
+      auto expr = b.lin_expr();
+      Serializer< Number >::write(e, expr.constant());
+      e.write_varint(expr.num_terms());
+      for (const auto& term : expr) {
+        e.write_ref(term.first);
+        Serializer< Number >::write(e, term.second);
+      }
+    }
+  }
+
+  template < typename Resolver >
+  static GaugeBoundT read(Decoder& d, Resolver& resolve) {
+    switch (d.read_byte()) {
+      case Finite: {
+        GaugeBoundT b(Serializer< Number >::read(d, resolve));
+        for (uint64_t n = d.read_varint(); n > 0; --n) {
+          auto v = d.read_ref< VariableRef >(resolve);
+          b += GaugeBoundT(Serializer< Number >::read(d, resolve), v);
+        }
+        return b;
+      }
+      case PlusInfinity:
+        return GaugeBoundT::plus_infinity();
+      case MinusInfinity:
+        return GaugeBoundT::minus_infinity();
+      default:
+        throw SerializationError("serialization: invalid gauge bound kind");
+    }
+  }
+};
+
+/// \brief Serializer for numeric::Gauge
+///
+/// The bottom gauge is encoded as [1, 0].
+template < typename Number, typename VariableRef >
+struct Serializer< numeric::Gauge< Number, VariableRef > > {
+  using GaugeT = numeric::Gauge< Number, VariableRef >;
+  using BoundSerializer =
+      Serializer< numeric::GaugeBound< Number, VariableRef > >;
+
+  static void write(Encoder& e, const GaugeT& g) {
+    BoundSerializer::write(e, g.lb());
+    BoundSerializer::write(e, g.ub());
+  }
+
+  template < typename Resolver >
+  static GaugeT read(Decoder& d, Resolver& resolve) {
+    auto lb = BoundSerializer::read(d, resolve);
+    auto ub = BoundSerializer::read(d, resolve);
+    return GaugeT(std::move(lb), std::move(ub));
+  }
+};
+
+/// \brief Serializer for machine_int::Interval
+///
+/// The bottom interval is encoded with lb > ub.
+template <>
+struct Serializer< machine_int::Interval > {
+  static void write(Encoder& e, const machine_int::Interval& i) {
+    MachineIntTypeSerializer::write(e, i.bit_width(), i.sign());
+    Serializer< ZNumber >::write(e, i.lb().to_z_number());
+    Serializer< ZNumber >::write(e, i.ub().to_z_number());
+  }
+
+  template < typename Resolver >
+  static machine_int::Interval read(Decoder& d, Resolver& resolve) {
+    auto type = MachineIntTypeSerializer::read(d);
+    ZNumber lb = Serializer< ZNumber >::read(d, resolve);
+    ZNumber ub = Serializer< ZNumber >::read(d, resolve);
+    return machine_int::Interval(MachineInt(lb, type.first, type.second),
+                                 MachineInt(ub, type.first, type.second));
+  }
+};
+
+/// \brief Serializer for machine_int::Congruence
+template <>
+struct Serializer< machine_int::Congruence > {
+  static void write(Encoder& e, const machine_int::Congruence& c) {
+    MachineIntTypeSerializer::write(e, c.bit_width(), c.sign());
+    e.write_bool(c.is_bottom());
+    if (!c.is_bottom()) {
+      Serializer< ZNumber >::write(e, c.modulus());
+      Serializer< ZNumber >::write(e, c.residue());
+    }
+  }
+
+  template < typename Resolver >
+  static machine_int::Congruence read(Decoder& d, Resolver& resolve) {
+    auto type = MachineIntTypeSerializer::read(d);
+    if (d.read_bool()) {
+      return machine_int::Congruence::bottom(type.first, type.second);
+    }
+    ZNumber a = Serializer< ZNumber >::read(d, resolve);
+    ZNumber b = Serializer< ZNumber >::read(d, resolve);
+    if (a < 0) {
+      throw SerializationError("serialization: invalid congruence");
+    }
+    return machine_int::Congruence(std::move(a),
+                                   std::move(b),
+                                   type.first,
+                                   type.second);
+  }
+};
+
+/// \brief Serializer for machine_int::IntervalCongruence
+template <>
+struct Serializer< machine_int::IntervalCongruence > {
+  static void write(Encoder& e, const machine_int::IntervalCongruence& ic) {
+    Serializer< machine_int::Interval >::write(e, ic.interval());
+    Serializer< machine_int::Congruence >::write(e, ic.congruence());
+  }
+
+  template < typename Resolver >
+  static machine_int::IntervalCongruence read(Decoder& d, Resolver& resolve) {
+    auto i = Serializer< machine_int::Interval >::read(d, resolve);
+    auto c = Serializer< machine_int::Congruence >::read(d, resolve);
+    if (i.bit_width() != c.bit_width() || i.sign() != c.sign()) {
+      throw SerializationError("serialization: incompatible machine integers");
+    }
+    return machine_int::IntervalCongruence(i, c);
+  }
+};
+
+/// \brief Serializer for Nullity
+template <>
+struct Serializer< Nullity > {
+  enum Kind : uint8_t { Bottom = 0, Null = 1, NonNull = 2, Top = 3 };
+
+  static void write(Encoder& e, const Nullity& n) {
+    if (n.is_bottom()) {
+      e.write_byte(Bottom);
+    } else if (n.is_null()) {
+      e.write_byte(Null);
+    } else if (n.is_non_null()) {
+      e.write_byte(NonNull);
+    } else {
+      e.write_byte(Top);
+    }
+  }
+
+  template < typename Resolver >
+  static Nullity read(Decoder& d, Resolver& /*resolve*/) {
+    switch (d.read_byte()) {
+      case Bottom:
+        return Nullity::bottom();
+      case Null:
+        return Nullity::null();
+      case NonNull:
+        return Nullity::non_null();
+      case Top:
+        return Nullity::top();
+      default:
+        throw SerializationError("serialization: invalid nullity");
+    }
+  }
+};
+
+/// \brief Serializer for Uninitialized
+template <>
+struct Serializer< Uninitialized > {
+  enum Kind : uint8_t {
+    Bottom = 0,
+    Initialized = 1,
+    IsUninitialized = 2,
+    Top = 3
+  };
+
+  static void write(Encoder& e, const Uninitialized& u) {
+    if (u.is_bottom()) {
+      e.write_byte(Bottom);
+    } else if (u.is_initialized()) {
+      e.write_byte(Initialized);
+    } else if (u.is_uninitialized()) {
+      e.write_byte(IsUninitialized);
+    } else {
+      e.write_byte(Top);
+    }
+  }
+
+  template < typename Resolver >
+  static Uninitialized read(Decoder& d, Resolver& /*resolve*/) {
+    switch (d.read_byte()) {
+      case Bottom:
+        return Uninitialized::bottom();
+      case Initialized:
+        return Uninitialized::initialized();
+      case IsUninitialized:
+        return Uninitialized::uninitialized();
+      case Top:
+        return Uninitialized::top();
+      default:
+        throw SerializationError("serialization: invalid uninitialized value");
+    }
+  }
+};
+
+/// \brief Serializer for Lifetime
+template <>
+struct Serializer< Lifetime > {
+  enum Kind : uint8_t { Bottom = 0, Allocated = 1, Deallocated = 2, Top = 3 };
+
+  static void write(Encoder& e, const Lifetime& l) {
+    if (l.is_bottom()) {
+      e.write_byte(Bottom);
+    } else if (l.is_allocated()) {
+      e.write_byte(Allocated);
+    } else if (l.is_deallocated()) {
+      e.write_byte(Deallocated);
+    } else {
+      e.write_byte(Top);
+    }
+  }
+
+  template < typename Resolver >
+  static Lifetime read(Decoder& d, Resolver& /*resolve*/) {
+    switch (d.read_byte()) {
+      case Bottom:
+        return Lifetime::bottom();
+      case Allocated:
+        return Lifetime::allocated();
+      case Deallocated:
+        return Lifetime::deallocated();
+      case Top:
+        return Lifetime::top();
+      default:
+        throw SerializationError("serialization: invalid lifetime");
+    }
+  }
+};
+
+/// \brief Serializer for PointsToSet
+template < typename MemoryLocationRef >
+struct Serializer< PointsToSet< MemoryLocationRef > > {
+  using PointsToSetT = PointsToSet< MemoryLocationRef >;
+
+  enum Kind : uint8_t { Bottom = 0, Top = 1, Set = 2 };
+
+  static void write(Encoder& e, const PointsToSetT& s) {
+    if (s.is_bottom()) {
+      e.write_byte(Bottom);
+    } else if (s.is_top()) {
+      e.write_byte(Top);
+    } else {
+      e.write_byte(Set);
+      e.write_varint(s.size());
+      for (const auto& m : s) {
+        e.write_ref(m);
+      }
+    }
+  }
+
+  template < typename Resolver >
+  static PointsToSetT read(Decoder& d, Resolver& resolve) {
+    switch (d.read_byte()) {
+      case Bottom:
+        return PointsToSetT::bottom();
+      case Top:
+        return PointsToSetT::top();
+      case Set: {
+        PointsToSetT s = PointsToSetT::empty();
+        for (uint64_t n = d.read_varint(); n > 0; --n) {
+          s.add(d.read_ref< MemoryLocationRef >(resolve));
+        }
+        return s;
+      }
+      default:
+        throw SerializationError("serialization: invalid points-to set");
+    }
+  }
+};
+
+/// \brief Serializer for PointerSet
+template < typename MemoryLocationRef >
+struct Serializer< PointerSet< MemoryLocationRef > > {
+  using PointerSetT = PointerSet< MemoryLocationRef >;
+
+  static void write(Encoder& e, const PointerSetT& s) {
+    Serializer< PointsToSet< MemoryLocationRef > >::write(e, s.points_to());
+    Serializer< machine_int::Interval >::write(e, s.offsets());
+  }
+
+  template < typename Resolver >
+  static PointerSetT read(Decoder& d, Resolver& resolve) {
+    auto points_to =
+        Serializer< PointsToSet< MemoryLocationRef > >::read(d, resolve);
+    auto offsets = Serializer< machine_int::Interval >::read(d, resolve);
+    return PointerSetT(std::move(points_to), std::move(offsets));
+  }
+};
+
+} // end namespace serialization
+} // end namespace core
+} // end namespace ikos
@@ -0,0 +1,166 @@
+/*******************************************************************************
+ *
+ * \file
+ * \brief Benchmark of the relational machine integer domains
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <ikos/core/domain/machine_int/dbm.hpp>
+#include <ikos/core/domain/machine_int/numeric_domain_adapter.hpp>
+#include <ikos/core/domain/machine_int/octagon.hpp>
+#include <ikos/core/example/machine_int/variable_factory.hpp>
+
+using ZNumber = ikos::core::ZNumber;
+using Int = ikos::core::MachineInt;
+using Interval = ikos::core::machine_int::Interval;
+using ikos::core::Signed;
+using ikos::core::machine_int::BinaryOperator;
+using ikos::core::machine_int::Predicate;
+using VariableFactory = ikos::core::example::machine_int::VariableFactory;
+using Variable = VariableFactory::VariableRef;
+
+namespace machine_int = ikos::core::machine_int;
+namespace numeric = ikos::core::numeric;
+
+using NumDBM = numeric::DBM< ZNumber, Variable >;
+using NumOctagon = numeric::Octagon< ZNumber, Variable >;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/// \brief Analyze a straight-line chain of 32-bit additions
+///
+/// x[0] = [0, 100]; x[i] = x[i-1] + 1; assume x[n-1] <= 50; then join with
+/// the same chain starting from [200, 300].
+template < typename Domain >
+void run_chain(Domain inv, const std::vector< Variable >& x) {
+  Domain other = inv;
+  inv.set(x[0], Interval(Int(0, 32, Signed), Int(100, 32, Signed)));
+  other.set(x[0], Interval(Int(200, 32, Signed), Int(300, 32, Signed)));
+  for (std::size_t i = 1; i < x.size(); i++) {
+    inv.apply(BinaryOperator::Add, x[i], x[i - 1], Int(1, 32, Signed));
+    other.apply(BinaryOperator::Add, x[i], x[i - 1], Int(1, 32, Signed));
+  }
+  inv.add(Predicate::LE, x.back(), Int(50, 32, Signed));
+  inv.join_with(other);
+  for (Variable v : x) {
+    inv.normalize();
+    static_cast< void >(inv.to_interval(v));
+  }
+}
+
+/// \brief Run the chain on the given domain for about a second
+///
+/// \returns the number of runs per second
+template < typename Domain >
+double throughput(const Domain& top, const std::vector< Variable >& x) {
+  std::size_t count = 0;
+  Clock::duration elapsed(0);
+  while (elapsed < std::chrono::seconds(1)) {
+    Clock::time_point start = Clock::now();
+    run_chain(top, x);
+    elapsed += Clock::now() - start;
+    count++;
+  }
+  return static_cast< double >(count) /
+         std::chrono::duration< double >(elapsed).count();
+}
+
+} // end anonymous namespace
+
+int main() {
+  VariableFactory vfac;
+
+  std::printf("%-10s %-10s %-10s %14s %10s\n",
+              "variables",
+              "numeric",
+              "domain",
+              "runs/s",
+              "speedup");
+  for (std::size_t num_vars : {10, 20, 40}) {
+    std::vector< Variable > x;
+    for (std::size_t i = 0; i < num_vars; i++) {
+      x.push_back(vfac.get("x" + std::to_string(i), 32, Signed));
+    }
+
+    double base = throughput(machine_int::NumericDomainAdapter< Variable,
+                                                                NumDBM >(
+                                 NumDBM::top()),
+                             x);
+    double t = throughput(machine_int::DBM< Variable >::top(), x);
+    std::printf("%-10zu %-10s %-10s %14.1f %9.1fx\n",
+                num_vars,
+                "dbm",
+                "adapter",
+                base,
+                1.0);
+    std::printf("%-10zu %-10s %-10s %14.1f %9.1fx\n",
+                num_vars,
+                "dbm",
+                "native",
+                t,
+                t / base);
+
+    base = throughput(machine_int::NumericDomainAdapter< Variable,
+                                                         NumOctagon >(
+                          NumOctagon::top()),
+                      x);
+    t = throughput(machine_int::Octagon< Variable >::top(), x);
+    std::printf("%-10zu %-10s %-10s %14.1f %9.1fx\n",
+                num_vars,
+                "octagon",
+                "adapter",
+                base,
+                1.0);
+    std::printf("%-10zu %-10s %-10s %14.1f %9.1fx\n",
+                num_vars,
+                "octagon",
+                "native",
+                t,
+                t / base);
+  }
+
+  return 0;
+}
@@ -0,0 +1,157 @@
+/*******************************************************************************
+ *
+ * Benchmark of the dense closure kernels
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include <ikos/core/domain/numeric/dense_closure.hpp>
+#include <ikos/core/number/z_number.hpp>
+
+using ZNumber = ikos::core::ZNumber;
+using Bound = ikos::core::ZBound;
+using Weight = ikos::core::numeric::dense_closure::Weight;
+using Kernels = ikos::core::numeric::dense_closure::detail::Kernels;
+
+namespace dense_closure = ikos::core::numeric::dense_closure;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/// \brief Return a random DBM of size n x n
+///
+/// Weights are non-negative, so that there is no negative cycle.
+std::vector< Bound > random_matrix(std::mt19937& rng, std::size_t n) {
+  std::vector< Bound > m(n * n, Bound::plus_infinity());
+  for (std::size_t i = 0; i < n; i++) {
+    for (std::size_t j = 0; j < n; j++) {
+      if (i == j) {
+        m[n * i + j] = Bound(0);
+      } else if (rng() % 4 == 0) {
+        m[n * i + j] = Bound(static_cast< int >(rng() % 1000));
+      }
+    }
+  }
+  return m;
+}
+
+/// \brief Floyd-Warshall algorithm on bounds, as in DBM
+void bound_floyd_warshall(std::vector< Bound >& m, std::size_t n) {
+  for (std::size_t k = 0; k < n; k++) {
+    for (std::size_t i = 0; i < n; i++) {
+      for (std::size_t j = 0; j < n; j++) {
+        m[n * i + j] = min(m[n * i + j], m[n * i + k] + m[n * k + j]);
+      }
+    }
+  }
+}
+
+/// \brief Floyd-Warshall algorithm on a dense copy, as in DBM
+void dense_floyd_warshall(std::vector< Bound >& m,
+                          std::size_t n,
+                          const Kernels& k) {
+  std::vector< Weight > dense(m.size());
+  for (std::size_t i = 0; i < m.size(); i++) {
+    dense_closure::to_weight(m[i], dense[i]);
+  }
+  dense_closure::floyd_warshall(dense.data(), n, k);
+  for (std::size_t i = 0; i < m.size(); i++) {
+    m[i] = dense_closure::to_bound(dense[i]);
+  }
+}
+
+/// \brief Run the given closure on copies of the matrix for about a second
+///
+/// \returns the number of closures per second
+template < typename Closure >
+double throughput(const std::vector< Bound >& m, Closure closure) {
+  std::size_t count = 0;
+  Clock::duration elapsed(0);
+  while (elapsed < std::chrono::seconds(1)) {
+    std::vector< Bound > tmp = m;
+    Clock::time_point start = Clock::now();
+    closure(tmp);
+    elapsed += Clock::now() - start;
+    count++;
+  }
+  return static_cast< double >(count) /
+         std::chrono::duration< double >(elapsed).count();
+}
+
+} // end anonymous namespace
+
+int main() {
+  std::mt19937 rng(42);
+  std::vector< Kernels > all_kernels = {dense_closure::detail::scalar_kernels(),
+                                        dense_closure::detail::sse42_kernels(),
+                                        dense_closure::detail::avx2_kernels()};
+
+  std::printf("%-10s %-10s %14s %10s\n",
+              "variables",
+              "kernels",
+              "closures/s",
+              "speedup");
+  for (std::size_t num_vars : {50, 100, 200}) {
+    std::size_t n = num_vars + 1;
+    std::vector< Bound > m = random_matrix(rng, n);
+
+    double base = throughput(m, [n](std::vector< Bound >& tmp) {
+      bound_floyd_warshall(tmp, n);
+    });
+    std::printf("%-10zu %-10s %14.1f %9.1fx\n", num_vars, "bound", base, 1.0);
+
+    for (const Kernels& k : all_kernels) {
+      double t = throughput(m, [n, &k](std::vector< Bound >& tmp) {
+        dense_floyd_warshall(tmp, n, k);
+      });
+      std::printf("%-10zu %-10s %14.1f %9.1fx\n",
+                  num_vars,
+                  k.name,
+                  t,
+                  t / base);
+    }
+  }
+
+  return 0;
+}
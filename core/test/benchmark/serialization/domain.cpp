@@ -0,0 +1,256 @@
+/*******************************************************************************
+ *
+ * \file
+ * \brief Benchmark of the serialization of abstract domains
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <ikos/core/example/memory_factory.hpp>
+#include <ikos/core/example/scalar/variable_factory.hpp>
+#include <ikos/core/example/variable_factory.hpp>
+#include <ikos/core/serialization/domain.hpp>
+#include <ikos/core/serialization/memory.hpp>
+
+using ZNumber = ikos::core::ZNumber;
+using ZBound = ikos::core::ZBound;
+using ZInterval = ikos::core::numeric::ZInterval;
+using Int = ikos::core::MachineInt;
+using Index = ikos::core::Index;
+using Nullity = ikos::core::Nullity;
+using ikos::core::Signed;
+using ikos::core::Unsigned;
+using VariableFactory = ikos::core::example::VariableFactory;
+using Variable = VariableFactory::VariableRef;
+using VariableExpr = ikos::core::VariableExpression< ZNumber, Variable >;
+using ScalarVariableFactory = ikos::core::example::scalar::VariableFactory;
+using ScalarVariable = ScalarVariableFactory::VariableRef;
+using MemoryFactory = ikos::core::example::MemoryFactory;
+using MemoryLocation = MemoryFactory::MemoryLocationRef;
+using Literal = ikos::core::Literal< ScalarVariable, MemoryLocation >;
+
+namespace core = ikos::core;
+namespace serialization = ikos::core::serialization;
+
+using IntervalDomain = core::numeric::IntervalDomain< ZNumber, Variable >;
+using DBM = core::numeric::DBM< ZNumber, Variable >;
+using GaugeDomain = core::numeric::GaugeDomain< ZNumber, Variable >;
+using MachIntPolymorphicDomain =
+    core::machine_int::PolymorphicDomain< ScalarVariable >;
+using ScalarDomain = core::scalar::CompositeDomain<
+    ScalarVariable,
+    MemoryLocation,
+    core::uninitialized::SeparateDomain< ScalarVariable >,
+    MachIntPolymorphicDomain,
+    core::nullity::SeparateDomain< ScalarVariable > >;
+using LifetimeDomain = core::lifetime::SeparateDomain< MemoryLocation >;
+using ValueDomain = core::memory::ValueDomain< ScalarVariable,
+                                               MemoryLocation,
+                                               ScalarVariableFactory*,
+                                               ScalarDomain,
+                                               LifetimeDomain >;
+using MemoryDomain =
+    core::memory::PolymorphicDomain< ScalarVariable, MemoryLocation >;
+using AbstractDomain = core::exception::ExceptionDomain< MemoryDomain >;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/// \brief Map indexes back to variables and memory locations
+class Resolver {
+private:
+  std::map< Index, Variable > _vars;
+  std::map< Index, ScalarVariable > _scalar_vars;
+  std::map< Index, MemoryLocation > _mem_locs;
+
+public:
+  void add(Variable v) { this->_vars.emplace(v->index(), v); }
+
+  void add(ScalarVariable v) { this->_scalar_vars.emplace(v->index(), v); }
+
+  void add(MemoryLocation m) { this->_mem_locs.emplace(m->index(), m); }
+
+  Variable operator()(Index i, serialization::Tag< Variable >) const {
+    return this->_vars.at(i);
+  }
+
+  ScalarVariable operator()(Index i,
+                            serialization::Tag< ScalarVariable >) const {
+    return this->_scalar_vars.at(i);
+  }
+
+  MemoryLocation operator()(Index i,
+                            serialization::Tag< MemoryLocation >) const {
+    return this->_mem_locs.at(i);
+  }
+};
+
+/// \brief Encode, then decode the given value for about a second each
+///
+/// Prints the size of the encoding and the throughput in MB/s.
+template < typename T >
+void run(const char* name,
+         std::size_t num_vars,
+         const T& value,
+         const Resolver& resolver) {
+  std::size_t size = serialization::serialize(value).size();
+
+  std::size_t count = 0;
+  Clock::duration elapsed(0);
+  while (elapsed < std::chrono::seconds(1)) {
+    Clock::time_point start = Clock::now();
+    static_cast< void >(serialization::serialize(value));
+    elapsed += Clock::now() - start;
+    count++;
+  }
+  double encode = static_cast< double >(count * size) / 1e6 /
+                  std::chrono::duration< double >(elapsed).count();
+
+  std::string bytes = serialization::serialize(value);
+  count = 0;
+  elapsed = Clock::duration(0);
+  while (elapsed < std::chrono::seconds(1)) {
+    Clock::time_point start = Clock::now();
+    static_cast< void >(serialization::deserialize(bytes, resolver, value));
+    elapsed += Clock::now() - start;
+    count++;
+  }
+  double decode = static_cast< double >(count * size) / 1e6 /
+                  std::chrono::duration< double >(elapsed).count();
+
+  std::printf("%-10s %-10zu %12zu %14.1f %14.1f\n",
+              name,
+              num_vars,
+              size,
+              encode,
+              decode);
+}
+
+} // end anonymous namespace
+
+int main() {
+  VariableFactory vfac;
+  ScalarVariableFactory svfac;
+  MemoryFactory mfac;
+  Resolver resolver;
+
+  std::printf("%-10s %-10s %12s %14s %14s\n",
+              "domain",
+              "variables",
+              "bytes",
+              "encode MB/s",
+              "decode MB/s");
+  for (std::size_t num_vars : {10, 100, 1000}) {
+    std::vector< Variable > x;
+    for (std::size_t i = 0; i < num_vars; i++) {
+      x.push_back(vfac.get("x" + std::to_string(i)));
+      resolver.add(x.back());
+    }
+
+    auto intervals = IntervalDomain::top();
+    for (std::size_t i = 0; i < num_vars; i++) {
+      intervals.set(x[i], ZInterval(ZBound(-1), ZBound(i * 1000)));
+    }
+    run("interval", num_vars, intervals, resolver);
+
+    if (num_vars <= 100) {
+      auto dbm = DBM::top();
+      dbm.set(x[0], ZInterval(ZBound(0), ZBound(100)));
+      for (std::size_t i = 1; i < num_vars; i++) {
+        dbm.add(VariableExpr(x[i]) - VariableExpr(x[i - 1]) <= 1);
+      }
+      run("dbm", num_vars, dbm, resolver);
+    }
+
+    auto gauge = GaugeDomain::top();
+    gauge.counter_init(x[0], ZNumber(0));
+    for (std::size_t i = 1; i < num_vars; i++) {
+      gauge.assign(x[i], static_cast< int >(i));
+    }
+    auto gauge2 = gauge;
+    gauge2.counter_incr(x[0], ZNumber(1));
+    for (std::size_t i = 1; i < num_vars; i++) {
+      gauge2.assign(x[i], VariableExpr(x[i]) + 1);
+    }
+    gauge = gauge.widening_threshold(gauge2, ZNumber(100));
+    run("gauge", num_vars, gauge, resolver);
+
+    // One pointer and one integer cell per memory location
+    auto normal = MemoryDomain(ValueDomain(
+        &svfac,
+        ScalarDomain(core::uninitialized::SeparateDomain<
+                         ScalarVariable >::top(),
+                     MachIntPolymorphicDomain(
+                         core::machine_int::IntervalDomain<
+                             ScalarVariable >::top()),
+                     core::nullity::SeparateDomain< ScalarVariable >::top()),
+        LifetimeDomain::top()));
+    auto bottom = normal;
+    bottom.set_to_bottom();
+    for (std::size_t i = 0; i < num_vars; i++) {
+      ScalarVariable p =
+          svfac.get_pointer("p" + std::to_string(i), 64, Unsigned);
+      MemoryLocation m = mfac.get("m" + std::to_string(i));
+      resolver.add(p);
+      resolver.add(p->offset_var());
+      resolver.add(m);
+      normal.lifetime_assign_allocated(m);
+      normal.pointer_assign(p, m, Nullity::non_null());
+      normal.mem_write(p,
+                       Literal::machine_int(Int(i, 32, Signed)),
+                       Int(4, 64, Unsigned));
+      ScalarVariable cell =
+          svfac.get_cell(m, Int(0, 64, Unsigned), Int(4, 64, Unsigned), Signed);
+      resolver.add(cell);
+      resolver.add(cell->offset_var());
+    }
+    run("value",
+        num_vars,
+        AbstractDomain(normal, bottom, bottom),
+        resolver);
+  }
+
+  return 0;
+}
@@ -46,6 +46,7 @@
 #include <boost/test/unit_test.hpp>
 
 #include <ikos/core/domain/machine_int/numeric_domain_adapter.hpp>
+#include <ikos/core/domain/numeric/dbm.hpp>
 #include <ikos/core/domain/numeric/interval.hpp>
 #include <ikos/core/example/machine_int/variable_factory.hpp>
 
@@ -69,6 +70,12 @@ using IntervalDomain =
     ikos::core::machine_int::NumericDomainAdapter< Variable,
                                                    NumericIntervalDomain >;
 
+// Machine integer abstract domain based on the numeric DBM domain
+using NumericDBMDomain = ikos::core::numeric::DBM< ZNumber, Variable >;
+using DBMDomain =
+    ikos::core::machine_int::NumericDomainAdapter< Variable,
+                                                   NumericDBMDomain >;
+
 BOOST_AUTO_TEST_CASE(is_top_and_bottom) {
   VariableFactory vfac;
   Variable x(vfac.get("x", 32, Signed));
@@ -402,6 +409,37 @@ BOOST_AUTO_TEST_CASE(assign) {
               Interval(Int(-7, 32, Signed), Int(0, 32, Signed)));
 }
 
+BOOST_AUTO_TEST_CASE(wrap) {
+  VariableFactory vfac;
+  Variable x(vfac.get("x", 8, Signed));
+  Variable y(vfac.get("y", 8, Signed));
+  Variable z(vfac.get("z", 8, Unsigned));
+
+  // No overflow: the relation between x and y is preserved
+  auto inv = DBMDomain(NumericDBMDomain::top());
+  inv.set(x, Interval(Int(0, 8, Signed), Int(10, 8, Signed)));
+  inv.apply(BinaryOperator::Add, y, x, Int(1, 8, Signed));
+  BOOST_CHECK(inv.to_interval(y) ==
+              Interval(Int(1, 8, Signed), Int(11, 8, Signed)));
+  inv.add(Predicate::GE, x, y);
+  BOOST_CHECK(inv.is_bottom());
+
+  // Overflow: the value wraps around
+  inv.set_to_top();
+  inv.set(x, Interval(Int(127, 8, Signed)));
+  inv.apply(BinaryOperator::Add, y, x, Int(1, 8, Signed));
+  BOOST_CHECK(inv.to_interval(y) == Interval(Int(-128, 8, Signed)));
+
+  auto inv2 = IntervalDomain(NumericIntervalDomain::top());
+  inv2.set(x, Interval(Int(-1, 8, Signed)));
+  inv2.apply(UnaryOperator::SignCast, z, x);
+  BOOST_CHECK(inv2.to_interval(z) == Interval(Int(255, 8, Unsigned)));
+
+  inv.set_to_bottom();
+  inv.apply(BinaryOperator::Add, y, x, Int(1, 8, Signed));
+  BOOST_CHECK(inv.is_bottom());
+}
+
 BOOST_AUTO_TEST_CASE(unary_apply) {
   VariableFactory vfac;
   Variable x(vfac.get("x", 8, Signed));
@@ -0,0 +1,268 @@
+/*******************************************************************************
+ *
+ * Tests for machine_int::Octagon
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2018-2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#define BOOST_TEST_MODULE test_machine_int_octagon
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <ikos/core/domain/machine_int/octagon.hpp>
+#include <ikos/core/example/machine_int/variable_factory.hpp>
+
+using ZNumber = ikos::core::ZNumber;
+using Int = ikos::core::MachineInt;
+using Interval = ikos::core::machine_int::Interval;
+using ikos::core::Signed;
+using ikos::core::Unsigned;
+using ikos::core::machine_int::BinaryOperator;
+using ikos::core::machine_int::Predicate;
+using ikos::core::machine_int::UnaryOperator;
+using VariableFactory = ikos::core::example::machine_int::VariableFactory;
+using Variable = VariableFactory::VariableRef;
+using LinearExpr = ikos::core::LinearExpression< Int, Variable >;
+
+using Domain = ikos::core::machine_int::Octagon< Variable >;
+
+BOOST_AUTO_TEST_CASE(is_top_and_bottom) {
+  VariableFactory vfac;
+  Variable x(vfac.get("x", 32, Signed));
+
+  BOOST_CHECK(Domain::top().is_top());
+  BOOST_CHECK(!Domain::top().is_bottom());
+  BOOST_CHECK(!Domain::bottom().is_top());
+  BOOST_CHECK(Domain::bottom().is_bottom());
+
+  auto inv = Domain::top();
+  inv.set(x, Interval(Int(1, 32, Signed)));
+  BOOST_CHECK(!inv.is_top());
+  BOOST_CHECK(!inv.is_bottom());
+
+  inv.set(x, Interval::bottom(32, Signed));
+  BOOST_CHECK(inv.is_bottom());
+}
+
+BOOST_AUTO_TEST_CASE(add_no_overflow) {
+  VariableFactory vfac;
+  Variable x(vfac.get("x", 8, Signed));
+  Variable y(vfac.get("y", 8, Signed));
+
+  // The relation between x and y is preserved
+  auto inv = Domain::top();
+  inv.set(x, Interval(Int(0, 8, Signed), Int(10, 8, Signed)));
+  inv.apply(BinaryOperator::Add, y, x, Int(1, 8, Signed));
+  inv.normalize();
+  BOOST_CHECK(inv.to_interval(y) ==
+              Interval(Int(1, 8, Signed), Int(11, 8, Signed)));
+  inv.add(Predicate::GE, x, y);
+  BOOST_CHECK(inv.is_bottom());
+}
+
+BOOST_AUTO_TEST_CASE(add_overflow) {
+  VariableFactory vfac;
+  Variable x(vfac.get("x", 8, Signed));
+  Variable y(vfac.get("y", 8, Signed));
+  Variable z(vfac.get("z", 8, Unsigned));
+
+  // The value wraps around
+  auto inv = Domain::top();
+  inv.assign(x, Int(127, 8, Signed));
+  inv.apply(BinaryOperator::Add, y, x, Int(1, 8, Signed));
+  inv.normalize();
+  BOOST_CHECK(inv.to_interval(y) == Interval(Int(-128, 8, Signed)));
+
+  inv.set(z, Interval(Int(250, 8, Unsigned), Int(255, 8, Unsigned)));
+  inv.apply(BinaryOperator::Add, z, z, Int(10, 8, Unsigned));
+  inv.normalize();
+  BOOST_CHECK(inv.to_interval(z) ==
+              Interval(Int(4, 8, Unsigned), Int(9, 8, Unsigned)));
+
+  // Partial overflow
+  inv.set(x, Interval(Int(100, 8, Signed), Int(120, 8, Signed)));
+  inv.apply(BinaryOperator::Add, y, x, Int(10, 8, Signed));
+  inv.normalize();
+  BOOST_CHECK(inv.to_interval(y) == Interval::top(8, Signed));
+
+  // Overflow is an undefined behavior
+  inv.apply(BinaryOperator::AddNoWrap, y, x, Int(10, 8, Signed));
+  inv.normalize();
+  BOOST_CHECK(inv.to_interval(y) ==
+              Interval(Int(110, 8, Signed), Int(127, 8, Signed)));
+}
+
+BOOST_AUTO_TEST_CASE(definite_no_wrap_overflow) {
+  VariableFactory vfac;
+  Variable x(vfac.get("x", 8, Signed));
+  Variable y(vfac.get("y", 8, Signed));
+
+  // The overflow is certain, hence the result is bottom
+  auto inv = Domain::top();
+  inv.assign(y, Int(100, 8, Signed));
+  inv.apply(BinaryOperator::AddNoWrap, x, y, y);
+  BOOST_CHECK(inv.is_bottom());
+
+  inv = Domain::top();
+  inv.set(y, Interval(Int(100, 8, Signed), Int(120, 8, Signed)));
+  inv.apply(BinaryOperator::MulNoWrap, x, y, Int(2, 8, Signed));
+  BOOST_CHECK(inv.is_bottom());
+
+  inv = Domain::top();
+  inv.assign(y, Int(-100, 8, Signed));
+  inv.apply(BinaryOperator::SubNoWrap, x, y, Int(50, 8, Signed));
+  BOOST_CHECK(inv.is_bottom());
+
+  // Refining to a disjoint interval
+  inv = Domain::top();
+  inv.set(y, Interval(Int(5, 8, Signed), Int(10, 8, Signed)));
+  inv.refine(y, Interval(Int(0, 8, Signed), Int(3, 8, Signed)));
+  BOOST_CHECK(inv.is_bottom());
+}
+
+BOOST_AUTO_TEST_CASE(sub_and_mul) {
+  VariableFactory vfac;
+  Variable x(vfac.get("x", 32, Unsigned));
+  Variable y(vfac.get("y", 32, Unsigned));
+  Variable z(vfac.get("z", 32, Unsigned));
+
+  auto inv = Domain::top();
+  inv.set(x, Interval(Int(0, 32, Unsigned), Int(10, 32, Unsigned)));
+  inv.assign(y, Int(1, 32, Unsigned));
+  inv.apply(BinaryOperator::Sub, z, x, y);
+  inv.normalize();
+  BOOST_CHECK(inv.to_interval(z) == Interval::top(32, Unsigned));
+
+  inv.add(Predicate::GE, x, Int(1, 32, Unsigned));
+  inv.apply(BinaryOperator::Sub, z, x, y);
+  inv.normalize();
+  BOOST_CHECK(inv.to_interval(z) ==
+              Interval(Int(0, 32, Unsigned), Int(9, 32, Unsigned)));
+
+  inv.apply(BinaryOperator::Mul, z, x, Int(3, 32, Unsigned));
+  inv.normalize();
+  BOOST_CHECK(inv.to_interval(z) ==
+              Interval(Int(3, 32, Unsigned), Int(30, 32, Unsigned)));
+}
+
+BOOST_AUTO_TEST_CASE(assign_linear_expression) {
+  VariableFactory vfac;
+  Variable x(vfac.get("x", 8, Unsigned));
+  Variable y(vfac.get("y", 8, Unsigned));
+
+  auto inv = Domain::top();
+  inv.set(x, Interval(Int(1, 8, Unsigned), Int(2, 8, Unsigned)));
+  LinearExpr e(Int(3, 8, Unsigned));
+  e.add(Int(2, 8, Unsigned), x);
+  inv.assign(y, e);
+  inv.normalize();
+  BOOST_CHECK(inv.to_interval(y) ==
+              Interval(Int(5, 8, Unsigned), Int(7, 8, Unsigned)));
+
+  LinearExpr f(Int(255, 8, Unsigned));
+  f.add(Int(1, 8, Unsigned), x);
+  inv.assign(y, f);
+  inv.normalize();
+  BOOST_CHECK(inv.to_interval(y) ==
+              Interval(Int(0, 8, Unsigned), Int(1, 8, Unsigned)));
+}
+
+BOOST_AUTO_TEST_CASE(casts) {
+  VariableFactory vfac;
+  Variable x(vfac.get("x", 32, Signed));
+  Variable y(vfac.get("y", 8, Signed));
+  Variable z(vfac.get("z", 32, Unsigned));
+  Variable w(vfac.get("w", 64, Signed));
+
+  auto inv = Domain::top();
+  inv.set(x, Interval(Int(-1, 32, Signed), Int(100, 32, Signed)));
+  inv.apply(UnaryOperator::Trunc, y, x);
+  inv.normalize();
+  BOOST_CHECK(inv.to_interval(y) ==
+              Interval(Int(-1, 8, Signed), Int(100, 8, Signed)));
+
+  inv.apply(UnaryOperator::SignCast, z, x);
+  inv.normalize();
+  BOOST_CHECK(inv.to_interval(z) == Interval::top(32, Unsigned));
+
+  inv.apply(UnaryOperator::Ext, w, x);
+  inv.normalize();
+  BOOST_CHECK(inv.to_interval(w) ==
+              Interval(Int(-1, 64, Signed), Int(100, 64, Signed)));
+
+  inv.set(x, Interval(Int(300, 32, Signed)));
+  inv.apply(UnaryOperator::Trunc, y, x);
+  inv.normalize();
+  BOOST_CHECK(inv.to_interval(y) == Interval(Int(44, 8, Signed)));
+}
+
+BOOST_AUTO_TEST_CASE(shifts) {
+  VariableFactory vfac;
+  Variable x(vfac.get("x", 8, Unsigned));
+  Variable y(vfac.get("y", 8, Unsigned));
+  Variable z(vfac.get("z", 8, Unsigned));
+
+  auto inv = Domain::top();
+  inv.assign(x, Int(1, 8, Unsigned));
+  inv.apply(BinaryOperator::Shl, y, x, z);
+  inv.normalize();
+  BOOST_CHECK(inv.to_interval(z) ==
+              Interval(Int(0, 8, Unsigned), Int(7, 8, Unsigned)));
+
+  inv.apply(BinaryOperator::Shl, y, x, Int(8, 8, Unsigned));
+  BOOST_CHECK(inv.is_bottom());
+}
+
+BOOST_AUTO_TEST_CASE(join) {
+  VariableFactory vfac;
+  Variable x(vfac.get("x", 32, Signed));
+  Variable y(vfac.get("y", 32, Signed));
+
+  auto inv1 = Domain::top();
+  inv1.assign(x, Int(0, 32, Signed));
+  inv1.apply(BinaryOperator::Add, y, x, Int(1, 32, Signed));
+
+  auto inv2 = Domain::top();
+  inv2.assign(x, Int(5, 32, Signed));
+  inv2.apply(BinaryOperator::Add, y, x, Int(1, 32, Signed));
+
+  auto inv = inv1.join(inv2);
+  inv.normalize();
+  BOOST_CHECK(inv.to_interval(y) ==
+              Interval(Int(1, 32, Signed), Int(6, 32, Signed)));
+}
@@ -0,0 +1,109 @@
+/*******************************************************************************
+ *
+ * \file
+ * \brief Tests for ApronDomain used from several threads
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#define BOOST_TEST_MODULE test_apron_concurrency
+#define BOOST_TEST_DYN_LINK
+#include <thread>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <ikos/core/domain/numeric/apron.hpp>
+#include <ikos/core/example/variable_factory.hpp>
+#include <ikos/core/number/z_number.hpp>
+
+using ZNumber = ikos::core::ZNumber;
+using VariableFactory = ikos::core::example::VariableFactory;
+using Variable = ikos::core::example::VariableFactory::VariableRef;
+using VariableExpr = ikos::core::VariableExpression< ZNumber, Variable >;
+using Bound = ikos::core::ZBound;
+using Interval = ikos::core::numeric::ZInterval;
+using ApronDomain = ikos::core::numeric::ApronDomain<
+    ikos::core::numeric::apron::PolkaPolyhedra,
+    ZNumber,
+    Variable >;
+
+BOOST_AUTO_TEST_CASE(threads) {
+  VariableFactory vfac;
+  Variable x(vfac.get("x"));
+  Variable y(vfac.get("y"));
+  Variable z(vfac.get("z"));
+
+  // Created by the manager of the main thread
+  auto shared = ApronDomain::top();
+  shared.assign(x, 1);
+  shared.add(VariableExpr(y) >= VariableExpr(x));
+  shared.add(VariableExpr(y) <= 10);
+
+  const int num_threads = 4;
+  std::vector< ApronDomain > results(num_threads, ApronDomain::bottom());
+  std::vector< std::thread > threads;
+  for (int i = 0; i < num_threads; i++) {
+    threads.emplace_back([&shared, &results, i, x, y, z] {
+      // Each thread copies and joins the shared value, then modifies it
+      auto inv = ApronDomain::bottom();
+      for (int j = 0; j < 100; j++) {
+        auto tmp = shared;
+        tmp.assign(z, VariableExpr(x) + i);
+        tmp.add(VariableExpr(y) <= VariableExpr(x) + j);
+        inv.join_with(tmp);
+      }
+      results[i] = std::move(inv);
+    });
+  }
+  for (std::thread& t : threads) {
+    t.join();
+  }
+
+  // Values created by other threads are used by the main thread
+  auto inv = ApronDomain::bottom();
+  for (int i = 0; i < num_threads; i++) {
+    BOOST_CHECK(results[i].to_interval(x) == Interval(1));
+    BOOST_CHECK(results[i].to_interval(y) == Interval(Bound(1), Bound(10)));
+    BOOST_CHECK(results[i].to_interval(z) == Interval(1 + i));
+    inv.join_with(results[i]);
+  }
+  BOOST_CHECK(inv.to_interval(z) == Interval(Bound(1), Bound(num_threads)));
+  BOOST_CHECK(inv.leq(shared.join(inv)));
+  BOOST_CHECK(!shared.leq(inv));
+}
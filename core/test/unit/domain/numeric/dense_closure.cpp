@@ -0,0 +1,221 @@
+/*******************************************************************************
+ *
+ * Tests for the dense closure kernels
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#define BOOST_TEST_MODULE test_dense_closure
+#define BOOST_TEST_DYN_LINK
+#include <random>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <ikos/core/domain/numeric/dense_closure.hpp>
+#include <ikos/core/number/z_number.hpp>
+
+using ZNumber = ikos::core::ZNumber;
+using Bound = ikos::core::ZBound;
+using Weight = ikos::core::numeric::dense_closure::Weight;
+using Result = ikos::core::numeric::dense_closure::Result;
+using Kernels = ikos::core::numeric::dense_closure::detail::Kernels;
+
+namespace dense_closure = ikos::core::numeric::dense_closure;
+
+namespace {
+
+const Weight Inf = dense_closure::PlusInfinity;
+
+/// \brief Return all the kernels supported by the host
+std::vector< Kernels > all_kernels() {
+  return {dense_closure::detail::scalar_kernels(),
+          dense_closure::detail::sse42_kernels(),
+          dense_closure::detail::avx2_kernels()};
+}
+
+/// \brief Return a random matrix of size n x n
+std::vector< Weight > random_matrix(std::mt19937& rng, std::size_t n) {
+  std::vector< Weight > m(n * n);
+  for (Weight& w : m) {
+    w = (rng() % 3 == 0) ? Inf : static_cast< Weight >(rng() % 41) - 10;
+  }
+  return m;
+}
+
+std::vector< Bound > to_bounds(const std::vector< Weight >& m) {
+  std::vector< Bound > r;
+  for (Weight w : m) {
+    r.push_back(dense_closure::to_bound(w));
+  }
+  return r;
+}
+
+/// \brief Floyd-Warshall algorithm on bounds, as in DBM
+void bound_floyd_warshall(std::vector< Bound >& m, std::size_t n) {
+  for (std::size_t k = 0; k < n; k++) {
+    for (std::size_t i = 0; i < n; i++) {
+      for (std::size_t j = 0; j < n; j++) {
+        m[n * i + j] = min(m[n * i + j], m[n * i + k] + m[n * k + j]);
+      }
+    }
+  }
+}
+
+/// \brief One step of the strong closure on bounds, as in Octagon
+void bound_octagon_strong_closure_step(std::vector< Bound >& m,
+                                       std::size_t n,
+                                       std::size_t v) {
+  std::size_t p = 2 * v;
+  std::size_t q = 2 * v + 1;
+  for (std::size_t i = 0; i < n; i++) {
+    for (std::size_t j = 0; j < n; j++) {
+      m[n * i + j] =
+          min(m[n * i + j],
+              min(m[n * i + p] + m[n * p + j],
+                  min(m[n * i + q] + m[n * q + j],
+                      min(m[n * i + p] + m[n * p + q] + m[n * q + j],
+                          m[n * i + q] + m[n * q + p] + m[n * p + j]))));
+    }
+  }
+  for (std::size_t i = 0; i < n; i++) {
+    for (std::size_t j = 0; j < n; j++) {
+      m[n * i + j] = min(m[n * i + j],
+                         (m[n * i + (i ^ 1)] + m[n * (j ^ 1) + j]) / Bound(2));
+    }
+  }
+}
+
+bool has_negative_cycle(const std::vector< Bound >& m, std::size_t n) {
+  for (std::size_t i = 0; i < n; i++) {
+    if (m[n * i + i] < Bound(0)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+} // end anonymous namespace
+
+BOOST_AUTO_TEST_CASE(to_weight) {
+  Weight w;
+  BOOST_CHECK(dense_closure::to_weight(Bound(42), w));
+  BOOST_CHECK(w == 42);
+  BOOST_CHECK(dense_closure::to_weight(Bound::plus_infinity(), w));
+  BOOST_CHECK(w == Inf);
+  BOOST_CHECK(!dense_closure::to_weight(Bound::minus_infinity(), w));
+  BOOST_CHECK(!dense_closure::to_weight(Bound(ZNumber::from_string(
+                                            "100000000000000000000")),
+                                        w));
+  BOOST_CHECK(!dense_closure::to_weight(Bound(ZNumber(Weight(1) << 60)), w));
+
+  BOOST_CHECK(dense_closure::to_bound(Inf) == Bound::plus_infinity());
+  BOOST_CHECK(dense_closure::to_bound(-3) == Bound(-3));
+  BOOST_CHECK(dense_closure::to_bound(Weight(1) << 31) ==
+              Bound(ZNumber(Weight(1) << 31)));
+  BOOST_CHECK(dense_closure::to_bound(-(Weight(1) << 40)) ==
+              Bound(ZNumber(-(Weight(1) << 40))));
+}
+
+BOOST_AUTO_TEST_CASE(floyd_warshall) {
+  std::mt19937 rng(42);
+
+  for (const Kernels& k : all_kernels()) {
+    for (int it = 0; it < 500; it++) {
+      std::size_t n = 1 + rng() % 13;
+      std::vector< Weight > m = random_matrix(rng, n);
+      for (std::size_t i = 0; i < n; i++) {
+        m[n * i + i] = 0;
+      }
+      std::vector< Bound > expected = to_bounds(m);
+      bound_floyd_warshall(expected, n);
+
+      Result result = dense_closure::floyd_warshall(m.data(), n, k);
+      BOOST_CHECK(result != Result::Overflow);
+      BOOST_CHECK((result == Result::NegativeCycle) ==
+                  has_negative_cycle(expected, n));
+      if (result == Result::Closed) {
+        BOOST_CHECK(to_bounds(m) == expected);
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(floyd_warshall_overflow) {
+  std::size_t n = 64;
+  std::vector< Weight > m(n * n, Inf);
+  for (std::size_t i = 0; i < n; i++) {
+    m[n * i + i] = 0;
+    m[n * i + (i + 1) % n] = -dense_closure::MaxInputWeight;
+  }
+
+  for (const Kernels& k : all_kernels()) {
+    std::vector< Weight > tmp = m;
+    BOOST_CHECK(dense_closure::floyd_warshall(tmp.data(), n, k) ==
+                Result::Overflow);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(octagon_strong_closure_step) {
+  std::mt19937 rng(42);
+  std::vector< Weight > diag;
+
+  for (const Kernels& k : all_kernels()) {
+    for (int it = 0; it < 500; it++) {
+      std::size_t n = 2 * (1 + rng() % 7);
+      std::vector< Weight > m = random_matrix(rng, n);
+      for (std::size_t i = 0; i < n; i++) {
+        m[n * i + i] = (rng() % 2 == 0) ? 0 : Inf;
+      }
+      std::vector< Bound > expected = to_bounds(m);
+
+      for (std::size_t v = 0; v < n / 2; v++) {
+        bound_octagon_strong_closure_step(expected, n, v);
+        Result result =
+            dense_closure::octagon_strong_closure_step(m.data(), n, v, diag, k);
+        BOOST_CHECK(result != Result::Overflow);
+        if (result == Result::NegativeCycle) {
+          BOOST_CHECK(has_negative_cycle(to_bounds(m), n));
+          BOOST_CHECK(has_negative_cycle(expected, n));
+          break;
+        }
+        BOOST_CHECK(to_bounds(m) == expected);
+      }
+    }
+  }
+}
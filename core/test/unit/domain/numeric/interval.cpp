@@ -40,6 +40,8 @@
  *
  ******************************************************************************/
 
+#include <array>
+
 #define BOOST_TEST_MODULE test_interval_domain
 #define BOOST_TEST_DYN_LINK
 #include <boost/mpl/list.hpp>
@@ -318,3 +318,32 @@ BOOST_AUTO_TEST_CASE(test_9) {
 
   // TODO(marthaud): Add checks
 }
+
+BOOST_AUTO_TEST_CASE(refine) {
+  VariableFactory vfac;
+  Variable x(vfac.get("x"));
+  Variable y(vfac.get("y"));
+
+  auto inv = Octagon::top();
+  inv.set(x, ZInterval(ZBound(5), ZBound(10)));
+  inv.refine(x, ZInterval(ZBound(7), ZBound(12)));
+  BOOST_CHECK(inv.to_interval(x) == ZInterval(ZBound(7), ZBound(10)));
+
+  // Refine to a disjoint interval below
+  inv.set(x, ZInterval(ZBound(5), ZBound(10)));
+  inv.refine(x, ZInterval(ZBound(0), ZBound(3)));
+  BOOST_CHECK(inv.is_bottom());
+
+  // Refine to a disjoint interval above
+  inv = Octagon::top();
+  inv.set(x, ZInterval(ZBound(5), ZBound(10)));
+  inv.assign(y, x);
+  inv.refine(y, ZInterval(ZBound(11), ZBound(20)));
+  BOOST_CHECK(inv.is_bottom());
+
+  // Contradicting equality constraint
+  inv = Octagon::top();
+  inv.set(x, ZInterval(ZBound(5), ZBound(10)));
+  inv.add(VariableExpr(x) == 3);
+  BOOST_CHECK(inv.is_bottom());
+}
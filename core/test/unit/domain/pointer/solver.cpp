@@ -42,6 +42,12 @@
 
 #define BOOST_TEST_MODULE test_pointer_solver
 #define BOOST_TEST_DYN_LINK
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
 #include <boost/mpl/list.hpp>
 #include <boost/test/unit_test.hpp>
 
@@ -352,3 +358,462 @@ BOOST_AUTO_TEST_CASE(test_4) {
                                                      zero));
   BOOST_CHECK(s.get_memory(nrows) == PointerAbsValue::bottom(64, Unsigned));
 }
+
+BOOST_AUTO_TEST_CASE(test_cycle) {
+  // p = &x;
+  // q = p;
+  // r = q;
+  // p = r;
+  // s = r + 4;
+  // *s = &y;
+  // t = *p;
+
+  VariableFactory vfac;
+  MemoryFactory memfac;
+
+  Variable p(vfac.get("p"));
+  Variable q(vfac.get("q"));
+  Variable r(vfac.get("r"));
+  Variable s(vfac.get("s"));
+  Variable t(vfac.get("t"));
+
+  MemLocation x(memfac.get("x"));
+  MemLocation y(memfac.get("y"));
+
+  ConstraintSystem sys(64, Unsigned);
+  Interval zero(Int(0, 64, Unsigned));
+  Interval four(Int(4, 64, Unsigned));
+
+  sys.add(Assign::create(p, AddrOperand::create(x, zero)));
+  sys.add(Assign::create(q, VarOperand::create(p, zero)));
+  sys.add(Assign::create(r, VarOperand::create(q, zero)));
+  sys.add(Assign::create(p, VarOperand::create(r, zero)));
+  sys.add(Assign::create(s, VarOperand::create(r, four)));
+  sys.add(Store::create(s, AddrOperand::create(y, zero)));
+  sys.add(Load::create(t, VarOperand::create(p, zero)));
+
+  sys.solve();
+
+  PointerAbsValue px(Uninitialized::top(),
+                     Nullity::top(),
+                     PointsToSet{x},
+                     zero);
+  BOOST_CHECK(sys.get_pointer(p) == px);
+  BOOST_CHECK(sys.get_pointer(q) == px);
+  BOOST_CHECK(sys.get_pointer(r) == px);
+  BOOST_CHECK(sys.get_pointer(s) == PointerAbsValue(Uninitialized::top(),
+                                                    Nullity::top(),
+                                                    PointsToSet{x},
+                                                    four));
+  BOOST_CHECK(sys.get_pointer(t) == PointerAbsValue(Uninitialized::top(),
+                                                    Nullity::top(),
+                                                    PointsToSet{y},
+                                                    zero));
+  BOOST_CHECK(sys.get_memory(x) == PointerAbsValue(Uninitialized::top(),
+                                                   Nullity::top(),
+                                                   PointsToSet{y},
+                                                   zero));
+}
+
+BOOST_AUTO_TEST_CASE(test_concurrent) {
+  // Two independent sets of constraints, plus the constraints of test_2
+
+  VariableFactory vfac;
+  MemoryFactory memfac;
+
+  ConstraintSystem s1(64, Unsigned);
+  ConstraintSystem s2(64, Unsigned);
+  Interval zero(Int(0, 64, Unsigned));
+  Interval offset(Int(0, 64, Unsigned), Int(8, 64, Unsigned));
+
+  std::vector< Variable > vars;
+  std::vector< MemLocation > locs;
+  for (int i = 0; i < 3; i++) {
+    std::string suffix = std::to_string(i);
+    Variable a(vfac.get("a" + suffix));
+    Variable b(vfac.get("b" + suffix));
+    Variable c(vfac.get("c" + suffix));
+    Variable d(vfac.get("d" + suffix));
+    MemLocation ma(memfac.get("&a" + suffix));
+    MemLocation mb(memfac.get("&b" + suffix));
+    vars.insert(vars.end(), {a, b, c, d});
+    locs.insert(locs.end(), {ma, mb});
+
+    for (ConstraintSystem* s : {&s1, &s2}) {
+      // a = &a;
+      s->add(Assign::create(a, AddrOperand::create(ma, zero)));
+      // b = &b + [0, 8];
+      s->add(Assign::create(b, AddrOperand::create(mb, offset)));
+      // *a = b;
+      s->add(Store::create(a, VarOperand::create(b, zero)));
+      // c = *a;
+      s->add(Load::create(c, VarOperand::create(a, zero)));
+      // *c = a;
+      s->add(Store::create(c, VarOperand::create(a, zero)));
+      // d = *b;
+      s->add(Load::create(d, VarOperand::create(b, offset)));
+    }
+  }
+
+  s1.solve();
+  s2.concurrent_solve();
+
+  for (Variable v : vars) {
+    BOOST_CHECK(s1.get_pointer(v) == s2.get_pointer(v));
+  }
+  for (MemLocation m : locs) {
+    BOOST_CHECK(s1.get_memory(m) == s2.get_memory(m));
+  }
+  BOOST_CHECK(s2.get_pointer(vars[3]) ==
+              PointerAbsValue(Uninitialized::top(),
+                              Nullity::top(),
+                              PointsToSet{locs[0]},
+                              zero));
+}
+
+namespace {
+
+/// \brief Description of a randomly generated constraint
+struct RandomConstraint {
+  enum Kind { AssignKind, StoreKind, LoadKind };
+
+  Kind kind;
+
+  // Index of the result (assign, load) or pointer (store) variable
+  std::size_t lhs;
+
+  // True if the operand is an address, false if it is a variable
+  bool is_address;
+
+  // Index of the operand variable or memory location
+  std::size_t operand;
+
+  // Offset of the operand
+  uint64_t offset;
+};
+
+/// \brief Generate a random constraint system
+///
+/// Unless `growing` is true, offsets on variable operands of assignments and
+/// stores are zero, so that the least fixpoint is finite and no widening is
+/// required. Otherwise, cycles of assignments increase the offsets until the
+/// widening threshold is reached.
+std::vector< RandomConstraint > random_system(std::mt19937& rng,
+                                              std::size_t num_vars,
+                                              std::size_t num_locs,
+                                              std::size_t num_csts,
+                                              bool growing = false) {
+  std::vector< RandomConstraint > csts;
+  for (std::size_t i = 0; i < num_csts; i++) {
+    RandomConstraint cst;
+    cst.kind = static_cast< RandomConstraint::Kind >(rng() % 3);
+    cst.lhs = rng() % num_vars;
+    cst.is_address = (cst.kind != RandomConstraint::LoadKind) && rng() % 2;
+    cst.operand = cst.is_address ? rng() % num_locs : rng() % num_vars;
+    cst.offset = 0;
+    if (growing || cst.is_address || cst.kind == RandomConstraint::LoadKind) {
+      cst.offset = 4 * (rng() % 3);
+    }
+    csts.push_back(cst);
+  }
+  return csts;
+}
+
+/// \brief Reference solver, iterating over all constraints in a round-robin
+/// fashion until no value changes, as the previous solver did
+///
+/// As in the previous solver, values are widened once the number of rounds
+/// reaches the widening threshold.
+class ReferenceSolver {
+private:
+  const std::vector< Variable >& _vars;
+  const std::vector< MemLocation >& _locs;
+  std::vector< PointerAbsValue > _pointers;
+  std::vector< PointerAbsValue > _memory;
+  std::size_t _widening_threshold;
+  std::size_t _iteration = 0;
+  bool _change_seen = false;
+
+public:
+  ReferenceSolver(const std::vector< Variable >& vars,
+                  const std::vector< MemLocation >& locs,
+                  std::size_t widening_threshold = 50)
+      : _vars(vars),
+        _locs(locs),
+        _pointers(vars.size(), PointerAbsValue::bottom(64, Unsigned)),
+        _memory(locs.size(), PointerAbsValue::bottom(64, Unsigned)),
+        _widening_threshold(widening_threshold) {}
+
+  void solve(const std::vector< RandomConstraint >& csts) {
+    this->_iteration = 0;
+    do {
+      this->_iteration++;
+      this->_change_seen = false;
+      for (const RandomConstraint& cst : csts) {
+        this->process(cst);
+      }
+    } while (this->_change_seen);
+  }
+
+  /// \brief Return true if the values of the given system satisfy all the
+  /// constraints, i.e. the system was solved soundly
+  ///
+  /// This overwrites the values of the reference solver.
+  bool is_post_fixpoint(const std::vector< RandomConstraint >& csts,
+                        ConstraintSystem& s) {
+    for (std::size_t i = 0; i < this->_vars.size(); i++) {
+      this->_pointers[i] = s.get_pointer(this->_vars[i]);
+    }
+    for (std::size_t i = 0; i < this->_locs.size(); i++) {
+      this->_memory[i] = s.get_memory(this->_locs[i]);
+    }
+    this->_change_seen = false;
+    for (const RandomConstraint& cst : csts) {
+      this->process(cst);
+    }
+    return !this->_change_seen;
+  }
+
+  const PointerAbsValue& pointer(std::size_t i) const {
+    return this->_pointers[i];
+  }
+
+  const PointerAbsValue& memory(std::size_t i) const {
+    return this->_memory[i];
+  }
+
+private:
+  PointerAbsValue operand(const RandomConstraint& cst) const {
+    Interval offset(Int(cst.offset, 64, Unsigned));
+    if (cst.is_address) {
+      return PointerAbsValue(Uninitialized::top(),
+                             Nullity::top(),
+                             PointsToSet{this->_locs[cst.operand]},
+                             offset);
+    }
+    PointerAbsValue value = this->_pointers[cst.operand];
+    value.add_offset(offset);
+    return value;
+  }
+
+  std::size_t loc_index(MemLocation m) const {
+    return static_cast< std::size_t >(
+        std::find(this->_locs.begin(), this->_locs.end(), m) -
+        this->_locs.begin());
+  }
+
+  void join(PointerAbsValue& before, const PointerAbsValue& after) {
+    if (!after.leq(before)) {
+      if (this->_iteration < this->_widening_threshold) {
+        before.join_with(after);
+      } else {
+        before.widen_with(after);
+      }
+      this->_change_seen = true;
+    }
+  }
+
+  void process(const RandomConstraint& cst) {
+    switch (cst.kind) {
+      case RandomConstraint::AssignKind: {
+        this->join(this->_pointers[cst.lhs], this->operand(cst));
+      } break;
+      case RandomConstraint::StoreKind: {
+        PointerAbsValue ptr = this->_pointers[cst.lhs];
+        PointerAbsValue value = this->operand(cst);
+        if (ptr.is_bottom()) {
+          return;
+        }
+        for (MemLocation m : ptr.points_to()) {
+          this->join(this->_memory[this->loc_index(m)], value);
+        }
+      } break;
+      case RandomConstraint::LoadKind: {
+        PointerAbsValue ptr = this->operand(cst);
+        if (ptr.is_bottom()) {
+          return;
+        }
+        for (MemLocation m : ptr.points_to()) {
+          PointerAbsValue value = this->_memory[this->loc_index(m)];
+          this->join(this->_pointers[cst.lhs], value);
+        }
+      } break;
+    }
+  }
+
+}; // end class ReferenceSolver
+
+/// \brief Add the given constraints to a constraint system
+void add_constraints(ConstraintSystem& s,
+                     const std::vector< RandomConstraint >& csts,
+                     const std::vector< Variable >& vars,
+                     const std::vector< MemLocation >& locs) {
+  for (const RandomConstraint& cst : csts) {
+    Interval offset(Int(cst.offset, 64, Unsigned));
+    std::unique_ptr< ikos::core::pointer::Operand< Variable, MemLocation > >
+        operand;
+    if (cst.is_address) {
+      operand = AddrOperand::create(locs[cst.operand], offset);
+    } else {
+      operand = VarOperand::create(vars[cst.operand], offset);
+    }
+    switch (cst.kind) {
+      case RandomConstraint::AssignKind: {
+        s.add(Assign::create(vars[cst.lhs], std::move(operand)));
+      } break;
+      case RandomConstraint::StoreKind: {
+        s.add(Store::create(vars[cst.lhs], std::move(operand)));
+      } break;
+      case RandomConstraint::LoadKind: {
+        s.add(Load::create(vars[cst.lhs], std::move(operand)));
+      } break;
+    }
+  }
+}
+
+} // end anonymous namespace
+
+BOOST_AUTO_TEST_CASE(test_random) {
+  VariableFactory vfac;
+  MemoryFactory memfac;
+
+  std::vector< Variable > vars;
+  std::vector< MemLocation > locs;
+  for (int i = 0; i < 12; i++) {
+    vars.push_back(vfac.get("v" + std::to_string(i)));
+  }
+  for (int i = 0; i < 6; i++) {
+    locs.push_back(memfac.get("m" + std::to_string(i)));
+  }
+
+  std::mt19937 rng(42);
+  for (int n = 0; n < 200; n++) {
+    std::vector< RandomConstraint > csts =
+        random_system(rng, vars.size(), locs.size(), 1 + rng() % 30);
+
+    ConstraintSystem s1(64, Unsigned);
+    ConstraintSystem s2(64, Unsigned);
+    add_constraints(s1, csts, vars, locs);
+    add_constraints(s2, csts, vars, locs);
+
+    ReferenceSolver ref(vars, locs);
+    ref.solve(csts);
+    s1.solve();
+    s2.concurrent_solve();
+
+    for (std::size_t i = 0; i < vars.size(); i++) {
+      BOOST_CHECK(s1.get_pointer(vars[i]) == ref.pointer(i));
+      BOOST_CHECK(s2.get_pointer(vars[i]) == ref.pointer(i));
+    }
+    for (std::size_t i = 0; i < locs.size(); i++) {
+      BOOST_CHECK(s1.get_memory(locs[i]) == ref.memory(i));
+      BOOST_CHECK(s2.get_memory(locs[i]) == ref.memory(i));
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_widening) {
+  // Cyclic constraints increasing the offsets, beyond the widening threshold:
+  //
+  // p = &x;
+  // q = p + 4;
+  // *q = p;
+  // r = *p;
+  // p = r + 8;
+
+  VariableFactory vfac;
+  MemoryFactory memfac;
+
+  std::vector< Variable > vars = {vfac.get("p"), vfac.get("q"), vfac.get("r")};
+  std::vector< MemLocation > locs = {memfac.get("x")};
+  std::vector< RandomConstraint > csts = {
+      {RandomConstraint::AssignKind, 0, true, 0, 0},
+      {RandomConstraint::AssignKind, 1, false, 0, 4},
+      {RandomConstraint::StoreKind, 1, false, 0, 0},
+      {RandomConstraint::LoadKind, 2, false, 0, 0},
+      {RandomConstraint::AssignKind, 0, false, 2, 8},
+  };
+
+  ConstraintSystem s1(64, Unsigned);
+  ConstraintSystem s2(64, Unsigned);
+  add_constraints(s1, csts, vars, locs);
+  add_constraints(s2, csts, vars, locs);
+
+  ReferenceSolver ref(vars, locs);
+  ref.solve(csts);
+  s1.solve();
+  s2.concurrent_solve();
+
+  for (std::size_t i = 0; i < vars.size(); i++) {
+    // The offsets are widened to the maximum
+    BOOST_CHECK(s1.get_pointer(vars[i]).offset().ub() ==
+                Int::max(64, Unsigned));
+    BOOST_CHECK(s1.get_pointer(vars[i]).points_to() == PointsToSet{locs[0]});
+    BOOST_CHECK(s1.get_pointer(vars[i]) == ref.pointer(i));
+    BOOST_CHECK(s2.get_pointer(vars[i]) == ref.pointer(i));
+  }
+  BOOST_CHECK(s1.get_memory(locs[0]) == ref.memory(0));
+  BOOST_CHECK(s2.get_memory(locs[0]) == ref.memory(0));
+
+  BOOST_CHECK(ref.is_post_fixpoint(csts, s1));
+  BOOST_CHECK(ref.is_post_fixpoint(csts, s2));
+}
+
+BOOST_AUTO_TEST_CASE(test_random_widening) {
+  VariableFactory vfac;
+  MemoryFactory memfac;
+
+  std::vector< Variable > vars;
+  std::vector< MemLocation > locs;
+  for (int i = 0; i < 12; i++) {
+    vars.push_back(vfac.get("v" + std::to_string(i)));
+  }
+  for (int i = 0; i < 6; i++) {
+    locs.push_back(memfac.get("m" + std::to_string(i)));
+  }
+
+  // Number of systems with an offset widened to the maximum
+  int num_widened = 0;
+
+  std::mt19937 rng(42);
+  for (int n = 0; n < 200; n++) {
+    std::vector< RandomConstraint > csts =
+        random_system(rng, vars.size(), locs.size(), 1 + rng() % 30, true);
+
+    ConstraintSystem s1(64, Unsigned);
+    ConstraintSystem s2(64, Unsigned);
+    add_constraints(s1, csts, vars, locs);
+    add_constraints(s2, csts, vars, locs);
+
+    ReferenceSolver ref(vars, locs);
+    ref.solve(csts);
+    s1.solve();
+    s2.concurrent_solve();
+
+    // Values are only widened on offsets, so the points-to sets are the same
+    // as the ones of the previous solver
+    bool widened = false;
+    for (std::size_t i = 0; i < vars.size(); i++) {
+      const PointerAbsValue& ptr = s1.get_pointer(vars[i]);
+      widened = widened || (!ptr.is_bottom() &&
+                            ptr.offset().ub() == Int::max(64, Unsigned));
+      BOOST_CHECK(s1.get_pointer(vars[i]).points_to() ==
+                  ref.pointer(i).points_to());
+      BOOST_CHECK(s2.get_pointer(vars[i]).points_to() ==
+                  ref.pointer(i).points_to());
+    }
+    for (std::size_t i = 0; i < locs.size(); i++) {
+      BOOST_CHECK(s1.get_memory(locs[i]).points_to() ==
+                  ref.memory(i).points_to());
+      BOOST_CHECK(s2.get_memory(locs[i]).points_to() ==
+                  ref.memory(i).points_to());
+    }
+
+    // Both results satisfy all the constraints
+    BOOST_CHECK(ref.is_post_fixpoint(csts, s1));
+    BOOST_CHECK(ref.is_post_fixpoint(csts, s2));
+    num_widened += widened ? 1 : 0;
+  }
+
+  BOOST_CHECK(num_widened > 0);
+}
@@ -634,3 +634,87 @@ BOOST_AUTO_TEST_CASE(test_z_number) {
   BOOST_CHECK(make_clipped_mask(Z(6), Z(2), Z(2), Z(5)).str(2) == "10000");
   BOOST_CHECK(make_clipped_mask(Z(7), Z(5), Z(2), Z(5)).str(2) == "0");
 }
+
+BOOST_AUTO_TEST_CASE(test_z_number_overflow) {
+  using Z = ikos::core::ZNumber;
+
+  // Results crossing the 64 bits boundary, in both directions
+  const Z max(std::numeric_limits< int64_t >::max());
+  const Z min(std::numeric_limits< int64_t >::min());
+  const Z big = Z::from_string("9223372036854775808"); // 2**63
+
+  BOOST_CHECK(max + 1 == big);
+  BOOST_CHECK(big - 1 == max);
+  BOOST_CHECK((max + 1).str() == "9223372036854775808");
+  BOOST_CHECK((min - 1).str() == "-9223372036854775809");
+  BOOST_CHECK(min - 1 + 1 == min);
+  BOOST_CHECK(-min == big);
+  BOOST_CHECK(-big == min);
+  BOOST_CHECK(min / -1 == big);
+  BOOST_CHECK(min % -1 == 0);
+  BOOST_CHECK(mod(min, Z(-1)) == 0);
+  BOOST_CHECK(mod(Z(-7), min) == Z::from_string("9223372036854775801"));
+  BOOST_CHECK(max * 2 == Z::from_string("18446744073709551614"));
+  BOOST_CHECK(max * 2 / 2 == max);
+  BOOST_CHECK(max * max / max == max);
+  BOOST_CHECK(min * -1 == big);
+  BOOST_CHECK((Z(1) << 62) * 2 == big);
+  BOOST_CHECK(Z(1) << 63 == big);
+  BOOST_CHECK(Z(-1) << 63 == min);
+  BOOST_CHECK(Z(-1) << 64 == min * 2);
+  BOOST_CHECK((Z(3) << 100) >> 100 == 3);
+  BOOST_CHECK(min >> 63 == -1);
+  BOOST_CHECK(min >> 100 == -1);
+  BOOST_CHECK(Z(-5) >> 1 == -3);
+  BOOST_CHECK((big & max) == 0);
+  BOOST_CHECK((big | max) == big * 2 - 1);
+  BOOST_CHECK((big ^ big) == 0);
+
+  BOOST_CHECK(++Z(max) == big);
+  BOOST_CHECK(--Z(big) == max);
+  BOOST_CHECK(--Z(min) == min - 1);
+  BOOST_CHECK(++(min - 1) == min);
+
+  // Comparisons between small and large integers
+  BOOST_CHECK(max < big);
+  BOOST_CHECK(!(big < max));
+  BOOST_CHECK(min - 1 < min);
+  BOOST_CHECK(min - 1 < big);
+  BOOST_CHECK(big > 0);
+  BOOST_CHECK(-big - 1 < 0);
+  BOOST_CHECK(big != max);
+  BOOST_CHECK(big - 1 == max);
+  BOOST_CHECK(std::numeric_limits< unsigned long long >::max() ==
+              big * 2 - 1);
+
+  // Utility functions
+  BOOST_CHECK(gcd(min, Z(0)) == big);
+  BOOST_CHECK(gcd(min, Z(6)) == 2);
+  BOOST_CHECK(lcm(max, Z(2)) == max * 2);
+  BOOST_CHECK(lcm(Z(-4), Z(6)) == 12);
+  BOOST_CHECK(abs(min) == big);
+  BOOST_CHECK(min.size_in_bits() == 64);
+  BOOST_CHECK(big.size_in_bits() == 64);
+  BOOST_CHECK(max.size_in_bits() == 63);
+  BOOST_CHECK(min.trailing_zeros() == 63);
+  BOOST_CHECK(big.trailing_zeros() == 63);
+  BOOST_CHECK(Z(-2).trailing_ones() == 0);
+  BOOST_CHECK(max.trailing_ones() == 63);
+  BOOST_CHECK(max.next_power_of_2() == big);
+  BOOST_CHECK(!big.fits< long long >());
+  BOOST_CHECK(big.fits< unsigned long long >());
+  BOOST_CHECK(!min.fits< unsigned long long >());
+  BOOST_CHECK(!Z(-1).fits< unsigned int >());
+  BOOST_CHECK(!Z(std::numeric_limits< unsigned int >::max() + 1UL)
+                   .fits< unsigned int >());
+  BOOST_CHECK(hash_value(big - 1) == hash_value(max));
+  BOOST_CHECK(hash_value(max + 1) == hash_value(big));
+
+  // Self assignment operations
+  Z x = big;
+  x -= x;
+  BOOST_CHECK(x == 0);
+  x = max;
+  x += x;
+  BOOST_CHECK(x == max * 2);
+}
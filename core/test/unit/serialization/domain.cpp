@@ -0,0 +1,420 @@
+/*******************************************************************************
+ *
+ * Tests for the serialization of abstract domains
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2018-2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#include <algorithm>
+#include <map>
+#include <stdexcept>
+
+#define BOOST_TEST_MODULE test_serialization_domain
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <ikos/core/domain/machine_int/dbm.hpp>
+#include <ikos/core/example/memory_factory.hpp>
+#include <ikos/core/example/scalar/variable_factory.hpp>
+#include <ikos/core/example/variable_factory.hpp>
+#include <ikos/core/number/z_number.hpp>
+#include <ikos/core/serialization/domain.hpp>
+#include <ikos/core/serialization/memory.hpp>
+
+using ZNumber = ikos::core::ZNumber;
+using ZBound = ikos::core::ZBound;
+using VariableFactory = ikos::core::example::VariableFactory;
+using Variable = ikos::core::example::VariableFactory::VariableRef;
+using VariableExpr = ikos::core::VariableExpression< ZNumber, Variable >;
+using LinearConstraint = ikos::core::LinearConstraint< ZNumber, Variable >;
+using LinearConstraintSystem =
+    ikos::core::LinearConstraintSystem< ZNumber, Variable >;
+using ZInterval = ikos::core::numeric::ZInterval;
+using ZCongruence = ikos::core::numeric::ZCongruence;
+using Nullity = ikos::core::Nullity;
+using Map = ikos::core::PatriciaTreeMap< Variable, ZInterval >;
+using Set = ikos::core::PatriciaTreeSet< Variable >;
+using SeparateDomain = ikos::core::SeparateDomain< Variable, ZInterval >;
+using IntervalDomain = ikos::core::numeric::IntervalDomain< ZNumber, Variable >;
+using CongruenceDomain =
+    ikos::core::numeric::CongruenceDomain< ZNumber, Variable >;
+using NullityDomain = ikos::core::nullity::SeparateDomain< Variable >;
+using DBM = ikos::core::numeric::DBM< ZNumber, Variable >;
+using SplitDBM = ikos::core::numeric::SplitDBM< ZNumber, Variable >;
+using Octagon = ikos::core::numeric::Octagon< ZNumber, Variable >;
+using Gauge = ikos::core::numeric::Gauge< ZNumber, Variable >;
+using GaugeDomain = ikos::core::numeric::GaugeDomain< ZNumber, Variable >;
+using Int = ikos::core::MachineInt;
+using IntInterval = ikos::core::machine_int::Interval;
+using ScalarVariableFactory = ikos::core::example::scalar::VariableFactory;
+using ScalarVariable = ScalarVariableFactory::VariableRef;
+using MemoryFactory = ikos::core::example::MemoryFactory;
+using MemoryLocation = MemoryFactory::MemoryLocationRef;
+using Literal = ikos::core::Literal< ScalarVariable, MemoryLocation >;
+using MachIntIntervalDomain =
+    ikos::core::machine_int::IntervalDomain< ScalarVariable >;
+using MachIntDBM = ikos::core::machine_int::DBM< ScalarVariable >;
+using MachIntPolymorphicDomain =
+    ikos::core::machine_int::PolymorphicDomain< ScalarVariable >;
+using UninitializedDomain =
+    ikos::core::uninitialized::SeparateDomain< ScalarVariable >;
+using ScalarNullityDomain = ikos::core::nullity::SeparateDomain< ScalarVariable >;
+using CompositeDomain =
+    ikos::core::scalar::CompositeDomain< ScalarVariable,
+                                         MemoryLocation,
+                                         UninitializedDomain,
+                                         MachIntPolymorphicDomain,
+                                         ScalarNullityDomain >;
+using LifetimeDomain = ikos::core::lifetime::SeparateDomain< MemoryLocation >;
+using ValueDomain = ikos::core::memory::ValueDomain< ScalarVariable,
+                                                     MemoryLocation,
+                                                     ScalarVariableFactory*,
+                                                     CompositeDomain,
+                                                     LifetimeDomain >;
+using MemoryPolymorphicDomain =
+    ikos::core::memory::PolymorphicDomain< ScalarVariable, MemoryLocation >;
+using ExceptionDomain =
+    ikos::core::exception::ExceptionDomain< MemoryPolymorphicDomain >;
+using Index = ikos::core::Index;
+using ikos::core::Signed;
+using ikos::core::Unsigned;
+using ikos::core::serialization::deserialize;
+using ikos::core::serialization::SerializationError;
+using ikos::core::serialization::serialize;
+using ikos::core::serialization::Tag;
+
+/// \brief Map indexes back to variables
+class Resolver {
+private:
+  std::map< Index, Variable > _vars;
+
+public:
+  void add(Variable v) { this->_vars.emplace(v->index(), v); }
+
+  Variable operator()(Index i, Tag< Variable >) const {
+    return this->_vars.at(i);
+  }
+};
+
+template < typename T >
+T round_trip(const T& value, const Resolver& resolver) {
+  return deserialize< T >(serialize(value), resolver);
+}
+
+/// \brief Fixture creating a few variables
+struct Variables {
+  VariableFactory vfac;
+  Variable x;
+  Variable y;
+  Variable z;
+  Resolver resolver;
+
+  Variables() : x(vfac.get("x")), y(vfac.get("y")), z(vfac.get("z")) {
+    resolver.add(x);
+    resolver.add(y);
+    resolver.add(z);
+  }
+};
+
+BOOST_FIXTURE_TEST_CASE(patricia_tree, Variables) {
+  Map map;
+  BOOST_CHECK(round_trip(map, resolver).empty());
+  map.insert_or_assign(x, ZInterval(1));
+  map.insert_or_assign(z, ZInterval(ZBound(2), ZBound::plus_infinity()));
+  Map map2 = round_trip(map, resolver);
+  BOOST_CHECK(map2.size() == 2);
+  BOOST_CHECK(*map2.at(x) == ZInterval(1));
+  BOOST_CHECK(*map2.at(z) == ZInterval(ZBound(2), ZBound::plus_infinity()));
+
+  Set set{x, y};
+  BOOST_CHECK(round_trip(set, resolver).equals(set));
+  BOOST_CHECK(round_trip(Set(), resolver).empty());
+}
+
+BOOST_FIXTURE_TEST_CASE(linear_constraints, Variables) {
+  LinearConstraintSystem csts{VariableExpr(x) - VariableExpr(y) <= 3,
+                              2 * VariableExpr(x) + VariableExpr(z) == 7,
+                              VariableExpr(y) != -1};
+  LinearConstraintSystem csts2 = round_trip(csts, resolver);
+  BOOST_REQUIRE(csts2.size() == 3);
+  auto it = csts.begin();
+  auto it2 = csts2.begin();
+  for (; it != csts.end(); ++it, ++it2) {
+    BOOST_CHECK(it->kind() == it2->kind());
+    BOOST_CHECK(it->constant() == it2->constant());
+    BOOST_CHECK(it->num_terms() == it2->num_terms());
+    BOOST_CHECK(std::equal(it->begin(), it->end(), it2->begin()));
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE(separate_domain, Variables) {
+  BOOST_CHECK(round_trip(SeparateDomain::top(), resolver).is_top());
+  BOOST_CHECK(round_trip(SeparateDomain::bottom(), resolver).is_bottom());
+  auto inv = SeparateDomain::top();
+  inv.set(x, ZInterval(1));
+  inv.set(y, ZInterval(ZBound(0), ZBound(10)));
+  BOOST_CHECK(round_trip(inv, resolver) == inv);
+}
+
+BOOST_FIXTURE_TEST_CASE(interval_domain, Variables) {
+  BOOST_CHECK(round_trip(IntervalDomain::top(), resolver).is_top());
+  BOOST_CHECK(round_trip(IntervalDomain::bottom(), resolver).is_bottom());
+  auto inv = IntervalDomain::top();
+  inv.set(x, ZInterval(ZBound::minus_infinity(), ZBound(4)));
+  inv.set(z, ZInterval(ZBound(1) << ZBound(90), ZBound::plus_infinity()));
+  BOOST_CHECK(round_trip(inv, resolver) == inv);
+}
+
+BOOST_FIXTURE_TEST_CASE(congruence_domain, Variables) {
+  auto inv = CongruenceDomain::top();
+  inv.set(x, ZCongruence(ZNumber(4), ZNumber(1)));
+  inv.set(y, ZCongruence(ZNumber(12)));
+  BOOST_CHECK(round_trip(inv, resolver) == inv);
+  BOOST_CHECK(round_trip(CongruenceDomain::bottom(), resolver).is_bottom());
+}
+
+BOOST_FIXTURE_TEST_CASE(nullity_domain, Variables) {
+  auto inv = NullityDomain::top();
+  inv.set(x, Nullity::null());
+  inv.set(y, Nullity::non_null());
+  BOOST_CHECK(round_trip(inv, resolver) == inv);
+  BOOST_CHECK(round_trip(NullityDomain::bottom(), resolver).is_bottom());
+}
+
+template < typename Domain >
+void check_relational(const Variables& vars) {
+  Variable x = vars.x;
+  Variable y = vars.y;
+  Variable z = vars.z;
+
+  BOOST_CHECK(round_trip(Domain::top(), vars.resolver).is_top());
+  BOOST_CHECK(round_trip(Domain::bottom(), vars.resolver).is_bottom());
+
+  auto inv = Domain::top();
+  inv.set(x, ZInterval(ZBound(0), ZBound(10)));
+  inv.add(VariableExpr(y) - VariableExpr(x) <= 2);
+  inv.add(VariableExpr(x) - VariableExpr(y) <= 1);
+  inv.add(VariableExpr(z) >= 5);
+  auto inv2 = round_trip(inv, vars.resolver);
+  BOOST_CHECK(inv2 == inv);
+  BOOST_CHECK(inv2.to_interval(y) == inv.to_interval(y));
+}
+
+BOOST_FIXTURE_TEST_CASE(dbm, Variables) {
+  check_relational< DBM >(*this);
+}
+
+BOOST_FIXTURE_TEST_CASE(split_dbm, Variables) {
+  check_relational< SplitDBM >(*this);
+}
+
+BOOST_FIXTURE_TEST_CASE(octagon, Variables) {
+  check_relational< Octagon >(*this);
+}
+
+BOOST_FIXTURE_TEST_CASE(gauge_domain, Variables) {
+  BOOST_CHECK(round_trip(GaugeDomain::top(), resolver).is_top());
+  BOOST_CHECK(round_trip(GaugeDomain::bottom(), resolver).is_bottom());
+
+  auto inv1 = GaugeDomain::top();
+  inv1.counter_init(x, ZNumber(0));
+  inv1.assign(y, 0);
+  inv1.assign(z, 1);
+  auto inv2 = inv1;
+  inv2.counter_incr(x, ZNumber(1));
+  inv2.assign(y, VariableExpr(y) + 2);
+  auto inv3 = inv1.widening_threshold(inv2, ZNumber(10));
+  auto inv4 = round_trip(inv3, resolver);
+  BOOST_CHECK(inv4 == inv3);
+  BOOST_CHECK(inv4.to_gauge(y) == inv3.to_gauge(y));
+  BOOST_CHECK(inv4.to_gauge(z) == Gauge(1));
+
+  // The loop counter is kept
+  inv3.counter_incr(x, ZNumber(1));
+  inv4.counter_incr(x, ZNumber(1));
+  BOOST_CHECK(inv4 == inv3);
+}
+
+/// \brief Map indexes back to scalar variables and memory locations
+class MemoryResolver {
+private:
+  std::map< Index, ScalarVariable > _vars;
+  std::map< Index, MemoryLocation > _mem_locs;
+
+public:
+  void add(ScalarVariable v) {
+    this->_vars.emplace(v->index(), v);
+    if (v->kind() == ScalarVariableFactory::PointerVariableKind ||
+        v->kind() == ScalarVariableFactory::DynamicVariableKind) {
+      this->_vars.emplace(v->offset_var()->index(), v->offset_var());
+    }
+  }
+
+  void add(MemoryLocation m) { this->_mem_locs.emplace(m->index(), m); }
+
+  ScalarVariable operator()(Index i, Tag< ScalarVariable >) const {
+    return this->_vars.at(i);
+  }
+
+  MemoryLocation operator()(Index i, Tag< MemoryLocation >) const {
+    return this->_mem_locs.at(i);
+  }
+};
+
+/// \brief Fixture creating the memory abstract domain used by the analyzer
+struct Memory {
+  ScalarVariableFactory vfac;
+  MemoryFactory mfac;
+  ScalarVariable i;
+  ScalarVariable j;
+  ScalarVariable p;
+  MemoryLocation a;
+  MemoryResolver resolver;
+
+  Memory()
+      : i(vfac.get_int("i", 32, Signed)),
+        j(vfac.get_int("j", 32, Signed)),
+        p(vfac.get_pointer("p", 64, Unsigned)),
+        a(mfac.get("a")) {
+    resolver.add(i);
+    resolver.add(j);
+    resolver.add(p);
+    resolver.add(a);
+  }
+
+  CompositeDomain make_scalar(bool top) {
+    if (top) {
+      return CompositeDomain(UninitializedDomain::top(),
+                             MachIntPolymorphicDomain(
+                                 MachIntIntervalDomain::top()),
+                             ScalarNullityDomain::top());
+    } else {
+      return CompositeDomain(UninitializedDomain::bottom(),
+                             MachIntPolymorphicDomain(
+                                 MachIntIntervalDomain::bottom()),
+                             ScalarNullityDomain::bottom());
+    }
+  }
+
+  MemoryPolymorphicDomain make_memory(bool top) {
+    return MemoryPolymorphicDomain(
+        ValueDomain(&vfac,
+                    make_scalar(top),
+                    top ? LifetimeDomain::top() : LifetimeDomain::bottom()));
+  }
+
+  ExceptionDomain make_initial() {
+    return ExceptionDomain(make_memory(true),
+                           make_memory(false),
+                           make_memory(false));
+  }
+};
+
+template < typename T >
+T round_trip(const T& value, const MemoryResolver& resolver) {
+  return deserialize(serialize(value), resolver, value);
+}
+
+BOOST_FIXTURE_TEST_CASE(machine_int_domain, Memory) {
+  auto inv = MachIntIntervalDomain::top();
+  inv.set(i, IntInterval(Int(0, 32, Signed), Int(10, 32, Signed)));
+  inv.set(j, IntInterval(Int(-1, 32, Signed)));
+  BOOST_CHECK(deserialize< MachIntIntervalDomain >(serialize(inv), resolver) ==
+              inv);
+
+  auto poly = MachIntPolymorphicDomain(inv);
+  auto poly2 = round_trip(poly, resolver);
+  BOOST_CHECK(poly2.equals(poly));
+  BOOST_CHECK(poly2.to_interval(i) == inv.to_interval(i));
+  auto bottom = MachIntPolymorphicDomain(MachIntIntervalDomain::bottom());
+  BOOST_CHECK(round_trip(bottom, resolver).is_bottom());
+
+  // The runtime domain is taken from the prototype
+  BOOST_CHECK(
+      deserialize(serialize(poly), resolver, bottom).to_interval(j) ==
+      IntInterval(Int(-1, 32, Signed)));
+
+  // Domains without serializer throw
+  auto dbm = MachIntPolymorphicDomain(MachIntDBM::top());
+  BOOST_CHECK_THROW(serialize(dbm), SerializationError);
+  BOOST_CHECK_THROW(deserialize(serialize(poly), resolver, dbm),
+                    SerializationError);
+}
+
+BOOST_FIXTURE_TEST_CASE(scalar_domain, Memory) {
+  BOOST_CHECK(round_trip(make_scalar(true), resolver).is_top());
+  BOOST_CHECK(round_trip(make_scalar(false), resolver).is_bottom());
+
+  auto inv = make_scalar(true);
+  inv.int_assign(i, Int(3, 32, Signed));
+  inv.int_assign_undef(j);
+  inv.pointer_assign(p, a, Nullity::non_null());
+  auto inv2 = round_trip(inv, resolver);
+  BOOST_CHECK(inv2.equals(inv));
+  BOOST_CHECK(inv2.int_to_interval(i) == IntInterval(Int(3, 32, Signed)));
+  BOOST_CHECK(inv2.uninit_is_uninitialized(j));
+  BOOST_CHECK(inv2.nullity_to_nullity(p).is_non_null());
+}
+
+BOOST_FIXTURE_TEST_CASE(value_abstract_domain, Memory) {
+  BOOST_CHECK(round_trip(make_initial(), resolver).equals(make_initial()));
+  BOOST_CHECK(round_trip(make_memory(false), resolver).is_bottom());
+
+  auto inv = make_initial();
+  inv.normal().lifetime_assign_allocated(a);
+  inv.normal().pointer_assign(p, a, Nullity::non_null());
+  inv.normal().mem_write(p,
+                         Literal::machine_int(Int(7, 32, Signed)),
+                         Int(4, 64, Unsigned));
+  inv.normal().int_assign(i, Int(3, 32, Signed));
+  resolver.add(vfac.get_cell(a, Int(0, 64, Unsigned), Int(4, 64, Unsigned), Signed));
+
+  auto inv2 = round_trip(inv, resolver);
+  BOOST_CHECK(inv2.equals(inv));
+  BOOST_CHECK(inv2.caught_exceptions().is_bottom());
+  BOOST_CHECK(inv2.normal().int_to_interval(i) ==
+              IntInterval(Int(3, 32, Signed)));
+
+  // The memory cells are kept
+  inv2.normal().mem_read(Literal::machine_int_var(j), p, Int(4, 64, Unsigned));
+  BOOST_CHECK(inv2.normal().int_to_interval(j) ==
+              IntInterval(Int(7, 32, Signed)));
+
+  // Unknown references are reported by the resolver
+  BOOST_CHECK_THROW(round_trip(inv, MemoryResolver()), std::out_of_range);
+}
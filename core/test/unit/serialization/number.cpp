@@ -0,0 +1,166 @@
+/*******************************************************************************
+ *
+ * Tests for the serialization of numbers
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2018-2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#include <limits>
+
+#define BOOST_TEST_MODULE test_serialization_number
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <ikos/core/number/bound.hpp>
+#include <ikos/core/number/machine_int.hpp>
+#include <ikos/core/number/q_number.hpp>
+#include <ikos/core/number/z_number.hpp>
+#include <ikos/core/serialization/number.hpp>
+
+using ZNumber = ikos::core::ZNumber;
+using QNumber = ikos::core::QNumber;
+using ZBound = ikos::core::ZBound;
+using QBound = ikos::core::QBound;
+using MachineInt = ikos::core::MachineInt;
+using SerializationError = ikos::core::serialization::SerializationError;
+using ikos::core::Signed;
+using ikos::core::Unsigned;
+using ikos::core::serialization::deserialize;
+using ikos::core::serialization::serialize;
+
+template < typename T >
+T round_trip(const T& value) {
+  return deserialize< T >(serialize(value));
+}
+
+BOOST_AUTO_TEST_CASE(z_number) {
+  BOOST_CHECK(round_trip(ZNumber(0)) == ZNumber(0));
+  BOOST_CHECK(round_trip(ZNumber(1)) == ZNumber(1));
+  BOOST_CHECK(round_trip(ZNumber(-1)) == ZNumber(-1));
+  BOOST_CHECK(round_trip(ZNumber(127)) == ZNumber(127));
+  BOOST_CHECK(round_trip(ZNumber(-128)) == ZNumber(-128));
+
+  ZNumber min(std::numeric_limits< int64_t >::min());
+  ZNumber max(std::numeric_limits< int64_t >::max());
+  BOOST_CHECK(round_trip(min) == min);
+  BOOST_CHECK(round_trip(max) == max);
+  BOOST_CHECK(round_trip(min - 1) == min - 1);
+  BOOST_CHECK(round_trip(max + 1) == max + 1);
+
+  ZNumber big = ZNumber(1) << 100;
+  BOOST_CHECK(round_trip(big) == big);
+  BOOST_CHECK(round_trip(-big) == -big);
+  BOOST_CHECK(round_trip(big + 3) == big + 3);
+}
+
+BOOST_AUTO_TEST_CASE(compact_encoding) {
+  // magic (4 bytes) + version (1 byte) + kind (1 byte) + value (1 byte)
+  BOOST_CHECK(serialize(ZNumber(0)).size() == 7);
+  BOOST_CHECK(serialize(ZNumber(-64)).size() == 7);
+  BOOST_CHECK(serialize(ZNumber(64)).size() == 8);
+
+  // 2^100 takes 13 bytes, plus 1 byte for the size
+  BOOST_CHECK(serialize(ZNumber(1) << 100).size() == 5 + 1 + 1 + 13);
+}
+
+BOOST_AUTO_TEST_CASE(q_number) {
+  BOOST_CHECK(round_trip(QNumber(0)) == QNumber(0));
+  BOOST_CHECK(round_trip(QNumber(-5)) == QNumber(-5));
+  QNumber third(mpq_class(1, 3));
+  BOOST_CHECK(round_trip(third) == third);
+  QNumber q(mpq_class(-7, 2));
+  BOOST_CHECK(round_trip(q) == q);
+  QNumber big(mpq_class((ZNumber(1) << 80).mpz(), (ZNumber(3) << 70).mpz()));
+  BOOST_CHECK(round_trip(big) == big);
+}
+
+BOOST_AUTO_TEST_CASE(bound) {
+  BOOST_CHECK(round_trip(ZBound(42)) == ZBound(42));
+  BOOST_CHECK(round_trip(ZBound::plus_infinity()) == ZBound::plus_infinity());
+  BOOST_CHECK(round_trip(ZBound::minus_infinity()) ==
+              ZBound::minus_infinity());
+  BOOST_CHECK(round_trip(QBound(QNumber(mpq_class(1, 2)))) ==
+              QBound(QNumber(mpq_class(1, 2))));
+  BOOST_CHECK(round_trip(QBound::plus_infinity()) == QBound::plus_infinity());
+}
+
+BOOST_AUTO_TEST_CASE(machine_int) {
+  MachineInt x(-3, 8, Signed);
+  BOOST_CHECK(round_trip(x) == x);
+  MachineInt y(200, 8, Unsigned);
+  BOOST_CHECK(round_trip(y) == y);
+  BOOST_CHECK(round_trip(y).sign() == Unsigned);
+  BOOST_CHECK(round_trip(y).bit_width() == 8);
+  MachineInt z = MachineInt::max(128, Unsigned);
+  BOOST_CHECK(round_trip(z) == z);
+  MachineInt w = MachineInt::min(64, Signed);
+  BOOST_CHECK(round_trip(w) == w);
+}
+
+BOOST_AUTO_TEST_CASE(malformed_data) {
+  std::string data = serialize(ZNumber(1) << 100);
+
+  // Wrong magic
+  std::string bad_magic = data;
+  bad_magic[0] = 'X';
+  BOOST_CHECK_THROW(deserialize< ZNumber >(bad_magic), SerializationError);
+
+  // Wrong version
+  std::string bad_version = data;
+  bad_version[4] = 42;
+  BOOST_CHECK_THROW(deserialize< ZNumber >(bad_version), SerializationError);
+
+  // Truncated
+  for (std::size_t i = 0; i < data.size(); i++) {
+    BOOST_CHECK_THROW(deserialize< ZNumber >(data.substr(0, i)),
+                      SerializationError);
+  }
+
+  // Trailing data
+  BOOST_CHECK_THROW(deserialize< ZNumber >(data + "x"), SerializationError);
+
+  // Invalid kind
+  std::string bad_kind = data;
+  bad_kind[5] = 3;
+  BOOST_CHECK_THROW(deserialize< ZNumber >(bad_kind), SerializationError);
+
+  // Zero bit-width
+  std::string bad_width = serialize(MachineInt(1, 8, Signed));
+  bad_width[5] = 0;
+  BOOST_CHECK_THROW(deserialize< MachineInt >(bad_width), SerializationError);
+}
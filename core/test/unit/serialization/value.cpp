@@ -0,0 +1,230 @@
+/*******************************************************************************
+ *
+ * Tests for the serialization of non-relational values
+ *
+ * Author: Maxime Arthaud
+ *
+ * Contact: ikos@lists.nasa.gov
+ *
+ * Notices:
+ *
+ * Copyright (c) 2018-2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Disclaimers:
+ *
+ * No Warranty: THE SUBJECT SOFTWARE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY OF
+ * ANY KIND, EITHER EXPRESSED, IMPLIED, OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ * TO, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL CONFORM TO SPECIFICATIONS,
+ * ANY IMPLIED WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * OR FREEDOM FROM INFRINGEMENT, ANY WARRANTY THAT THE SUBJECT SOFTWARE WILL BE
+ * ERROR FREE, OR ANY WARRANTY THAT DOCUMENTATION, IF PROVIDED, WILL CONFORM TO
+ * THE SUBJECT SOFTWARE. THIS AGREEMENT DOES NOT, IN ANY MANNER, CONSTITUTE AN
+ * ENDORSEMENT BY GOVERNMENT AGENCY OR ANY PRIOR RECIPIENT OF ANY RESULTS,
+ * RESULTING DESIGNS, HARDWARE, SOFTWARE PRODUCTS OR ANY OTHER APPLICATIONS
+ * RESULTING FROM USE OF THE SUBJECT SOFTWARE.  FURTHER, GOVERNMENT AGENCY
+ * DISCLAIMS ALL WARRANTIES AND LIABILITIES REGARDING THIRD-PARTY SOFTWARE,
+ * IF PRESENT IN THE ORIGINAL SOFTWARE, AND DISTRIBUTES IT "AS IS."
+ *
+ * Waiver and Indemnity:  RECIPIENT AGREES TO WAIVE ANY AND ALL CLAIMS AGAINST
+ * THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS, AS WELL
+ * AS ANY PRIOR RECIPIENT.  IF RECIPIENT'S USE OF THE SUBJECT SOFTWARE RESULTS
+ * IN ANY LIABILITIES, DEMANDS, DAMAGES, EXPENSES OR LOSSES ARISING FROM SUCH
+ * USE, INCLUDING ANY DAMAGES FROM PRODUCTS BASED ON, OR RESULTING FROM,
+ * RECIPIENT'S USE OF THE SUBJECT SOFTWARE, RECIPIENT SHALL INDEMNIFY AND HOLD
+ * HARMLESS THE UNITED STATES GOVERNMENT, ITS CONTRACTORS AND SUBCONTRACTORS,
+ * AS WELL AS ANY PRIOR RECIPIENT, TO THE EXTENT PERMITTED BY LAW.
+ * RECIPIENT'S SOLE REMEDY FOR ANY SUCH MATTER SHALL BE THE IMMEDIATE,
+ * UNILATERAL TERMINATION OF THIS AGREEMENT.
+ *
+ ******************************************************************************/
+
+#include <map>
+
+#define BOOST_TEST_MODULE test_serialization_value
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <ikos/core/example/memory_factory.hpp>
+#include <ikos/core/example/variable_factory.hpp>
+#include <ikos/core/number/z_number.hpp>
+#include <ikos/core/serialization/value.hpp>
+
+using ZNumber = ikos::core::ZNumber;
+using ZBound = ikos::core::ZBound;
+using MachineInt = ikos::core::MachineInt;
+using VariableFactory = ikos::core::example::VariableFactory;
+using Variable = ikos::core::example::VariableFactory::VariableRef;
+using MemoryFactory = ikos::core::example::MemoryFactory;
+using MemoryLocation = ikos::core::example::MemoryFactory::MemoryLocationRef;
+using ZInterval = ikos::core::numeric::ZInterval;
+using ZCongruence = ikos::core::numeric::ZCongruence;
+using ZIntervalCongruence = ikos::core::numeric::IntervalCongruence< ZNumber >;
+using ZGaugeBound = ikos::core::numeric::GaugeBound< ZNumber, Variable >;
+using ZGauge = ikos::core::numeric::Gauge< ZNumber, Variable >;
+using Interval = ikos::core::machine_int::Interval;
+using Congruence = ikos::core::machine_int::Congruence;
+using IntervalCongruence = ikos::core::machine_int::IntervalCongruence;
+using Nullity = ikos::core::Nullity;
+using Uninitialized = ikos::core::Uninitialized;
+using Lifetime = ikos::core::Lifetime;
+using PointsToSet = ikos::core::PointsToSet< MemoryLocation >;
+using Index = ikos::core::Index;
+using SerializationError = ikos::core::serialization::SerializationError;
+using ikos::core::Signed;
+using ikos::core::Unsigned;
+using ikos::core::serialization::deserialize;
+using ikos::core::serialization::serialize;
+using ikos::core::serialization::Tag;
+
+/// \brief Map indexes back to variables and memory locations
+class Resolver {
+private:
+  std::map< Index, Variable > _vars;
+  std::map< Index, MemoryLocation > _mems;
+
+public:
+  void add(Variable v) { this->_vars.emplace(v->index(), v); }
+
+  void add(MemoryLocation m) { this->_mems.emplace(m->index(), m); }
+
+  Variable operator()(Index i, Tag< Variable >) const {
+    return this->_vars.at(i);
+  }
+
+  MemoryLocation operator()(Index i, Tag< MemoryLocation >) const {
+    return this->_mems.at(i);
+  }
+};
+
+template < typename T >
+T round_trip(const T& value) {
+  return deserialize< T >(serialize(value));
+}
+
+template < typename T >
+T round_trip(const T& value, const Resolver& resolver) {
+  return deserialize< T >(serialize(value), resolver);
+}
+
+BOOST_AUTO_TEST_CASE(numeric_interval) {
+  BOOST_CHECK(round_trip(ZInterval::top()) == ZInterval::top());
+  BOOST_CHECK(round_trip(ZInterval::bottom()) == ZInterval::bottom());
+  BOOST_CHECK(round_trip(ZInterval(5)) == ZInterval(5));
+  ZInterval i(ZBound(-3), ZBound(1) << ZBound(70));
+  BOOST_CHECK(round_trip(i) == i);
+  ZInterval j(ZBound::minus_infinity(), ZBound(4));
+  BOOST_CHECK(round_trip(j) == j);
+}
+
+BOOST_AUTO_TEST_CASE(numeric_congruence) {
+  BOOST_CHECK(round_trip(ZCongruence::top()) == ZCongruence::top());
+  BOOST_CHECK(round_trip(ZCongruence::bottom()) == ZCongruence::bottom());
+  BOOST_CHECK(round_trip(ZCongruence(7)) == ZCongruence(7));
+  ZCongruence c(ZNumber(4), ZNumber(3));
+  BOOST_CHECK(round_trip(c) == c);
+}
+
+BOOST_AUTO_TEST_CASE(numeric_interval_congruence) {
+  BOOST_CHECK(round_trip(ZIntervalCongruence::top()) ==
+              ZIntervalCongruence::top());
+  BOOST_CHECK(round_trip(ZIntervalCongruence::bottom()) ==
+              ZIntervalCongruence::bottom());
+  ZIntervalCongruence ic(ZInterval(ZBound(0), ZBound(100)),
+                         ZCongruence(ZNumber(4), ZNumber(1)));
+  BOOST_CHECK(round_trip(ic) == ic);
+}
+
+BOOST_AUTO_TEST_CASE(numeric_gauge) {
+  VariableFactory vfac;
+  Variable i(vfac.get("i"));
+  Variable j(vfac.get("j"));
+  Resolver resolver;
+  resolver.add(i);
+  resolver.add(j);
+
+  BOOST_CHECK(round_trip(ZGauge::top(), resolver) == ZGauge::top());
+  BOOST_CHECK(round_trip(ZGauge::bottom(), resolver) == ZGauge::bottom());
+
+  ZGaugeBound lb = ZGaugeBound(1) + ZGaugeBound(2, i);
+  ZGaugeBound ub = ZGaugeBound(3) + ZGaugeBound(2, i) + ZGaugeBound(1, j);
+  ZGauge g(lb, ub);
+  BOOST_CHECK(!g.is_bottom());
+  BOOST_CHECK(round_trip(g, resolver) == g);
+  ZGauge h(ZGaugeBound(ZNumber(0)), ZGaugeBound::plus_infinity());
+  BOOST_CHECK(round_trip(h, resolver) == h);
+
+  // The resolver does not know any variable
+  BOOST_CHECK_THROW(round_trip(g), SerializationError);
+}
+
+BOOST_AUTO_TEST_CASE(machine_int_interval) {
+  BOOST_CHECK(round_trip(Interval::top(8, Signed)) == Interval::top(8, Signed));
+  BOOST_CHECK(round_trip(Interval::bottom(8, Signed)) ==
+              Interval::bottom(8, Signed));
+  Interval i(MachineInt(-5, 32, Signed), MachineInt(10, 32, Signed));
+  BOOST_CHECK(round_trip(i) == i);
+  Interval j(MachineInt(0, 64, Unsigned), MachineInt::max(64, Unsigned));
+  BOOST_CHECK(round_trip(j) == j);
+  BOOST_CHECK(round_trip(j).sign() == Unsigned);
+}
+
+BOOST_AUTO_TEST_CASE(machine_int_congruence) {
+  BOOST_CHECK(round_trip(Congruence::top(8, Signed)) ==
+              Congruence::top(8, Signed));
+  BOOST_CHECK(round_trip(Congruence::bottom(8, Unsigned)) ==
+              Congruence::bottom(8, Unsigned));
+  Congruence c(ZNumber(4), ZNumber(2), 32, Signed);
+  BOOST_CHECK(round_trip(c) == c);
+}
+
+BOOST_AUTO_TEST_CASE(machine_int_interval_congruence) {
+  BOOST_CHECK(round_trip(IntervalCongruence::top(16, Signed)) ==
+              IntervalCongruence::top(16, Signed));
+  BOOST_CHECK(round_trip(IntervalCongruence::bottom(16, Signed)) ==
+              IntervalCongruence::bottom(16, Signed));
+  IntervalCongruence ic(Interval(MachineInt(0, 16, Unsigned),
+                                 MachineInt(100, 16, Unsigned)),
+                        Congruence(ZNumber(3), ZNumber(1), 16, Unsigned));
+  BOOST_CHECK(round_trip(ic) == ic);
+}
+
+BOOST_AUTO_TEST_CASE(pointer_values) {
+  BOOST_CHECK(round_trip(Nullity::bottom()) == Nullity::bottom());
+  BOOST_CHECK(round_trip(Nullity::null()) == Nullity::null());
+  BOOST_CHECK(round_trip(Nullity::non_null()) == Nullity::non_null());
+  BOOST_CHECK(round_trip(Nullity::top()) == Nullity::top());
+
+  BOOST_CHECK(round_trip(Uninitialized::bottom()) == Uninitialized::bottom());
+  BOOST_CHECK(round_trip(Uninitialized::initialized()) ==
+              Uninitialized::initialized());
+  BOOST_CHECK(round_trip(Uninitialized::uninitialized()) ==
+              Uninitialized::uninitialized());
+  BOOST_CHECK(round_trip(Uninitialized::top()) == Uninitialized::top());
+
+  BOOST_CHECK(round_trip(Lifetime::bottom()) == Lifetime::bottom());
+  BOOST_CHECK(round_trip(Lifetime::allocated()) == Lifetime::allocated());
+  BOOST_CHECK(round_trip(Lifetime::deallocated()) == Lifetime::deallocated());
+  BOOST_CHECK(round_trip(Lifetime::top()) == Lifetime::top());
+}
+
+BOOST_AUTO_TEST_CASE(points_to_set) {
+  MemoryFactory mfac;
+  MemoryLocation a(mfac.get("a"));
+  MemoryLocation b(mfac.get("b"));
+  MemoryLocation c(mfac.get("c"));
+  Resolver resolver;
+  resolver.add(a);
+  resolver.add(b);
+  resolver.add(c);
+
+  BOOST_CHECK(round_trip(PointsToSet::top(), resolver) == PointsToSet::top());
+  BOOST_CHECK(round_trip(PointsToSet::bottom(), resolver) ==
+              PointsToSet::bottom());
+  BOOST_CHECK(round_trip(PointsToSet::empty(), resolver) ==
+              PointsToSet::empty());
+  PointsToSet s{a, c};
+  BOOST_CHECK(round_trip(s, resolver) == s);
+  BOOST_CHECK(!round_trip(s, resolver).contains(b));
+}